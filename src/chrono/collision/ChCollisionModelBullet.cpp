@@ -42,6 +42,7 @@ ChCollisionModelBullet::ChCollisionModelBullet() {
     bt_collision_object = std::unique_ptr<btCollisionObject>(new btCollisionObject);
     bt_collision_object->setCollisionShape(nullptr);
     bt_collision_object->setUserPointer((void*)this);
+    m_aabb_dirty = true;
 }
 
 ChCollisionModelBullet::~ChCollisionModelBullet() {}
@@ -793,13 +794,17 @@ void ChCollisionModelBullet::GetAABB(ChVector<>& bbmin, ChVector<>& bbmax) const
 void ChCollisionModelBullet::SyncPosition() {
     ChCoordsys<> mcsys = mcontactable->GetCsysForCollisionModel();
 
-    bt_collision_object->getWorldTransform().setOrigin(
-        btVector3((btScalar)mcsys.pos.x(), (btScalar)mcsys.pos.y(), (btScalar)mcsys.pos.z()));
     const ChMatrix33<>& rA(mcsys.rot);
     btMatrix3x3 basisA((btScalar)rA(0, 0), (btScalar)rA(0, 1), (btScalar)rA(0, 2), (btScalar)rA(1, 0),
                        (btScalar)rA(1, 1), (btScalar)rA(1, 2), (btScalar)rA(2, 0), (btScalar)rA(2, 1),
                        (btScalar)rA(2, 2));
-    bt_collision_object->getWorldTransform().setBasis(basisA);
+    btTransform transform(basisA, btVector3((btScalar)mcsys.pos.x(), (btScalar)mcsys.pos.y(), (btScalar)mcsys.pos.z()));
+
+    // Flag a change of position, so that the AABB of a static model gets updated (see ChCollisionSystemBullet::Run)
+    if (!(transform == bt_collision_object->getWorldTransform())) {
+        bt_collision_object->setWorldTransform(transform);
+        m_aabb_dirty = true;
+    }
 }
 
 bool ChCollisionModelBullet::SetSphereRadius(double coll_radius, double out_envelope) {
@@ -811,6 +816,7 @@ bool ChCollisionModelBullet::SetSphereRadius(double coll_radius, double out_enve
         SetSafeMargin(coll_radius);
         SetEnvelope(out_envelope);
         bt_sphere_shape->setUnscaledRadius((btScalar)(coll_radius + out_envelope));
+        m_aabb_dirty = true;
         ////bt_sphere_shape->setMargin((btScalar)(coll_radius + out_envelope));
         return true;
     }
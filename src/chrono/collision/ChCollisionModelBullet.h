@@ -339,6 +339,8 @@ class ChApi ChCollisionModelBullet : public ChCollisionModel {
 
     std::vector<std::shared_ptr<geometry::ChTriangleMesh>> m_trimeshes;
 
+    bool m_aabb_dirty;  ///< set if the model moved or changed shape since the last update of its AABB
+
     friend class ChCollisionSystemBullet;
     friend class ChCollisionSystemBulletParallel;
 };
@@ -0,0 +1,47 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+
+#include "chrono/collision/ChCollisionSystem.h"
+
+namespace chrono {
+namespace collision {
+
+void ChCollisionSystem::RayHitBatch(const std::vector<ChVector<>>& from,
+                                    const std::vector<ChVector<>>& to,
+                                    const std::vector<ChCollisionModel*>& models,
+                                    std::vector<ChRayhitResult>& results,
+                                    int num_threads) const {
+    int num_rays = (int)from.size();
+    results.resize(num_rays);
+
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic, 64)
+    for (int i = 0; i < num_rays; i++) {
+        if (models.empty()) {
+            RayHit(from[i], to[i], results[i]);
+            continue;
+        }
+
+        // Keep the closest hit over all specified models
+        results[i].hit = false;
+        for (auto model : models) {
+            ChRayhitResult result;
+            if (RayHit(from[i], to[i], model, result) &&
+                (!results[i].hit || result.dist_factor < results[i].dist_factor))
+                results[i] = result;
+        }
+    }
+}
+
+}  // end namespace collision
+}  // end namespace chrono
@@ -15,6 +15,8 @@
 #ifndef CH_COLLISIONSYSTEM_H
 #define CH_COLLISIONSYSTEM_H
 
+#include <vector>
+
 #include "chrono/collision/ChCollisionInfo.h"
 #include "chrono/core/ChApiCE.h"
 #include "chrono/core/ChFrame.h"
@@ -149,6 +151,17 @@ class ChApi ChCollisionSystem {
                         ChCollisionModel* model,
                         ChRayhitResult& mresult) const = 0;
 
+    /// Perform a batch of ray-hit tests.
+    /// The i-th ray goes from 'from[i]' to 'to[i]' and its result is returned in 'results[i]'.
+    /// If the list of collision models is not empty, a ray only reports its closest hit on one of these models.
+    /// Rays are processed in parallel, using the specified number of OpenMP threads.
+    /// The default implementation calls one of the above RayHit functions for each ray.
+    virtual void RayHitBatch(const std::vector<ChVector<>>& from,
+                             const std::vector<ChVector<>>& to,
+                             const std::vector<ChCollisionModel*>& models,
+                             std::vector<ChRayhitResult>& results,
+                             int num_threads = 1) const;
+
     /// Method to allow serialization of transient data to archives.
     virtual void ArchiveOUT(ChArchiveOut& marchive) {
         // version number
@@ -12,6 +12,8 @@
 // Authors: Alessandro Tasora
 // =============================================================================
 
+#include <algorithm>
+
 #include "chrono/collision/ChCollisionSystemBullet.h"
 #include "chrono/collision/ChCollisionModelBullet.h"
 #include "chrono/collision/gimpact/GIMPACT/Bullet/btGImpactCollisionAlgorithm.h"
@@ -19,6 +21,8 @@
 #include "chrono/physics/ChBody.h"
 #include "chrono/physics/ChContactContainer.h"
 #include "chrono/physics/ChProximityContainer.h"
+#include "chrono/parallel/ChOpenMP.h"
+#include "chrono/collision/bullet/LinearMath/btAabbUtil2.h"
 #include "chrono/collision/bullet/LinearMath/btPoolAllocator.h"
 #include "chrono/collision/bullet/BulletCollision/CollisionShapes/btSphereShape.h"
 #include "chrono/collision/bullet/BulletCollision/CollisionShapes/btCylinderShape.h"
@@ -27,6 +31,7 @@
 #include "chrono/collision/bullet/BulletCollision/CollisionDispatch/btEmptyCollisionAlgorithm.h"
 
 extern btScalar gContactBreakingThreshold;
+extern thread_local int gNumManifold;
 
 namespace chrono {
 namespace collision {
@@ -1179,11 +1184,178 @@ class btCEtriangleShapeCollisionAlgorithm : public btActivatingCollisionAlgorith
 ////////////////////////////////////
 ////////////////////////////////////
 
+// Collision dispatcher that processes the narrowphase of the overlapping pairs on multiple OpenMP threads.
+// The Bullet narrowphase is not thread-safe as such: algorithms and manifolds are allocated from shared pools,
+// new manifolds are registered in a shared array, and the compound and concave algorithms temporarily replace the
+// collision shape of the objects they process. Therefore:
+// - only pairs of two convex objects are processed in parallel, all other pairs are processed serially;
+// - allocations from the shared pools are protected by a lock;
+// - manifolds created or released during the narrowphase are recorded in per-thread lists, and are registered or
+//   released afterwards in pair order. The list of manifolds (and hence the contacts reported from it) is thus the
+//   same as with the serial dispatcher, regardless of the number of threads.
+class btCollisionDispatcherMt : public btCollisionDispatcher {
+  public:
+    btCollisionDispatcherMt(btCollisionConfiguration* configuration)
+        : btCollisionDispatcher(configuration), m_num_threads(1), m_deferred(false) {}
+
+    void SetNumThreads(int num_threads) { m_num_threads = std::max(1, num_threads); }
+    int GetNumThreads() const { return m_num_threads; }
+
+    virtual btPersistentManifold* getNewManifold(void* b0, void* b1) override {
+        if (!m_deferred)
+            return btCollisionDispatcher::getNewManifold(b0, b1);
+
+        btCollisionObject* body0 = (btCollisionObject*)b0;
+        btCollisionObject* body1 = (btCollisionObject*)b1;
+        btScalar contactBreakingThreshold =
+            (m_dispatcherFlags & btCollisionDispatcher::CD_USE_RELATIVE_CONTACT_BREAKING_THRESHOLD)
+                ? btMin(body0->getCollisionShape()->getContactBreakingThreshold(gContactBreakingThreshold),
+                        body1->getCollisionShape()->getContactBreakingThreshold(gContactBreakingThreshold))
+                : gContactBreakingThreshold;
+        btScalar contactProcessingThreshold =
+            btMin(body0->getContactProcessingThreshold(), body1->getContactProcessingThreshold());
+
+        m_lock.Lock();
+        void* mem = m_persistentManifoldPoolAllocator->getFreeCount()
+                        ? m_persistentManifoldPoolAllocator->allocate(sizeof(btPersistentManifold))
+                        : btAlignedAlloc(sizeof(btPersistentManifold), 16);
+        m_lock.Unlock();
+
+        btPersistentManifold* manifold = new (mem)
+            btPersistentManifold(body0, body1, 0, contactBreakingThreshold, contactProcessingThreshold);
+        manifold->m_index1a = -1;
+        RecordEvent(manifold, true);
+        return manifold;
+    }
+
+    virtual void releaseManifold(btPersistentManifold* manifold) override {
+        if (!m_deferred)
+            btCollisionDispatcher::releaseManifold(manifold);
+        else
+            RecordEvent(manifold, false);
+    }
+
+    virtual void* allocateCollisionAlgorithm(int size) override {
+        if (!m_deferred)
+            return btCollisionDispatcher::allocateCollisionAlgorithm(size);
+        m_lock.Lock();
+        void* mem = btCollisionDispatcher::allocateCollisionAlgorithm(size);
+        m_lock.Unlock();
+        return mem;
+    }
+
+    virtual void freeCollisionAlgorithm(void* ptr) override {
+        if (!m_deferred) {
+            btCollisionDispatcher::freeCollisionAlgorithm(ptr);
+            return;
+        }
+        m_lock.Lock();
+        btCollisionDispatcher::freeCollisionAlgorithm(ptr);
+        m_lock.Unlock();
+    }
+
+    virtual void dispatchAllCollisionPairs(btOverlappingPairCache* pairCache,
+                                           const btDispatcherInfo& dispatchInfo,
+                                           btDispatcher* dispatcher) override {
+        if (m_num_threads < 2 || dispatchInfo.m_dispatchFunc != btDispatcherInfo::DISPATCH_DISCRETE) {
+            btCollisionDispatcher::dispatchAllCollisionPairs(pairCache, dispatchInfo, dispatcher);
+            return;
+        }
+
+        int num_pairs = pairCache->getNumOverlappingPairs();
+        if (num_pairs == 0)
+            return;
+        btBroadphasePair* pairs = pairCache->getOverlappingPairArrayPtr();
+
+        m_events.resize(m_num_threads);
+        for (auto& events : m_events)
+            events.clear();
+        m_deferred = true;
+
+        // Pairs of convex objects, in parallel
+#pragma omp parallel for num_threads(m_num_threads) schedule(dynamic, 64)
+        for (int i = 0; i < num_pairs; i++) {
+            if (IsConvexPair(pairs[i])) {
+                s_current = {&m_events[CHOMPfunctions::GetThreadNum()], i, 0};
+                m_nearCallback(pairs[i], *this, dispatchInfo);
+            }
+        }
+
+        // All other pairs, serially
+        for (int i = 0; i < num_pairs; i++) {
+            if (!IsConvexPair(pairs[i])) {
+                s_current = {&m_events[0], i, 0};
+                m_nearCallback(pairs[i], *this, dispatchInfo);
+            }
+        }
+
+        m_deferred = false;
+
+        // Register new manifolds and release old ones, in the same order as the serial dispatcher
+        std::vector<ManifoldEvent> events;
+        for (auto& thread_events : m_events)
+            events.insert(events.end(), thread_events.begin(), thread_events.end());
+        std::sort(events.begin(), events.end(), [](const ManifoldEvent& a, const ManifoldEvent& b) {
+            return a.pair < b.pair || (a.pair == b.pair && a.seq < b.seq);
+        });
+        for (const auto& e : events) {
+            if (e.created) {
+                gNumManifold++;
+                e.manifold->m_index1a = m_manifoldsPtr.size();
+                m_manifoldsPtr.push_back(e.manifold);
+            } else {
+                btCollisionDispatcher::releaseManifold(e.manifold);
+            }
+        }
+    }
+
+  private:
+    struct ManifoldEvent {
+        int pair;                        // index of the overlapping pair being processed
+        int seq;                         // order of the event while processing this pair
+        bool created;                    // manifold created (true) or released (false)
+        btPersistentManifold* manifold;  // the manifold
+    };
+
+    struct PairContext {
+        std::vector<ManifoldEvent>* events;  // event list of the current thread
+        int pair;                            // index of the pair processed by the current thread
+        int seq;                             // number of events recorded for this pair
+    };
+
+    static bool IsConvexPair(const btBroadphasePair& pair) {
+        btCollisionObject* obA = static_cast<btCollisionObject*>(pair.m_pProxy0->m_clientObject);
+        btCollisionObject* obB = static_cast<btCollisionObject*>(pair.m_pProxy1->m_clientObject);
+        return obA->getCollisionShape()->isConvex() && obB->getCollisionShape()->isConvex();
+    }
+
+    void RecordEvent(btPersistentManifold* manifold, bool created) {
+        ManifoldEvent e;
+        e.pair = s_current.pair;
+        e.seq = s_current.seq++;
+        e.created = created;
+        e.manifold = manifold;
+        s_current.events->push_back(e);
+    }
+
+    int m_num_threads;
+    bool m_deferred;
+    CHOMPmutex m_lock;
+    std::vector<std::vector<ManifoldEvent>> m_events;
+
+    static thread_local PairContext s_current;
+};
+
+thread_local btCollisionDispatcherMt::PairContext btCollisionDispatcherMt::s_current = {nullptr, 0, 0};
+
+////////////////////////////////////
+////////////////////////////////////
+
 ChCollisionSystemBullet::ChCollisionSystemBullet(unsigned int max_objects, double scene_size) {
     // btDefaultCollisionConstructionInfo conf_info(...); ***TODO***
     bt_collision_configuration = new btDefaultCollisionConfiguration();
 
-    bt_dispatcher = new btCollisionDispatcher(bt_collision_configuration);
+    bt_dispatcher = new btCollisionDispatcherMt(bt_collision_configuration);
     //((btDefaultCollisionConfiguration*)bt_collision_configuration)->setConvexConvexMultipointIterations(4,4);
 
     //***OLD***
@@ -1198,6 +1370,8 @@ ChCollisionSystemBullet::ChCollisionSystemBullet(unsigned int max_objects, doubl
 
     bt_collision_world = new btCollisionWorld(bt_dispatcher, bt_broadphase, bt_collision_configuration);
 
+    m_static_split = false;
+
     // custom collision for sphere-sphere case ***OBSOLETE*** // already registered by btDefaultCollisionConfiguration
     // bt_dispatcher->registerCollisionCreateFunc(SPHERE_SHAPE_PROXYTYPE,SPHERE_SHAPE_PROXYTYPE,new
     // btSphereSphereCollisionAlgorithm::CreateFunc);
@@ -1284,10 +1458,46 @@ void ChCollisionSystemBullet::Remove(ChCollisionModel* model) {
 
 void ChCollisionSystemBullet::Run() {
     if (bt_collision_world) {
+        if (m_static_split)
+            UpdateStaticModels();
         bt_collision_world->performDiscreteCollisionDetection();
     }
 }
 
+// Deactivate (in the Bullet sense) the collision models of inactive contactables, e.g. fixed or sleeping bodies.
+// Bullet does not update the AABBs of deactivated objects, so that the DBVT broadphase moves their proxies to its
+// static tree, and it skips the narrowphase for pairs of deactivated objects. The AABB of a deactivated model is
+// still updated if the model moved, e.g. for a fixed body repositioned by the user.
+void ChCollisionSystemBullet::UpdateStaticModels() {
+    btCollisionObjectArray& objects = bt_collision_world->getCollisionObjectArray();
+    for (int i = 0; i < objects.size(); i++) {
+        btCollisionObject* object = objects[i];
+        if (object->getActivationState() == DISABLE_SIMULATION)
+            continue;
+        auto model = (ChCollisionModelBullet*)object->getUserPointer();
+        if (model->GetContactable()->IsContactActive()) {
+            object->forceActivationState(ACTIVE_TAG);
+        } else {
+            if (object->isActive() || model->m_aabb_dirty)
+                bt_collision_world->updateSingleAabb(object);
+            object->forceActivationState(ISLAND_SLEEPING);
+        }
+        model->m_aabb_dirty = false;
+    }
+}
+
+void ChCollisionSystemBullet::SetUseStaticSplit(bool val) {
+    m_static_split = val;
+    bt_collision_world->setForceUpdateAllAabbs(!m_static_split);
+    if (!m_static_split) {
+        btCollisionObjectArray& objects = bt_collision_world->getCollisionObjectArray();
+        for (int i = 0; i < objects.size(); i++) {
+            if (objects[i]->getActivationState() == ISLAND_SLEEPING)
+                objects[i]->forceActivationState(ACTIVE_TAG);
+        }
+    }
+}
+
 void ChCollisionSystemBullet::ResetTimers() {
     bt_collision_world->timer_collision_broad.reset();
     bt_collision_world->timer_collision_narrow.reset();
@@ -1301,88 +1511,130 @@ double ChCollisionSystemBullet::GetTimerCollisionNarrow() const {
     return bt_collision_world->timer_collision_narrow();
 }
 
+void ChCollisionSystemBullet::SetNumThreads(int num_threads) {
+    static_cast<btCollisionDispatcherMt*>(bt_dispatcher)->SetNumThreads(num_threads);
+}
+
+int ChCollisionSystemBullet::GetNumThreads() const {
+    return static_cast<btCollisionDispatcherMt*>(bt_dispatcher)->GetNumThreads();
+}
+
+// Convert a Bullet contact point into collision info for the contact container.
+static void ConvertContactPoint(btManifoldPoint& pt,
+                                const btCollisionObject* obA,
+                                const btCollisionObject* obB,
+                                ChCollisionInfo& icontact) {
+    icontact.modelA = (ChCollisionModel*)obA->getUserPointer();
+    icontact.modelB = (ChCollisionModel*)obB->getUserPointer();
+
+    double envelopeA = icontact.modelA->GetEnvelope();
+    double envelopeB = icontact.modelB->GetEnvelope();
+
+    btVector3 ptA = pt.getPositionWorldOnA();
+    btVector3 ptB = pt.getPositionWorldOnB();
+
+    icontact.vpA.Set(ptA.getX(), ptA.getY(), ptA.getZ());
+    icontact.vpB.Set(ptB.getX(), ptB.getY(), ptB.getZ());
+
+    icontact.vN.Set(-pt.m_normalWorldOnB.getX(), -pt.m_normalWorldOnB.getY(), -pt.m_normalWorldOnB.getZ());
+    icontact.vN.Normalize();
+
+    double ptdist = pt.getDistance();
+
+    icontact.vpA = icontact.vpA - icontact.vN * envelopeA;
+    icontact.vpB = icontact.vpB + icontact.vN * envelopeB;
+    icontact.distance = ptdist + envelopeA + envelopeB;
+
+    icontact.reaction_cache = pt.reactions_cache;
+
+    bool compoundA = (obA->getRootCollisionShape()->getShapeType() == COMPOUND_SHAPE_PROXYTYPE);
+    bool compoundB = (obB->getRootCollisionShape()->getShapeType() == COMPOUND_SHAPE_PROXYTYPE);
+
+    int indexA = compoundA ? pt.m_index0 : 0;
+    int indexB = compoundB ? pt.m_index1 : 0;
+
+    icontact.shapeA = icontact.modelA->GetShape(indexA).get();
+    icontact.shapeB = icontact.modelB->GetShape(indexB).get();
+}
+
 void ChCollisionSystemBullet::ReportContacts(ChContactContainer* mcontactcontainer) {
     // This should remove all old contacts (or at least rewind the index)
     mcontactcontainer->BeginAddContact();
 
     // NOTE: Bullet does not provide information on radius of curvature at a contact point.
     // As such, for all Bullet-identified contacts, the default value will be used (SMC only).
-    ChCollisionInfo icontact;
 
-    int numManifolds = bt_collision_world->getDispatcher()->getNumManifolds();
+    btDispatcher* dispatcher = bt_collision_world->getDispatcher();
+    int numManifolds = dispatcher->getNumManifolds();
+    int num_threads = GetNumThreads();
+
+    // Refresh the manifolds and count their contact points within the safe margins
+    m_contact_start.resize(numManifolds + 1);
+    m_contact_start[0] = 0;
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic, 64)
     for (int i = 0; i < numManifolds; i++) {
-        btPersistentManifold* contactManifold = bt_collision_world->getDispatcher()->getManifoldByIndexInternal(i);
+        btPersistentManifold* contactManifold = dispatcher->getManifoldByIndexInternal(i);
         btCollisionObject* obA = static_cast<btCollisionObject*>(contactManifold->getBody0());
         btCollisionObject* obB = static_cast<btCollisionObject*>(contactManifold->getBody1());
         contactManifold->refreshContactPoints(obA->getWorldTransform(), obB->getWorldTransform());
 
-        icontact.modelA = (ChCollisionModel*)obA->getUserPointer();
-        icontact.modelB = (ChCollisionModel*)obB->getUserPointer();
+        double marginA = ((ChCollisionModel*)obA->getUserPointer())->GetSafeMargin();
+        double marginB = ((ChCollisionModel*)obB->getUserPointer())->GetSafeMargin();
+
+        // Discard "too far" constraints (the Bullet engine also has its threshold)
+        int count = 0;
+        for (int j = 0; j < contactManifold->getNumContacts(); j++) {
+            if (contactManifold->getContactPoint(j).getDistance() < marginA + marginB)
+                count++;
+        }
+        m_contact_start[i + 1] = count;
+    }
+    for (int i = 0; i < numManifolds; i++)
+        m_contact_start[i + 1] += m_contact_start[i];
+
+    // Convert the contact points
+    m_contacts.resize(m_contact_start[numManifolds]);
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic, 64)
+    for (int i = 0; i < numManifolds; i++) {
+        btPersistentManifold* contactManifold = dispatcher->getManifoldByIndexInternal(i);
+        btCollisionObject* obA = static_cast<btCollisionObject*>(contactManifold->getBody0());
+        btCollisionObject* obB = static_cast<btCollisionObject*>(contactManifold->getBody1());
+
+        double marginA = ((ChCollisionModel*)obA->getUserPointer())->GetSafeMargin();
+        double marginB = ((ChCollisionModel*)obB->getUserPointer())->GetSafeMargin();
 
-        double envelopeA = icontact.modelA->GetEnvelope();
-        double envelopeB = icontact.modelB->GetEnvelope();
+        int k = m_contact_start[i];
+        for (int j = 0; j < contactManifold->getNumContacts(); j++) {
+            btManifoldPoint& pt = contactManifold->getContactPoint(j);
+            if (pt.getDistance() < marginA + marginB)
+                ConvertContactPoint(pt, obA, obB, m_contacts[k++]);
+        }
+    }
 
-        double marginA = icontact.modelA->GetSafeMargin();
-        double marginB = icontact.modelB->GetSafeMargin();
+    // Add to the contact container, in manifold order
+    for (int i = 0; i < numManifolds; i++) {
+        btPersistentManifold* contactManifold = dispatcher->getManifoldByIndexInternal(i);
+        btCollisionObject* obA = static_cast<btCollisionObject*>(contactManifold->getBody0());
+        btCollisionObject* obB = static_cast<btCollisionObject*>(contactManifold->getBody1());
 
         // Execute custom broadphase callback, if any
         bool do_narrow_contactgeneration = true;
         if (this->broad_callback)
-            do_narrow_contactgeneration = this->broad_callback->OnBroadphase(icontact.modelA, icontact.modelB);
+            do_narrow_contactgeneration = this->broad_callback->OnBroadphase((ChCollisionModel*)obA->getUserPointer(),
+                                                                             (ChCollisionModel*)obB->getUserPointer());
 
         if (do_narrow_contactgeneration) {
-            int numContacts = contactManifold->getNumContacts();
-            // GetLog() << "numContacts=" << numContacts << "\n";
-            for (int j = 0; j < numContacts; j++) {
-                btManifoldPoint& pt = contactManifold->getContactPoint(j);
-
-                // Discard "too far" constraints (the Bullet engine also has its threshold)
-                if (pt.getDistance() < marginA + marginB) {
-                    btVector3 ptA = pt.getPositionWorldOnA();
-                    btVector3 ptB = pt.getPositionWorldOnB();
-
-                    icontact.vpA.Set(ptA.getX(), ptA.getY(), ptA.getZ());
-                    icontact.vpB.Set(ptB.getX(), ptB.getY(), ptB.getZ());
-
-                    icontact.vN.Set(-pt.m_normalWorldOnB.getX(), -pt.m_normalWorldOnB.getY(),
-                                    -pt.m_normalWorldOnB.getZ());
-                    icontact.vN.Normalize();
-
-                    double ptdist = pt.getDistance();
-
-                    icontact.vpA = icontact.vpA - icontact.vN * envelopeA;
-                    icontact.vpB = icontact.vpB + icontact.vN * envelopeB;
-                    icontact.distance = ptdist + envelopeA + envelopeB;
-
-                    icontact.reaction_cache = pt.reactions_cache;
-
-                    bool compoundA = (obA->getRootCollisionShape()->getShapeType() == COMPOUND_SHAPE_PROXYTYPE);
-                    bool compoundB = (obB->getRootCollisionShape()->getShapeType() == COMPOUND_SHAPE_PROXYTYPE);
-
-                    int indexA = compoundA ? pt.m_index0 : 0;
-                    int indexB = compoundB ? pt.m_index1 : 0;
-
-                    icontact.shapeA = icontact.modelA->GetShape(indexA).get();
-                    icontact.shapeB = icontact.modelB->GetShape(indexB).get();
-
-                    // Execute some user custom callback, if any
-                    bool add_contact = true;
-                    if (this->narrow_callback)
-                        add_contact = this->narrow_callback->OnNarrowphase(icontact);
-
-                    // Add to contact container
-                    if (add_contact) {
-                        ////std::cout << " add indexA=" << indexA << " indexB=" << indexB << std::endl;
-                        ////std::cout << "     typeA=" << icontact.shapeA->m_type << " typeB=" << icontact.shapeB->m_type
-                        ////          << std::endl;
-                        mcontactcontainer->AddContact(icontact);
-                    }
-                }
+            for (int k = m_contact_start[i]; k < m_contact_start[i + 1]; k++) {
+                // Execute some user custom callback, if any
+                bool add_contact = true;
+                if (this->narrow_callback)
+                    add_contact = this->narrow_callback->OnNarrowphase(m_contacts[k]);
+
+                // Add to contact container
+                if (add_contact)
+                    mcontactcontainer->AddContact(m_contacts[k]);
             }
         }
-
-        // Uncomment this line to remove all points
-        ////contactManifold->clearManifold();
     }
     mcontactcontainer->EndAddContact();
 }
@@ -1509,6 +1761,73 @@ bool ChCollisionSystemBullet::RayHit(const ChVector<>& from,
     return true;
 }
 
+void ChCollisionSystemBullet::RayHitBatch(const std::vector<ChVector<>>& from,
+                                          const std::vector<ChVector<>>& to,
+                                          const std::vector<ChCollisionModel*>& models,
+                                          std::vector<ChRayhitResult>& results,
+                                          int num_threads) const {
+    if (models.empty()) {
+        ChCollisionSystem::RayHitBatch(from, to, models, results, num_threads);
+        return;
+    }
+
+    // Cache the Bullet collision objects and their current AABBs
+    struct ObjectRecord {
+        btCollisionObject* object;
+        btVector3 aabb_min;
+        btVector3 aabb_max;
+    };
+    std::vector<ObjectRecord> objects;
+    for (auto model : models) {
+        auto object = static_cast<ChCollisionModelBullet*>(model)->GetBulletModel();
+        if (!object->getCollisionShape())
+            continue;
+        ObjectRecord record;
+        record.object = object;
+        object->getCollisionShape()->getAabb(object->getWorldTransform(), record.aabb_min, record.aabb_max);
+        objects.push_back(record);
+    }
+
+    int num_rays = (int)from.size();
+    results.resize(num_rays);
+
+#pragma omp parallel for num_threads(num_threads) schedule(dynamic, 64)
+    for (int i = 0; i < num_rays; i++) {
+        btVector3 btfrom((btScalar)from[i].x(), (btScalar)from[i].y(), (btScalar)from[i].z());
+        btVector3 btto((btScalar)to[i].x(), (btScalar)to[i].y(), (btScalar)to[i].z());
+        btTransform from_trans(btMatrix3x3::getIdentity(), btfrom);
+        btTransform to_trans(btMatrix3x3::getIdentity(), btto);
+
+        // Test the ray directly against each object whose AABB it intersects.
+        // The callback keeps track of the closest hit over all objects.
+        btCollisionWorld::ClosestRayResultCallback rayCallback(btfrom, btto);
+        for (const auto& record : objects) {
+            btScalar param = 1;
+            btVector3 normal;
+            if (!btRayAabb(btfrom, btto, record.aabb_min, record.aabb_max, param, normal))
+                continue;
+            btCollisionWorld::rayTestSingle(from_trans, to_trans, record.object, record.object->getCollisionShape(),
+                                            record.object->getWorldTransform(), rayCallback);
+        }
+
+        ChRayhitResult& mresult = results[i];
+        mresult.hit = false;
+        if (rayCallback.hasHit()) {
+            mresult.hitModel = (ChCollisionModel*)(rayCallback.m_collisionObject->getUserPointer());
+            if (mresult.hitModel) {
+                mresult.hit = true;
+                mresult.abs_hitPoint.Set(rayCallback.m_hitPointWorld.x(), rayCallback.m_hitPointWorld.y(),
+                                         rayCallback.m_hitPointWorld.z());
+                mresult.abs_hitNormal.Set(rayCallback.m_hitNormalWorld.x(), rayCallback.m_hitNormalWorld.y(),
+                                          rayCallback.m_hitNormalWorld.z());
+                mresult.abs_hitNormal.Normalize();
+                mresult.dist_factor = rayCallback.m_closestHitFraction;
+                mresult.abs_hitPoint = mresult.abs_hitPoint - mresult.abs_hitNormal * mresult.hitModel->GetEnvelope();
+            }
+        }
+    }
+}
+
 void ChCollisionSystemBullet::SetContactBreakingThreshold(double threshold) {
     gContactBreakingThreshold = (btScalar)threshold;
 }
@@ -15,6 +15,8 @@
 #ifndef CH_COLLISION_SYSTEM_BULLET_H
 #define CH_COLLISION_SYSTEM_BULLET_H
 
+#include <vector>
+
 #include "chrono/collision/ChCollisionSystem.h"
 #include "chrono/collision/bullet/btBulletCollisionCommon.h"
 #include "chrono/core/ChApiCE.h"
@@ -50,6 +52,24 @@ class ChApi ChCollisionSystemBullet : public ChCollisionSystem {
     /// (Contacts will be managed by the Bullet persistent contact cache).
     virtual void Run() override;
 
+    /// Set the number of OpenMP threads used for the narrowphase and for collecting the contacts (default: 1).
+    /// Pairs of two convex shapes are processed in parallel, while pairs involving compound (multi-shape) or
+    /// concave (triangle mesh) models are processed serially. The reported contacts, and their order, do not
+    /// depend on the number of threads.
+    void SetNumThreads(int num_threads);
+
+    /// Get the number of OpenMP threads used for the narrowphase and for collecting the contacts.
+    int GetNumThreads() const;
+
+    /// Enable or disable the static/dynamic split of the broadphase (default: false).
+    /// When enabled, the AABBs of collision models of inactive objects (fixed or sleeping bodies) are updated only
+    /// when these models move, so that they stay in the static tree of the broadphase and only pairs involving at
+    /// least one active model are tested at each step. Pairs of two inactive models are not reported.
+    void SetUseStaticSplit(bool val);
+
+    /// Return true if the static/dynamic split of the broadphase is enabled.
+    bool GetUseStaticSplit() const { return m_static_split; }
+
     /// Reset timers for collision detection.
     virtual void ResetTimers() override;
 
@@ -103,6 +123,15 @@ class ChApi ChCollisionSystemBullet : public ChCollisionSystem {
                 short int filter_group,
                 short int filter_mask) const;
 
+    /// Perform a batch of ray-hit tests (see ChCollisionSystem::RayHitBatch).
+    /// If a list of collision models is provided, rays are tested directly against these models, bypassing the
+    /// broadphase; this is typically much faster when there are only a few such models.
+    virtual void RayHitBatch(const std::vector<ChVector<>>& from,
+                             const std::vector<ChVector<>>& to,
+                             const std::vector<ChCollisionModel*>& models,
+                             std::vector<ChRayhitResult>& results,
+                             int num_threads = 1) const override;
+
     // For Bullet related stuff
     btCollisionWorld* GetBulletCollisionWorld() { return bt_collision_world; }
 
@@ -123,6 +152,12 @@ class ChApi ChCollisionSystemBullet : public ChCollisionSystem {
     btCollisionAlgorithmCreateFunc* m_collision_cetri_cetri;
     void* m_tmp_mem;
     btCollisionAlgorithmCreateFunc* m_emptyCreateFunc;
+
+    void UpdateStaticModels();
+
+    bool m_static_split;                      ///< static/dynamic split of the broadphase
+    std::vector<int> m_contact_start;         ///< index of the first contact of each manifold in m_contacts
+    std::vector<ChCollisionInfo> m_contacts;  ///< contacts collected from the manifolds
 };
 
 }  // end namespace collision
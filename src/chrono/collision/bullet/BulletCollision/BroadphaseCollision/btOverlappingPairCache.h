@@ -49,9 +49,9 @@ struct btOverlapFilterCallback
 
 
 
-extern int gRemovePairs;
-extern int gAddedPairs;
-extern int gFindPairs;
+extern thread_local int gRemovePairs;
+extern thread_local int gAddedPairs;
+extern thread_local int gFindPairs;
 
 const int BT_NULL_PAIR=0xffffffff;
 
@@ -202,14 +202,20 @@ void	btCollisionWorld::performDiscreteCollisionDetection()
 
 	btDispatcherInfo& dispatchInfo = getDispatchInfo();
 
-	updateAabbs();
-
 	{
-		BT_PROFILE("calculateOverlappingPairs");
         CH_PROFILE("Broad-phase"); //***ALEX***
-        timer_collision_broad.start(); //***RADU***
-		m_broadphasePairCache->calculateOverlappingPairs(m_dispatcher1);
-        timer_collision_broad.stop(); //***RADU***
+        {
+            CH_PROFILE("UpdateAABBs");
+            updateAabbs();
+        }
+
+        {
+            BT_PROFILE("calculateOverlappingPairs");
+            CH_PROFILE("OverlappingPairs");
+            timer_collision_broad.start(); //***RADU***
+            m_broadphasePairCache->calculateOverlappingPairs(m_dispatcher1);
+            timer_collision_broad.stop(); //***RADU***
+        }
 	}
 
 
@@ -492,9 +498,8 @@ void	btCollisionWorld::rayTestSingle(const btTransform& rayFromTrans,const btTra
 						const btTransform& childTrans = m_compoundShape->getChildTransform(i);
 						btTransform childWorldTrans = m_colObjWorldTransform * childTrans;
 						
-						// replace collision shape so that callback can determine the triangle
-						btCollisionShape* saveCollisionShape = m_collisionObject->getCollisionShape();
-						m_collisionObject->internalSetTemporaryCollisionShape((btCollisionShape*)childCollisionShape);
+						//***CHRONO*** the collision shape of the object is not temporarily replaced by the child shape,
+						// so that rays can be cast concurrently; the child index is still reported in the shape info
 
 						LocalInfoAdder2 my_cb(i, &m_resultCallback);
 
@@ -505,9 +510,6 @@ void	btCollisionWorld::rayTestSingle(const btTransform& rayFromTrans,const btTra
 							childCollisionShape,
 							childWorldTrans,
 							my_cb);
-						
-						// restore
-						m_collisionObject->internalSetTemporaryCollisionShape(saveCollisionShape);
 					}
 					
 					void Process(const btDbvtNode* leaf)
@@ -122,7 +122,9 @@ void btConvex2dConvex2dAlgorithm ::processCollision (btCollisionObject* body0,bt
 
 		btGjkPairDetector::ClosestPointInput input;
 
-		btGjkPairDetector	gjkPairDetector(min0,min1,m_simplexSolver,m_pdSolver);
+		//***CHRONO*** local simplex solver, the one shared by all algorithms is not thread-safe
+		btVoronoiSimplexSolver	simplexSolver;
+		btGjkPairDetector	gjkPairDetector(min0,min1,&simplexSolver,m_pdSolver);
 		//TODO: if (dispatchInfo.m_useContinuous)
 		gjkPairDetector.setMinkowskiA(min0);
 		gjkPairDetector.setMinkowskiB(min1);
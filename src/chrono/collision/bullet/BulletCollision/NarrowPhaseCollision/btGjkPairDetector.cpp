@@ -34,8 +34,9 @@ subject to the following restrictions:
 #define REL_ERROR2 btScalar(1.0e-6)
 
 //temp globals, to improve GJK/EPA/penetration calculations
-int gNumDeepPenetrationChecks = 0;
-int gNumGjkChecks = 0;
+//***CHRONO*** per-thread statistics counters
+thread_local int gNumDeepPenetrationChecks = 0;
+thread_local int gNumGjkChecks = 0;
 
 
 btGjkPairDetector::btGjkPairDetector(const btConvexShape* objectA,const btConvexShape* objectB,btSimplexSolverInterface* simplexSolver,btConvexPenetrationDepthSolver*	penetrationDepthSolver)
@@ -421,10 +421,10 @@ void	CProfileIterator::Enter_Parent( void )
 **
 ***************************************************************************************************/
 
-CProfileNode	CProfileManager::Root( "Root", NULL );
-CProfileNode *	CProfileManager::CurrentNode = &CProfileManager::Root;
-int				CProfileManager::FrameCounter = 0;
-unsigned long int			CProfileManager::ResetTime = 0;
+thread_local CProfileNode	CProfileManager::Root( "Root", NULL );
+thread_local CProfileNode *	CProfileManager::CurrentNode = &CProfileManager::Root;
+thread_local int				CProfileManager::FrameCounter = 0;
+thread_local unsigned long int			CProfileManager::ResetTime = 0;
 
 
 /***********************************************************************************************
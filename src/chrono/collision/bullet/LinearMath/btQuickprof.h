@@ -158,10 +158,11 @@ public:
 	static void	dumpAll();
 
 private:
-	static	CProfileNode			Root;
-	static	CProfileNode *			CurrentNode;
-	static	int						FrameCounter;
-	static	unsigned long int					ResetTime;
+	// Chrono: profile trees are per thread, so that independent systems can be simulated concurrently
+	static	thread_local CProfileNode			Root;
+	static	thread_local CProfileNode *			CurrentNode;
+	static	thread_local int						FrameCounter;
+	static	thread_local unsigned long int					ResetTime;
 };
 
 
@@ -18,9 +18,8 @@ namespace chrono {
 /// between dll boundaries. It is allocated the 1st time it is called, if null.
 
 ChClassFactory* ChClassFactory::GetGlobalClassFactory() {
-    static ChClassFactory* mfactory = 0;
-    if (!mfactory)
-        mfactory = new ChClassFactory;
+    // Function-local static initialization is thread safe
+    static ChClassFactory* mfactory = new ChClassFactory;
     return mfactory;
 }
 
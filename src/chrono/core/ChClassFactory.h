@@ -75,6 +75,8 @@ public:
 /// NOTE: You do not need to explicitly create it: a static ChClassFactory
 ///  class factory is automatically instanced once, at the first time
 ///  that someone registers a class. It is consistent also across different DLLs.
+/// NOTE: classes are registered during static initialization; after that, the
+///  factory is only read, so objects can be created concurrently from several threads.
 
 
 class ChApi ChClassFactory {
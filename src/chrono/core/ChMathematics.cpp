@@ -43,7 +43,8 @@ double ChAtan2(double mcos, double msin) {
 #define IR 2836
 #define MASK 123459876
 
-static long CH_PAseed = 123;
+// Generator state, one per thread (so that independent systems can be simulated concurrently)
+static thread_local long CH_PAseed = 123;
 
 void ChSetRandomSeed(long newseed) {
     if (CH_PAseed)
@@ -49,10 +49,11 @@ ChApi double ChAtan2(double mcos, double msin);
 
 // OTHER
 
-/// Returns random value in (0..1) interval with Park-Miller method
+/// Returns random value in (0..1) interval with Park-Miller method.
+/// The generator state is local to the calling thread.
 ChApi double ChRandom();
 
-/// Sets the seed of the ChRandom function 	(Park-Miller method)
+/// Sets the seed of the ChRandom function 	(Park-Miller method), for the calling thread.
 ChApi void ChSetRandomSeed(long newseed);
 
 /// Computes a 1D harmonic multi-octave noise
@@ -100,6 +100,7 @@ class ChApi ChElementBase {
     /// Adds the internal forces (pasted at global nodes offsets) into
     /// a global vector R, multiplied by a scaling factor c, as
     ///   R += forces * c
+    /// Note that the containing mesh calls this function concurrently for elements that do not share any node.
     virtual void EleIntLoadResidual_F(ChVectorDynamic<>& R, const double c) {}
 
     /// Adds the product of element mass M by a vector w (pasted at global nodes offsets) into
@@ -113,6 +114,7 @@ class ChApi ChElementBase {
     /// contains G_acc values in the proper stride (ex. tetahedrons have 4x copies of G_acc in g). 
     /// Note that elements can provide fast implementations that do not need to build any internal M matrix,
     /// and not even the g vector, for instance if using lumped masses. 
+    /// Note that the containing mesh calls this function concurrently for elements that do not share any node.
     virtual void EleIntLoadResidual_F_gravity(ChVectorDynamic<>& R, const ChVector<>& G_acc, const double c) = 0;
 
 
@@ -25,9 +25,8 @@ void ChElementGeneric::EleIntLoadResidual_F(ChVectorDynamic<>& R, const double c
     // GetLog() << "EleIntLoadResidual_F , mFi=" << mFi << "  c=" << c << "\n";
     mFi *= c;
 
-    //// RADU
-    //// Attention: this is called from within a parallel OMP for loop.
-    //// Must use atomic increment when updating the global vector R.
+    // Note: this is called from within a parallel OMP for loop over elements that do not share nodes
+    // (see ChMesh::IntLoadResidual_F), so the global vector R can be updated without synchronization.
 
     int stride = 0;
     for (int in = 0; in < this->GetNnodes(); in++) {
@@ -35,9 +34,7 @@ void ChElementGeneric::EleIntLoadResidual_F(ChVectorDynamic<>& R, const double c
         // GetLog() << "  in=" << in << "  stride=" << stride << "  nodedofs=" << nodedofs << " offset=" <<
         // GetNodeN(in)->NodeGetOffset_w() << "\n";
         if (!GetNodeN(in)->GetFixed()) {
-            for (int j = 0; j < nodedofs; j++)
-#pragma omp atomic
-                R(GetNodeN(in)->NodeGetOffset_w() + j) += mFi(stride + j);
+            R.segment(GetNodeN(in)->NodeGetOffset_w(), nodedofs) += mFi.segment(stride, nodedofs);
         }
         stride += nodedofs;
     }
@@ -86,11 +83,9 @@ void ChElementGeneric::EleIntLoadResidual_F_gravity(ChVectorDynamic<>& R, const
     int stride = 0;
     for (int in = 0; in < this->GetNnodes(); in++) {
         int nodedofs = GetNodeNdofs(in);
+        // Called from an OMP parallel loop over elements that do not share nodes: no race conditions when writing to R
         if (!GetNodeN(in)->GetFixed()) {
-            for (int j = 0; j < nodedofs; j++)
-                //***ATOMIC*** as called from an OMP parallel loop: this is here to avoid race conditions when writing to R
-                #pragma omp atomic  
-                R(GetNodeN(in)->NodeGetOffset_w() + j) += mFg(stride + j);
+            R.segment(GetNodeN(in)->NodeGetOffset_w(), nodedofs) += mFg.segment(stride, nodedofs);
         }
         stride += nodedofs;
     }
@@ -18,11 +18,13 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <unordered_map>
 
 #include "chrono/core/ChMath.h"
 #include "chrono/physics/ChLoad.h"
 #include "chrono/physics/ChObject.h"
 #include "chrono/physics/ChSystem.h"
+#include "chrono/utils/ChProfiler.h"
 
 #include "chrono/fea/ChElementTetra_4.h"
 #include "chrono/fea/ChMesh.h"
@@ -44,6 +46,8 @@ ChMesh::ChMesh(const ChMesh& other) : ChIndexedNodes(other) {
     automatic_gravity_load = other.automatic_gravity_load;
     num_points_gravity = other.num_points_gravity;
 
+    element_colors_valid = false;
+
     ncalls_internal_forces = 0;
     ncalls_KRMload = 0;
 }
@@ -64,6 +68,8 @@ void ChMesh::SetupInitial() {
         //    - precompute matrices, such as the [Kl] local stiffness of each element, if needed, etc.
         velements[i]->SetupInitial(GetSystem());
     }
+
+    element_colors_valid = false;
 }
 
 void ChMesh::Relax() {
@@ -93,6 +99,7 @@ void ChMesh::AddNode(std::shared_ptr<ChNodeFEAbase> m_node) {
 
 void ChMesh::AddElement(std::shared_ptr<ChElementBase> m_elem) {
     velements.push_back(m_elem);
+    element_colors_valid = false;
 
     // If the mesh is already added to a system, mark the system uninitialized and out-of-date
     if (system) {
@@ -104,6 +111,7 @@ void ChMesh::AddElement(std::shared_ptr<ChElementBase> m_elem) {
 void ChMesh::ClearElements() {
     velements.clear();
     vcontactsurfaces.clear();
+    element_colors_valid = false;
 
     // If the mesh is already added to a system, mark the system out-of-date
     if (system) {
@@ -115,6 +123,7 @@ void ChMesh::ClearNodes() {
     velements.clear();
     vnodes.clear();
     vcontactsurfaces.clear();
+    element_colors_valid = false;
 
     // If the mesh is already added to a system, mark the system out-of-date
     if (system) {
@@ -279,20 +288,31 @@ void ChMesh::IntLoadResidual_F(const unsigned int off,
         }
     }
 
+    // Elements sharing a node write to the same entries in R. Process elements one color at a time, so that
+    // elements loaded concurrently never share a node and no synchronization is needed when writing to R.
+    if (!element_colors_valid)
+        ColorElements();
+
     // elements internal forces
+    CH_PROFILE("FEA_InternalForces");
     timer_internal_forces.start();
-    #pragma omp parallel for schedule(dynamic, 4) //***PARALLEL FOR***, must use omp atomic to avoid race condition in writing to R
-    for (int ie = 0; ie < velements.size(); ie++) {
-        velements[ie]->EleIntLoadResidual_F(R, c);
+    for (const auto& color : element_colors) {
+        #pragma omp parallel for schedule(dynamic, 4)
+        for (int i = 0; i < (int)color.size(); i++) {
+            velements[color[i]]->EleIntLoadResidual_F(R, c);
+        }
     }
     timer_internal_forces.stop();
     ncalls_internal_forces++;
 
     // elements gravity forces 
     if (automatic_gravity_load) {
-        #pragma omp parallel for schedule(dynamic, 4) //***PARALLEL FOR***, must use omp atomic to avoid race condition in writing to R
-        for (int ie = 0; ie < velements.size(); ie++) {
-            velements[ie]->EleIntLoadResidual_F_gravity(R, GetSystem()->Get_G_acc(), c);
+        ChVector<> G_acc = GetSystem()->Get_G_acc();
+        for (const auto& color : element_colors) {
+            #pragma omp parallel for schedule(dynamic, 4)
+            for (int i = 0; i < (int)color.size(); i++) {
+                velements[color[i]]->EleIntLoadResidual_F_gravity(R, G_acc, c);
+            }
         }
     }
     
@@ -320,6 +340,35 @@ void ChMesh::IntLoadResidual_F(const unsigned int off,
     */
 }
 
+void ChMesh::ColorElements() {
+    // Colors already used by the elements connected to each node
+    std::unordered_map<ChNodeFEAbase*, std::vector<int>> node_colors;
+    std::vector<bool> used;
+
+    element_colors.clear();
+    for (int ie = 0; ie < (int)velements.size(); ie++) {
+        // Flag the colors of all elements sharing a node with this element
+        used.assign(element_colors.size(), false);
+        for (int in = 0; in < velements[ie]->GetNnodes(); in++) {
+            for (auto col : node_colors[velements[ie]->GetNodeN(in).get()])
+                used[col] = true;
+        }
+
+        // Pick the first available color
+        int color = 0;
+        while (color < (int)used.size() && used[color])
+            color++;
+        if (color == (int)element_colors.size())
+            element_colors.push_back(std::vector<int>());
+        element_colors[color].push_back(ie);
+
+        for (int in = 0; in < velements[ie]->GetNnodes(); in++)
+            node_colors[velements[ie]->GetNodeN(in).get()].push_back(color);
+    }
+
+    element_colors_valid = true;
+}
+
 void ChMesh::ComputeMassProperties(double& mass,           // ChMesh object mass
                                    ChVector<>& com,        // ChMesh center of gravity
                                    ChMatrix33<>& inertia)  // ChMesh inertia tensor
@@ -397,6 +446,7 @@ void ChMesh::InjectKRMmatrices(ChSystemDescriptor& mdescriptor) {
 }
 
 void ChMesh::KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) {
+    CH_PROFILE("FEA_KRMload");
     timer_KRMload.start();
 #pragma omp parallel for
     for (int ie = 0; ie < velements.size(); ie++)
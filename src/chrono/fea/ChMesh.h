@@ -52,6 +52,9 @@ class ChApi ChMesh : public ChIndexedNodes {
     bool automatic_gravity_load;
     int num_points_gravity;
 
+    std::vector<std::vector<int>> element_colors;  ///< element indices, grouped in sets with no shared nodes
+    bool element_colors_valid;                      ///< element coloring up to date with mesh topology
+
     ChTimer<> timer_internal_forces;
     ChTimer<> timer_KRMload;
     int ncalls_internal_forces;
@@ -63,6 +66,7 @@ class ChApi ChMesh : public ChIndexedNodes {
           n_dofs_w(0),
           automatic_gravity_load(true),
           num_points_gravity(1),
+          element_colors_valid(false),
           ncalls_internal_forces(0),
           ncalls_KRMload(0) {}
     ChMesh(const ChMesh& other);
@@ -100,6 +104,12 @@ class ChApi ChMesh : public ChIndexedNodes {
     /// Override default in ChPhysicsItem.
     virtual bool GetCollide() const override { return true; }
 
+    /// Get the number of element colors.
+    /// Elements are grouped in colors such that no two elements of the same color share a node. Internal and gravity
+    /// forces are loaded in the global residual one color at a time, in parallel over the elements of each color.
+    /// The coloring is computed at the first residual evaluation after a change in the mesh topology.
+    int GetNumElementColors() const { return (int)element_colors.size(); }
+
     /// Reset counters for internal force and Jacobian evaluations.
     void ResetCounters() {
         ncalls_internal_forces = 0;
@@ -270,6 +280,9 @@ class ChApi ChMesh : public ChIndexedNodes {
     virtual void InjectVariables(ChSystemDescriptor& mdescriptor) override;
 
   private:
+    /// Group the elements in colors (sets of elements with no shared nodes), using a greedy algorithm.
+    void ColorElements();
+
     /// Initial setup (before analysis).
     /// This function is called from ChSystem::SetupInitial, marking a point where system
     /// construction is completed.
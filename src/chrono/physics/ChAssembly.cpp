@@ -19,6 +19,7 @@
 #include "chrono/core/ChTransform.h"
 #include "chrono/physics/ChAssembly.h"
 #include "chrono/physics/ChSystem.h"
+#include "chrono/utils/ChProfiler.h"
 
 namespace chrono {
 
@@ -520,6 +521,15 @@ void ChAssembly::Setup() {
     ndof = ncoords_w - ndoc_w;
 }
 
+// Number of threads used in the per-item loops below, as set in the owning system.
+// With a single thread, no OpenMP parallel region is created at all.
+// Only loops where each item reads/writes its own data (or its own rows in the state vectors) are run in parallel,
+// so results do not depend on the number of threads. Links that load forces into their connected bodies, meshes
+// (parallel internally), and other physics items are always processed sequentially.
+int ChAssembly::GetNumThreads() const {
+    return system ? system->GetNumThreads() : 1;
+}
+
 // Update assembly's own properties first (ChTime and assets, if any).
 // Then update all contents of this assembly.
 void ChAssembly::Update(double mytime, bool update_assets) {
@@ -530,19 +540,33 @@ void ChAssembly::Update(double mytime, bool update_assets) {
 // Update all physical items (bodies, links, meshes, etc), including their auxiliary variables.
 // Updates all forces (automatic, as children of bodies)
 // Updates all markers (automatic, as children of bodies).
+// This is always done sequentially: item updates evaluate user ChFunctions (forces, motors) and update assets,
+// neither of which is required to be thread-safe.
 void ChAssembly::Update(bool update_assets) {
-    //// NOTE: do not switch these to range for loops (may want to use OMP for)
-    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
-        bodylist[ip]->Update(ChTime, update_assets);
+    //// NOTE: do not switch these to range for loops (OMP for)
+    {
+        CH_PROFILE("UpdateBodies");
+        for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+            bodylist[ip]->Update(ChTime, update_assets);
+        }
     }
-    for (int ip = 0; ip < (int)otherphysicslist.size(); ++ip) {
-        otherphysicslist[ip]->Update(ChTime, update_assets);
+    {
+        CH_PROFILE("UpdateOtherPhysics");
+        for (int ip = 0; ip < (int)otherphysicslist.size(); ++ip) {
+            otherphysicslist[ip]->Update(ChTime, update_assets);
+        }
     }
-    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
-        linklist[ip]->Update(ChTime, update_assets);
+    {
+        CH_PROFILE("UpdateLinks");
+        for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+            linklist[ip]->Update(ChTime, update_assets);
+        }
     }
-    for (int ip = 0; ip < (int)meshlist.size(); ++ip) {
-        meshlist[ip]->Update(ChTime, update_assets);
+    {
+        CH_PROFILE("UpdateMeshes");
+        for (int ip = 0; ip < (int)meshlist.size(); ++ip) {
+            meshlist[ip]->Update(ChTime, update_assets);
+        }
     }
 }
 
@@ -569,13 +593,19 @@ void ChAssembly::IntStateGather(const unsigned int off_x,
     unsigned int displ_x = off_x - this->offset_x;
     unsigned int displ_v = off_v - this->offset_w;
 
-    for (auto& body : bodylist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        auto& body = bodylist[ip];
+        double T_body;  // per-item copy: T is shared across threads and reset below anyway
         if (body->IsActive())
-            body->IntStateGather(displ_x + body->GetOffset_x(), x, displ_v + body->GetOffset_w(), v, T);
+            body->IntStateGather(displ_x + body->GetOffset_x(), x, displ_v + body->GetOffset_w(), v, T_body);
     }
-    for (auto& link : linklist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+        auto& link = linklist[ip];
+        double T_link;
         if (link->IsActive())
-            link->IntStateGather(displ_x + link->GetOffset_x(), x, displ_v + link->GetOffset_w(), v, T);
+            link->IntStateGather(displ_x + link->GetOffset_x(), x, displ_v + link->GetOffset_w(), v, T_link);
     }
     for (auto& mesh : meshlist) {
         mesh->IntStateGather(displ_x + mesh->GetOffset_x(), x, displ_v + mesh->GetOffset_w(), v, T);
@@ -598,6 +628,7 @@ void ChAssembly::IntStateScatter(const unsigned int off_x,
     // 2. Order below is *important*
     //    - in particular, bodies and meshes must be processed *before* links, so that links can use
     //      up-to-date body and node information
+    // 3. Because of the Update() calls, this is done sequentially (see Update).
 
     unsigned int displ_x = off_x - this->offset_x;
     unsigned int displ_v = off_v - this->offset_w;
@@ -626,11 +657,15 @@ void ChAssembly::IntStateScatter(const unsigned int off_x,
 void ChAssembly::IntStateGatherAcceleration(const unsigned int off_a, ChStateDelta& a) {
     unsigned int displ_a = off_a - this->offset_w;
 
-    for (auto& body : bodylist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        auto& body = bodylist[ip];
         if (body->IsActive())
             body->IntStateGatherAcceleration(displ_a + body->GetOffset_w(), a);
     }
-    for (auto& link : linklist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+        auto& link = linklist[ip];
         if (link->IsActive())
             link->IntStateGatherAcceleration(displ_a + link->GetOffset_w(), a);
     }
@@ -646,11 +681,15 @@ void ChAssembly::IntStateGatherAcceleration(const unsigned int off_a, ChStateDel
 void ChAssembly::IntStateScatterAcceleration(const unsigned int off_a, const ChStateDelta& a) {
     unsigned int displ_a = off_a - this->offset_w;
 
-    for (auto& body : bodylist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        auto& body = bodylist[ip];
         if (body->IsActive())
             body->IntStateScatterAcceleration(displ_a + body->GetOffset_w(), a);
     }
-    for (auto& link : linklist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+        auto& link = linklist[ip];
         if (link->IsActive())
             link->IntStateScatterAcceleration(displ_a + link->GetOffset_w(), a);
     }
@@ -666,11 +705,15 @@ void ChAssembly::IntStateScatterAcceleration(const unsigned int off_a, const ChS
 void ChAssembly::IntStateGatherReactions(const unsigned int off_L, ChVectorDynamic<>& L) {
     unsigned int displ_L = off_L - this->offset_L;
 
-    for (auto& body : bodylist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        auto& body = bodylist[ip];
         if (body->IsActive())
             body->IntStateGatherReactions(displ_L + body->GetOffset_L(), L);
     }
-    for (auto& link : linklist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+        auto& link = linklist[ip];
         if (link->IsActive())
             link->IntStateGatherReactions(displ_L + link->GetOffset_L(), L);
     }
@@ -686,11 +729,15 @@ void ChAssembly::IntStateGatherReactions(const unsigned int off_L, ChVectorDynam
 void ChAssembly::IntStateScatterReactions(const unsigned int off_L, const ChVectorDynamic<>& L) {
     unsigned int displ_L = off_L - this->offset_L;
 
-    for (auto& body : bodylist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        auto& body = bodylist[ip];
         if (body->IsActive())
             body->IntStateScatterReactions(displ_L + body->GetOffset_L(), L);
     }
-    for (auto& link : linklist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+        auto& link = linklist[ip];
         if (link->IsActive())
             link->IntStateScatterReactions(displ_L + link->GetOffset_L(), L);
     }
@@ -710,12 +757,16 @@ void ChAssembly::IntStateIncrement(const unsigned int off_x,
     unsigned int displ_x = off_x - this->offset_x;
     unsigned int displ_v = off_v - this->offset_w;
 
-    for (auto& body : bodylist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        auto& body = bodylist[ip];
         if (body->IsActive())
             body->IntStateIncrement(displ_x + body->GetOffset_x(), x_new, x, displ_v + body->GetOffset_w(), Dv);
     }
 
-    for (auto& link : linklist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+        auto& link = linklist[ip];
         if (link->IsActive())
             link->IntStateIncrement(displ_x + link->GetOffset_x(), x_new, x, displ_v + link->GetOffset_w(), Dv);
     }
@@ -735,7 +786,9 @@ void ChAssembly::IntLoadResidual_F(const unsigned int off,  ///< offset in R res
 {
     unsigned int displ_v = off - this->offset_w;
 
-    for (auto& body : bodylist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        auto& body = bodylist[ip];
         if (body->IsActive())
             body->IntLoadResidual_F(displ_v + body->GetOffset_w(), R, c);
     }
@@ -758,7 +811,9 @@ void ChAssembly::IntLoadResidual_Mv(const unsigned int off,      ///< offset in
 ) {
     unsigned int displ_v = off - this->offset_w;
 
-    for (auto& body : bodylist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        auto& body = bodylist[ip];
         if (body->IsActive())
             body->IntLoadResidual_Mv(displ_v + body->GetOffset_w(), R, w, c);
     }
@@ -805,11 +860,15 @@ void ChAssembly::IntLoadConstraint_C(const unsigned int off_L,  ///< offset in Q
 ) {
     unsigned int displ_L = off_L - this->offset_L;
 
-    for (auto& body : bodylist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        auto& body = bodylist[ip];
         if (body->IsActive())
             body->IntLoadConstraint_C(displ_L + body->GetOffset_L(), Qc, c, do_clamp, recovery_clamp);
     }
-    for (auto& link : linklist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+        auto& link = linklist[ip];
         if (link->IsActive())
             link->IntLoadConstraint_C(displ_L + link->GetOffset_L(), Qc, c, do_clamp, recovery_clamp);
     }
@@ -827,11 +886,15 @@ void ChAssembly::IntLoadConstraint_Ct(const unsigned int off_L,  ///< offset in
 ) {
     unsigned int displ_L = off_L - this->offset_L;
 
-    for (auto& body : bodylist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        auto& body = bodylist[ip];
         if (body->IsActive())
             body->IntLoadConstraint_Ct(displ_L + body->GetOffset_L(), Qc, c);
     }
-    for (auto& link : linklist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+        auto& link = linklist[ip];
         if (link->IsActive())
             link->IntLoadConstraint_Ct(displ_L + link->GetOffset_L(), Qc, c);
     }
@@ -852,12 +915,16 @@ void ChAssembly::IntToDescriptor(const unsigned int off_v,
     unsigned int displ_L = off_L - this->offset_L;
     unsigned int displ_v = off_v - this->offset_w;
 
-    for (auto& body : bodylist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        auto& body = bodylist[ip];
         if (body->IsActive())
             body->IntToDescriptor(displ_v + body->GetOffset_w(), v, R, displ_L + body->GetOffset_L(), L, Qc);
     }
 
-    for (auto& link : linklist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+        auto& link = linklist[ip];
         if (link->IsActive())
             link->IntToDescriptor(displ_v + link->GetOffset_w(), v, R, displ_L + link->GetOffset_L(), L, Qc);
     }
@@ -878,12 +945,16 @@ void ChAssembly::IntFromDescriptor(const unsigned int off_v,
     unsigned int displ_L = off_L - this->offset_L;
     unsigned int displ_v = off_v - this->offset_w;
 
-    for (auto& body : bodylist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        auto& body = bodylist[ip];
         if (body->IsActive())
             body->IntFromDescriptor(displ_v + body->GetOffset_w(), v, displ_L + body->GetOffset_L(), L);
     }
 
-    for (auto& link : linklist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+        auto& link = linklist[ip];
         if (link->IsActive())
             link->IntFromDescriptor(displ_v + link->GetOffset_w(), v, displ_L + link->GetOffset_L(), L);
     }
@@ -915,10 +986,14 @@ void ChAssembly::InjectVariables(ChSystemDescriptor& mdescriptor) {
 }
 
 void ChAssembly::VariablesFbReset() {
-    for (auto& body : bodylist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        auto& body = bodylist[ip];
         body->VariablesFbReset();
     }
-    for (auto& link : linklist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+        auto& link = linklist[ip];
         link->VariablesFbReset();
     }
     for (auto& mesh : meshlist) {
@@ -930,7 +1005,9 @@ void ChAssembly::VariablesFbReset() {
 }
 
 void ChAssembly::VariablesFbLoadForces(double factor) {
-    for (auto& body : bodylist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        auto& body = bodylist[ip];
         body->VariablesFbLoadForces(factor);
     }
     for (auto& link : linklist) {
@@ -945,7 +1022,9 @@ void ChAssembly::VariablesFbLoadForces(double factor) {
 }
 
 void ChAssembly::VariablesFbIncrementMq() {
-    for (auto& body : bodylist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        auto& body = bodylist[ip];
         body->VariablesFbIncrementMq();
     }
     for (auto& link : linklist) {
@@ -960,10 +1039,14 @@ void ChAssembly::VariablesFbIncrementMq() {
 }
 
 void ChAssembly::VariablesQbLoadSpeed() {
-    for (auto& body : bodylist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        auto& body = bodylist[ip];
         body->VariablesQbLoadSpeed();
     }
-    for (auto& link : linklist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+        auto& link = linklist[ip];
         link->VariablesQbLoadSpeed();
     }
     for (auto& mesh : meshlist) {
@@ -975,10 +1058,14 @@ void ChAssembly::VariablesQbLoadSpeed() {
 }
 
 void ChAssembly::VariablesQbSetSpeed(double step) {
-    for (auto& body : bodylist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        auto& body = bodylist[ip];
         body->VariablesQbSetSpeed(step);
     }
-    for (auto& link : linklist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+        auto& link = linklist[ip];
         link->VariablesQbSetSpeed(step);
     }
     for (auto& mesh : meshlist) {
@@ -990,10 +1077,14 @@ void ChAssembly::VariablesQbSetSpeed(double step) {
 }
 
 void ChAssembly::VariablesQbIncrementPosition(double dt_step) {
-    for (auto& body : bodylist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        auto& body = bodylist[ip];
         body->VariablesQbIncrementPosition(dt_step);
     }
-    for (auto& link : linklist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+        auto& link = linklist[ip];
         link->VariablesQbIncrementPosition(dt_step);
     }
     for (auto& mesh : meshlist) {
@@ -1020,10 +1111,14 @@ void ChAssembly::InjectConstraints(ChSystemDescriptor& mdescriptor) {
 }
 
 void ChAssembly::ConstraintsBiReset() {
-    for (auto& body : bodylist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        auto& body = bodylist[ip];
         body->ConstraintsBiReset();
     }
-    for (auto& link : linklist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+        auto& link = linklist[ip];
         link->ConstraintsBiReset();
     }
     for (auto& mesh : meshlist) {
@@ -1035,10 +1130,14 @@ void ChAssembly::ConstraintsBiReset() {
 }
 
 void ChAssembly::ConstraintsBiLoad_C(double factor, double recovery_clamp, bool do_clamp) {
-    for (auto& body : bodylist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        auto& body = bodylist[ip];
         body->ConstraintsBiLoad_C(factor, recovery_clamp, do_clamp);
     }
-    for (auto& link : linklist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+        auto& link = linklist[ip];
         link->ConstraintsBiLoad_C(factor, recovery_clamp, do_clamp);
     }
     for (auto& mesh : meshlist) {
@@ -1050,10 +1149,14 @@ void ChAssembly::ConstraintsBiLoad_C(double factor, double recovery_clamp, bool
 }
 
 void ChAssembly::ConstraintsBiLoad_Ct(double factor) {
-    for (auto& body : bodylist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        auto& body = bodylist[ip];
         body->ConstraintsBiLoad_Ct(factor);
     }
-    for (auto& link : linklist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+        auto& link = linklist[ip];
         link->ConstraintsBiLoad_Ct(factor);
     }
     for (auto& mesh : meshlist) {
@@ -1065,10 +1168,14 @@ void ChAssembly::ConstraintsBiLoad_Ct(double factor) {
 }
 
 void ChAssembly::ConstraintsBiLoad_Qc(double factor) {
-    for (auto& body : bodylist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        auto& body = bodylist[ip];
         body->ConstraintsBiLoad_Qc(factor);
     }
-    for (auto& link : linklist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+        auto& link = linklist[ip];
         link->ConstraintsBiLoad_Qc(factor);
     }
     for (auto& mesh : meshlist) {
@@ -1095,10 +1202,14 @@ void ChAssembly::ConstraintsFbLoadForces(double factor) {
 }
 
 void ChAssembly::ConstraintsLoadJacobians() {
-    for (auto& body : bodylist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        auto& body = bodylist[ip];
         body->ConstraintsLoadJacobians();
     }
-    for (auto& link : linklist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+        auto& link = linklist[ip];
         link->ConstraintsLoadJacobians();
     }
     for (auto& mesh : meshlist) {
@@ -1110,10 +1221,14 @@ void ChAssembly::ConstraintsLoadJacobians() {
 }
 
 void ChAssembly::ConstraintsFetch_react(double factor) {
-    for (auto& body : bodylist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        auto& body = bodylist[ip];
         body->ConstraintsFetch_react(factor);
     }
-    for (auto& link : linklist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+        auto& link = linklist[ip];
         link->ConstraintsFetch_react(factor);
     }
     for (auto& mesh : meshlist) {
@@ -1140,10 +1255,14 @@ void ChAssembly::InjectKRMmatrices(ChSystemDescriptor& mdescriptor) {
 }
 
 void ChAssembly::KRMmatricesLoad(double Kfactor, double Rfactor, double Mfactor) {
-    for (auto& body : bodylist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)bodylist.size(); ++ip) {
+        auto& body = bodylist[ip];
         body->KRMmatricesLoad(Kfactor, Rfactor, Mfactor);
     }
-    for (auto& link : linklist) {
+#pragma omp parallel for num_threads(GetNumThreads()) if (GetNumThreads() > 1)
+    for (int ip = 0; ip < (int)linklist.size(); ++ip) {
+        auto& link = linklist[ip];
         link->KRMmatricesLoad(Kfactor, Rfactor, Mfactor);
     }
     for (auto& mesh : meshlist) {
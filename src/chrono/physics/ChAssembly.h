@@ -295,6 +295,9 @@ class ChApi ChAssembly : public ChPhysicsItem {
   private:
     virtual void SetupInitial() override;
 
+    /// Number of threads for the per-item loops (from the owning system, if any).
+    int GetNumThreads() const;
+
     std::vector<std::shared_ptr<ChBody>> bodylist;                 ///< list of rigid bodies
     std::vector<std::shared_ptr<ChLinkBase>> linklist;             ///< list of joints (links)
     std::vector<std::shared_ptr<fea::ChMesh>> meshlist;            ///< list of meshes
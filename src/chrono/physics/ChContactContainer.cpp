@@ -22,6 +22,7 @@ namespace chrono {
 ChContactContainer::ChContactContainer(const ChContactContainer& other) : ChPhysicsItem(other) {
     add_contact_callback = other.add_contact_callback;
     report_contact_callback = other.report_contact_callback;
+    contact_pooling = other.contact_pooling;
 }
 
 void ChContactContainer::ArchiveOUT(ChArchiveOut& marchive) {
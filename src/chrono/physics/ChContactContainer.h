@@ -22,9 +22,11 @@
 
 #include <list>
 #include <unordered_map>
+#include <vector>
 
 #include "chrono/collision/ChCollisionInfo.h"
 #include "chrono/physics/ChBody.h"
+#include "chrono/physics/ChContactPool.h"
 #include "chrono/physics/ChContactable.h"
 #include "chrono/physics/ChMaterialSurface.h"
 
@@ -33,7 +35,7 @@ namespace chrono {
 /// Class representing a container of many contacts.
 class ChApi ChContactContainer : public ChPhysicsItem {
   public:
-    ChContactContainer() : add_contact_callback(nullptr), report_contact_callback(nullptr) {}
+    ChContactContainer() : add_contact_callback(nullptr), report_contact_callback(nullptr), contact_pooling(false) {}
     ChContactContainer(const ChContactContainer& other);
     virtual ~ChContactContainer() {}
 
@@ -64,6 +66,16 @@ class ChApi ChContactContainer : public ChPhysicsItem {
     /// similar).
     virtual void EndAddContact() {}
 
+    /// Enable or disable pooling of contact objects across steps (default: false).
+    /// If enabled, contact objects which were not reused during the last collision detection pass are kept alive
+    /// (rather than destroyed in EndAddContact) and recycled in later steps, so that a simulation with a fluctuating
+    /// number of contacts does not allocate once the peak number of contacts was reached. This comes at the price of
+    /// retaining the memory for that peak number of contacts. Note that derived classes may not support this.
+    void SetContactPooling(bool val) { contact_pooling = val; }
+
+    /// Return true if contact objects are pooled across steps.
+    bool GetContactPooling() const { return contact_pooling; }
+
     /// Class to be used as a callback interface for some user defined action to be taken
     /// each time a contact is added to the container.
     /// It can be used to modify the composite material properties for the contact pair.
@@ -115,6 +127,11 @@ class ChApi ChContactContainer : public ChPhysicsItem {
     /// object.
     virtual void ReportAllContacts(std::shared_ptr<ReportContactCallback> callback) {}
 
+    /// Append the collision information of all contacts to the given list, in the same order as their reactions in
+    /// the system-level vectors. Adding these contacts, in this order, to an empty container re-creates the current
+    /// contacts. Return false if not supported by this container.
+    virtual bool GetContactsInfo(std::vector<collision::ChCollisionInfo>& cinfos) { return false; }
+
     /// Compute contact forces on all contactable objects in this container.
     virtual void ComputeContactForces() {}
 
@@ -138,58 +155,61 @@ class ChApi ChContactContainer : public ChPhysicsItem {
 
     std::shared_ptr<AddContactCallback> add_contact_callback;
     ReportContactCallback* report_contact_callback;
+    bool contact_pooling;
 
-    /// Utility function to accumulate contact forces from a specified list of contacts.
+    /// Utility function to accumulate contact forces from a specified pool of contacts.
     /// This function is templated by the contact type (assumed to be derived from ChContactTuple).
     /// Contact forces are accumulated in a map keyed by the contactable objects.
     /// Derived ChContactContainer classes can use this utility (processing their various lists
     /// of contacts) to cache information used for reporting through GetContactableForce and
     /// GetContactableTorque.
     template <class Tcont>
-    void SumAllContactForces(std::list<Tcont*>& contactlist,
+    void SumAllContactForces(ChContactPool<Tcont>& contactlist,
                              std::unordered_map<ChContactable*, ForceTorque>& contactforces) {
-        for (auto contact = contactlist.begin(); contact != contactlist.end(); ++contact) {
+        for (size_t i = 0; i < contactlist.size(); i++) {
+            Tcont* contact = contactlist[i];
+
             // Extract information for current contact (expressed in global frame)
-            ChMatrix33<> A = (*contact)->GetContactPlane();
-            ChVector<> force_loc = (*contact)->GetContactForce();
+            ChMatrix33<> A = contact->GetContactPlane();
+            ChVector<> force_loc = contact->GetContactForce();
             ChVector<> force = A * force_loc;
-            ChVector<> p1 = (*contact)->GetContactP1();
-            ChVector<> p2 = (*contact)->GetContactP2();
+            ChVector<> p1 = contact->GetContactP1();
+            ChVector<> p2 = contact->GetContactP2();
 
             // Calculate contact torque for first object (expressed in global frame).
             // Recall that -force is applied to the first object.
             ChVector<> torque1(0);
-            if (ChBody* body = dynamic_cast<ChBody*>((*contact)->GetObjA())) {
+            if (ChBody* body = dynamic_cast<ChBody*>(contact->GetObjA())) {
                 torque1 = Vcross(p1 - body->GetPos(), -force);
             }
 
             // If there is already an entry for the first object, accumulate.
             // Otherwise, insert a new entry.
-            auto entry1 = contactforces.find((*contact)->GetObjA());
+            auto entry1 = contactforces.find(contact->GetObjA());
             if (entry1 != contactforces.end()) {
                 entry1->second.force -= force;
                 entry1->second.torque += torque1;
             } else {
                 ForceTorque ft{-force, torque1};
-                contactforces.insert(std::make_pair((*contact)->GetObjA(), ft));
+                contactforces.insert(std::make_pair(contact->GetObjA(), ft));
             }
 
             // Calculate contact torque for second object (expressed in global frame).
             // Recall that +force is applied to the second object.
             ChVector<> torque2(0);
-            if (ChBody* body = dynamic_cast<ChBody*>((*contact)->GetObjB())) {
+            if (ChBody* body = dynamic_cast<ChBody*>(contact->GetObjB())) {
                 torque2 = Vcross(p2 - body->GetPos(), force);
             }
 
             // If there is already an entry for the first object, accumulate.
             // Otherwise, insert a new entry.
-            auto entry2 = contactforces.find((*contact)->GetObjB());
+            auto entry2 = contactforces.find(contact->GetObjB());
             if (entry2 != contactforces.end()) {
                 entry2->second.force += force;
                 entry2->second.torque += torque2;
             } else {
                 ForceTorque ft{force, torque2};
-                contactforces.insert(std::make_pair((*contact)->GetObjB(), ft));
+                contactforces.insert(std::make_pair(contact->GetObjB(), ft));
             }
         }
     }
@@ -12,6 +12,8 @@
 // Authors: Alessandro Tasora, Radu Serban
 // =============================================================================
 
+#include <functional>
+
 #include "chrono/physics/ChContactContainerNSC.h"
 #include "chrono/physics/ChSystem.h"
 #include "chrono/solver/ChConstraintTwoTuplesContactN.h"
@@ -25,31 +27,13 @@ using namespace geometry;
 CH_FACTORY_REGISTER(ChContactContainerNSC)
 
 ChContactContainerNSC::ChContactContainerNSC()
-    : n_added_6_6(0),
-      n_added_6_3(0),
-      n_added_3_3(0),
-      n_added_333_3(0),
-      n_added_333_6(0),
-      n_added_333_333(0),
-      n_added_666_3(0),
-      n_added_666_6(0),
-      n_added_666_333(0),
-      n_added_666_666(0),
-      n_added_6_6_rolling(0) {}
-
-ChContactContainerNSC::ChContactContainerNSC(const ChContactContainerNSC& other) : ChContactContainer(other) {
-    n_added_6_6 = 0;
-    n_added_6_3 = 0;
-    n_added_3_3 = 0;
-    n_added_333_3 = 0;
-    n_added_333_6 = 0;
-    n_added_333_333 = 0;
-    n_added_666_3 = 0;
-    n_added_666_6 = 0;
-    n_added_666_333 = 0;
-    n_added_666_666 = 0;
-    n_added_6_6_rolling = 0;
-}
+    : persistent_contacts(false), persistent_tolerance(0.01), persistent_matched(0) {}
+
+ChContactContainerNSC::ChContactContainerNSC(const ChContactContainerNSC& other)
+    : ChContactContainer(other),
+      persistent_contacts(other.persistent_contacts),
+      persistent_tolerance(other.persistent_tolerance),
+      persistent_matched(0) {}
 
 ChContactContainerNSC::~ChContactContainerNSC() {
     RemoveAllContacts();
@@ -60,138 +44,88 @@ void ChContactContainerNSC::Update(double mytime, bool update_assets) {
     ChContactContainer::Update(mytime, update_assets);
 }
 
-template <class Tcont, class Titer>
-void _RemoveAllContacts(std::list<Tcont*>& contactlist, Titer& lastcontact, int& n_added) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        delete (*itercontact);
-        (*itercontact) = 0;
-        ++itercontact;
-    }
-    contactlist.clear();
-    lastcontact = contactlist.begin();
-    n_added = 0;
-}
-
 void ChContactContainerNSC::RemoveAllContacts() {
-    _RemoveAllContacts(contactlist_6_6, lastcontact_6_6, n_added_6_6);
-    _RemoveAllContacts(contactlist_6_3, lastcontact_6_3, n_added_6_3);
-    _RemoveAllContacts(contactlist_3_3, lastcontact_3_3, n_added_3_3);
-    _RemoveAllContacts(contactlist_333_3, lastcontact_333_3, n_added_333_3);
-    _RemoveAllContacts(contactlist_333_6, lastcontact_333_6, n_added_333_6);
-    _RemoveAllContacts(contactlist_333_333, lastcontact_333_333, n_added_333_333);
-    _RemoveAllContacts(contactlist_666_3, lastcontact_666_3, n_added_666_3);
-    _RemoveAllContacts(contactlist_666_6, lastcontact_666_6, n_added_666_6);
-    _RemoveAllContacts(contactlist_666_333, lastcontact_666_333, n_added_666_333);
-    _RemoveAllContacts(contactlist_666_666, lastcontact_666_666, n_added_666_666);
-    _RemoveAllContacts(contactlist_6_6_rolling, lastcontact_6_6_rolling, n_added_6_6_rolling);
+    contactlist_6_6.Clear();
+    contactlist_6_3.Clear();
+    contactlist_3_3.Clear();
+    contactlist_333_3.Clear();
+    contactlist_333_6.Clear();
+    contactlist_333_333.Clear();
+    contactlist_666_3.Clear();
+    contactlist_666_6.Clear();
+    contactlist_666_333.Clear();
+    contactlist_666_666.Clear();
+    contactlist_6_6_rolling.Clear();
+
+    records.clear();
+    records_prev.clear();
+    records_map.clear();
+    records_prev_map.clear();
+    persistent_matched = 0;
 }
 
 void ChContactContainerNSC::BeginAddContact() {
-    lastcontact_6_6 = contactlist_6_6.begin();
-    n_added_6_6 = 0;
-
-    lastcontact_6_3 = contactlist_6_3.begin();
-    n_added_6_3 = 0;
-
-    lastcontact_3_3 = contactlist_3_3.begin();
-    n_added_3_3 = 0;
-
-    lastcontact_333_3 = contactlist_333_3.begin();
-    n_added_333_3 = 0;
-
-    lastcontact_333_6 = contactlist_333_6.begin();
-    n_added_333_6 = 0;
-
-    lastcontact_333_333 = contactlist_333_333.begin();
-    n_added_333_333 = 0;
-
-    lastcontact_666_3 = contactlist_666_3.begin();
-    n_added_666_3 = 0;
-
-    lastcontact_666_6 = contactlist_666_6.begin();
-    n_added_666_6 = 0;
-
-    lastcontact_666_333 = contactlist_666_333.begin();
-    n_added_666_333 = 0;
-
-    lastcontact_666_666 = contactlist_666_666.begin();
-    n_added_666_666 = 0;
-
-    lastcontact_6_6_rolling = contactlist_6_6_rolling.begin();
-    n_added_6_6_rolling = 0;
+    contactlist_6_6.Rewind();
+    contactlist_6_3.Rewind();
+    contactlist_3_3.Rewind();
+    contactlist_333_3.Rewind();
+    contactlist_333_6.Rewind();
+    contactlist_333_333.Rewind();
+    contactlist_666_3.Rewind();
+    contactlist_666_6.Rewind();
+    contactlist_666_333.Rewind();
+    contactlist_666_666.Rewind();
+    contactlist_6_6_rolling.Rewind();
+
+    // The persistent data of the current contacts become the data of the previous step
+    persistent_matched = 0;
+    if (persistent_contacts) {
+        records_prev.swap(records);
+        records_prev_map.swap(records_map);
+        records.clear();
+        records_map.clear();
+    } else if (!records.empty() || !records_prev.empty()) {
+        records.clear();
+        records_prev.clear();
+        records_map.clear();
+        records_prev_map.clear();
+    }
 }
 
 void ChContactContainerNSC::EndAddContact() {
-    // remove contacts that are beyond last contact
-    while (lastcontact_6_6 != contactlist_6_6.end()) {
-        delete (*lastcontact_6_6);
-        lastcontact_6_6 = contactlist_6_6.erase(lastcontact_6_6);
-    }
-    while (lastcontact_6_3 != contactlist_6_3.end()) {
-        delete (*lastcontact_6_3);
-        lastcontact_6_3 = contactlist_6_3.erase(lastcontact_6_3);
-    }
-    while (lastcontact_3_3 != contactlist_3_3.end()) {
-        delete (*lastcontact_3_3);
-        lastcontact_3_3 = contactlist_3_3.erase(lastcontact_3_3);
-    }
-    while (lastcontact_333_3 != contactlist_333_3.end()) {
-        delete (*lastcontact_333_3);
-        lastcontact_333_3 = contactlist_333_3.erase(lastcontact_333_3);
-    }
-    while (lastcontact_333_6 != contactlist_333_6.end()) {
-        delete (*lastcontact_333_6);
-        lastcontact_333_6 = contactlist_333_6.erase(lastcontact_333_6);
-    }
-    while (lastcontact_333_333 != contactlist_333_333.end()) {
-        delete (*lastcontact_333_333);
-        lastcontact_333_333 = contactlist_333_333.erase(lastcontact_333_333);
-    }
-    while (lastcontact_666_3 != contactlist_666_3.end()) {
-        delete (*lastcontact_666_3);
-        lastcontact_666_3 = contactlist_666_3.erase(lastcontact_666_3);
-    }
-    while (lastcontact_666_6 != contactlist_666_6.end()) {
-        delete (*lastcontact_666_6);
-        lastcontact_666_6 = contactlist_666_6.erase(lastcontact_666_6);
-    }
-    while (lastcontact_666_333 != contactlist_666_333.end()) {
-        delete (*lastcontact_666_333);
-        lastcontact_666_333 = contactlist_666_333.erase(lastcontact_666_333);
-    }
-    while (lastcontact_666_666 != contactlist_666_666.end()) {
-        delete (*lastcontact_666_666);
-        lastcontact_666_666 = contactlist_666_666.erase(lastcontact_666_666);
-    }
-
-    while (lastcontact_6_6_rolling != contactlist_6_6_rolling.end()) {
-        delete (*lastcontact_6_6_rolling);
-        lastcontact_6_6_rolling = contactlist_6_6_rolling.erase(lastcontact_6_6_rolling);
-    }
-}
+    // keep the contacts that were not reused, if pooling is enabled
+    if (contact_pooling)
+        return;
 
-template <class Tcont, class Titer, class Ta, class Tb>
-void _OptimalContactInsert(std::list<Tcont*>& contactlist,           // contact list
-                           Titer& lastcontact,                       // last contact acquired
-                           int& n_added,                             // number of contacts inserted
+    // remove contacts that are beyond last contact
+    contactlist_6_6.Trim();
+    contactlist_6_3.Trim();
+    contactlist_3_3.Trim();
+    contactlist_333_3.Trim();
+    contactlist_333_6.Trim();
+    contactlist_333_333.Trim();
+    contactlist_666_3.Trim();
+    contactlist_666_6.Trim();
+    contactlist_666_333.Trim();
+    contactlist_666_666.Trim();
+    contactlist_6_6_rolling.Trim();
+}
+
+template <class Tcont, class Ta, class Tb>
+void _OptimalContactInsert(ChContactPool<Tcont>& contactlist,        // contact pool
                            ChContactContainer* container,            // contact container
                            Ta* objA,                                 // collidable object A
                            Tb* objB,                                 // collidable object B
                            const collision::ChCollisionInfo& cinfo,  // collision information
                            const ChMaterialCompositeNSC& cmat        // composite material
 ) {
-    if (lastcontact != contactlist.end()) {
+    if (Tcont* mc = contactlist.Recycle()) {
         // reuse old contacts
-        (*lastcontact)->Reset(objA, objB, cinfo, cmat);
-        lastcontact++;
+        mc->Reset(objA, objB, cinfo, cmat);
     } else {
         // add new contact
-        Tcont* mc = new Tcont(container, objA, objB, cinfo, cmat);
-        contactlist.push_back(mc);
-        lastcontact = contactlist.end();
+        contactlist.Emplace(container, objA, objB, cinfo, cmat);
     }
-    n_added++;
 }
 
 void ChContactContainerNSC::AddContact(const collision::ChCollisionInfo& cinfo,
@@ -251,6 +185,106 @@ void ChContactContainerNSC::AddContact(const collision::ChCollisionInfo& cinfo)
 }
 
 void ChContactContainerNSC::InsertContact(const collision::ChCollisionInfo& cinfo, const ChMaterialCompositeNSC& cmat) {
+    if (!persistent_contacts) {
+        CreateContact(cinfo, cmat);
+        return;
+    }
+
+    // Use the persistent data of this container as reaction cache for the new contact. The record is matched with the
+    // contactables in the order used by CreateContact, so that the cached reactions refer to its contact frame.
+    collision::ChCollisionInfo pcinfo(cinfo, SwapOnCreation(cinfo));
+    pcinfo.reaction_cache = MatchContact(pcinfo);
+    CreateContact(pcinfo, cmat);
+}
+
+// Return true if CreateContact swaps the two contactables of the given pair. The contactable with the more complex
+// type is always placed first (666, 333, 6, 3).
+bool ChContactContainerNSC::SwapOnCreation(const collision::ChCollisionInfo& cinfo) {
+    auto rank = [](ChContactable::eChContactableType type) {
+        switch (type) {
+            case ChContactable::CONTACTABLE_666:
+                return 3;
+            case ChContactable::CONTACTABLE_333:
+                return 2;
+            case ChContactable::CONTACTABLE_6:
+                return 1;
+            default:
+                return 0;
+        }
+    };
+    return rank(cinfo.modelB->GetContactable()->GetContactableType()) >
+           rank(cinfo.modelA->GetContactable()->GetContactableType());
+}
+
+// Create a persistent record for the given contact. If a contact between the same shapes, with contact points within
+// the specified tolerance, was found at the previous step, initialize the record reactions from the closest such
+// contact. Return a pointer to the record reactions.
+// The collision system may report the two models of a pair in either order. Records are found with a key independent
+// of this order, and a matching contact of the previous step may have its two sides swapped.
+float* ChContactContainerNSC::MatchContact(const collision::ChCollisionInfo& cinfo) {
+    ContactRecord rec;
+    rec.modelA = cinfo.modelA;
+    rec.shapeA = cinfo.shapeA;
+    rec.shapeB = cinfo.shapeB;
+    rec.ptA = cinfo.modelA->GetContactable()->GetCsysForCollisionModel().TransformPointParentToLocal(cinfo.vpA);
+    rec.ptB = cinfo.modelB->GetContactable()->GetCsysForCollisionModel().TransformPointParentToLocal(cinfo.vpB);
+    rec.normal = cinfo.vN;
+    rec.reactions[0] = rec.reactions[1] = rec.reactions[2] = 0;
+    rec.matched = false;
+
+    ModelPair key = std::less<collision::ChCollisionModel*>()(cinfo.modelB, cinfo.modelA)
+                        ? ModelPair(cinfo.modelB, cinfo.modelA)
+                        : ModelPair(cinfo.modelA, cinfo.modelB);
+
+    auto itr = records_prev_map.find(key);
+    if (itr != records_prev_map.end()) {
+        ContactRecord* best = nullptr;
+        bool best_swapped = false;
+        double best_dist = persistent_tolerance;
+        for (auto i : itr->second) {
+            auto& prev = records_prev[i];
+            if (prev.matched)
+                continue;
+            bool swapped = prev.modelA != rec.modelA;
+            const auto& prev_shapeA = swapped ? prev.shapeB : prev.shapeA;
+            const auto& prev_shapeB = swapped ? prev.shapeA : prev.shapeB;
+            const auto& prev_ptA = swapped ? prev.ptB : prev.ptA;
+            const auto& prev_ptB = swapped ? prev.ptA : prev.ptB;
+            if (prev_shapeA != rec.shapeA || prev_shapeB != rec.shapeB)
+                continue;
+            double dist = ChMax((prev_ptA - rec.ptA).Length(), (prev_ptB - rec.ptB).Length());
+            if (dist <= best_dist) {
+                best = &prev;
+                best_swapped = swapped;
+                best_dist = dist;
+            }
+        }
+        if (best) {
+            best->matched = true;
+            // The tangent directions of the contact plane are derived from the normal (see ChContactTuple) and may
+            // change arbitrarily between steps, e.g. for normals close to the Y axis. The tangential reaction is
+            // carried over in absolute coordinates and expressed in the plane of the new contact. If the pair is
+            // swapped, the reaction is the one acting on the other side and changes sign.
+            ChVector<> Vx, Vy, Vz;
+            XdirToDxDyDz(best->normal, VECT_Y, Vx, Vy, Vz);
+            ChVector<> Ft = Vy * best->reactions[1] + Vz * best->reactions[2];
+            if (best_swapped)
+                Ft = -Ft;
+            XdirToDxDyDz(rec.normal, VECT_Y, Vx, Vy, Vz);
+            rec.reactions[0] = best->reactions[0];
+            rec.reactions[1] = (float)Ft.Dot(Vy);
+            rec.reactions[2] = (float)Ft.Dot(Vz);
+            persistent_matched++;
+        }
+    }
+
+    records.push_back(rec);
+    records_map[key].push_back(records.size() - 1);
+
+    return records.back().reactions;
+}
+
+void ChContactContainerNSC::CreateContact(const collision::ChCollisionInfo& cinfo, const ChMaterialCompositeNSC& cmat) {
     auto contactableA = cinfo.modelA->GetContactable();
     auto contactableB = cinfo.modelB->GetContactable();
 
@@ -271,22 +305,22 @@ void ChContactContainerNSC::InsertContact(const collision::ChCollisionInfo& cinf
             if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
                 auto objB = static_cast<ChContactable_1vars<3>*>(contactableB);
                 // 3_3
-                _OptimalContactInsert(contactlist_3_3, lastcontact_3_3, n_added_3_3, this, objA, objB, cinfo, cmat);
+                _OptimalContactInsert(contactlist_3_3, this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
                 auto objB = static_cast<ChContactable_1vars<6>*>(contactableB);
                 // 3_6 -> 6_3
                 collision::ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_6_3, lastcontact_6_3, n_added_6_3, this, objB, objA, swapped_cinfo, cmat);
+                _OptimalContactInsert(contactlist_6_3, this, objB, objA, swapped_cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
                 auto objB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
                 // 3_333 -> 333_3
                 collision::ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_333_3, lastcontact_333_3, n_added_333_3, this, objB, objA, swapped_cinfo, cmat);
+                _OptimalContactInsert(contactlist_333_3, this, objB, objA, swapped_cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
                 auto objB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
                 // 3_666 -> 666_3
                 collision::ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_666_3, lastcontact_666_3, n_added_666_3, this, objB, objA, swapped_cinfo, cmat);
+                _OptimalContactInsert(contactlist_666_3, this, objB, objA, swapped_cinfo, cmat);
             }
         } break;
 
@@ -295,25 +329,25 @@ void ChContactContainerNSC::InsertContact(const collision::ChCollisionInfo& cinf
             if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
                 auto objB = static_cast<ChContactable_1vars<3>*>(contactableB);
                 // 6_3
-                _OptimalContactInsert(contactlist_6_3, lastcontact_6_3, n_added_6_3, this, objA, objB, cinfo, cmat);
+                _OptimalContactInsert(contactlist_6_3, this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
                 auto objB = static_cast<ChContactable_1vars<6>*>(contactableB);
                 // 6_6    ***NOTE: for body-body one could have rolling friction: ***
                 if (cmat.rolling_friction || cmat.spinning_friction) {
-                    _OptimalContactInsert(contactlist_6_6_rolling, lastcontact_6_6_rolling, n_added_6_6_rolling, this, objA, objB, cinfo, cmat);
+                    _OptimalContactInsert(contactlist_6_6_rolling, this, objA, objB, cinfo, cmat);
                 } else {
-                    _OptimalContactInsert(contactlist_6_6, lastcontact_6_6, n_added_6_6, this, objA, objB, cinfo, cmat);
+                    _OptimalContactInsert(contactlist_6_6, this, objA, objB, cinfo, cmat);
                 }
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
                 auto objB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
                 // 6_333 -> 333_6
                 collision::ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_333_6, lastcontact_333_6, n_added_333_6, this, objB, objA, swapped_cinfo, cmat);
+                _OptimalContactInsert(contactlist_333_6, this, objB, objA, swapped_cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
                 auto objB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
                 // 6_666 -> 666_6
                 collision::ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_666_6, lastcontact_666_6, n_added_666_6, this, objB, objA, swapped_cinfo, cmat);
+                _OptimalContactInsert(contactlist_666_6, this, objB, objA, swapped_cinfo, cmat);
             }
         } break;
 
@@ -322,20 +356,20 @@ void ChContactContainerNSC::InsertContact(const collision::ChCollisionInfo& cinf
             if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
                 auto objB = static_cast<ChContactable_1vars<3>*>(contactableB);
                 // 333_3
-                _OptimalContactInsert(contactlist_333_3, lastcontact_333_3, n_added_333_3, this, objA, objB, cinfo, cmat);
+                _OptimalContactInsert(contactlist_333_3, this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
                 auto objB = static_cast<ChContactable_1vars<6>*>(contactableB);
                 // 333_6
-                _OptimalContactInsert(contactlist_333_6, lastcontact_333_6, n_added_333_6, this, objA, objB, cinfo, cmat);
+                _OptimalContactInsert(contactlist_333_6, this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
                 auto objB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
                 // 333_333
-                _OptimalContactInsert(contactlist_333_333, lastcontact_333_333, n_added_333_333, this, objA, objB, cinfo, cmat);
+                _OptimalContactInsert(contactlist_333_333, this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
                 auto objB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
                 // 333_666 -> 666_333
                 collision::ChCollisionInfo swapped_cinfo(cinfo, true);
-                _OptimalContactInsert(contactlist_666_333, lastcontact_666_333, n_added_666_333, this, objB, objA, swapped_cinfo, cmat);
+                _OptimalContactInsert(contactlist_666_333, this, objB, objA, swapped_cinfo, cmat);
             }
         } break;
 
@@ -344,19 +378,19 @@ void ChContactContainerNSC::InsertContact(const collision::ChCollisionInfo& cinf
             if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_3) {
                 auto objB = static_cast<ChContactable_1vars<3>*>(contactableB);
                 // 666_3
-                _OptimalContactInsert(contactlist_666_3, lastcontact_666_3, n_added_666_3, this, objA, objB, cinfo, cmat);
+                _OptimalContactInsert(contactlist_666_3, this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_6) {
                 auto objB = static_cast<ChContactable_1vars<6>*>(contactableB);
                 // 666_6
-                _OptimalContactInsert(contactlist_666_6, lastcontact_666_6, n_added_666_6, this, objA, objB, cinfo, cmat);
+                _OptimalContactInsert(contactlist_666_6, this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_333) {
                 auto objB = static_cast<ChContactable_3vars<3, 3, 3>*>(contactableB);
                 // 666_333
-                _OptimalContactInsert(contactlist_666_333, lastcontact_666_333, n_added_666_333, this, objA, objB, cinfo, cmat);
+                _OptimalContactInsert(contactlist_666_333, this, objA, objB, cinfo, cmat);
             } else if (contactableB->GetContactableType() == ChContactable::CONTACTABLE_666) {
                 auto objB = static_cast<ChContactable_3vars<6, 6, 6>*>(contactableB);
                 // 666_666
-                _OptimalContactInsert(contactlist_666_666, lastcontact_666_666, n_added_666_666, this, objA, objB, cinfo, cmat);
+                _OptimalContactInsert(contactlist_666_666, this, objA, objB, cinfo, cmat);
             }
         } break;
 
@@ -399,31 +433,28 @@ ChVector<> ChContactContainerNSC::GetContactableTorque(ChContactable* contactabl
 }
 
 template <class Tcont>
-void _ReportAllContacts(std::list<Tcont*>& contactlist, ChContactContainer::ReportContactCallback* mcallback) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
+void _ReportAllContacts(ChContactPool<Tcont>& contactlist, ChContactContainer::ReportContactCallback* mcallback) {
+    for (size_t i = 0; i < contactlist.size(); i++) {
         bool proceed = mcallback->OnReportContact(
-            (*itercontact)->GetContactP1(), (*itercontact)->GetContactP2(), (*itercontact)->GetContactPlane(),
-            (*itercontact)->GetContactDistance(), (*itercontact)->GetEffectiveCurvatureRadius(),
-            (*itercontact)->GetContactForce(), VNULL, (*itercontact)->GetObjA(), (*itercontact)->GetObjB());
+            contactlist[i]->GetContactP1(), contactlist[i]->GetContactP2(), contactlist[i]->GetContactPlane(),
+            contactlist[i]->GetContactDistance(), contactlist[i]->GetEffectiveCurvatureRadius(),
+            contactlist[i]->GetContactForce(), VNULL, contactlist[i]->GetObjA(), contactlist[i]->GetObjB());
         if (!proceed)
             break;
-        ++itercontact;
     }
 }
 
 template <class Tcont>
-void _ReportAllContactsRolling(std::list<Tcont*>& contactlist, ChContactContainer::ReportContactCallback* mcallback) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
+void _ReportAllContactsRolling(ChContactPool<Tcont>& contactlist,
+                               ChContactContainer::ReportContactCallback* mcallback) {
+    for (size_t i = 0; i < contactlist.size(); i++) {
         bool proceed = mcallback->OnReportContact(
-            (*itercontact)->GetContactP1(), (*itercontact)->GetContactP2(), (*itercontact)->GetContactPlane(),
-            (*itercontact)->GetContactDistance(), (*itercontact)->GetEffectiveCurvatureRadius(),
-            (*itercontact)->GetContactForce(), (*itercontact)->GetContactTorque(), (*itercontact)->GetObjA(),
-            (*itercontact)->GetObjB());
+            contactlist[i]->GetContactP1(), contactlist[i]->GetContactP2(), contactlist[i]->GetContactPlane(),
+            contactlist[i]->GetContactDistance(), contactlist[i]->GetEffectiveCurvatureRadius(),
+            contactlist[i]->GetContactForce(), contactlist[i]->GetContactTorque(), contactlist[i]->GetObjA(),
+            contactlist[i]->GetObjB());
         if (!proceed)
             break;
-        ++itercontact;
     }
 }
 
@@ -441,19 +472,38 @@ void ChContactContainerNSC::ReportAllContacts(std::shared_ptr<ReportContactCallb
     _ReportAllContactsRolling(contactlist_6_6_rolling, callback.get());
 }
 
+template <class Tcont>
+void _GetContactsInfo(ChContactPool<Tcont>& contactlist, std::vector<collision::ChCollisionInfo>& cinfos) {
+    for (size_t i = 0; i < contactlist.size(); i++)
+        cinfos.push_back(contactlist[i]->GetCollisionInfo());
+}
+
+bool ChContactContainerNSC::GetContactsInfo(std::vector<collision::ChCollisionInfo>& cinfos) {
+    _GetContactsInfo(contactlist_6_6, cinfos);
+    _GetContactsInfo(contactlist_6_3, cinfos);
+    _GetContactsInfo(contactlist_3_3, cinfos);
+    _GetContactsInfo(contactlist_333_3, cinfos);
+    _GetContactsInfo(contactlist_333_6, cinfos);
+    _GetContactsInfo(contactlist_333_333, cinfos);
+    _GetContactsInfo(contactlist_666_3, cinfos);
+    _GetContactsInfo(contactlist_666_6, cinfos);
+    _GetContactsInfo(contactlist_666_333, cinfos);
+    _GetContactsInfo(contactlist_666_666, cinfos);
+    _GetContactsInfo(contactlist_6_6_rolling, cinfos);
+    return true;
+}
+
 ////////// STATE INTERFACE ////
 
 template <class Tcont>
 void _IntStateGatherReactions(unsigned int& coffset,
-                              std::list<Tcont*>& contactlist,
+                              ChContactPool<Tcont>& contactlist,
                               const unsigned int off_L,
                               ChVectorDynamic<>& L,
                               const int stride) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ContIntStateGatherReactions(off_L + coffset, L);
+    for (size_t i = 0; i < contactlist.size(); i++) {
+        contactlist[i]->ContIntStateGatherReactions(off_L + coffset, L);
         coffset += stride;
-        ++itercontact;
     }
 }
 
@@ -474,15 +524,13 @@ void ChContactContainerNSC::IntStateGatherReactions(const unsigned int off_L, Ch
 
 template <class Tcont>
 void _IntStateScatterReactions(unsigned int& coffset,
-                               std::list<Tcont*>& contactlist,
+                               ChContactPool<Tcont>& contactlist,
                                const unsigned int off_L,
                                const ChVectorDynamic<>& L,
                                const int stride) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ContIntStateScatterReactions(off_L + coffset, L);
+    for (size_t i = 0; i < contactlist.size(); i++) {
+        contactlist[i]->ContIntStateScatterReactions(off_L + coffset, L);
         coffset += stride;
-        ++itercontact;
     }
 }
 
@@ -502,19 +550,17 @@ void ChContactContainerNSC::IntStateScatterReactions(const unsigned int off_L, c
 }
 
 template <class Tcont>
-void _IntLoadResidual_CqL(unsigned int& coffset,           // offset of the contacts
-                          std::list<Tcont*>& contactlist,  // list of contacts
-                          const unsigned int off_L,        // offset in L multipliers
-                          ChVectorDynamic<>& R,            // result: the R residual, R += c*Cq'*L
-                          const ChVectorDynamic<>& L,      // the L vector
-                          const double c,                  // a scaling factor
-                          const int stride                 // stride
+void _IntLoadResidual_CqL(unsigned int& coffset,              // offset of the contacts
+                          ChContactPool<Tcont>& contactlist,  // list of contacts
+                          const unsigned int off_L,           // offset in L multipliers
+                          ChVectorDynamic<>& R,               // result: the R residual, R += c*Cq'*L
+                          const ChVectorDynamic<>& L,         // the L vector
+                          const double c,                     // a scaling factor
+                          const int stride                    // stride
 ) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ContIntLoadResidual_CqL(off_L + coffset, R, L, c);
+    for (size_t i = 0; i < contactlist.size(); i++) {
+        contactlist[i]->ContIntLoadResidual_CqL(off_L + coffset, R, L, c);
         coffset += stride;
-        ++itercontact;
     }
 }
 
@@ -537,20 +583,18 @@ void ChContactContainerNSC::IntLoadResidual_CqL(const unsigned int off_L,
 }
 
 template <class Tcont>
-void _IntLoadConstraint_C(unsigned int& coffset,           // contact offset
-                          std::list<Tcont*>& contactlist,  // contact list
-                          const unsigned int off,          // offset in Qc residual
-                          ChVectorDynamic<>& Qc,           // result: the Qc residual, Qc += c*C
-                          const double c,                  // a scaling factor
-                          bool do_clamp,                   // apply clamping to c*C?
-                          double recovery_clamp,           // value for min/max clamping of c*C
-                          const int stride                 // stride
+void _IntLoadConstraint_C(unsigned int& coffset,              // contact offset
+                          ChContactPool<Tcont>& contactlist,  // contact list
+                          const unsigned int off,             // offset in Qc residual
+                          ChVectorDynamic<>& Qc,              // result: the Qc residual, Qc += c*C
+                          const double c,                     // a scaling factor
+                          bool do_clamp,                      // apply clamping to c*C?
+                          double recovery_clamp,              // value for min/max clamping of c*C
+                          const int stride                    // stride
 ) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ContIntLoadConstraint_C(off + coffset, Qc, c, do_clamp, recovery_clamp);
+    for (size_t i = 0; i < contactlist.size(); i++) {
+        contactlist[i]->ContIntLoadConstraint_C(off + coffset, Qc, c, do_clamp, recovery_clamp);
         coffset += stride;
-        ++itercontact;
     }
 }
 
@@ -575,7 +619,7 @@ void ChContactContainerNSC::IntLoadConstraint_C(const unsigned int off,
 
 template <class Tcont>
 void _IntToDescriptor(unsigned int& coffset,
-                      std::list<Tcont*>& contactlist,
+                      ChContactPool<Tcont>& contactlist,
                       const unsigned int off_v,
                       const ChStateDelta& v,
                       const ChVectorDynamic<>& R,
@@ -583,11 +627,9 @@ void _IntToDescriptor(unsigned int& coffset,
                       const ChVectorDynamic<>& L,
                       const ChVectorDynamic<>& Qc,
                       const int stride) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ContIntToDescriptor(off_L + coffset, L, Qc);
+    for (size_t i = 0; i < contactlist.size(); i++) {
+        contactlist[i]->ContIntToDescriptor(off_L + coffset, L, Qc);
         coffset += stride;
-        ++itercontact;
     }
 }
 
@@ -613,17 +655,15 @@ void ChContactContainerNSC::IntToDescriptor(const unsigned int off_v,
 
 template <class Tcont>
 void _IntFromDescriptor(unsigned int& coffset,
-                        std::list<Tcont*>& contactlist,
+                        ChContactPool<Tcont>& contactlist,
                         const unsigned int off_v,
                         ChStateDelta& v,
                         const unsigned int off_L,
                         ChVectorDynamic<>& L,
                         const int stride) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ContIntFromDescriptor(off_L + coffset, L);
+    for (size_t i = 0; i < contactlist.size(); i++) {
+        contactlist[i]->ContIntFromDescriptor(off_L + coffset, L);
         coffset += stride;
-        ++itercontact;
     }
 }
 
@@ -648,11 +688,9 @@ void ChContactContainerNSC::IntFromDescriptor(const unsigned int off_v,
 // SOLVER INTERFACES
 
 template <class Tcont>
-void _InjectConstraints(std::list<Tcont*>& contactlist, ChSystemDescriptor& mdescriptor) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->InjectConstraints(mdescriptor);
-        ++itercontact;
+void _InjectConstraints(ChContactPool<Tcont>& contactlist, ChSystemDescriptor& mdescriptor) {
+    for (size_t i = 0; i < contactlist.size(); i++) {
+        contactlist[i]->InjectConstraints(mdescriptor);
     }
 }
 
@@ -671,11 +709,9 @@ void ChContactContainerNSC::InjectConstraints(ChSystemDescriptor& mdescriptor) {
 }
 
 template <class Tcont>
-void _ConstraintsBiReset(std::list<Tcont*>& contactlist) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ConstraintsBiReset();
-        ++itercontact;
+void _ConstraintsBiReset(ChContactPool<Tcont>& contactlist) {
+    for (size_t i = 0; i < contactlist.size(); i++) {
+        contactlist[i]->ConstraintsBiReset();
     }
 }
 
@@ -694,11 +730,9 @@ void ChContactContainerNSC::ConstraintsBiReset() {
 }
 
 template <class Tcont>
-void _ConstraintsBiLoad_C(std::list<Tcont*>& contactlist, double factor, double recovery_clamp, bool do_clamp) {
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ConstraintsBiLoad_C(factor, recovery_clamp, do_clamp);
-        ++itercontact;
+void _ConstraintsBiLoad_C(ChContactPool<Tcont>& contactlist, double factor, double recovery_clamp, bool do_clamp) {
+    for (size_t i = 0; i < contactlist.size(); i++) {
+        contactlist[i]->ConstraintsBiLoad_C(factor, recovery_clamp, do_clamp);
     }
 }
 
@@ -721,12 +755,10 @@ void ChContactContainerNSC::ConstraintsLoadJacobians() {
 }
 
 template <class Tcont>
-void _ConstraintsFetch_react(std::list<Tcont*>& contactlist, double factor) {
+void _ConstraintsFetch_react(ChContactPool<Tcont>& contactlist, double factor) {
     // From constraints to react vector:
-    typename std::list<Tcont*>::iterator itercontact = contactlist.begin();
-    while (itercontact != contactlist.end()) {
-        (*itercontact)->ConstraintsFetch_react(factor);
-        ++itercontact;
+    for (size_t i = 0; i < contactlist.size(); i++) {
+        contactlist[i]->ConstraintsFetch_react(factor);
     }
 }
 
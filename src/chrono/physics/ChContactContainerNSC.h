@@ -15,18 +15,22 @@
 #ifndef CH_CONTACTCONTAINER_NSC_H
 #define CH_CONTACTCONTAINER_NSC_H
 
-#include <list>
+#include <deque>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "chrono/physics/ChContactContainer.h"
 #include "chrono/physics/ChContactNSC.h"
 #include "chrono/physics/ChContactNSCrolling.h"
+#include "chrono/physics/ChContactPool.h"
 #include "chrono/physics/ChContactable.h"
 
 namespace chrono {
 
 /// Class representing a container of many non-smooth contacts.
-/// Implemented using linked lists of ChContactNSC objects (that is, contacts between two ChContactable objects, with 3
-/// reactions). It might also contain ChContactNSCrolling objects (extended versions of ChContactNSC, with 6 reactions,
+/// Implemented using per-type pools of ChContactNSC objects (that is, contacts between two ChContactable objects, with
+/// 3 reactions). It might also contain ChContactNSCrolling objects (extended versions of ChContactNSC, with 6 reactions,
 /// that account also for rolling and spinning resistance), but also for '6dof vs 6dof' contactables.
 class ChApi ChContactContainerNSC : public ChContactContainer {
   public:
@@ -44,46 +48,51 @@ class ChApi ChContactContainerNSC : public ChContactContainer {
     typedef ChContactNSCrolling<ChContactable_1vars<6>, ChContactable_1vars<6> > ChContactNSCrolling_6_6;
 
   protected:
-    std::list<ChContactNSC_6_6*> contactlist_6_6;
-    std::list<ChContactNSC_6_3*> contactlist_6_3;
-    std::list<ChContactNSC_3_3*> contactlist_3_3;
-    std::list<ChContactNSC_333_3*> contactlist_333_3;
-    std::list<ChContactNSC_333_6*> contactlist_333_6;
-    std::list<ChContactNSC_333_333*> contactlist_333_333;
-    std::list<ChContactNSC_666_3*> contactlist_666_3;
-    std::list<ChContactNSC_666_6*> contactlist_666_6;
-    std::list<ChContactNSC_666_333*> contactlist_666_333;
-    std::list<ChContactNSC_666_666*> contactlist_666_666;
-
-    std::list<ChContactNSCrolling_6_6*> contactlist_6_6_rolling;
-
-    int n_added_6_6;
-    int n_added_6_3;
-    int n_added_3_3;
-    int n_added_333_3;
-    int n_added_333_6;
-    int n_added_333_333;
-    int n_added_666_3;
-    int n_added_666_6;
-    int n_added_666_333;
-    int n_added_666_666;
-    int n_added_6_6_rolling;
-
-    std::list<ChContactNSC_6_6*>::iterator lastcontact_6_6;
-    std::list<ChContactNSC_6_3*>::iterator lastcontact_6_3;
-    std::list<ChContactNSC_3_3*>::iterator lastcontact_3_3;
-    std::list<ChContactNSC_333_3*>::iterator lastcontact_333_3;
-    std::list<ChContactNSC_333_6*>::iterator lastcontact_333_6;
-    std::list<ChContactNSC_333_333*>::iterator lastcontact_333_333;
-    std::list<ChContactNSC_666_3*>::iterator lastcontact_666_3;
-    std::list<ChContactNSC_666_6*>::iterator lastcontact_666_6;
-    std::list<ChContactNSC_666_333*>::iterator lastcontact_666_333;
-    std::list<ChContactNSC_666_666*>::iterator lastcontact_666_666;
-
-    std::list<ChContactNSCrolling_6_6*>::iterator lastcontact_6_6_rolling;
+    ChContactPool<ChContactNSC_6_6> contactlist_6_6;
+    ChContactPool<ChContactNSC_6_3> contactlist_6_3;
+    ChContactPool<ChContactNSC_3_3> contactlist_3_3;
+    ChContactPool<ChContactNSC_333_3> contactlist_333_3;
+    ChContactPool<ChContactNSC_333_6> contactlist_333_6;
+    ChContactPool<ChContactNSC_333_333> contactlist_333_333;
+    ChContactPool<ChContactNSC_666_3> contactlist_666_3;
+    ChContactPool<ChContactNSC_666_6> contactlist_666_6;
+    ChContactPool<ChContactNSC_666_333> contactlist_666_333;
+    ChContactPool<ChContactNSC_666_666> contactlist_666_666;
+
+    ChContactPool<ChContactNSCrolling_6_6> contactlist_6_6_rolling;
 
     std::unordered_map<ChContactable*, ForceTorque> contact_forces;
 
+    /// Persistent data of a contact, used to match contacts between consecutive steps.
+    struct ContactRecord {
+        collision::ChCollisionModel* modelA;  ///< collision model A (the pair may be swapped at the next step)
+        collision::ChCollisionShape* shapeA;  ///< collision shape on A
+        collision::ChCollisionShape* shapeB;  ///< collision shape on B
+        ChVector<> ptA;                       ///< contact point in the collision frame of contactable A
+        ChVector<> ptB;                       ///< contact point in the collision frame of contactable B
+        ChVector<> normal;                    ///< contact normal in absolute frame
+        float reactions[3];                   ///< contact force (N,U,V) in the contact frame
+        bool matched;                         ///< record already used as initial guess for a new contact
+    };
+
+    /// Pair of collision models, used as key for the records. The two models are stored in increasing order of their
+    /// addresses, independent of the order in which the collision system reports them.
+    typedef std::pair<collision::ChCollisionModel*, collision::ChCollisionModel*> ModelPair;
+
+    struct ModelPairHash {
+        size_t operator()(const ModelPair& p) const {
+            return std::hash<void*>()(p.first) ^ (std::hash<void*>()(p.second) << 1);
+        }
+    };
+
+    bool persistent_contacts;                 ///< match contacts with those of the previous step
+    double persistent_tolerance;              ///< max. distance of matched contact points
+    int persistent_matched;                   ///< number of contacts matched at last collision detection
+    std::deque<ContactRecord> records;        ///< persistent data for the current contacts
+    std::deque<ContactRecord> records_prev;   ///< persistent data for the contacts at previous step
+    std::unordered_map<ModelPair, std::vector<size_t>, ModelPairHash> records_map;       ///< current records per pair
+    std::unordered_map<ModelPair, std::vector<size_t>, ModelPairHash> records_prev_map;  ///< previous records per pair
+
   public:
     ChContactContainerNSC();
     ChContactContainerNSC(const ChContactContainerNSC& other);
@@ -92,18 +101,37 @@ class ChApi ChContactContainerNSC : public ChContactContainer {
     /// "Virtual" copy constructor (covariant return type).
     virtual ChContactContainerNSC* Clone() const override { return new ChContactContainerNSC(*this); }
 
+    /// Enable/disable persistent contact matching (default: false).
+    /// If enabled, each new contact is matched with the closest contact between the same pair of collision shapes at
+    /// the previous step (distance measured in the collision frames of the two contactables) and its reactions are
+    /// initialized from the matched contact. This replaces any reaction cache provided by the collision system. Used
+    /// together with solver warm starting (see ChIterativeSolver::EnableWarmStart), this provides a good initial guess
+    /// for the multipliers in resting and stacking configurations.
+    void SetPersistentContacts(bool val) { persistent_contacts = val; }
+
+    /// Set the maximum distance between points of matched persistent contacts (default: 0.01).
+    void SetPersistentContactTolerance(double tol) { persistent_tolerance = tol; }
+
+    /// Return true if persistent contact matching is enabled.
+    bool GetPersistentContacts() const { return persistent_contacts; }
+
+    /// Return the number of contacts matched with a contact of the previous step at the last collision detection.
+    int GetNcontactsMatched() const { return persistent_matched; }
+
     /// Report the number of added contacts.
     virtual int GetNcontacts() const override {
-        return n_added_3_3 + n_added_6_3 + n_added_6_6 + n_added_333_3 + n_added_333_6 + n_added_333_333 +
-               n_added_666_3 + n_added_666_6 + n_added_666_333 + n_added_666_666 + n_added_6_6_rolling;
+        return (int)(contactlist_3_3.size() + contactlist_6_3.size() + contactlist_6_6.size() +
+                     contactlist_333_3.size() + contactlist_333_6.size() + contactlist_333_333.size() +
+                     contactlist_666_3.size() + contactlist_666_6.size() + contactlist_666_333.size() +
+                     contactlist_666_666.size() + contactlist_6_6_rolling.size());
     }
 
     /// Remove (delete) all contained contact data.
     virtual void RemoveAllContacts() override;
 
     /// The collision system will call BeginAddContact() before adding all contacts (for example with AddContact() or
-    /// similar). Instead of simply deleting all list of the previous contacts, this optimized implementation rewinds
-    /// the link iterator to begin and tries to reuse previous contact objects until possible, to avoid too much
+    /// similar). Instead of simply deleting all the previous contacts, this optimized implementation rewinds the
+    /// contact pools and tries to reuse previous contact objects until possible, to avoid too much
     /// allocation/deallocation.
     virtual void BeginAddContact() override;
 
@@ -120,19 +148,25 @@ class ChApi ChContactContainerNSC : public ChContactContainer {
     virtual void AddContact(const collision::ChCollisionInfo& cinfo) override;
 
     /// The collision system will call BeginAddContact() after adding all contacts (for example with AddContact() or
-    /// similar). This optimized version purges the end of the list of contacts that were not reused (if any).
+    /// similar). Unless contact pooling is enabled, this optimized version purges the contacts that were not reused (if
+    /// any).
     virtual void EndAddContact() override;
 
     /// Scan all the contacts and for each contact executes the OnReportContact() function of the provided callback
     /// object.
     virtual void ReportAllContacts(std::shared_ptr<ReportContactCallback> callback) override;
 
+    /// Append the collision information of all contacts to the given list, in the order of their reactions.
+    virtual bool GetContactsInfo(std::vector<collision::ChCollisionInfo>& cinfos) override;
+
     /// Report the number of scalar unilateral constraints.
     /// Note: friction constraints aren't exactly unilaterals, but they are still counted.
     virtual int GetDOC_d() override {
-        return 3 * (n_added_3_3 + n_added_6_3 + n_added_6_6 + n_added_333_3 + n_added_333_6 + n_added_333_333 +
-                    n_added_666_3 + n_added_666_6 + n_added_666_333 + n_added_666_666) +
-               6 * (n_added_6_6_rolling);
+        return (int)(3 * (contactlist_3_3.size() + contactlist_6_3.size() + contactlist_6_6.size() +
+                          contactlist_333_3.size() + contactlist_333_6.size() + contactlist_333_333.size() +
+                          contactlist_666_3.size() + contactlist_666_6.size() + contactlist_666_333.size() +
+                          contactlist_666_666.size()) +
+                     6 * contactlist_6_6_rolling.size());
     }
 
     /// Update state of this contact container: compute jacobians, violations, etc.
@@ -197,6 +231,9 @@ class ChApi ChContactContainerNSC : public ChContactContainer {
 
   private:
     void InsertContact(const collision::ChCollisionInfo& cinfo, const ChMaterialCompositeNSC& cmat);
+    void CreateContact(const collision::ChCollisionInfo& cinfo, const ChMaterialCompositeNSC& cmat);
+    float* MatchContact(const collision::ChCollisionInfo& cinfo);
+    static bool SwapOnCreation(const collision::ChCollisionInfo& cinfo);
 };
 
 CH_CLASS_VERSION(ChContactContainerNSC, 0)
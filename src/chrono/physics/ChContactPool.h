@@ -0,0 +1,122 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+
+#ifndef CH_CONTACT_POOL_H
+#define CH_CONTACT_POOL_H
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace chrono {
+
+/// Storage for contacts of a given type, used by the contact containers.
+/// Contact objects are constructed in place in contiguous memory blocks (slabs) of fixed capacity, so that their
+/// addresses never change while they are alive (the solver keeps pointers to the constraints they own) and so that
+/// sweeps over all contacts touch memory sequentially. Contacts are accessed by index, in insertion order.
+/// At each collision pass the pool is rewound and previously constructed contacts are recycled first; only contacts
+/// beyond the largest count seen so far require construction. Unused contacts can either be destroyed (Trim) or kept
+/// alive for reuse in later steps.
+template <class Tcont>
+class ChContactPool {
+  public:
+    /// Number of contacts stored in each memory block.
+    static const size_t BLOCK_SIZE = 128;
+
+    ChContactPool() : m_size(0), m_constructed(0) {}
+    ~ChContactPool() { Clear(); }
+
+    // The contacts are referenced by the solver, so a pool cannot be copied.
+    ChContactPool(const ChContactPool&) = delete;
+    ChContactPool& operator=(const ChContactPool&) = delete;
+
+    /// Return the number of active contacts (i.e., added since the last Rewind).
+    size_t size() const { return m_size; }
+
+    /// Return true if there are no active contacts.
+    bool empty() const { return m_size == 0; }
+
+    /// Return the number of contact objects currently alive (active or available for recycling).
+    size_t capacity() const { return m_constructed; }
+
+    /// Access the i-th active contact.
+    Tcont* operator[](size_t i) const {
+        assert(i < m_size);
+        return at(i);
+    }
+
+    /// Mark all contacts as inactive, making them available for recycling.
+    void Rewind() { m_size = 0; }
+
+    /// Return the next contact available for recycling (marking it as active), or nullptr if there is none.
+    /// The returned contact still holds stale data and must be reinitialized by the caller.
+    Tcont* Recycle() {
+        if (m_size == m_constructed)
+            return nullptr;
+        return at(m_size++);
+    }
+
+    /// Construct a new active contact at the end of the pool, forwarding the given arguments to its constructor.
+    /// This function must only be called when no contact is available for recycling.
+    template <typename... Args>
+    Tcont* Emplace(Args&&... args) {
+        assert(m_size == m_constructed);
+        if (m_constructed == m_blocks.size() * BLOCK_SIZE)
+            m_blocks.push_back(Block());
+        Tcont* mc = new (slot(m_constructed)) Tcont(std::forward<Args>(args)...);
+        m_constructed++;
+        m_size++;
+        return mc;
+    }
+
+    /// Destroy all inactive contacts and release the memory blocks that are no longer used.
+    void Trim() {
+        while (m_constructed > m_size)
+            at(--m_constructed)->~Tcont();
+        m_blocks.resize((m_constructed + BLOCK_SIZE - 1) / BLOCK_SIZE);
+    }
+
+    /// Destroy all contacts and release all memory.
+    void Clear() {
+        m_size = 0;
+        Trim();
+    }
+
+  private:
+    /// Raw, suitably aligned, storage for BLOCK_SIZE contacts.
+    struct Block {
+        Block() : buffer(new char[BLOCK_SIZE * sizeof(Tcont) + alignof(Tcont)]) {
+            void* ptr = buffer.get();
+            size_t space = BLOCK_SIZE * sizeof(Tcont) + alignof(Tcont);
+            data = std::align(alignof(Tcont), BLOCK_SIZE * sizeof(Tcont), ptr, space);
+        }
+        std::unique_ptr<char[]> buffer;
+        void* data;
+    };
+
+    void* slot(size_t i) const {
+        return static_cast<char*>(m_blocks[i / BLOCK_SIZE].data) + (i % BLOCK_SIZE) * sizeof(Tcont);
+    }
+    Tcont* at(size_t i) const { return static_cast<Tcont*>(slot(i)); }
+
+    std::vector<Block> m_blocks;  ///< memory slabs
+    size_t m_size;                ///< number of active contacts
+    size_t m_constructed;         ///< number of contacts alive (active + recyclable)
+};
+
+}  // end namespace chrono
+
+#endif
@@ -38,6 +38,11 @@ class ChContactTuple {
     Ta* objA;  ///< first ChContactable object in the pair
     Tb* objB;  ///< second ChContactable object in the pair
 
+    collision::ChCollisionModel* modelA;  ///< collision model of object A
+    collision::ChCollisionModel* modelB;  ///< collision model of object B
+    collision::ChCollisionShape* shapeA;  ///< collision shape on object A (may be null)
+    collision::ChCollisionShape* shapeB;  ///< collision shape on object B (may be null)
+
     ChVector<> p1;      ///< max penetration point on geo1, after refining, in abs space
     ChVector<> p2;      ///< max penetration point on geo2, after refining, in abs space
     ChVector<> normal;  ///< normal, on surface of master reference (geo1)
@@ -83,6 +88,11 @@ class ChContactTuple {
         this->objA = mobjA;
         this->objB = mobjB;
 
+        this->modelA = cinfo.modelA;
+        this->modelB = cinfo.modelB;
+        this->shapeA = cinfo.shapeA;
+        this->shapeB = cinfo.shapeB;
+
         this->p1 = cinfo.vpA;
         this->p2 = cinfo.vpB;
         this->normal = cinfo.vN;
@@ -101,6 +111,22 @@ class ChContactTuple {
     /// Get the colliding object B, with point P2
     Tb* GetObjB() { return this->objB; }
 
+    /// Get the collision information of this contact, as used to initialize it (without reaction cache).
+    collision::ChCollisionInfo GetCollisionInfo() const {
+        collision::ChCollisionInfo cinfo;
+        cinfo.modelA = this->modelA;
+        cinfo.modelB = this->modelB;
+        cinfo.shapeA = this->shapeA;
+        cinfo.shapeB = this->shapeB;
+        cinfo.vpA = this->p1;
+        cinfo.vpB = this->p2;
+        cinfo.vN = this->normal;
+        cinfo.distance = this->norm_dist;
+        cinfo.eff_radius = this->eff_radius;
+        cinfo.reaction_cache = nullptr;
+        return cinfo;
+    }
+
     /// Get the contact coordinate system, expressed in absolute frame.
     /// This represents the 'main' reference of the link: reaction forces
     /// are expressed in this coordinate system. Its origin is point P2.
@@ -0,0 +1,184 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+
+#include "chrono/physics/ChNeighborGridSPH.h"
+#include "chrono/parallel/ChOpenMP.h"
+
+namespace chrono {
+
+// Offsets of the 13 adjacent cells scanned from each cell (the other 13 are covered by symmetry).
+static const int half_stencil[13][3] = {{1, 0, 0},  {-1, 1, 0}, {0, 1, 0},  {1, 1, 0},  {-1, -1, 1},
+                                        {0, -1, 1}, {1, -1, 1}, {-1, 0, 1}, {0, 0, 1},  {1, 0, 1},
+                                        {-1, 1, 1}, {0, 1, 1},  {1, 1, 1}};
+
+ChNeighborGridSPH::ChNeighborGridSPH()
+    : m_nthreads(CHOMPfunctions::GetMaxThreads()), m_min(VNULL), m_dims(0, 0, 0), m_cell_size(0) {}
+
+void ChNeighborGridSPH::SetNumThreads(int num_threads) {
+    m_nthreads = std::max(1, num_threads);
+}
+
+void ChNeighborGridSPH::Update(const std::vector<ChVector<>>& pos, const std::vector<double>& radius) {
+    assert(pos.size() == radius.size());
+
+    size_t num_points = pos.size();
+    m_pairA.clear();
+    m_pairB.clear();
+    m_cell.resize(num_points);
+    m_sorted.resize(num_points);
+    m_sorted_pos.resize(num_points);
+    m_sorted_rad.resize(num_points);
+
+    if (num_points == 0) {
+        m_cell_start.clear();
+        return;
+    }
+
+    // Grid extent and cell size
+    ChVector<> pmin = pos[0];
+    ChVector<> pmax = pos[0];
+    double rmax = 0;
+    for (size_t i = 0; i < num_points; i++) {
+        pmin.x() = std::min(pmin.x(), pos[i].x());
+        pmin.y() = std::min(pmin.y(), pos[i].y());
+        pmin.z() = std::min(pmin.z(), pos[i].z());
+        pmax.x() = std::max(pmax.x(), pos[i].x());
+        pmax.y() = std::max(pmax.y(), pos[i].y());
+        pmax.z() = std::max(pmax.z(), pos[i].z());
+        rmax = std::max(rmax, radius[i]);
+    }
+    ChVector<> extent = pmax - pmin;
+
+    // Cells cannot be smaller than the search radius. Enlarge them if the grid would have too many (mostly empty)
+    // cells, as is the case for sparse point sets.
+    const double max_cells = std::max(8.0 * num_points, 1024.0);
+    m_cell_size = std::max(rmax, 1e-12);
+    while (true) {
+        m_dims.x() = (int)(extent.x() / m_cell_size) + 1;
+        m_dims.y() = (int)(extent.y() / m_cell_size) + 1;
+        m_dims.z() = (int)(extent.z() / m_cell_size) + 1;
+        double num_cells = (double)m_dims.x() * (double)m_dims.y() * (double)m_dims.z();
+        if (num_cells <= max_cells)
+            break;
+        m_cell_size *= std::max(std::cbrt(num_cells / max_cells), 1.01);
+    }
+    m_min = pmin;
+    size_t num_cells = (size_t)m_dims.x() * m_dims.y() * m_dims.z();
+
+    // Bin the points (counting sort by cell index)
+    m_cell_start.assign(num_cells + 1, 0);
+    double inv_size = 1 / m_cell_size;
+    for (size_t i = 0; i < num_points; i++) {
+        int ix = std::min((int)((pos[i].x() - m_min.x()) * inv_size), m_dims.x() - 1);
+        int iy = std::min((int)((pos[i].y() - m_min.y()) * inv_size), m_dims.y() - 1);
+        int iz = std::min((int)((pos[i].z() - m_min.z()) * inv_size), m_dims.z() - 1);
+        m_cell[i] = (unsigned int)(ix + (size_t)m_dims.x() * (iy + (size_t)m_dims.y() * iz));
+        m_cell_start[m_cell[i] + 1]++;
+    }
+    for (size_t c = 0; c < num_cells; c++)
+        m_cell_start[c + 1] += m_cell_start[c];
+
+    std::vector<unsigned int> cursor(m_cell_start.begin(), m_cell_start.end() - 1);
+    for (size_t i = 0; i < num_points; i++) {
+        unsigned int k = cursor[m_cell[i]]++;
+        m_sorted[k] = (unsigned int)i;
+        m_sorted_pos[k] = pos[i];
+        m_sorted_rad[k] = radius[i];
+    }
+
+    // Pair search over the sorted arrays.
+    // Each thread scans a contiguous range of cells into its own arrays, which are then concatenated in thread
+    // order, so that the pairs are listed in cell order independently of the number of threads.
+    m_thread_pairA.resize(m_nthreads);
+    m_thread_pairB.resize(m_nthreads);
+    for (int t = 0; t < m_nthreads; t++) {
+        m_thread_pairA[t].clear();
+        m_thread_pairB[t].clear();
+    }
+    size_t num_rows = (size_t)m_dims.y() * m_dims.z();
+
+#pragma omp parallel num_threads(m_nthreads)
+    {
+        int t = CHOMPfunctions::GetThreadNum();
+        int nt = CHOMPfunctions::GetNumThreads();
+        auto& pairA = m_thread_pairA[t];
+        auto& pairB = m_thread_pairB[t];
+        for (size_t row = num_rows * t / nt; row < num_rows * (t + 1) / nt; row++) {
+            int iy = (int)(row % m_dims.y());
+            int iz = (int)(row / m_dims.y());
+            for (int ix = 0; ix < m_dims.x(); ix++)
+                ScanCell(ix, iy, iz, pairA, pairB);
+        }
+    }
+
+    size_t num_pairs = 0;
+    for (const auto& pairA : m_thread_pairA)
+        num_pairs += pairA.size();
+    m_pairA.reserve(num_pairs);
+    m_pairB.reserve(num_pairs);
+    for (int t = 0; t < m_nthreads; t++) {
+        m_pairA.insert(m_pairA.end(), m_thread_pairA[t].begin(), m_thread_pairA[t].end());
+        m_pairB.insert(m_pairB.end(), m_thread_pairB[t].begin(), m_thread_pairB[t].end());
+    }
+}
+
+void ChNeighborGridSPH::ScanCell(int ix,
+                                 int iy,
+                                 int iz,
+                                 std::vector<unsigned int>& pairA,
+                                 std::vector<unsigned int>& pairB) const {
+    size_t c = ix + (size_t)m_dims.x() * (iy + (size_t)m_dims.y() * iz);
+    unsigned int start = m_cell_start[c];
+    unsigned int end = m_cell_start[c + 1];
+    if (start == end)
+        return;
+
+    // Pairs within the cell
+    for (unsigned int a = start; a < end; a++) {
+        for (unsigned int b = a + 1; b < end; b++) {
+            double r = std::max(m_sorted_rad[a], m_sorted_rad[b]);
+            if ((m_sorted_pos[b] - m_sorted_pos[a]).Length2() < r * r) {
+                pairA.push_back(a);
+                pairB.push_back(b);
+            }
+        }
+    }
+
+    // Pairs with the adjacent cells
+    for (int n = 0; n < 13; n++) {
+        int jx = ix + half_stencil[n][0];
+        int jy = iy + half_stencil[n][1];
+        int jz = iz + half_stencil[n][2];
+        if (jx < 0 || jx >= m_dims.x() || jy < 0 || jy >= m_dims.y() || jz >= m_dims.z())
+            continue;
+        size_t cn = jx + (size_t)m_dims.x() * (jy + (size_t)m_dims.y() * jz);
+        unsigned int nstart = m_cell_start[cn];
+        unsigned int nend = m_cell_start[cn + 1];
+        for (unsigned int a = start; a < end; a++) {
+            for (unsigned int b = nstart; b < nend; b++) {
+                double r = std::max(m_sorted_rad[a], m_sorted_rad[b]);
+                if ((m_sorted_pos[b] - m_sorted_pos[a]).Length2() < r * r) {
+                    pairA.push_back(a);
+                    pairB.push_back(b);
+                }
+            }
+        }
+    }
+}
+
+}  // end namespace chrono
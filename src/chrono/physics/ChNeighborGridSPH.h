@@ -0,0 +1,90 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+
+#ifndef CHNEIGHBORGRIDSPH_H
+#define CHNEIGHBORGRIDSPH_H
+
+#include <vector>
+
+#include "chrono/core/ChApiCE.h"
+#include "chrono/core/ChVector.h"
+
+namespace chrono {
+
+/// Uniform grid (cell list) for finding the neighbors of SPH nodes.
+/// Points are binned in cells of size at least equal to the largest search radius, then reordered with a
+/// counting sort so that the points of a cell are stored contiguously. The pair search scans each cell and
+/// half of its adjacent cells, and stores the resulting pairs in two contiguous index arrays.
+/// The pair search is parallelized with OpenMP over contiguous ranges of cells.
+class ChApi ChNeighborGridSPH {
+  public:
+    ChNeighborGridSPH();
+
+    /// Set the number of OpenMP threads used for the pair search (default: maximum number of OpenMP threads).
+    /// The pairs found, and their order, do not depend on the number of threads.
+    void SetNumThreads(int num_threads);
+
+    /// Return the number of OpenMP threads used for the pair search.
+    int GetNumThreads() const { return m_nthreads; }
+
+    /// Find all pairs (i, j) of points whose distance is less than max(radius[i], radius[j]).
+    /// Each pair is reported once. Pairs are listed in cell order, and their indices refer to the points in cell
+    /// order (use GetSortedIndices to map them to the indices of the input arrays).
+    void Update(const std::vector<ChVector<>>& pos, const std::vector<double>& radius);
+
+    /// Get the number of pairs found by the last call to Update().
+    size_t GetNumPairs() const { return m_pairA.size(); }
+
+    /// Get the first point index (in cell order) of each pair.
+    const std::vector<unsigned int>& GetPairsA() const { return m_pairA; }
+
+    /// Get the second point index (in cell order) of each pair.
+    const std::vector<unsigned int>& GetPairsB() const { return m_pairB; }
+
+    /// Get the input indices of the points in cell order.
+    const std::vector<unsigned int>& GetSortedIndices() const { return m_sorted; }
+
+    /// Get the number of grid cells used by the last call to Update().
+    size_t GetNumCells() const { return m_cell_start.empty() ? 0 : m_cell_start.size() - 1; }
+
+    /// Get the cell size used by the last call to Update().
+    double GetCellSize() const { return m_cell_size; }
+
+  private:
+    /// Find the pairs between the points of cell (ix, iy, iz) and those of the same cell and of half of its
+    /// adjacent cells, and append them to the given arrays.
+    void ScanCell(int ix,
+                  int iy,
+                  int iz,
+                  std::vector<unsigned int>& pairA,
+                  std::vector<unsigned int>& pairB) const;
+
+    int m_nthreads;                          ///< number of OpenMP threads
+    ChVector<> m_min;                        ///< lower corner of the grid
+    ChVector<int> m_dims;                    ///< number of cells in each direction
+    double m_cell_size;                      ///< edge length of a cell
+    std::vector<unsigned int> m_cell;        ///< cell index of each point
+    std::vector<unsigned int> m_cell_start;  ///< index in the sorted arrays of the first point of each cell
+    std::vector<unsigned int> m_sorted;      ///< point indices in cell order
+    std::vector<ChVector<>> m_sorted_pos;    ///< point positions in cell order
+    std::vector<double> m_sorted_rad;        ///< point radii in cell order
+    std::vector<unsigned int> m_pairA;       ///< first point of each pair
+    std::vector<unsigned int> m_pairB;       ///< second point of each pair
+    std::vector<std::vector<unsigned int>> m_thread_pairA;  ///< first point of the pairs found by each thread
+    std::vector<std::vector<unsigned int>> m_thread_pairB;  ///< second point of the pairs found by each thread
+};
+
+}  // end namespace chrono
+
+#endif
@@ -31,27 +31,24 @@ using namespace geometry;
 // CLASS FOR A PARTICLE
 // -----------------------------------------------------------------------------
 
-ChAparticle::ChAparticle() : container(NULL), UserForce(VNULL), UserTorque(VNULL) {
+ChAparticleBase::ChAparticleBase() {
     collision_model = new ChCollisionModelBullet;
     collision_model->SetContactable(this);
 }
 
-ChAparticle::ChAparticle(const ChAparticle& other) : ChParticleBase(other) {
+ChAparticleBase::ChAparticleBase(const ChAparticleBase& other) : ChParticleBase(other) {
     collision_model = new ChCollisionModelBullet;
     collision_model->AddCopyOfAnotherModel(other.collision_model);
     collision_model->SetContactable(this);
 
-    container = other.container;
-    UserForce = other.UserForce;
-    UserTorque = other.UserTorque;
     variables = other.variables;
 }
 
-ChAparticle::~ChAparticle() {
+ChAparticleBase::~ChAparticleBase() {
     delete collision_model;
 }
 
-ChAparticle& ChAparticle::operator=(const ChAparticle& other) {
+ChAparticleBase& ChAparticleBase::operator=(const ChAparticleBase& other) {
     if (&other == this)
         return *this;
 
@@ -62,44 +59,52 @@ ChAparticle& ChAparticle::operator=(const ChAparticle& other) {
     collision_model->AddCopyOfAnotherModel(other.collision_model);
     collision_model->SetContactable(this);
 
-    container = other.container;
-    UserForce = other.UserForce;
-    UserTorque = other.UserTorque;
     variables = other.variables;
 
     return *this;
 }
 
-void ChAparticle::ContactableGetStateBlock_w(ChStateDelta& w) {
-    w.segment(0, 3) = GetPos_dt().eigen();
-    w.segment(3, 3) = GetWvel_loc().eigen();
+void ChAparticleBase::ContactableGetStateBlock_x(ChState& x) {
+    ChCoordsys<> csys = GetStateCoord();
+    x.segment(0, 3) = csys.pos.eigen();
+    x.segment(3, 4) = csys.rot.eigen();
+}
+
+void ChAparticleBase::ContactableGetStateBlock_w(ChStateDelta& w) {
+    w.segment(0, 3) = GetStatePos_dt().eigen();
+    w.segment(3, 3) = GetStateWvel_loc().eigen();
 }
 
-void ChAparticle::ContactableIncrementState(const ChState& x, const ChStateDelta& dw, ChState& x_new) {
+ChQuaternion<> ChAparticleBase::IncrementRotation(const ChQuaternion<>& rot, const ChVector<>& rot_abs) {
+    // rot' = delta*rot  (use quaternion for delta rotation)
+    ChQuaternion<> mdeltarot;
+    ChVector<> axis = rot_abs;
+    double mangle = axis.Length();
+    axis.Normalize();
+    mdeltarot.Q_from_AngAxis(mangle, axis);
+    return mdeltarot * rot;  // quaternion product
+}
+
+void ChAparticleBase::ContactableIncrementState(const ChState& x, const ChStateDelta& dw, ChState& x_new) {
     // Increment position
     x_new(0) = x(0) + dw(0);
     x_new(1) = x(1) + dw(1);
     x_new(2) = x(2) + dw(2);
 
     // Increment rotation: rot' = delta*rot  (use quaternion for delta rotation)
-    ChQuaternion<> mdeltarot;
     ChQuaternion<> moldrot(x.segment(3, 4));
-    ChVector<> newwel_abs = Amatrix * ChVector<>(dw.segment(3, 3));
-    double mangle = newwel_abs.Length();
-    newwel_abs.Normalize();
-    mdeltarot.Q_from_AngAxis(mangle, newwel_abs);
-    ChQuaternion<> mnewrot = mdeltarot * moldrot;  // quaternion product
-    x_new.segment(3, 4) = mnewrot.eigen();
+    ChVector<> newwel_abs = GetStateCoord().rot.Rotate(ChVector<>(dw.segment(3, 3)));
+    x_new.segment(3, 4) = IncrementRotation(moldrot, newwel_abs).eigen();
 }
 
-ChVector<> ChAparticle::GetContactPoint(const ChVector<>& loc_point, const ChState& state_x) {
+ChVector<> ChAparticleBase::GetContactPoint(const ChVector<>& loc_point, const ChState& state_x) {
     ChCoordsys<> csys(state_x.segment(0, 7));
     return csys.TransformPointLocalToParent(loc_point);
 }
 
-ChVector<> ChAparticle::GetContactPointSpeed(const ChVector<>& loc_point,
-                                             const ChState& state_x,
-                                             const ChStateDelta& state_w) {
+ChVector<> ChAparticleBase::GetContactPointSpeed(const ChVector<>& loc_point,
+                                                 const ChState& state_x,
+                                                 const ChStateDelta& state_w) {
     ChCoordsys<> csys(state_x.segment(0, 7));
     ChVector<> abs_vel(state_w.segment(0, 3));
     ChVector<> loc_omg(state_w.segment(3, 3));
@@ -108,24 +113,28 @@ ChVector<> ChAparticle::GetContactPointSpeed(const ChVector<>& loc_point,
     return abs_vel + Vcross(abs_omg, loc_point);
 }
 
-ChVector<> ChAparticle::GetContactPointSpeed(const ChVector<>& abs_point) {
-    ChVector<> m_p1_loc = this->TransformPointParentToLocal(abs_point);
-    return this->PointSpeedLocalToParent(m_p1_loc);
+ChVector<> ChAparticleBase::GetContactPointSpeed(const ChVector<>& abs_point) {
+    ChCoordsys<> csys = GetStateCoord();
+    ChVector<> abs_omg = csys.rot.Rotate(GetStateWvel_loc());
+    return GetStatePos_dt() + Vcross(abs_omg, abs_point - csys.pos);
 }
 
-void ChAparticle::ContactForceLoadResidual_F(const ChVector<>& F, const ChVector<>& abs_point, ChVectorDynamic<>& R) {
-    ChVector<> m_p1_loc = this->TransformPointParentToLocal(abs_point);
-    ChVector<> force1_loc = this->TransformDirectionParentToLocal(F);
+void ChAparticleBase::ContactForceLoadResidual_F(const ChVector<>& F,
+                                                 const ChVector<>& abs_point,
+                                                 ChVectorDynamic<>& R) {
+    ChCoordsys<> csys = GetStateCoord();
+    ChVector<> m_p1_loc = csys.TransformPointParentToLocal(abs_point);
+    ChVector<> force1_loc = csys.TransformDirectionParentToLocal(F);
     ChVector<> torque1_loc = Vcross(m_p1_loc, force1_loc);
     R.segment(Variables().GetOffset() + 0, 3) += F.eigen();
     R.segment(Variables().GetOffset() + 3, 3) += torque1_loc.eigen();
 }
 
-void ChAparticle::ContactForceLoadQ(const ChVector<>& F,
-                                    const ChVector<>& point,
-                                    const ChState& state_x,
-                                    ChVectorDynamic<>& Q,
-                                    int offset) {
+void ChAparticleBase::ContactForceLoadQ(const ChVector<>& F,
+                                        const ChVector<>& point,
+                                        const ChState& state_x,
+                                        ChVectorDynamic<>& Q,
+                                        int offset) {
     ChCoordsys<> csys(state_x.segment(0, 7));
     ChVector<> point_loc = csys.TransformPointParentToLocal(point);
     ChVector<> force_loc = csys.TransformDirectionParentToLocal(F);
@@ -134,21 +143,22 @@ void ChAparticle::ContactForceLoadQ(const ChVector<>& F,
     Q.segment(offset + 3, 3) = torque_loc.eigen();
 }
 
-void ChAparticle::ComputeJacobianForContactPart(
+void ChAparticleBase::ComputeJacobianForContactPart(
     const ChVector<>& abs_point,
     ChMatrix33<>& contact_plane,
     ChVariableTupleCarrier_1vars<6>::type_constraint_tuple& jacobian_tuple_N,
     ChVariableTupleCarrier_1vars<6>::type_constraint_tuple& jacobian_tuple_U,
     ChVariableTupleCarrier_1vars<6>::type_constraint_tuple& jacobian_tuple_V,
     bool second) {
-    ChVector<> m_p1_loc = this->TransformPointParentToLocal(abs_point);
+    ChCoordsys<> csys = GetStateCoord();
+    ChVector<> m_p1_loc = csys.TransformPointParentToLocal(abs_point);
 
     ChMatrix33<> Jx1 = contact_plane.transpose();
     if (!second)
         Jx1 *= -1;
-    
+
     ChStarMatrix33<> Ps1(m_p1_loc);
-    ChMatrix33<> Jr1 = contact_plane.transpose() * GetA() * Ps1;
+    ChMatrix33<> Jr1 = contact_plane.transpose() * ChMatrix33<>(csys.rot) * Ps1;
     if (second)
         Jr1 *= -1;
 
@@ -161,14 +171,14 @@ void ChAparticle::ComputeJacobianForContactPart(
     jacobian_tuple_V.Get_Cq().segment(3, 3) = Jr1.row(2);
 }
 
-void ChAparticle::ComputeJacobianForRollingContactPart(
+void ChAparticleBase::ComputeJacobianForRollingContactPart(
     const ChVector<>& abs_point,
     ChMatrix33<>& contact_plane,
     ChVariableTupleCarrier_1vars<6>::type_constraint_tuple& jacobian_tuple_N,
     ChVariableTupleCarrier_1vars<6>::type_constraint_tuple& jacobian_tuple_U,
     ChVariableTupleCarrier_1vars<6>::type_constraint_tuple& jacobian_tuple_V,
     bool second) {
-    ChMatrix33<> Jr1 = contact_plane.transpose() * this->GetA();
+    ChMatrix33<> Jr1 = contact_plane.transpose() * ChMatrix33<>(GetStateCoord().rot);
     if (!second)
         Jr1 *= -1;
 
@@ -180,6 +190,30 @@ void ChAparticle::ComputeJacobianForRollingContactPart(
     jacobian_tuple_V.Get_Cq().segment(3, 3) = Jr1.row(2);
 }
 
+// -----------------------------------------------------------------------------
+
+ChAparticle::ChAparticle() : container(NULL), UserForce(VNULL), UserTorque(VNULL) {}
+
+ChAparticle::ChAparticle(const ChAparticle& other) : ChAparticleBase(other) {
+    container = other.container;
+    UserForce = other.UserForce;
+    UserTorque = other.UserTorque;
+}
+
+ChAparticle& ChAparticle::operator=(const ChAparticle& other) {
+    if (&other == this)
+        return *this;
+
+    // parent class copy
+    ChAparticleBase::operator=(other);
+
+    container = other.container;
+    UserForce = other.UserForce;
+    UserTorque = other.UserTorque;
+
+    return *this;
+}
+
 ChPhysicsItem* ChAparticle::GetPhysicsItem() {
     return container;
 }
@@ -564,35 +598,19 @@ void ChParticlesClones::SetInertia(const ChMatrix33<>& newXInertia) {
 }
 
 void ChParticlesClones::SetInertiaXX(const ChVector<>& iner) {
-    particle_mass.GetBodyInertia()(0, 0) = iner.x();
-    particle_mass.GetBodyInertia()(1, 1) = iner.y();
-    particle_mass.GetBodyInertia()(2, 2) = iner.z();
-    particle_mass.GetBodyInvInertia() = particle_mass.GetBodyInertia().inverse();
+    particle_mass.SetBodyInertiaXX(iner);
 }
+
 void ChParticlesClones::SetInertiaXY(const ChVector<>& iner) {
-    particle_mass.GetBodyInertia()(0, 1) = iner.x();
-    particle_mass.GetBodyInertia()(0, 2) = iner.y();
-    particle_mass.GetBodyInertia()(1, 2) = iner.z();
-    particle_mass.GetBodyInertia()(1, 0) = iner.x();
-    particle_mass.GetBodyInertia()(2, 0) = iner.y();
-    particle_mass.GetBodyInertia()(2, 1) = iner.z();
-    particle_mass.GetBodyInvInertia() = particle_mass.GetBodyInertia().inverse();
+    particle_mass.SetBodyInertiaXY(iner);
 }
 
 ChVector<> ChParticlesClones::GetInertiaXX() const {
-    ChVector<> iner;
-    iner.x() = particle_mass.GetBodyInertia()(0, 0);
-    iner.y() = particle_mass.GetBodyInertia()(1, 1);
-    iner.z() = particle_mass.GetBodyInertia()(2, 2);
-    return iner;
+    return particle_mass.GetBodyInertiaXX();
 }
 
 ChVector<> ChParticlesClones::GetInertiaXY() const {
-    ChVector<> iner;
-    iner.x() = particle_mass.GetBodyInertia()(0, 1);
-    iner.y() = particle_mass.GetBodyInertia()(0, 2);
-    iner.z() = particle_mass.GetBodyInertia()(1, 2);
-    return iner;
+    return particle_mass.GetBodyInertiaXY();
 }
 
 void ChParticlesClones::Update(bool update_assets) {
@@ -28,29 +28,24 @@ namespace chrono {
 class ChSystem;
 class ChParticlesClones;
 
-/// Class for a single particle clone in the ChParticlesClones cluster.
-/// It does not define mass, inertia and shape because those are _shared_ among them.
-class ChApi ChAparticle : public ChParticleBase, public ChContactable_1vars<6> {
+/// Base class for a single particle of a cluster of clone particles.
+/// It holds the solver variables (referencing the mass and inertia shared by all particles of the cluster) and the
+/// collision model of the particle, and implements the ChContactable interface of a 6-DOF rigid particle.
+/// The particle state used by the contactable interface is obtained through the GetState... functions, so that
+/// derived classes can store it in the particle frame (ChAparticle) or in the arrays of the container
+/// (ChAparticleSoA).
+class ChApi ChAparticleBase : public ChParticleBase, public ChContactable_1vars<6> {
   public:
-    ChAparticle();
-    ChAparticle(const ChAparticle& other);
-    ~ChAparticle();
-
-    ChAparticle& operator=(const ChAparticle& other);
+    virtual ~ChAparticleBase();
 
     // Access the variables of the node
     virtual ChVariables& Variables() override { return variables; }
 
-    // Get the container
-    ChParticlesClones* GetContainer() const { return container; }
-    // Set the container
-    void SetContainer(ChParticlesClones* mc) { container = mc; }
-
     //
     // INTERFACE TO ChContactable
     //
 
-	virtual ChContactable::eChContactableType GetContactableType() const override { return CONTACTABLE_6; }
+    virtual ChContactable::eChContactableType GetContactableType() const override { return CONTACTABLE_6; }
 
     /// Access variables.
     virtual ChVariables* GetVariables1() override { return &Variables(); }
@@ -65,10 +60,7 @@ class ChApi ChAparticle : public ChParticleBase, public ChContactable_1vars<6> {
     virtual int ContactableGet_ndof_w() override { return 6; }
 
     /// Get all the DOFs packed in a single vector (position part)
-    virtual void ContactableGetStateBlock_x(ChState& x) override {
-        x.segment(0, 3) = GetCoord().pos.eigen();
-        x.segment(3, 4) = GetCoord().rot.eigen();
-    }
+    virtual void ContactableGetStateBlock_x(ChState& x) override;
 
     /// Get all the DOFs packed in a single vector (speed part)
     virtual void ContactableGetStateBlock_w(ChStateDelta& w) override;
@@ -88,13 +80,12 @@ class ChApi ChAparticle : public ChParticleBase, public ChContactable_1vars<6> {
                                             const ChStateDelta& state_w) override;
 
     /// Get the absolute speed of point abs_point if attached to the surface.
-    /// Easy in this case because there are no rotations..
     virtual ChVector<> GetContactPointSpeed(const ChVector<>& abs_point) override;
 
     /// Return the coordinate system for the associated collision model.
     /// ChCollisionModel might call this to get the position of the
     /// contact model (when rigid) and sync it.
-    virtual ChCoordsys<> GetCsysForCollisionModel() override { return this->coord; }
+    virtual ChCoordsys<> GetCsysForCollisionModel() override { return GetStateCoord(); }
 
     /// Apply the force, expressed in absolute reference, applied in pos, to the
     /// coordinates of the variables. Force for example could come from a penalty model.
@@ -134,6 +125,48 @@ class ChApi ChAparticle : public ChParticleBase, public ChContactable_1vars<6> {
     /// used by some SMC code
     virtual double GetContactableMass() override { return variables.GetBodyMass(); }
 
+    /// Increment the given rotation by the rotation vector rot_abs, expressed in the absolute frame:
+    /// rot' = delta * rot, with delta the rotation of angle |rot_abs| about rot_abs.
+    static ChQuaternion<> IncrementRotation(const ChQuaternion<>& rot, const ChVector<>& rot_abs);
+
+    //
+    // DATA
+    //
+
+    ChVariablesBodySharedMass variables;
+    collision::ChCollisionModel* collision_model;
+
+  protected:
+    ChAparticleBase();
+    ChAparticleBase(const ChAparticleBase& other);
+
+    ChAparticleBase& operator=(const ChAparticleBase& other);
+
+    /// Get the position and rotation of the particle.
+    virtual ChCoordsys<> GetStateCoord() const = 0;
+
+    /// Get the linear velocity of the particle (in the absolute frame).
+    virtual ChVector<> GetStatePos_dt() const = 0;
+
+    /// Get the angular velocity of the particle (in the particle frame).
+    virtual ChVector<> GetStateWvel_loc() const = 0;
+};
+
+/// Class for a single particle clone in the ChParticlesClones cluster.
+/// It does not define mass, inertia and shape because those are _shared_ among them.
+class ChApi ChAparticle : public ChAparticleBase {
+  public:
+    ChAparticle();
+    ChAparticle(const ChAparticle& other);
+    ~ChAparticle() {}
+
+    ChAparticle& operator=(const ChAparticle& other);
+
+    // Get the container
+    ChParticlesClones* GetContainer() const { return container; }
+    // Set the container
+    void SetContainer(ChParticlesClones* mc) { container = mc; }
+
     /// This is only for backward compatibility
     virtual ChPhysicsItem* GetPhysicsItem() override;
 
@@ -147,10 +180,13 @@ class ChApi ChAparticle : public ChParticleBase, public ChContactable_1vars<6> {
     //
 
     ChParticlesClones* container;
-    ChVariablesBodySharedMass variables;
-    collision::ChCollisionModel* collision_model;
     ChVector<> UserForce;
     ChVector<> UserTorque;
+
+  private:
+    virtual ChCoordsys<> GetStateCoord() const override { return coord; }
+    virtual ChVector<> GetStatePos_dt() const override { return coord_dt.pos; }
+    virtual ChVector<> GetStateWvel_loc() const override { return GetWvel_loc(); }
 };
 
 /// Class for clusters of 'clone' particles, that is many
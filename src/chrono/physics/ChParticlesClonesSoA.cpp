@@ -0,0 +1,689 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+
+#include <algorithm>
+
+#include "chrono/collision/ChCollisionModelBullet.h"
+#include "chrono/core/ChGlobal.h"
+#include "chrono/physics/ChMaterialSurfaceNSC.h"
+#include "chrono/physics/ChParticlesClonesSoA.h"
+#include "chrono/physics/ChSystem.h"
+
+namespace chrono {
+
+using namespace collision;
+
+// Column views of the particle arrays and of the (interleaved) blocks of the global state vectors.
+typedef Eigen::Map<Eigen::Matrix<double, 3, Eigen::Dynamic>> Map3N;
+typedef Eigen::Map<Eigen::Matrix<double, 4, Eigen::Dynamic>> Map4N;
+typedef Eigen::Map<Eigen::Matrix<double, 6, Eigen::Dynamic>> Map6N;
+typedef Eigen::Map<Eigen::Matrix<double, 7, Eigen::Dynamic>> Map7N;
+typedef Eigen::Map<const Eigen::Matrix<double, 3, Eigen::Dynamic>> ConstMap3N;
+typedef Eigen::Map<const Eigen::Matrix<double, 6, Eigen::Dynamic>> ConstMap6N;
+typedef Eigen::Map<const Eigen::Matrix<double, 7, Eigen::Dynamic>> ConstMap7N;
+
+// -----------------------------------------------------------------------------
+// CLASS FOR A PARTICLE
+// -----------------------------------------------------------------------------
+
+ChAparticleSoA::ChAparticleSoA(ChParticlesClonesSoA* container, unsigned int index)
+    : container(container), index(index) {}
+
+ChCoordsys<> ChAparticleSoA::GetStateCoord() const {
+    return ChCoordsys<>(container->GetParticlePos(index), container->GetParticleRot(index));
+}
+
+ChVector<> ChAparticleSoA::GetStatePos_dt() const {
+    return container->GetParticlePos_dt(index);
+}
+
+ChVector<> ChAparticleSoA::GetStateWvel_loc() const {
+    return container->GetParticleWvel_loc(index);
+}
+
+ChPhysicsItem* ChAparticleSoA::GetPhysicsItem() {
+    return container;
+}
+
+void ChAparticleSoA::ReadState() {
+    // Use the base class setters, so that the state is not written back to the container
+    ChParticleBase::SetCoord(container->GetParticlePos(index), container->GetParticleRot(index));
+    ChParticleBase::SetPos_dt(container->GetParticlePos_dt(index));
+    ChParticleBase::SetWvel_loc(container->GetParticleWvel_loc(index));
+    ChParticleBase::SetPos_dtdt(Map3N(container->pos_dtdt.data(), 3, container->GetNparticles()).col(index));
+    ChParticleBase::SetWacc_loc(Map3N(container->wacc_loc.data(), 3, container->GetNparticles()).col(index));
+}
+
+void ChAparticleSoA::WriteState() {
+    Eigen::Index n = (Eigen::Index)container->GetNparticles();
+    Map3N(container->pos.data(), 3, n).col(index) = coord.pos.eigen();
+    Map4N(container->rot.data(), 4, n).col(index) = coord.rot.eigen();
+    Map3N(container->pos_dt.data(), 3, n).col(index) = coord_dt.pos.eigen();
+    Map3N(container->wvel_loc.data(), 3, n).col(index) = GetWvel_loc().eigen();
+    Map3N(container->pos_dtdt.data(), 3, n).col(index) = coord_dtdt.pos.eigen();
+    Map3N(container->wacc_loc.data(), 3, n).col(index) = GetWacc_loc().eigen();
+}
+
+void ChAparticleSoA::SetCoord(const ChCoordsys<>& mcoord) {
+    ChParticleBase::SetCoord(mcoord);
+    WriteState();
+}
+
+void ChAparticleSoA::SetCoord(const ChVector<>& mv, const ChQuaternion<>& mq) {
+    ChParticleBase::SetCoord(mv, mq);
+    WriteState();
+}
+
+void ChAparticleSoA::SetRot(const ChQuaternion<>& mrot) {
+    ChParticleBase::SetRot(mrot);
+    WriteState();
+}
+
+void ChAparticleSoA::SetRot(const ChMatrix33<>& mA) {
+    ChParticleBase::SetRot(mA);
+    WriteState();
+}
+
+void ChAparticleSoA::SetPos(const ChVector<>& mpos) {
+    ChParticleBase::SetPos(mpos);
+    WriteState();
+}
+
+void ChAparticleSoA::SetCoord_dt(const ChCoordsys<>& mcoord_dt) {
+    ChParticleBase::SetCoord_dt(mcoord_dt);
+    WriteState();
+}
+
+void ChAparticleSoA::SetPos_dt(const ChVector<>& mvel) {
+    ChParticleBase::SetPos_dt(mvel);
+    WriteState();
+}
+
+void ChAparticleSoA::SetRot_dt(const ChQuaternion<>& mrot_dt) {
+    ChParticleBase::SetRot_dt(mrot_dt);
+    WriteState();
+}
+
+void ChAparticleSoA::SetWvel_loc(const ChVector<>& wl) {
+    ChParticleBase::SetWvel_loc(wl);
+    WriteState();
+}
+
+void ChAparticleSoA::SetWvel_par(const ChVector<>& wp) {
+    ChParticleBase::SetWvel_par(wp);
+    WriteState();
+}
+
+void ChAparticleSoA::SetCoord_dtdt(const ChCoordsys<>& mcoord_dtdt) {
+    ChParticleBase::SetCoord_dtdt(mcoord_dtdt);
+    WriteState();
+}
+
+void ChAparticleSoA::SetPos_dtdt(const ChVector<>& macc) {
+    ChParticleBase::SetPos_dtdt(macc);
+    WriteState();
+}
+
+void ChAparticleSoA::SetRot_dtdt(const ChQuaternion<>& mrot_dtdt) {
+    ChParticleBase::SetRot_dtdt(mrot_dtdt);
+    WriteState();
+}
+
+void ChAparticleSoA::SetWacc_loc(const ChVector<>& al) {
+    ChParticleBase::SetWacc_loc(al);
+    WriteState();
+}
+
+void ChAparticleSoA::SetWacc_par(ChVector<>& ap) {
+    ChParticleBase::SetWacc_par(ap);
+    WriteState();
+}
+
+// -----------------------------------------------------------------------------
+// CLASS FOR PARTICLE CLUSTER
+// -----------------------------------------------------------------------------
+
+// Register into the object factory, to enable run-time dynamic creation and persistence
+CH_FACTORY_REGISTER(ChParticlesClonesSoA)
+
+ChParticlesClonesSoA::ChParticlesClonesSoA()
+    : do_collide(false), do_limit_speed(false), max_speed(0.5f), max_wvel((float)CH_C_2PI) {
+    SetMass(1.0);
+    SetInertiaXX(ChVector<double>(1.0, 1.0, 1.0));
+    SetInertiaXY(ChVector<double>(0, 0, 0));
+
+    particle_collision_model = new ChCollisionModelBullet();
+    particle_collision_model->SetContactable(0);
+
+    // default non-smooth contact material
+    matsurface = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+}
+
+ChParticlesClonesSoA::ChParticlesClonesSoA(const ChParticlesClonesSoA& other) : ChIndexedParticles(other) {
+    do_collide = false;
+    do_limit_speed = other.do_limit_speed;
+
+    SetMass(other.GetMass());
+    SetInertiaXX(other.GetInertiaXX());
+    SetInertiaXY(other.GetInertiaXY());
+
+    particle_collision_model = new ChCollisionModelBullet();
+    particle_collision_model->SetContactable(0);
+    particle_collision_model->AddCopyOfAnotherModel(other.particle_collision_model);
+
+    matsurface = std::shared_ptr<ChMaterialSurface>(other.matsurface->Clone());  // deep copy
+
+    pos = other.pos;
+    rot = other.rot;
+    pos_dt = other.pos_dt;
+    wvel_loc = other.wvel_loc;
+    pos_dtdt = other.pos_dtdt;
+    wacc_loc = other.wacc_loc;
+    force = other.force;
+    torque = other.torque;
+    CreateParticles(0);
+
+    max_speed = other.max_speed;
+    max_wvel = other.max_wvel;
+}
+
+ChParticlesClonesSoA::~ChParticlesClonesSoA() {
+    ResizeNparticles(0);
+
+    if (particle_collision_model)
+        delete particle_collision_model;
+    particle_collision_model = 0;
+}
+
+void ChParticlesClonesSoA::CreateParticles(size_t start) {
+    size_t n = pos.size() / 3;
+    for (size_t j = start; j < n; j++) {
+        particles.emplace_back(this, (unsigned int)j);
+        ChAparticleSoA& p = particles.back();
+
+        p.variables.SetSharedMass(&particle_mass);
+        p.variables.SetUserData((void*)this);
+
+        p.collision_model->AddCopyOfAnotherModel(particle_collision_model);
+        p.collision_model->BuildModel();
+    }
+}
+
+void ChParticlesClonesSoA::ResizeNparticles(int newsize) {
+    bool oldcoll = GetCollide();
+    SetCollide(false);  // this will remove old particle coll.models from coll.engine, if previously added
+
+    particles.clear();
+
+    // Reset the state of all particles
+    pos.assign(3 * newsize, 0.0);
+    rot.assign(4 * newsize, 0.0);
+    for (int j = 0; j < newsize; j++)
+        rot[4 * j] = 1;
+    pos_dt.assign(3 * newsize, 0.0);
+    wvel_loc.assign(3 * newsize, 0.0);
+    pos_dtdt.assign(3 * newsize, 0.0);
+    wacc_loc.assign(3 * newsize, 0.0);
+    force.assign(3 * newsize, 0.0);
+    torque.assign(3 * newsize, 0.0);
+
+    CreateParticles(0);
+
+    SetCollide(oldcoll);  // this will also add particle coll.models to coll.engine, if already in a ChSystem
+}
+
+void ChParticlesClonesSoA::AddParticle(ChCoordsys<double> initial_state) {
+    size_t n = GetNparticles();
+
+    pos.insert(pos.end(), initial_state.pos.eigen().data(), initial_state.pos.eigen().data() + 3);
+    rot.insert(rot.end(), initial_state.rot.eigen().data(), initial_state.rot.eigen().data() + 4);
+    pos_dt.resize(pos_dt.size() + 3, 0.0);
+    wvel_loc.resize(wvel_loc.size() + 3, 0.0);
+    pos_dtdt.resize(pos_dtdt.size() + 3, 0.0);
+    wacc_loc.resize(wacc_loc.size() + 3, 0.0);
+    force.resize(force.size() + 3, 0.0);
+    torque.resize(torque.size() + 3, 0.0);
+
+    CreateParticles(n);
+}
+
+ChParticleBase& ChParticlesClonesSoA::GetParticle(unsigned int n) {
+    assert(n < particles.size());
+    particles[n].ReadState();
+    return particles[n];
+}
+
+// PARTICLE STATE
+
+ChVector<> ChParticlesClonesSoA::GetParticlePos(unsigned int n) const {
+    return ChVector<>(pos[3 * n], pos[3 * n + 1], pos[3 * n + 2]);
+}
+
+void ChParticlesClonesSoA::SetParticlePos(unsigned int n, const ChVector<>& p) {
+    Map3N(pos.data(), 3, GetNparticles()).col(n) = p.eigen();
+}
+
+ChQuaternion<> ChParticlesClonesSoA::GetParticleRot(unsigned int n) const {
+    return ChQuaternion<>(rot[4 * n], rot[4 * n + 1], rot[4 * n + 2], rot[4 * n + 3]);
+}
+
+void ChParticlesClonesSoA::SetParticleRot(unsigned int n, const ChQuaternion<>& q) {
+    Map4N(rot.data(), 4, GetNparticles()).col(n) = q.eigen();
+}
+
+ChVector<> ChParticlesClonesSoA::GetParticlePos_dt(unsigned int n) const {
+    return ChVector<>(pos_dt[3 * n], pos_dt[3 * n + 1], pos_dt[3 * n + 2]);
+}
+
+void ChParticlesClonesSoA::SetParticlePos_dt(unsigned int n, const ChVector<>& v) {
+    Map3N(pos_dt.data(), 3, GetNparticles()).col(n) = v.eigen();
+}
+
+ChVector<> ChParticlesClonesSoA::GetParticleWvel_loc(unsigned int n) const {
+    return ChVector<>(wvel_loc[3 * n], wvel_loc[3 * n + 1], wvel_loc[3 * n + 2]);
+}
+
+void ChParticlesClonesSoA::SetParticleWvel_loc(unsigned int n, const ChVector<>& w) {
+    Map3N(wvel_loc.data(), 3, GetNparticles()).col(n) = w.eigen();
+}
+
+ChVector<> ChParticlesClonesSoA::GetParticleForce(unsigned int n) const {
+    return ChVector<>(force[3 * n], force[3 * n + 1], force[3 * n + 2]);
+}
+
+void ChParticlesClonesSoA::SetParticleForce(unsigned int n, const ChVector<>& f) {
+    Map3N(force.data(), 3, GetNparticles()).col(n) = f.eigen();
+}
+
+ChVector<> ChParticlesClonesSoA::GetParticleTorque(unsigned int n) const {
+    return ChVector<>(torque[3 * n], torque[3 * n + 1], torque[3 * n + 2]);
+}
+
+void ChParticlesClonesSoA::SetParticleTorque(unsigned int n, const ChVector<>& t) {
+    Map3N(torque.data(), 3, GetNparticles()).col(n) = t.eigen();
+}
+
+// STATE BOOKKEEPING FUNCTIONS
+
+void ChParticlesClonesSoA::IntStateGather(const unsigned int off_x,  // offset in x state vector
+                                          ChState& x,                // state vector, position part
+                                          const unsigned int off_v,  // offset in v state vector
+                                          ChStateDelta& v,           // state vector, speed part
+                                          double& T                  // time
+) {
+    Eigen::Index n = (Eigen::Index)GetNparticles();
+    Map7N X(x.data() + off_x, 7, n);
+    Map6N V(v.data() + off_v, 6, n);
+    X.topRows(3) = Map3N(pos.data(), 3, n);
+    X.bottomRows(4) = Map4N(rot.data(), 4, n);
+    V.topRows(3) = Map3N(pos_dt.data(), 3, n);
+    V.bottomRows(3) = Map3N(wvel_loc.data(), 3, n);
+    T = GetChTime();
+}
+
+void ChParticlesClonesSoA::IntStateScatter(const unsigned int off_x,  // offset in x state vector
+                                           const ChState& x,          // state vector, position part
+                                           const unsigned int off_v,  // offset in v state vector
+                                           const ChStateDelta& v,     // state vector, speed part
+                                           const double T             // time
+) {
+    Eigen::Index n = (Eigen::Index)GetNparticles();
+    ConstMap7N X(x.data() + off_x, 7, n);
+    ConstMap6N V(v.data() + off_v, 6, n);
+    Map3N(pos.data(), 3, n) = X.topRows(3);
+    Map4N(rot.data(), 4, n) = X.bottomRows(4);
+    Map3N(pos_dt.data(), 3, n) = V.topRows(3);
+    Map3N(wvel_loc.data(), 3, n) = V.bottomRows(3);
+    SetChTime(T);
+    Update(T);
+}
+
+void ChParticlesClonesSoA::IntStateGatherAcceleration(const unsigned int off_a, ChStateDelta& a) {
+    Eigen::Index n = (Eigen::Index)GetNparticles();
+    Map6N A(a.data() + off_a, 6, n);
+    A.topRows(3) = Map3N(pos_dtdt.data(), 3, n);
+    A.bottomRows(3) = Map3N(wacc_loc.data(), 3, n);
+}
+
+void ChParticlesClonesSoA::IntStateScatterAcceleration(const unsigned int off_a, const ChStateDelta& a) {
+    Eigen::Index n = (Eigen::Index)GetNparticles();
+    ConstMap6N A(a.data() + off_a, 6, n);
+    Map3N(pos_dtdt.data(), 3, n) = A.topRows(3);
+    Map3N(wacc_loc.data(), 3, n) = A.bottomRows(3);
+}
+
+void ChParticlesClonesSoA::IntStateIncrement(const unsigned int off_x,  // offset in x state vector
+                                             ChState& x_new,            // state vector, position part, incremented
+                                             const ChState& x,          // state vector, initial position part
+                                             const unsigned int off_v,  // offset in v state vector
+                                             const ChStateDelta& Dv     // state vector, increment
+) {
+    Eigen::Index n = (Eigen::Index)GetNparticles();
+    ConstMap7N X(x.data() + off_x, 7, n);
+    ConstMap6N D(Dv.data() + off_v, 6, n);
+    Map7N X_new(x_new.data() + off_x, 7, n);
+
+    // ADVANCE POSITION:
+    X_new.topRows(3) = X.topRows(3) + D.topRows(3);
+
+    // ADVANCE ROTATION: rot' = delta*rot  (use quaternion for delta rotation)
+    for (Eigen::Index j = 0; j < n; j++) {
+        ChQuaternion<> moldrot(X.block<4, 1>(3, j));
+        ChVector<> newwel_abs = GetParticleRot((unsigned int)j).Rotate(ChVector<>(D.block<3, 1>(3, j)));
+        X_new.block<4, 1>(3, j) = ChAparticleBase::IncrementRotation(moldrot, newwel_abs).eigen();
+    }
+}
+
+void ChParticlesClonesSoA::IntLoadResidual_F(const unsigned int off,  // offset in R residual
+                                             ChVectorDynamic<>& R,    // result: the R residual, R += c*F
+                                             const double c           // a scaling factor
+) {
+    ChVector<> Gforce;
+    if (GetSystem())
+        Gforce = GetSystem()->Get_G_acc() * particle_mass.GetBodyMass();
+
+    Eigen::Index n = (Eigen::Index)GetNparticles();
+    Map6N Rm(R.data() + off, 6, n);
+    ConstMap3N W(wvel_loc.data(), 3, n);
+    const ChMatrix33<>& I = particle_mass.GetBodyInertia();
+
+    // applied forces and torques, and gravity
+    Rm.topRows(3) += c * ConstMap3N(force.data(), 3, n);
+    Rm.topRows(3).colwise() += c * Gforce.eigen();
+    Rm.bottomRows(3) += c * ConstMap3N(torque.data(), 3, n);
+
+    // particle gyroscopic torques
+    for (Eigen::Index j = 0; j < n; j++) {
+        Eigen::Vector3d w = W.col(j);
+        Rm.block<3, 1>(3, j) -= c * w.cross(I * w);
+    }
+}
+
+void ChParticlesClonesSoA::IntLoadResidual_Mv(const unsigned int off,      // offset in R residual
+                                              ChVectorDynamic<>& R,        // result: the R residual, R += c*M*v
+                                              const ChVectorDynamic<>& w,  // the w vector
+                                              const double c               // a scaling factor
+) {
+    Eigen::Index n = (Eigen::Index)GetNparticles();
+    Map6N Rm(R.data() + off, 6, n);
+    ConstMap6N Wm(w.data() + off, 6, n);
+    Rm.topRows(3) += (c * GetMass()) * Wm.topRows(3);
+    Rm.bottomRows(3).noalias() += c * particle_mass.GetBodyInertia() * Wm.bottomRows(3);
+}
+
+void ChParticlesClonesSoA::IntToDescriptor(const unsigned int off_v,  // offset in v, R
+                                           const ChStateDelta& v,
+                                           const ChVectorDynamic<>& R,
+                                           const unsigned int off_L,  // offset in L, Qc
+                                           const ChVectorDynamic<>& L,
+                                           const ChVectorDynamic<>& Qc) {
+    for (unsigned int j = 0; j < particles.size(); j++) {
+        particles[j].variables.Get_qb() = v.segment(off_v + 6 * j, 6);
+        particles[j].variables.Get_fb() = R.segment(off_v + 6 * j, 6);
+    }
+}
+
+void ChParticlesClonesSoA::IntFromDescriptor(const unsigned int off_v,  // offset in v
+                                             ChStateDelta& v,
+                                             const unsigned int off_L,  // offset in L
+                                             ChVectorDynamic<>& L) {
+    for (unsigned int j = 0; j < particles.size(); j++) {
+        v.segment(off_v + 6 * j, 6) = particles[j].variables.Get_qb();
+    }
+}
+
+void ChParticlesClonesSoA::InjectVariables(ChSystemDescriptor& mdescriptor) {
+    for (unsigned int j = 0; j < particles.size(); j++) {
+        mdescriptor.InsertVariables(&(particles[j].variables));
+    }
+}
+
+void ChParticlesClonesSoA::VariablesFbReset() {
+    for (unsigned int j = 0; j < particles.size(); j++) {
+        particles[j].variables.Get_fb().setZero();
+    }
+}
+
+void ChParticlesClonesSoA::VariablesFbLoadForces(double factor) {
+    ChVector<> Gforce;
+    if (GetSystem())
+        Gforce = GetSystem()->Get_G_acc() * particle_mass.GetBodyMass();
+
+    for (unsigned int j = 0; j < particles.size(); j++) {
+        // particle gyroscopic force:
+        ChVector<> Wvel = GetParticleWvel_loc(j);
+        ChVector<> gyro = Vcross(Wvel, particle_mass.GetBodyInertia() * Wvel);
+
+        // add applied forces and torques (and also the gyroscopic torque and gravity!) to 'fb' vector
+        particles[j].variables.Get_fb().segment(0, 3) += factor * (GetParticleForce(j) + Gforce).eigen();
+        particles[j].variables.Get_fb().segment(3, 3) += factor * (GetParticleTorque(j) - gyro).eigen();
+    }
+}
+
+void ChParticlesClonesSoA::VariablesQbLoadSpeed() {
+    for (unsigned int j = 0; j < particles.size(); j++) {
+        // set current speed in 'qb', it can be used by the solver when working in incremental mode
+        particles[j].variables.Get_qb().segment(0, 3) = GetParticlePos_dt(j).eigen();
+        particles[j].variables.Get_qb().segment(3, 3) = GetParticleWvel_loc(j).eigen();
+    }
+}
+
+void ChParticlesClonesSoA::VariablesFbIncrementMq() {
+    for (unsigned int j = 0; j < particles.size(); j++) {
+        particles[j].variables.Compute_inc_Mb_v(particles[j].variables.Get_fb(), particles[j].variables.Get_qb());
+    }
+}
+
+void ChParticlesClonesSoA::VariablesQbSetSpeed(double step) {
+    for (unsigned int j = 0; j < particles.size(); j++) {
+        ChVector<> old_pos_dt = GetParticlePos_dt(j);
+        ChVector<> old_wvel_loc = GetParticleWvel_loc(j);
+
+        // from 'qb' vector, sets particle speed
+        SetParticlePos_dt(j, particles[j].variables.Get_qb().segment(0, 3));
+        SetParticleWvel_loc(j, particles[j].variables.Get_qb().segment(3, 3));
+
+        // Compute accel. by BDF (approximate by differentiation);
+        if (step) {
+            ChVector<> acc = (GetParticlePos_dt(j) - old_pos_dt) / step;
+            ChVector<> wacc = (GetParticleWvel_loc(j) - old_wvel_loc) / step;
+            Map3N(pos_dtdt.data(), 3, particles.size()).col(j) = acc.eigen();
+            Map3N(wacc_loc.data(), 3, particles.size()).col(j) = wacc.eigen();
+        }
+    }
+}
+
+void ChParticlesClonesSoA::VariablesQbIncrementPosition(double dt_step) {
+    for (unsigned int j = 0; j < particles.size(); j++) {
+        // Updates position with incremental action of speed contained in the
+        // 'qb' vector:  pos' = pos + dt * speed   , like in an Eulero step.
+
+        ChVector<> newspeed(particles[j].variables.Get_qb().segment(0, 3));
+        ChVector<> newwel(particles[j].variables.Get_qb().segment(3, 3));
+
+        // ADVANCE POSITION: pos' = pos + dt * vel
+        SetParticlePos(j, GetParticlePos(j) + newspeed * dt_step);
+
+        // ADVANCE ROTATION: rot' = [dt*wwel]%rot  (use quaternion for delta rotation)
+        ChQuaternion<> moldrot = GetParticleRot(j);
+        SetParticleRot(j, ChAparticleBase::IncrementRotation(moldrot, moldrot.Rotate(newwel) * dt_step));
+    }
+}
+
+void ChParticlesClonesSoA::SetNoSpeedNoAcceleration() {
+    std::fill(pos_dt.begin(), pos_dt.end(), 0.0);
+    std::fill(wvel_loc.begin(), wvel_loc.end(), 0.0);
+    std::fill(pos_dtdt.begin(), pos_dtdt.end(), 0.0);
+    std::fill(wacc_loc.begin(), wacc_loc.end(), 0.0);
+}
+
+void ChParticlesClonesSoA::ClampSpeed() {
+    if (GetLimitSpeed()) {
+        Eigen::Index n = (Eigen::Index)GetNparticles();
+        Map3N V(pos_dt.data(), 3, n);
+        Map3N W(wvel_loc.data(), 3, n);
+        for (Eigen::Index j = 0; j < n; j++) {
+            double w = W.col(j).norm();
+            if (w > max_wvel)
+                W.col(j) *= max_wvel / w;
+
+            double v = V.col(j).norm();
+            if (v > max_speed)
+                V.col(j) *= max_speed / v;
+        }
+    }
+}
+
+// The inertia tensor functions
+
+void ChParticlesClonesSoA::SetInertia(const ChMatrix33<>& newXInertia) {
+    particle_mass.SetBodyInertia(newXInertia);
+}
+
+void ChParticlesClonesSoA::SetInertiaXX(const ChVector<>& iner) {
+    particle_mass.SetBodyInertiaXX(iner);
+}
+
+void ChParticlesClonesSoA::SetInertiaXY(const ChVector<>& iner) {
+    particle_mass.SetBodyInertiaXY(iner);
+}
+
+ChVector<> ChParticlesClonesSoA::GetInertiaXX() const {
+    return particle_mass.GetBodyInertiaXX();
+}
+
+ChVector<> ChParticlesClonesSoA::GetInertiaXY() const {
+    return particle_mass.GetBodyInertiaXY();
+}
+
+void ChParticlesClonesSoA::Update(bool update_assets) {
+    ChParticlesClonesSoA::Update(GetChTime(), update_assets);
+}
+
+void ChParticlesClonesSoA::Update(double mytime, bool update_assets) {
+    ChTime = mytime;
+
+    ClampSpeed();  // Apply limits (if in speed clamping mode) to speeds.
+}
+
+// collision stuff
+void ChParticlesClonesSoA::SetCollide(bool mcoll) {
+    if (mcoll == do_collide)
+        return;
+
+    if (mcoll) {
+        do_collide = true;
+        if (GetSystem()) {
+            for (unsigned int j = 0; j < particles.size(); j++) {
+                GetSystem()->GetCollisionSystem()->Add(particles[j].collision_model);
+            }
+        }
+    } else {
+        do_collide = false;
+        if (GetSystem()) {
+            for (unsigned int j = 0; j < particles.size(); j++) {
+                GetSystem()->GetCollisionSystem()->Remove(particles[j].collision_model);
+            }
+        }
+    }
+}
+
+void ChParticlesClonesSoA::SyncCollisionModels() {
+    for (unsigned int j = 0; j < particles.size(); j++) {
+        particles[j].collision_model->SyncPosition();
+    }
+}
+
+void ChParticlesClonesSoA::AddCollisionModelsToSystem() {
+    assert(GetSystem());
+    SyncCollisionModels();
+    for (unsigned int j = 0; j < particles.size(); j++) {
+        GetSystem()->GetCollisionSystem()->Add(particles[j].collision_model);
+    }
+}
+
+void ChParticlesClonesSoA::RemoveCollisionModelsFromSystem() {
+    assert(GetSystem());
+    for (unsigned int j = 0; j < particles.size(); j++) {
+        GetSystem()->GetCollisionSystem()->Remove(particles[j].collision_model);
+    }
+}
+
+void ChParticlesClonesSoA::UpdateParticleCollisionModels() {
+    for (unsigned int j = 0; j < particles.size(); j++) {
+        particles[j].collision_model->ClearModel();
+        particles[j].collision_model->AddCopyOfAnotherModel(particle_collision_model);
+        particles[j].collision_model->BuildModel();
+    }
+}
+
+// FILE I/O
+
+void ChParticlesClonesSoA::ArchiveOUT(ChArchiveOut& marchive) {
+    // version number
+    marchive.VersionWrite<ChParticlesClonesSoA>();
+
+    // serialize parent class
+    ChIndexedParticles::ArchiveOUT(marchive);
+
+    // serialize all member data:
+    marchive << CHNVP(pos);
+    marchive << CHNVP(rot);
+    marchive << CHNVP(pos_dt);
+    marchive << CHNVP(wvel_loc);
+    marchive << CHNVP(pos_dtdt);
+    marchive << CHNVP(wacc_loc);
+    marchive << CHNVP(force);
+    marchive << CHNVP(torque);
+    marchive << CHNVP(particle_collision_model);
+    marchive << CHNVP(matsurface);
+    marchive << CHNVP(do_collide);
+    marchive << CHNVP(do_limit_speed);
+    marchive << CHNVP(max_speed);
+    marchive << CHNVP(max_wvel);
+}
+
+void ChParticlesClonesSoA::ArchiveIN(ChArchiveIn& marchive) {
+    // version number
+    int version = marchive.VersionRead<ChParticlesClonesSoA>();
+
+    // deserialize parent class:
+    ChIndexedParticles::ArchiveIN(marchive);
+
+    // deserialize all member data:
+    SetCollide(false);  // this will remove old particle coll.models from coll.engine, if previously added
+    particles.clear();
+
+    marchive >> CHNVP(pos);
+    marchive >> CHNVP(rot);
+    marchive >> CHNVP(pos_dt);
+    marchive >> CHNVP(wvel_loc);
+    marchive >> CHNVP(pos_dtdt);
+    marchive >> CHNVP(wacc_loc);
+    marchive >> CHNVP(force);
+    marchive >> CHNVP(torque);
+    marchive >> CHNVP(particle_collision_model);
+    marchive >> CHNVP(matsurface);
+    marchive >> CHNVP(do_collide);
+    marchive >> CHNVP(do_limit_speed);
+    marchive >> CHNVP(max_speed);
+    marchive >> CHNVP(max_wvel);
+
+    bool mcoll = do_collide;
+    do_collide = false;
+    CreateParticles(0);
+    SetCollide(mcoll);
+}
+
+}  // end namespace chrono
@@ -0,0 +1,329 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+
+#ifndef CHPARTICLESCLONESSOA_H
+#define CHPARTICLESCLONESSOA_H
+
+#include <deque>
+#include <vector>
+
+#include "chrono/physics/ChParticlesClones.h"
+
+namespace chrono {
+
+// Forward references (for parent hierarchy pointer)
+class ChParticlesClonesSoA;
+
+/// Class for a single particle of a ChParticlesClonesSoA cluster.
+/// The particle state is not stored here, but in the arrays of the container. This object only carries
+/// what must be addressable per particle (the solver variables and the collision model) and implements the
+/// ChContactable interface (see ChAparticleBase) by indexing into the container arrays.\n
+/// The particle frame is a proxy of the particle state: it is refreshed from the container arrays by
+/// ChParticlesClonesSoA::GetParticle, and all its Set... functions write through to the container arrays.
+/// Modifications through other means (e.g. the non-const references returned by GetPos() or GetCoord(), or the
+/// frame operators) only affect the frame and are not propagated to the container.
+class ChApi ChAparticleSoA : public ChAparticleBase {
+  public:
+    ChAparticleSoA(ChParticlesClonesSoA* container, unsigned int index);
+    ChAparticleSoA(const ChAparticleSoA& other) = delete;
+    ~ChAparticleSoA() {}
+
+    ChAparticleSoA& operator=(const ChAparticleSoA& other) = delete;
+
+    /// Get the container.
+    ChParticlesClonesSoA* GetContainer() const { return container; }
+
+    /// Get the index of this particle in the container.
+    unsigned int GetIndex() const { return index; }
+
+    /// This is only for backward compatibility
+    virtual ChPhysicsItem* GetPhysicsItem() override;
+
+    // Frame setters, writing through to the container arrays
+
+    virtual void SetCoord(const ChCoordsys<>& mcoord) override;
+    virtual void SetCoord(const ChVector<>& mv, const ChQuaternion<>& mq) override;
+    virtual void SetRot(const ChQuaternion<>& mrot) override;
+    virtual void SetRot(const ChMatrix33<>& mA) override;
+    virtual void SetPos(const ChVector<>& mpos) override;
+    virtual void SetCoord_dt(const ChCoordsys<>& mcoord_dt) override;
+    virtual void SetPos_dt(const ChVector<>& mvel) override;
+    virtual void SetRot_dt(const ChQuaternion<>& mrot_dt) override;
+    virtual void SetWvel_loc(const ChVector<>& wl) override;
+    virtual void SetWvel_par(const ChVector<>& wp) override;
+    virtual void SetCoord_dtdt(const ChCoordsys<>& mcoord_dtdt) override;
+    virtual void SetPos_dtdt(const ChVector<>& macc) override;
+    virtual void SetRot_dtdt(const ChQuaternion<>& mrot_dtdt) override;
+    virtual void SetWacc_loc(const ChVector<>& al) override;
+    virtual void SetWacc_par(ChVector<>& ap) override;
+
+    //
+    // DATA
+    //
+
+    ChParticlesClonesSoA* container;
+    unsigned int index;
+
+  private:
+    virtual ChCoordsys<> GetStateCoord() const override;
+    virtual ChVector<> GetStatePos_dt() const override;
+    virtual ChVector<> GetStateWvel_loc() const override;
+
+    /// Refresh the particle frame from the container arrays.
+    void ReadState();
+
+    /// Write the particle frame to the container arrays.
+    void WriteState();
+
+    friend class ChParticlesClonesSoA;
+};
+
+/// Class for clusters of 'clone' particles with structure-of-arrays storage.
+/// This is a variant of ChParticlesClones for very large numbers of identical particles: positions,
+/// rotations, velocities, accelerations, and applied forces of all particles are stored in contiguous
+/// arrays, so that the state gather/scatter, state increment, and residual loading are performed with
+/// vectorized operations over these arrays rather than by visiting one heap object per particle.
+/// The per-particle objects (ChAparticleSoA) only hold the solver variables and the collision models.
+/// The particle frame returned by GetParticle() is refreshed from the arrays at each call, and its Set...
+/// functions write through to the arrays (see ChAparticleSoA). The SetParticle... functions of this class
+/// modify the state of a particle directly.
+class ChApi ChParticlesClonesSoA : public ChIndexedParticles {
+  public:
+    ChParticlesClonesSoA();
+    ChParticlesClonesSoA(const ChParticlesClonesSoA& other);
+    ~ChParticlesClonesSoA();
+
+    /// "Virtual" copy constructor (covariant return type).
+    virtual ChParticlesClonesSoA* Clone() const override { return new ChParticlesClonesSoA(*this); }
+
+    /// Enable/disable the collision for this cluster of particles.
+    void SetCollide(bool mcoll);
+    virtual bool GetCollide() const override { return do_collide; }
+
+    /// Enable/disable clamping of the particle speeds (see SetMaxSpeed and SetMaxWvel).
+    void SetLimitSpeed(bool mlimit) { do_limit_speed = mlimit; }
+    bool GetLimitSpeed() const { return do_limit_speed; }
+
+    /// Get the number of particles
+    size_t GetNparticles() const override { return particles.size(); }
+
+    /// Access the N-th particle.
+    /// The frame of the returned particle is refreshed from the container arrays; modifications through its
+    /// Set... functions are written to the container arrays.
+    ChParticleBase& GetParticle(unsigned int n) override;
+
+    /// Resize the particle cluster. Also clear the state of
+    /// previously created particles, if any.
+    /// NOTE! Define the sample collision shape using GetCollisionModel()->...
+    /// before adding particles!
+    void ResizeNparticles(int newsize) override;
+
+    /// Add a new particle to the particle cluster, passing a
+    /// coordinate system as initial state.
+    /// NOTE! Define the sample collision shape using GetCollisionModel()->...
+    /// before adding particles!
+    void AddParticle(ChCoordsys<double> initial_state = CSYSNORM) override;
+
+    /// Set the material surface for contacts
+    void SetMaterialSurface(const std::shared_ptr<ChMaterialSurface>& mnewsurf) { matsurface = mnewsurf; }
+
+    /// Set the material surface for contacts
+    std::shared_ptr<ChMaterialSurface>& GetMaterialSurface() { return matsurface; }
+
+    //
+    // PARTICLE STATE
+    //
+
+    /// Get the position of the N-th particle.
+    ChVector<> GetParticlePos(unsigned int n) const;
+    /// Set the position of the N-th particle.
+    void SetParticlePos(unsigned int n, const ChVector<>& p);
+
+    /// Get the rotation of the N-th particle.
+    ChQuaternion<> GetParticleRot(unsigned int n) const;
+    /// Set the rotation of the N-th particle.
+    void SetParticleRot(unsigned int n, const ChQuaternion<>& q);
+
+    /// Get the linear velocity of the N-th particle.
+    ChVector<> GetParticlePos_dt(unsigned int n) const;
+    /// Set the linear velocity of the N-th particle.
+    void SetParticlePos_dt(unsigned int n, const ChVector<>& v);
+
+    /// Get the angular velocity of the N-th particle (in the particle frame).
+    ChVector<> GetParticleWvel_loc(unsigned int n) const;
+    /// Set the angular velocity of the N-th particle (in the particle frame).
+    void SetParticleWvel_loc(unsigned int n, const ChVector<>& w);
+
+    /// Get the force applied to the N-th particle (in the absolute frame).
+    ChVector<> GetParticleForce(unsigned int n) const;
+    /// Set the force applied to the N-th particle (in the absolute frame).
+    void SetParticleForce(unsigned int n, const ChVector<>& f);
+
+    /// Get the torque applied to the N-th particle (in the particle frame).
+    ChVector<> GetParticleTorque(unsigned int n) const;
+    /// Set the torque applied to the N-th particle (in the particle frame).
+    void SetParticleTorque(unsigned int n, const ChVector<>& t);
+
+    //
+    // STATE FUNCTIONS
+    //
+
+    // (override/implement interfaces for global state vectors, see ChPhysicsItem for comments.)
+    virtual void IntStateGather(const unsigned int off_x,
+                                ChState& x,
+                                const unsigned int off_v,
+                                ChStateDelta& v,
+                                double& T) override;
+    virtual void IntStateScatter(const unsigned int off_x,
+                                 const ChState& x,
+                                 const unsigned int off_v,
+                                 const ChStateDelta& v,
+                                 const double T) override;
+    virtual void IntStateGatherAcceleration(const unsigned int off_a, ChStateDelta& a) override;
+    virtual void IntStateScatterAcceleration(const unsigned int off_a, const ChStateDelta& a) override;
+    virtual void IntStateIncrement(const unsigned int off_x,
+                                   ChState& x_new,
+                                   const ChState& x,
+                                   const unsigned int off_v,
+                                   const ChStateDelta& Dv) override;
+    virtual void IntLoadResidual_F(const unsigned int off, ChVectorDynamic<>& R, const double c) override;
+    virtual void IntLoadResidual_Mv(const unsigned int off,
+                                    ChVectorDynamic<>& R,
+                                    const ChVectorDynamic<>& w,
+                                    const double c) override;
+    virtual void IntToDescriptor(const unsigned int off_v,
+                                 const ChStateDelta& v,
+                                 const ChVectorDynamic<>& R,
+                                 const unsigned int off_L,
+                                 const ChVectorDynamic<>& L,
+                                 const ChVectorDynamic<>& Qc) override;
+    virtual void IntFromDescriptor(const unsigned int off_v,
+                                   ChStateDelta& v,
+                                   const unsigned int off_L,
+                                   ChVectorDynamic<>& L) override;
+
+    //
+    // SOLVER FUNCTIONS
+    //
+
+    virtual void VariablesFbReset() override;
+    virtual void VariablesFbLoadForces(double factor = 1) override;
+    virtual void VariablesQbLoadSpeed() override;
+    virtual void VariablesFbIncrementMq() override;
+    virtual void VariablesQbSetSpeed(double step = 0) override;
+    virtual void VariablesQbIncrementPosition(double step) override;
+    virtual void InjectVariables(ChSystemDescriptor& mdescriptor) override;
+
+    // Other functions
+
+    /// Set no speed and no accelerations (but does not change the position)
+    void SetNoSpeedNoAcceleration() override;
+
+    /// Access the collision model for the collision engine: this is the 'sample'
+    /// collision model that is used by all particles.
+    collision::ChCollisionModel* GetCollisionModel() { return particle_collision_model; }
+
+    /// Synchronize coll.models coordinates and bounding boxes to the positions of the particles.
+    virtual void SyncCollisionModels() override;
+    virtual void AddCollisionModelsToSystem() override;
+    virtual void RemoveCollisionModelsFromSystem() override;
+
+    /// After you added collision shapes to the sample coll.model (the one
+    /// that you access with GetCollisionModel() ) you need to call this
+    /// function so that all collision models of particles will reference the sample coll.model.
+    void UpdateParticleCollisionModels();
+
+    /// Mass of each particle. Must be positive.
+    void SetMass(double newmass) {
+        if (newmass > 0)
+            particle_mass.SetBodyMass(newmass);
+    }
+    double GetMass() const { return particle_mass.GetBodyMass(); }
+
+    /// Set the inertia tensor of each particle
+    void SetInertia(const ChMatrix33<>& newXInertia);
+    /// Set the diagonal part of the inertia tensor of each particle
+    void SetInertiaXX(const ChVector<>& iner);
+    /// Get the diagonal part of the inertia tensor of each particle
+    ChVector<> GetInertiaXX() const;
+    /// Set the extra-diagonal part of the inertia tensor of each particle
+    /// (xy, yz, zx values, the rest is symmetric)
+    void SetInertiaXY(const ChVector<>& iner);
+    /// Get the extra-diagonal part of the inertia tensor of each particle
+    /// (xy, yz, zx values, the rest is symmetric)
+    ChVector<> GetInertiaXY() const;
+
+    /// Set the maximum linear speed (active only with SetLimitSpeed(true)).
+    void SetMaxSpeed(float m_max_speed) { max_speed = m_max_speed; }
+    float GetMaxSpeed() const { return max_speed; }
+
+    /// Set the maximum angular speed (active only with SetLimitSpeed(true)).
+    void SetMaxWvel(float m_max_wvel) { max_wvel = m_max_wvel; }
+    float GetMaxWvel() const { return max_wvel; }
+
+    /// Clamp the speed of the particles to the limits set with SetMaxSpeed and SetMaxWvel
+    /// (only with SetLimitSpeed(true)).
+    void ClampSpeed();
+
+    //
+    // UPDATE FUNCTIONS
+    //
+
+    /// Update all auxiliary data of the particles
+    virtual void Update(double mytime, bool update_assets = true) override;
+    /// Update all auxiliary data of the particles
+    virtual void Update(bool update_assets = true) override;
+
+    //
+    // SERIALIZATION
+    //
+
+    virtual void ArchiveOUT(ChArchiveOut& marchive) override;
+    virtual void ArchiveIN(ChArchiveIn& marchive) override;
+
+  private:
+    /// Create the per-particle objects for particles [start, GetNparticles()).
+    void CreateParticles(size_t start);
+
+    std::deque<ChAparticleSoA> particles;  ///< per-particle variables and collision models (stable addresses)
+
+    std::vector<double> pos;        ///< particle positions (3 per particle)
+    std::vector<double> rot;        ///< particle rotations (4 per particle)
+    std::vector<double> pos_dt;     ///< particle linear velocities (3 per particle)
+    std::vector<double> wvel_loc;   ///< particle angular velocities, local frame (3 per particle)
+    std::vector<double> pos_dtdt;   ///< particle linear accelerations (3 per particle)
+    std::vector<double> wacc_loc;   ///< particle angular accelerations, local frame (3 per particle)
+    std::vector<double> force;      ///< applied forces, absolute frame (3 per particle)
+    std::vector<double> torque;     ///< applied torques, local frame (3 per particle)
+
+    ChSharedMassBody particle_mass;  ///< shared mass of particles
+
+    collision::ChCollisionModel* particle_collision_model;  ///< sample collision model
+
+    std::shared_ptr<ChMaterialSurface> matsurface;  ///< data for surface contact and impact
+
+    bool do_collide;
+    bool do_limit_speed;
+
+    float max_speed;  ///< limit on linear speed
+    float max_wvel;   ///< limit on angular vel.
+
+    friend class ChAparticleSoA;
+};
+
+CH_CLASS_VERSION(ChParticlesClonesSoA, 0)
+
+}  // end namespace chrono
+
+#endif
@@ -27,13 +27,16 @@ using namespace geometry;
 // Register into the object factory, to enable run-time dynamic creation and persistence
 CH_FACTORY_REGISTER(ChProximityContainerSPH)
 
-ChProximityContainerSPH::ChProximityContainerSPH() : n_added(0) {
+ChProximityContainerSPH::ChProximityContainerSPH()
+    : n_added(0), use_cell_list(false), sph_family(14) {
     lastproximity = proximitylist.begin();
 }
 
 ChProximityContainerSPH::ChProximityContainerSPH(const ChProximityContainerSPH& other)
     : ChProximityContainer(other) {
     n_added = other.n_added;
+    use_cell_list = other.use_cell_list;
+    sph_family = other.sph_family;
     proximitylist = other.proximitylist;
     lastproximity = proximitylist.begin();
 }
@@ -64,11 +67,109 @@ void ChProximityContainerSPH::RemoveAllProximities() {
 
     lastproximity = proximitylist.begin();
     n_added = 0;
+
+    sph_nodes.clear();
+    sph_pos.clear();
+    sph_rad.clear();
+    grid.Update(sph_pos, sph_rad);
 }
 
 void ChProximityContainerSPH::BeginAddProximities() {
     lastproximity = proximitylist.begin();
     n_added = 0;
+
+    if (use_cell_list) {
+        UpdateCellList();
+    } else if (!sph_families.empty()) {
+        // Let the collision system report the node-node pairs again
+        CollectNodes();
+        FilterNodeCollisions(false);
+        sph_nodes.clear();
+        sph_pos.clear();
+        sph_rad.clear();
+        grid.Update(sph_pos, sph_rad);
+    }
+}
+
+void ChProximityContainerSPH::CollectNodes() {
+    sph_nodes.clear();
+    if (!GetSystem())
+        return;
+
+    for (auto otherphysics : GetSystem()->Get_otherphysicslist()) {
+        if (auto matter = std::dynamic_pointer_cast<ChMatterSPH>(otherphysics)) {
+            for (auto& node : matter->GetNodes())
+                sph_nodes.push_back(node.get());
+        }
+    }
+}
+
+void ChProximityContainerSPH::FilterNodeCollisions(bool filter) {
+    // Note that changing the family of a collision model re-inserts it in the collision system, hence the saved
+    // families are also used to tell which nodes were already moved. Entries of nodes no longer in the system are
+    // dropped, as the map is rebuilt from the current nodes.
+    std::unordered_map<ChCollisionModel*, std::pair<short int, short int>> families;
+    short int group = (short int)(1 << sph_family);
+    for (auto node : sph_nodes) {
+        auto model = node->collision_model;
+        auto saved = sph_families.find(model);
+        if (filter) {
+            if (saved != sph_families.end()) {
+                families.insert(*saved);
+                continue;
+            }
+            families.insert(std::make_pair(model, std::make_pair(model->GetFamilyGroup(), model->GetFamilyMask())));
+            model->SetFamilyGroup(group);
+            model->SetFamilyMask((short int)(model->GetFamilyMask() & ~group));
+        } else if (saved != sph_families.end()) {
+            model->SetFamilyGroup(saved->second.first);
+            model->SetFamilyMask(saved->second.second);
+        }
+    }
+    sph_families.swap(families);
+}
+
+void ChProximityContainerSPH::UpdateCellList() {
+    // Collect the nodes and keep the collision system from processing node-node pairs (including new nodes)
+    CollectNodes();
+    FilterNodeCollisions(true);
+
+    // Gather positions and radii in contiguous arrays and find the pairs
+    size_t num_nodes = sph_nodes.size();
+    sph_pos.resize(num_nodes);
+    sph_rad.resize(num_nodes);
+    for (size_t i = 0; i < num_nodes; i++) {
+        sph_pos[i] = sph_nodes[i]->GetPos();
+        sph_rad[i] = sph_nodes[i]->GetKernelRadius();
+    }
+    grid.Update(sph_pos, sph_rad);
+
+    // Store the nodes in cell order, as indexed by the pairs
+    const auto& sorted = grid.GetSortedIndices();
+    std::vector<ChNodeSPH*> nodes(num_nodes);
+    for (size_t k = 0; k < num_nodes; k++)
+        nodes[k] = sph_nodes[sorted[k]];
+    sph_nodes.swap(nodes);
+
+    sph_vel.resize(num_nodes);
+    sph_mass.resize(num_nodes);
+    sph_vol.resize(num_nodes);
+    sph_press.resize(num_nodes);
+    sph_visc.resize(num_nodes);
+    sph_density.resize(num_nodes);
+    sph_force.resize(num_nodes);
+
+    n_added = (int)grid.GetNumPairs();
+
+    // Launch the proximity callback, if implemented by the user
+    if (this->add_proximity_callback) {
+        const auto& pairsA = grid.GetPairsA();
+        const auto& pairsB = grid.GetPairsB();
+        for (size_t ip = 0; ip < pairsA.size(); ip++) {
+            this->add_proximity_callback->OnAddProximity(*sph_nodes[pairsA[ip]]->collision_model,
+                                                         *sph_nodes[pairsB[ip]]->collision_model);
+        }
+    }
 }
 
 void ChProximityContainerSPH::EndAddProximities() {
@@ -88,6 +189,10 @@ void ChProximityContainerSPH::AddProximity(collision::ChCollisionModel* modA, co
     if (!(mnA && mnB))
         return;
 
+    // With the cell list, SPH pairs are not taken from the collision system
+    if (use_cell_list)
+        return;
+
     // Launch the proximity callback, if implemented by the user
 
     if (this->add_proximity_callback) {
@@ -112,6 +217,18 @@ void ChProximityContainerSPH::AddProximity(collision::ChCollisionModel* modA, co
 }
 
 void ChProximityContainerSPH::ReportAllProximities(ReportProximityCallback* mcallback) {
+    if (use_cell_list) {
+        const auto& pairsA = grid.GetPairsA();
+        const auto& pairsB = grid.GetPairsB();
+        for (size_t ip = 0; ip < pairsA.size(); ip++) {
+            bool proceed = mcallback->OnReportProximity(sph_nodes[pairsA[ip]]->collision_model,
+                                                        sph_nodes[pairsB[ip]]->collision_model);
+            if (!proceed)
+                break;
+        }
+        return;
+    }
+
     std::list<ChProximitySPH*>::iterator iterproximity = proximitylist.begin();
     while (iterproximity != proximitylist.end()) {
         bool proceed = mcallback->OnReportProximity((*iterproximity)->GetModelA(), (*iterproximity)->GetModelB());
@@ -145,68 +262,142 @@ static void W_gr_press(ChVector<>& Wresult, const ChVector<>& r, const double r_
         Wresult = VNULL;
 }
 
-void ChProximityContainerSPH::AccumulateStep1() {
-    // Per-edge data computation
-    std::list<ChProximitySPH*>::iterator iterproximity = proximitylist.begin();
-    while (iterproximity != proximitylist.end()) {
-        ChNodeSPH* mnodeA = dynamic_cast<ChNodeSPH*>((*iterproximity)->GetModelA()->GetContactable());
-        ChNodeSPH* mnodeB = dynamic_cast<ChNodeSPH*>((*iterproximity)->GetModelB()->GetContactable());
+// Per-edge initialization and accumulation of the nodes' density
+static void AccumulateDensity(ChNodeSPH* mnodeA, ChNodeSPH* mnodeB) {
+    ChVector<> x_A = mnodeA->GetPos();
+    ChVector<> x_B = mnodeB->GetPos();
 
-        ChVector<> x_A = mnodeA->GetPos();
-        ChVector<> x_B = mnodeB->GetPos();
+    ChVector<> r_BA = x_B - x_A;
+    double dist_BA = r_BA.Length();
 
-        ChVector<> r_BA = x_B - x_A;
-        double dist_BA = r_BA.Length();
+    double W_k_poly6 = W_poly6(dist_BA, mnodeA->GetKernelRadius());
 
-        double W_k_poly6 = W_poly6(dist_BA, mnodeA->GetKernelRadius());
+    // increment data of connected nodes
 
-        // increment data of connected nodes
+    mnodeA->density += mnodeB->GetMass() * W_k_poly6;
+    mnodeB->density += mnodeA->GetMass() * W_k_poly6;
+}
 
-        mnodeA->density += mnodeB->GetMass() * W_k_poly6;
-        mnodeB->density += mnodeA->GetMass() * W_k_poly6;
+// Per-edge transfer of stress to forces
+static void AccumulateForces(ChNodeSPH* mnodeA, ChNodeSPH* mnodeB) {
+    ChVector<> x_A = mnodeA->GetPos();
+    ChVector<> x_B = mnodeB->GetPos();
 
-        ++iterproximity;
-    }
-}
+    ChVector<> r_BA = x_B - x_A;
+    double dist_BA = r_BA.Length();
 
-void ChProximityContainerSPH::AccumulateStep2() {
-    // Per-edge data computation (transfer stress to forces)
-    std::list<ChProximitySPH*>::iterator iterproximity = proximitylist.begin();
-    while (iterproximity != proximitylist.end()) {
-        ChNodeSPH* mnodeA = dynamic_cast<ChNodeSPH*>((*iterproximity)->GetModelA()->GetContactable());
-        ChNodeSPH* mnodeB = dynamic_cast<ChNodeSPH*>((*iterproximity)->GetModelB()->GetContactable());
+    // increment pressure forces
 
-        ChVector<> x_A = mnodeA->GetPos();
-        ChVector<> x_B = mnodeB->GetPos();
+    ChVector<> W_k_press;
+    W_gr_press(W_k_press, r_BA, dist_BA, mnodeA->GetKernelRadius());
 
-        ChVector<> r_BA = x_B - x_A;
-        double dist_BA = r_BA.Length();
+    double avg_press = 0.5 * (mnodeA->pressure + mnodeB->pressure);
 
-        // increment pressure forces
+    ChVector<> pressureForceA = W_k_press * mnodeA->volume * avg_press * mnodeB->volume;
+    mnodeA->UserForce += pressureForceA;
 
-        ChVector<> W_k_press;
-        W_gr_press(W_k_press, r_BA, dist_BA, mnodeA->GetKernelRadius());
+    // ChVector<> pressureForceB  = - W_k_press * mnodeB->volume * avg_dens * mnodeA->volume;
+    mnodeB->UserForce -= pressureForceA;
 
-        double avg_press = 0.5 * (mnodeA->pressure + mnodeB->pressure);
+    // increment viscous forces..
 
-        ChVector<> pressureForceA = W_k_press * mnodeA->volume * avg_press * mnodeB->volume;
-        mnodeA->UserForce += pressureForceA;
+    double W_k_visc = W_sq_visco(dist_BA, mnodeA->GetKernelRadius());
+    ChVector<> velBA = mnodeB->GetPos_dt() - mnodeA->GetPos_dt();
 
-        // ChVector<> pressureForceB  = - W_k_press * mnodeB->volume * avg_dens * mnodeA->volume;
-        mnodeB->UserForce -= pressureForceA;
+    double avg_viscosity = 0.5 * (mnodeA->GetContainer()->GetMaterial().Get_viscosity() +
+                                  mnodeB->GetContainer()->GetMaterial().Get_viscosity());
 
-        // increment viscous forces..
+    ChVector<> viscforceBA = velBA * (mnodeA->volume * avg_viscosity * mnodeB->volume * W_k_visc);
+    mnodeA->UserForce += viscforceBA;
+    mnodeB->UserForce -= viscforceBA;
+}
 
-        double W_k_visc = W_sq_visco(dist_BA, mnodeA->GetKernelRadius());
-        ChVector<> velBA = mnodeB->GetPos_dt() - mnodeA->GetPos_dt();
+void ChProximityContainerSPH::AccumulateStep1() {
+    // Per-edge data computation
+    if (use_cell_list) {
+        // Gather the node data in cell order, accumulate over the pairs, then scatter the density to the nodes
+        size_t num_nodes = sph_nodes.size();
+        for (size_t i = 0; i < num_nodes; i++) {
+            sph_pos[i] = sph_nodes[i]->GetPos();
+            sph_rad[i] = sph_nodes[i]->GetKernelRadius();
+            sph_mass[i] = sph_nodes[i]->GetMass();
+            sph_density[i] = 0;
+        }
+
+        const auto& pairsA = grid.GetPairsA();
+        const auto& pairsB = grid.GetPairsB();
+        for (size_t ip = 0; ip < pairsA.size(); ip++) {
+            unsigned int a = pairsA[ip];
+            unsigned int b = pairsB[ip];
+            double W_k_poly6 = W_poly6((sph_pos[b] - sph_pos[a]).Length(), sph_rad[a]);
+            sph_density[a] += sph_mass[b] * W_k_poly6;
+            sph_density[b] += sph_mass[a] * W_k_poly6;
+        }
+
+        for (size_t i = 0; i < num_nodes; i++)
+            sph_nodes[i]->density += sph_density[i];
+        return;
+    }
 
-        double avg_viscosity = 0.5 * (mnodeA->GetContainer()->GetMaterial().Get_viscosity() +
-                                      mnodeB->GetContainer()->GetMaterial().Get_viscosity());
+    std::list<ChProximitySPH*>::iterator iterproximity = proximitylist.begin();
+    while (iterproximity != proximitylist.end()) {
+        ChNodeSPH* mnodeA = dynamic_cast<ChNodeSPH*>((*iterproximity)->GetModelA()->GetContactable());
+        ChNodeSPH* mnodeB = dynamic_cast<ChNodeSPH*>((*iterproximity)->GetModelB()->GetContactable());
+        AccumulateDensity(mnodeA, mnodeB);
+        ++iterproximity;
+    }
+}
 
-        ChVector<> viscforceBA = velBA * (mnodeA->volume * avg_viscosity * mnodeB->volume * W_k_visc);
-        mnodeA->UserForce += viscforceBA;
-        mnodeB->UserForce -= viscforceBA;
+void ChProximityContainerSPH::AccumulateStep2() {
+    // Per-edge data computation (transfer stress to forces)
+    if (use_cell_list) {
+        // Gather the node data in cell order, accumulate over the pairs, then scatter the forces to the nodes
+        size_t num_nodes = sph_nodes.size();
+        for (size_t i = 0; i < num_nodes; i++) {
+            sph_pos[i] = sph_nodes[i]->GetPos();
+            sph_vel[i] = sph_nodes[i]->GetPos_dt();
+            sph_rad[i] = sph_nodes[i]->GetKernelRadius();
+            sph_vol[i] = sph_nodes[i]->volume;
+            sph_press[i] = sph_nodes[i]->pressure;
+            sph_visc[i] = sph_nodes[i]->GetContainer()->GetMaterial().Get_viscosity();
+            sph_force[i] = VNULL;
+        }
+
+        const auto& pairsA = grid.GetPairsA();
+        const auto& pairsB = grid.GetPairsB();
+        for (size_t ip = 0; ip < pairsA.size(); ip++) {
+            unsigned int a = pairsA[ip];
+            unsigned int b = pairsB[ip];
+            ChVector<> r_BA = sph_pos[b] - sph_pos[a];
+            double dist_BA = r_BA.Length();
+
+            // pressure forces
+            ChVector<> W_k_press;
+            W_gr_press(W_k_press, r_BA, dist_BA, sph_rad[a]);
+            double avg_press = 0.5 * (sph_press[a] + sph_press[b]);
+            ChVector<> pressureForceA = W_k_press * sph_vol[a] * avg_press * sph_vol[b];
+            sph_force[a] += pressureForceA;
+            sph_force[b] -= pressureForceA;
+
+            // viscous forces
+            double W_k_visc = W_sq_visco(dist_BA, sph_rad[a]);
+            ChVector<> velBA = sph_vel[b] - sph_vel[a];
+            double avg_viscosity = 0.5 * (sph_visc[a] + sph_visc[b]);
+            ChVector<> viscforceBA = velBA * (sph_vol[a] * avg_viscosity * sph_vol[b] * W_k_visc);
+            sph_force[a] += viscforceBA;
+            sph_force[b] -= viscforceBA;
+        }
+
+        for (size_t i = 0; i < num_nodes; i++)
+            sph_nodes[i]->UserForce += sph_force[i];
+        return;
+    }
 
+    std::list<ChProximitySPH*>::iterator iterproximity = proximitylist.begin();
+    while (iterproximity != proximitylist.end()) {
+        ChNodeSPH* mnodeA = dynamic_cast<ChNodeSPH*>((*iterproximity)->GetModelA()->GetContactable());
+        ChNodeSPH* mnodeB = dynamic_cast<ChNodeSPH*>((*iterproximity)->GetModelB()->GetContactable());
+        AccumulateForces(mnodeA, mnodeB);
         ++iterproximity;
     }
 }
@@ -16,11 +16,19 @@
 #define CHPROXIMITYCONTAINERSPH_H
 
 #include <list>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include "chrono/physics/ChNeighborGridSPH.h"
 #include "chrono/physics/ChProximityContainer.h"
 
 namespace chrono {
 
+class ChMatterSPH;
+class ChNodeSPH;
+
 /// Class for a proximity pair information in a SPH cluster
 /// of particles - that is, an 'edge' topological connectivity in
 /// in a meshless FEA approach, like the Smoothed Particle Hydrodynamics.
@@ -57,8 +65,10 @@ class ChApi ChProximitySPH {
 };
 
 /// Class for container of many proximity pairs for SPH (Smooth
-/// Particle Hydrodynamics and similar meshless force computations),
-/// as CPU typical linked list of ChProximitySPH objects.
+/// Particle Hydrodynamics and similar meshless force computations).
+/// By default, the pairs of SPH nodes are those reported by the collision system, stored as a
+/// linked list of ChProximitySPH objects. Optionally, they can be found with a uniform grid (cell
+/// list) over all the ChMatterSPH clusters in the system, and stored in contiguous arrays.
 
 class ChApi ChProximityContainerSPH : public ChProximityContainer {
 
@@ -67,6 +77,25 @@ class ChApi ChProximityContainerSPH : public ChProximityContainer {
     std::list<ChProximitySPH*>::iterator lastproximity;
     int n_added;
 
+    bool use_cell_list;      ///< if true, find SPH pairs with the cell list
+    int sph_family;          ///< collision family of the SPH nodes, when using the cell list
+    ChNeighborGridSPH grid;  ///< cell list for the SPH nodes
+
+    /// Original collision family group and mask of the SPH nodes moved to the cell list family
+    std::unordered_map<collision::ChCollisionModel*, std::pair<short int, short int>> sph_families;
+
+    // Data of the SPH nodes, in cell order (as indexed by the cell list pairs)
+    std::vector<ChNodeSPH*> sph_nodes;  ///< SPH nodes
+    std::vector<ChVector<>> sph_pos;    ///< positions
+    std::vector<ChVector<>> sph_vel;    ///< velocities
+    std::vector<double> sph_rad;        ///< kernel radii
+    std::vector<double> sph_mass;       ///< masses
+    std::vector<double> sph_vol;        ///< volumes
+    std::vector<double> sph_press;      ///< pressures
+    std::vector<double> sph_visc;       ///< viscosities
+    std::vector<double> sph_density;    ///< accumulated density
+    std::vector<ChVector<>> sph_force;  ///< accumulated force
+
   public:
     ChProximityContainerSPH();
     ChProximityContainerSPH(const ChProximityContainerSPH& other);
@@ -75,6 +104,29 @@ class ChApi ChProximityContainerSPH : public ChProximityContainer {
     /// "Virtual" copy constructor (covariant return type).
     virtual ChProximityContainerSPH* Clone() const override { return new ChProximityContainerSPH(*this); }
 
+    /// Enable/disable the cell list neighbor search (default: false).
+    /// If disabled, the SPH pairs are those reported by the collision system, which requires the ChMatterSPH
+    /// clusters to have collision enabled.
+    /// If enabled, the collision models of the SPH nodes are moved to a dedicated collision family (see
+    /// SetCellListFamily) that does not collide with itself, so that the collision system does not process the
+    /// node-node pairs found by the cell list. Contacts between the SPH nodes and other objects are still found by the
+    /// collision system. The original family group and mask of each node are restored when the cell list is disabled.
+    void SetUseCellList(bool val) { use_cell_list = val; }
+
+    /// Return true if the cell list neighbor search is used.
+    bool GetUseCellList() const { return use_cell_list; }
+
+    /// Set the collision family of the SPH nodes when the cell list is used (default: 14).
+    /// Other collision models should not use this family, as they would not collide with each other. Collision
+    /// models of other objects are tested against this family (rather than the original family of the nodes).
+    void SetCellListFamily(int family) { sph_family = family; }
+
+    /// Return the collision family of the SPH nodes when the cell list is used.
+    int GetCellListFamily() const { return sph_family; }
+
+    /// Set the number of OpenMP threads used by the cell list neighbor search.
+    void SetNumThreads(int num_threads) { grid.SetNumThreads(num_threads); }
+
     /// Tell the number of added contacts
     virtual int GetNproximities() const override { return n_added; }
 
@@ -86,9 +138,11 @@ class ChApi ChProximityContainerSPH : public ChProximityContainer {
     /// simply deleting all list of the previous pairs, this optimized implementation
     /// rewinds the link iterator to begin and tries to reuse previous pairs objects
     /// until possible, to avoid too much allocation/deallocation.
+    /// If the cell list is used, this also finds all the SPH pairs.
     virtual void BeginAddProximities() override;
 
     /// Add a proximity SPH data between two collision models, if possible.
+    /// Ignored if the cell list is used.
     virtual void AddProximity(collision::ChCollisionModel* modA,  ///< get contact model 1
                               collision::ChCollisionModel* modB   ///< get contact model 2
                               ) override;
@@ -111,6 +165,9 @@ class ChApi ChProximityContainerSPH : public ChProximityContainer {
     // Will be called by the ChMatterSPH item.
     void AccumulateStep2();
 
+    /// Access the cell list used for the SPH neighbor search.
+    const ChNeighborGridSPH& GetNeighborGrid() const { return grid; }
+
     //
     // SERIALIZATION
     //
@@ -120,6 +177,17 @@ class ChApi ChProximityContainerSPH : public ChProximityContainer {
 
     /// Method to allow de-serialization of transient data from archives.
     virtual void ArchiveIN(ChArchiveIn& marchive) override;
+
+  private:
+    /// Collect the SPH nodes of all ChMatterSPH items in the system.
+    void CollectNodes();
+
+    /// Move the collected SPH nodes to the cell list family (saving their original family group and mask), or
+    /// restore their original family group and mask.
+    void FilterNodeCollisions(bool filter);
+
+    /// Collect the SPH nodes of all ChMatterSPH items in the system, find their pairs and store them in cell order.
+    void UpdateCellList();
 };
 
 }  // end namespace chrono
@@ -23,6 +23,7 @@
 #include "chrono/solver/ChSolverPJacobi.h"
 #include "chrono/solver/ChSolverPMINRES.h"
 #include "chrono/solver/ChSolverPSOR.h"
+#include "chrono/solver/ChSolverPSORcolored.h"
 #include "chrono/solver/ChSolverPSSOR.h"
 #include "chrono/solver/ChIterativeSolverLS.h"
 #include "chrono/core/ChMatrix.h"
@@ -55,6 +56,7 @@ ChSystem::ChSystem()
       is_updated(false),
       applied_forces_current(false),
       maxiter(6),
+      nthreads_chrono(1),
       ncontacts(0),
       min_bounce_speed(0.15),
       max_penetration_recovery_speed(0.6),
@@ -105,6 +107,7 @@ ChSystem::ChSystem(const ChSystem& other) {
     is_updated = false;
     applied_forces_current = false;
     maxiter = other.maxiter;
+    nthreads_chrono = other.nthreads_chrono;
 
     min_bounce_speed = other.min_bounce_speed;
     max_penetration_recovery_speed = other.max_penetration_recovery_speed;
@@ -232,6 +235,9 @@ void ChSystem::SetSolverType(ChSolver::Type type) {
         case ChSolver::Type::APGD:
             solver = chrono_types::make_shared<ChSolverAPGD>();
             break;
+        case ChSolver::Type::PSOR_COLORED:
+            solver = chrono_types::make_shared<ChSolverPSORcolored>();
+            break;
         case ChSolver::Type::GMRES:
             solver = chrono_types::make_shared<ChSolverGMRES>();
             break;
@@ -943,6 +949,7 @@ bool ChSystem::StateSolveCorrection(ChStateDelta& Dv,             // result: com
     // If the solver's Setup() must be called or if the solver's Solve() requires it,
     // fill the sparse system structures with information in G and Cq.
     if (force_setup || GetSolver()->SolveRequiresMatrix()) {
+        CH_PROFILE("LoadJacobians");
         timer_jacobian.start();
 
         // Cq  matrix
@@ -978,6 +985,7 @@ bool ChSystem::StateSolveCorrection(ChStateDelta& Dv,             // result: com
     // If indicated, first perform a solver setup.
     // Return 'false' if the setup phase fails.
     if (force_setup) {
+        CH_PROFILE("SolverSetup");
         timer_setup.start();
         bool success = GetSolver()->Setup(*descriptor);
         timer_setup.stop();
@@ -988,9 +996,12 @@ bool ChSystem::StateSolveCorrection(ChStateDelta& Dv,             // result: com
 
     // Solve the problem
     // The solution is scattered in the provided system descriptor
-    timer_solver.start();
-    GetSolver()->Solve(*descriptor);
-    timer_solver.stop();
+    {
+        CH_PROFILE("SolverSolve");
+        timer_solver.start();
+        GetSolver()->Solve(*descriptor);
+        timer_solver.stop();
+    }
 
     // Dv and L vectors  <-- sparse solver structures
     IntFromDescriptor(0, Dv, 0, L);
@@ -1270,6 +1281,11 @@ void ChSystem::DumpSystemMatrices(bool save_M, bool save_K, bool save_R, bool sa
 // -----------------------------------------------------------------------------
 
 int ChSystem::DoStepDynamics(double step_size) {
+#ifndef CH_NO_PROFILE
+    // By default, profile the first thread that advances a system
+    utils::ChProfileManager::ClaimProfilingThread();
+#endif
+
     if (!is_initialized)
         SetupInitial();
 
@@ -1316,7 +1332,10 @@ bool ChSystem::Integrate_Y() {
     ManageSleepingBodies();
 
     // Prepare lists of variables and constraints.
-    DescriptorPrepareInject(*descriptor);
+    {
+        CH_PROFILE("DescriptorPrepareInject");
+        DescriptorPrepareInject(*descriptor);
+    }
 
     // No need to update counts and offsets, as already done by the above call (in ChSystemDescriptor::EndInsertion)
     ////descriptor->UpdateCountsAndOffsets();
@@ -1345,6 +1364,12 @@ bool ChSystem::Integrate_Y() {
     // Time elapsed for step
     timer_step.stop();
 
+    // Per-step counters for the profiler trace
+    CH_PROFILE_COUNTER("contacts", ncontacts);
+    CH_PROFILE_COUNTER("constraints", GetNconstr());
+    if (auto iterative_solver = std::dynamic_pointer_cast<ChIterativeSolver>(GetSolver()))
+        CH_PROFILE_COUNTER("solver_iterations", iterative_solver->GetIterations());
+
     // Tentatively mark system as unchanged (i.e., no updated necessary)
     is_updated = true;
 
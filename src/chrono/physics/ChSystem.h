@@ -15,6 +15,7 @@
 #ifndef CHSYSTEM_H
 #define CHSYSTEM_H
 
+#include <algorithm>
 #include <cfloat>
 #include <memory>
 #include <cstdlib>
@@ -140,6 +141,17 @@ class ChApi ChSystem : public ChIntegrableIIorder {
     /// Gets iteration limit for assembly constraints.
     int GetMaxiter() const { return maxiter; }
 
+    /// Set the number of OpenMP threads used for the per-item loops of the underlying assembly (default: 1).
+    /// With more than one thread, state gather, residual loading and the solver-descriptor fan-out loops process
+    /// bodies and links in parallel. Only loops in which each item writes exclusively to its own data are
+    /// parallelized, so results are identical to a serial run. Item updates (which evaluate user ChFunctions and update
+    /// assets), including those performed when scattering the state, are always sequential. With a single thread no
+    /// OpenMP parallel region is created. Ignored if Chrono was built without OpenMP support.
+    void SetNumThreads(int num_threads) { nthreads_chrono = std::max(1, num_threads); }
+
+    /// Get the number of OpenMP threads used for the per-item loops of the underlying assembly.
+    int GetNumThreads() const { return nthreads_chrono; }
+
     /// Change the default composition laws for contact surface materials
     /// (coefficient of friction, cohesion, compliance, etc.)
     virtual void SetMaterialCompositionStrategy(std::unique_ptr<ChMaterialCompositionStrategy>&& strategy);
@@ -869,6 +881,8 @@ class ChApi ChSystem : public ChIntegrableIIorder {
 
     int maxiter;  ///< max iterations for nonlinear convergence in DoAssembly()
 
+    int nthreads_chrono;  ///< number of OpenMP threads for the assembly per-item loops
+
     bool use_sleeping;  ///< if true, put to sleep objects that come to rest
 
     std::shared_ptr<ChSystemDescriptor> descriptor;  ///< system descriptor
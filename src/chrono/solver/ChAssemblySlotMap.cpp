@@ -0,0 +1,318 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+
+#include <algorithm>
+
+#include "chrono/solver/ChAssemblySlotMap.h"
+#include "chrono/parallel/ChOpenMP.h"
+
+namespace chrono {
+
+// -----------------------------------------------------------------------------
+
+// Proxy matrix used when recording the slot map.
+// Each element is located (by binary search) in the compressed row of the target matrix, where its value is set, and
+// the index of its slot in the value array is appended to the list of slots.
+class ChAssemblySlotMap::Recorder : public ChSparseMatrix {
+  public:
+    Recorder(ChSparseMatrix& Z, std::vector<int>& slots) : m_Z(Z), m_slots(slots), m_ok(true) {}
+
+    virtual void SetElement(int row, int col, double el, bool overwrite = true) override {
+        if (row < 0 || row >= m_Z.rows()) {
+            m_ok = false;
+            return;
+        }
+        const int* inner = m_Z.innerIndexPtr();
+        const int* begin = inner + m_Z.outerIndexPtr()[row];
+        const int* end = inner + m_Z.outerIndexPtr()[row + 1];
+        const int* it = std::lower_bound(begin, end, col);
+        if (it == end || *it != col) {
+            m_ok = false;
+            return;
+        }
+        int slot = (int)(it - inner);
+        m_slots.push_back(slot);
+        double& val = m_Z.valuePtr()[slot];
+        val = overwrite ? el : val + el;
+    }
+
+    bool Succeeded() const { return m_ok; }
+
+  private:
+    ChSparseMatrix& m_Z;
+    std::vector<int>& m_slots;
+    bool m_ok;
+};
+
+// Proxy matrix used when assembling with the slot map.
+// Consumes the slots in the range set with Reset, checking that each slot corresponds to the element being written.
+class ChAssemblySlotMap::Writer : public ChSparseMatrix {
+  public:
+    Writer(ChSparseMatrix& Z, const std::vector<int>& slots)
+        : m_rows((int)Z.rows()),
+          m_outer(Z.outerIndexPtr()),
+          m_inner(Z.innerIndexPtr()),
+          m_values(Z.valuePtr()),
+          m_slots(slots.data()),
+          m_next(0),
+          m_end(0),
+          m_ok(true) {}
+
+    void Reset(int start, int end) {
+        m_next = start;
+        m_end = end;
+        m_ok = true;
+    }
+
+    virtual void SetElement(int row, int col, double el, bool overwrite = true) override {
+        if (m_next >= m_end || row < 0 || row >= m_rows) {
+            m_ok = false;
+            return;
+        }
+        int slot = m_slots[m_next++];
+        if (slot < m_outer[row] || slot >= m_outer[row + 1] || m_inner[slot] != col) {
+            m_ok = false;
+            return;
+        }
+        double* val = m_values + slot;
+        *val = overwrite ? el : *val + el;
+    }
+
+    /// Return true if all elements were found and all slots in the current range were consumed.
+    bool Succeeded() const { return m_ok && m_next == m_end; }
+
+  private:
+    int m_rows;
+    const int* m_outer;
+    const int* m_inner;
+    double* m_values;
+    const int* m_slots;
+    int m_next;
+    int m_end;
+    bool m_ok;
+};
+
+// -----------------------------------------------------------------------------
+
+ChAssemblySlotMap::ChAssemblySlotMap()
+    : m_n_q(0), m_nnz(0), m_nthreads(CHOMPfunctions::GetMaxThreads()), m_valid(false) {}
+
+void ChAssemblySlotMap::SetNumThreads(int num_threads) {
+    m_nthreads = std::max(1, num_threads);
+}
+
+void ChAssemblySlotMap::Reset() {
+    m_valid = false;
+    m_slots.clear();
+    m_variables.clear();
+    m_kblocks.clear();
+    m_constraints.clear();
+    m_var_offset.clear();
+    m_var_start.clear();
+    m_kb_start.clear();
+    m_kb_colors.clear();
+    m_con_start.clear();
+}
+
+bool ChAssemblySlotMap::Record(ChSystemDescriptor& sysd, ChSparseMatrix& Z) {
+    Reset();
+
+    if (!Z.isCompressed())
+        return false;
+
+    std::fill(Z.valuePtr(), Z.valuePtr() + Z.nonZeros(), 0.0);
+
+    Recorder recorder(Z, m_slots);
+    m_slots.reserve(Z.nonZeros());
+
+    // Traverse the blocks in the same order as ChSystemDescriptor::ConvertToMatrixForm.
+
+    // Masses and inertias in upper-left block
+    int s_q = 0;
+    for (auto var : sysd.GetVariablesList()) {
+        if (var->IsActive()) {
+            m_variables.push_back(var);
+            m_var_offset.push_back(s_q);
+            m_var_start.push_back((int)m_slots.size());
+            var->Build_M(recorder, s_q, s_q, sysd.GetMassFactor());
+            s_q += var->Get_ndof();
+        }
+    }
+    m_var_start.push_back((int)m_slots.size());
+    m_n_q = s_q;
+
+    // Stiffness matrices, added to upper-left block
+    for (auto kblock : sysd.GetKblocksList()) {
+        m_kblocks.push_back(kblock);
+        m_kb_start.push_back((int)m_slots.size());
+        kblock->Build_K(recorder, true);
+    }
+    m_kb_start.push_back((int)m_slots.size());
+    ColorKblocks(Z);
+
+    // Constraint Jacobian (lower-left block), its transpose (upper-right block), and cfm (lower-right block)
+    int s_c = 0;
+    for (auto con : sysd.GetConstraintsList()) {
+        if (con->IsActive()) {
+            m_constraints.push_back(con);
+            m_con_start.push_back((int)m_slots.size());
+            con->Build_Cq(recorder, m_n_q + s_c);
+            con->Build_CqT(recorder, m_n_q + s_c);
+            recorder.SetElement(m_n_q + s_c, m_n_q + s_c, con->Get_cfm_i());
+            s_c++;
+        }
+    }
+    m_con_start.push_back((int)m_slots.size());
+
+    if (!recorder.Succeeded() || Z.rows() != m_n_q + s_c) {
+        Reset();
+        return false;
+    }
+
+    m_nnz = (int)Z.nonZeros();
+    m_valid = true;
+    return true;
+}
+
+void ChAssemblySlotMap::ColorKblocks(const ChSparseMatrix& Z) {
+    // Colors already used by the stiffness blocks writing to each matrix row
+    std::vector<std::vector<int>> row_colors(Z.rows());
+    std::vector<int> rows;
+    std::vector<bool> used;
+
+    const int* outer = Z.outerIndexPtr();
+    for (int ib = 0; ib < (int)m_kblocks.size(); ib++) {
+        // Collect the rows written by this block
+        rows.clear();
+        for (int is = m_kb_start[ib]; is < m_kb_start[ib + 1]; is++)
+            rows.push_back((int)(std::upper_bound(outer, outer + Z.rows() + 1, m_slots[is]) - outer) - 1);
+        std::sort(rows.begin(), rows.end());
+        rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+
+        // Flag the colors of all blocks writing to one of these rows
+        used.assign(m_kb_colors.size(), false);
+        for (auto row : rows) {
+            for (auto col : row_colors[row])
+                used[col] = true;
+        }
+
+        // Pick the first available color
+        int color = 0;
+        while (color < (int)used.size() && used[color])
+            color++;
+        if (color == (int)m_kb_colors.size())
+            m_kb_colors.push_back(std::vector<int>());
+        m_kb_colors[color].push_back(ib);
+
+        for (auto row : rows)
+            row_colors[row].push_back(color);
+    }
+}
+
+bool ChAssemblySlotMap::CheckBlocks(ChSystemDescriptor& sysd) const {
+    size_t iv = 0;
+    int s_q = 0;
+    for (auto var : sysd.GetVariablesList()) {
+        if (var->IsActive()) {
+            if (iv >= m_variables.size() || m_variables[iv] != var || m_var_offset[iv] != s_q)
+                return false;
+            s_q += var->Get_ndof();
+            iv++;
+        }
+    }
+    if (iv != m_variables.size() || s_q != m_n_q)
+        return false;
+
+    if (sysd.GetKblocksList() != m_kblocks)
+        return false;
+
+    size_t ic = 0;
+    for (auto con : sysd.GetConstraintsList()) {
+        if (con->IsActive()) {
+            if (ic >= m_constraints.size() || m_constraints[ic] != con)
+                return false;
+            ic++;
+        }
+    }
+    return ic == m_constraints.size();
+}
+
+bool ChAssemblySlotMap::Assemble(ChSystemDescriptor& sysd, ChSparseMatrix& Z) {
+    if (!m_valid)
+        return false;
+
+    if (!Z.isCompressed() || Z.nonZeros() != m_nnz || Z.rows() != m_n_q + (int)m_constraints.size() ||
+        !CheckBlocks(sysd)) {
+        Reset();
+        return false;
+    }
+
+    std::fill(Z.valuePtr(), Z.valuePtr() + Z.nonZeros(), 0.0);
+
+    int num_variables = (int)m_variables.size();
+    int num_colors = (int)m_kb_colors.size();
+    int num_constraints = (int)m_constraints.size();
+    double c_a = sysd.GetMassFactor();
+    int num_failed = 0;
+
+#pragma omp parallel num_threads(m_nthreads) reduction(+ : num_failed)
+    {
+        Writer writer(Z, m_slots);
+
+        // Mass blocks, each one writing its own diagonal block
+#pragma omp for
+        for (int i = 0; i < num_variables; i++) {
+            writer.Reset(m_var_start[i], m_var_start[i + 1]);
+            m_variables[i]->Build_M(writer, m_var_offset[i], m_var_offset[i], c_a);
+            if (!writer.Succeeded())
+                num_failed++;
+        }
+
+        // Stiffness blocks, one color at a time (blocks of the same color do not write to the same rows).
+        // The order in which the blocks add to each element does not depend on the number of threads.
+        for (int color = 0; color < num_colors; color++) {
+            const auto& kblocks = m_kb_colors[color];
+            int num_kblocks = (int)kblocks.size();
+#pragma omp for
+            for (int k = 0; k < num_kblocks; k++) {
+                int i = kblocks[k];
+                writer.Reset(m_kb_start[i], m_kb_start[i + 1]);
+                m_kblocks[i]->Build_K(writer, true);
+                if (!writer.Succeeded())
+                    num_failed++;
+            }
+        }
+
+        // Constraints, each one writing its own row and column
+#pragma omp for
+        for (int i = 0; i < num_constraints; i++) {
+            int row = m_n_q + i;
+            writer.Reset(m_con_start[i], m_con_start[i + 1]);
+            m_constraints[i]->Build_Cq(writer, row);
+            m_constraints[i]->Build_CqT(writer, row);
+            writer.SetElement(row, row, m_constraints[i]->Get_cfm_i());
+            if (!writer.Succeeded())
+                num_failed++;
+        }
+    }
+
+    if (num_failed > 0) {
+        Reset();
+        return false;
+    }
+
+    return true;
+}
+
+}  // end namespace chrono
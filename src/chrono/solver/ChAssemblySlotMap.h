@@ -0,0 +1,101 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+
+#ifndef CH_ASSEMBLY_SLOT_MAP_H
+#define CH_ASSEMBLY_SLOT_MAP_H
+
+#include <vector>
+
+#include "chrono/core/ChApiCE.h"
+#include "chrono/core/ChMatrix.h"
+#include "chrono/solver/ChSystemDescriptor.h"
+
+namespace chrono {
+
+/// @addtogroup chrono_solver
+/// @{
+
+/// Cached map of the CSR value slots of the system matrix, for fast repeated assembly.\n
+/// When recording the map (see #Record), the system matrix is assembled in the same order as in
+/// ChSystemDescriptor::ConvertToMatrixForm and the index in the CSR value array of each element written by the
+/// ChVariables (mass), ChKblock (stiffness) and ChConstraint (Jacobian and compliance) blocks is stored.
+/// Subsequent matrices with the same structure can then be assembled (see #Assemble) by direct indexed writes in the
+/// value array, without searching for the element positions, and in parallel over the blocks. Stiffness blocks are
+/// grouped in colors (sets of blocks writing to distinct rows) and added one color at a time, so that the assembled
+/// matrix does not depend on the number of threads.\n
+/// The structure of the problem is checked during assembly: if the active blocks, or the elements they write, differ
+/// from those recorded, the map is invalidated and must be recorded again.
+class ChApi ChAssemblySlotMap {
+  public:
+    ChAssemblySlotMap();
+
+    /// Set the number of OpenMP threads used in #Assemble (default: maximum number of OpenMP threads).
+    void SetNumThreads(int num_threads);
+
+    /// Return the number of OpenMP threads used in #Assemble.
+    int GetNumThreads() const { return m_nthreads; }
+
+    /// Return true if the map was recorded and was not invalidated since.
+    bool IsValid() const { return m_valid; }
+
+    /// Invalidate the map.
+    void Reset();
+
+    /// Assemble the system matrix in Z and record the slot map.
+    /// Z must be compressed and its sparsity pattern must include all elements of the system matrix (for example, as
+    /// obtained with ChSystemDescriptor::ConvertToMatrixForm followed by a call to makeCompressed).
+    /// Return false (and leave the map invalid) if some element is not in the sparsity pattern of Z.
+    bool Record(ChSystemDescriptor& sysd, ChSparseMatrix& Z);
+
+    /// Assemble the system matrix in Z using the recorded slot map.
+    /// Z must have the same compressed sparsity pattern as when the map was recorded.
+    /// Return false (and invalidate the map) if the structure of the problem changed; in that case, Z is not valid.
+    bool Assemble(ChSystemDescriptor& sysd, ChSparseMatrix& Z);
+
+    /// Return the number of recorded slots.
+    size_t GetNumSlots() const { return m_slots.size(); }
+
+  private:
+    class Recorder;
+    class Writer;
+
+    /// Group the stiffness blocks in colors (sets of blocks writing to distinct rows of Z), using a greedy algorithm.
+    void ColorKblocks(const ChSparseMatrix& Z);
+
+    /// Check that the active blocks in the system descriptor are the ones recorded.
+    bool CheckBlocks(ChSystemDescriptor& sysd) const;
+
+    std::vector<int> m_slots;  ///< value index of each element write, in assembly order
+
+    std::vector<ChVariables*> m_variables;     ///< active variables, when recorded
+    std::vector<ChKblock*> m_kblocks;          ///< stiffness blocks, when recorded
+    std::vector<ChConstraint*> m_constraints;  ///< active constraints, when recorded
+
+    std::vector<int> m_var_offset;              ///< row and column of the mass block of each variables object
+    std::vector<int> m_var_start;               ///< first slot of each mass block (plus end marker)
+    std::vector<int> m_kb_start;                ///< first slot of each stiffness block (plus end marker)
+    std::vector<std::vector<int>> m_kb_colors;  ///< stiffness block indices, grouped in colors
+    std::vector<int> m_con_start;               ///< first slot of each constraint (plus end marker)
+
+    int m_n_q;       ///< number of active variables, when recorded
+    int m_nnz;       ///< number of nonzeros in the matrix, when recorded
+    int m_nthreads;  ///< number of OpenMP threads
+    bool m_valid;    ///< is the map valid?
+};
+
+/// @} chrono_solver
+
+}  // end namespace chrono
+
+#endif
@@ -21,6 +21,8 @@
 
 namespace chrono {
 
+class ChVariables;
+
 /// Modes for constraint
 enum eChConstraintMode {
     CONSTRAINT_FREE = 0,        ///< the constraint does not enforce anything
@@ -296,6 +298,12 @@ class ChApi ChConstraint {
     /// Same as Build_Cq, but puts the _transposed_ jacobian row as a column.
     virtual void Build_CqT(ChSparseMatrix& storage, int inscol) = 0;
 
+    /// Append to 'vars' the ChVariables objects referenced by this constraint.
+    /// Used by solvers that need the constraint connectivity (e.g. to color the constraint graph).
+    /// The default implementation appends nothing, meaning that the connectivity is unknown; solvers must then assume
+    /// that the constraint may act on any variable.
+    virtual void CollectVariables(std::vector<ChVariables*>& vars) {}
+
     /// Set offset in global q vector (set automatically by ChSystemDescriptor)
     void SetOffset(int moff) { offset = moff; }
 
@@ -13,6 +13,7 @@
 // =============================================================================
 
 #include "chrono/solver/ChDirectSolverLS.h"
+#include "chrono/core/ChException.h"
 #include "chrono/core/ChSparsityPatternLearner.h"
 
 #define SPM_DEF_SPARSITY 0.9  ///< default predicted sparsity (in [0,1])
@@ -23,6 +24,7 @@ ChDirectSolverLS::ChDirectSolverLS()
     : m_lock(false),
       m_use_learner(true),
       m_force_update(true),
+      m_use_slot_map(false),
       m_null_pivot_detection(false),
       m_use_rhs_sparsity(false),
       m_use_perm(false),
@@ -30,7 +32,11 @@ ChDirectSolverLS::ChDirectSolverLS()
       m_dim(0),
       m_sparsity(-1),
       m_solve_call(0),
-      m_setup_call(0) {}
+      m_setup_call(0),
+      m_analysis_call(0),
+      m_slot_map_call(0),
+      m_new_pattern(true),
+      m_nnz(0) {}
 
 void ChDirectSolverLS::ResetTimers() {
     m_timer_setup_assembly.reset();
@@ -44,6 +50,7 @@ bool ChDirectSolverLS::Setup(ChSystemDescriptor& sysd) {
 
     // Calculate problem size.
     // Note that ChSystemDescriptor::UpdateCountsAndOffsets was already called at the beginning of the step.
+    int dim_prev = m_dim;
     m_dim = sysd.CountActiveVariables() + sysd.CountActiveConstraints();
 
     // If use of the sparsity pattern learner is enabled, call it if:
@@ -57,6 +64,15 @@ bool ChDirectSolverLS::Setup(ChSystemDescriptor& sysd) {
     // (b) the sparsity pattern is not locked and so has to be re-evaluated at each call
     bool call_reserve = !m_use_learner && (m_setup_call == 0 || !m_lock);
 
+    // If enabled, assemble the matrix using the slot map if the sparsity pattern is locked and not re-evaluated.
+    // If the problem structure changed (the slot map assembly fails), re-evaluate the sparsity pattern.
+    bool use_slot_map = m_use_slot_map && m_lock && !call_learner && !call_reserve && m_slot_map.IsValid();
+    if (use_slot_map && !m_slot_map.Assemble(sysd, m_mat)) {
+        use_slot_map = false;
+        call_learner = m_use_learner;
+        call_reserve = !m_use_learner;
+    }
+
     if (verbose) {
         GetLog() << "Solver setup\n";
         GetLog() << "  call number:    " << m_setup_call << "\n";
@@ -64,6 +80,7 @@ bool ChDirectSolverLS::Setup(ChSystemDescriptor& sysd) {
         GetLog() << "  pattern locked? " << m_lock << "\n";
         GetLog() << "  CALL learner:   " << call_learner << "\n";
         GetLog() << "  CALL reserve:   " << call_reserve << "\n";
+        GetLog() << "  slot map?       " << use_slot_map << "\n";
     }
 
     if (call_learner) {
@@ -77,11 +94,28 @@ bool ChDirectSolverLS::Setup(ChSystemDescriptor& sysd) {
         m_mat.reserve(Eigen::VectorXi::Constant(m_dim, static_cast<int>(m_dim * density)));
     }
 
-    // Let the system descriptor load the current matrix
-    sysd.ConvertToMatrixForm(&m_mat, nullptr);
+    if (use_slot_map) {
+        m_slot_map_call++;
+    } else {
+        // Let the system descriptor load the current matrix
+        sysd.ConvertToMatrixForm(&m_mat, nullptr);
+
+        // Allow the matrix to be compressed
+        m_mat.makeCompressed();
 
-    // Allow the matrix to be compressed
-    m_mat.makeCompressed();
+        // Record the slot map for subsequent calls (this reassembles the matrix)
+        if (m_use_slot_map && m_lock && !m_slot_map.Record(sysd, m_mat))
+            sysd.ConvertToMatrixForm(&m_mat, nullptr);
+    }
+
+    // A new symbolic analysis is needed unless the sparsity pattern is locked and was not re-evaluated, and neither
+    // the problem size nor the number of nonzeros changed (no new nonzeros were inserted during assembly).
+    int nnz = (int)m_mat.nonZeros();
+    m_new_pattern = !m_lock || call_learner || call_reserve || m_dim != dim_prev || nnz != m_nnz;
+    if (m_new_pattern) {
+        m_nnz = nnz;
+        m_analysis_call++;
+    }
 
     m_timer_setup_assembly.stop();
 
@@ -94,7 +128,8 @@ bool ChDirectSolverLS::Setup(ChSystemDescriptor& sysd) {
         GetLog() << " Solver setup [" << m_setup_call << "] n = " << m_dim << "  nnz = " << (int)m_mat.nonZeros()
                  << "\n";
         GetLog() << "  assembly matrix:   " << m_timer_setup_assembly.GetTimeSecondsIntermediate() << "s\n"
-                 << "  analyze+factorize: " << m_timer_setup_solvercall.GetTimeSecondsIntermediate() << "s\n";
+                 << (m_new_pattern ? "  analyze+factorize: " : "  factorize:         ")
+                 << m_timer_setup_solvercall.GetTimeSecondsIntermediate() << "s\n";
     }
 
     m_setup_call++;
@@ -172,7 +207,9 @@ void ChDirectSolverLS::ArchiveIN(ChArchiveIn& marchive) {
 // ---------------------------------------------------------------------------
 
 bool ChSolverSparseLU::FactorizeMatrix() {
-    m_engine.compute(m_mat);
+    if (m_new_pattern)
+        m_engine.analyzePattern(m_mat);
+    m_engine.factorize(m_mat);
     return (m_engine.info() == Eigen::Success);
 }
 
@@ -201,7 +238,9 @@ void ChSolverSparseLU::PrintErrorMessage() {
 // ---------------------------------------------------------------------------
 
 bool ChSolverSparseQR::FactorizeMatrix() {
-    m_engine.compute(m_mat);
+    if (m_new_pattern)
+        m_engine.analyzePattern(m_mat);
+    m_engine.factorize(m_mat);
     return (m_engine.info() == Eigen::Success);
 }
 
@@ -227,4 +266,137 @@ void ChSolverSparseQR::PrintErrorMessage() {
     }
 }
 
+// ---------------------------------------------------------------------------
+
+ChSolverSparseLDLT::ChSolverSparseLDLT() : m_num_constraints(0), m_refinement_steps(2), m_use_llt(false) {
+    m_symmetry = MatrixSymmetryType::SYMMETRIC_INDEF;
+}
+
+void ChSolverSparseLDLT::SetMatrixSymmetryType(MatrixSymmetryType symmetry) {
+    // Only the upper triangle of the matrix is factorized, so non-symmetric matrices cannot be handled
+    if (symmetry != MatrixSymmetryType::SYMMETRIC_POSDEF && symmetry != MatrixSymmetryType::SYMMETRIC_INDEF)
+        throw ChException("ChSolverSparseLDLT: only SYMMETRIC_POSDEF and SYMMETRIC_INDEF matrices are supported.");
+    m_symmetry = symmetry;
+}
+
+bool ChSolverSparseLDLT::Setup(ChSystemDescriptor& sysd) {
+    m_num_constraints = sysd.CountActiveConstraints();
+    return ChDirectSolverLS::Setup(sysd);
+}
+
+bool ChSolverSparseLDLT::FactorizeMatrix() {
+    bool use_llt = (m_symmetry == MatrixSymmetryType::SYMMETRIC_POSDEF);
+    bool analyze = m_new_pattern || use_llt != m_use_llt || m_perm.size() != m_dim;
+    m_use_llt = use_llt;
+
+    // Ordering (only when the sparsity pattern changed)
+    if (analyze)
+        ComputeOrdering();
+
+    // Permute the problem matrix (only its upper triangle is used)
+    m_pmat.resize(m_dim, m_dim);
+    m_pmat.selfadjointView<Eigen::Upper>() = m_mat.selfadjointView<Eigen::Upper>().twistedBy(m_perm);
+
+    // Symbolic factorization (only when the sparsity pattern changed) and numeric factorization
+    if (m_use_llt) {
+        if (analyze)
+            m_llt_engine.analyzePattern(m_pmat);
+        m_llt_engine.factorize(m_pmat);
+    } else {
+        if (analyze)
+            m_ldlt_engine.analyzePattern(m_pmat);
+        m_ldlt_engine.factorize(m_pmat);
+    }
+
+    return (GetInfo() == Eigen::Success);
+}
+
+bool ChSolverSparseLDLT::SolveSystem() {
+    m_sol = SolvePermuted(m_rhs);
+
+    // Iterative refinement, to recover the accuracy lost by factorizing an indefinite matrix without pivoting.
+    // Not needed with the Cholesky factorization of a positive definite matrix, which is stable without pivoting.
+    int refinement_steps = m_use_llt ? 0 : m_refinement_steps;
+    for (int i = 0; i < refinement_steps; i++) {
+        ChVectorDynamic<> res = m_rhs - m_mat * m_sol;
+        m_sol += SolvePermuted(res);
+    }
+
+    return (GetInfo() == Eigen::Success);
+}
+
+ChVectorDynamic<> ChSolverSparseLDLT::SolvePermuted(const ChVectorDynamic<>& rhs) const {
+    ChVectorDynamic<> prhs = m_perm * rhs;
+    ChVectorDynamic<> psol;
+    if (m_use_llt)
+        psol = m_llt_engine.solve(prhs);
+    else
+        psol = m_ldlt_engine.solve(prhs);
+    return m_perm.transpose() * psol;
+}
+
+void ChSolverSparseLDLT::ComputeOrdering() {
+    int n_c = std::min(m_num_constraints, m_dim);
+    int n_q = m_dim - n_c;
+
+    // Approximate minimum degree ordering of the variables.
+    // The resulting permutation lists the variables in elimination order.
+    Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, int> order;
+    if (n_q > 0) {
+        ColMajorMatrix H = m_mat.topLeftCorner(n_q, n_q);
+        Eigen::AMDOrdering<int> amd;
+        amd(H, order);
+    }
+
+    std::vector<int> var_pos(n_q);
+    for (int k = 0; k < n_q; k++)
+        var_pos[order.indices()(k)] = k;
+
+    // Each constraint (one of the last n_c rows of the problem matrix) is eliminated right after the last of the
+    // variables it acts on. Constraints which act on no variables are eliminated first.
+    std::vector<std::vector<int>> constraints_after(n_q + 1);
+    for (int i = n_q; i < m_dim; i++) {
+        int last = -1;
+        for (ChSparseMatrix::InnerIterator it(m_mat, i); it; ++it) {
+            if (it.col() < n_q)
+                last = std::max(last, var_pos[it.col()]);
+        }
+        constraints_after[last + 1].push_back(i);
+    }
+
+    // Permutation from the original to the new position of each unknown
+    m_perm.resize(m_dim);
+    int k = 0;
+    for (auto i : constraints_after[0])
+        m_perm.indices()(i) = k++;
+    for (int j = 0; j < n_q; j++) {
+        m_perm.indices()(order.indices()(j)) = k++;
+        for (auto i : constraints_after[j + 1])
+            m_perm.indices()(i) = k++;
+    }
+}
+
+Eigen::ComputationInfo ChSolverSparseLDLT::GetInfo() const {
+    return m_use_llt ? m_llt_engine.info() : m_ldlt_engine.info();
+}
+
+void ChSolverSparseLDLT::PrintErrorMessage() {
+    switch (GetInfo()) {
+        case Eigen::Success:
+            GetLog() << "computation was successful\n";
+            break;
+        case Eigen::NumericalIssue:
+            if (m_use_llt)
+                GetLog() << "LLT factorization reported a problem, matrix not positive definite\n";
+            else
+                GetLog() << "LDLT factorization reported a problem, zero pivot (redundant constraints?)\n";
+            break;
+        case Eigen::InvalidInput:
+            GetLog() << "inputs are invalid, or the algorithm has been improperly called\n";
+            break;
+        default:
+            break;
+    }
+}
+
 }  // end namespace chrono
@@ -18,8 +18,10 @@
 #include "chrono/core/ChMatrix.h"
 #include "chrono/core/ChTimer.h"
 #include "chrono/solver/ChSolverLS.h"
+#include "chrono/solver/ChAssemblySlotMap.h"
 
 #include <Eigen/SparseLU>
+#include <Eigen/SparseCholesky>
 
 namespace chrono {
 
@@ -56,6 +58,19 @@ to a fully dense matrix). This value is used if the sparsity pattern learner is
 space for matrix indices and nonzeros.
 See #SetSparsityEstimate();
 
+With a locked sparsity pattern, the solvers which separate the symbolic analysis (ordering and symbolic factorization)
+from the numeric factorization perform the former only when the sparsity pattern changes, i.e., at the first call to
+Setup, after a call to #ForceSparsityPatternUpdate, or if the number of nonzeros changed. Subsequent calls to Setup
+only perform a numeric refactorization.\n
+See #GetNumAnalysisCalls();
+
+With a locked sparsity pattern, the matrix can also be assembled using a cached map of the positions of its elements in
+the CSR value array (see ChAssemblySlotMap). The map is recorded at the first call to Setup (or after a sparsity pattern
+update); subsequent matrices are assembled by direct indexed writes, in parallel over the variable, stiffness and
+constraint blocks. If the structure of the problem changes, the solver falls back on the default assembly and a new
+sparsity pattern.\n
+See #UseSlotMapAssembly();
+
 <br>
 
 <div class="ce-warning">
@@ -92,6 +107,13 @@ class ChApi ChDirectSolverLS : public ChSolverLS {
     /// or structure occurred. This function has no effect if the sparsity pattern learner is disabled.
     void ForceSparsityPatternUpdate() { m_force_update = true; }
 
+    /// Enable/disable matrix assembly using a cached map of the CSR value slots (default: false).\n
+    /// Only used if the sparsity pattern is locked. See ChAssemblySlotMap.
+    void UseSlotMapAssembly(bool val) { m_use_slot_map = val; }
+
+    /// Set the number of OpenMP threads used for the slot map assembly (default: maximum number of OpenMP threads).
+    void SetNumAssemblyThreads(int num_threads) { m_slot_map.SetNumThreads(num_threads); }
+
     /// Set estimate for matrix sparsity, a value in [0,1], with 0 indicating a fully dense matrix (default: 0.9).\n
     /// Only used if the sparsity pattern learner is disabled.
     void SetSparsityEstimate(double sparsity) { m_sparsity = sparsity; }
@@ -125,8 +147,12 @@ class ChApi ChDirectSolverLS : public ChSolverLS {
 
     /// Return the number of calls to the solver's Setup function.
     int GetNumSetupCalls() const { return m_setup_call; }
-    /// Return the number of calls to the solver's Setup function.
+    /// Return the number of calls to the solver's Solve function.
     int GetNumSolveCalls() const { return m_solve_call; }
+    /// Return the number of calls to the solver's Setup function which required a new symbolic analysis.
+    int GetNumAnalysisCalls() const { return m_analysis_call; }
+    /// Return the number of calls to the solver's Setup function which assembled the matrix using the slot map.
+    int GetNumSlotMapAssemblies() const { return m_slot_map_call; }
 
     /// Get a handle to the underlying matrix.
     ChSparseMatrix& GetMatrix() { return m_mat; }
@@ -171,13 +197,21 @@ class ChApi ChDirectSolverLS : public ChSolverLS {
     ChVectorDynamic<double> m_rhs;  ///< right-hand side vector
     ChVectorDynamic<double> m_sol;  ///< solution vector
 
-    int m_solve_call;  ///< counter for calls to Solve
-    int m_setup_call;  ///< counter for calls to Setup
+    int m_solve_call;     ///< counter for calls to Solve
+    int m_setup_call;     ///< counter for calls to Setup
+    int m_analysis_call;  ///< counter for calls to Setup with a new sparsity pattern
+    int m_slot_map_call;  ///< counter for calls to Setup with slot map assembly
+
+    bool m_new_pattern;  ///< did the sparsity pattern change at the current call to Setup?
+    int m_nnz;           ///< number of nonzeros in the problem matrix at the last sparsity pattern change
 
     bool m_lock;          ///< is the matrix sparsity pattern locked?
     bool m_use_learner;   ///< use the sparsity pattern learner?
     bool m_force_update;  ///< force a call to the sparsity pattern learner?
 
+    bool m_use_slot_map;           ///< assemble the matrix using the slot map?
+    ChAssemblySlotMap m_slot_map;  ///< cached CSR value slots of the matrix elements
+
     bool m_use_perm;              ///< use of the permutation vector?
     bool m_use_rhs_sparsity;      ///< leverage right-hand side sparsity?
     bool m_null_pivot_detection;  ///< enable detection of zero pivots?
@@ -240,6 +274,72 @@ class ChApi ChSolverSparseQR : public ChDirectSolverLS {
     Eigen::SparseQR<ChSparseMatrix, Eigen::COLAMDOrdering<int>> m_engine;  ///< Eigen SparseQR solver
 };
 
+/// Sparse LDLT direct solver.\n
+/// Interface to Eigen's simplicial LDLT (or LLT) factorization, for symmetric matrices.\n
+/// The matrix symmetry type (see #SetMatrixSymmetryType) selects the factorization:
+/// - SYMMETRIC_INDEF (default): LDLT, for problems with constraints or with an indefinite stiffness matrix;
+/// - SYMMETRIC_POSDEF: LLT (Cholesky), for problems without constraints and with a positive definite matrix.
+///
+/// Since the factorization does not pivot, the unknowns are reordered such that each constraint is eliminated after
+/// all variables it acts on (within an approximate minimum degree ordering of the variables). With this ordering, the
+/// factorization succeeds as long as the constraints are not redundant. Since small pivots can still lose accuracy, the
+/// solution of indefinite problems is improved with a few steps of iterative refinement (see #SetRefinementSteps).\n
+/// Cannot handle VI and complementarity problems, so it cannot be used with NSC formulations.\n
+/// See ChDirectSolverLS for more details.
+class ChApi ChSolverSparseLDLT : public ChDirectSolverLS {
+  public:
+    ChSolverSparseLDLT();
+    ~ChSolverSparseLDLT() {}
+    virtual Type GetType() const override { return Type::SPARSE_LDLT; }
+
+    /// Set the matrix symmetry type (default: SYMMETRIC_INDEF).
+    /// Only SYMMETRIC_INDEF and SYMMETRIC_POSDEF are supported; a ChException is thrown for any other type.
+    virtual void SetMatrixSymmetryType(MatrixSymmetryType symmetry) override;
+
+    /// Set the number of iterative refinement steps performed after each solve (default: 2).
+    /// Each step requires one matrix-vector product and one solve with the existing factorization.
+    /// Refinement is only performed with the LDLT factorization (SYMMETRIC_INDEF); it is skipped with LLT.
+    void SetRefinementSteps(int steps) { m_refinement_steps = std::max(0, steps); }
+
+    /// Perform the solver setup operations.
+    virtual bool Setup(ChSystemDescriptor& sysd) override;
+
+  private:
+    typedef Eigen::SparseMatrix<double, Eigen::ColMajor, int> ColMajorMatrix;
+
+    /// Factorize the current sparse matrix and return true if successful.
+    virtual bool FactorizeMatrix() override;
+
+    /// Solve the linear system using the current factorization and right-hand side vector.
+    /// Load the solution vector (already of appropriate size) and return true if succesful.
+    virtual bool SolveSystem() override;
+
+    /// Display an error message corresponding to the last failure.
+    /// This function is only called if Factorize or Solve returned false.
+    virtual void PrintErrorMessage() override;
+
+    /// Evaluate the fill-reducing permutation, with each constraint placed after the variables it acts on.
+    void ComputeOrdering();
+
+    /// Solve with the current factorization, applying the fill-reducing permutation.
+    ChVectorDynamic<> SolvePermuted(const ChVectorDynamic<>& rhs) const;
+
+    /// Return the status of the last factorization.
+    Eigen::ComputationInfo GetInfo() const;
+
+    int m_num_constraints;   ///< number of constraints (last rows of the problem matrix)
+    int m_refinement_steps;  ///< number of iterative refinement steps
+    bool m_use_llt;          ///< use the LLT factorization (SYMMETRIC_POSDEF)?
+
+    Eigen::PermutationMatrix<Eigen::Dynamic, Eigen::Dynamic, int> m_perm;  ///< fill-reducing permutation
+    ColMajorMatrix m_pmat;                                                 ///< permuted matrix (upper triangle)
+
+    /// Eigen simplicial LDLT solver (the ordering is applied to the matrix, see m_perm)
+    Eigen::SimplicialLDLT<ColMajorMatrix, Eigen::Upper, Eigen::NaturalOrdering<int>> m_ldlt_engine;
+    /// Eigen simplicial LLT solver (the ordering is applied to the matrix, see m_perm)
+    Eigen::SimplicialLLT<ColMajorMatrix, Eigen::Upper, Eigen::NaturalOrdering<int>> m_llt_engine;
+};
+
 /// @} chrono_solver
 
 }  // end namespace chrono
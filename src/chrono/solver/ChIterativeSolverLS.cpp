@@ -15,7 +15,8 @@
 // Chrono solvers based on Eigen iterative linear solvers.
 // All iterative linear solvers are implemented in a matrix-free context and
 // rely on the system descriptor for the required SPMV operations.
-// They can optionally use a diagonal preconditioner.
+// They can optionally use a diagonal, block-Jacobi, or incomplete LU
+// preconditioner.
 //
 // Available solvers:
 //   GMRES
@@ -25,6 +26,8 @@
 // =============================================================================
 
 #include "chrono/solver/ChIterativeSolverLS.h"
+#include "chrono/solver/ChKblockGeneric.h"
+#include "chrono/core/ChSparsityPatternLearner.h"
 
 // =============================================================================
 
@@ -77,58 +80,76 @@ class ChMatrixSPMV : public Eigen::EigenBase<ChMatrixSPMV> {
     chrono::ChVectorDynamic<> m_vect;    // workspace for the result of the SPMV operation
 };
 
-/// Simple diagonal preconditioner
-class ChDiagonalPreconditioner {
+/// Preconditioner for the Eigen iterative solvers.
+/// Applies the preconditioner built by the associated ChIterativeSolverLS (see ChIterativeSolverLS::Setup).
+class ChIterativePreconditioner {
     typedef double Scalar;
 
   public:
     typedef int StorageIndex;
     enum { ColsAtCompileTime = Eigen::Dynamic, MaxColsAtCompileTime = Eigen::Dynamic };
 
-    ChDiagonalPreconditioner() : m_N(0), m_diag_precond(false), m_invdiag(nullptr) {}
+    ChIterativePreconditioner() : m_N(0), m_solver(nullptr) {}
 
-    void Setup(Eigen::Index N, const ChVectorDynamic<>& invdiag) {
+    void Setup(Eigen::Index N, const ChIterativeSolverLS* solver) {
         m_N = N;
-        m_invdiag = &invdiag;
-        m_diag_precond = (invdiag.size() > 0);
+        m_solver = solver;
     }
 
     Eigen::Index rows() const { return m_N; }
     Eigen::Index cols() const { return m_N; }
 
     template <typename MatType>
-    ChDiagonalPreconditioner& analyzePattern(const MatType&) {
+    ChIterativePreconditioner& analyzePattern(const MatType&) {
         return *this;
     }
     template <typename MatType>
-    ChDiagonalPreconditioner& factorize(const MatType& mat) {
+    ChIterativePreconditioner& factorize(const MatType& mat) {
         return *this;
     }
     template <typename MatType>
-    ChDiagonalPreconditioner& compute(const MatType& mat) {
+    ChIterativePreconditioner& compute(const MatType& mat) {
         return *this;
     }
 
     template <typename Rhs, typename Dest>
     void _solve_impl(const Rhs& b, Dest& x) const {
-        if (m_diag_precond) {
-            x = m_invdiag->array() * b.array();
-        } else {
-            x = b;
+        auto type = m_solver ? m_solver->m_precond_active : ChIterativeSolverLS::PreconditionerType::NONE;
+
+        switch (type) {
+            case ChIterativeSolverLS::PreconditionerType::DIAGONAL:
+                x = m_solver->m_invdiag.array() * b.array();
+                break;
+            case ChIterativeSolverLS::PreconditionerType::BLOCK_JACOBI: {
+                // Diagonal blocks of the variables, followed by the (diagonal) constraint entries
+                x = m_solver->m_invdiag.array() * b.array();
+                const auto& offsets = m_solver->m_block_offsets;
+                const auto& blocks = m_solver->m_block_inv;
+                for (size_t k = 0; k < blocks.size(); k++) {
+                    auto n = blocks[k].rows();
+                    x.segment(offsets[k], n).noalias() = blocks[k] * b.segment(offsets[k], n);
+                }
+                break;
+            }
+            case ChIterativeSolverLS::PreconditionerType::ILU:
+                x = m_solver->m_ilu.solve(b);
+                break;
+            default:
+                x = b;
+                break;
         }
     }
 
     template <typename Rhs>
-    inline const Eigen::Solve<ChDiagonalPreconditioner, Rhs> solve(const Eigen::MatrixBase<Rhs>& b) const {
-        return Eigen::Solve<ChDiagonalPreconditioner, Rhs>(*this, b.derived());
+    inline const Eigen::Solve<ChIterativePreconditioner, Rhs> solve(const Eigen::MatrixBase<Rhs>& b) const {
+        return Eigen::Solve<ChIterativePreconditioner, Rhs>(*this, b.derived());
     }
 
     Eigen::ComputationInfo info() { return Eigen::Success; }
 
   protected:
-    Eigen::Index m_N;                    // problem dimension
-    const ChVectorDynamic<>* m_invdiag;  // pointer to (invcerse) diagonal entries
-    bool m_diag_precond;                 // if false, no preconditioning
+    Eigen::Index m_N;                     // problem dimension
+    const ChIterativeSolverLS* m_solver;  // solver owning the preconditioner data
 };
 
 }  // namespace chrono
@@ -169,7 +190,15 @@ CH_FACTORY_REGISTER(ChSolverGMRES)
 CH_FACTORY_REGISTER(ChSolverBiCGSTAB)
 CH_FACTORY_REGISTER(ChSolverMINRES)
 
-ChIterativeSolverLS::ChIterativeSolverLS() : ChIterativeSolver(-1, -1.0, true, false) {
+ChIterativeSolverLS::ChIterativeSolverLS()
+    : ChIterativeSolver(-1, -1.0, true, false),
+      m_precond_type(PreconditionerType::DIAGONAL),
+      m_precond_active(PreconditionerType::NONE),
+      m_precond_interval(1),
+      m_precond_age(-1),
+      m_precond_updates(0),
+      m_ilu_droptol(1e-4),
+      m_ilu_fillfactor(10) {
     m_spmv = new ChMatrixSPMV();
 }
 
@@ -184,16 +213,22 @@ bool ChIterativeSolverLS::Setup(ChSystemDescriptor& sysd) {
     // Set up the SPMV wrapper
     m_spmv->Setup(dim, sysd);
 
-    // If needed, evaluate the inverse diagonal entries
-    if (m_use_precond) {
-        m_invdiag.resize(dim);
-        sysd.BuildDiagonalVector(m_invdiag);
-        for (int i = 0; i < dim; i++) {
-            if (std::abs(m_invdiag(i)) > 1e-9)
-                m_invdiag(i) = 1.0 / m_invdiag(i);
-            else
-                m_invdiag(i) = 1.0;
+    // If needed, update the preconditioner.
+    // MINRES requires a symmetric positive definite preconditioner, so it cannot use ILU.
+    if (m_use_precond && m_precond_type != PreconditionerType::NONE) {
+        auto type = m_precond_type;
+        if (type == PreconditionerType::ILU && GetType() == Type::MINRES)
+            type = PreconditionerType::BLOCK_JACOBI;
+
+        // Rebuild the preconditioner if forced, if it is too old, or if the problem size changed
+        bool update = (m_precond_age < 0) || (++m_precond_age >= m_precond_interval);
+        if (update || m_precond_active == PreconditionerType::NONE || m_invdiag.size() != dim) {
+            UpdatePreconditioner(sysd, type);
+            m_precond_age = 0;
+            m_precond_updates++;
         }
+    } else {
+        m_precond_active = PreconditionerType::NONE;
     }
 
     // If needed, evaluate the initial guess
@@ -237,10 +272,203 @@ double ChIterativeSolverLS::Solve(ChSystemDescriptor& sysd) {
     return result;
 }
 
+void ChIterativeSolverLS::SetPreconditioner(PreconditionerType type) {
+    m_precond_type = type;
+    m_use_precond = (type != PreconditionerType::NONE);
+    m_precond_age = -1;
+}
+
+void ChIterativeSolverLS::SetILUParameters(double droptol, int fillfactor) {
+    m_ilu_droptol = droptol;
+    m_ilu_fillfactor = fillfactor;
+    m_precond_age = -1;
+}
+
+void ChIterativeSolverLS::UpdatePreconditioner(ChSystemDescriptor& sysd, PreconditionerType type) {
+    // The diagonal preconditioner is always evaluated: it is the fallback for the other types
+    BuildDiagonalPreconditioner(sysd);
+    m_precond_active = PreconditionerType::DIAGONAL;
+
+    switch (type) {
+        case PreconditionerType::BLOCK_JACOBI:
+            BuildBlockJacobiPreconditioner(sysd);
+            m_precond_active = PreconditionerType::BLOCK_JACOBI;
+            break;
+        case PreconditionerType::ILU:
+            BuildILUPreconditioner(sysd);
+            if (m_ilu.info() == Eigen::Success)
+                m_precond_active = PreconditionerType::ILU;
+            else if (verbose)
+                std::cout << "  ILU factorization failed; using diagonal preconditioner" << std::endl;
+            break;
+        default:
+            break;
+    }
+
+    if (verbose) {
+        std::cout << "  Preconditioner update " << m_precond_updates << " (type " << static_cast<int>(m_precond_active)
+                  << ")" << std::endl;
+    }
+}
+
+void ChIterativeSolverLS::BuildDiagonalPreconditioner(ChSystemDescriptor& sysd) {
+    int dim = sysd.BuildDiagonalVector(m_invdiag);
+    for (int i = 0; i < dim; i++) {
+        if (std::abs(m_invdiag(i)) > 1e-9)
+            m_invdiag(i) = 1.0 / m_invdiag(i);
+        else
+            m_invdiag(i) = 1.0;
+    }
+}
+
+void ChIterativeSolverLS::BuildBlockJacobiPreconditioner(ChSystemDescriptor& sysd) {
+    std::vector<ChVariables*>& vvariables = sysd.GetVariablesList();
+    std::vector<ChConstraint*>& vconstraints = sysd.GetConstraintsList();
+    std::vector<ChKblock*>& vstiffness = sysd.GetKblocksList();
+
+    int n_q = sysd.CountActiveVariables();
+    int n_c = sysd.CountActiveConstraints();
+    double c_a = sysd.GetMassFactor();
+
+    // Mass blocks of the active variables (scaled by the mass factor).
+    // Also record the block of each variable entry (as needed to collect the stiffness and constraint terms).
+    std::vector<int> block_of(n_q, -1);
+    m_block_offsets.clear();
+    m_block_inv.clear();
+    for (auto var : vvariables) {
+        if (!var->IsActive() || var->Get_ndof() == 0)
+            continue;
+        int offset = var->GetOffset();
+        int ndof = var->Get_ndof();
+        ChMatrixDynamic<> B(ndof, ndof);
+        ChVectorDynamic<> e = ChVectorDynamic<>::Zero(ndof);
+        ChVectorDynamic<> col(ndof);
+        for (int j = 0; j < ndof; j++) {
+            e(j) = 1;
+            col.setZero();
+            var->Compute_inc_Mb_v(col, e);
+            B.col(j) = c_a * col;
+            e(j) = 0;
+        }
+        for (int j = 0; j < ndof; j++)
+            block_of[offset + j] = (int)m_block_offsets.size();
+        m_block_offsets.push_back(offset);
+        m_block_inv.push_back(B);
+    }
+
+    // Add the diagonal blocks of the stiffness matrices.
+    // For ChKblock objects other than ChKblockGeneric, only their diagonal entries are used.
+    ChVectorDynamic<> Kdiag = ChVectorDynamic<>::Zero(n_q + n_c);
+    for (auto kblock : vstiffness) {
+        auto kgeneric = dynamic_cast<ChKblockGeneric*>(kblock);
+        if (!kgeneric) {
+            kblock->DiagonalAdd(Kdiag);
+            continue;
+        }
+        ChMatrixRef K = kgeneric->Get_K();
+        int kio = 0;
+        for (unsigned int iv = 0; iv < kgeneric->GetNvars(); iv++) {
+            ChVariables* var = kgeneric->GetVariableN(iv);
+            int ndof = var->Get_ndof();
+            if (var->IsActive() && ndof > 0) {
+                int k = block_of[var->GetOffset()];
+                m_block_inv[k] += K.block(kio, kio, ndof, ndof);
+            }
+            kio += ndof;
+        }
+    }
+
+    // Add the remaining stiffness diagonal entries and invert the diagonal blocks.
+    // Singular blocks are replaced by the inverse diagonal entries.
+    // MINRES requires a symmetric positive definite preconditioner: in that case, the symmetric part of each block is
+    // inverted, and blocks which are not positive definite are replaced by the inverse diagonal entries.
+    bool spd = (GetType() == Type::MINRES);
+    for (size_t k = 0; k < m_block_inv.size(); k++) {
+        auto& B = m_block_inv[k];
+        auto n = B.rows();
+        B.diagonal() += Kdiag.segment(m_block_offsets[k], n);
+        bool inverted = false;
+        if (spd) {
+            ChMatrixDynamic<> Bs = 0.5 * (B + B.transpose());
+            Eigen::LLT<ChMatrixDynamic<>> llt(Bs);
+            if (llt.info() == Eigen::Success) {
+                ChMatrixDynamic<> Binv = llt.solve(ChMatrixDynamic<>::Identity(n, n));
+                B = 0.5 * (Binv + Binv.transpose());
+                inverted = true;
+            }
+        } else {
+            Eigen::FullPivLU<ChMatrixDynamic<>> lu(B);
+            if (lu.isInvertible()) {
+                B = lu.inverse();
+                inverted = true;
+            }
+        }
+        if (!inverted)
+            B = m_invdiag.segment(m_block_offsets[k], n).asDiagonal();
+    }
+
+    if (n_c == 0)
+        return;
+
+    // Constraint Jacobian
+    ChSparseMatrix Cq;
+    ChSparsityPatternLearner sparsity_pattern(n_c, n_q);
+    for (auto constr : vconstraints) {
+        if (constr->IsActive())
+            constr->Build_Cq(sparsity_pattern, constr->GetOffset());
+    }
+    sparsity_pattern.Apply(Cq);
+    for (auto constr : vconstraints) {
+        if (constr->IsActive())
+            constr->Build_Cq(Cq, constr->GetOffset());
+    }
+
+    // Diagonal of the Schur complement, approximated with the block-diagonal part B of the system matrix:
+    // s_i = Cq_i * B^-1 * Cq_i' + |cfm_i|
+    // Since the column indices in each row are sorted, the entries acting on a given block are consecutive.
+    ChVectorDynamic<> S = ChVectorDynamic<>::Zero(n_c);
+    for (auto constr : vconstraints) {
+        if (constr->IsActive())
+            S(constr->GetOffset()) = std::abs(constr->Get_cfm_i());
+    }
+    ChVectorDynamic<> cq;
+    for (int i = 0; i < n_c; i++) {
+        int k = -1;
+        for (ChSparseMatrix::InnerIterator it(Cq, i); it; ++it) {
+            int kk = block_of[it.col()];
+            if (kk != k) {
+                if (k >= 0)
+                    S(i) += cq.dot(m_block_inv[k] * cq);
+                k = kk;
+                cq.setZero(m_block_inv[k].rows());
+            }
+            cq(it.col() - m_block_offsets[k]) = it.value();
+        }
+        if (k >= 0)
+            S(i) += cq.dot(m_block_inv[k] * cq);
+
+        m_invdiag(n_q + i) = (S(i) > 1e-9) ? 1.0 / S(i) : 1.0;
+    }
+}
+
+void ChIterativeSolverLS::BuildILUPreconditioner(ChSystemDescriptor& sysd) {
+    int dim = sysd.CountActiveVariables() + sysd.CountActiveConstraints();
+
+    ChSparsityPatternLearner sparsity_pattern(dim, dim);
+    sysd.ConvertToMatrixForm(&sparsity_pattern, nullptr);
+    sparsity_pattern.Apply(m_mat);
+    sysd.ConvertToMatrixForm(&m_mat, nullptr);
+    m_mat.makeCompressed();
+
+    m_ilu.setDroptol(m_ilu_droptol);
+    m_ilu.setFillfactor(m_ilu_fillfactor);
+    m_ilu.compute(m_mat);
+}
+
 // ---------------------------------------------------------------------------
 
 ChSolverGMRES::ChSolverGMRES() {
-    m_engine = new Eigen::GMRES<ChMatrixSPMV, ChDiagonalPreconditioner>();
+    m_engine = new Eigen::GMRES<ChMatrixSPMV, ChIterativePreconditioner>();
 }
 
 ChSolverGMRES::~ChSolverGMRES() {
@@ -248,7 +476,7 @@ ChSolverGMRES::~ChSolverGMRES() {
 }
 
 bool ChSolverGMRES::SetupProblem() {
-    m_engine->preconditioner().Setup(m_rhs.size(), m_invdiag);
+    m_engine->preconditioner().Setup(m_spmv->rows(), this);
     m_engine->compute(*m_spmv);
     return (m_engine->info() == Eigen::Success);
 }
@@ -285,7 +513,7 @@ double ChSolverGMRES::GetError() const {
 // ---------------------------------------------------------------------------
 
 ChSolverBiCGSTAB::ChSolverBiCGSTAB() {
-    m_engine = new Eigen::BiCGSTAB<ChMatrixSPMV, ChDiagonalPreconditioner>();
+    m_engine = new Eigen::BiCGSTAB<ChMatrixSPMV, ChIterativePreconditioner>();
 }
 
 ChSolverBiCGSTAB::~ChSolverBiCGSTAB() {
@@ -293,7 +521,7 @@ ChSolverBiCGSTAB::~ChSolverBiCGSTAB() {
 }
 
 bool ChSolverBiCGSTAB::SetupProblem() {
-    m_engine->preconditioner().Setup(m_rhs.size(), m_invdiag);
+    m_engine->preconditioner().Setup(m_spmv->rows(), this);
     m_engine->compute(*m_spmv);
     return (m_engine->info() == Eigen::Success);
 }
@@ -331,7 +559,7 @@ double ChSolverBiCGSTAB::GetError() const {
 // ---------------------------------------------------------------------------
 
 ChSolverMINRES::ChSolverMINRES() {
-    m_engine = new Eigen::MINRES<ChMatrixSPMV, Eigen::Lower | Eigen::Upper, ChDiagonalPreconditioner>();
+    m_engine = new Eigen::MINRES<ChMatrixSPMV, Eigen::Lower | Eigen::Upper, ChIterativePreconditioner>();
 }
 
 ChSolverMINRES::~ChSolverMINRES() {
@@ -339,7 +567,7 @@ ChSolverMINRES::~ChSolverMINRES() {
 }
 
 bool ChSolverMINRES::SetupProblem() {
-    m_engine->preconditioner().Setup(m_rhs.size(), m_invdiag);
+    m_engine->preconditioner().Setup(m_spmv->rows(), this);
     m_engine->compute(*m_spmv);
     return (m_engine->info() == Eigen::Success);
 }
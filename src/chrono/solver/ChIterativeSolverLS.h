@@ -15,7 +15,8 @@
 // Chrono solvers based on Eigen iterative linear solvers.
 // All iterative linear solvers are implemented in a matrix-free context and
 // rely on the system descriptor for the required SPMV operations.
-// They can optionally use a diagonal preconditioner.
+// They can optionally use a diagonal, block-Jacobi, or incomplete LU
+// preconditioner.
 //
 // Available solvers:
 //   GMRES
@@ -27,6 +28,8 @@
 #ifndef CH_ITERATIVESOLVER_LS_H
 #define CH_ITERATIVESOLVER_LS_H
 
+#include <vector>
+
 #include "chrono/solver/ChSolverLS.h"
 #include "chrono/solver/ChIterativeSolver.h"
 
@@ -42,7 +45,7 @@ namespace chrono {
 
 // Forward declarations of wrapper class for SPMV operations and custom preconditioner
 class ChMatrixSPMV;
-class ChDiagonalPreconditioner;
+class ChIterativePreconditioner;
 
 // ---------------------------------------------------------------------------
 
@@ -63,11 +66,54 @@ residual error: |Ax - b|/|b|. Default: machine precision.
 
 By default, these solvers use a diagonal preconditioner and no warm start. Recall that the warm start option should
 be used **only** in conjunction with the Euler implicit linearized integrator.
+
+Stronger preconditioners can be selected with #SetPreconditioner: a block-Jacobi preconditioner (built from the
+ChVariables mass blocks and the diagonal blocks of the ChKblock stiffness matrices) or an incomplete LU factorization
+of the assembled system matrix. Since these are more expensive to build, they can be reused over several calls to
+#Setup (e.g., across the Newton iterations of an implicit integrator or of a nonlinear static analysis); see
+#SetPreconditionerUpdateInterval.
 */
 class ChApi ChIterativeSolverLS : public ChIterativeSolver, public ChSolverLS {
   public:
+    /// Preconditioner types.
+    enum class PreconditionerType {
+        NONE,          ///< no preconditioning
+        DIAGONAL,      ///< diagonal (Jacobi) preconditioner
+        BLOCK_JACOBI,  ///< block-diagonal preconditioner (variable blocks and constraint Schur complement diagonal)
+        ILU            ///< incomplete LU factorization with dual threshold (Eigen::IncompleteLUT)
+    };
+
     virtual ~ChIterativeSolverLS();
 
+    /// Set the preconditioner type (default: DIAGONAL).
+    /// With BLOCK_JACOBI, each block of variables (e.g., 6x6 for a body, 3x3 for an FEA xyz node) is preconditioned
+    /// with the inverse of its mass block plus the diagonal blocks of the stiffness matrices which act on it; each
+    /// constraint is preconditioned with the inverse of Cq_i * B^-1 * Cq_i' (+ cfm_i), B being the block-diagonal
+    /// part of the system matrix. With MINRES, which requires a symmetric positive definite preconditioner, the
+    /// symmetric part of each block is used, and blocks that are not positive definite are preconditioned with their
+    /// diagonal only. ILU is not symmetric and cannot be used with MINRES (BLOCK_JACOBI is used instead).
+    /// Note that EnableDiagonalPreconditioner(false) disables preconditioning, irrespective of this setting.
+    void SetPreconditioner(PreconditionerType type);
+
+    /// Get the current preconditioner type.
+    PreconditionerType GetPreconditioner() const { return m_use_precond ? m_precond_type : PreconditionerType::NONE; }
+
+    /// Set the number of calls to #Setup between preconditioner updates (default: 1).
+    /// With a value n > 1, the preconditioner is rebuilt only at every n-th call to Setup (or when the problem size
+    /// changes) and reused in between, even though the system matrix changed.
+    void SetPreconditionerUpdateInterval(int n) { m_precond_interval = std::max(1, n); }
+
+    /// Force a preconditioner update at the next call to #Setup.
+    void ForcePreconditionerUpdate() { m_precond_age = -1; }
+
+    /// Set the parameters of the incomplete LU factorization (default: 1e-4 and 10).
+    /// Entries smaller (in relative terms) than the drop tolerance are dropped; the fill factor limits the number of
+    /// nonzeros per row of the factors, relative to the number of nonzeros per row in the system matrix.
+    void SetILUParameters(double droptol, int fillfactor);
+
+    /// Return the number of preconditioner updates since construction.
+    int GetNumPreconditionerUpdates() const { return m_precond_updates; }
+
     /// Perform the solver setup operations.\n
     /// Here, sysd is the system description with constraints and variables.
     /// Returns true if successful and false otherwise.
@@ -95,6 +141,34 @@ class ChApi ChIterativeSolverLS : public ChIterativeSolver, public ChSolverLS {
     ChVectorDynamic<double> m_rhs;        ///< right-hand side vector
     ChVectorDynamic<double> m_invdiag;    ///< inverse diagonal entries (for preconditioning)
     ChVectorDynamic<double> m_initguess;  ///< initial guess (for warm start)
+
+    PreconditionerType m_precond_type;    ///< requested preconditioner type
+    PreconditionerType m_precond_active;  ///< preconditioner type built at the last update
+    int m_precond_interval;               ///< number of Setup calls between preconditioner updates
+    int m_precond_age;                    ///< number of Setup calls since the last preconditioner update
+    int m_precond_updates;                ///< number of preconditioner updates
+
+    std::vector<int> m_block_offsets;                  ///< offsets of the diagonal blocks (block Jacobi)
+    std::vector<ChMatrixDynamic<double>> m_block_inv;  ///< inverse diagonal blocks (block Jacobi)
+    ChSparseMatrix m_mat;                              ///< assembled system matrix (ILU)
+    Eigen::IncompleteLUT<double, int> m_ilu;           ///< incomplete LU factorization (ILU)
+    double m_ilu_droptol;                              ///< ILU drop tolerance
+    int m_ilu_fillfactor;                              ///< ILU fill factor
+
+  private:
+    /// Rebuild the preconditioner of the specified type.
+    void UpdatePreconditioner(ChSystemDescriptor& sysd, PreconditionerType type);
+
+    /// Evaluate the inverse diagonal entries (diagonal preconditioner).
+    void BuildDiagonalPreconditioner(ChSystemDescriptor& sysd);
+
+    /// Evaluate the inverse diagonal blocks and the constraint diagonal (block-Jacobi preconditioner).
+    void BuildBlockJacobiPreconditioner(ChSystemDescriptor& sysd);
+
+    /// Assemble the system matrix and evaluate its incomplete LU factorization.
+    void BuildILUPreconditioner(ChSystemDescriptor& sysd);
+
+    friend class ChIterativePreconditioner;
 };
 
 // ---------------------------------------------------------------------------
@@ -115,7 +189,7 @@ class ChApi ChSolverGMRES : public ChIterativeSolverLS {
     virtual bool SetupProblem() override;
     virtual bool SolveProblem() override;
 
-    Eigen::GMRES<ChMatrixSPMV, ChDiagonalPreconditioner>* m_engine;
+    Eigen::GMRES<ChMatrixSPMV, ChIterativePreconditioner>* m_engine;
 };
 
 // ---------------------------------------------------------------------------
@@ -135,7 +209,7 @@ class ChApi ChSolverBiCGSTAB : public ChIterativeSolverLS {
     virtual bool SetupProblem() override;
     virtual bool SolveProblem() override;
 
-    Eigen::BiCGSTAB<ChMatrixSPMV, ChDiagonalPreconditioner>* m_engine;
+    Eigen::BiCGSTAB<ChMatrixSPMV, ChIterativePreconditioner>* m_engine;
 };
 
 // ---------------------------------------------------------------------------
@@ -156,7 +230,7 @@ class ChApi ChSolverMINRES : public ChIterativeSolverLS {
     virtual bool SetupProblem() override;
     virtual bool SolveProblem() override;
 
-    Eigen::MINRES<ChMatrixSPMV, Eigen::Lower | Eigen::Upper, ChDiagonalPreconditioner>* m_engine;
+    Eigen::MINRES<ChMatrixSPMV, Eigen::Lower | Eigen::Upper, ChIterativePreconditioner>* m_engine;
 };
 
 /// @} chrono_solver
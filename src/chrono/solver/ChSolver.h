@@ -50,6 +50,10 @@ class ChApi ChSolver {
         GMRES,     ///< Generalized Minimal RESidual Algorithm
         MINRES,    ///< MINimum RESidual method
         BICGSTAB,  ///< Bi-conjugate gradient stabilized
+        // Iterative VI solvers (added after the types above, to keep their values)
+        PSOR_COLORED,  ///< Projected SOR, multithreaded over colors of the constraint graph
+        // Direct linear solvers (added after the types above, to keep their values)
+        SPARSE_LDLT,  ///< Sparse simplicial LDLT factorization (symmetric matrices)
         // Other
         CUSTOM,
     };
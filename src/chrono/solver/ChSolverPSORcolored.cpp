@@ -0,0 +1,320 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+
+#include <algorithm>
+#include <cstdint>
+#include <unordered_map>
+
+#include "chrono/solver/ChSolverPSORcolored.h"
+#include "chrono/core/ChMathematics.h"
+#include "chrono/parallel/ChOpenMP.h"
+
+namespace chrono {
+
+// Register into the object factory, to enable run-time dynamic creation and persistence
+CH_FACTORY_REGISTER(ChSolverPSORcolored)
+
+ChSolverPSORcolored::ChSolverPSORcolored()
+    : m_nthreads(CHOMPfunctions::GetMaxThreads()), m_symmetric(false), maxviolation(0) {}
+
+void ChSolverPSORcolored::SetNumThreads(int num_threads) {
+    m_nthreads = std::max(1, num_threads);
+}
+
+void ChSolverPSORcolored::ColorConstraints(ChSystemDescriptor& sysd) {
+    std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
+    std::vector<ChVariables*>& mvariables = sysd.GetVariablesList();
+
+    // Only active variables are modified by Increment_q, so only these create dependencies between constraints
+    // (in particular, fixed bodies shared by many contacts do not).
+    std::unordered_map<ChVariables*, int> var_index;
+    var_index.reserve(mvariables.size());
+    for (int iv = 0; iv < (int)mvariables.size(); iv++) {
+        if (mvariables[iv]->IsActive())
+            var_index[mvariables[iv]] = iv;
+    }
+
+    // Group the active constraints into units. As in ChSolverPSOR, every three friction constraints form a triplet
+    // (N,U,V) which is projected as a whole.
+    std::vector<Unit> units;
+    units.reserve(mconstraints.size());
+    Unit friction_unit;
+    friction_unit.count = 0;
+    for (int ic = 0; ic < (int)mconstraints.size(); ic++) {
+        if (!mconstraints[ic]->IsActive())
+            continue;
+        if (mconstraints[ic]->GetMode() == CONSTRAINT_FRIC) {
+            friction_unit.ic[friction_unit.count++] = ic;
+            if (friction_unit.count == 3) {
+                units.push_back(friction_unit);
+                friction_unit.count = 0;
+            }
+        } else {
+            Unit unit;
+            unit.ic[0] = ic;
+            unit.count = 1;
+            units.push_back(unit);
+        }
+    }
+
+    // Greedy coloring: assign to each unit the smallest color not yet used by any of its variables.
+    // The colors used by each variable are kept in a bitmask.
+    // Units with unknown connectivity (no variables reported) conflict with all other units; they are colored last,
+    // each with a color of its own.
+    std::vector<std::vector<uint64_t>> var_colors(mvariables.size());
+    std::vector<int> unit_color(units.size());
+    std::vector<int> unit_vars;
+    std::vector<ChVariables*> vars;
+    std::vector<uint64_t> forbidden;
+    std::vector<size_t> isolated_units;
+    int ncolors = 0;
+
+    for (size_t iu = 0; iu < units.size(); iu++) {
+        vars.clear();
+        for (int k = 0; k < units[iu].count; k++)
+            mconstraints[units[iu].ic[k]]->CollectVariables(vars);
+
+        if (vars.empty()) {
+            isolated_units.push_back(iu);
+            continue;
+        }
+
+        unit_vars.clear();
+        forbidden.assign((ncolors + 63) / 64 + 1, 0);
+        for (auto var : vars) {
+            auto found = var_index.find(var);
+            if (found == var_index.end())
+                continue;
+            unit_vars.push_back(found->second);
+            const auto& mask = var_colors[found->second];
+            for (size_t w = 0; w < mask.size(); w++)
+                forbidden[w] |= mask[w];
+        }
+
+        size_t word = 0;
+        while (forbidden[word] == ~uint64_t(0))
+            word++;
+        int bit = 0;
+        while (forbidden[word] & (uint64_t(1) << bit))
+            bit++;
+        int color = (int)(64 * word) + bit;
+
+        unit_color[iu] = color;
+        ncolors = std::max(ncolors, color + 1);
+        for (auto iv : unit_vars) {
+            auto& mask = var_colors[iv];
+            if (mask.size() <= word)
+                mask.resize(word + 1, 0);
+            mask[word] |= uint64_t(1) << bit;
+        }
+    }
+
+    for (auto iu : isolated_units)
+        unit_color[iu] = ncolors++;
+
+    // Sort units by color (counting sort, stable so that the original order is kept within each color).
+    m_color_start.assign(ncolors + 1, 0);
+    for (auto color : unit_color)
+        m_color_start[color + 1]++;
+    for (int c = 0; c < ncolors; c++)
+        m_color_start[c + 1] += m_color_start[c];
+
+    m_units.resize(units.size());
+    std::vector<int> next(m_color_start.begin(), m_color_start.end() - 1);
+    for (size_t iu = 0; iu < units.size(); iu++)
+        m_units[next[unit_color[iu]]++] = units[iu];
+}
+
+void ChSolverPSORcolored::UpdateUnit(const std::vector<ChConstraint*>& mconstraints,
+                                     const Unit& unit,
+                                     double& violation,
+                                     double& deltalambda) {
+    if (unit.count == 1) {
+        ChConstraint* constr = mconstraints[unit.ic[0]];
+
+        // compute residual  c_i = [Cq_i]*q + b_i + cfm_i*l_i
+        double mresidual = constr->Compute_Cq_q() + constr->Get_b_i() + constr->Get_cfm_i() * constr->Get_l_i();
+
+        // true constraint violation may be different from 'mresidual' (ex:clamped if unilateral)
+        double candidate_violation = fabs(constr->Violation(mresidual));
+
+        // compute:  delta_lambda = -(omega/g_i) * ([Cq_i]*q + b_i + cfm_i*l_i )
+        double deltal = (m_omega / constr->Get_g_i()) * (-mresidual);
+
+        // update:   lambda += delta_lambda, then project onto the admissible set
+        double old_lambda = constr->Get_l_i();
+        constr->Set_l_i(old_lambda + deltal);
+        constr->Project();
+        double new_lambda = constr->Get_l_i();
+
+        // Apply the smoothing: lambda= sharpness*lambda_new_projected + (1-sharpness)*lambda_old
+        if (m_shlambda != 1.0) {
+            new_lambda = m_shlambda * new_lambda + (1.0 - m_shlambda) * old_lambda;
+            constr->Set_l_i(new_lambda);
+        }
+
+        double true_delta = new_lambda - old_lambda;
+        constr->Increment_q(true_delta);
+
+        deltalambda = ChMax(deltalambda, fabs(true_delta));
+        violation = ChMax(violation, candidate_violation);
+        return;
+    }
+
+    // Friction triplet: update N,U,V, then project the triplet onto the friction cone (done by the N component)
+    double old_lambda[3];
+    double new_lambda[3];
+    for (int k = 0; k < 3; k++) {
+        ChConstraint* constr = mconstraints[unit.ic[k]];
+        double mresidual = constr->Compute_Cq_q() + constr->Get_b_i() + constr->Get_cfm_i() * constr->Get_l_i();
+        double deltal = (m_omega / constr->Get_g_i()) * (-mresidual);
+        old_lambda[k] = constr->Get_l_i();
+        constr->Set_l_i(old_lambda[k] + deltal);
+        if (k == 0)
+            violation = ChMax(violation, fabs(ChMin(0.0, mresidual)));
+    }
+
+    mconstraints[unit.ic[0]]->Project();
+
+    for (int k = 0; k < 3; k++) {
+        ChConstraint* constr = mconstraints[unit.ic[k]];
+        new_lambda[k] = constr->Get_l_i();
+        if (m_shlambda != 1.0) {
+            new_lambda[k] = m_shlambda * new_lambda[k] + (1.0 - m_shlambda) * old_lambda[k];
+            constr->Set_l_i(new_lambda[k]);
+        }
+    }
+
+    for (int k = 0; k < 3; k++) {
+        double true_delta = new_lambda[k] - old_lambda[k];
+        mconstraints[unit.ic[k]]->Increment_q(true_delta);
+        deltalambda = ChMax(deltalambda, fabs(true_delta));
+    }
+}
+
+double ChSolverPSORcolored::Solve(ChSystemDescriptor& sysd) {
+    std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
+    std::vector<ChVariables*>& mvariables = sysd.GetVariablesList();
+
+    m_iterations = 0;
+    maxviolation = 0;
+    double maxdeltalambda = 0.;
+
+    // 1)  Update auxiliary data in all constraints before starting,
+    //     that is: g_i=[Cq_i]*[invM_i]*[Cq_i]' and  [Eq_i]=[invM_i]*[Cq_i]'
+#pragma omp parallel for num_threads(m_nthreads)
+    for (int ic = 0; ic < (int)mconstraints.size(); ic++)
+        mconstraints[ic]->Update_auxiliary();
+
+    // Average all g_i for the triplet of contact constraints n,u,v.
+    int j_friction_comp = 0;
+    double gi_values[3];
+    for (unsigned int ic = 0; ic < mconstraints.size(); ic++) {
+        if (mconstraints[ic]->GetMode() == CONSTRAINT_FRIC) {
+            gi_values[j_friction_comp] = mconstraints[ic]->Get_g_i();
+            j_friction_comp++;
+            if (j_friction_comp == 3) {
+                double average_g_i = (gi_values[0] + gi_values[1] + gi_values[2]) / 3.0;
+                mconstraints[ic - 2]->Set_g_i(average_g_i);
+                mconstraints[ic - 1]->Set_g_i(average_g_i);
+                mconstraints[ic - 0]->Set_g_i(average_g_i);
+                j_friction_comp = 0;
+            }
+        }
+    }
+
+    // 2)  Compute, for all items with variables, the initial guess for
+    //     still unconstrained system:
+#pragma omp parallel for num_threads(m_nthreads)
+    for (int iv = 0; iv < (int)mvariables.size(); iv++) {
+        if (mvariables[iv]->IsActive())
+            mvariables[iv]->Compute_invMb_v(mvariables[iv]->Get_qb(), mvariables[iv]->Get_fb());  // q = [M]'*fb
+    }
+
+    // 3)  For all items with variables, add the effect of initial (guessed)
+    //     lagrangian reactions of constraints, if a warm start is desired.
+    //     Otherwise, if no warm start, simply resets initial lagrangians to zero.
+    if (m_warm_start) {
+        for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
+            if (mconstraints[ic]->IsActive())
+                mconstraints[ic]->Increment_q(mconstraints[ic]->Get_l_i());
+    } else {
+        for (unsigned int ic = 0; ic < mconstraints.size(); ic++)
+            mconstraints[ic]->Set_l_i(0.);
+    }
+
+    // 4)  Color the constraint graph
+    ColorConstraints(sysd);
+    int ncolors = GetNumColors();
+
+    // 5)  Perform the iteration loops. Each sweep processes the colors in sequence, and the units of a color in
+    //     parallel. With symmetric sweeps, odd iterations process the colors in reverse order.
+    for (int iter = 0; iter < m_max_iterations; iter++) {
+        bool backward = m_symmetric && (iter % 2 == 1);
+
+        maxviolation = 0;
+        maxdeltalambda = 0;
+
+#pragma omp parallel num_threads(m_nthreads)
+        {
+            double violation = 0;
+            double deltalambda = 0;
+            for (int k = 0; k < ncolors; k++) {
+                int color = backward ? ncolors - 1 - k : k;
+#pragma omp for
+                for (int iu = m_color_start[color]; iu < m_color_start[color + 1]; iu++)
+                    UpdateUnit(mconstraints, m_units[iu], violation, deltalambda);
+            }
+#pragma omp critical
+            {
+                maxviolation = ChMax(maxviolation, violation);
+                maxdeltalambda = ChMax(maxdeltalambda, deltalambda);
+            }
+        }
+
+        // For recording into violation history, if debugging
+        if (this->record_violation_history)
+            AtIterationEnd(maxviolation, maxdeltalambda, iter);
+
+        m_iterations++;
+
+        // Terminate the loop if violation in constraints has been successfully limited.
+        if (maxviolation < m_tolerance)
+            break;
+    }
+
+    return maxviolation;
+}
+
+void ChSolverPSORcolored::ArchiveOUT(ChArchiveOut& marchive) {
+    // version number
+    marchive.VersionWrite<ChSolverPSORcolored>();
+    // serialize parent class
+    ChIterativeSolverVI::ArchiveOUT(marchive);
+    // serialize all member data:
+    marchive << CHNVP(m_nthreads);
+    marchive << CHNVP(m_symmetric);
+}
+
+void ChSolverPSORcolored::ArchiveIN(ChArchiveIn& marchive) {
+    // version number
+    int version = marchive.VersionRead<ChSolverPSORcolored>();
+    // deserialize parent class
+    ChIterativeSolverVI::ArchiveIN(marchive);
+    // stream in all member data:
+    marchive >> CHNVP(m_nthreads);
+    marchive >> CHNVP(m_symmetric);
+}
+
+}  // end namespace chrono
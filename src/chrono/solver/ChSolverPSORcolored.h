@@ -0,0 +1,103 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+
+#ifndef CHSOLVER_PSOR_COLORED_H
+#define CHSOLVER_PSOR_COLORED_H
+
+#include "chrono/solver/ChIterativeSolverVI.h"
+
+namespace chrono {
+
+/// @addtogroup chrono_solver
+/// @{
+
+/// A multithreaded variant of the projected SOR solver (see ChSolverPSOR), based on coloring of the constraint graph.\n
+/// At each solve, constraints (with friction triplets kept together) are partitioned into colors such that no two
+/// constraints of the same color act on the same active ChVariables object. The constraints of a color are then
+/// updated in parallel, and colors are processed one after the other, so each sweep is still a Gauss-Seidel sweep
+/// (with a different constraint ordering than ChSolverPSOR). Results do not depend on the number of threads.\n
+/// Constraints which do not report their variables (see ChConstraint::CollectVariables) are assumed to conflict with
+/// all other constraints and are each given a color of their own.\n
+/// Optionally, forward and backward sweeps over the colors can be alternated, as in symmetric SOR; in that case each
+/// sweep counts as one iteration.\n
+/// See ChSystemDescriptor for more information about the problem formulation and the data structures passed to the
+/// solver.
+class ChApi ChSolverPSORcolored : public ChIterativeSolverVI {
+  public:
+    ChSolverPSORcolored();
+
+    ~ChSolverPSORcolored() {}
+
+    virtual Type GetType() const override { return Type::PSOR_COLORED; }
+
+    /// Set the number of OpenMP threads used in the sweeps (default: maximum number of OpenMP threads).
+    void SetNumThreads(int num_threads);
+
+    /// Return the number of OpenMP threads used in the sweeps.
+    int GetNumThreads() const { return m_nthreads; }
+
+    /// Enable/disable symmetric sweeps, i.e. alternating forward and backward sweeps over the colors (default: false).
+    void SetSymmetric(bool symmetric) { m_symmetric = symmetric; }
+
+    /// Return true if symmetric sweeps are enabled.
+    bool GetSymmetric() const { return m_symmetric; }
+
+    /// Return the number of colors used in the last solve.
+    int GetNumColors() const { return (int)m_color_start.size() - 1; }
+
+    /// Performs the solution of the problem.
+    /// \return  the maximum constraint violation after termination.
+    virtual double Solve(ChSystemDescriptor& sysd  ///< system description with constraints and variables
+                         ) override;
+
+    /// Return the tolerance error reached during the last solve.
+    /// For the PSOR solver, this is the maximum constraint violation.
+    virtual double GetError() const override { return maxviolation; }
+
+    /// Method to allow serialization of transient data to archives.
+    virtual void ArchiveOUT(ChArchiveOut& marchive) override;
+
+    /// Method to allow de-serialization of transient data from archives.
+    virtual void ArchiveIN(ChArchiveIn& marchive) override;
+
+  private:
+    /// Set of constraints updated together: a single constraint or a friction triplet (normal first).
+    struct Unit {
+        int ic[3];
+        int count;
+    };
+
+    /// Group the active constraints into units and color them, so that units in the same color share no active
+    /// variables. On output, m_units is sorted by color and m_color_start holds the start of each color.
+    void ColorConstraints(ChSystemDescriptor& sysd);
+
+    /// Perform a projected SOR update of the constraints in the given unit.
+    void UpdateUnit(const std::vector<ChConstraint*>& mconstraints,
+                    const Unit& unit,
+                    double& violation,
+                    double& deltalambda);
+
+    int m_nthreads;
+    bool m_symmetric;
+    double maxviolation;
+
+    std::vector<Unit> m_units;       ///< constraint units, sorted by color
+    std::vector<int> m_color_start;  ///< start of each color in m_units (size: number of colors + 1)
+};
+
+/// @} chrono_solver
+
+}  // end namespace chrono
+
+#endif
@@ -26,6 +26,7 @@ double ChSolverPSSOR::Solve(ChSystemDescriptor& sysd) {
     std::vector<ChConstraint*>& mconstraints = sysd.GetConstraintsList();
     std::vector<ChVariables*>& mvariables = sysd.GetVariablesList();
 
+    m_iterations = 0;
     maxviolation = 0;
     double maxdeltalambda = 0.;
     int i_friction_comp = 0;
@@ -176,6 +177,8 @@ double ChSolverPSSOR::Solve(ChSystemDescriptor& sysd) {
         if (this->record_violation_history)
             AtIterationEnd(maxviolation, maxdeltalambda, iter);
 
+        m_iterations++;
+
         // Increment iter count (each sweep, either forward or backward, is considered
         // as a complete iteration, to be fair when comparing to the non-symmetric SOR :)
         iter++;
@@ -275,6 +278,8 @@ double ChSolverPSSOR::Solve(ChSystemDescriptor& sysd) {
         if (this->record_violation_history)
             AtIterationEnd(maxviolation, maxdeltalambda, iter);
 
+        m_iterations++;
+
         // Terminate the loop if violation in constraints has been successfully limited.
         if (maxviolation < m_tolerance)
             break;
@@ -28,6 +28,31 @@ void ChSharedMassBody::SetBodyInertia(const ChMatrix33<>& minertia) {
     inv_inertia = inertia.inverse();
 }
 
+void ChSharedMassBody::SetBodyInertiaXX(const ChVector<>& iner) {
+    inertia(0, 0) = iner.x();
+    inertia(1, 1) = iner.y();
+    inertia(2, 2) = iner.z();
+    inv_inertia = inertia.inverse();
+}
+
+void ChSharedMassBody::SetBodyInertiaXY(const ChVector<>& iner) {
+    inertia(0, 1) = iner.x();
+    inertia(0, 2) = iner.y();
+    inertia(1, 2) = iner.z();
+    inertia(1, 0) = iner.x();
+    inertia(2, 0) = iner.y();
+    inertia(2, 1) = iner.z();
+    inv_inertia = inertia.inverse();
+}
+
+ChVector<> ChSharedMassBody::GetBodyInertiaXX() const {
+    return ChVector<>(inertia(0, 0), inertia(1, 1), inertia(2, 2));
+}
+
+ChVector<> ChSharedMassBody::GetBodyInertiaXY() const {
+    return ChVector<>(inertia(0, 1), inertia(0, 2), inertia(1, 2));
+}
+
 void ChSharedMassBody::SetBodyMass(const double mmass) {
     mass = mmass;
     inv_mass = 1.0 / mass;
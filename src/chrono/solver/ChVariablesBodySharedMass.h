@@ -34,6 +34,18 @@ class ChApi ChSharedMassBody {
     /// Set the inertia matrix
     void SetBodyInertia(const ChMatrix33<>& minertia);
 
+    /// Set the diagonal part of the inertia matrix
+    void SetBodyInertiaXX(const ChVector<>& iner);
+
+    /// Set the extra-diagonal part of the inertia matrix (xy, yz, zx values, the rest is symmetric)
+    void SetBodyInertiaXY(const ChVector<>& iner);
+
+    /// Get the diagonal part of the inertia matrix
+    ChVector<> GetBodyInertiaXX() const;
+
+    /// Get the extra-diagonal part of the inertia matrix (xy, yz, zx values, the rest is symmetric)
+    ChVector<> GetBodyInertiaXY() const;
+
     /// Set the mass associated with translation of body
     void SetBodyMass(const double mmass);
 
@@ -15,6 +15,7 @@
 #include <cmath>
 
 #include "chrono/timestepper/ChTimestepper.h"
+#include "chrono/utils/ChProfiler.h"
 
 namespace chrono {
 
@@ -335,13 +336,17 @@ void ChTimestepperEulerImplicit::Advance(const double dt) {
     numsolves = 0;
 
     for (int i = 0; i < this->GetMaxiters(); ++i) {
+        CH_PROFILE("NewtonIteration");
         mintegrable->StateScatter(Xnew, Vnew, T + dt);  // state -> system
         R.setZero();
         Qc.setZero();
-        mintegrable->LoadResidual_F(R, dt);
-        mintegrable->LoadResidual_Mv(R, (V - Vnew), 1.0);
-        mintegrable->LoadResidual_CqL(R, L, dt);
-        mintegrable->LoadConstraint_C(Qc, 1.0 / dt, Qc_do_clamp, Qc_clamping);
+        {
+            CH_PROFILE("LoadResidual");
+            mintegrable->LoadResidual_F(R, dt);
+            mintegrable->LoadResidual_Mv(R, (V - Vnew), 1.0);
+            mintegrable->LoadResidual_CqL(R, L, dt);
+            mintegrable->LoadConstraint_C(Qc, 1.0 / dt, Qc_do_clamp, Qc_clamping);
+        }
 
         if (verbose)
             GetLog() << " Euler iteration=" << i << "  |R|=" << R.lpNorm<Eigen::Infinity>()
@@ -424,10 +429,13 @@ void ChTimestepperEulerImplicitLinearized::Advance(const double dt) {
     // [ M - dt*dF/dv - dt^2*dF/dx    Cq' ] [ v_new  ] = [ M*(v_old) + dt*f]
     // [ Cq                           0   ] [ -dt*l  ] = [ -C/dt - Ct ]
 
-    mintegrable->LoadResidual_F(R, dt);
-    mintegrable->LoadResidual_Mv(R, V, 1.0);
-    mintegrable->LoadConstraint_C(Qc, 1.0 / dt, Qc_do_clamp, Qc_clamping);
-    mintegrable->LoadConstraint_Ct(Qc, 1.0);
+    {
+        CH_PROFILE("LoadResidual");
+        mintegrable->LoadResidual_F(R, dt);
+        mintegrable->LoadResidual_Mv(R, V, 1.0);
+        mintegrable->LoadConstraint_C(Qc, 1.0 / dt, Qc_do_clamp, Qc_clamping);
+        mintegrable->LoadConstraint_Ct(Qc, 1.0);
+    }
 
     mintegrable->StateSolveCorrection(
         V, L, R, Qc,
@@ -486,10 +494,13 @@ void ChTimestepperEulerImplicitProjected::Advance(const double dt) {
     // [ M - dt*dF/dv - dt^2*dF/dx    Cq' ] [ v_new  ] = [ M*(v_old) + dt*f]
     // [ Cq                           0   ] [ -dt*l  ] = [ -Ct ]
 
-    mintegrable->LoadResidual_F(R, dt);
-    mintegrable->LoadResidual_Mv(R, V, 1.0);
-    mintegrable->LoadConstraint_C(Qc, 1.0 / dt, Qc_do_clamp, 0);  // may be avoided
-    mintegrable->LoadConstraint_Ct(Qc, 1.0);
+    {
+        CH_PROFILE("LoadResidual");
+        mintegrable->LoadResidual_F(R, dt);
+        mintegrable->LoadResidual_Mv(R, V, 1.0);
+        mintegrable->LoadConstraint_C(Qc, 1.0 / dt, Qc_do_clamp, 0);  // may be avoided
+        mintegrable->LoadConstraint_Ct(Qc, 1.0);
+    }
 
     mintegrable->StateSolveCorrection(
         V, L, R, Qc,
@@ -526,7 +537,10 @@ void ChTimestepperEulerImplicitProjected::Advance(const double dt) {
     // [ M       Cq' ] [ dpos ] = [  0 ]
     // [ Cq       0  ] [ l    ] = [ -C ]
 
-    mintegrable->LoadConstraint_C(Qc, 1.0, false, 0);
+    {
+        CH_PROFILE("LoadResidual");
+        mintegrable->LoadConstraint_C(Qc, 1.0, false, 0);
+    }
 
     mintegrable->StateSolveCorrection(
         Vold, L, R, Qc,
@@ -584,8 +598,11 @@ void ChTimestepperTrapezoidal::Advance(const double dt) {
     // [M-dt/2*dF/dv-dt^2/4*dF/dx  Cq'] [Dv      ] = [M*(v_old - v_new) + dt/2(f_old + f_new  + Cq*l_old + Cq*l_new)]
     // [Cq                          0 ] [-dt/2*Dl] = [-C/dt                                                         ]
 
-    mintegrable->LoadResidual_F(Rold, dt * 0.5);  // dt/2*f_old
-    mintegrable->LoadResidual_Mv(Rold, V, 1.0);   // M*v_old
+    {
+        CH_PROFILE("LoadResidual");
+        mintegrable->LoadResidual_F(Rold, dt * 0.5);  // dt/2*f_old
+        mintegrable->LoadResidual_Mv(Rold, V, 1.0);   // M*v_old
+    }
     // mintegrable->LoadResidual_CqL(Rold, L, dt*0.5); // dt/2*l_old   assume L_old = 0
 
     numiters = 0;
@@ -593,13 +610,17 @@ void ChTimestepperTrapezoidal::Advance(const double dt) {
     numsolves = 0;
 
     for (int i = 0; i < this->GetMaxiters(); ++i) {
+        CH_PROFILE("NewtonIteration");
         mintegrable->StateScatter(Xnew, Vnew, T + dt);  // state -> system
         R = Rold;
         Qc.setZero();
-        mintegrable->LoadResidual_F(R, dt * 0.5);                               // + dt/2*f_new
-        mintegrable->LoadResidual_Mv(R, Vnew, -1.0);                            // - M*v_new
-        mintegrable->LoadResidual_CqL(R, L, dt * 0.5);                          // + dt/2*Cq*l_new
-        mintegrable->LoadConstraint_C(Qc, 1.0 / dt, Qc_do_clamp, Qc_clamping);  // -C/dt
+        {
+            CH_PROFILE("LoadResidual");
+            mintegrable->LoadResidual_F(R, dt * 0.5);                               // + dt/2*f_new
+            mintegrable->LoadResidual_Mv(R, Vnew, -1.0);                            // - M*v_new
+            mintegrable->LoadResidual_CqL(R, L, dt * 0.5);                          // + dt/2*Cq*l_new
+            mintegrable->LoadConstraint_C(Qc, 1.0 / dt, Qc_do_clamp, Qc_clamping);  // -C/dt
+        }
 
         if (verbose)
             GetLog() << " Trapezoidal iteration=" << i << "  |R|=" << R.lpNorm<Eigen::Infinity>()
@@ -678,17 +699,23 @@ void ChTimestepperTrapezoidalLinearized::Advance(const double dt) {
     // [M-dt/2*dF/dv-dt^2/4*dF/dx  Cq'] [Dv      ] = [M*(v_old - v_new) + dt/2(f_old + f_new  + Cq*l_old + Cq*l_new)]
     // [Cq                          0 ] [-dt/2*Dl] = [-C/dt                                                         ]
 
-    mintegrable->LoadResidual_F(Rold, dt * 0.5);  // dt/2*f_old
-    mintegrable->LoadResidual_Mv(Rold, V, 1.0);   // M*v_old
+    {
+        CH_PROFILE("LoadResidual");
+        mintegrable->LoadResidual_F(Rold, dt * 0.5);  // dt/2*f_old
+        mintegrable->LoadResidual_Mv(Rold, V, 1.0);   // M*v_old
+    }
     // mintegrable->LoadResidual_CqL(Rold, L, dt*0.5); // dt/2*l_old  assume l_old = 0;
 
     mintegrable->StateScatter(Xnew, Vnew, T + dt);  // state -> system
     R = Rold;
     Qc.setZero();
-    mintegrable->LoadResidual_F(R, dt * 0.5);     // + dt/2*f_new
-    mintegrable->LoadResidual_Mv(R, Vnew, -1.0);  // - M*v_new
-    // mintegrable->LoadResidual_CqL(R, L, dt*0.5); // + dt/2*Cq*l_new  assume l_old = 0;
-    mintegrable->LoadConstraint_C(Qc, 1.0 / dt, Qc_do_clamp, Qc_clamping);  // -C/dt
+    {
+        CH_PROFILE("LoadResidual");
+        mintegrable->LoadResidual_F(R, dt * 0.5);     // + dt/2*f_new
+        mintegrable->LoadResidual_Mv(R, Vnew, -1.0);  // - M*v_new
+        // mintegrable->LoadResidual_CqL(R, L, dt*0.5); // + dt/2*Cq*l_new  assume l_old = 0;
+        mintegrable->LoadConstraint_C(Qc, 1.0 / dt, Qc_do_clamp, Qc_clamping);  // -C/dt
+    }
 
     mintegrable->StateSolveCorrection(
         Dv, Dl, R, Qc,
@@ -754,13 +781,19 @@ void ChTimestepperTrapezoidalLinearized2::Advance(const double dt) {
     // [ M - dt/2*dF/dv - dt^2/4*dF/dx    Cq' ] [ v_new    ] = [ M*(v_old) + dt/2(f_old + f_new)]
     // [ Cq                               0   ] [ -dt/2*L ] m= [ -C/dt                          ]
 
-    mintegrable->LoadResidual_F(R, dt * 0.5);  // dt/2*f_old
-    mintegrable->LoadResidual_Mv(R, V, 1.0);   // M*v_old
+    {
+        CH_PROFILE("LoadResidual");
+        mintegrable->LoadResidual_F(R, dt * 0.5);  // dt/2*f_old
+        mintegrable->LoadResidual_Mv(R, V, 1.0);   // M*v_old
+    }
 
     mintegrable->StateScatter(Xnew, Vnew, T + dt);  // state -> system
     Qc.setZero();
-    mintegrable->LoadResidual_F(R, dt * 0.5);                               // + dt/2*f_new
-    mintegrable->LoadConstraint_C(Qc, 1.0 / dt, Qc_do_clamp, Qc_clamping);  // -C/dt
+    {
+        CH_PROFILE("LoadResidual");
+        mintegrable->LoadResidual_F(R, dt * 0.5);                               // + dt/2*f_new
+        mintegrable->LoadConstraint_C(Qc, 1.0 / dt, Qc_do_clamp, Qc_clamping);  // -C/dt
+    }
 
     mintegrable->StateSolveCorrection(
         Vnew, L, R, Qc,
@@ -848,14 +881,18 @@ void ChTimestepperNewmark::Advance(const double dt) {
     numsolves = 0;
 
     for (int i = 0; i < this->GetMaxiters(); ++i) {
+        CH_PROFILE("NewtonIteration");
         mintegrable->StateScatter(Xnew, Vnew, T + dt);  // state -> system
 
         R.setZero(mintegrable->GetNcoords_v());
         Qc.setZero(mintegrable->GetNconstr());
-        mintegrable->LoadResidual_F(R, 1.0);                                                    //  f_new
-        mintegrable->LoadResidual_CqL(R, L, 1.0);                                               //   Cq'*l_new
-        mintegrable->LoadResidual_Mv(R, Anew, -1.0);                                            //  - M*a_new
-        mintegrable->LoadConstraint_C(Qc, (1.0 / (beta * dt * dt)), Qc_do_clamp, Qc_clamping);  //  - 1/(beta*dt^2)*C
+        {
+            CH_PROFILE("LoadResidual");
+            mintegrable->LoadResidual_F(R, 1.0);                                                   //  f_new
+            mintegrable->LoadResidual_CqL(R, L, 1.0);                                              //   Cq'*l_new
+            mintegrable->LoadResidual_Mv(R, Anew, -1.0);                                           //  - M*a_new
+            mintegrable->LoadConstraint_C(Qc, (1.0 / (beta * dt * dt)), Qc_do_clamp, Qc_clamping);  // - 1/(beta*dt^2)*C
+        }
 
         if (verbose)
             GetLog() << " Newmark iteration=" << i << "  |R|=" << R.lpNorm<Eigen::Infinity>()
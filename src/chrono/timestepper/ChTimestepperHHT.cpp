@@ -15,6 +15,7 @@
 #include <cmath>
 
 #include "chrono/timestepper/ChTimestepperHHT.h"
+#include "chrono/utils/ChProfiler.h"
 
 namespace chrono {
 
@@ -120,6 +121,7 @@ void ChTimestepperHHT::Advance(const double dt) {
         int it;
 
         for (it = 0; it < maxiters; it++) {
+            CH_PROFILE("NewtonIteration");
             if (verbose && modified_Newton && call_setup)
                 GetLog() << " HHT call Setup.\n";
 
@@ -252,8 +254,11 @@ void ChTimestepperHHT::Prepare(ChIntegrableIIorder* integrable, double scaling_f
                 Anew = A;
             Vnew = V + Anew * h;
             Xnew = X + Vnew * h + Anew * (h * h);
-            integrable->LoadResidual_F(Rold, -alpha / (1.0 + alpha));       // -alpha/(1.0+alpha) * f_old
-            integrable->LoadResidual_CqL(Rold, L, -alpha / (1.0 + alpha));  // -alpha/(1.0+alpha) * Cq'*l_old
+            {
+                CH_PROFILE("LoadResidual");
+                integrable->LoadResidual_F(Rold, -alpha / (1.0 + alpha));       // -alpha/(1.0+alpha) * f_old
+                integrable->LoadResidual_CqL(Rold, L, -alpha / (1.0 + alpha));  // -alpha/(1.0+alpha) * Cq'*l_old
+            }
             CalcErrorWeights(A, reltol, abstolS, ewtS);
             break;
         case POSITION:
@@ -261,9 +266,13 @@ void ChTimestepperHHT::Prepare(ChIntegrableIIorder* integrable, double scaling_f
             Xprev = X;
             Vnew = V * (-(gamma / beta - 1.0)) - A * (h * (gamma / (2.0 * beta) - 1.0));
             Anew = V * (-1.0 / (beta * h)) - A * (1.0 / (2.0 * beta) - 1.0);
-            integrable->LoadResidual_F(Rold, -(alpha / (1.0 + alpha)) * scaling_factor);  // -alpha/(1.0+alpha) * f_old
-            integrable->LoadResidual_CqL(Rold, L,
-                                         -(alpha / (1.0 + alpha)) * scaling_factor);  // -alpha/(1.0+alpha) * Cq'*l_old
+            {
+                CH_PROFILE("LoadResidual");
+                // -alpha/(1.0+alpha) * f_old
+                integrable->LoadResidual_F(Rold, -(alpha / (1.0 + alpha)) * scaling_factor);
+                // -alpha/(1.0+alpha) * Cq'*l_old
+                integrable->LoadResidual_CqL(Rold, L, -(alpha / (1.0 + alpha)) * scaling_factor);
+            }
             CalcErrorWeights(X, reltol, abstolS, ewtS);
             break;
     }
@@ -297,10 +306,13 @@ void ChTimestepperHHT::Increment(ChIntegrableIIorder* integrable, double scaling
     switch (mode) {
         case ACCELERATION:
             // Set up linear system
-            integrable->LoadResidual_F(R, 1.0);                                              //  f_new
-            integrable->LoadResidual_CqL(R, Lnew, 1.0);                                      //  Cq'*l_new
-            integrable->LoadResidual_Mv(R, Anew, -1 / (1 + alpha));                          // -1/(1+alpha)*M*a_new
-            integrable->LoadConstraint_C(Qc, 1 / (beta * h * h), Qc_do_clamp, Qc_clamping);  //  1/(beta*dt^2)*C
+            {
+                CH_PROFILE("LoadResidual");
+                integrable->LoadResidual_F(R, 1.0);                                              //  f_new
+                integrable->LoadResidual_CqL(R, Lnew, 1.0);                                      //  Cq'*l_new
+                integrable->LoadResidual_Mv(R, Anew, -1 / (1 + alpha));                          // -1/(1+alpha)*M*a_new
+                integrable->LoadConstraint_C(Qc, 1 / (beta * h * h), Qc_do_clamp, Qc_clamping);  //  1/(beta*dt^2)*C
+            }
 
             // Solve linear system
             integrable->StateSolveCorrection(Da, Dl, R, Qc,
@@ -322,10 +334,13 @@ void ChTimestepperHHT::Increment(ChIntegrableIIorder* integrable, double scaling
 
         case POSITION:
             // Set up linear system
-            integrable->LoadResidual_F(R, scaling_factor);                            //  f_new
-            integrable->LoadResidual_CqL(R, Lnew, scaling_factor);                    //  Cq'*l_new
-            integrable->LoadResidual_Mv(R, Anew, -1 / (1 + alpha) * scaling_factor);  // -1/(1+alpha)*M*a_new
-            integrable->LoadConstraint_C(Qc, 1.0, Qc_do_clamp, Qc_clamping);          //  1/(beta*dt^2)*C
+            {
+                CH_PROFILE("LoadResidual");
+                integrable->LoadResidual_F(R, scaling_factor);                            //  f_new
+                integrable->LoadResidual_CqL(R, Lnew, scaling_factor);                    //  Cq'*l_new
+                integrable->LoadResidual_Mv(R, Anew, -1 / (1 + alpha) * scaling_factor);  // -1/(1+alpha)*M*a_new
+                integrable->LoadConstraint_C(Qc, 1.0, Qc_do_clamp, Qc_clamping);          //  1/(beta*dt^2)*C
+            }
 
             // Solve linear system
             integrable->StateSolveCorrection(Da, Dl, R, Qc,
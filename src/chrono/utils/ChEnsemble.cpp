@@ -0,0 +1,84 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Ensemble of independent simulations, run concurrently on a pool of threads.
+//
+// =============================================================================
+
+#include <exception>
+
+#include "chrono/core/ChMathematics.h"
+#include "chrono/core/ChTimer.h"
+#include "chrono/utils/ChEnsemble.h"
+#include "chrono/utils/ChUtilsSamplers.h"
+
+namespace chrono {
+namespace utils {
+
+ChEnsemble::ChEnsemble() : m_num_threads(1), m_seed(1), m_run_time(0) {}
+
+void ChEnsemble::AddMember(std::shared_ptr<ChEnsembleMember> member) {
+    m_members.push_back(member);
+    m_errors.push_back(std::string());
+}
+
+int ChEnsemble::GetNumFailed() const {
+    int num_failed = 0;
+    for (const auto& error : m_errors) {
+        if (!error.empty())
+            num_failed++;
+    }
+    return num_failed;
+}
+
+void ChEnsemble::Run(double step, double end_time) {
+    ChTimer<double> timer;
+    timer.start();
+
+    int num_members = (int)m_members.size();
+
+    // Members are picked up one at a time, as threads become available (run times may differ widely)
+#pragma omp parallel for num_threads(m_num_threads) schedule(dynamic, 1)
+    for (int i = 0; i < num_members; i++) {
+        RunMember(i, step, end_time);
+    }
+
+    timer.stop();
+    m_run_time = timer();
+}
+
+void ChEnsemble::RunMember(int index, double step, double end_time) {
+    auto& member = m_members[index];
+    m_errors[index].clear();
+
+    // Seed the random engines of this thread (a zero Park-Miller seed is avoided)
+    unsigned int seed = GetMemberSeed(index);
+    ChSetRandomSeed(1 + (long)(seed % 2147483646u));
+    rengine().seed(seed);
+
+    try {
+        member->Initialize(index, seed);
+        while (member->GetSystem()->GetChTime() < end_time - 1e-3 * step && !member->Done()) {
+            member->Advance(step);
+        }
+        member->Finalize();
+    } catch (const std::exception& e) {
+        m_errors[index] = e.what();
+    } catch (...) {
+        m_errors[index] = "unknown exception";
+    }
+}
+
+}  // end namespace utils
+}  // end namespace chrono
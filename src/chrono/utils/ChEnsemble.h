@@ -0,0 +1,133 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Ensemble of independent simulations, run concurrently on a pool of threads.
+//
+// =============================================================================
+
+#ifndef CH_ENSEMBLE_H
+#define CH_ENSEMBLE_H
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "chrono/core/ChApiCE.h"
+#include "chrono/physics/ChSystem.h"
+
+namespace chrono {
+namespace utils {
+
+/// @addtogroup chrono_utils
+/// @{
+
+/// Base class for a member of an ensemble (one independent simulation run).
+/// A derived class constructs its own system in Initialize and stores its results in Finalize.
+class ChApi ChEnsembleMember {
+  public:
+    virtual ~ChEnsembleMember() {}
+
+    /// Construct the system of this member.
+    /// Called on the worker thread running this member, after the random engines of that thread
+    /// (ChRandom and utils::rengine) were seeded with the member seed.
+    virtual void Initialize(int index,         ///< index of this member in the ensemble
+                            unsigned int seed  ///< seed for this member
+                            ) = 0;
+
+    /// Return the system of this member (valid between Initialize and Finalize).
+    virtual ChSystem* GetSystem() = 0;
+
+    /// Advance the state of this member by the specified step.
+    /// The default implementation calls ChSystem::DoStepDynamics.
+    virtual void Advance(double step) { GetSystem()->DoStepDynamics(step); }
+
+    /// Return true to end the run of this member before the final time.
+    virtual bool Done() const { return false; }
+
+    /// Collect the results of this member, at the end of its run.
+    /// Called on the worker thread running this member. A member may release its system here,
+    /// to bound the memory used by large ensembles.
+    virtual void Finalize() {}
+};
+
+/// Ensemble of independent simulations.
+/// The members are distributed dynamically over a pool of OpenMP threads; each member is run from
+/// initialization to finalization on a single thread, so that the per-thread random engines are
+/// owned by that member for the duration of its run. With a given seed, the results of each member
+/// do not depend on the number of threads or on the order in which the members are run.
+/// Note that parallel regions within the member systems (see ChSystem::SetNumThreads) run serially
+/// when the ensemble uses more than one thread, since nested OpenMP parallelism is not enabled.
+/// Profiling zones (see ChProfileManager) are recorded only outside OpenMP parallel regions, so none are recorded
+/// while the members run on more than one thread.
+class ChApi ChEnsemble {
+  public:
+    ChEnsemble();
+
+    ~ChEnsemble() {}
+
+    /// Add a member to this ensemble.
+    void AddMember(std::shared_ptr<ChEnsembleMember> member);
+
+    /// Set the number of threads used to run the ensemble members (default: 1).
+    void SetNumThreads(int num_threads) { m_num_threads = std::max(1, num_threads); }
+
+    /// Set the base seed for the random engines (default: 1).
+    /// The member with index i is run with seed + i.
+    void SetSeed(unsigned int seed) { m_seed = seed; }
+
+    /// Run all ensemble members from their initial time to the specified final time.
+    /// An exception thrown by a member ends the run of that member only (see GetError).
+    void Run(double step,     ///< integration step size
+             double end_time  ///< final simulation time
+    );
+
+    /// Get the number of members in this ensemble.
+    int GetNumMembers() const { return (int)m_members.size(); }
+
+    /// Get the specified ensemble member.
+    std::shared_ptr<ChEnsembleMember> GetMember(int index) const { return m_members[index]; }
+
+    /// Get the seed used for the specified ensemble member.
+    unsigned int GetMemberSeed(int index) const { return m_seed + (unsigned int)index; }
+
+    /// Get the error message of the specified member (empty if its last run completed).
+    const std::string& GetError(int index) const { return m_errors[index]; }
+
+    /// Get the number of members whose last run ended with an exception.
+    int GetNumFailed() const;
+
+    /// Get the wall-clock time of the last call to Run (in seconds).
+    double GetRunTime() const { return m_run_time; }
+
+    /// Get the number of members run per second during the last call to Run.
+    double GetThroughput() const { return m_run_time > 0 ? m_members.size() / m_run_time : 0; }
+
+  private:
+    /// Run the specified member on the calling thread.
+    void RunMember(int index, double step, double end_time);
+
+    std::vector<std::shared_ptr<ChEnsembleMember>> m_members;  ///< ensemble members
+    std::vector<std::string> m_errors;                         ///< error messages from the last run
+    int m_num_threads;                                         ///< number of worker threads
+    unsigned int m_seed;                                       ///< base seed
+    double m_run_time;                                         ///< wall-clock time of the last run
+};
+
+/// @} chrono_utils
+
+}  // end namespace utils
+}  // end namespace chrono
+
+#endif
@@ -37,6 +37,14 @@ CODE MODIFIED FROM:
 #include <ratio>
 #include <chrono>
 #include <cstdio>
+#include <atomic>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace chrono {
 namespace utils {
@@ -45,6 +53,10 @@ namespace utils {
 
 static ChTimer<double> gProfileClock;
 
+// Thread on which profiling zones are recorded (see ChProfileManager::SetProfilingThread).
+// Unset (default-constructed id) until claimed by the first thread that advances a system.
+static std::atomic<std::thread::id> gProfileThread{std::thread::id()};
+
 #define mymin(a,b) (a > b ? a : b)
 
 inline void Profile_Get_Ticks(unsigned long int * ticks)
@@ -59,6 +71,46 @@ inline float Profile_Get_Tick_Rate(void)
 
 }
 
+// Trace recording (see ChProfileManager::EnableTrace).
+// All times are in microseconds since the trace was enabled.
+
+struct ChTraceZone {
+    const char* name;
+    double start;
+};
+
+struct ChTraceEvent {
+    const char* name;
+    double start;
+    double duration;
+};
+
+struct ChTraceCounter {
+    const char* name;
+    double time;
+    double value;
+};
+
+static ChTimer<double> gTraceClock;
+static std::vector<ChTraceZone> gTraceOpenZones;
+static std::vector<ChTraceEvent> gTraceEvents;
+static std::vector<ChTraceCounter> gTraceCounters;
+
+inline double Trace_Get_Time() {
+    return gTraceClock.GetTimeSecondsIntermediate() * 1e6;
+}
+
+// Write a string to a JSON file, escaping special characters.
+static void Write_JSON_String(std::ofstream& file, const char* str) {
+    file << '"';
+    for (const char* c = str; *c; c++) {
+        if (*c == '"' || *c == '\\')
+            file << '\\';
+        file << *c;
+    }
+    file << '"';
+}
+
 
 
 
@@ -230,6 +282,8 @@ void	ChProfileIterator::Enter_Parent( void )
 **
 ***************************************************************************************************/
 
+bool			ChProfileManager::Enabled = true;
+bool			ChProfileManager::TraceEnabled = false;
 ChProfileNode	ChProfileManager::Root( "Root", NULL );
 ChProfileNode *	ChProfileManager::CurrentNode = &ChProfileManager::Root;
 int				ChProfileManager::FrameCounter = 0;
@@ -256,6 +310,9 @@ void	ChProfileManager::Start_Profile( const char * name )
 	} 
 	
 	CurrentNode->Call();
+
+	if (TraceEnabled)
+		gTraceOpenZones.push_back({name, Trace_Get_Time()});
 }
 
 
@@ -269,6 +326,13 @@ void	ChProfileManager::Stop_Profile( void )
 	if (CurrentNode->Return()) {
 		CurrentNode = CurrentNode->Get_Parent();
 	}
+
+	// Zones opened before the trace was enabled are not recorded
+	if (TraceEnabled && !gTraceOpenZones.empty()) {
+		const ChTraceZone& zone = gTraceOpenZones.back();
+		gTraceEvents.push_back({zone.name, zone.start, Trace_Get_Time() - zone.start});
+		gTraceOpenZones.pop_back();
+	}
 }
 
 
@@ -368,6 +432,127 @@ void	ChProfileManager::dumpAll()
 	ChProfileManager::Release_Iterator(profileIterator);
 }
 
+void ChProfileManager::SetProfilingThread() {
+    gProfileThread = std::this_thread::get_id();
+}
+
+void ChProfileManager::ClaimProfilingThread() {
+    std::thread::id none;
+    gProfileThread.compare_exchange_strong(none, std::this_thread::get_id());
+}
+
+void ChProfileManager::ClearProfilingThread() {
+    gProfileThread = std::thread::id();
+}
+
+bool ChProfileManager::IsProfilingThread() {
+#ifdef _OPENMP
+    if (omp_in_parallel())
+        return false;
+#endif
+    return std::this_thread::get_id() == gProfileThread;
+}
+
+void ChProfileManager::EnableTrace(bool val) {
+    // A new trace (with its own clock) is started if there are no recorded events; otherwise, events are appended.
+    if (val && !TraceEnabled && gTraceEvents.empty() && gTraceCounters.empty()) {
+        gTraceClock.reset();
+        gTraceClock.start();
+    }
+    // Zones still open when toggling cannot be matched with their end, so they are not recorded.
+    gTraceOpenZones.clear();
+    TraceEnabled = val;
+}
+
+void ChProfileManager::ClearTrace() {
+    gTraceOpenZones.clear();
+    gTraceEvents.clear();
+    gTraceCounters.clear();
+    if (TraceEnabled) {
+        gTraceClock.reset();
+        gTraceClock.start();
+    }
+}
+
+size_t ChProfileManager::Get_Trace_Num_Events() {
+    return gTraceEvents.size();
+}
+
+void ChProfileManager::Record_Counter(const char* name, double value) {
+    if (TraceEnabled)
+        gTraceCounters.push_back({name, Trace_Get_Time(), value});
+}
+
+bool ChProfileManager::WriteChromeTrace(const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open())
+        return false;
+
+    file.precision(17);
+    file << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+    bool first = true;
+    for (const auto& event : gTraceEvents) {
+        file << (first ? "\n" : ",\n") << "{\"name\": ";
+        Write_JSON_String(file, event.name);
+        file << ", \"ph\": \"X\", \"pid\": 0, \"tid\": 0, \"ts\": " << event.start
+             << ", \"dur\": " << event.duration << "}";
+        first = false;
+    }
+    for (const auto& counter : gTraceCounters) {
+        file << (first ? "\n" : ",\n") << "{\"name\": ";
+        Write_JSON_String(file, counter.name);
+        file << ", \"ph\": \"C\", \"pid\": 0, \"tid\": 0, \"ts\": " << counter.time
+             << ", \"args\": {\"value\": " << counter.value << "}}";
+        first = false;
+    }
+    file << "\n]}\n";
+
+    if (!file.good())
+        return false;
+
+    // The written events are discarded (open zones are kept, so that they are recorded when closed)
+    gTraceEvents.clear();
+    gTraceCounters.clear();
+    return true;
+}
+
+// Write the given profile node and, recursively, its children.
+static void Write_JSON_Node(std::ofstream& file, ChProfileNode* node, int frames, int indent) {
+    std::string pad(indent, ' ');
+    file << pad << "{\"name\": ";
+    Write_JSON_String(file, node->Get_Name());
+    file << ", \"calls\": " << node->Get_Total_Calls() << ", \"time_ms\": " << node->Get_Total_Time()
+         << ", \"time_per_frame_ms\": " << (frames > 0 ? node->Get_Total_Time() / frames : 0.0)
+         << ", \"children\": [";
+    bool first = true;
+    for (ChProfileNode* child = node->Get_Child(); child; child = child->Get_Sibling()) {
+        file << (first ? "\n" : ",\n");
+        Write_JSON_Node(file, child, frames, indent + 2);
+        first = false;
+    }
+    if (!first)
+        file << "\n" << pad;
+    file << "]}";
+}
+
+bool ChProfileManager::WriteJSON(const std::string& filename) {
+    std::ofstream file(filename);
+    if (!file.is_open())
+        return false;
+
+    file << "{\"frames\": " << FrameCounter << ", \"time_since_reset_ms\": " << Get_Time_Since_Reset()
+         << ", \"zones\": [";
+    bool first = true;
+    for (ChProfileNode* child = Root.Get_Child(); child; child = child->Get_Sibling()) {
+        file << (first ? "\n" : ",\n");
+        Write_JSON_Node(file, child, FrameCounter, 2);
+        first = false;
+    }
+    file << "\n]}\n";
+
+    return file.good();
+}
+
 
 
 
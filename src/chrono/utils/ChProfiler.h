@@ -45,6 +45,7 @@ CODE MODIFIED FROM:
 #include <ctime>
 #include <ratio>
 #include <chrono>
+#include <string>
 #include "chrono/core/ChApiCE.h"
 
 namespace chrono {
@@ -148,7 +149,63 @@ public:
 
 	static void	dumpAll();
 
+    /// Enable/disable profiling at run time (default: true).
+    /// If disabled, profiling zones (see CH_PROFILE) and counters (see CH_PROFILE_COUNTER) have negligible overhead.
+    static void Enable(bool val) { Enabled = val; }
+
+    /// Return true if profiling is enabled.
+    static bool IsEnabled() { return Enabled; }
+
+    /// Make the calling thread the profiling thread.
+    /// The profile tree and the trace are not thread-safe: profiling zones and counters are recorded only when
+    /// opened on the profiling thread, outside active OpenMP parallel regions, and ignored otherwise.
+    /// IMPORTANT: by default, the profiling thread is the first thread that calls ChSystem::DoStepDynamics (see
+    /// ClaimProfilingThread). Until then, no zones are recorded. To profile code on another thread (or before the first
+    /// step), call this function from that thread.
+    static void SetProfilingThread();
+
+    /// Make the calling thread the profiling thread, unless a profiling thread is already set.
+    /// Called by ChSystem::DoStepDynamics.
+    static void ClaimProfilingThread();
+
+    /// Unset the profiling thread, so that the next thread calling ClaimProfilingThread becomes the profiling thread.
+    static void ClearProfilingThread();
+
+    /// Return true if profiling zones and counters are recorded on the calling thread (see SetProfilingThread).
+    static bool IsProfilingThread();
+
+    /// Enable/disable recording of individual zone events and counter samples (default: false).
+    /// Disabling the trace keeps the recorded events, until they are written (see WriteChromeTrace) or discarded (see
+    /// ClearTrace); enabling it again appends new events. A new trace, with times measured from the call to
+    /// EnableTrace, starts when no events are recorded. Note that memory use grows with the number of recorded events.
+    /// Only zones on the profiling thread are recorded (see SetProfilingThread).
+    static void EnableTrace(bool val);
+
+    /// Return true if trace recording is enabled.
+    static bool IsTraceEnabled() { return Enabled && TraceEnabled; }
+
+    /// Discard all recorded events and counter samples (and restart the trace clock, if recording).
+    static void ClearTrace();
+
+    /// Return the number of recorded zone events.
+    static size_t Get_Trace_Num_Events();
+
+    /// Record a sample of the named counter (e.g., number of contacts) at the current time.
+    /// As for profiling zones, the name is assumed to be a static string.
+    static void Record_Counter(const char* name, double value);
+
+    /// Write the recorded events and counter samples to a file in the Chrome trace event format (JSON).
+    /// The file can be loaded in chrome://tracing or in the Perfetto UI. The written events are then discarded.
+    /// Return false if the file cannot be written (in which case the recorded events are kept).
+    static bool WriteChromeTrace(const std::string& filename);
+
+    /// Write the profile tree (name, number of calls, total time, and time per frame for each zone) to a JSON file.
+    /// Return false if the file cannot be written.
+    static bool WriteJSON(const std::string& filename);
+
 private:
+	static	bool					Enabled;
+	static	bool					TraceEnabled;
 	static	ChProfileNode			Root;
 	static	ChProfileNode *			CurrentNode;
 	static	int						FrameCounter;
@@ -160,15 +217,20 @@ private:
 ///Use the BT_PROFILE macro at the start of scope to time
 class  ChApi  CProfileSample {
 public:
-	CProfileSample( const char * name )
+	CProfileSample( const char * name ) : active(ChProfileManager::IsEnabled() && ChProfileManager::IsProfilingThread())
 	{ 
-		ChProfileManager::Start_Profile( name ); 
+		if (active)
+			ChProfileManager::Start_Profile( name ); 
 	}
 
 	~CProfileSample( void )					
 	{ 
-		ChProfileManager::Stop_Profile(); 
+		if (active)
+			ChProfileManager::Stop_Profile(); 
 	}
+
+private:
+	bool active;  ///< profiling enabled when the zone was opened
 };
 
 
@@ -179,9 +241,17 @@ public:
 
 #define	CH_PROFILE( name )			chrono::utils::CProfileSample __ch_profile( name )
 
+#define CH_PROFILE_COUNTER(name, value)                                     \
+    do {                                                                    \
+        if (chrono::utils::ChProfileManager::IsTraceEnabled() &&            \
+            chrono::utils::ChProfileManager::IsProfilingThread())           \
+            chrono::utils::ChProfileManager::Record_Counter(name, value);   \
+    } while (0)
+
 #else
 
 #define	CH_PROFILE( name )
+#define CH_PROFILE_COUNTER(name, value) do {} while (0)
 
 #endif //#ifndef CH_NO_PROFILE
 
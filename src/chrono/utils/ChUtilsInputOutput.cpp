@@ -14,6 +14,9 @@
 //
 // =============================================================================
 
+#include <algorithm>
+#include <unordered_map>
+
 #include "chrono/assets/ChBoxShape.h"
 #include "chrono/assets/ChCapsuleShape.h"
 #include "chrono/assets/ChColorAsset.h"
@@ -27,9 +30,101 @@
 #include "chrono/assets/ChSphereShape.h"
 #include "chrono/assets/ChTriangleMeshShape.h"
 #include "chrono/geometry/ChLineBezier.h"
+#include "chrono/serialization/ChArchiveBinary.h"
 #include "chrono/utils/ChUtilsInputOutput.h"
 
 namespace chrono {
+
+// -----------------------------------------------------------------------------
+// Content of a binary checkpoint file (see WriteCheckpointBinary).
+// The counts of physics items and of state and constraint unknowns are used to
+// check that the checkpoint matches the system into which it is loaded.
+// -----------------------------------------------------------------------------
+namespace {
+class ChCheckpointBinaryData;
+}
+
+CH_CLASS_VERSION(ChCheckpointBinaryData, 1)
+
+namespace {
+
+class ChCheckpointBinaryData {
+  public:
+    ChCheckpointBinaryData()
+        : nbodies(0),
+          nlinks(0),
+          nphysicsitems(0),
+          ncoords(0),
+          ncoords_w(0),
+          nconstr(0),
+          nconstr_contact(0),
+          time(0),
+          contacts_saved(false) {}
+
+    void ArchiveOUT(ChArchiveOut& marchive) {
+        marchive.VersionWrite<ChCheckpointBinaryData>();
+        marchive << CHNVP(nbodies);
+        marchive << CHNVP(nlinks);
+        marchive << CHNVP(nphysicsitems);
+        marchive << CHNVP(ncoords);
+        marchive << CHNVP(ncoords_w);
+        marchive << CHNVP(nconstr);
+        marchive << CHNVP(nconstr_contact);
+        marchive << CHNVP(time);
+        marchive << CHNVP(x);
+        marchive << CHNVP(v);
+        marchive << CHNVP(a);
+        marchive << CHNVP(L);
+        marchive << CHNVP(body_frames);
+        marchive << CHNVP(contacts_saved);
+        marchive << CHNVP(contact_ids);
+        marchive << CHNVP(contact_geometry);
+    }
+
+    void ArchiveIN(ChArchiveIn& marchive) {
+        int version = marchive.VersionRead<ChCheckpointBinaryData>();
+        if (version != class_factory::ChClassVersion<ChCheckpointBinaryData>::version)
+            throw ChException("Unsupported binary checkpoint version: " + std::to_string(version));
+        marchive >> CHNVP(nbodies);
+        marchive >> CHNVP(nlinks);
+        marchive >> CHNVP(nphysicsitems);
+        marchive >> CHNVP(ncoords);
+        marchive >> CHNVP(ncoords_w);
+        marchive >> CHNVP(nconstr);
+        marchive >> CHNVP(nconstr_contact);
+        marchive >> CHNVP(time);
+        marchive >> CHNVP(x);
+        marchive >> CHNVP(v);
+        marchive >> CHNVP(a);
+        marchive >> CHNVP(L);
+        marchive >> CHNVP(body_frames);
+        marchive >> CHNVP(contacts_saved);
+        marchive >> CHNVP(contact_ids);
+        marchive >> CHNVP(contact_geometry);
+    }
+
+    int nbodies;
+    int nlinks;
+    int nphysicsitems;
+    int ncoords;
+    int ncoords_w;
+    int nconstr;
+    int nconstr_contact;
+    double time;
+    ChVectorDynamic<> x;
+    ChVectorDynamic<> v;
+    ChVectorDynamic<> a;
+    ChVectorDynamic<> L;
+    ChVectorDynamic<> body_frames;       // coordinates and their derivatives for each body (21 values per body)
+    bool contacts_saved;                 // were the contacts (and their reactions in L) saved?
+    std::vector<int> contact_ids;        // body and collision shape indices for each contact (4 values per contact)
+    ChVectorDynamic<> contact_geometry;  // points, normal, distance, and radius for each contact (11 values per contact)
+};
+
+}  // end anonymous namespace
+
+static const std::string checkpoint_binary_tag("CHRONO_CHECKPOINT");
+
 namespace utils {
 
 // -----------------------------------------------------------------------------
@@ -295,6 +390,215 @@ void ReadCheckpoint(ChSystem* system, const std::string& filename) {
     }
 }
 
+// -----------------------------------------------------------------------------
+// WriteCheckpointBinary
+//
+// Write a binary file with the state, accelerations, and reactions of all
+// physics items in the system, the body frames, and the current contacts, as
+// well as item counts used for validation. The system is not modified.
+// -----------------------------------------------------------------------------
+bool WriteCheckpointBinary(ChSystem* system, const std::string& filename) {
+    // The counts and offsets set in ChSystem::Setup must be up to date
+    const auto& bodies = system->Get_bodylist();
+    if (system->GetNbodiesTotal() != (int)bodies.size() || system->GetNlinks() > (int)system->Get_linklist().size()) {
+        std::cout << "utils::WriteCheckpointBinary ERROR: the system was modified since its last setup\n";
+        return false;
+    }
+
+    ChCheckpointBinaryData data;
+    data.nbodies = system->GetNbodiesTotal();
+    data.nlinks = system->GetNlinks();
+    data.nphysicsitems = system->GetNphysicsItems();
+    data.ncoords = system->GetNcoords_x();
+    data.ncoords_w = system->GetNcoords_w();
+    data.nconstr = system->GetNconstr();
+    data.nconstr_contact = system->GetContactContainer()->GetDOC();
+
+    ChState x(data.ncoords, system);
+    ChStateDelta v(data.ncoords_w, system);
+    ChStateDelta a(data.ncoords_w, system);
+    ChVectorDynamic<> L(data.nconstr);
+    system->StateGather(x, v, data.time);
+    system->StateGatherAcceleration(a);
+    system->StateGatherReactions(L);
+
+    // Bodies store the time derivatives of their rotation quaternion, rather than the angular velocity and
+    // acceleration used in the state vectors, so that a scatter/gather round trip is not exact. Save the body frames
+    // as stored, so that a restarted simulation continues exactly as this one.
+    data.body_frames.resize(21 * bodies.size());
+    for (size_t ib = 0; ib < bodies.size(); ib++) {
+        const ChCoordsys<>* frames[3] = {&bodies[ib]->GetCoord(), &bodies[ib]->GetCoord_dt(),
+                                         &bodies[ib]->GetCoord_dtdt()};
+        for (int k = 0; k < 3; k++) {
+            data.body_frames.segment(21 * ib + 7 * k, 3) = frames[k]->pos.eigen();
+            data.body_frames.segment(21 * ib + 7 * k + 3, 4) = frames[k]->rot.eigen();
+        }
+    }
+
+    // Save the contacts, identified by the indices of the two bodies and of their collision shapes. Contacts are
+    // saved only if all of them are between collision shapes of bodies in the system (otherwise, they are re-generated
+    // at the next step and their reactions are not restored).
+    std::vector<collision::ChCollisionInfo> cinfos;
+    data.contacts_saved = system->GetContactContainer()->GetContactsInfo(cinfos);
+    if (data.contacts_saved) {
+        std::unordered_map<collision::ChCollisionModel*, int> body_index;
+        for (size_t ib = 0; ib < bodies.size(); ib++)
+            body_index[bodies[ib]->GetCollisionModel().get()] = (int)ib;
+
+        data.contact_ids.reserve(4 * cinfos.size());
+        data.contact_geometry.resize(11 * cinfos.size());
+        for (size_t ic = 0; ic < cinfos.size() && data.contacts_saved; ic++) {
+            const auto& cinfo = cinfos[ic];
+            for (auto model_shape : {std::make_pair(cinfo.modelA, cinfo.shapeA),
+                                     std::make_pair(cinfo.modelB, cinfo.shapeB)}) {
+                auto ib = body_index.find(model_shape.first);
+                if (ib == body_index.end() || !model_shape.second) {
+                    data.contacts_saved = false;
+                    break;
+                }
+                const auto& shapes = model_shape.first->GetShapes();
+                auto is = std::find_if(shapes.begin(), shapes.end(),
+                                       [&](const std::shared_ptr<collision::ChCollisionShape>& shape) {
+                                           return shape.get() == model_shape.second;
+                                       });
+                if (is == shapes.end()) {
+                    data.contacts_saved = false;
+                    break;
+                }
+                data.contact_ids.push_back(ib->second);
+                data.contact_ids.push_back((int)(is - shapes.begin()));
+            }
+            data.contact_geometry.segment(11 * ic + 0, 3) = cinfo.vpA.eigen();
+            data.contact_geometry.segment(11 * ic + 3, 3) = cinfo.vpB.eigen();
+            data.contact_geometry.segment(11 * ic + 6, 3) = cinfo.vN.eigen();
+            data.contact_geometry(11 * ic + 9) = cinfo.distance;
+            data.contact_geometry(11 * ic + 10) = cinfo.eff_radius;
+        }
+        if (!data.contacts_saved) {
+            data.contact_ids.clear();
+            data.contact_geometry.resize(0);
+        }
+    }
+
+    data.x = x;
+    data.v = v;
+    data.a = a;
+    data.L = L;
+
+    try {
+        ChStreamOutBinaryFile mfile(filename.c_str());
+        ChArchiveOutBinary marchive(mfile);
+        marchive << make_ChNameValue("tag", checkpoint_binary_tag);
+        marchive << make_ChNameValue("checkpoint", data);
+    } catch (const ChException& e) {
+        std::cout << "utils::WriteCheckpointBinary ERROR: " << e.what() << "\n";
+        return false;
+    }
+
+    return true;
+}
+
+// -----------------------------------------------------------------------------
+// ReadCheckpointBinary
+//
+// Load a binary checkpoint file in an existing system, identical to the one
+// used to write the checkpoint.
+// -----------------------------------------------------------------------------
+void ReadCheckpointBinary(ChSystem* system, const std::string& filename) {
+    ChCheckpointBinaryData data;
+    {
+        ChStreamInBinaryFile mfile(filename.c_str());
+        ChArchiveInBinary marchive(mfile);
+        std::string tag;
+        marchive >> make_ChNameValue("tag", tag);
+        if (tag != checkpoint_binary_tag)
+            throw ChException("File " + filename + " is not a binary checkpoint");
+        marchive >> make_ChNameValue("checkpoint", data);
+    }
+
+    // Check consistency with the current system.
+    // Contacts are not part of the model, so only the constraints not owned by the contact container are compared.
+    system->Setup();
+    const auto& bodies = system->Get_bodylist();
+    int nbodies = system->GetNbodiesTotal();
+    int nconstr = system->GetNconstr() - system->GetContactContainer()->GetDOC();
+    if (data.nbodies != nbodies || data.nlinks != system->GetNlinks() ||
+        data.nphysicsitems != system->GetNphysicsItems() || data.ncoords != system->GetNcoords_x() ||
+        data.ncoords_w != system->GetNcoords_w() || data.nconstr - data.nconstr_contact != nconstr ||
+        data.x.size() != data.ncoords || data.v.size() != data.ncoords_w || data.a.size() != data.ncoords_w ||
+        data.L.size() != data.nconstr ||
+        data.body_frames.size() != 21 * (int)bodies.size() ||
+        data.contact_ids.size() != 4 * (size_t)data.contact_geometry.size() / 11) {
+        throw ChException("Binary checkpoint " + filename + " is inconsistent with the Chrono system");
+    }
+    for (size_t i = 0; i < data.contact_ids.size(); i += 2) {
+        int ib = data.contact_ids[i];
+        int is = data.contact_ids[i + 1];
+        if (ib < 0 || ib >= (int)bodies.size() || !bodies[ib]->GetCollisionModel() || is < 0 ||
+            is >= bodies[ib]->GetCollisionModel()->GetNumShapes()) {
+            throw ChException("Binary checkpoint " + filename + " is inconsistent with the Chrono system");
+        }
+    }
+
+    // Discard any existing contacts and load states and accelerations
+    system->GetContactContainer()->RemoveAllContacts();
+    system->Setup();
+
+    ChState x(data.ncoords, system);
+    ChStateDelta v(data.ncoords_w, system);
+    ChStateDelta a(data.ncoords_w, system);
+    x = data.x;
+    v = data.v;
+    a = data.a;
+    system->StateScatter(x, v, data.time);
+    system->StateScatterAcceleration(a);
+
+    // Restore the body frames exactly as stored when the checkpoint was written
+    for (size_t ib = 0; ib < bodies.size(); ib++) {
+        ChCoordsys<> frames[3];
+        for (int k = 0; k < 3; k++) {
+            frames[k].pos = ChVector<>(data.body_frames.segment(21 * ib + 7 * k, 3));
+            frames[k].rot = ChQuaternion<>(data.body_frames.segment(21 * ib + 7 * k + 3, 4));
+        }
+        bodies[ib]->SetCoord(frames[0]);
+        bodies[ib]->SetCoord_dt(frames[1]);
+        bodies[ib]->SetCoord_dtdt(frames[2]);
+    }
+    system->Update(false);
+
+    if (!data.contacts_saved) {
+        // Load reactions of all non-contact constraints (these come first in the system-level vector)
+        ChVectorDynamic<> L = data.L.head(nconstr);
+        system->StateScatterReactions(L);
+        return;
+    }
+
+    // Re-create the contacts, in the same order, and load the reactions of all constraints (including contacts)
+    auto container = system->GetContactContainer();
+    container->BeginAddContact();
+    for (size_t ic = 0; ic < data.contact_ids.size() / 4; ic++) {
+        collision::ChCollisionInfo cinfo;
+        cinfo.modelA = bodies[data.contact_ids[4 * ic + 0]]->GetCollisionModel().get();
+        cinfo.shapeA = cinfo.modelA->GetShape(data.contact_ids[4 * ic + 1]).get();
+        cinfo.modelB = bodies[data.contact_ids[4 * ic + 2]]->GetCollisionModel().get();
+        cinfo.shapeB = cinfo.modelB->GetShape(data.contact_ids[4 * ic + 3]).get();
+        cinfo.vpA = ChVector<>(data.contact_geometry.segment(11 * ic + 0, 3));
+        cinfo.vpB = ChVector<>(data.contact_geometry.segment(11 * ic + 3, 3));
+        cinfo.vN = ChVector<>(data.contact_geometry.segment(11 * ic + 6, 3));
+        cinfo.distance = data.contact_geometry(11 * ic + 9);
+        cinfo.eff_radius = data.contact_geometry(11 * ic + 10);
+        container->AddContact(cinfo);
+    }
+    container->EndAddContact();
+
+    system->Setup();
+    if (system->GetNconstr() != data.nconstr)
+        throw ChException("Binary checkpoint " + filename + ": contacts could not be re-created");
+
+    ChVectorDynamic<> L = data.L;
+    system->StateScatterReactions(L);
+}
+
 // -----------------------------------------------------------------------------
 // WriteShapesPovray
 //
@@ -25,6 +25,21 @@
 //      contact geometry.
 //    - only a subset of contact shapes are currently supported
 //
+// WriteCheckpointBinary and ReadCheckpointBinary
+//  these functions write and read, respectively, a versioned binary file with
+//  the complete dynamic state of an existing system (restart file).
+//  Limitations:
+//    - the model itself is not saved; the system must be re-created identically
+//      before reading the checkpoint.
+//    - contact state is restored for NSC systems only: contacts (with their
+//      reactions) are saved only if the contact container is ChContactContainerNSC
+//      and all contacts are between collision shapes of bodies. Otherwise (e.g.
+//      for SMC systems), contacts are re-generated from the collision geometry at
+//      the next step, and their history (e.g. tangential displacements) is lost.
+//    - reaction caches kept by the collision system are not saved; for an exact
+//      restart with warm starting, enable persistent contacts in the NSC contact
+//      container (see ChContactContainerNSC::SetPersistentContacts).
+//
 // WriteShapesPovray
 //  this function writes a CSV file appropriate for processing with a POV-Ray
 //  script.
@@ -144,6 +159,26 @@ bool WriteCheckpoint(ChSystem* system, const std::string& filename);
 ChApi
 void ReadCheckpoint(ChSystem* system, const std::string& filename);
 
+/// Write a binary checkpoint with the current state of the given system.
+/// The file contains the system time, the state (positions and velocities), the accelerations and the constraint
+/// reactions of all physics items, as gathered through the ChSystem state interface, the body frames as stored, and
+/// the current contacts (NSC systems only, and only if all contacts are between bodies). The model is not saved: to
+/// restart, re-create the same system and call ReadCheckpointBinary. The system is not modified; it must be set up
+/// (as after any simulation step). Return false if the system was modified since its last setup or if the file
+/// cannot be written.
+ChApi
+bool WriteCheckpointBinary(ChSystem* system, const std::string& filename);
+
+/// Load a binary checkpoint (written with WriteCheckpointBinary) into the given system.
+/// The system must have been created with the same physics items, in the same order, as the one used to write the
+/// checkpoint. Saved contacts are re-created, so that the reactions of all constraints (including contacts, used to
+/// warm start iterative solvers) are restored. Contact state is restored for NSC systems only; SMC contacts are
+/// re-generated at the next step.
+/// An exception is thrown if the file cannot be read, if its format version is not supported, or if it is
+/// inconsistent with the given system.
+ChApi
+void ReadCheckpointBinary(ChSystem* system, const std::string& filename);
+
 /// Write CSV output file for PovRay.
 /// Each line contains information about one visualization asset shape, as follows:
 /// <pre>
@@ -46,13 +46,15 @@ namespace chrono {
 namespace utils {
 
 // -----------------------------------------------------------------------------
-// Construct a single random engine (on first use)
+// Construct a random engine for the calling thread (on first use)
 //
-// Note that this object is never destructed (but this is OK)
+// Each thread has its own engine, so that samplers and generators can be used
+// concurrently (e.g., by the members of a ChEnsemble). Seed it with
+// rengine().seed(...) on the thread that uses it.
 // -----------------------------------------------------------------------------
 inline std::default_random_engine& rengine() {
-    static std::default_random_engine* re = new std::default_random_engine;
-    return *re;
+    static thread_local std::default_random_engine re;
+    return re;
 }
 
 // -----------------------------------------------------------------------------
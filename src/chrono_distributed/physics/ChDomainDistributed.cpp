@@ -22,6 +22,7 @@
 
 #include <mpi.h>
 #include <stdlib.h>
+#include <algorithm>
 #include <iostream>
 #include <memory>
 
@@ -32,6 +33,8 @@ ChDomainDistributed::ChDomainDistributed(ChSystemDistributed* sys) {
     split_axis = 0;
     split = false;
     axis_set = false;
+    balance_interval = 0;
+    max_shift_fraction = 0.5;
 }
 
 ChDomainDistributed::~ChDomainDistributed() {}
@@ -69,26 +72,104 @@ void ChDomainDistributed::SetSimDomain(double xlo, double xhi, double ylo, doubl
 }
 
 void ChDomainDistributed::SplitDomain() {
-    // Length of this subdomain along the long axis
-    double sub_len = (boxhi[split_axis] - boxlo[split_axis]) / my_sys->num_ranks;
+    int num_ranks = my_sys->num_ranks;
+
+    // Length of each subdomain along the long axis
+    double sub_len = (boxhi[split_axis] - boxlo[split_axis]) / num_ranks;
 
+    split_points.resize(num_ranks + 1);
+    for (int i = 0; i < num_ranks; i++)
+        split_points[i] = boxlo[split_axis] + i * sub_len;
+    split_points[num_ranks] = boxhi[split_axis];
+
+    SetSubDomain();
+    split = true;
+}
+
+void ChDomainDistributed::SetSubDomain() {
+    int my_rank = my_sys->my_rank;
     for (int i = 0; i < 3; i++) {
         if (split_axis == i) {
-            sublo[i] = boxlo[i] + my_sys->my_rank * sub_len;
-            subhi[i] = sublo[i] + sub_len;
+            sublo[i] = split_points[my_rank];
+            subhi[i] = split_points[my_rank + 1];
         } else {
             sublo[i] = boxlo[i];
             subhi[i] = boxhi[i];
         }
     }
-    split = true;
 }
 
 int ChDomainDistributed::GetRank(ChVector<double> pos) {
-    double sub_len = subhi[split_axis] - sublo[split_axis];
-    double pt = pos[split_axis] - boxlo[split_axis];
+    // First interior boundary above the position
+    auto it = std::upper_bound(split_points.begin() + 1, split_points.end() - 1, pos[split_axis]);
+    return (int)(it - split_points.begin()) - 1;
+}
+
+void ChDomainDistributed::SetBalanceInterval(int interval, double max_shift_fraction) {
+    balance_interval = std::max(interval, 0);
+    this->max_shift_fraction = std::min(std::max(max_shift_fraction, 0.0), 1.0);
+}
+
+void ChDomainDistributed::Rebalance() {
+    assert(split);
+    int num_ranks = my_sys->num_ranks;
+    if (num_ranks == 1)
+        return;
+
+    // Load of this rank: bodies simulated here (including ghosts) and contacts
+    double load = (double)my_sys->data_manager->num_rigid_contacts;
+    for (auto status : my_sys->ddm->comm_status) {
+        if (status != distributed::EMPTY && status != distributed::GLOBAL)
+            load += 1;
+    }
+
+    std::vector<double> loads(num_ranks);
+    MPI_Allgather(&load, 1, MPI_DOUBLE, loads.data(), 1, MPI_DOUBLE, my_sys->world);
+
+    double ghost_layer = my_sys->GetGhostLayer();
+    split_points = BalanceSplitPoints(split_points, loads, max_shift_fraction * ghost_layer, 2 * ghost_layer);
+    SetSubDomain();
+}
+
+std::vector<double> ChDomainDistributed::BalanceSplitPoints(const std::vector<double>& split_points,
+                                                            const std::vector<double>& loads,
+                                                            double max_shift,
+                                                            double min_length) {
+    int num_ranks = (int)loads.size();
+    std::vector<double> points(split_points);
+
+    double total = 0;
+    for (auto l : loads)
+        total += l;
+    if (total <= 0)
+        return points;
+
+    // Cumulative load at the current boundaries
+    std::vector<double> cumulative(num_ranks + 1, 0.0);
+    for (int i = 0; i < num_ranks; i++)
+        cumulative[i + 1] = cumulative[i] + loads[i];
+
+    double hi = split_points[num_ranks];
+    int k = 0;
+    for (int i = 1; i < num_ranks; i++) {
+        // Position where the cumulative load, interpolated linearly within each sub-domain, reaches i/num_ranks
+        double target = total * i / num_ranks;
+        while (k < num_ranks - 1 && cumulative[k + 1] < target)
+            k++;
+        double alpha = loads[k] > 0 ? (target - cumulative[k]) / loads[k] : 0.5;
+        alpha = std::min(std::max(alpha, 0.0), 1.0);
+        double x = split_points[k] + alpha * (split_points[k + 1] - split_points[k]);
+
+        // Limit the displacement and keep room for the sub-domains on both sides
+        double lower = std::max(split_points[i] - max_shift, points[i - 1] + min_length);
+        double upper = std::min(split_points[i] + max_shift, hi - (num_ranks - i) * min_length);
+        if (lower > upper)
+            points[i] = split_points[i];
+        else
+            points[i] = std::min(std::max(x, lower), upper);
+    }
 
-    return (int)(pt / sub_len);
+    return points;
 }
 
 distributed::COMM_STATUS ChDomainDistributed::GetRegion(double pos) {
@@ -15,6 +15,7 @@
 #pragma once
 
 #include <memory>
+#include <vector>
 
 #include "chrono/core/ChVector.h"
 #include "chrono/physics/ChBody.h"
@@ -31,7 +32,11 @@ class ChSystemDistributed;
 /// @{
 
 /// This class maps sub-domains of the global simulation domain to each MPI rank.
-/// The global domain is split along the longest axis.
+/// The global domain is split along the longest axis into slabs, initially of equal length.
+/// Only this one-dimensional (slab) decomposition is supported: the communication protocol in ChCommDistributed
+/// assumes exactly two neighbors (up and down) per rank along the split axis.
+/// If load balancing is enabled (see SetBalanceInterval), the slab boundaries are periodically moved
+/// so as to equalize the measured load (number of bodies and contacts) of the ranks.
 /// Within each sub-domain, there are layers of ownership:
 ///
 ///
@@ -142,6 +147,33 @@ class CH_DISTR_API ChDomainDistributed {
     /// Returns true if the domain has been set.
     bool IsSplit() { return split; }
 
+    /// Return the positions of the sub-domain boundaries along the split axis (num_ranks + 1 values).
+    const std::vector<double>& GetSplitPoints() const { return split_points; }
+
+    /// Enable dynamic load balancing, performed every 'interval' steps (default: 0, disabled).
+    /// At each rebalancing, all ranks exchange their load (number of bodies and contacts) and the sub-domain
+    /// boundaries are moved towards an equal load distribution. A boundary moves by at most max_shift_fraction times
+    /// the ghost layer per rebalancing, so that no body crosses more than one region of the sub-domain at once, and
+    /// sub-domains are kept at least two ghost layers long.
+    /// NOTE: Fixed bodies are only added to the ranks they overlap at creation; with load balancing, fixed
+    /// bodies spanning multiple sub-domains should be added with ChSystemDistributed::AddBodyAllRanks.
+    void SetBalanceInterval(int interval, double max_shift_fraction = 0.5);
+
+    /// Return the number of steps between two load balancing operations (0 if disabled).
+    int GetBalanceInterval() const { return balance_interval; }
+
+    /// Move the sub-domain boundaries based on the current load of each rank.
+    /// Must be called on all ranks. Bodies are migrated at the next call to ChCommDistributed::Exchange.
+    virtual void Rebalance();
+
+    /// Compute new sub-domain boundaries from the current ones and the load of each sub-domain, assuming a uniform
+    /// load density within each sub-domain. Each interior boundary moves by at most max_shift, and all sub-domains
+    /// are kept at least min_length long (if the current ones are).
+    static std::vector<double> BalanceSplitPoints(const std::vector<double>& split_points,
+                                                  const std::vector<double>& loads,
+                                                  double max_shift,
+                                                  double min_length);
+
     /// Prints basic information about the domain decomposition
     virtual void PrintDomain();
 
@@ -162,7 +194,14 @@ class CH_DISTR_API ChDomainDistributed {
     bool split;     ///< Flag indicating that the domain has been divided into sub-domains.
     bool axis_set;  ///< Flag indicating that the splitting axis has been set.
 
+    std::vector<double> split_points;  ///< Boundaries of all sub-domains along the split axis
+    int balance_interval;              ///< Number of steps between load balancing operations (0: disabled)
+    double max_shift_fraction;         ///< Maximum boundary displacement per rebalancing, relative to the ghost layer
+
   private:
+    /// Set the local sub-domain from the split points.
+    void SetSubDomain();
+
     /// Helper function that is called by the public GetRegion methods to get
     /// the region classification for a body based on the center position.
     distributed::COMM_STATUS GetRegion(double pos);
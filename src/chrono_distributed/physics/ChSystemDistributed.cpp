@@ -54,7 +54,7 @@ static void PrintNode(LocalShapeNode* node) {
 }
 
 ChSystemDistributed::ChSystemDistributed(MPI_Comm communicator, double ghostlayer, unsigned int maxobjects)
-    : ghost_layer(ghostlayer), master_rank(0), num_bodies_global(0) {
+    : ghost_layer(ghostlayer), master_rank(0), num_bodies_global(0), steps_since_balance(0) {
     MPI_Comm_dup(communicator, &world);
     MPI_Comm_size(world, &num_ranks);
     MPI_Comm_rank(world, &my_rank);
@@ -128,6 +128,12 @@ bool ChSystemDistributed::Integrate_Y() {
     bool ret = ChSystemParallelSMC::Integrate_Y();
     if (num_ranks != 1) {
         data_manager->system_timer.start("Exchange");
+        // Move the sub-domain boundaries first, so that the exchange migrates the affected bodies
+        int interval = domain->GetBalanceInterval();
+        if (interval > 0 && ++steps_since_balance >= interval) {
+            domain->Rebalance();
+            steps_since_balance = 0;
+        }
         comm->Exchange();
         data_manager->system_timer.stop("Exchange");
     }
@@ -230,6 +230,9 @@ class CH_DISTR_API ChSystemDistributed : public ChSystemParallelSMC {
     /// unique global IDs
     unsigned int num_bodies_global;
 
+    /// Number of steps since the last load balancing of the sub-domains
+    int steps_since_balance;
+
     /// Communicator of MPI ranks for the simulation
     MPI_Comm world;
 
@@ -17,6 +17,7 @@
 
 #ifndef CH_FSI_DATAMANAGER_H_
 #define CH_FSI_DATAMANAGER_H_
+#include "chrono_fsi/ChConfigFSI.h"  // must precede thrust headers (device system selection)
 #include <thrust/device_vector.h>
 #include <thrust/host_vector.h>
 #include <thrust/iterator/detail/normal_iterator.h>
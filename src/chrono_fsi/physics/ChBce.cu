@@ -34,18 +34,25 @@ __device__ double atomicAdd(double* address, double val) {
 
     return __longlong_as_double(old);
 }
+
+// atomic add shared by the CUDA kernels and the CPU (OpenMP) backend
+__host__ __device__ inline void bceAtomicAdd(double* address, double val) {
+#ifdef __CUDA_ARCH__
+    atomicAdd(address, val);
+#else
+#pragma omp atomic
+    *address += val;
+#endif
+}
 //--------------------------------------------------------------------------------------------------------------------------------
-__global__ void Populate_RigidSPH_MeshPos_LRF_kernel(Real3* rigidSPH_MeshPos_LRF_D,
-                                                     Real4* posRadD,
-                                                     uint* rigidIdentifierD,
-                                                     Real3* posRigidD,
-                                                     Real4* qD) {
-    uint index = blockIdx.x * blockDim.x + threadIdx.x;
-    if (index >= numObjectsD.numRigid_SphMarkers) {
-        return;
-    }
+__host__ __device__ inline void Populate_RigidSPH_MeshPos_LRF_kernel_marker(uint index,
+                                                                            Real3* rigidSPH_MeshPos_LRF_D,
+                                                                            Real4* posRadD,
+                                                                            uint* rigidIdentifierD,
+                                                                            Real3* posRigidD,
+                                                                            Real4* qD) {
     int rigidIndex = rigidIdentifierD[index];
-    uint rigidMarkerIndex = index + numObjectsD.startRigidMarkers;  // updatePortion = [start, end]
+    uint rigidMarkerIndex = index + NumObjects().startRigidMarkers;  // updatePortion = [start, end]
                                                                     // index of the update portion
     Real4 q4 = qD[rigidIndex];
     Real3 a1, a2, a3;
@@ -55,24 +62,34 @@ __global__ void Populate_RigidSPH_MeshPos_LRF_kernel(Real3* rigidSPH_MeshPos_LRF
     rigidSPH_MeshPos_LRF_D[index] = dist3LF;
 }
 
-//--------------------------------------------------------------------------------------------------------------------------------
-__global__ void Populate_FlexSPH_MeshPos_LRF_kernel(Real3* FlexSPH_MeshPos_LRF_D,
-                                                    Real3* FlexSPH_MeshPos_LRF_H,
-                                                    Real4* posRadD,
-                                                    uint* FlexIdentifierD,
-                                                    const int numFlex1D,
-                                                    uint2* CableElementsNodes,
-                                                    uint4* ShellElementsNodes,
-                                                    Real3* pos_fsi_fea_D,
-                                                    Real Spacing) {
+__global__ void Populate_RigidSPH_MeshPos_LRF_kernel(Real3* rigidSPH_MeshPos_LRF_D,
+                                                     Real4* posRadD,
+                                                     uint* rigidIdentifierD,
+                                                     Real3* posRigidD,
+                                                     Real4* qD) {
     uint index = blockIdx.x * blockDim.x + threadIdx.x;
-    if (index >= numObjectsD.numFlex_SphMarkers) {
+    if (index >= NumObjects().numRigid_SphMarkers) {
         return;
     }
-    //  int numFlexSphMarkers = numObjectsD.numFlex_SphMarkers;
+    Populate_RigidSPH_MeshPos_LRF_kernel_marker(index, rigidSPH_MeshPos_LRF_D, posRadD, rigidIdentifierD, posRigidD,
+                                                qD);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+__host__ __device__ inline void Populate_FlexSPH_MeshPos_LRF_kernel_marker(uint index,
+                                                                           Real3* FlexSPH_MeshPos_LRF_D,
+                                                                           Real3* FlexSPH_MeshPos_LRF_H,
+                                                                           Real4* posRadD,
+                                                                           uint* FlexIdentifierD,
+                                                                           const int numFlex1D,
+                                                                           uint2* CableElementsNodes,
+                                                                           uint4* ShellElementsNodes,
+                                                                           Real3* pos_fsi_fea_D,
+                                                                           Real Spacing) {
+    //  int numFlexSphMarkers = NumObjects().numFlex_SphMarkers;
 
     int FlexIndex = FlexIdentifierD[index];
-    uint FlexMarkerIndex = index + numObjectsD.startFlexMarkers;  // updatePortion = [start, end]
+    uint FlexMarkerIndex = index + NumObjects().startFlexMarkers;  // updatePortion = [start, end]
     //  printf("FlexInd ex=%d, FlexMarkerIndex=%d\n", FlexIndex, FlexMarkerIndex);
 
     if (FlexIndex < numFlex1D) {
@@ -177,26 +194,41 @@ __global__ void Populate_FlexSPH_MeshPos_LRF_kernel(Real3* FlexSPH_MeshPos_LRF_D
         //               FlexSPH_MeshPos_LRF_D[index].z);
     }
 }
-//--------------------------------------------------------------------------------------------------------------------------------
-__global__ void Calc_Flex_FSI_ForcesD(Real3* FlexSPH_MeshPos_LRF_D,
-                                      uint* FlexIdentifierD,
-                                      const int numFlex1D,
-                                      uint2* CableElementsNodes,  // This is the connectivity of FEA mesh.
-                                      uint4* ShellElementsNodes,  // This is the connectivity of FEA mesh.
-                                      Real4* derivVelRhoD,
-                                      Real4* derivVelRhoD_old,
-                                      Real3* pos_fsi_fea_D,
-                                      Real3* Flex_FSI_ForcesD) {
+
+__global__ void Populate_FlexSPH_MeshPos_LRF_kernel(Real3* FlexSPH_MeshPos_LRF_D,
+                                                    Real3* FlexSPH_MeshPos_LRF_H,
+                                                    Real4* posRadD,
+                                                    uint* FlexIdentifierD,
+                                                    const int numFlex1D,
+                                                    uint2* CableElementsNodes,
+                                                    uint4* ShellElementsNodes,
+                                                    Real3* pos_fsi_fea_D,
+                                                    Real Spacing) {
     uint index = blockIdx.x * blockDim.x + threadIdx.x;
-    if (index >= numObjectsD.numFlex_SphMarkers) {
+    if (index >= NumObjects().numFlex_SphMarkers) {
         return;
     }
-    //  int numFlexSphMarkers = numObjectsD.numFlex_SphMarkers;
+    Populate_FlexSPH_MeshPos_LRF_kernel_marker(index, FlexSPH_MeshPos_LRF_D, FlexSPH_MeshPos_LRF_H, posRadD,
+                                               FlexIdentifierD, numFlex1D, CableElementsNodes, ShellElementsNodes,
+                                               pos_fsi_fea_D, Spacing);
+}
+//--------------------------------------------------------------------------------------------------------------------------------
+__host__ __device__ inline void Calc_Flex_FSI_ForcesD_marker(uint index,
+                                                             Real3* FlexSPH_MeshPos_LRF_D,
+                                                             uint* FlexIdentifierD,
+                                                             const int numFlex1D,
+                                                             uint2* CableElementsNodes,
+                                                             uint4* ShellElementsNodes,
+                                                             Real4* derivVelRhoD,
+                                                             Real4* derivVelRhoD_old,
+                                                             Real3* pos_fsi_fea_D,
+                                                             Real3* Flex_FSI_ForcesD) {
+    //  int numFlexSphMarkers = NumObjects().numFlex_SphMarkers;
 
     int FlexIndex = FlexIdentifierD[index];
-    uint FlexMarkerIndex = index + numObjectsD.startFlexMarkers;  // updatePortion = [start, end]
+    uint FlexMarkerIndex = index + NumObjects().startFlexMarkers;  // updatePortion = [start, end]
     derivVelRhoD[FlexMarkerIndex] =
-        derivVelRhoD[FlexMarkerIndex] * paramsD.Beta + derivVelRhoD_old[FlexMarkerIndex] * (1 - paramsD.Beta);
+        derivVelRhoD[FlexMarkerIndex] * Params().Beta + derivVelRhoD_old[FlexMarkerIndex] * (1 - Params().Beta);
     if (FlexIndex < numFlex1D) {
         Real2 N_cable = Cables_ShapeFunctions(FlexSPH_MeshPos_LRF_D[index].x);
         Real NA = N_cable.x;
@@ -208,13 +240,13 @@ __global__ void Calc_Flex_FSI_ForcesD(Real3* FlexSPH_MeshPos_LRF_D,
         //        FlexMarkerIndex,
         //               FlexIndex, nA, nB, FlexSPH_MeshPos_LRF_D[index].x, index, NA, NB);
 
-        atomicAdd(&(Flex_FSI_ForcesD[nA].x), NA * (double)derivVelRhoD[FlexMarkerIndex].x);
-        atomicAdd(&(Flex_FSI_ForcesD[nA].y), NA * (double)derivVelRhoD[FlexMarkerIndex].y);
-        atomicAdd(&(Flex_FSI_ForcesD[nA].z), NA * (double)derivVelRhoD[FlexMarkerIndex].z);
+        bceAtomicAdd(&(Flex_FSI_ForcesD[nA].x), NA * (double)derivVelRhoD[FlexMarkerIndex].x);
+        bceAtomicAdd(&(Flex_FSI_ForcesD[nA].y), NA * (double)derivVelRhoD[FlexMarkerIndex].y);
+        bceAtomicAdd(&(Flex_FSI_ForcesD[nA].z), NA * (double)derivVelRhoD[FlexMarkerIndex].z);
 
-        atomicAdd(&(Flex_FSI_ForcesD[nB].x), NB * (double)derivVelRhoD[FlexMarkerIndex].x);
-        atomicAdd(&(Flex_FSI_ForcesD[nB].y), NB * (double)derivVelRhoD[FlexMarkerIndex].y);
-        atomicAdd(&(Flex_FSI_ForcesD[nB].z), NB * (double)derivVelRhoD[FlexMarkerIndex].z);
+        bceAtomicAdd(&(Flex_FSI_ForcesD[nB].x), NB * (double)derivVelRhoD[FlexMarkerIndex].x);
+        bceAtomicAdd(&(Flex_FSI_ForcesD[nB].y), NB * (double)derivVelRhoD[FlexMarkerIndex].y);
+        bceAtomicAdd(&(Flex_FSI_ForcesD[nB].z), NB * (double)derivVelRhoD[FlexMarkerIndex].z);
     }
     if (FlexIndex >= numFlex1D) {
         Real4 N_shell = Shells_ShapeFunctions(FlexSPH_MeshPos_LRF_D[index].x, FlexSPH_MeshPos_LRF_D[index].y);
@@ -234,40 +266,57 @@ __global__ void Calc_Flex_FSI_ForcesD(Real3* FlexSPH_MeshPos_LRF_D,
         //            FlexMarkerIndex, FlexIndex, nA, nB, nC, nD, N_shell.x, N_shell.y, N_shell.z, N_shell.w,
         //            FlexSPH_MeshPos_LRF_D[index].x, FlexSPH_MeshPos_LRF_D[index].y);
 
-        atomicAdd(&(Flex_FSI_ForcesD[nA].x), NA * (double)derivVelRhoD[FlexMarkerIndex].x);
-        atomicAdd(&(Flex_FSI_ForcesD[nA].y), NA * (double)derivVelRhoD[FlexMarkerIndex].y);
-        atomicAdd(&(Flex_FSI_ForcesD[nA].z), NA * (double)derivVelRhoD[FlexMarkerIndex].z);
+        bceAtomicAdd(&(Flex_FSI_ForcesD[nA].x), NA * (double)derivVelRhoD[FlexMarkerIndex].x);
+        bceAtomicAdd(&(Flex_FSI_ForcesD[nA].y), NA * (double)derivVelRhoD[FlexMarkerIndex].y);
+        bceAtomicAdd(&(Flex_FSI_ForcesD[nA].z), NA * (double)derivVelRhoD[FlexMarkerIndex].z);
 
-        atomicAdd(&(Flex_FSI_ForcesD[nB].x), NB * (double)derivVelRhoD[FlexMarkerIndex].x);
-        atomicAdd(&(Flex_FSI_ForcesD[nB].y), NB * (double)derivVelRhoD[FlexMarkerIndex].y);
-        atomicAdd(&(Flex_FSI_ForcesD[nB].z), NB * (double)derivVelRhoD[FlexMarkerIndex].z);
+        bceAtomicAdd(&(Flex_FSI_ForcesD[nB].x), NB * (double)derivVelRhoD[FlexMarkerIndex].x);
+        bceAtomicAdd(&(Flex_FSI_ForcesD[nB].y), NB * (double)derivVelRhoD[FlexMarkerIndex].y);
+        bceAtomicAdd(&(Flex_FSI_ForcesD[nB].z), NB * (double)derivVelRhoD[FlexMarkerIndex].z);
 
-        atomicAdd(&(Flex_FSI_ForcesD[nC].x), NC * (double)derivVelRhoD[FlexMarkerIndex].x);
-        atomicAdd(&(Flex_FSI_ForcesD[nC].y), NC * (double)derivVelRhoD[FlexMarkerIndex].y);
-        atomicAdd(&(Flex_FSI_ForcesD[nC].z), NC * (double)derivVelRhoD[FlexMarkerIndex].z);
+        bceAtomicAdd(&(Flex_FSI_ForcesD[nC].x), NC * (double)derivVelRhoD[FlexMarkerIndex].x);
+        bceAtomicAdd(&(Flex_FSI_ForcesD[nC].y), NC * (double)derivVelRhoD[FlexMarkerIndex].y);
+        bceAtomicAdd(&(Flex_FSI_ForcesD[nC].z), NC * (double)derivVelRhoD[FlexMarkerIndex].z);
 
-        atomicAdd(&(Flex_FSI_ForcesD[nD].x), ND * (double)derivVelRhoD[FlexMarkerIndex].x);
-        atomicAdd(&(Flex_FSI_ForcesD[nD].y), ND * (double)derivVelRhoD[FlexMarkerIndex].y);
-        atomicAdd(&(Flex_FSI_ForcesD[nD].z), ND * (double)derivVelRhoD[FlexMarkerIndex].z);
+        bceAtomicAdd(&(Flex_FSI_ForcesD[nD].x), ND * (double)derivVelRhoD[FlexMarkerIndex].x);
+        bceAtomicAdd(&(Flex_FSI_ForcesD[nD].y), ND * (double)derivVelRhoD[FlexMarkerIndex].y);
+        bceAtomicAdd(&(Flex_FSI_ForcesD[nD].z), ND * (double)derivVelRhoD[FlexMarkerIndex].z);
     }
 }
+
+__global__ void Calc_Flex_FSI_ForcesD(Real3* FlexSPH_MeshPos_LRF_D,
+                                      uint* FlexIdentifierD,
+                                      const int numFlex1D,
+                                      uint2* CableElementsNodes,  // This is the connectivity of FEA mesh.
+                                      uint4* ShellElementsNodes,  // This is the connectivity of FEA mesh.
+                                      Real4* derivVelRhoD,
+                                      Real4* derivVelRhoD_old,
+                                      Real3* pos_fsi_fea_D,
+                                      Real3* Flex_FSI_ForcesD) {
+    uint index = blockIdx.x * blockDim.x + threadIdx.x;
+    if (index >= NumObjects().numFlex_SphMarkers) {
+        return;
+    }
+    Calc_Flex_FSI_ForcesD_marker(index, FlexSPH_MeshPos_LRF_D, FlexIdentifierD, numFlex1D, CableElementsNodes,
+                                 ShellElementsNodes, derivVelRhoD, derivVelRhoD_old, pos_fsi_fea_D, Flex_FSI_ForcesD);
+}
 //--------------------------------------------------------------------------------------------------------------------------------
 // collide a particle against all other particles in a given cell
 // Arman : revisit equation 10 of tech report, is it only on fluid or it is on
 // all markers
-__device__ void BCE_modification_Share(Real3& sumVW,
-                                       Real3& sumRhoRW,
-                                       Real& sumPW,
-                                       Real& sumWFluid,
-                                       int& isAffectedV,
-                                       int& isAffectedP,
-                                       int3 gridPos,
-                                       Real3 posRadA,
-                                       Real4* sortedPosRad,
-                                       Real3* sortedVelMas,
-                                       Real4* sortedRhoPreMu,
-                                       uint* cellStart,
-                                       uint* cellEnd) {
+__host__ __device__ void BCE_modification_Share(Real3& sumVW,
+                                                Real3& sumRhoRW,
+                                                Real& sumPW,
+                                                Real& sumWFluid,
+                                                int& isAffectedV,
+                                                int& isAffectedP,
+                                                int3 gridPos,
+                                                Real3 posRadA,
+                                                Real4* sortedPosRad,
+                                                Real3* sortedVelMas,
+                                                Real4* sortedRhoPreMu,
+                                                uint* cellStart,
+                                                uint* cellEnd) {
     uint gridHash = calcGridHash(gridPos);
     // get start of bucket for this cell
     uint startIndex = cellStart[gridHash];
@@ -278,7 +327,7 @@ __device__ void BCE_modification_Share(Real3& sumVW,
         Real3 dist3 = Distance(posRadA, posRadB);
         Real d = length(dist3);
         Real4 rhoPresMuB = sortedRhoPreMu[j];
-        if (d > RESOLUTION_LENGTH_MULT * paramsD.HSML || rhoPresMuB.w > -1.0)
+        if (d > RESOLUTION_LENGTH_MULT * Params().HSML || rhoPresMuB.w > -1.0)
             continue;
 
         Real Wd = W3h(d, sortedPosRad[j].w);
@@ -291,25 +340,22 @@ __device__ void BCE_modification_Share(Real3& sumVW,
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
-__global__ void new_BCE_VelocityPressure(Real4* velMassRigid_fsiBodies_D,
-                                         uint* rigidIdentifierD,
-                                         Real3* velMas_ModifiedBCE,    // input: sorted velocities
-                                         Real4* rhoPreMu_ModifiedBCE,  // input: sorted velocities
-                                         Real4* sortedPosRad,          // input: sorted positions
-                                         Real3* sortedVelMas,          // input: sorted velocities
-                                         Real4* sortedRhoPreMu,
-                                         uint* cellStart,
-                                         uint* cellEnd,
-                                         uint* mapOriginalToSorted,
-
-                                         Real3* bceAcc,
-                                         int3 updatePortion,
-                                         volatile bool* isErrorD) {
-    uint bceIndex = blockIdx.x * blockDim.x + threadIdx.x;
+__host__ __device__ inline void new_BCE_VelocityPressure_marker(uint bceIndex,
+                                                                Real4* velMassRigid_fsiBodies_D,
+                                                                uint* rigidIdentifierD,
+                                                                Real3* velMas_ModifiedBCE,  // input: sorted velocities
+                                                                Real4* rhoPreMu_ModifiedBCE,
+                                                                Real4* sortedPosRad,          // input: sorted positions
+                                                                Real3* sortedVelMas,  // input: sorted velocities
+                                                                Real4* sortedRhoPreMu,
+                                                                uint* cellStart,
+                                                                uint* cellEnd,
+                                                                uint* mapOriginalToSorted,
+
+                                                                Real3* bceAcc,
+                                                                int3 updatePortion,
+                                                                volatile bool* isErrorD) {
     uint sphIndex = bceIndex + updatePortion.x;  // updatePortion = [start, end] index of the update portion
-    if (bceIndex >= updatePortion.z - updatePortion.x) {
-        return;
-    }
 
     uint idA = mapOriginalToSorted[sphIndex];
 
@@ -339,8 +385,8 @@ __global__ void new_BCE_VelocityPressure(Real4* velMassRigid_fsiBodies_D,
     // get address in grid
     int3 gridPos = calcGridPos(posRadA);
 
-    /// if (gridPos.x == paramsD.gridSize.x-1) printf("****aha %d %d\n",
-    /// gridPos.x, paramsD.gridSize.x);
+    /// if (gridPos.x == Params().gridSize.x-1) printf("****aha %d %d\n",
+    /// gridPos.x, Params().gridSize.x);
 
     // examine neighbouring cells
     for (int z = -1; z <= 1; z++) {
@@ -359,8 +405,8 @@ __global__ void new_BCE_VelocityPressure(Real4* velMassRigid_fsiBodies_D,
         // pressure
         Real3 a3 = mR3(0);
         if (fabs(rhoPreMuA.w) > 0) {  // rigid BCE
-            int rigidBceIndex = sphIndex - numObjectsD.startRigidMarkers;
-            if (rigidBceIndex < 0 || rigidBceIndex >= numObjectsD.numRigid_SphMarkers) {
+            int rigidBceIndex = sphIndex - NumObjects().startRigidMarkers;
+            if (rigidBceIndex < 0 || rigidBceIndex >= NumObjects().numRigid_SphMarkers) {
                 printf(
                     "Error! marker index out of bound: thrown from "
                     "SDKCollisionSystem.cu, new_BCE_VelocityPressure !\n");
@@ -369,34 +415,53 @@ __global__ void new_BCE_VelocityPressure(Real4* velMassRigid_fsiBodies_D,
             }
             a3 = bceAcc[rigidBceIndex];
         }
-        Real pressure = (sumPW + dot(paramsD.gravity - a3, sumRhoRW)) / sumWFluid;  //(in fact:  (paramsD.gravity -
+        Real pressure = (sumPW + dot(Params().gravity - a3, sumRhoRW)) / sumWFluid;  //(in fact:  (Params().gravity -
         // aW), but aW for moving rigids
         // is hard to calc. Assume aW is
         // zero for now
         Real density = InvEos(pressure);
         rhoPreMu_ModifiedBCE[bceIndex] = mR4(density, pressure, rhoPreMuA.z, rhoPreMuA.w);
     } else {
-        rhoPreMu_ModifiedBCE[bceIndex] = mR4(paramsD.rho0, paramsD.BASEPRES, paramsD.mu0, rhoPreMuA.w);
+        rhoPreMu_ModifiedBCE[bceIndex] = mR4(Params().rho0, Params().BASEPRES, Params().mu0, rhoPreMuA.w);
         velMas_ModifiedBCE[bceIndex] = mR3(0.0);
     }
 
     sortedVelMas[idA] = velMas_ModifiedBCE[bceIndex];
     sortedRhoPreMu[idA] = rhoPreMu_ModifiedBCE[bceIndex];
 }
-//--------------------------------------------------------------------------------------------------------------------------------
-// calculate marker acceleration, required in ADAMI
-__global__ void calcBceAcceleration_kernel(Real3* bceAcc,
-                                           Real4* q_fsiBodies_D,
-                                           Real3* accRigid_fsiBodies_D,
-                                           Real3* omegaVelLRF_fsiBodies_D,
-                                           Real3* omegaAccLRF_fsiBodies_D,
-                                           Real3* rigidSPH_MeshPos_LRF_D,
-                                           const uint* rigidIdentifierD) {
+
+__global__ void new_BCE_VelocityPressure(Real4* velMassRigid_fsiBodies_D,
+                                         uint* rigidIdentifierD,
+                                         Real3* velMas_ModifiedBCE,    // input: sorted velocities
+                                         Real4* rhoPreMu_ModifiedBCE,  // input: sorted velocities
+                                         Real4* sortedPosRad,          // input: sorted positions
+                                         Real3* sortedVelMas,          // input: sorted velocities
+                                         Real4* sortedRhoPreMu,
+                                         uint* cellStart,
+                                         uint* cellEnd,
+                                         uint* mapOriginalToSorted,
+
+                                         Real3* bceAcc,
+                                         int3 updatePortion,
+                                         volatile bool* isErrorD) {
     uint bceIndex = blockIdx.x * blockDim.x + threadIdx.x;
-    if (bceIndex >= numObjectsD.numRigid_SphMarkers) {
+    if (bceIndex >= updatePortion.z - updatePortion.x) {
         return;
     }
-
+    new_BCE_VelocityPressure_marker(bceIndex, velMassRigid_fsiBodies_D, rigidIdentifierD, velMas_ModifiedBCE,
+                                    rhoPreMu_ModifiedBCE, sortedPosRad, sortedVelMas, sortedRhoPreMu, cellStart,
+                                    cellEnd, mapOriginalToSorted, bceAcc, updatePortion, isErrorD);
+}
+//--------------------------------------------------------------------------------------------------------------------------------
+// calculate marker acceleration, required in ADAMI
+__host__ __device__ inline void calcBceAcceleration_kernel_marker(uint bceIndex,
+                                                                  Real3* bceAcc,
+                                                                  Real4* q_fsiBodies_D,
+                                                                  Real3* accRigid_fsiBodies_D,
+                                                                  Real3* omegaVelLRF_fsiBodies_D,
+                                                                  Real3* omegaAccLRF_fsiBodies_D,
+                                                                  Real3* rigidSPH_MeshPos_LRF_D,
+                                                                  const uint* rigidIdentifierD) {
     int rigidBodyIndex = rigidIdentifierD[bceIndex];
     Real3 acc3 = accRigid_fsiBodies_D[rigidBodyIndex];  // linear acceleration (CM)
 
@@ -419,21 +484,33 @@ __global__ void calcBceAcceleration_kernel(Real3* bceAcc,
     // acc3.z);
     bceAcc[bceIndex] = acc3;
 }
-//--------------------------------------------------------------------------------------------------------------------------------
-// updates the rigid body particles
-__global__ void UpdateRigidMarkersPositionVelocityD(Real4* posRadD,
-                                                    Real3* velMasD,
-                                                    Real3* rigidSPH_MeshPos_LRF_D,
-                                                    uint* rigidIdentifierD,
-                                                    Real3* posRigidD,
-                                                    Real4* velMassRigidD,
-                                                    Real3* omegaLRF_D,
-                                                    Real4* qD) {
-    uint index = blockIdx.x * blockDim.x + threadIdx.x;
-    if (index >= numObjectsD.numRigid_SphMarkers) {
+
+__global__ void calcBceAcceleration_kernel(Real3* bceAcc,
+                                           Real4* q_fsiBodies_D,
+                                           Real3* accRigid_fsiBodies_D,
+                                           Real3* omegaVelLRF_fsiBodies_D,
+                                           Real3* omegaAccLRF_fsiBodies_D,
+                                           Real3* rigidSPH_MeshPos_LRF_D,
+                                           const uint* rigidIdentifierD) {
+    uint bceIndex = blockIdx.x * blockDim.x + threadIdx.x;
+    if (bceIndex >= NumObjects().numRigid_SphMarkers) {
         return;
     }
-    uint rigidMarkerIndex = index + numObjectsD.startRigidMarkers;  // updatePortion = [start, end]
+    calcBceAcceleration_kernel_marker(bceIndex, bceAcc, q_fsiBodies_D, accRigid_fsiBodies_D, omegaVelLRF_fsiBodies_D,
+                                      omegaAccLRF_fsiBodies_D, rigidSPH_MeshPos_LRF_D, rigidIdentifierD);
+}
+//--------------------------------------------------------------------------------------------------------------------------------
+// updates the rigid body particles
+__host__ __device__ inline void UpdateRigidMarkersPositionVelocityD_marker(uint index,
+                                                                           Real4* posRadD,
+                                                                           Real3* velMasD,
+                                                                           Real3* rigidSPH_MeshPos_LRF_D,
+                                                                           uint* rigidIdentifierD,
+                                                                           Real3* posRigidD,
+                                                                           Real4* velMassRigidD,
+                                                                           Real3* omegaLRF_D,
+                                                                           Real4* qD) {
+    uint rigidMarkerIndex = index + NumObjects().startRigidMarkers;  // updatePortion = [start, end]
                                                                     // index of the update portion
     int rigidBodyIndex = rigidIdentifierD[index];
 
@@ -456,30 +533,43 @@ __global__ void UpdateRigidMarkersPositionVelocityD(Real4* posRadD,
     Real3 omegaCrossS = cross(omega3, rigidSPH_MeshPos_LRF);
     velMasD[rigidMarkerIndex] = mR3(vM_Rigid) + mR3(dot(a1, omegaCrossS), dot(a2, omegaCrossS), dot(a3, omegaCrossS));
 }
-//--------------------------------------------------------------------------------------------------------------------------------
-// Real3 *posRadD, uint *FlexIdentifierD, Real3 *posFlex_fsiBodies_nA_D, Real3 *posFlex_fsiBodies_nB_D,
-//    Real3 *posFlex_fsiBodies_nC_D, Real3 *posFlex_fsiBodies_nD_D
 
-__global__ void UpdateFlexMarkersPositionVelocityAccD(Real4* posRadD,
-                                                      Real3* FlexSPH_MeshPos_LRF_D,
-                                                      Real3* velMasD,
-                                                      const uint* FlexIdentifierD,
-                                                      const int numFlex1D,
-                                                      uint2* CableElementsNodes,
-                                                      uint4* ShellelementsNodes,
-                                                      Real3* pos_fsi_fea_D,
-                                                      Real3* vel_fsi_fea_D,
-                                                      Real Spacing) {
+__global__ void UpdateRigidMarkersPositionVelocityD(Real4* posRadD,
+                                                    Real3* velMasD,
+                                                    Real3* rigidSPH_MeshPos_LRF_D,
+                                                    uint* rigidIdentifierD,
+                                                    Real3* posRigidD,
+                                                    Real4* velMassRigidD,
+                                                    Real3* omegaLRF_D,
+                                                    Real4* qD) {
     uint index = blockIdx.x * blockDim.x + threadIdx.x;
-    if (index >= numObjectsD.numFlex_SphMarkers) {
+    if (index >= NumObjects().numRigid_SphMarkers) {
         return;
     }
-    //  int numFlexSphMarkers = numObjectsD.numFlex_SphMarkers;
+    UpdateRigidMarkersPositionVelocityD_marker(index, posRadD, velMasD, rigidSPH_MeshPos_LRF_D, rigidIdentifierD,
+                                               posRigidD, velMassRigidD, omegaLRF_D, qD);
+}
+//--------------------------------------------------------------------------------------------------------------------------------
+// Real3 *posRadD, uint *FlexIdentifierD, Real3 *posFlex_fsiBodies_nA_D, Real3 *posFlex_fsiBodies_nB_D,
+//    Real3 *posFlex_fsiBodies_nC_D, Real3 *posFlex_fsiBodies_nD_D
+
+__host__ __device__ inline void UpdateFlexMarkersPositionVelocityAccD_marker(uint index,
+                                                                             Real4* posRadD,
+                                                                             Real3* FlexSPH_MeshPos_LRF_D,
+                                                                             Real3* velMasD,
+                                                                             const uint* FlexIdentifierD,
+                                                                             const int numFlex1D,
+                                                                             uint2* CableElementsNodes,
+                                                                             uint4* ShellelementsNodes,
+                                                                             Real3* pos_fsi_fea_D,
+                                                                             Real3* vel_fsi_fea_D,
+                                                                             Real Spacing) {
+    //  int numFlexSphMarkers = NumObjects().numFlex_SphMarkers;
 
     int FlexIndex = FlexIdentifierD[index];
     //  printf(" %d FlexIndex= %d\n", index, FlexIndex);
 
-    uint FlexMarkerIndex = index + numObjectsD.startFlexMarkers;  // updatePortion = [start, end]
+    uint FlexMarkerIndex = index + NumObjects().startFlexMarkers;  // updatePortion = [start, end]
 
     if (FlexIndex < numFlex1D) {
         uint2 CableNodes = CableElementsNodes[FlexIndex];
@@ -597,29 +687,45 @@ __global__ void UpdateFlexMarkersPositionVelocityAccD(Real4* posRadD,
     }
 }
 
-//--------------------------------------------------------------------------------------------------------------------------------
-__global__ void Calc_Rigid_FSI_ForcesD_TorquesD(Real3* rigid_FSI_ForcesD,
-                                                Real3* rigid_FSI_TorquesD,
-                                                Real4* derivVelRhoD,
-                                                Real4* derivVelRhoD_old,
-
-                                                Real4* posRadD,
-                                                uint* rigidIdentifierD,
-                                                Real3* posRigidD,
-                                                Real3* rigidSPH_MeshPos_LRF_D,
-                                                Real4* qD) {
+__global__ void UpdateFlexMarkersPositionVelocityAccD(Real4* posRadD,
+                                                      Real3* FlexSPH_MeshPos_LRF_D,
+                                                      Real3* velMasD,
+                                                      const uint* FlexIdentifierD,
+                                                      const int numFlex1D,
+                                                      uint2* CableElementsNodes,
+                                                      uint4* ShellelementsNodes,
+                                                      Real3* pos_fsi_fea_D,
+                                                      Real3* vel_fsi_fea_D,
+                                                      Real Spacing) {
     uint index = blockIdx.x * blockDim.x + threadIdx.x;
-    if (index >= numObjectsD.numRigid_SphMarkers) {
+    if (index >= NumObjects().numFlex_SphMarkers) {
         return;
     }
+    UpdateFlexMarkersPositionVelocityAccD_marker(index, posRadD, FlexSPH_MeshPos_LRF_D, velMasD, FlexIdentifierD,
+                                                 numFlex1D, CableElementsNodes, ShellelementsNodes, pos_fsi_fea_D,
+                                                 vel_fsi_fea_D, Spacing);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+__host__ __device__ inline void Calc_Rigid_FSI_ForcesD_TorquesD_marker(uint index,
+                                                                       Real3* rigid_FSI_ForcesD,
+                                                                       Real3* rigid_FSI_TorquesD,
+                                                                       Real4* derivVelRhoD,
+                                                                       Real4* derivVelRhoD_old,
+
+                                                                       Real4* posRadD,
+                                                                       uint* rigidIdentifierD,
+                                                                       Real3* posRigidD,
+                                                                       Real3* rigidSPH_MeshPos_LRF_D,
+                                                                       Real4* qD) {
     int RigidIndex = rigidIdentifierD[index];
-    uint rigidMarkerIndex = index + numObjectsD.startRigidMarkers;  // updatePortion = [start, end]
+    uint rigidMarkerIndex = index + NumObjects().startRigidMarkers;  // updatePortion = [start, end]
     derivVelRhoD[rigidMarkerIndex] =
-        derivVelRhoD[rigidMarkerIndex] * paramsD.Beta + derivVelRhoD_old[rigidMarkerIndex] * (1 - paramsD.Beta);
+        derivVelRhoD[rigidMarkerIndex] * Params().Beta + derivVelRhoD_old[rigidMarkerIndex] * (1 - Params().Beta);
 
-    atomicAdd(&(rigid_FSI_ForcesD[RigidIndex].x), (double)derivVelRhoD[rigidMarkerIndex].x);
-    atomicAdd(&(rigid_FSI_ForcesD[RigidIndex].y), (double)derivVelRhoD[rigidMarkerIndex].y);
-    atomicAdd(&(rigid_FSI_ForcesD[RigidIndex].z), (double)derivVelRhoD[rigidMarkerIndex].z);
+    bceAtomicAdd(&(rigid_FSI_ForcesD[RigidIndex].x), (double)derivVelRhoD[rigidMarkerIndex].x);
+    bceAtomicAdd(&(rigid_FSI_ForcesD[RigidIndex].y), (double)derivVelRhoD[rigidMarkerIndex].y);
+    bceAtomicAdd(&(rigid_FSI_ForcesD[RigidIndex].z), (double)derivVelRhoD[rigidMarkerIndex].z);
 
     //    Real3 p_loc = rigidSPH_MeshPos_LRF_D[rigidMarkerIndex];
     //    Real4 q4 = qD[rigidIndex];
@@ -631,9 +737,27 @@ __global__ void Calc_Rigid_FSI_ForcesD_TorquesD(Real3* rigid_FSI_ForcesD,
     Real3 dist3 = Distance(mR3(posRadD[rigidMarkerIndex]), posRigidD[RigidIndex]);
     Real3 mtorque = cross(dist3, mR3(derivVelRhoD[rigidMarkerIndex]));
 
-    atomicAdd(&(rigid_FSI_TorquesD[RigidIndex].x), (double)mtorque.x);
-    atomicAdd(&(rigid_FSI_TorquesD[RigidIndex].y), (double)mtorque.y);
-    atomicAdd(&(rigid_FSI_TorquesD[RigidIndex].z), (double)mtorque.z);
+    bceAtomicAdd(&(rigid_FSI_TorquesD[RigidIndex].x), (double)mtorque.x);
+    bceAtomicAdd(&(rigid_FSI_TorquesD[RigidIndex].y), (double)mtorque.y);
+    bceAtomicAdd(&(rigid_FSI_TorquesD[RigidIndex].z), (double)mtorque.z);
+}
+
+__global__ void Calc_Rigid_FSI_ForcesD_TorquesD(Real3* rigid_FSI_ForcesD,
+                                                Real3* rigid_FSI_TorquesD,
+                                                Real4* derivVelRhoD,
+                                                Real4* derivVelRhoD_old,
+
+                                                Real4* posRadD,
+                                                uint* rigidIdentifierD,
+                                                Real3* posRigidD,
+                                                Real3* rigidSPH_MeshPos_LRF_D,
+                                                Real4* qD) {
+    uint index = blockIdx.x * blockDim.x + threadIdx.x;
+    if (index >= NumObjects().numRigid_SphMarkers) {
+        return;
+    }
+    Calc_Rigid_FSI_ForcesD_TorquesD_marker(index, rigid_FSI_ForcesD, rigid_FSI_TorquesD, derivVelRhoD, derivVelRhoD_old,
+                                           posRadD, rigidIdentifierD, posRigidD, rigidSPH_MeshPos_LRF_D, qD);
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
@@ -655,8 +779,13 @@ ChBce::ChBce(std::shared_ptr<SphMarkerDataD> otherSortedSphMarkersD,
 void ChBce::Finalize(std::shared_ptr<SphMarkerDataD> sphMarkersD,
                      std::shared_ptr<FsiBodiesDataD> fsiBodiesD,
                      std::shared_ptr<FsiMeshDataD> fsiMeshD) {
+#ifdef CHRONO_FSI_USE_CPU
+    paramsH_CPU = *paramsH;
+    numObjectsH_CPU = *numObjectsH;
+#else
     cudaMemcpyToSymbolAsync(paramsD, paramsH.get(), sizeof(SimParams));
     cudaMemcpyToSymbolAsync(numObjectsD, numObjectsH.get(), sizeof(NumberOfObjects));
+#endif
     CopyParams_NumberOfObjects(paramsH, numObjectsH);
     totalSurfaceInteractionRigid4.resize(numObjectsH->numRigidBodies);
     dummyIdentify.resize(numObjectsH->numRigidBodies);
@@ -776,10 +905,17 @@ void ChBce::Populate_RigidSPH_MeshPos_LRF(std::shared_ptr<SphMarkerDataD> sphMar
     uint nThreads_SphMarkers;
     computeGridSize((uint)numObjectsH->numRigid_SphMarkers, 256, nBlocks_numRigid_SphMarkers, nThreads_SphMarkers);
 
+#ifdef CHRONO_FSI_USE_CPU
+    ForEachMarker((uint)numObjectsH->numRigid_SphMarkers, Populate_RigidSPH_MeshPos_LRF_kernel_marker,
+                  mR3CAST(fsiGeneralData->rigidSPH_MeshPos_LRF_D), mR4CAST(sphMarkersD->posRadD),
+                  U1CAST(fsiGeneralData->rigidIdentifierD), mR3CAST(fsiBodiesD->posRigid_fsiBodies_D),
+                  mR4CAST(fsiBodiesD->q_fsiBodies_D));
+#else
     Populate_RigidSPH_MeshPos_LRF_kernel<<<nBlocks_numRigid_SphMarkers, nThreads_SphMarkers>>>(
         mR3CAST(fsiGeneralData->rigidSPH_MeshPos_LRF_D), mR4CAST(sphMarkersD->posRadD),
         U1CAST(fsiGeneralData->rigidIdentifierD), mR3CAST(fsiBodiesD->posRigid_fsiBodies_D),
         mR4CAST(fsiBodiesD->q_fsiBodies_D));
+#endif
     cudaDeviceSynchronize();
     cudaCheckError();
 
@@ -816,11 +952,20 @@ void ChBce::Populate_FlexSPH_MeshPos_LRF(std::shared_ptr<SphMarkerDataD> sphMark
     //      fsiMeshD->pos_fsi_fea_D.size());
 
     thrust::device_vector<Real3> FlexSPH_MeshPos_LRF_H = fsiGeneralData->FlexSPH_MeshPos_LRF_H;
+#ifdef CHRONO_FSI_USE_CPU
+    ForEachMarker((uint)numObjectsH->numFlex_SphMarkers, Populate_FlexSPH_MeshPos_LRF_kernel_marker,
+                  mR3CAST(fsiGeneralData->FlexSPH_MeshPos_LRF_D), mR3CAST(FlexSPH_MeshPos_LRF_H),
+                  mR4CAST(sphMarkersD->posRadD), U1CAST(fsiGeneralData->FlexIdentifierD),
+                  (int)numObjectsH->numFlexBodies1D, U2CAST(fsiGeneralData->CableElementsNodes),
+                  U4CAST(fsiGeneralData->ShellElementsNodes), mR3CAST(fsiMeshD->pos_fsi_fea_D),
+                  paramsH->HSML * paramsH->MULT_INITSPACE_Shells);
+#else
     Populate_FlexSPH_MeshPos_LRF_kernel<<<nBlocks_numFlex_SphMarkers, nThreads_SphMarkers>>>(
         mR3CAST(fsiGeneralData->FlexSPH_MeshPos_LRF_D), mR3CAST(FlexSPH_MeshPos_LRF_H), mR4CAST(sphMarkersD->posRadD),
         U1CAST(fsiGeneralData->FlexIdentifierD), (int)numObjectsH->numFlexBodies1D,
         U2CAST(fsiGeneralData->CableElementsNodes), U4CAST(fsiGeneralData->ShellElementsNodes),
         mR3CAST(fsiMeshD->pos_fsi_fea_D), paramsH->HSML * paramsH->MULT_INITSPACE_Shells);
+#endif
 
     cudaDeviceSynchronize();
     cudaCheckError();
@@ -841,9 +986,8 @@ void ChBce::RecalcSortedVelocityPressure_BCE(std::shared_ptr<FsiBodiesDataD> fsi
                                              int3 updatePortion) {
     bool *isErrorH, *isErrorD;
     isErrorH = (bool*)malloc(sizeof(bool));
-    cudaMalloc((void**)&isErrorD, sizeof(bool));
+    isErrorD = ChUtilsDevice::CreateErrorFlag();
     *isErrorH = false;
-    cudaMemcpy(isErrorD, isErrorH, sizeof(bool), cudaMemcpyHostToDevice);
     //------------------------------------------------------------------------
 
     // thread per particle
@@ -853,22 +997,30 @@ void ChBce::RecalcSortedVelocityPressure_BCE(std::shared_ptr<FsiBodiesDataD> fsi
     //    printf("rigid size %d %d %d %d\n", fsiGeneralData->rigidIdentifierD.size(),
     //           fsiBodiesD->velMassRigid_fsiBodies_D.size(), updatePortion.y, updatePortion.x);
 
+#ifdef CHRONO_FSI_USE_CPU
+    ForEachMarker((uint)(updatePortion.z - updatePortion.x), new_BCE_VelocityPressure_marker,
+                  mR4CAST(fsiBodiesD->velMassRigid_fsiBodies_D), U1CAST(fsiGeneralData->rigidIdentifierD),
+                  mR3CAST(velMas_ModifiedBCE), mR4CAST(rhoPreMu_ModifiedBCE), mR4CAST(sortedPosRad),
+                  mR3CAST(sortedVelMas), mR4CAST(sortedRhoPreMu), U1CAST(cellStart), U1CAST(cellEnd),
+                  U1CAST(mapOriginalToSorted), mR3CAST(bceAcc), updatePortion, isErrorD);
+#else
     new_BCE_VelocityPressure<<<numBlocks, numThreads>>>(
         mR4CAST(fsiBodiesD->velMassRigid_fsiBodies_D), U1CAST(fsiGeneralData->rigidIdentifierD),
         mR3CAST(velMas_ModifiedBCE),
         mR4CAST(rhoPreMu_ModifiedBCE),  // input: sorted velocities
         mR4CAST(sortedPosRad), mR3CAST(sortedVelMas), mR4CAST(sortedRhoPreMu), U1CAST(cellStart), U1CAST(cellEnd),
         U1CAST(mapOriginalToSorted), mR3CAST(bceAcc), updatePortion, isErrorD);
+#endif
 
     cudaDeviceSynchronize();
-    cudaCheckError()
+    cudaCheckError();
 
-        //------------------------------------------------------------------------
-        cudaMemcpy(isErrorH, isErrorD, sizeof(bool), cudaMemcpyDeviceToHost);
+    //------------------------------------------------------------------------
+    *isErrorH = ChUtilsDevice::GetErrorFlag(isErrorD);
     if (*isErrorH == true) {
         throw std::runtime_error("Error! program crashed in  new_BCE_VelocityPressure!\n");
     }
-    cudaFree(isErrorD);
+    ChUtilsDevice::FreeErrorFlag(isErrorD);
     free(isErrorH);
 }
 //--------------------------------------------------------------------------------------------------------------------------------
@@ -884,9 +1036,15 @@ void ChBce::CalcBceAcceleration(thrust::device_vector<Real3>& bceAcc,
     uint numThreads, numBlocks;
     computeGridSize(numRigid_SphMarkers, 64, numBlocks, numThreads);
 
+#ifdef CHRONO_FSI_USE_CPU
+    ForEachMarker((uint)numRigid_SphMarkers, calcBceAcceleration_kernel_marker, mR3CAST(bceAcc), mR4CAST(q_fsiBodies_D),
+                  mR3CAST(accRigid_fsiBodies_D), mR3CAST(omegaVelLRF_fsiBodies_D), mR3CAST(omegaAccLRF_fsiBodies_D),
+                  mR3CAST(rigidSPH_MeshPos_LRF_D), U1CAST(rigidIdentifierD));
+#else
     calcBceAcceleration_kernel<<<numBlocks, numThreads>>>(
         mR3CAST(bceAcc), mR4CAST(q_fsiBodies_D), mR3CAST(accRigid_fsiBodies_D), mR3CAST(omegaVelLRF_fsiBodies_D),
         mR3CAST(omegaAccLRF_fsiBodies_D), mR3CAST(rigidSPH_MeshPos_LRF_D), U1CAST(rigidIdentifierD));
+#endif
 
     cudaDeviceSynchronize();
     cudaCheckError();
@@ -944,11 +1102,20 @@ void ChBce::Rigid_Forces_Torques(std::shared_ptr<SphMarkerDataD> sphMarkersD,
     uint nBlocks_numRigid_SphMarkers;
     uint nThreads_SphMarkers;
     computeGridSize((uint)numObjectsH->numRigid_SphMarkers, 256, nBlocks_numRigid_SphMarkers, nThreads_SphMarkers);
+#ifdef CHRONO_FSI_USE_CPU
+    ForEachMarker((uint)numObjectsH->numRigid_SphMarkers, Calc_Rigid_FSI_ForcesD_TorquesD_marker,
+                  mR3CAST(fsiGeneralData->rigid_FSI_ForcesD), mR3CAST(fsiGeneralData->rigid_FSI_TorquesD),
+                  mR4CAST(fsiGeneralData->derivVelRhoD), mR4CAST(fsiGeneralData->derivVelRhoD_old),
+                  mR4CAST(sphMarkersD->posRadD), U1CAST(fsiGeneralData->rigidIdentifierD),
+                  mR3CAST(fsiBodiesD->posRigid_fsiBodies_D), mR3CAST(fsiGeneralData->rigidSPH_MeshPos_LRF_D),
+                  mR4CAST(fsiBodiesD->q_fsiBodies_D));
+#else
     Calc_Rigid_FSI_ForcesD_TorquesD<<<nBlocks_numRigid_SphMarkers, nThreads_SphMarkers>>>(
         mR3CAST(fsiGeneralData->rigid_FSI_ForcesD), mR3CAST(fsiGeneralData->rigid_FSI_TorquesD),
         mR4CAST(fsiGeneralData->derivVelRhoD), mR4CAST(fsiGeneralData->derivVelRhoD_old), mR4CAST(sphMarkersD->posRadD),
         U1CAST(fsiGeneralData->rigidIdentifierD), mR3CAST(fsiBodiesD->posRigid_fsiBodies_D),
         mR3CAST(fsiGeneralData->rigidSPH_MeshPos_LRF_D), mR4CAST(fsiBodiesD->q_fsiBodies_D));
+#endif
     cudaDeviceSynchronize();
     cudaCheckError();
 }
@@ -964,12 +1131,21 @@ void ChBce::Flex_Forces(std::shared_ptr<SphMarkerDataD> sphMarkersD, std::shared
     uint nThreads_SphMarkers;
     computeGridSize((int)numObjectsH->numFlex_SphMarkers, 256, nBlocks_numFlex_SphMarkers, nThreads_SphMarkers);
 
+#ifdef CHRONO_FSI_USE_CPU
+    ForEachMarker((uint)numObjectsH->numFlex_SphMarkers, Calc_Flex_FSI_ForcesD_marker,
+                  mR3CAST(fsiGeneralData->FlexSPH_MeshPos_LRF_D), U1CAST(fsiGeneralData->FlexIdentifierD),
+                  (int)numObjectsH->numFlexBodies1D, U2CAST(fsiGeneralData->CableElementsNodes),
+                  U4CAST(fsiGeneralData->ShellElementsNodes), mR4CAST(fsiGeneralData->derivVelRhoD),
+                  mR4CAST(fsiGeneralData->derivVelRhoD_old), mR3CAST(fsiMeshD->pos_fsi_fea_D),
+                  mR3CAST(fsiGeneralData->Flex_FSI_ForcesD));
+#else
     Calc_Flex_FSI_ForcesD<<<nBlocks_numFlex_SphMarkers, nThreads_SphMarkers>>>(
         mR3CAST(fsiGeneralData->FlexSPH_MeshPos_LRF_D), U1CAST(fsiGeneralData->FlexIdentifierD),
         (int)numObjectsH->numFlexBodies1D, U2CAST(fsiGeneralData->CableElementsNodes),
         U4CAST(fsiGeneralData->ShellElementsNodes), mR4CAST(fsiGeneralData->derivVelRhoD),
         mR4CAST(fsiGeneralData->derivVelRhoD_old), mR3CAST(fsiMeshD->pos_fsi_fea_D),
         mR3CAST(fsiGeneralData->Flex_FSI_ForcesD));
+#endif
     cudaDeviceSynchronize();
     cudaCheckError();
 }
@@ -991,11 +1167,19 @@ void ChBce::UpdateRigidMarkersPositionVelocity(std::shared_ptr<SphMarkerDataD> s
     //** "posRadD2"/"velMasD2" associated to BCE markers are updated based on new
     // rigid body (position,
     // orientation)/(velocity, angular velocity)
+#ifdef CHRONO_FSI_USE_CPU
+    ForEachMarker((uint)numObjectsH->numRigid_SphMarkers, UpdateRigidMarkersPositionVelocityD_marker,
+                  mR4CAST(sphMarkersD->posRadD), mR3CAST(sphMarkersD->velMasD),
+                  mR3CAST(fsiGeneralData->rigidSPH_MeshPos_LRF_D), U1CAST(fsiGeneralData->rigidIdentifierD),
+                  mR3CAST(fsiBodiesD->posRigid_fsiBodies_D), mR4CAST(fsiBodiesD->velMassRigid_fsiBodies_D),
+                  mR3CAST(fsiBodiesD->omegaVelLRF_fsiBodies_D), mR4CAST(fsiBodiesD->q_fsiBodies_D));
+#else
     UpdateRigidMarkersPositionVelocityD<<<nBlocks_numRigid_SphMarkers, nThreads_SphMarkers>>>(
         mR4CAST(sphMarkersD->posRadD), mR3CAST(sphMarkersD->velMasD), mR3CAST(fsiGeneralData->rigidSPH_MeshPos_LRF_D),
         U1CAST(fsiGeneralData->rigidIdentifierD), mR3CAST(fsiBodiesD->posRigid_fsiBodies_D),
         mR4CAST(fsiBodiesD->velMassRigid_fsiBodies_D), mR3CAST(fsiBodiesD->omegaVelLRF_fsiBodies_D),
         mR4CAST(fsiBodiesD->q_fsiBodies_D));
+#endif
     cudaDeviceSynchronize();
     cudaCheckError();
 }
@@ -1011,12 +1195,21 @@ void ChBce::UpdateFlexMarkersPositionVelocity(std::shared_ptr<SphMarkerDataD> sp
     printf("UpdateFlexMarkersPositionVelocity..\n");
 
     computeGridSize((int)numObjectsH->numFlex_SphMarkers, 256, nBlocks_numFlex_SphMarkers, nThreads_SphMarkers);
+#ifdef CHRONO_FSI_USE_CPU
+    ForEachMarker((uint)numObjectsH->numFlex_SphMarkers, UpdateFlexMarkersPositionVelocityAccD_marker,
+                  mR4CAST(sphMarkersD->posRadD), mR3CAST(fsiGeneralData->FlexSPH_MeshPos_LRF_D),
+                  mR3CAST(sphMarkersD->velMasD), U1CAST(fsiGeneralData->FlexIdentifierD),
+                  (int)numObjectsH->numFlexBodies1D, U2CAST(fsiGeneralData->CableElementsNodes),
+                  U4CAST(fsiGeneralData->ShellElementsNodes), mR3CAST(fsiMeshD->pos_fsi_fea_D),
+                  mR3CAST(fsiMeshD->vel_fsi_fea_D), paramsH->HSML * paramsH->MULT_INITSPACE_Shells);
+#else
     UpdateFlexMarkersPositionVelocityAccD<<<nBlocks_numFlex_SphMarkers, nThreads_SphMarkers>>>(
         mR4CAST(sphMarkersD->posRadD), mR3CAST(fsiGeneralData->FlexSPH_MeshPos_LRF_D), mR3CAST(sphMarkersD->velMasD),
         U1CAST(fsiGeneralData->FlexIdentifierD), (int)numObjectsH->numFlexBodies1D,
         U2CAST(fsiGeneralData->CableElementsNodes), U4CAST(fsiGeneralData->ShellElementsNodes),
         mR3CAST(fsiMeshD->pos_fsi_fea_D), mR3CAST(fsiMeshD->vel_fsi_fea_D),
         paramsH->HSML * paramsH->MULT_INITSPACE_Shells);
+#endif
     cudaDeviceSynchronize();
     cudaCheckError();
 }
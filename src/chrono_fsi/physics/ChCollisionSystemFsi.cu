@@ -38,22 +38,17 @@ namespace fsi {
  * @param numAllMarkers
  */
 
-/// calcHashD :
-/// 1. Get particle index.Determine by the block and thread we are in.
-/// 2. From x, y, z position determine which bin it is in.
-/// 3. Calculate hash from bin index.
-/// 4. Store hash and particle index associated with it.
-__global__ void calcHashD(
+/// calcHash_marker :
+/// 1. From x, y, z position of the marker with the given index determine which bin it is in.
+/// 2. Calculate hash from bin index.
+/// 3. Store hash and particle index associated with it.
+/// Shared by the calcHashD kernel and the CPU backend.
+__host__ __device__ inline void calcHash_marker(
+    uint index,              ///< index of the marker in posRad
     uint* gridMarkerHashD,   ///< gridMarkerHash Store marker hash here
     uint* gridMarkerIndexD,  ///< gridMarkerIndex Store marker index here
     Real4* posRad,           ///< posRad Vector containing the positions of all particles, including boundary particles
-    const size_t numAllMarkers,  ///< Total number of markers (fluid + boundary)
     volatile bool* isErrorD) {
-    /* Calculate the index of where the particle is stored in posRad. */
-    uint index = blockIdx.x * blockDim.x + threadIdx.x;
-    if (index >= numAllMarkers)
-        return;
-
     Real3 p = mR3(posRad[index]);
 
     if (!(isfinite(p.x) && isfinite(p.y) && isfinite(p.z))) {
@@ -65,7 +60,7 @@ __global__ void calcHashD(
     }
 
     /* Check particle is inside the domain. */
-    Real3 boxCorner = paramsD.worldOrigin - mR3(40 * paramsD.HSML);
+    Real3 boxCorner = Params().worldOrigin - mR3(40 * Params().HSML);
     if (p.x < boxCorner.x || p.y < boxCorner.y || p.z < boxCorner.z) {
         printf(
             "Out of Min Boundary, point %f %f %f, boundary min: %f %f %f. "
@@ -74,7 +69,7 @@ __global__ void calcHashD(
         *isErrorD = true;
         return;
     }
-    boxCorner = paramsD.worldOrigin + paramsD.boxDims + mR3(40 * paramsD.HSML);
+    boxCorner = Params().worldOrigin + Params().boxDims + mR3(40 * Params().HSML);
     if (p.x > boxCorner.x || p.y > boxCorner.y || p.z > boxCorner.z) {
         printf(
             "Out of max Boundary, point %f %f %f, boundary max: %f %f %f. "
@@ -95,6 +90,107 @@ __global__ void calcHashD(
     gridMarkerIndexD[index] = index;
 }
 
+/// calcHashD :
+/// 1. Get particle index.Determine by the block and thread we are in.
+/// 2. Calculate and store the hash of this particle (see calcHash_marker).
+__global__ void calcHashD(
+    uint* gridMarkerHashD,   ///< gridMarkerHash Store marker hash here
+    uint* gridMarkerIndexD,  ///< gridMarkerIndex Store marker index here
+    Real4* posRad,           ///< posRad Vector containing the positions of all particles, including boundary particles
+    const size_t numAllMarkers,  ///< Total number of markers (fluid + boundary)
+    volatile bool* isErrorD) {
+    /* Calculate the index of where the particle is stored in posRad. */
+    uint index = blockIdx.x * blockDim.x + threadIdx.x;
+    if (index >= numAllMarkers)
+        return;
+
+    calcHash_marker(index, gridMarkerHashD, gridMarkerIndexD, posRad, isErrorD);
+}
+
+/// Find the cell start/end of the marker with the given sorted index and copy its data to the sorted arrays.
+/// prevHash is the hash of the marker at index-1 (unused for index 0). Shared by the kernel and the CPU backend.
+__host__ __device__ inline void reorderDataAndFindCellStart_marker(uint index,
+                                                                   uint hash,
+                                                                   uint prevHash,
+                                                                   uint* cellStartD,
+                                                                   uint* cellEndD,
+                                                                   Real4* sortedPosRadD,
+                                                                   Real3* sortedVelMasD,
+                                                                   Real4* sortedRhoPreMuD,
+                                                                   Real3* sortedTauXxYyZzD,
+                                                                   Real3* sortedTauXyXzYzD,
+                                                                   Real3* tauXxYyZzD,
+                                                                   Real3* tauXyXzYzD,
+                                                                   uint* gridMarkerHashD,
+                                                                   uint* gridMarkerIndexD,
+                                                                   uint* mapOriginalToSorted,
+                                                                   Real4* posRadD,
+                                                                   Real3* velMasD,
+                                                                   Real4* rhoPresMuD,
+                                                                   const size_t numAllMarkers) {
+    /* If this particle has a different cell index to the previous particle then
+     * it must be
+     * the first particle in the cell, so store the index of this particle in
+     * the cell. As it
+     * isn't the first particle, it must also be the cell end of the previous
+     * particle's cell
+     */
+    if (index == 0 || hash != prevHash) {
+        cellStartD[hash] = index;
+        if (index > 0)
+            cellEndD[prevHash] = index;
+    }
+
+    if (index == numAllMarkers - 1) {
+        cellEndD[hash] = index + 1;
+    }
+
+    /* Now use the sorted index to reorder the pos and vel data */
+    uint originalIndex = gridMarkerIndexD[index];  // map sorted to original
+    mapOriginalToSorted[index] = index;            // will be sorted outside. Alternatively, you could have
+    // mapOriginalToSorted[originalIndex] = index; without need to sort. But
+    // that
+    // is not thread safe
+    Real3 posRad = mR3(posRadD[originalIndex]);  // macro does either global read or
+                                                 // texture fetch
+    Real3 velMas = velMasD[originalIndex];       // see particles_kernel.cuh
+    Real4 rhoPreMu = rhoPresMuD[originalIndex];
+
+    Real3 tauXxYyZz = tauXxYyZzD[originalIndex];
+    Real3 tauXyXzYz = tauXyXzYzD[originalIndex];
+
+    if (!(isfinite(posRad.x) && isfinite(posRad.y) && isfinite(posRad.z))) {
+        printf(
+            "Error! particle position is NAN: thrown from "
+            "SDKCollisionSystem.cu, reorderDataAndFindCellStartD !\n");
+    }
+    if (!(isfinite(velMas.x) && isfinite(velMas.y) && isfinite(velMas.z))) {
+        printf(
+            "Error! particle velocity is NAN: thrown from "
+            "SDKCollisionSystem.cu, reorderDataAndFindCellStartD !\n");
+    }
+    if (!(isfinite(rhoPreMu.x) && isfinite(rhoPreMu.y) && isfinite(rhoPreMu.z) && isfinite(rhoPreMu.w))) {
+        printf(
+            "Error! particle rhoPreMu is NAN: thrown from "
+            "SDKCollisionSystem.cu, reorderDataAndFindCellStartD !\n");
+    }
+    if (!(isfinite(tauXxYyZz.x) && isfinite(tauXxYyZz.y) && isfinite(tauXxYyZz.z))) {
+        printf(
+            "Error! particle tauXxYyZz is NAN: thrown from "
+            "SDKCollisionSystem.cu, reorderDataAndFindCellStartD !\n");
+    }
+    if (!(isfinite(tauXyXzYz.x) && isfinite(tauXyXzYz.y) && isfinite(tauXyXzYz.z))) {
+        printf(
+            "Error! particle tauXyXzYz is NAN: thrown from "
+            "SDKCollisionSystem.cu, reorderDataAndFindCellStartD !\n");
+    }
+    sortedPosRadD[index] = mR4(posRad, posRadD[originalIndex].w);
+    sortedVelMasD[index] = velMas;
+    sortedRhoPreMuD[index] = rhoPreMu;
+    sortedTauXxYyZzD[index] = tauXxYyZz;
+    sortedTauXyXzYzD[index] = tauXyXzYz;
+}
+
 /**
  * @brief reorderDataAndFindCellStartD
  * @details See SDKCollisionSystem.cuh for more info
@@ -138,70 +234,42 @@ __global__ void reorderDataAndFindCellStartD(uint* cellStartD,      // output: c
     __syncthreads();
 
     if (index < numAllMarkers) {
-        /* If this particle has a different cell index to the previous particle then
-         * it must be
-         * the first particle in the cell, so store the index of this particle in
-         * the cell. As it
-         * isn't the first particle, it must also be the cell end of the previous
-         * particle's cell
-         */
-        if (index == 0 || hash != sharedHash[threadIdx.x]) {
-            cellStartD[hash] = index;
-            if (index > 0)
-                cellEndD[sharedHash[threadIdx.x]] = index;
-        }
-
-        if (index == numAllMarkers - 1) {
-            cellEndD[hash] = index + 1;
-        }
-
-        /* Now use the sorted index to reorder the pos and vel data */
-        uint originalIndex = gridMarkerIndexD[index];  // map sorted to original
-        mapOriginalToSorted[index] = index;            // will be sorted outside. Alternatively, you could have
-        // mapOriginalToSorted[originalIndex] = index; without need to sort. But
-        // that
-        // is not thread safe
-        Real3 posRad = mR3(posRadD[originalIndex]);  // macro does either global read or
-                                                     // texture fetch
-        Real3 velMas = velMasD[originalIndex];       // see particles_kernel.cuh
-        Real4 rhoPreMu = rhoPresMuD[originalIndex];
-
-        Real3 tauXxYyZz = tauXxYyZzD[originalIndex];  
-        Real3 tauXyXzYz = tauXyXzYzD[originalIndex]; 
-
-        if (!(isfinite(posRad.x) && isfinite(posRad.y) && isfinite(posRad.z))) {
-            printf(
-                "Error! particle position is NAN: thrown from "
-                "SDKCollisionSystem.cu, reorderDataAndFindCellStartD !\n");
-        }
-        if (!(isfinite(velMas.x) && isfinite(velMas.y) && isfinite(velMas.z))) {
-            printf(
-                "Error! particle velocity is NAN: thrown from "
-                "SDKCollisionSystem.cu, reorderDataAndFindCellStartD !\n");
-        }
-        if (!(isfinite(rhoPreMu.x) && isfinite(rhoPreMu.y) && isfinite(rhoPreMu.z) && isfinite(rhoPreMu.w))) {
-            printf(
-                "Error! particle rhoPreMu is NAN: thrown from "
-                "SDKCollisionSystem.cu, reorderDataAndFindCellStartD !\n");
-        }
-        if (!(isfinite(tauXxYyZz.x) && isfinite(tauXxYyZz.y) && isfinite(tauXxYyZz.z))) {  
-            printf(
-                "Error! particle tauXxYyZz is NAN: thrown from "
-                "SDKCollisionSystem.cu, reorderDataAndFindCellStartD !\n");
-        }
-        if (!(isfinite(tauXyXzYz.x) && isfinite(tauXyXzYz.y) && isfinite(tauXyXzYz.z))) { 
-            printf(
-                "Error! particle tauXyXzYz is NAN: thrown from "
-                "SDKCollisionSystem.cu, reorderDataAndFindCellStartD !\n");
-        }
-        sortedPosRadD[index] = mR4(posRad, posRadD[originalIndex].w);
-        sortedVelMasD[index] = velMas;
-        sortedRhoPreMuD[index] = rhoPreMu;
-        sortedTauXxYyZzD[index] = tauXxYyZz;  
-        sortedTauXyXzYzD[index] = tauXyXzYz; 
+        uint prevHash = (index > 0) ? sharedHash[threadIdx.x] : 0;
+        reorderDataAndFindCellStart_marker(index, hash, prevHash, cellStartD, cellEndD, sortedPosRadD, sortedVelMasD,
+                                           sortedRhoPreMuD, sortedTauXxYyZzD, sortedTauXyXzYzD, tauXxYyZzD, tauXyXzYzD,
+                                           gridMarkerHashD, gridMarkerIndexD, mapOriginalToSorted, posRadD, velMasD,
+                                           rhoPresMuD, numAllMarkers);
     }
 }
 
+#ifdef CHRONO_FSI_USE_CPU
+/// Host version of reorderDataAndFindCellStartD for the CPU backend (reads the previous hash directly).
+inline void reorderDataAndFindCellStartH(uint index,
+                                         uint* cellStartD,
+                                         uint* cellEndD,
+                                         Real4* sortedPosRadD,
+                                         Real3* sortedVelMasD,
+                                         Real4* sortedRhoPreMuD,
+                                         Real3* sortedTauXxYyZzD,
+                                         Real3* sortedTauXyXzYzD,
+                                         Real3* tauXxYyZzD,
+                                         Real3* tauXyXzYzD,
+                                         uint* gridMarkerHashD,
+                                         uint* gridMarkerIndexD,
+                                         uint* mapOriginalToSorted,
+                                         Real4* posRadD,
+                                         Real3* velMasD,
+                                         Real4* rhoPresMuD,
+                                         const size_t numAllMarkers) {
+    uint hash = gridMarkerHashD[index];
+    uint prevHash = (index > 0) ? gridMarkerHashD[index - 1] : 0;
+    reorderDataAndFindCellStart_marker(index, hash, prevHash, cellStartD, cellEndD, sortedPosRadD, sortedVelMasD,
+                                       sortedRhoPreMuD, sortedTauXxYyZzD, sortedTauXyXzYzD, tauXxYyZzD, tauXyXzYzD,
+                                       gridMarkerHashD, gridMarkerIndexD, mapOriginalToSorted, posRadD, velMasD,
+                                       rhoPresMuD, numAllMarkers);
+}
+#endif
+
 //--------------------------------------------------------------------------------------------------------------------------------
 
 ChCollisionSystemFsi::ChCollisionSystemFsi(std::shared_ptr<SphMarkerDataD> otherSortedSphMarkersD,
@@ -218,8 +286,13 @@ ChCollisionSystemFsi::ChCollisionSystemFsi(std::shared_ptr<SphMarkerDataD> other
 
 //--------------------------------------------------------------------------------------------------------------------------------
 void ChCollisionSystemFsi::Finalize() {
+#ifdef CHRONO_FSI_USE_CPU
+    paramsH_CPU = *paramsH;
+    numObjectsH_CPU = *numObjectsH;
+#else
     cudaMemcpyToSymbolAsync(paramsD, paramsH.get(), sizeof(SimParams));
     cudaMemcpyToSymbolAsync(numObjectsD, numObjectsH.get(), sizeof(NumberOfObjects));
+#endif
 }
 //--------------------------------------------------------------------------------------------------------------------------------
 
@@ -243,10 +316,13 @@ void ChCollisionSystemFsi::calcHash() {
 
     bool *isErrorH, *isErrorD;
     isErrorH = (bool*)malloc(sizeof(bool));
-    cudaMalloc((void**)&isErrorD, sizeof(bool));
+    isErrorD = ChUtilsDevice::CreateErrorFlag();
     *isErrorH = false;
-    cudaMemcpy(isErrorD, isErrorH, sizeof(bool), cudaMemcpyHostToDevice);
     //------------------------------------------------------------------------
+#ifdef CHRONO_FSI_USE_CPU
+    ForEachMarker((uint)numObjectsH->numAllMarkers, calcHash_marker, U1CAST(markersProximityD->gridMarkerHashD),
+                  U1CAST(markersProximityD->gridMarkerIndexD), mR4CAST(sphMarkersD->posRadD), isErrorD);
+#else
     /* Is there a need to optimize the number of threads used at once? */
     uint numThreads, numBlocks;
     computeGridSize((int)numObjectsH->numAllMarkers, 256, numBlocks, numThreads);
@@ -259,12 +335,13 @@ void ChCollisionSystemFsi::calcHash() {
     /* Check for errors in kernel execution */
     cudaDeviceSynchronize();
     cudaCheckError();
+#endif
     //------------------------------------------------------------------------
-    cudaMemcpy(isErrorH, isErrorD, sizeof(bool), cudaMemcpyDeviceToHost);
+    *isErrorH = ChUtilsDevice::GetErrorFlag(isErrorD);
     if (*isErrorH == true) {
         throw std::runtime_error("Error! program crashed in  calcHashD!\n");
     }
-    cudaFree(isErrorD);
+    ChUtilsDevice::FreeErrorFlag(isErrorD);
     free(isErrorH);
 }
 
@@ -283,6 +360,16 @@ void ChCollisionSystemFsi::reorderDataAndFindCellStart() {
     thrust::fill(markersProximityD->cellStartD.begin(), markersProximityD->cellStartD.end(), 0);
     thrust::fill(markersProximityD->cellEndD.begin(), markersProximityD->cellEndD.end(), 0);
 
+#ifdef CHRONO_FSI_USE_CPU
+    ForEachMarker((uint)numObjectsH->numAllMarkers, reorderDataAndFindCellStartH, U1CAST(markersProximityD->cellStartD),
+                  U1CAST(markersProximityD->cellEndD), mR4CAST(sortedSphMarkersD->posRadD),
+                  mR3CAST(sortedSphMarkersD->velMasD), mR4CAST(sortedSphMarkersD->rhoPresMuD),
+                  mR3CAST(sortedSphMarkersD->tauXxYyZzD), mR3CAST(sortedSphMarkersD->tauXyXzYzD),
+                  mR3CAST(sphMarkersD->tauXxYyZzD), mR3CAST(sphMarkersD->tauXyXzYzD),
+                  U1CAST(markersProximityD->gridMarkerHashD), U1CAST(markersProximityD->gridMarkerIndexD),
+                  U1CAST(markersProximityD->mapOriginalToSorted), mR4CAST(sphMarkersD->posRadD),
+                  mR3CAST(sphMarkersD->velMasD), mR4CAST(sphMarkersD->rhoPresMuD), numObjectsH->numAllMarkers);
+#else
     uint numThreads, numBlocks;
     computeGridSize((uint)numObjectsH->numAllMarkers, 256, numBlocks, numThreads);  //?$ 256 is blockSize
 
@@ -297,6 +384,7 @@ void ChCollisionSystemFsi::reorderDataAndFindCellStart() {
         mR4CAST(sphMarkersD->rhoPresMuD), numObjectsH->numAllMarkers);
     cudaDeviceSynchronize();
     cudaCheckError();
+#endif
 
     // unroll sorted index to have the location of original particles in the
     // sorted arrays
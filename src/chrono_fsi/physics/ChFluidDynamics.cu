@@ -23,16 +23,16 @@ namespace fsi {
 // -----------------------------------------------------------------------------
 /// Device function to calculate the share of density influence on a given
 /// marker from all other markers in a given cell
-__device__ void collideCellDensityReInit(Real& numerator,
-                                         Real& denominator,
-                                         int3 gridPos,
-                                         uint index,
-                                         Real3 posRadA,
-                                         Real4* sortedPosRad,
-                                         Real3* sortedVelMas,
-                                         Real4* sortedRhoPreMu,
-                                         uint* cellStart,
-                                         uint* cellEnd) {
+__host__ __device__ void collideCellDensityReInit(Real& numerator,
+                                                  Real& denominator,
+                                                  int3 gridPos,
+                                                  uint index,
+                                                  Real3 posRadA,
+                                                  Real4* sortedPosRad,
+                                                  Real3* sortedVelMas,
+                                                  Real4* sortedRhoPreMu,
+                                                  uint* cellStart,
+                                                  uint* cellEnd) {
     //?c2 printf("grid pos %d %d %d \n", gridPos.x, gridPos.y, gridPos.z);
     uint gridHash = calcGridHash(gridPos);
     // get start of bucket for this cell
@@ -47,21 +47,17 @@ __device__ void collideCellDensityReInit(Real& numerator,
             Real4 rhoPreMuB = sortedRhoPreMu[j];
             Real3 dist3 = Distance(posRadA, posRadB);
             Real d = length(dist3);
-            if (d > RESOLUTION_LENGTH_MULT * paramsD.HSML)
+            if (d > RESOLUTION_LENGTH_MULT * Params().HSML)
                 continue;
-            numerator += paramsD.markerMass * W3h(d, sortedPosRad[j].w);
-            denominator += paramsD.markerMass / rhoPreMuB.x * W3h(d, sortedPosRad[j].w);
+            numerator += Params().markerMass * W3h(d, sortedPosRad[j].w);
+            denominator += Params().markerMass / rhoPreMuB.x * W3h(d, sortedPosRad[j].w);
         }
     }
 }
 
 // -----------------------------------------------------------------------------
 /// Kernel to apply periodic BC along x
-__global__ void ApplyPeriodicBoundaryXKernel(Real4* posRadD, Real4* rhoPresMuD) {
-    uint index = blockIdx.x * blockDim.x + threadIdx.x;
-    if (index >= numObjectsD.numAllMarkers) {
-        return;
-    }
+__host__ __device__ inline void ApplyPeriodicBoundaryXKernel_marker(uint index, Real4* posRadD, Real4* rhoPresMuD) {
     Real4 rhoPresMu = rhoPresMuD[index];
     if (fabs(rhoPresMu.w) < .1) {
         return;
@@ -69,31 +65,38 @@ __global__ void ApplyPeriodicBoundaryXKernel(Real4* posRadD, Real4* rhoPresMuD)
     Real3 posRad = mR3(posRadD[index]);
     Real h = posRadD[index].w;
 
-    if (posRad.x > paramsD.cMax.x) {
-        posRad.x -= (paramsD.cMax.x - paramsD.cMin.x);
+    if (posRad.x > Params().cMax.x) {
+        posRad.x -= (Params().cMax.x - Params().cMin.x);
         posRadD[index] = mR4(posRad, h);
         if (rhoPresMu.w < -.1) {
-            rhoPresMuD[index].y += paramsD.deltaPress.x;
+            rhoPresMuD[index].y += Params().deltaPress.x;
         }
         return;
     }
-    if (posRad.x < paramsD.cMin.x) {
-        posRad.x += (paramsD.cMax.x - paramsD.cMin.x);
+    if (posRad.x < Params().cMin.x) {
+        posRad.x += (Params().cMax.x - Params().cMin.x);
         posRadD[index] = mR4(posRad, h);
         if (rhoPresMu.w < -.1) {
-            rhoPresMuD[index].y -= paramsD.deltaPress.x;
+            rhoPresMuD[index].y -= Params().deltaPress.x;
         }
         return;
     }
 }
 
-// -----------------------------------------------------------------------------
-/// Kernel to apply inlet/outlet BC along x
-__global__ void ApplyInletBoundaryXKernel(Real4* posRadD, Real3* VelMassD, Real4* rhoPresMuD) {
+__global__ void ApplyPeriodicBoundaryXKernel(Real4* posRadD, Real4* rhoPresMuD) {
     uint index = blockIdx.x * blockDim.x + threadIdx.x;
-    if (index >= numObjectsD.numAllMarkers) {
+    if (index >= NumObjects().numAllMarkers) {
         return;
     }
+    ApplyPeriodicBoundaryXKernel_marker(index, posRadD, rhoPresMuD);
+}
+
+// -----------------------------------------------------------------------------
+/// Kernel to apply inlet/outlet BC along x
+__host__ __device__ inline void ApplyInletBoundaryXKernel_marker(uint index,
+                                                                 Real4* posRadD,
+                                                                 Real3* VelMassD,
+                                                                 Real4* rhoPresMuD) {
     Real4 rhoPresMu = rhoPresMuD[index];
     if (rhoPresMu.w > 0.0) {
         return;
@@ -101,41 +104,45 @@ __global__ void ApplyInletBoundaryXKernel(Real4* posRadD, Real3* VelMassD, Real4
     Real3 posRad = mR3(posRadD[index]);
     Real h = posRadD[index].w;
 
-    if (posRad.x > paramsD.cMax.x) {
-        posRad.x -= (paramsD.cMax.x - paramsD.cMin.x);
+    if (posRad.x > Params().cMax.x) {
+        posRad.x -= (Params().cMax.x - Params().cMin.x);
         posRadD[index] = mR4(posRad, h);
         if (rhoPresMu.w <= 0.0) {
-            rhoPresMu.y = rhoPresMu.y + paramsD.deltaPress.x;
+            rhoPresMu.y = rhoPresMu.y + Params().deltaPress.x;
             rhoPresMuD[index] = rhoPresMu;
         }
     }
-    if (posRad.x < paramsD.cMin.x) {
-        posRad.x += (paramsD.cMax.x - paramsD.cMin.x);
+    if (posRad.x < Params().cMin.x) {
+        posRad.x += (Params().cMax.x - Params().cMin.x);
         posRadD[index] = mR4(posRad, h);
-        VelMassD[index] = mR3(paramsD.V_in.x, 0, 0);
+        VelMassD[index] = mR3(Params().V_in.x, 0, 0);
 
         if (rhoPresMu.w <= -.1) {
-            rhoPresMu.y = rhoPresMu.y - paramsD.deltaPress.x;
+            rhoPresMu.y = rhoPresMu.y - Params().deltaPress.x;
             rhoPresMuD[index] = rhoPresMu;
         }
     }
 
-    if (posRad.x > -paramsD.x_in)
+    if (posRad.x > -Params().x_in)
         rhoPresMuD[index].y = 0;
 
-    if (posRad.x < paramsD.x_in) {
-        //        Real vel = paramsD.V_in * 4 * (posRadD[index].z) * (0.41 - posRadD[index].z) / (0.41 * 0.41);
-        VelMassD[index] = mR3(paramsD.V_in.x, 0, 0);
+    if (posRad.x < Params().x_in) {
+        //        Real vel = Params().V_in * 4 * (posRadD[index].z) * (0.41 - posRadD[index].z) / (0.41 * 0.41);
+        VelMassD[index] = mR3(Params().V_in.x, 0, 0);
     }
 }
 
-// -----------------------------------------------------------------------------
-/// Kernel to apply periodic BC along y
-__global__ void ApplyPeriodicBoundaryYKernel(Real4* posRadD, Real4* rhoPresMuD) {
+__global__ void ApplyInletBoundaryXKernel(Real4* posRadD, Real3* VelMassD, Real4* rhoPresMuD) {
     uint index = blockIdx.x * blockDim.x + threadIdx.x;
-    if (index >= numObjectsD.numAllMarkers) {
+    if (index >= NumObjects().numAllMarkers) {
         return;
     }
+    ApplyInletBoundaryXKernel_marker(index, posRadD, VelMassD, rhoPresMuD);
+}
+
+// -----------------------------------------------------------------------------
+/// Kernel to apply periodic BC along y
+__host__ __device__ inline void ApplyPeriodicBoundaryYKernel_marker(uint index, Real4* posRadD, Real4* rhoPresMuD) {
     Real4 rhoPresMu = rhoPresMuD[index];
     if (fabs(rhoPresMu.w) < .1) {
         return;
@@ -143,33 +150,37 @@ __global__ void ApplyPeriodicBoundaryYKernel(Real4* posRadD, Real4* rhoPresMuD)
     Real3 posRad = mR3(posRadD[index]);
     Real h = posRadD[index].w;
 
-    if (posRad.y > paramsD.cMax.y) {
-        posRad.y -= (paramsD.cMax.y - paramsD.cMin.y);
+    if (posRad.y > Params().cMax.y) {
+        posRad.y -= (Params().cMax.y - Params().cMin.y);
         posRadD[index] = mR4(posRad, h);
         if (rhoPresMu.w < -.1) {
-            rhoPresMu.y = rhoPresMu.y + paramsD.deltaPress.y;
+            rhoPresMu.y = rhoPresMu.y + Params().deltaPress.y;
             rhoPresMuD[index] = rhoPresMu;
         }
         return;
     }
-    if (posRad.y < paramsD.cMin.y) {
-        posRad.y += (paramsD.cMax.y - paramsD.cMin.y);
+    if (posRad.y < Params().cMin.y) {
+        posRad.y += (Params().cMax.y - Params().cMin.y);
         posRadD[index] = mR4(posRad, h);
         if (rhoPresMu.w < -.1) {
-            rhoPresMu.y = rhoPresMu.y - paramsD.deltaPress.y;
+            rhoPresMu.y = rhoPresMu.y - Params().deltaPress.y;
             rhoPresMuD[index] = rhoPresMu;
         }
         return;
     }
 }
 
-// -----------------------------------------------------------------------------
-/// Kernel to apply periodic BC along z
-__global__ void ApplyPeriodicBoundaryZKernel(Real4* posRadD, Real4* rhoPresMuD) {
+__global__ void ApplyPeriodicBoundaryYKernel(Real4* posRadD, Real4* rhoPresMuD) {
     uint index = blockIdx.x * blockDim.x + threadIdx.x;
-    if (index >= numObjectsD.numAllMarkers) {
+    if (index >= NumObjects().numAllMarkers) {
         return;
     }
+    ApplyPeriodicBoundaryYKernel_marker(index, posRadD, rhoPresMuD);
+}
+
+// -----------------------------------------------------------------------------
+/// Kernel to apply periodic BC along z
+__host__ __device__ inline void ApplyPeriodicBoundaryZKernel_marker(uint index, Real4* posRadD, Real4* rhoPresMuD) {
     Real4 rhoPresMu = rhoPresMuD[index];
     if (fabs(rhoPresMu.w) < .1) {
         return;
@@ -177,54 +188,57 @@ __global__ void ApplyPeriodicBoundaryZKernel(Real4* posRadD, Real4* rhoPresMuD)
     Real3 posRad = mR3(posRadD[index]);
     Real h = posRadD[index].w;
 
-    if (posRad.z > paramsD.cMax.z) {
-        posRad.z -= (paramsD.cMax.z - paramsD.cMin.z);
+    if (posRad.z > Params().cMax.z) {
+        posRad.z -= (Params().cMax.z - Params().cMin.z);
         posRadD[index] = mR4(posRad, h);
         if (rhoPresMu.w < -.1) {
-            rhoPresMu.y = rhoPresMu.y + paramsD.deltaPress.z;
+            rhoPresMu.y = rhoPresMu.y + Params().deltaPress.z;
             rhoPresMuD[index] = rhoPresMu;
         }
         return;
     }
-    if (posRad.z < paramsD.cMin.z) {
-        posRad.z += (paramsD.cMax.z - paramsD.cMin.z);
+    if (posRad.z < Params().cMin.z) {
+        posRad.z += (Params().cMax.z - Params().cMin.z);
         posRadD[index] = mR4(posRad, h);
         if (rhoPresMu.w < -.1) {
-            rhoPresMu.y = rhoPresMu.y - paramsD.deltaPress.z;
+            rhoPresMu.y = rhoPresMu.y - Params().deltaPress.z;
             rhoPresMuD[index] = rhoPresMu;
         }
         return;
     }
 }
+
+__global__ void ApplyPeriodicBoundaryZKernel(Real4* posRadD, Real4* rhoPresMuD) {
+    uint index = blockIdx.x * blockDim.x + threadIdx.x;
+    if (index >= NumObjects().numAllMarkers) {
+        return;
+    }
+    ApplyPeriodicBoundaryZKernel_marker(index, posRadD, rhoPresMuD);
+}
 // -----------------------------------------------------------------------------
 /// Kernel to update the fluid properities.
 /// It updates the density, velocity and position relying on explicit Euler
 /// scheme. Pressure is obtained from the density and an Equation of State.
-__global__ void UpdateFluidD(Real4* posRadD,
-                             Real3* velMasD,
-                             Real3* vel_XSPH_D,
-                             Real4* rhoPresMuD,
-                             Real4* derivVelRhoD,
-                             Real3* tauXxYyZzD,       
-                             Real3* tauXyXzYzD,       
-                             Real3* derivTauXxYyZzD,  
-                             Real3* derivTauXyXzYzD,  
-                             Real4* sr_tau_I_mu_iD,   
-                             int2 updatePortion,
-                             Real dT,
-                             volatile bool* isErrorD) {
-    uint index = blockIdx.x * blockDim.x + threadIdx.x;
-    index += updatePortion.x;  // updatePortion = [start, end] index of the update portion
-    if (index >= updatePortion.y) {
-        return;
-    }
-
+__host__ __device__ inline void UpdateFluidD_marker(uint index,
+                                                    Real4* posRadD,
+                                                    Real3* velMasD,
+                                                    Real3* vel_XSPH_D,
+                                                    Real4* rhoPresMuD,
+                                                    Real4* derivVelRhoD,
+                                                    Real3* tauXxYyZzD,
+                                                    Real3* tauXyXzYzD,
+                                                    Real3* derivTauXxYyZzD,
+                                                    Real3* derivTauXyXzYzD,
+                                                    Real4* sr_tau_I_mu_iD,
+                                                    int2 updatePortion,
+                                                    Real dT,
+                                                    volatile bool* isErrorD) {
     Real4 derivVelRho = derivVelRhoD[index];
     Real4 rhoPresMu = rhoPresMuD[index];
 
     if (rhoPresMu.w < 0) {
         Real h = posRadD[index].w;
-        if(paramsD.elastic_SPH){
+        if(Params().elastic_SPH){
             //--------------------------------
             // ** shear stress tau 
             //--------------------------------
@@ -248,17 +262,17 @@ __global__ void UpdateFluidD(Real4* posRadD,
             Real Chi = abs(tau_tr - tau_n) / dT;  // should use the positive magnitude according to "A constitutive law for
                                                 // dense granular flows" Nature 2006
             if (p_tr > 0.0e0) {
-                Real mu_s = paramsD.mu_fric_s;
-                Real mu_2 = paramsD.mu_fric_2;
+                Real mu_s = Params().mu_fric_s;
+                Real mu_2 = Params().mu_fric_2;
                 // Real s_0 = mu_s * p_tr;
                 // Real s_2 = mu_2 * p_tr;
                 // Real xi = 1.1;
-                Real dia = paramsD.ave_diam;
-                Real I0 = paramsD.mu_I0;  // xi*dia*sqrt(rhoPresMu.x);
-                Real I = Chi * dia * sqrt(paramsD.rho0 / p_tr);
+                Real dia = Params().ave_diam;
+                Real I0 = Params().mu_I0;  // xi*dia*sqrt(rhoPresMu.x);
+                Real I = Chi * dia * sqrt(Params().rho0 / p_tr);
                 Real mu = mu_s + (mu_2 - mu_s) / (I0 / (I + 1.0E-9) + 1.0);
-                // Real G0 = paramsD.G_shear;
-                // Real alpha = xi*G0*I0*(paramsD.dT)*sqrt(p_tr);
+                // Real G0 = Params().G_shear;
+                // Real alpha = xi*G0*I0*(Params().dT)*sqrt(p_tr);
                 // Real B0 = s_2 + tau_tr + alpha;
                 // Real H0 = s_2*tau_tr + s_0*alpha;
                 // Real tau_n1 = (B0+sqrt(B0*B0-4*H0))/(2*H0+1e-9);
@@ -267,7 +281,7 @@ __global__ void UpdateFluidD(Real4* posRadD,
                 //     updatedTauXxYyZz = updatedTauXxYyZz*coeff;
                 //     updatedTauXyXzYz = updatedTauXyXzYz*coeff;
                 // }
-                Real tau_max = p_tr * mu;  // p_tr*paramsD.Q_FA; //
+                Real tau_max = p_tr * mu;  // p_tr*Params().Q_FA; //
                 if (tau_tr > tau_max) {    // should use tau_max instead of s_0 according to "A constitutive law for dense
                                         // granular flows" Nature 2006
                     Real coeff = tau_max / (tau_tr + 1e-9);
@@ -290,7 +304,7 @@ __global__ void UpdateFluidD(Real4* posRadD,
         //-------------
         // ** position
         //-------------
-        Real3 vel_XSPH = velMasD[index] + paramsD.EPS_XSPH * vel_XSPH_D[index];
+        Real3 vel_XSPH = velMasD[index] + Params().EPS_XSPH * vel_XSPH_D[index];
         Real3 posRad = mR3(posRadD[index]);
         Real3 updatedPositon = posRad + vel_XSPH * dT;
         if (!(isfinite(updatedPositon.x) && isfinite(updatedPositon.y) && isfinite(updatedPositon.z))) {
@@ -305,7 +319,7 @@ __global__ void UpdateFluidD(Real4* posRadD,
         //-------------
         // Note that the velocity update should not use the XSPH contribution
         // It adds dissipation to the solution, and provides numerical damping
-        Real3 velMas = velMasD[index] + 0.0 * vel_XSPH_D[index];// paramsD.EPS_XSPH * vel_XSPH_D[index]
+        Real3 velMas = velMasD[index] + 0.0 * vel_XSPH_D[index];// Params().EPS_XSPH * vel_XSPH_D[index]
         Real3 updatedVelocity = velMas + mR3(derivVelRho) * dT;  
         velMasD[index] = updatedVelocity;
 
@@ -326,8 +340,51 @@ __global__ void UpdateFluidD(Real4* posRadD,
     /// Important note: the derivVelRhoD that is calculated by the ChForceExplicitSPH is the negative of actual time
     /// derivative. That is important to keep the derivVelRhoD to be the force/mass for fsi forces.
     // calculate the force that is f=m dv/dt
-    derivVelRhoD[index] *= paramsD.markerMass;
+    derivVelRhoD[index] *= Params().markerMass;
+}
+
+__global__ void UpdateFluidD(Real4* posRadD,
+                             Real3* velMasD,
+                             Real3* vel_XSPH_D,
+                             Real4* rhoPresMuD,
+                             Real4* derivVelRhoD,
+                             Real3* tauXxYyZzD,       
+                             Real3* tauXyXzYzD,       
+                             Real3* derivTauXxYyZzD,  
+                             Real3* derivTauXyXzYzD,  
+                             Real4* sr_tau_I_mu_iD,   
+                             int2 updatePortion,
+                             Real dT,
+                             volatile bool* isErrorD) {
+    uint index = blockIdx.x * blockDim.x + threadIdx.x;
+    index += updatePortion.x;  // updatePortion = [start, end] index of the update portion
+    if (index >= updatePortion.y) {
+        return;
+    }
+    UpdateFluidD_marker(index, posRadD, velMasD, vel_XSPH_D, rhoPresMuD, derivVelRhoD, tauXxYyZzD, tauXyXzYzD,
+                        derivTauXxYyZzD, derivTauXyXzYzD, sr_tau_I_mu_iD, updatePortion, dT, isErrorD);
+}
+
+#ifdef CHRONO_FSI_USE_CPU
+/// Host version of UpdateFluidD for the CPU backend (index is relative to the start of the update portion).
+inline void UpdateFluidH(uint index,
+                         Real4* posRadD,
+                         Real3* velMasD,
+                         Real3* vel_XSPH_D,
+                         Real4* rhoPresMuD,
+                         Real4* derivVelRhoD,
+                         Real3* tauXxYyZzD,
+                         Real3* tauXyXzYzD,
+                         Real3* derivTauXxYyZzD,
+                         Real3* derivTauXyXzYzD,
+                         Real4* sr_tau_I_mu_iD,
+                         int2 updatePortion,
+                         Real dT,
+                         volatile bool* isErrorD) {
+    UpdateFluidD_marker(index + updatePortion.x, posRadD, velMasD, vel_XSPH_D, rhoPresMuD, derivVelRhoD, tauXxYyZzD,
+                        tauXyXzYzD, derivTauXxYyZzD, derivTauXyXzYzD, sr_tau_I_mu_iD, updatePortion, dT, isErrorD);
 }
+#endif
 
 //------------------------------------------------------------------------------
 __global__ void Update_Fluid_State(Real3* new_vel,  // input: sorted velocities,
@@ -346,7 +403,7 @@ __global__ void Update_Fluid_State(Real3* new_vel,  // input: sorted velocities,
 
     //  sortedPosRad[i_idx] = new_Pos[i_idx];
     velMas[i_idx] = new_vel[i_idx];
-    //    velMas[i_idx] = paramsD.EPS_XSPH * vis_vel[i_idx] + (1 - paramsD.EPS_XSPH) * new_vel[i_idx];
+    //    velMas[i_idx] = Params().EPS_XSPH * vis_vel[i_idx] + (1 - Params().EPS_XSPH) * new_vel[i_idx];
     //    printf(" %d vel %f,%f,%f\n", i_idx, vis_vel[i_idx].x, vis_vel[i_idx].y, vis_vel[i_idx].z);
 
     Real3 newpos = mR3(posRad[i_idx]) + dT * velMas[i_idx];
@@ -372,18 +429,15 @@ __global__ void Update_Fluid_State(Real3* new_vel,  // input: sorted velocities,
 /// Kernel for updating the density.
 /// It calculates the density of the markers. It does include the normalization
 /// close to the boundaries and free surface.
-__global__ void ReCalcDensityD_F1(Real4* dummySortedRhoPreMu,
-                                  Real4* sortedPosRad,
-                                  Real3* sortedVelMas,
-                                  Real4* sortedRhoPreMu,
-                                  uint* gridMarkerIndex,
-                                  uint* cellStart,
-                                  uint* cellEnd,
-                                  size_t numAllMarkers) {
-    uint index = __mul24(blockIdx.x, blockDim.x) + threadIdx.x;
-    if (index >= numAllMarkers)
-        return;
-
+__host__ __device__ inline void ReCalcDensityD_F1_marker(uint index,
+                                                         Real4* dummySortedRhoPreMu,
+                                                         Real4* sortedPosRad,
+                                                         Real3* sortedVelMas,
+                                                         Real4* sortedRhoPreMu,
+                                                         uint* gridMarkerIndex,
+                                                         uint* cellStart,
+                                                         uint* cellEnd,
+                                                         size_t numAllMarkers) {
     // read particle data from sorted arrays
     Real3 posRadA = mR3(sortedPosRad[index]);
     Real4 rhoPreMuA = sortedRhoPreMu[index];
@@ -413,6 +467,21 @@ __global__ void ReCalcDensityD_F1(Real4* dummySortedRhoPreMu,
     dummySortedRhoPreMu[index] = rhoPreMuA;
 }
 
+__global__ void ReCalcDensityD_F1(Real4* dummySortedRhoPreMu,
+                                  Real4* sortedPosRad,
+                                  Real3* sortedVelMas,
+                                  Real4* sortedRhoPreMu,
+                                  uint* gridMarkerIndex,
+                                  uint* cellStart,
+                                  uint* cellEnd,
+                                  size_t numAllMarkers) {
+    uint index = __mul24(blockIdx.x, blockDim.x) + threadIdx.x;
+    if (index >= numAllMarkers)
+        return;
+    ReCalcDensityD_F1_marker(index, dummySortedRhoPreMu, sortedPosRad, sortedVelMas, sortedRhoPreMu, gridMarkerIndex,
+                             cellStart, cellEnd, numAllMarkers);
+}
+
 // -----------------------------------------------------------------------------
 // CLASS FOR FLUID DYNAMICS SYSTEM
 // -----------------------------------------------------------------------------
@@ -461,9 +530,14 @@ ChFluidDynamics::ChFluidDynamics(std::shared_ptr<ChBce> otherBceWorker,
 void ChFluidDynamics::Finalize() {
     printf("ChFluidDynamics::Finalize()\n");
     forceSystem->Finalize();
+#ifdef CHRONO_FSI_USE_CPU
+    paramsH_CPU = *paramsH;
+    numObjectsH_CPU = *numObjectsH;
+#else
     cudaMemcpyToSymbolAsync(paramsD, paramsH.get(), sizeof(SimParams));
     cudaMemcpyToSymbolAsync(numObjectsD, numObjectsH.get(), sizeof(NumberOfObjects));
     cudaMemcpyFromSymbol(paramsH.get(), paramsD, sizeof(SimParams));
+#endif
 }
 
 // -----------------------------------------------------------------------------
@@ -504,10 +578,17 @@ void ChFluidDynamics::UpdateFluid(std::shared_ptr<SphMarkerDataD> sphMarkersD, R
 
     bool *isErrorH, *isErrorD;
     isErrorH = (bool*)malloc(sizeof(bool));
-    cudaMalloc((void**)&isErrorD, sizeof(bool));
+    isErrorD = ChUtilsDevice::CreateErrorFlag();
     *isErrorH = false;
-    cudaMemcpy(isErrorD, isErrorH, sizeof(bool), cudaMemcpyHostToDevice);
     //------------------------
+#ifdef CHRONO_FSI_USE_CPU
+    ForEachMarker(updatePortion.y - updatePortion.x, UpdateFluidH, mR4CAST(sphMarkersD->posRadD),
+                  mR3CAST(sphMarkersD->velMasD), mR3CAST(fsiData->fsiGeneralData->vel_XSPH_D),
+                  mR4CAST(sphMarkersD->rhoPresMuD), mR4CAST(fsiData->fsiGeneralData->derivVelRhoD_old),
+                  mR3CAST(sphMarkersD->tauXxYyZzD), mR3CAST(sphMarkersD->tauXyXzYzD),
+                  mR3CAST(fsiData->fsiGeneralData->derivTauXxYyZzD), mR3CAST(fsiData->fsiGeneralData->derivTauXyXzYzD),
+                  mR4CAST(fsiData->fsiGeneralData->sr_tau_I_mu_i), updatePortion, dT, isErrorD);
+#else
     uint nBlock_UpdateFluid, nThreads;
     computeGridSize(updatePortion.y - updatePortion.x, 128, nBlock_UpdateFluid, nThreads);
     UpdateFluidD<<<nBlock_UpdateFluid, nThreads>>>(
@@ -521,15 +602,19 @@ void ChFluidDynamics::UpdateFluid(std::shared_ptr<SphMarkerDataD> sphMarkersD, R
         updatePortion, dT, isErrorD);
     cudaDeviceSynchronize();
     cudaCheckError();
+#endif
     //------------------------
-    cudaMemcpy(isErrorH, isErrorD, sizeof(bool), cudaMemcpyDeviceToHost);
+    *isErrorH = ChUtilsDevice::GetErrorFlag(isErrorD);
     if (*isErrorH == true) {
         throw std::runtime_error("Error! program crashed in  UpdateFluidD!\n");
     }
-    cudaFree(isErrorD);
+    ChUtilsDevice::FreeErrorFlag(isErrorD);
     free(isErrorH);
 }
 void ChFluidDynamics::UpdateFluid_Implicit(std::shared_ptr<SphMarkerDataD> sphMarkersD) {
+#ifdef CHRONO_FSI_USE_CPU
+    throw std::runtime_error("Error! Implicit SPH is not available with the CPU backend of Chrono::FSI.\n");
+#endif
     uint numThreads, numBlocks;
     computeGridSize((int)numObjectsH->numAllMarkers, 256, numBlocks, numThreads);
 
@@ -575,6 +660,15 @@ void ChFluidDynamics::UpdateFluid_Implicit(std::shared_ptr<SphMarkerDataD> sphMa
  * 		applies periodic boundary conditions in x,y, and z directions
  */
 void ChFluidDynamics::ApplyBoundarySPH_Markers(std::shared_ptr<SphMarkerDataD> sphMarkersD) {
+#ifdef CHRONO_FSI_USE_CPU
+    uint numAllMarkers = (uint)numObjectsH->numAllMarkers;
+    ForEachMarker(numAllMarkers, ApplyPeriodicBoundaryXKernel_marker, mR4CAST(sphMarkersD->posRadD),
+                  mR4CAST(sphMarkersD->rhoPresMuD));
+    ForEachMarker(numAllMarkers, ApplyPeriodicBoundaryYKernel_marker, mR4CAST(sphMarkersD->posRadD),
+                  mR4CAST(sphMarkersD->rhoPresMuD));
+    ForEachMarker(numAllMarkers, ApplyPeriodicBoundaryZKernel_marker, mR4CAST(sphMarkersD->posRadD),
+                  mR4CAST(sphMarkersD->rhoPresMuD));
+#else
     uint nBlock_NumSpheres, nThreads_SphMarkers;
     computeGridSize((int)numObjectsH->numAllMarkers, 256, nBlock_NumSpheres, nThreads_SphMarkers);
     ApplyPeriodicBoundaryXKernel<<<nBlock_NumSpheres, nThreads_SphMarkers>>>(mR4CAST(sphMarkersD->posRadD),
@@ -593,6 +687,7 @@ void ChFluidDynamics::ApplyBoundarySPH_Markers(std::shared_ptr<SphMarkerDataD> s
     //    SetOutputPressureToZero_X<<<nBlock_NumSpheres, nThreads_SphMarkers>>>(mR3CAST(posRadD), mR4CAST(rhoPresMuD));
     //    cudaDeviceSynchronize();
     //    cudaCheckError();
+#endif
 }
 
 // -----------------------------------------------------------------------------
@@ -606,6 +701,15 @@ void ChFluidDynamics::ApplyBoundarySPH_Markers(std::shared_ptr<SphMarkerDataD> s
  * 		This functions needs to be tested.
  */
 void ChFluidDynamics::ApplyModifiedBoundarySPH_Markers(std::shared_ptr<SphMarkerDataD> sphMarkersD) {
+#ifdef CHRONO_FSI_USE_CPU
+    uint numAllMarkers = (uint)numObjectsH->numAllMarkers;
+    ForEachMarker(numAllMarkers, ApplyInletBoundaryXKernel_marker, mR4CAST(sphMarkersD->posRadD),
+                  mR3CAST(sphMarkersD->velMasD), mR4CAST(sphMarkersD->rhoPresMuD));
+    ForEachMarker(numAllMarkers, ApplyPeriodicBoundaryYKernel_marker, mR4CAST(sphMarkersD->posRadD),
+                  mR4CAST(sphMarkersD->rhoPresMuD));
+    ForEachMarker(numAllMarkers, ApplyPeriodicBoundaryZKernel_marker, mR4CAST(sphMarkersD->posRadD),
+                  mR4CAST(sphMarkersD->rhoPresMuD));
+#else
     uint nBlock_NumSpheres, nThreads_SphMarkers;
     computeGridSize((int)numObjectsH->numAllMarkers, 256, nBlock_NumSpheres, nThreads_SphMarkers);
     ApplyInletBoundaryXKernel<<<nBlock_NumSpheres, nThreads_SphMarkers>>>(
@@ -621,6 +725,7 @@ void ChFluidDynamics::ApplyModifiedBoundarySPH_Markers(std::shared_ptr<SphMarker
                                                                              mR4CAST(sphMarkersD->rhoPresMuD));
     cudaDeviceSynchronize();
     cudaCheckError();
+#endif
 }
 // -----------------------------------------------------------------------------
 
@@ -633,6 +738,13 @@ void ChFluidDynamics::DensityReinitialization() {
     thrust::device_vector<Real4> dummySortedRhoPreMu(numObjectsH->numAllMarkers);
     thrust::fill(dummySortedRhoPreMu.begin(), dummySortedRhoPreMu.end(), mR4(0.0));
 
+#ifdef CHRONO_FSI_USE_CPU
+    ForEachMarker((uint)numObjectsH->numAllMarkers, ReCalcDensityD_F1_marker, mR4CAST(dummySortedRhoPreMu),
+                  mR4CAST(fsiData->sortedSphMarkersD->posRadD), mR3CAST(fsiData->sortedSphMarkersD->velMasD),
+                  mR4CAST(fsiData->sortedSphMarkersD->rhoPresMuD),
+                  U1CAST(fsiData->markersProximityD->gridMarkerIndexD), U1CAST(fsiData->markersProximityD->cellStartD),
+                  U1CAST(fsiData->markersProximityD->cellEndD), numObjectsH->numAllMarkers);
+#else
     ReCalcDensityD_F1<<<nBlock_NumSpheres, nThreads_SphMarkers>>>(
         mR4CAST(dummySortedRhoPreMu), mR4CAST(fsiData->sortedSphMarkersD->posRadD),
         mR3CAST(fsiData->sortedSphMarkersD->velMasD), mR4CAST(fsiData->sortedSphMarkersD->rhoPresMuD),
@@ -641,6 +753,7 @@ void ChFluidDynamics::DensityReinitialization() {
 
     cudaDeviceSynchronize();
     cudaCheckError();
+#endif
     ChFsiForce::CopySortedToOriginal_NonInvasive_R4(fsiData->sphMarkersD1->rhoPresMuD, dummySortedRhoPreMu,
                                                     fsiData->markersProximityD->gridMarkerIndexD);
     ChFsiForce::CopySortedToOriginal_NonInvasive_R4(fsiData->sphMarkersD2->rhoPresMuD, dummySortedRhoPreMu,
@@ -43,8 +43,13 @@ ChFsiForce::ChFsiForce(std::shared_ptr<ChBce> otherBceWorker,
 //--------------------------------------------------------------------------------------------------------------------------------
 
 void ChFsiForce::Finalize() {
+#ifdef CHRONO_FSI_USE_CPU
+    paramsH_CPU = *paramsH;
+    numObjectsH_CPU = *numObjectsH;
+#else
     cudaMemcpyToSymbolAsync(paramsD, paramsH.get(), sizeof(SimParams));
     cudaMemcpyToSymbolAsync(numObjectsD, numObjectsH.get(), sizeof(NumberOfObjects));
+#endif
     printf("ChFsiForce::Finalize() numAllMarkers=%zd\n", numObjectsH->numAllMarkers);
 
     vel_XSPH_Sorted_D.resize(numObjectsH->numAllMarkers);
@@ -20,24 +20,20 @@ namespace chrono {
 namespace fsi {
 
 //--------------------------------------------------------------------------------------------------------------------------------
-__global__ void Shear_Stress_Rate(Real4* sortedPosRad,
-                                  Real4* sortedRhoPreMu,
-                                  Real3* sortedVelMas,
-                                  Real3* velMas_ModifiedBCE,
-                                  Real4* rhoPreMu_ModifiedBCE,
-                                  Real3* sortedTauXxYyZz,
-                                  Real3* sortedTauXyXzYz,
-                                  Real3* sortedDerivTauXxYyZz,
-                                  Real3* sortedDerivTauXyXzYz,
-                                  uint* gridMarkerIndex,
-                                  uint* cellStart,
-                                  uint* cellEnd,
-                                  const size_t numAllMarkers) {
-    uint index = blockIdx.x * blockDim.x + threadIdx.x;
-    if (index >= numAllMarkers) {
-        return;
-    }
-
+__host__ __device__ inline void Shear_Stress_Rate_marker(uint index,
+                                                         Real4* sortedPosRad,
+                                                         Real4* sortedRhoPreMu,
+                                                         Real3* sortedVelMas,
+                                                         Real3* velMas_ModifiedBCE,
+                                                         Real4* rhoPreMu_ModifiedBCE,
+                                                         Real3* sortedTauXxYyZz,
+                                                         Real3* sortedTauXyXzYz,
+                                                         Real3* sortedDerivTauXxYyZz,
+                                                         Real3* sortedDerivTauXyXzYz,
+                                                         uint* gridMarkerIndex,
+                                                         uint* cellStart,
+                                                         uint* cellEnd,
+                                                         const size_t numAllMarkers) {
     Real3 posRadA = mR3(sortedPosRad[index]);
     Real3 velMasA = sortedVelMas[index];
     Real hA = sortedPosRad[index].w;
@@ -73,14 +69,14 @@ __global__ void Shear_Stress_Rate(Real4* sortedPosRad,
                         Real3 dist3 = Distance(posRadA, posRadB);
                         Real d = length(dist3);
 
-                        if (d > RESOLUTION_LENGTH_MULT * paramsD.HSML)
+                        if (d > RESOLUTION_LENGTH_MULT * Params().HSML)
                             continue;
                         Real3 velMasB = sortedVelMas[j];
                         Real4 rhoPresMuB = sortedRhoPreMu[j];
                         if (rhoPresMuB.w > -1.0) {
-                            int bceIndexB = gridMarkerIndex[j] - (numObjectsD.numFluidMarkers);
+                            int bceIndexB = gridMarkerIndex[j] - (NumObjects().numFluidMarkers);
                             if (!(bceIndexB >= 0 &&
-                                  bceIndexB < numObjectsD.numBoundaryMarkers + numObjectsD.numRigid_SphMarkers)) {
+                                  bceIndexB < NumObjects().numBoundaryMarkers + NumObjects().numRigid_SphMarkers)) {
                                 printf("Error! bceIndex out of bound, collideCell !\n");
                             }
                             rhoPresMuB = rhoPreMu_ModifiedBCE[bceIndexB];
@@ -88,10 +84,10 @@ __global__ void Shear_Stress_Rate(Real4* sortedPosRad,
                         }
                         Real rhoB = rhoPresMuB.x;
                         Real hB = sortedPosRad[j].w;
-                        Real mB = paramsD.markerMass;
+                        Real mB = Params().markerMass;
                         Real3 gradW = GradWh(dist3, (hA + hB) * 0.5);
                         // start to calculate the rate
-                        Real Gm = paramsD.G_shear;  // shear modulus of the material
+                        Real Gm = Params().G_shear;  // shear modulus of the material
                         Real half_mB_over_rhoB = 0.5 * (mB / rhoB);
                         // entries of strain rate tensor
                         Real exx = -half_mB_over_rhoB *
@@ -142,20 +138,39 @@ __global__ void Shear_Stress_Rate(Real4* sortedPosRad,
     sortedDerivTauXyXzYz[index] = mR3(dTauxy, dTauxz, dTauyz);
 }
 
-//--------------------------------------------------------------------------------------------------------------------------------
-__global__ void calcRho_kernel(Real4* sortedPosRad,
-                               Real4* sortedRhoPreMu,
-                               Real4* sortedRhoPreMu_old,
-                               Real* _sumWij_rhoi,
-                               uint* cellStart,
-                               uint* cellEnd,
-                               const size_t numAllMarkers,
-                               int density_reinit,
-                               volatile bool* isErrorD) {
-    uint i_idx = blockIdx.x * blockDim.x + threadIdx.x;
-    if (i_idx >= numAllMarkers) {
+__global__ void Shear_Stress_Rate(Real4* sortedPosRad,
+                                  Real4* sortedRhoPreMu,
+                                  Real3* sortedVelMas,
+                                  Real3* velMas_ModifiedBCE,
+                                  Real4* rhoPreMu_ModifiedBCE,
+                                  Real3* sortedTauXxYyZz,
+                                  Real3* sortedTauXyXzYz,
+                                  Real3* sortedDerivTauXxYyZz,
+                                  Real3* sortedDerivTauXyXzYz,
+                                  uint* gridMarkerIndex,
+                                  uint* cellStart,
+                                  uint* cellEnd,
+                                  const size_t numAllMarkers) {
+    uint index = blockIdx.x * blockDim.x + threadIdx.x;
+    if (index >= numAllMarkers) {
         return;
     }
+    Shear_Stress_Rate_marker(index, sortedPosRad, sortedRhoPreMu, sortedVelMas, velMas_ModifiedBCE,
+                             rhoPreMu_ModifiedBCE, sortedTauXxYyZz, sortedTauXyXzYz, sortedDerivTauXxYyZz,
+                             sortedDerivTauXyXzYz, gridMarkerIndex, cellStart, cellEnd, numAllMarkers);
+}
+
+//--------------------------------------------------------------------------------------------------------------------------------
+__host__ __device__ inline void calcRho_kernel_marker(uint i_idx,
+                                                      Real4* sortedPosRad,
+                                                      Real4* sortedRhoPreMu,
+                                                      Real4* sortedRhoPreMu_old,
+                                                      Real* _sumWij_rhoi,
+                                                      uint* cellStart,
+                                                      uint* cellEnd,
+                                                      const size_t numAllMarkers,
+                                                      int density_reinit,
+                                                      volatile bool* isErrorD) {
     sortedRhoPreMu_old[i_idx].y = Eos(sortedRhoPreMu_old[i_idx].x, sortedRhoPreMu_old[i_idx].w);
 
     Real3 posRadA = mR3(sortedPosRad[i_idx]);
@@ -183,7 +198,7 @@ __global__ void calcRho_kernel(Real4* sortedPosRad,
                             continue;
                         if (sortedRhoPreMu_old[j].w == -1) {  //
                             Real h_j = sortedPosRad[j].w;
-                            Real m_j = paramsD.markerMass;  // pow(h_j * paramsD.MULT_INITSPACE, 3) * paramsD.rho0;
+                            Real m_j = Params().markerMass;  // pow(h_j * Params().MULT_INITSPACE, 3) * Params().rho0;
                             Real W3 = W3h(d, 0.5 * (h_j + h_i));
                             sum_mW += m_j * W3;
                             sum_W += W3;
@@ -194,33 +209,50 @@ __global__ void calcRho_kernel(Real4* sortedPosRad,
             }
         }
     }
-    //    sumWij_inv[i_idx] = paramsD.markerMass / sum_mW;
+    //    sumWij_inv[i_idx] = Params().markerMass / sum_mW;
 
     // sortedRhoPreMu[i_idx].x = sum_mW;
     if ((density_reinit == 0) && (sortedRhoPreMu[i_idx].w == -1))
         sortedRhoPreMu[i_idx].x = sum_mW / sum_mW_rho;
 
-    if ((sortedRhoPreMu[i_idx].x > 3 * paramsD.rho0 || sortedRhoPreMu[i_idx].x < 0.01 * paramsD.rho0) &&
+    if ((sortedRhoPreMu[i_idx].x > 3 * Params().rho0 || sortedRhoPreMu[i_idx].x < 0.01 * Params().rho0) &&
         sortedRhoPreMu[i_idx].w == -1)
         printf("(calcRho_kernel)density marker %d, sum_mW=%f, sum_W=%f, h_i=%f\n", i_idx, sum_mW, sum_W, h_i);
 }
 
+__global__ void calcRho_kernel(Real4* sortedPosRad,
+                               Real4* sortedRhoPreMu,
+                               Real4* sortedRhoPreMu_old,
+                               Real* _sumWij_rhoi,
+                               uint* cellStart,
+                               uint* cellEnd,
+                               const size_t numAllMarkers,
+                               int density_reinit,
+                               volatile bool* isErrorD) {
+    uint i_idx = blockIdx.x * blockDim.x + threadIdx.x;
+    if (i_idx >= numAllMarkers) {
+        return;
+    }
+    calcRho_kernel_marker(i_idx, sortedPosRad, sortedRhoPreMu, sortedRhoPreMu_old, _sumWij_rhoi, cellStart, cellEnd,
+                          numAllMarkers, density_reinit, isErrorD);
+}
+
 //--------------------------------------------------------------------------------------------------------------------------------
 // modify pressure for body force
-__device__ __inline__ void modifyPressure(Real4& rhoPresMuB, const Real3& dist3Alpha) {
+__host__ __device__ __inline__ void modifyPressure(Real4& rhoPresMuB, const Real3& dist3Alpha) {
     // body force in x direction
-    rhoPresMuB.y = (dist3Alpha.x > 0.5 * paramsD.boxDims.x) ? (rhoPresMuB.y - paramsD.deltaPress.x) : rhoPresMuB.y;
-    rhoPresMuB.y = (dist3Alpha.x < -0.5 * paramsD.boxDims.x) ? (rhoPresMuB.y + paramsD.deltaPress.x) : rhoPresMuB.y;
+    rhoPresMuB.y = (dist3Alpha.x > 0.5 * Params().boxDims.x) ? (rhoPresMuB.y - Params().deltaPress.x) : rhoPresMuB.y;
+    rhoPresMuB.y = (dist3Alpha.x < -0.5 * Params().boxDims.x) ? (rhoPresMuB.y + Params().deltaPress.x) : rhoPresMuB.y;
     // body force in x direction
-    rhoPresMuB.y = (dist3Alpha.y > 0.5 * paramsD.boxDims.y) ? (rhoPresMuB.y - paramsD.deltaPress.y) : rhoPresMuB.y;
-    rhoPresMuB.y = (dist3Alpha.y < -0.5 * paramsD.boxDims.y) ? (rhoPresMuB.y + paramsD.deltaPress.y) : rhoPresMuB.y;
+    rhoPresMuB.y = (dist3Alpha.y > 0.5 * Params().boxDims.y) ? (rhoPresMuB.y - Params().deltaPress.y) : rhoPresMuB.y;
+    rhoPresMuB.y = (dist3Alpha.y < -0.5 * Params().boxDims.y) ? (rhoPresMuB.y + Params().deltaPress.y) : rhoPresMuB.y;
     // body force in x direction
-    rhoPresMuB.y = (dist3Alpha.z > 0.5 * paramsD.boxDims.z) ? (rhoPresMuB.y - paramsD.deltaPress.z) : rhoPresMuB.y;
-    rhoPresMuB.y = (dist3Alpha.z < -0.5 * paramsD.boxDims.z) ? (rhoPresMuB.y + paramsD.deltaPress.z) : rhoPresMuB.y;
+    rhoPresMuB.y = (dist3Alpha.z > 0.5 * Params().boxDims.z) ? (rhoPresMuB.y - Params().deltaPress.z) : rhoPresMuB.y;
+    rhoPresMuB.y = (dist3Alpha.z < -0.5 * Params().boxDims.z) ? (rhoPresMuB.y + Params().deltaPress.z) : rhoPresMuB.y;
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
-__device__ inline Real3 CubicSolve(Real aa, Real bb, Real cc, Real dd) {
+__host__ __device__ inline Real3 CubicSolve(Real aa, Real bb, Real cc, Real dd) {
     Real disc, q, r, dum1, dum2, term1, r13;
     bb /= aa;
     cc /= aa;
@@ -228,13 +260,13 @@ __device__ inline Real3 CubicSolve(Real aa, Real bb, Real cc, Real dd) {
     if (aa == 0) {
         return mR3(0, 0, 0);
     }
-    if (abs(bb) < 1e-9) {
+    if (fabs(bb) < 1e-9) {
         return mR3(0, 0, 0);
     }
-    if (abs(cc) < 1e-9) {
+    if (fabs(cc) < 1e-9) {
         return mR3(0, 0, 0);
     }
-    if (abs(dd) < 1e-9) {
+    if (fabs(dd) < 1e-9) {
         return mR3(0, 0, 0);
     }
     q = (3.0 * cc - (bb * bb)) / 9.0;
@@ -307,7 +339,7 @@ __device__ inline Real3 CubicSolve(Real aa, Real bb, Real cc, Real dd) {
 
     return mR3(xRex, xRey, xRez);
 }
-__device__ inline Real3 CubicEigen(Real4 c1, Real4 c2, Real4 c3) {
+__host__ __device__ inline Real3 CubicEigen(Real4 c1, Real4 c2, Real4 c3) {
     Real a = c1.x;
     Real b = c1.y;
     Real c = c1.z;
@@ -369,62 +401,62 @@ __device__ inline Real3 CubicEigen(Real4 c1, Real4 c2, Real4 c3) {
  * @brief DifVelocityRho
  * @details  See SDKCollisionSystem.cuh
  */
-__device__ inline Real4 DifVelocityRho(Real3 dist3,
-                                       Real d,
-                                       Real4 posRadA,
-                                       Real4 posRadB,
-                                       Real3 velMasA,
-                                       Real3 vel_XSPH_A,
-                                       Real3 velMasB,
-                                       Real3 vel_XSPH_B,
-                                       Real4 rhoPresMuA,
-                                       Real4 rhoPresMuB,
-                                       Real multViscosity) {
+__host__ __device__ inline Real4 DifVelocityRho(Real3 dist3,
+                                                Real d,
+                                                Real4 posRadA,
+                                                Real4 posRadB,
+                                                Real3 velMasA,
+                                                Real3 vel_XSPH_A,
+                                                Real3 velMasB,
+                                                Real3 vel_XSPH_B,
+                                                Real4 rhoPresMuA,
+                                                Real4 rhoPresMuB,
+                                                Real multViscosity) {
     Real3 gradW = GradWh(dist3, (posRadA.w + posRadB.w) * 0.5);
 
     //    Real vAB_Dot_rAB = dot(velMasA - velMasB, dist3);
     //
     //    //	//*** Artificial viscosity type 1.1
     //    Real alpha = .001;
-    //    Real c_ab = 10 * paramsD.v_Max;  // Ma = .1;//sqrt(7.0f * 10000 /
+    //    Real c_ab = 10 * Params().v_Max;  // Ma = .1;//sqrt(7.0f * 10000 /
     //                                     //    ((rhoPresMuA.x + rhoPresMuB.x) / 2.0f));
-    //                                     // Real h = paramsD.HSML;
+    //                                     // Real h = Params().HSML;
     //    Real rho = .5f * (rhoPresMuA.x + rhoPresMuB.x);
-    //    Real nu = alpha * paramsD.HSML * c_ab / rho;
+    //    Real nu = alpha * Params().HSML * c_ab / rho;
     //
     //    //*** Artificial viscosity type 1.2
-    //    //    Real nu = 22.8f * paramsD.mu0 / 2.0f / (rhoPresMuA.x * rhoPresMuB.x);
-    //    Real3 derivV = -paramsD.markerMass *
+    //    //    Real nu = 22.8f * Params().mu0 / 2.0f / (rhoPresMuA.x * rhoPresMuB.x);
+    //    Real3 derivV = -Params().markerMass *
     //                   (rhoPresMuA.y / (rhoPresMuA.x * rhoPresMuA.x) + rhoPresMuB.y / (rhoPresMuB.x * rhoPresMuB.x) -
-    //                    nu * vAB_Dot_rAB / (d * d + paramsD.epsMinMarkersDis * paramsD.HSML * paramsD.HSML)) *
+    //                    nu * vAB_Dot_rAB / (d * d + Params().epsMinMarkersDis * Params().HSML * Params().HSML)) *
     //                   gradW;
-    //    return mR4(derivV, rhoPresMuA.x * paramsD.markerMass / rhoPresMuB.x * dot(vel_XSPH_A - vel_XSPH_B, gradW));
+    //    return mR4(derivV, rhoPresMuA.x * Params().markerMass / rhoPresMuB.x * dot(vel_XSPH_A - vel_XSPH_B, gradW));
 
     //*** Artificial viscosity type 2
     if (rhoPresMuA.w > -1 && rhoPresMuB.w > -1)
         return mR4(0.0);
 
     Real rAB_Dot_GradWh = dot(dist3, gradW);
-    Real rAB_Dot_GradWh_OverDist = rAB_Dot_GradWh / (d * d + paramsD.epsMinMarkersDis * paramsD.HSML * paramsD.HSML);
-    Real3 derivV = - paramsD.markerMass *(rhoPresMuA.y / (rhoPresMuA.x * rhoPresMuA.x) + rhoPresMuB.y / (rhoPresMuB.x * rhoPresMuB.x)) * gradW
-                   + paramsD.markerMass * (8.0f * multViscosity) * paramsD.mu0 
+    Real rAB_Dot_GradWh_OverDist = rAB_Dot_GradWh / (d * d + Params().epsMinMarkersDis * Params().HSML * Params().HSML);
+    Real3 derivV = - Params().markerMass *(rhoPresMuA.y / (rhoPresMuA.x * rhoPresMuA.x) + rhoPresMuB.y / (rhoPresMuB.x * rhoPresMuB.x)) * gradW
+                   + Params().markerMass * (8.0f * multViscosity) * Params().mu0 
                    * pow(rhoPresMuA.x + rhoPresMuB.x, Real(-2)) * rAB_Dot_GradWh_OverDist * (velMasA - velMasB);
 
-    //    Real derivRho = rhoPresMuA.x * paramsD.markerMass / rhoPresMuB.x * dot(vel_XSPH_A - vel_XSPH_B, gradW);
+    //    Real derivRho = rhoPresMuA.x * Params().markerMass / rhoPresMuB.x * dot(vel_XSPH_A - vel_XSPH_B, gradW);
     //	Real zeta = 0;//.05;//.1;
-    //	Real derivRho = rhoPresMuA.x * paramsD.markerMass * invrhoPresMuBx *
+    //	Real derivRho = rhoPresMuA.x * Params().markerMass * invrhoPresMuBx *
     //(dot(vel_XSPH_A - vel_XSPH_B, gradW)
-    //			+ zeta * paramsD.HSML * (10 * paramsD.v_Max) * 2 * (rhoPresMuB.x
+    //			+ zeta * Params().HSML * (10 * Params().v_Max) * 2 * (rhoPresMuB.x
     /// rhoPresMuA.x - 1) *
     // rAB_Dot_GradWh_OverDist
     //			);
 
     //--------------------------------
     // Ferrari Modification
-    Real derivRho = paramsD.markerMass * dot(vel_XSPH_A - vel_XSPH_B, gradW);
+    Real derivRho = Params().markerMass * dot(vel_XSPH_A - vel_XSPH_B, gradW);
     //    Real cA = FerrariCi(rhoPresMuA.x);
     //    Real cB = FerrariCi(rhoPresMuB.x);
-    //    derivRho += rAB_Dot_GradWh / (d + paramsD.epsMinMarkersDis * paramsD.HSML) * max(cA, cB) / rhoPresMuB.x *
+    //    derivRho += rAB_Dot_GradWh / (d + Params().epsMinMarkersDis * Params().HSML) * max(cA, cB) / rhoPresMuB.x *
     //                (rhoPresMuB.x - rhoPresMuA.x);
 
     //    --------------------------------
@@ -432,30 +464,30 @@ __device__ inline Real4 DifVelocityRho(Real3 dist3,
 
     //	//*** Artificial viscosity type 1.3
     //    Real rAB_Dot_GradWh = dot(dist3, gradW);
-    //    Real3 derivV = -paramsD.markerMass *
+    //    Real3 derivV = -Params().markerMass *
     //                       (rhoPresMuA.y / (rhoPresMuA.x * rhoPresMuA.x) + rhoPresMuB.y / (rhoPresMuB.x *
     //                       rhoPresMuB.x)) * gradW +
-    //                   paramsD.markerMass / (rhoPresMuA.x * rhoPresMuB.x) * 2.0f * paramsD.mu0 * rAB_Dot_GradWh /
-    //                       (d * d + paramsD.epsMinMarkersDis * paramsD.HSML * paramsD.HSML) * (velMasA - velMasB);
-    //    return mR4(derivV, rhoPresMuA.x * paramsD.markerMass / rhoPresMuB.x * dot(vel_XSPH_A - vel_XSPH_B, gradW));
+    //                   Params().markerMass / (rhoPresMuA.x * rhoPresMuB.x) * 2.0f * Params().mu0 * rAB_Dot_GradWh /
+    //                       (d * d + Params().epsMinMarkersDis * Params().HSML * Params().HSML) * (velMasA - velMasB);
+    //    return mR4(derivV, rhoPresMuA.x * Params().markerMass / rhoPresMuB.x * dot(vel_XSPH_A - vel_XSPH_B, gradW));
 }
 
 /// Only for modelling elastic and granular problems
-__device__ inline Real4 DifVelocityRho_ElasticSPH(Real3 dist3,
-                                                  Real d,
-                                                  Real4 posRadA,
-                                                  Real4 posRadB,
-                                                  Real3 velMasA,
-                                                  Real3 vel_XSPH_A,
-                                                  Real3 velMasB,
-                                                  Real3 vel_XSPH_B,
-                                                  Real4 rhoPresMuA,
-                                                  Real4 rhoPresMuB,
-                                                  Real multViscosity,
-                                                  Real3 tauXxYyZz_A,
-                                                  Real3 tauXyXzYz_A,
-                                                  Real3 tauXxYyZz_B,
-                                                  Real3 tauXyXzYz_B) {
+__host__ __device__ inline Real4 DifVelocityRho_ElasticSPH(Real3 dist3,
+                                                           Real d,
+                                                           Real4 posRadA,
+                                                           Real4 posRadB,
+                                                           Real3 velMasA,
+                                                           Real3 vel_XSPH_A,
+                                                           Real3 velMasB,
+                                                           Real3 vel_XSPH_B,
+                                                           Real4 rhoPresMuA,
+                                                           Real4 rhoPresMuB,
+                                                           Real multViscosity,
+                                                           Real3 tauXxYyZz_A,
+                                                           Real3 tauXyXzYz_A,
+                                                           Real3 tauXxYyZz_B,
+                                                           Real3 tauXyXzYz_B) {
     Real3 gradW = GradWh(dist3, (posRadA.w + posRadB.w) * 0.5);
 
     // if (rhoPresMuA.w > -1 )
@@ -484,7 +516,7 @@ __device__ inline Real4 DifVelocityRho_ElasticSPH(Real3 dist3,
     Real rhoA = rhoPresMuA.x;
     Real rhoB = rhoPresMuB.x;
 
-    Real Mass = paramsD.markerMass;
+    Real Mass = Params().markerMass;
 
     Real derivVx = -Mass * (PA / (rhoA * rhoA) + PB / (rhoB * rhoB)) * gradW.x +
                    Mass * (txxA * gradW.x + txyA * gradW.y + txzA * gradW.z) / (rhoA * rhoA) +
@@ -499,11 +531,11 @@ __device__ inline Real4 DifVelocityRho_ElasticSPH(Real3 dist3,
     //*** Artificial viscosity type 1.1
     Real vAB_Dot_rAB = dot(velMasA - velMasB, dist3);
     if (vAB_Dot_rAB < 0.0) {
-        Real alpha = paramsD.Ar_vis_alpha;
-        Real c_ab = paramsD.Cs;
+        Real alpha = Params().Ar_vis_alpha;
+        Real c_ab = Params().Cs;
         Real rho = 0.5f * (rhoA + rhoB);
-        Real nu = -alpha * paramsD.HSML * c_ab / rho;
-        Real derivM1 = -Mass * (nu * vAB_Dot_rAB / (d * d + paramsD.epsMinMarkersDis * paramsD.HSML * paramsD.HSML));
+        Real nu = -alpha * Params().HSML * c_ab / rho;
+        Real derivM1 = -Mass * (nu * vAB_Dot_rAB / (d * d + Params().epsMinMarkersDis * Params().HSML * Params().HSML));
         derivVx += derivM1 * gradW.x;
         derivVy += derivM1 * gradW.y;
         derivVz += derivM1 * gradW.z;
@@ -511,9 +543,9 @@ __device__ inline Real4 DifVelocityRho_ElasticSPH(Real3 dist3,
 
     // damping force
     if (1 == 1) {
-        Real xi0 = paramsD.Vis_Dam;
-        Real E0 = paramsD.E_young;
-        Real h0 = paramsD.HSML;
+        Real xi0 = Params().Vis_Dam;
+        Real E0 = Params().E_young;
+        Real h0 = Params().HSML;
         Real Cd = xi0 * sqrt(E0 / (rhoA * h0 * h0));
         derivVx -= Cd * velMasA.x;
         derivVy -= Cd * velMasA.y;
@@ -533,24 +565,22 @@ __global__ void EOS(Real4* sortedRhoPreMu, uint numAllMarkers, volatile bool* is
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
-__global__ void Navier_Stokes(Real4* sortedDerivVelRho,  // output: new velocity
-                              Real3* shift_r,
-                              Real4* sortedPosRad,
-                              Real3* sortedVelMas,
-                              Real4* sortedRhoPreMu,
-                              Real3* velMas_ModifiedBCE,
-                              Real4* rhoPreMu_ModifiedBCE,
-                              Real3* sortedTauXxYyZz,  //
-                              Real3* sortedTauXyXzYz,  //
-                              uint* gridMarkerIndex,
-                              uint* cellStart,
-                              uint* cellEnd,
-                              const size_t numAllMarkers,
-                              Real MaxVel,
-                              volatile bool* isErrorD) {
-    uint index = blockIdx.x * blockDim.x + threadIdx.x;
-    if (index >= numAllMarkers)
-        return;
+__host__ __device__ inline void Navier_Stokes_marker(uint index,
+                                                     Real4* sortedDerivVelRho,  // output: new velocity
+                                                     Real3* shift_r,
+                                                     Real4* sortedPosRad,
+                                                     Real3* sortedVelMas,
+                                                     Real4* sortedRhoPreMu,
+                                                     Real3* velMas_ModifiedBCE,
+                                                     Real4* rhoPreMu_ModifiedBCE,
+                                                     Real3* sortedTauXxYyZz,  //
+                                                     Real3* sortedTauXyXzYz,  //
+                                                     uint* gridMarkerIndex,
+                                                     uint* cellStart,
+                                                     uint* cellEnd,
+                                                     const size_t numAllMarkers,
+                                                     Real MaxVel,
+                                                     volatile bool* isErrorD) {
     Real3 posRadA = mR3(sortedPosRad[index]);
     Real3 velMasA = sortedVelMas[index];
     Real4 rhoPresMuA = sortedRhoPreMu[index];
@@ -574,7 +604,7 @@ __global__ void Navier_Stokes(Real4* sortedDerivVelRho,  // output: new velocity
                         // Real3 dist3Alpha = posRadA - posRadB;
                         Real3 dist3 = Distance(posRadA, posRadB);  // change from B-A to A-B
                         Real d = length(dist3);
-                        if (d > RESOLUTION_LENGTH_MULT * paramsD.HSML)
+                        if (d > RESOLUTION_LENGTH_MULT * Params().HSML)
                             continue;
                         Real4 rhoPresMuB = sortedRhoPreMu[j];
                         if (rhoPresMuA.w > -.1 && rhoPresMuB.w > -.1) {  // no rigid-rigid force
@@ -586,9 +616,9 @@ __global__ void Navier_Stokes(Real4* sortedDerivVelRho,  // output: new velocity
                         }
                         Real3 velMasB = sortedVelMas[j];
                         if (rhoPresMuB.w > -1.0) {
-                            int bceIndexB = gridMarkerIndex[j] - (numObjectsD.numFluidMarkers);
+                            int bceIndexB = gridMarkerIndex[j] - (NumObjects().numFluidMarkers);
                             if (!(bceIndexB >= 0 &&
-                                  bceIndexB < numObjectsD.numBoundaryMarkers + numObjectsD.numRigid_SphMarkers)) {
+                                  bceIndexB < NumObjects().numBoundaryMarkers + NumObjects().numRigid_SphMarkers)) {
                                 printf("Error! bceIndex out of bound, collideCell !\n");
                             }
                             rhoPresMuB = rhoPreMu_ModifiedBCE[bceIndexB];
@@ -600,7 +630,7 @@ __global__ void Navier_Stokes(Real4* sortedDerivVelRho,  // output: new velocity
                                    rhoPresMuB.w);
                         }
                         // change from "-=" to "+="
-                        if(paramsD.elastic_SPH){
+                        if(Params().elastic_SPH){
                             derivVelRho += DifVelocityRho_ElasticSPH(dist3, d, sortedPosRad[index], sortedPosRad[j], velMasA, velMasA,
                                                       velMasB, velMasB, rhoPresMuA, rhoPresMuB, multViscosit,
                                                       sortedTauXxYyZz[index], sortedTauXyXzYz[index],  //
@@ -611,7 +641,7 @@ __global__ void Navier_Stokes(Real4* sortedDerivVelRho,  // output: new velocity
                                                        velMasB, velMasB, rhoPresMuA, rhoPresMuB, multViscosit);}
 
                         if (d > EPSILON) {
-                            Real m_j = pow(sortedPosRad[j].w * paramsD.MULT_INITSPACE, 3) * paramsD.rho0;
+                            Real m_j = pow(sortedPosRad[j].w * Params().MULT_INITSPACE, 3) * Params().rho0;
                             mi_bar += m_j;
                             r0 += d;
                             inner_sum += m_j * (-dist3) / (d * d * d);  // change from dist3 to -dist3
@@ -635,27 +665,47 @@ __global__ void Navier_Stokes(Real4* sortedDerivVelRho,  // output: new velocity
 
     r0 /= N_;
     mi_bar /= N_;
-    if (abs(mi_bar) > EPSILON && sortedRhoPreMu[index].w == -1.0)
-        shift_r[index] = paramsD.beta_shifting * r0 * r0 * MaxVel * paramsD.dT * inner_sum / mi_bar;
+    if (fabs(mi_bar) > EPSILON && sortedRhoPreMu[index].w == -1.0)
+        shift_r[index] = Params().beta_shifting * r0 * r0 * MaxVel * Params().dT * inner_sum / mi_bar;
 }
 
-//--------------------------------------------------------------------------------------------------------------------------------
-__global__ void CalcVel_XSPH_D(Real3* vel_XSPH_Sorted_D,  // output: new velocity
-                               Real4* sortedPosRad_old,   // input: sorted positions
-                               Real4* sortedPosRad,       // input: sorted positions
-                               Real3* sortedVelMas,       // input: sorted velocities
-                               Real4* sortedRhoPreMu,
-                               Real3* shift_r,
-
-                               uint* gridMarkerIndex,  // input: sorted particle indices
-                               uint* cellStart,
-                               uint* cellEnd,
-                               const size_t numAllMarkers,
-                               volatile bool* isErrorD) {
+__global__ void Navier_Stokes(Real4* sortedDerivVelRho,  // output: new velocity
+                              Real3* shift_r,
+                              Real4* sortedPosRad,
+                              Real3* sortedVelMas,
+                              Real4* sortedRhoPreMu,
+                              Real3* velMas_ModifiedBCE,
+                              Real4* rhoPreMu_ModifiedBCE,
+                              Real3* sortedTauXxYyZz,  //
+                              Real3* sortedTauXyXzYz,  //
+                              uint* gridMarkerIndex,
+                              uint* cellStart,
+                              uint* cellEnd,
+                              const size_t numAllMarkers,
+                              Real MaxVel,
+                              volatile bool* isErrorD) {
     uint index = blockIdx.x * blockDim.x + threadIdx.x;
     if (index >= numAllMarkers)
         return;
+    Navier_Stokes_marker(index, sortedDerivVelRho, shift_r, sortedPosRad, sortedVelMas, sortedRhoPreMu,
+                         velMas_ModifiedBCE, rhoPreMu_ModifiedBCE, sortedTauXxYyZz, sortedTauXyXzYz, gridMarkerIndex,
+                         cellStart, cellEnd, numAllMarkers, MaxVel, isErrorD);
+}
 
+//--------------------------------------------------------------------------------------------------------------------------------
+__host__ __device__ inline void CalcVel_XSPH_D_marker(uint index,
+                                                      Real3* vel_XSPH_Sorted_D,  // output: new velocity
+                                                      Real4* sortedPosRad_old,   // input: sorted positions
+                                                      Real4* sortedPosRad,       // input: sorted positions
+                                                      Real3* sortedVelMas,       // input: sorted velocities
+                                                      Real4* sortedRhoPreMu,
+                                                      Real3* shift_r,
+
+                                                      uint* gridMarkerIndex,  // input: sorted particle indices
+                                                      uint* cellStart,
+                                                      uint* cellEnd,
+                                                      const size_t numAllMarkers,
+                                                      volatile bool* isErrorD) {
     Real4 rhoPreMuA = sortedRhoPreMu[index];
     Real3 velMasA = sortedVelMas[index];
 
@@ -680,7 +730,7 @@ __global__ void CalcVel_XSPH_D(Real3* vel_XSPH_Sorted_D,  // output: new velocit
                         Real3 posRadB = mR3(sortedPosRad_old[j]);
                         Real3 dist3 = Distance(posRadA, posRadB);
                         Real d = length(dist3);
-                        if (d > RESOLUTION_LENGTH_MULT * paramsD.HSML)
+                        if (d > RESOLUTION_LENGTH_MULT * Params().HSML)
                             continue;
                         Real4 rhoPresMuB = sortedRhoPreMu[j];
 
@@ -688,7 +738,7 @@ __global__ void CalcVel_XSPH_D(Real3* vel_XSPH_Sorted_D,  // output: new velocit
                             continue;
                         Real3 velMasB = sortedVelMas[j];
                         Real rho_bar = 0.5 * (rhoPreMuA.x + rhoPresMuB.x);
-                        deltaV += paramsD.markerMass * (velMasB - velMasA) *
+                        deltaV += Params().markerMass * (velMasB - velMasA) *
                                   W3h(d, (sortedPosRad_old[index].w + sortedPosRad_old[j].w) * 0.5) / rho_bar;
                     }
                 }
@@ -707,6 +757,25 @@ __global__ void CalcVel_XSPH_D(Real3* vel_XSPH_Sorted_D,  // output: new velocit
     }
 }
 
+__global__ void CalcVel_XSPH_D(Real3* vel_XSPH_Sorted_D,  // output: new velocity
+                               Real4* sortedPosRad_old,   // input: sorted positions
+                               Real4* sortedPosRad,       // input: sorted positions
+                               Real3* sortedVelMas,       // input: sorted velocities
+                               Real4* sortedRhoPreMu,
+                               Real3* shift_r,
+
+                               uint* gridMarkerIndex,  // input: sorted particle indices
+                               uint* cellStart,
+                               uint* cellEnd,
+                               const size_t numAllMarkers,
+                               volatile bool* isErrorD) {
+    uint index = blockIdx.x * blockDim.x + threadIdx.x;
+    if (index >= numAllMarkers)
+        return;
+    CalcVel_XSPH_D_marker(index, vel_XSPH_Sorted_D, sortedPosRad_old, sortedPosRad, sortedVelMas, sortedRhoPreMu,
+                          shift_r, gridMarkerIndex, cellStart, cellEnd, numAllMarkers, isErrorD);
+}
+
 //--------------------------------------------------------------------------------------------------------------------------------
 ChFsiForceExplicitSPH::ChFsiForceExplicitSPH(std::shared_ptr<ChBce> otherBceWorker,
                                              std::shared_ptr<SphMarkerDataD> otherSortedSphMarkersD,
@@ -730,10 +799,15 @@ ChFsiForceExplicitSPH::~ChFsiForceExplicitSPH() {}
 //--------------------------------------------------------------------------------------------------------------------------------
 void ChFsiForceExplicitSPH::Finalize() {
     ChFsiForce::Finalize();
+#ifdef CHRONO_FSI_USE_CPU
+    paramsH_CPU = *paramsH;
+    numObjectsH_CPU = *numObjectsH;
+#else
     cudaMemcpyToSymbolAsync(paramsD, paramsH.get(), sizeof(SimParams));
     cudaMemcpyToSymbolAsync(numObjectsD, numObjectsH.get(), sizeof(NumberOfObjects));
     cudaMemcpyFromSymbol(paramsH.get(), paramsD, sizeof(SimParams));
     cudaDeviceSynchronize();
+#endif
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
@@ -752,9 +826,8 @@ void ChFsiForceExplicitSPH::ForceSPH(std::shared_ptr<SphMarkerDataD> otherSphMar
 void ChFsiForceExplicitSPH::CollideWrapper() {
     bool *isErrorH, *isErrorD;
     isErrorH = (bool*)malloc(sizeof(bool));
-    cudaMalloc((void**)&isErrorD, sizeof(bool));
+    isErrorD = ChUtilsDevice::CreateErrorFlag();
     *isErrorH = false;
-    cudaMemcpy(isErrorD, isErrorH, sizeof(bool), cudaMemcpyHostToDevice);
     //------------------------------------------------------------------------
     // thread per particle
     uint numThreads, numBlocks;
@@ -775,10 +848,17 @@ void ChFsiForceExplicitSPH::CollideWrapper() {
 
     if (density_initialization == 0)
         printf("Re-initializing density after %d steps.", paramsH->densityReinit);
+#ifdef CHRONO_FSI_USE_CPU
+    ForEachMarker((uint)numObjectsH->numAllMarkers, calcRho_kernel_marker, mR4CAST(sortedSphMarkersD->posRadD),
+                  mR4CAST(sortedSphMarkersD->rhoPresMuD), mR4CAST(rhoPresMuD_old), R1CAST(_sumWij_rhoi),
+                  U1CAST(markersProximityD->cellStartD), U1CAST(markersProximityD->cellEndD),
+                  numObjectsH->numAllMarkers, density_initialization, isErrorD);
+#else
     calcRho_kernel<<<numBlocks, numThreads>>>(
         mR4CAST(sortedSphMarkersD->posRadD), mR4CAST(sortedSphMarkersD->rhoPresMuD), mR4CAST(rhoPresMuD_old),
         R1CAST(_sumWij_rhoi), U1CAST(markersProximityD->cellStartD), U1CAST(markersProximityD->cellEndD),
         numObjectsH->numAllMarkers, density_initialization, isErrorD);
+#endif
     ChUtilsDevice::Sync_CheckError(isErrorH, isErrorD, "calcRho_kernel");
 
     //    EOS<<<numBlocks, numThreads>>>(mR4CAST(sortedSphMarkersD->rhoPresMuD),
@@ -787,7 +867,7 @@ void ChFsiForceExplicitSPH::CollideWrapper() {
     ChUtilsDevice::Sync_CheckError(isErrorH, isErrorD, "EOS");
 
     *isErrorH = false;
-    cudaMemcpy(isErrorD, isErrorH, sizeof(bool), cudaMemcpyHostToDevice);
+    ChUtilsDevice::ResetErrorFlag(isErrorD);
 
     thrust::device_vector<Real3>::iterator iter =
         thrust::max_element(sortedSphMarkersD->velMasD.begin(), sortedSphMarkersD->velMasD.end(), compare_Real3_mag());
@@ -796,6 +876,15 @@ void ChFsiForceExplicitSPH::CollideWrapper() {
 
     if(paramsH->elastic_SPH){
         // calculate the rate of shear stress tau
+#ifdef CHRONO_FSI_USE_CPU
+        ForEachMarker((uint)numObjectsH->numAllMarkers, Shear_Stress_Rate_marker, mR4CAST(sortedSphMarkersD->posRadD),
+                      mR4CAST(sortedSphMarkersD->rhoPresMuD), mR3CAST(sortedSphMarkersD->velMasD),
+                      mR3CAST(bceWorker->velMas_ModifiedBCE), mR4CAST(bceWorker->rhoPreMu_ModifiedBCE),
+                      mR3CAST(sortedSphMarkersD->tauXxYyZzD), mR3CAST(sortedSphMarkersD->tauXyXzYzD),
+                      mR3CAST(sortedDerivTauXxYyZz), mR3CAST(sortedDerivTauXyXzYz),
+                      U1CAST(markersProximityD->gridMarkerIndexD), U1CAST(markersProximityD->cellStartD),
+                      U1CAST(markersProximityD->cellEndD), numObjectsH->numAllMarkers);
+#else
         Shear_Stress_Rate<<<numBlocks, numThreads>>>(
             mR4CAST(sortedSphMarkersD->posRadD), mR4CAST(sortedSphMarkersD->rhoPresMuD),
             mR3CAST(sortedSphMarkersD->velMasD), mR3CAST(bceWorker->velMas_ModifiedBCE),
@@ -803,13 +892,23 @@ void ChFsiForceExplicitSPH::CollideWrapper() {
             mR3CAST(sortedSphMarkersD->tauXyXzYzD), mR3CAST(sortedDerivTauXxYyZz), mR3CAST(sortedDerivTauXyXzYz),
             U1CAST(markersProximityD->gridMarkerIndexD), U1CAST(markersProximityD->cellStartD),
             U1CAST(markersProximityD->cellEndD), numObjectsH->numAllMarkers);
+#endif
         ChUtilsDevice::Sync_CheckError(isErrorH, isErrorD, "Shear_Stress_Rate");
     }
 
     *isErrorH = false;
-    cudaMemcpy(isErrorD, isErrorH, sizeof(bool), cudaMemcpyHostToDevice);
+    ChUtilsDevice::ResetErrorFlag(isErrorD);
 
     // execute the kernel
+#ifdef CHRONO_FSI_USE_CPU
+    ForEachMarker((uint)numObjectsH->numAllMarkers, Navier_Stokes_marker, mR4CAST(sortedDerivVelRho), mR3CAST(shift_r),
+                  mR4CAST(sortedSphMarkersD->posRadD), mR3CAST(sortedSphMarkersD->velMasD),
+                  mR4CAST(sortedSphMarkersD->rhoPresMuD), mR3CAST(bceWorker->velMas_ModifiedBCE),
+                  mR4CAST(bceWorker->rhoPreMu_ModifiedBCE), mR3CAST(sortedSphMarkersD->tauXxYyZzD),
+                  mR3CAST(sortedSphMarkersD->tauXyXzYzD), U1CAST(markersProximityD->gridMarkerIndexD),
+                  U1CAST(markersProximityD->cellStartD), U1CAST(markersProximityD->cellEndD),
+                  numObjectsH->numAllMarkers, MaxVel, isErrorD);
+#else
     Navier_Stokes<<<numBlocks, numThreads>>>(
         mR4CAST(sortedDerivVelRho), mR3CAST(shift_r), mR4CAST(sortedSphMarkersD->posRadD),
         mR3CAST(sortedSphMarkersD->velMasD), mR4CAST(sortedSphMarkersD->rhoPresMuD),
@@ -817,6 +916,7 @@ void ChFsiForceExplicitSPH::CollideWrapper() {
         mR3CAST(sortedSphMarkersD->tauXxYyZzD), mR3CAST(sortedSphMarkersD->tauXyXzYzD),  //
         U1CAST(markersProximityD->gridMarkerIndexD), U1CAST(markersProximityD->cellStartD),
         U1CAST(markersProximityD->cellEndD), numObjectsH->numAllMarkers, MaxVel, isErrorD);
+#endif
     ChUtilsDevice::Sync_CheckError(isErrorH, isErrorD, "Navier_Stokes");
 
     CopySortedToOriginal_NonInvasive_R4(fsiGeneralData->derivVelRhoD_old, sortedDerivVelRho,
@@ -828,7 +928,7 @@ void ChFsiForceExplicitSPH::CollideWrapper() {
     sortedDerivVelRho.clear();
     sortedDerivTauXxYyZz.clear();  //
     sortedDerivTauXyXzYz.clear();  //
-    cudaFree(isErrorD);
+    ChUtilsDevice::FreeErrorFlag(isErrorD);
     free(isErrorH);
     density_initialization++;
     if (density_initialization >= paramsH->densityReinit)
@@ -848,9 +948,8 @@ void ChFsiForceExplicitSPH::CalculateXSPH_velocity() {
 
     bool *isErrorH, *isErrorD;
     isErrorH = (bool*)malloc(sizeof(bool));
-    cudaMalloc((void**)&isErrorD, sizeof(bool));
+    isErrorD = ChUtilsDevice::CreateErrorFlag();
     *isErrorH = false;
-    cudaMemcpy(isErrorD, isErrorH, sizeof(bool), cudaMemcpyHostToDevice);
     //------------------------------------------------------------------------
     /* thread per particle */
     uint numThreads, numBlocks;
@@ -859,11 +958,19 @@ void ChFsiForceExplicitSPH::CalculateXSPH_velocity() {
     thrust::fill(vel_XSPH_Sorted_D.begin(), vel_XSPH_Sorted_D.end(), mR3(0.0));
 
     /* Execute the kernel */
+#ifdef CHRONO_FSI_USE_CPU
+    ForEachMarker((uint)numObjectsH->numAllMarkers, CalcVel_XSPH_D_marker, mR3CAST(vel_XSPH_Sorted_D),
+                  mR4CAST(sortedPosRad_old), mR4CAST(sortedSphMarkersD->posRadD), mR3CAST(sortedSphMarkersD->velMasD),
+                  mR4CAST(sortedSphMarkersD->rhoPresMuD), mR3CAST(shift_r),
+                  U1CAST(markersProximityD->gridMarkerIndexD), U1CAST(markersProximityD->cellStartD),
+                  U1CAST(markersProximityD->cellEndD), numObjectsH->numAllMarkers, isErrorD);
+#else
     CalcVel_XSPH_D<<<numBlocks, numThreads>>>(
         mR3CAST(vel_XSPH_Sorted_D), mR4CAST(sortedPosRad_old), mR4CAST(sortedSphMarkersD->posRadD),
         mR3CAST(sortedSphMarkersD->velMasD), mR4CAST(sortedSphMarkersD->rhoPresMuD), mR3CAST(shift_r),
         U1CAST(markersProximityD->gridMarkerIndexD), U1CAST(markersProximityD->cellStartD),
         U1CAST(markersProximityD->cellEndD), numObjectsH->numAllMarkers, isErrorD);
+#endif
     ChUtilsDevice::Sync_CheckError(isErrorH, isErrorD, "CalcVel_XSPH_D");
 
     CopySortedToOriginal_NonInvasive_R3(fsiGeneralData->vel_XSPH_D, vel_XSPH_Sorted_D,
@@ -874,7 +981,7 @@ void ChFsiForceExplicitSPH::CalculateXSPH_velocity() {
     if (density_initialization % paramsH->densityReinit == 0)
         CopySortedToOriginal_NonInvasive_R4(sphMarkersD->rhoPresMuD, sortedSphMarkersD->rhoPresMuD,
                                             markersProximityD->gridMarkerIndexD);
-    cudaFree(isErrorD);
+    ChUtilsDevice::FreeErrorFlag(isErrorD);
     free(isErrorH);
 }
 
@@ -79,7 +79,7 @@ __global__ void Viscosity_correction(Real4* sortedPosRad,  // input: sorted posi
         Real d = length(rij);
         Real3 eij = rij / d;
         Real h_j = sortedPosRad[j].w;
-        Real m_j = pow(h_j * paramsD.MULT_INITSPACE, 3) * paramsD.rho0;
+        Real m_j = pow(h_j * Params().MULT_INITSPACE, 3) * Params().rho0;
         Real W3 = 0.5 * (W3h(d, h_i) + W3h(d, h_j));
         Real3 grad_i_wij = 0.5 * (GradWh(rij, h_i) + GradWh(rij, h_j));
 
@@ -100,27 +100,27 @@ __global__ void Viscosity_correction(Real4* sortedPosRad,  // input: sorted posi
 
     Real sr = Strain_Rate(grad_ux, grad_uy, grad_uz);
 
-    Real mu_0 = Herschel_Bulkley_mu_eff(paramsD.HB_sr0, paramsD.HB_k, paramsD.HB_n, paramsD.HB_tau0);
-    mu_0 = paramsD.mu_max;
-    Real tau_yeild = paramsD.HB_tau0;
-    if (paramsD.granular_material) {
-        Real I = Inertia_num(sr, sortedRhoPreMu_old[i_idx].x, p_ave, paramsD.ave_diam);
+    Real mu_0 = Herschel_Bulkley_mu_eff(Params().HB_sr0, Params().HB_k, Params().HB_n, Params().HB_tau0);
+    mu_0 = Params().mu_max;
+    Real tau_yeild = Params().HB_tau0;
+    if (Params().granular_material) {
+        Real I = Inertia_num(sr, sortedRhoPreMu_old[i_idx].x, p_ave, Params().ave_diam);
         Real mu_i = mu_I(sr, I);
         sr_tau_I_mu_i[i_idx].z = I;
         sr_tau_I_mu_i[i_idx].w = mu_i;
-        tau_yeild = mu_i * rmaxr(sortedRhoPreMu_old[i_idx].y, 0.0) + paramsD.cohesion;
+        tau_yeild = mu_i * rmaxr(sortedRhoPreMu_old[i_idx].y, 0.0) + Params().cohesion;
     }
 
-    if (paramsD.non_newtonian) {
-        if (sr < tau_yeild / paramsD.mu_max)
-            sortedRhoPreMu[i_idx].z = paramsD.mu_max;
-        //        if (sr < rmaxr(gamma_y, paramsD.HB_sr0))
-        //    if (sr < paramsD.HB_sr0)
-        //        sortedRhoPreMu[i_idx].z = paramsD.HB_tau0 * pow(sr / paramsD.HB_sr0, 1000) / paramsD.HB_sr0;
-        //    else if (sortedRhoPreMu_old[i_idx].x < paramsD.rho0)
+    if (Params().non_newtonian) {
+        if (sr < tau_yeild / Params().mu_max)
+            sortedRhoPreMu[i_idx].z = Params().mu_max;
+        //        if (sr < rmaxr(gamma_y, Params().HB_sr0))
+        //    if (sr < Params().HB_sr0)
+        //        sortedRhoPreMu[i_idx].z = Params().HB_tau0 * pow(sr / Params().HB_sr0, 1000) / Params().HB_sr0;
+        //    else if (sortedRhoPreMu_old[i_idx].x < Params().rho0)
         //        sortedRhoPreMu[i_idx].z = mu_ave;
         else
-            sortedRhoPreMu[i_idx].z = Herschel_Bulkley_mu_eff(sr, paramsD.HB_k, paramsD.HB_n, tau_yeild);
+            sortedRhoPreMu[i_idx].z = Herschel_Bulkley_mu_eff(sr, Params().HB_k, Params().HB_n, tau_yeild);
     }
     sr_tau_I_mu_i[i_idx].x = sr;
     sr_tau_I_mu_i[i_idx].y = Sym_Tensor_Norm(sortedTauXxYyZz[i_idx], sortedTauXyXzYz[i_idx]);
@@ -180,9 +180,9 @@ __global__ void V_star_Predictor(Real4* sortedPosRad,  // input: sorted position
     Real CN2 = 0.5;
 
     uint csrStartIdx = numContacts[i_idx];
-    uint csrEndIdx = numContacts[i_idx + 1];  //- uint(paramsD.Pressure_Constraint);
+    uint csrEndIdx = numContacts[i_idx + 1];  //- uint(Params().Pressure_Constraint);
 
-    //    if (paramsD.Pressure_Constraint) {
+    //    if (Params().Pressure_Constraint) {
     //        A_Matrix[csrEndIdx + 1] = 0;
     //        A_Matrix[numContacts[numAllMarkers] + i_idx] = 0;
     //    }
@@ -196,7 +196,7 @@ __global__ void V_star_Predictor(Real4* sortedPosRad,  // input: sorted position
         return;
     }
 
-    //    Real rho0 = paramsD.rho0;
+    //    Real rho0 = Params().rho0;
     Real rhoi = sortedRhoPreMu[i_idx].x;
     Real mu_i = sortedRhoPreMu[i_idx].z;
     Real3 grad_rho_i = mR3(0.0), grad_mu_i = mR3(0.0);
@@ -205,11 +205,11 @@ __global__ void V_star_Predictor(Real4* sortedPosRad,  // input: sorted position
     Real3 posRadA = mR3(sortedPosRad[i_idx]);
     Real h_i = sortedPosRad[i_idx].w;
 
-    //    bool full_support = (csrEndIdx - csrStartIdx) > 0.9 * paramsD.num_neighbors;
-    //    bool full_support = (rhoi >= paramsD.rho0);
+    //    bool full_support = (csrEndIdx - csrStartIdx) > 0.9 * Params().num_neighbors;
+    //    bool full_support = (rhoi >= Params().rho0);
     //    printf("full support nn=%d, rho_i=%f\n", csrEndIdx - csrStartIdx, rhoi);
-    //    bool ON_FREE_SURFACE = (rhoi < paramsD.rho0);
-    //    bool ON_FREE_SURFACE = (rhoi < 0.90 * paramsD.rho0 || csrEndIdx - csrStartIdx < 20);
+    //    bool ON_FREE_SURFACE = (rhoi < Params().rho0);
+    //    bool ON_FREE_SURFACE = (rhoi < 0.90 * Params().rho0 || csrEndIdx - csrStartIdx < 20);
     //    bool ON_FREE_SURFACE = false;
 
     //    bool ON_FREE_SURFACE = (csrEndIdx - csrStartIdx < 20);
@@ -224,7 +224,7 @@ __global__ void V_star_Predictor(Real4* sortedPosRad,  // input: sorted position
         Real d = length(rij);
         Real3 eij = rij / d;
         Real h_j = sortedPosRad[j].w;
-        Real m_j = pow(h_j * paramsD.MULT_INITSPACE, 3) * paramsD.rho0;
+        Real m_j = pow(h_j * Params().MULT_INITSPACE, 3) * Params().rho0;
         Real W3 = 0.5 * (W3h(d, h_i) + W3h(d, h_j));
         Real3 grad_i_wij = 0.5 * (GradWh(rij, h_i) + GradWh(rij, h_j));
 
@@ -239,16 +239,16 @@ __global__ void V_star_Predictor(Real4* sortedPosRad,  // input: sorted position
         gradP += A_G[count] * sortedRhoPreMu[j].y;
         if (sortedRhoPreMu[j].w == -1)
             num_fluid++;
-        if (paramsD.granular_material) {
+        if (Params().granular_material) {
             granular_source.x += dot(mR3(sortedTauXxYyZz[j].x, sortedTauXyXzYz[j].x, sortedTauXyXzYz[j].y), A_G[count]);
             granular_source.y += dot(mR3(sortedTauXyXzYz[j].x, sortedTauXxYyZz[j].y, sortedTauXyXzYz[j].z), A_G[count]);
             granular_source.z += dot(mR3(sortedTauXyXzYz[j].y, sortedTauXyXzYz[j].z, sortedTauXxYyZz[j].z), A_G[count]);
         }
     }
-    bool full_support = true;  //(rhoi >= 0.2 * paramsD.rho0) && num_fluid > uint(0.1 * paramsD.num_neighbors);
+    bool full_support = true;  //(rhoi >= 0.2 * Params().rho0) && num_fluid > uint(0.1 * Params().num_neighbors);
 
     Real sr = Strain_Rate(grad_ux, grad_uy, grad_uz);
-    Real I = Inertia_num(sr, sortedRhoPreMu[i_idx].x, sortedRhoPreMu[i_idx].y, paramsD.ave_diam);
+    Real I = Inertia_num(sr, sortedRhoPreMu[i_idx].x, sortedRhoPreMu[i_idx].y, Params().ave_diam);
     Real mu_i_p = mu_I(sr, I) * rmaxr(sortedRhoPreMu[i_idx].y, 0);
     Real3 sgn_grad_ux = mu_i_p * sgn(grad_ux), sgn_grad_uy = mu_i_p * sgn(grad_uy), sgn_grad_uz = mu_i_p * sgn(grad_uz);
     Real3 graduxT = mR3(grad_ux.x, grad_uy.x, grad_uz.x);
@@ -265,20 +265,20 @@ __global__ void V_star_Predictor(Real4* sortedPosRad,  // input: sorted position
             for (int count = csrStartIdx; count < csrEndIdx; count++) {
                 //                int j = csrColInd[count];
                 A_Matrix[count] = -CN * mu_i * A_L[count] * full_support +  //
-                                  -CN2 * paramsD.non_newtonian * dot(grad_mu_i, A_G[count]) * full_support;
+                                  -CN2 * Params().non_newtonian * dot(grad_mu_i, A_G[count]) * full_support;
             }
             A_Matrix[csrStartIdx] += rhoi / delta_t;
             Bi[i_idx] += rhoi * sortedVelMas[i_idx] / delta_t +                     // forward euler term from lhs
-                         -gradP * !paramsD.USE_NonIncrementalProjection             // Pressure Gradient
+                         -gradP * !Params().USE_NonIncrementalProjection             // Pressure Gradient
                          + (1 - CN) * mu_i * Laplacian_u                            // viscous term;
-                         + (1 - CN2) * paramsD.non_newtonian * grad_mu_dot_gradu_u  // Non-Newtonian term
-                         + paramsD.non_newtonian * grad_mu_dot_gradu_uT             // Non - Newtonian term
-                         + !paramsD.non_newtonian * paramsD.granular_material * granular_source  // granular term
-                         + rhoi * (paramsD.gravity + paramsD.bodyForce3);                        // body force
+                         + (1 - CN2) * Params().non_newtonian * grad_mu_dot_gradu_u  // Non-Newtonian term
+                         + Params().non_newtonian * grad_mu_dot_gradu_uT             // Non - Newtonian term
+                         + !Params().non_newtonian * Params().granular_material * granular_source  // granular term
+                         + rhoi * (Params().gravity + Params().bodyForce3);                        // body force
 
         } else {
             A_Matrix[csrStartIdx] = 1.0;
-            Bi[i_idx] = sortedVelMas[i_idx] + (paramsD.gravity + paramsD.bodyForce3) * delta_t;
+            Bi[i_idx] = sortedVelMas[i_idx] + (Params().gravity + Params().bodyForce3) * delta_t;
         }
     }
     //======================== Boundary ===========================
@@ -316,7 +316,7 @@ __global__ void V_star_Predictor(Real4* sortedPosRad,  // input: sorted position
             A_Matrix[csrStartIdx] = den;
             Bi[i_idx] = 2 * V_prescribed * den;
 
-            //                       + gradP / sortedRhoPreMu[i_idx].x * delta_t * paramsD.USE_NonIncrementalProjection
+            //                       + gradP / sortedRhoPreMu[i_idx].x * delta_t * Params().USE_NonIncrementalProjection
             //                       * den;
         }
     }
@@ -373,7 +373,7 @@ __global__ void Pressure_Equation(Real4* sortedPosRad,  // input: sorted positio
     }
 
     uint csrStartIdx = numContacts[i_idx];
-    uint csrEndIdx = numContacts[i_idx + 1];  //- uint(paramsD.Pressure_Constraint);
+    uint csrEndIdx = numContacts[i_idx + 1];  //- uint(Params().Pressure_Constraint);
 
     bool Fluid_Marker = sortedRhoPreMu[i_idx].w == -1.0;
     bool Boundary_Marker = sortedRhoPreMu[i_idx].w > -1.0;
@@ -385,15 +385,15 @@ __global__ void Pressure_Equation(Real4* sortedPosRad,  // input: sorted positio
     }
 
     Real rhoi = sortedRhoPreMu[i_idx].x;
-    Real TIME_SCALE = paramsD.DensityBaseProjetion ? (delta_t * delta_t) : delta_t;
+    Real TIME_SCALE = Params().DensityBaseProjetion ? (delta_t * delta_t) : delta_t;
     //    Real TIME_SCALE = 1.0;
 
-    //    bool ON_FREE_SURFACE = (rhoi < paramsD.rho0 || csrEndIdx - csrStartIdx < paramsD.num_neighbors * 0.5);
-    bool full_support = (rhoi >= 0.8 * paramsD.rho0) && (csrEndIdx - csrStartIdx) > uint(0.2 * paramsD.num_neighbors);
+    //    bool ON_FREE_SURFACE = (rhoi < Params().rho0 || csrEndIdx - csrStartIdx < Params().num_neighbors * 0.5);
+    bool full_support = (rhoi >= 0.8 * Params().rho0) && (csrEndIdx - csrStartIdx) > uint(0.2 * Params().num_neighbors);
 
-    //    bool ON_FREE_SURFACE = (rhoi < paramsD.rho0);
-    //    Real rho0 = paramsD.rho0;
-    Real3 body_force = paramsD.gravity + paramsD.bodyForce3;
+    //    bool ON_FREE_SURFACE = (rhoi < Params().rho0);
+    //    Real rho0 = Params().rho0;
+    Real3 body_force = Params().gravity + Params().bodyForce3;
     Real3 grad_rho_i = mR3(0.0);
     Real div_vi_star = 0;
     Real div_vi = 0;
@@ -406,21 +406,21 @@ __global__ void Pressure_Equation(Real4* sortedPosRad,  // input: sorted positio
         grad_rho_i += A_G[count] * sortedRhoPreMu[j].x;
     }
 
-    Real rhoi_star = rhoi - paramsD.rho0 * div_vi_star * delta_t;
+    Real rhoi_star = rhoi - Params().rho0 * div_vi_star * delta_t;
     //    Real rhoi_star = rhoi + dot(grad_rho_i, Vstar[i_idx] * delta_t);
 
     //======================== Interior ===========================
     if (Fluid_Marker) {
-        if (full_support || !paramsD.Conservative_Form) {
+        if (full_support || !Params().Conservative_Form) {
             for (int count = csrStartIdx; count < csrEndIdx; count++) {
                 // Note that including the second term creates problems with density based projection
                 A_Matrix[count] = 1 / rhoi * A_L[count] - 1.0 / (rhoi * rhoi) * dot(grad_rho_i, A_G[count]);
             }
 
-            double alpha = paramsD.Alpha;  // pow(rhoi / paramsD.rho0, 2);
+            double alpha = Params().Alpha;  // pow(rhoi / Params().rho0, 2);
             //            alpha = (alpha > 1) ? 1.0 : alpha;
-            if (paramsD.DensityBaseProjetion)
-                Bi[i_idx] = alpha * (paramsD.rho0 - rhoi_star) / paramsD.rho0 * (TIME_SCALE / (delta_t * delta_t)) +
+            if (Params().DensityBaseProjetion)
+                Bi[i_idx] = alpha * (Params().rho0 - rhoi_star) / Params().rho0 * (TIME_SCALE / (delta_t * delta_t)) +
                             +0 * (1 - alpha) * div_vi_star * (TIME_SCALE / delta_t);
             else
                 Bi[i_idx] = div_vi_star * (TIME_SCALE / delta_t);
@@ -429,12 +429,12 @@ __global__ void Pressure_Equation(Real4* sortedPosRad,  // input: sorted positio
             //            for (int count = csrStartIdx; count < csrEndIdx; count++) {
             //                A_Matrix[count] = A_f[count];
             //            }
-            Bi[i_idx] = paramsD.BASEPRES;
+            Bi[i_idx] = Params().BASEPRES;
             A_Matrix[csrStartIdx] = 1.0;
         }
 
         //======================= Boundary ===========================
-    } else if (Boundary_Marker && paramsD.bceType != ADAMI) {
+    } else if (Boundary_Marker && Params().bceType != ADAMI) {
         Real3 my_normal = Normals[i_idx];
         for (int count = csrStartIdx; count < csrEndIdx; count++) {
             uint j = csrColInd[count];
@@ -460,7 +460,7 @@ __global__ void Pressure_Equation(Real4* sortedPosRad,  // input: sorted positio
         //                A_Matrix[count] = A_Matrix[count] / Scale;
 
         //======================= Boundary Adami===========================
-    } else if (Boundary_Marker && paramsD.bceType == ADAMI && paramsD.USE_NonIncrementalProjection) {
+    } else if (Boundary_Marker && Params().bceType == ADAMI && Params().USE_NonIncrementalProjection) {
         Real h_i = sortedPosRad[i_idx].w;
         //        Real Vi = sumWij_inv[i_idx];
         Real3 posRadA = mR3(sortedPosRad[i_idx]);
@@ -499,14 +499,14 @@ __global__ void Pressure_Equation(Real4* sortedPosRad,  // input: sorted positio
 
         } else {
             A_Matrix[csrStartIdx] = 1.0;
-            Bi[i_idx] = paramsD.BASEPRES;
+            Bi[i_idx] = Params().BASEPRES;
         }
 
         q_new[i_idx] = sortedRhoPreMu[i_idx].y * TIME_SCALE;
         Bi[i_idx] *= TIME_SCALE;
     }
 
-    //    if (paramsD.Pressure_Constraint) {
+    //    if (Params().Pressure_Constraint) {
     //        A_Matrix[csrEndIdx] = (double)Fluid_Marker / (double)numFluidMarkers;
     //        csrColInd[csrEndIdx] = numAllMarkers;
     //        uint last_row_start = numContacts[numAllMarkers];
@@ -523,7 +523,7 @@ __global__ void Pressure_Equation(Real4* sortedPosRad,  // input: sorted positio
     //    }
 
     //    if (sortedRhoPreMu[i_idx].w > -1)
-    //    A_Matrix[csrStartIdx] = 1.0 + paramsD.epsMinMarkersDis;
+    //    A_Matrix[csrStartIdx] = 1.0 + Params().epsMinMarkersDis;
 
     //    if (abs(A_Matrix[csrStartIdx]) < EPSILON)
     //        printf("Pressure_Equation %d A_Matrix[csrStartIdx]= %f, type=%f \n", i_idx, A_Matrix[csrStartIdx],
@@ -566,10 +566,10 @@ __global__ void Velocity_Correction_and_update(Real4* sortedPosRad,
     // Note that every variable that is used inside the for loops should not be overwritten later otherwise there would
     // be a race condition. For such variables one must use the old values.
     uint csrStartIdx = numContacts[i_idx];
-    uint csrEndIdx = numContacts[i_idx + 1];  //- uint(paramsD.Pressure_Constraint);
-    //    Real m_i = pow(sortedPosRad_old[i_idx].w * paramsD.MULT_INITSPACE, 3) * paramsD.rho0;
-    Real m_i = paramsD.markerMass;
-    Real TIME_SCALE = paramsD.DensityBaseProjetion ? (delta_t * delta_t) : delta_t;
+    uint csrEndIdx = numContacts[i_idx + 1];  //- uint(Params().Pressure_Constraint);
+    //    Real m_i = pow(sortedPosRad_old[i_idx].w * Params().MULT_INITSPACE, 3) * Params().rho0;
+    Real m_i = Params().markerMass;
+    Real TIME_SCALE = Params().DensityBaseProjetion ? (delta_t * delta_t) : delta_t;
     //    Real TIME_SCALE = 1.0;
 
     Real3 grad_p_nPlus1 = mR3(0.0);
@@ -583,8 +583,8 @@ __global__ void Velocity_Correction_and_update(Real4* sortedPosRad,
 
     for (int count = csrStartIdx; count < csrEndIdx; count++) {
         uint j = csrColInd[count];
-        //        Real m_j = pow(sortedPosRad_old[j].w * paramsD.MULT_INITSPACE, 3) * paramsD.rho0;
-        Real m_j = paramsD.markerMass;
+        //        Real m_j = pow(sortedPosRad_old[j].w * Params().MULT_INITSPACE, 3) * Params().rho0;
+        Real m_j = Params().markerMass;
         Real rho_j = sortedRhoPreMu_old[j].x;
         Real3 rij = Distance(posA, mR3(sortedPosRad_old[j]));
         Real h_j = sortedPosRad_old[j].w;
@@ -614,10 +614,10 @@ __global__ void Velocity_Correction_and_update(Real4* sortedPosRad,
         laplacian_V += A_L[count] * sortedVelMas_old[j];
     }
 
-    Real3 grad_q_i = (paramsD.Conservative_Form ? grad_q_i_conservative : grad_q_i_consistent) / TIME_SCALE;
-    Real3 Pressure_correction_term = -grad_q_i * (delta_t) / paramsD.rho0;
+    Real3 grad_q_i = (Params().Conservative_Form ? grad_q_i_conservative : grad_q_i_consistent) / TIME_SCALE;
+    Real3 Pressure_correction_term = -grad_q_i * (delta_t) / Params().rho0;
 
-    //    if (rho_i < paramsD.rho0)
+    //    if (rho_i < Params().rho0)
     //        Pressure_correction_term = mR3(0);
 
     //    if (!(isfinite(q_i[i_idx]))) {
@@ -634,7 +634,7 @@ __global__ void Velocity_Correction_and_update(Real4* sortedPosRad,
     //    sortedRhoPreMu[i_idx].x = sortedRhoPreMu_old[i_idx].x - delta_t * sortedRhoPreMu_old[i_idx].x * divV_star;
     Real mu_i = sortedRhoPreMu_old[i_idx].z;
 
-    Real3 FS_force = (-grad_q_i_conservative / TIME_SCALE + laplacian_V * mu_i + paramsD.bodyForce3 + paramsD.gravity) *
+    Real3 FS_force = (-grad_q_i_conservative / TIME_SCALE + laplacian_V * mu_i + Params().bodyForce3 + Params().gravity) *
                      m_i / sortedRhoPreMu_old[i_idx].x;
     derivVelRho[i_idx] = mR4(FS_force, 0.0);
 
@@ -644,13 +644,13 @@ __global__ void Velocity_Correction_and_update(Real4* sortedPosRad,
     //    Real3 m_dv_dt = m_i * (V_new - sortedVelMas_old[i_idx]) / delta_t;
     //    derivVelRho[i_idx] = mR4(-m_dv_dt, 0);
 
-    if (paramsD.USE_NonIncrementalProjection)
+    if (Params().USE_NonIncrementalProjection)
         sortedRhoPreMu[i_idx].y = (q_i[i_idx]) / TIME_SCALE;
     else
         sortedRhoPreMu[i_idx].y += q_i[i_idx] + dot(grad_p_nPlus1, mR3(x_new - sortedPosRad_old[i_idx]));
 
     Real3 d_sortedTauXxYyZz, d_sortedTauXyXzYz;
-    if (paramsD.granular_material) {
+    if (Params().granular_material) {
         Real3 ep_XxYyZz = mR3(0.0);
         Real3 ep_XyXzYz = mR3(0.0);
         ep_XxYyZz.x = grad_ux.x;
@@ -667,7 +667,7 @@ __global__ void Velocity_Correction_and_update(Real4* sortedPosRad,
 
         Real ep_ii = ep_XxYyZz.x + ep_XxYyZz.y + ep_XxYyZz.z;
 
-        d_sortedTauXxYyZz = 2 * paramsD.Shear_Mod * (ep_XxYyZz - 1.0 / 3.0 * mR3(ep_ii));
+        d_sortedTauXxYyZz = 2 * Params().Shear_Mod * (ep_XxYyZz - 1.0 / 3.0 * mR3(ep_ii));
         d_sortedTauXxYyZz.x -= 2 * (+sortedTauXyXzYz[i_idx].x * -w_XyXzYz.x + sortedTauXyXzYz[i_idx].y * -w_XyXzYz.y);
         d_sortedTauXxYyZz.y -= 2 * (+sortedTauXyXzYz[i_idx].x * +w_XyXzYz.x + sortedTauXyXzYz[i_idx].z * -w_XyXzYz.z);
         d_sortedTauXxYyZz.z -= 2 * (+sortedTauXyXzYz[i_idx].y * +w_XyXzYz.y + sortedTauXyXzYz[i_idx].z * +w_XyXzYz.z);
@@ -675,7 +675,7 @@ __global__ void Velocity_Correction_and_update(Real4* sortedPosRad,
         //    d_sortedTauXxYyZz.y += +sortedTauXyXzYz[i_idx].x * +w_XyXzYz.x + sortedTauXyXzYz[i_idx].z * -w_XyXzYz.z;
         //    d_sortedTauXxYyZz.z += +sortedTauXyXzYz[i_idx].y * +w_XyXzYz.y + sortedTauXyXzYz[i_idx].z * +w_XyXzYz.z;
 
-        d_sortedTauXyXzYz = 2 * paramsD.Shear_Mod * (ep_XyXzYz - 0.0 / 3.0 * mR3(ep_ii));
+        d_sortedTauXyXzYz = 2 * Params().Shear_Mod * (ep_XyXzYz - 0.0 / 3.0 * mR3(ep_ii));
         d_sortedTauXyXzYz.x -= sortedTauXxYyZz[i_idx].x * +w_XyXzYz.x + sortedTauXyXzYz[i_idx].y * -w_XyXzYz.z;
         d_sortedTauXyXzYz.y -= sortedTauXxYyZz[i_idx].x * +w_XyXzYz.y + sortedTauXyXzYz[i_idx].x * +w_XyXzYz.z;
         d_sortedTauXyXzYz.z -= sortedTauXyXzYz[i_idx].x * +w_XyXzYz.y + sortedTauXxYyZz[i_idx].y * +w_XyXzYz.z;
@@ -695,7 +695,7 @@ __global__ void Velocity_Correction_and_update(Real4* sortedPosRad,
     bool yeilded = tau_norm > yeild_tau;
 
     if (sortedRhoPreMu_old[i_idx].w == -1.0) {
-        if (paramsD.granular_material && !paramsD.non_newtonian) {
+        if (Params().granular_material && !Params().non_newtonian) {
             if (yeilded) {
                 sortedPosRad[i_idx] = x_new;
                 sortedTauXxYyZz[i_idx] = updatedTauXxYyZz * yeild_tau / (tau_norm);
@@ -748,7 +748,7 @@ __global__ void Shifting(Real4* sortedPosRad,
     }
 
     uint csrStartIdx = numContacts[i_idx];
-    uint csrEndIdx = numContacts[i_idx + 1];  //- uint(paramsD.Pressure_Constraint);
+    uint csrEndIdx = numContacts[i_idx + 1];  //- uint(Params().Pressure_Constraint);
     Real3 inner_sum = mR3(0.0), shift_r = mR3(0.0);
     Real mi_bar = 0.0, r0 = 0.0;  // v_bar = 0.0;
     Real3 xSPH_Sum = mR3(0.0);
@@ -774,7 +774,7 @@ __global__ void Shifting(Real4* sortedPosRad,
         uint j = csrColInd[count];
         Real3 rij = Distance(mR3(sortedPosRad_old[i_idx]), mR3(sortedPosRad_old[j]));
         Real d = length(rij);
-        Real m_j = paramsD.markerMass;
+        Real m_j = Params().markerMass;
 
         if (sortedRhoPreMu_old[j].w == -1.0) {
             Real h_ij = 0.5 * (sortedPosRad_old[j].w + sortedPosRad_old[i_idx].w);
@@ -783,7 +783,7 @@ __global__ void Shifting(Real4* sortedPosRad,
             xSPH_Sum += (sortedVelMas_old[j] - sortedVelMas_old[i_idx]) * Wd * m_j / rho_bar;
         }
         //        v_bar += length(A_f[count] * (sortedVelMas_old[j]));
-        //        Real m_j = pow(sortedPosRad_old[j].w * paramsD.MULT_INITSPACE, 3) * paramsD.rho0;
+        //        Real m_j = pow(sortedPosRad_old[j].w * Params().MULT_INITSPACE, 3) * Params().rho0;
 
         mi_bar += m_j;
         r0 += d;
@@ -798,8 +798,8 @@ __global__ void Shifting(Real4* sortedPosRad,
     }
 
     if (abs(mi_bar) > EPSILON)
-        shift_r = paramsD.beta_shifting * r0 * r0 * length(MaxVel) * delta_t * inner_sum / mi_bar;
-    //    shift_r = paramsD.beta_shifting * r0 * r0 * length(MaxVel) * delta_t * inner_sum;
+        shift_r = Params().beta_shifting * r0 * r0 * length(MaxVel) * delta_t * inner_sum / mi_bar;
+    //    shift_r = Params().beta_shifting * r0 * r0 * length(MaxVel) * delta_t * inner_sum;
 
     Real3 grad_p = mR3(0.0);
     Real3 grad_rho = mR3(0.0);
@@ -826,8 +826,8 @@ __global__ void Shifting(Real4* sortedPosRad,
         sortedVelMas[i_idx].x += dot(shift_r, grad_ux);
         sortedVelMas[i_idx].y += dot(shift_r, grad_uy);
         sortedVelMas[i_idx].z += dot(shift_r, grad_uz);
-        sortedVelMas[i_idx] += paramsD.EPS_XSPH * xSPH_Sum;
-        //        sortedPosRad[i_idx] += mR4(paramsD.EPS_XSPH * xSPH_Sum * delta_t, 0.0);
+        sortedVelMas[i_idx] += Params().EPS_XSPH * xSPH_Sum;
+        //        sortedPosRad[i_idx] += mR4(Params().EPS_XSPH * xSPH_Sum * delta_t, 0.0);
     }
 
     Real3 vis_vel = mR3(0.0);
@@ -875,6 +875,9 @@ ChFsiForceI2SPH::ChFsiForceI2SPH(std::shared_ptr<ChBce> otherBceWorker,
 ChFsiForceI2SPH::~ChFsiForceI2SPH() {}
 
 void ChFsiForceI2SPH::Finalize() {
+#ifdef CHRONO_FSI_USE_CPU
+    throw std::runtime_error("Error! I2SPH is not available with the CPU backend of Chrono::FSI, use WCSPH instead.\n");
+#endif
     ChFsiForce::Finalize();
     cudaMemcpyToSymbolAsync(paramsD, paramsH.get(), sizeof(SimParams));
     cudaMemcpyToSymbolAsync(numObjectsD, numObjectsH.get(), sizeof(NumberOfObjects));
@@ -49,6 +49,9 @@ ChFsiForceIISPH::ChFsiForceIISPH(std::shared_ptr<ChBce> otherBceWorker,
 ChFsiForceIISPH::~ChFsiForceIISPH() {}
 //--------------------------------------------------------------------------------------------------------------------------------
 void ChFsiForceIISPH::Finalize() {
+#ifdef CHRONO_FSI_USE_CPU
+    throw std::runtime_error("Error! IISPH is not available with the CPU backend of Chrono::FSI, use WCSPH instead.\n");
+#endif
     ChFsiForce::Finalize();
     cudaMemcpyToSymbolAsync(paramsD, paramsH.get(), sizeof(SimParams));
     cudaMemcpyToSymbolAsync(numObjectsD, numObjectsH.get(), sizeof(NumberOfObjects));
@@ -75,13 +78,13 @@ __global__ void V_i_np__AND__d_ii_kernel(Real4* sortedPosRad,  // input: sorted
     }
     //    sortedRhoPreMu[i_idx].x = sortedRhoPreMu[i_idx].x / sumWij_inv[i_idx];
     Real h_i = sortedPosRad[i_idx].w;
-    Real m_i = h_i * h_i * h_i * paramsD.rho0;
+    Real m_i = h_i * h_i * h_i * Params().rho0;
 
-    Real mu_0 = paramsD.mu0;
-    Real epsilon = paramsD.epsMinMarkersDis;
+    Real mu_0 = Params().mu0;
+    Real epsilon = Params().epsMinMarkersDis;
     Real dT = delta_t;
-    Real3 source_term = paramsD.gravity + paramsD.bodyForce3;
-    Real RHO_0 = paramsD.rho0;
+    Real3 source_term = Params().gravity + Params().bodyForce3;
+    Real RHO_0 = Params().rho0;
     if (sortedRhoPreMu[i_idx].x < EPSILON) {
         printf("density is %f,ref density= %f\n", sortedRhoPreMu[i_idx].x, RHO_0);
     }
@@ -135,14 +138,14 @@ __global__ void V_i_np__AND__d_ii_kernel(Real4* sortedPosRad,  // input: sorted
                             printf("Bug F_i_np__AND__d_ii_kernel i=%d j=%d, hi=%f, hj=%f\n", i_idx, j, h_i, h_j);
                         }
 
-                        Real m_j = h_j * h_j * h_j * paramsD.rho0;
+                        Real m_j = h_j * h_j * h_j * Params().rho0;
                         Real h_ij = 0.5 * (h_j + h_i);
                         Real3 grad_ij = GradWh(rij, h_ij);
                         My_d_ii += m_j * (-(dT * dT) / (Rhoi * Rhoi)) * grad_ij;
 
                         Real Rho_bar = (Rhoj + Rhoi) * 0.5;
                         Real3 V_ij = (Veli - Velj);
-                        //                        Real nu = mu_0 * paramsD.HSML * 320 / Rho_bar;
+                        //                        Real nu = mu_0 * Params().HSML * 320 / Rho_bar;
                         //                        Real3 muNumerator = nu * fmin(0.0, dot(rij, V_ij)) * grad_ij;
                         Real3 muNumerator = 2 * mu_0 * dot(rij, grad_ij) * V_ij;
                         Real muDenominator = (Rho_bar * Rho_bar) * (d * d + h_ij * h_ij * epsilon);
@@ -152,7 +155,7 @@ __global__ void V_i_np__AND__d_ii_kernel(Real4* sortedPosRad,  // input: sorted
                         My_F_i_np += m_j * muNumerator / muDenominator;
 
                         Real Wd = W3h(d, h_ij);
-                        My_F_i_np -= paramsD.kappa / m_i * m_j * Wd * rij;
+                        My_F_i_np -= Params().kappa / m_i * m_j * Wd * rij;
 
                         Real Vj = sumWij_inv[j];
                         Real commonterm =
@@ -162,18 +165,18 @@ __global__ void V_i_np__AND__d_ii_kernel(Real4* sortedPosRad,  // input: sorted
                              Li[2] * eij.z * grad_ij.x + Li[4] * eij.z * grad_ij.y + Li[5] * eij.z * grad_ij.z);
 
                         LaplacainVi.x +=
-                            commonterm * (V_ij.x / (d + h_ij * paramsD.epsMinMarkersDis) - dot(eij, myGradvx));
+                            commonterm * (V_ij.x / (d + h_ij * Params().epsMinMarkersDis) - dot(eij, myGradvx));
                         LaplacainVi.y +=
-                            commonterm * (V_ij.y / (d + h_ij * paramsD.epsMinMarkersDis) - dot(eij, myGradvy));
+                            commonterm * (V_ij.y / (d + h_ij * Params().epsMinMarkersDis) - dot(eij, myGradvy));
                         LaplacainVi.z +=
-                            commonterm * (V_ij.y / (d + h_ij * paramsD.epsMinMarkersDis) - dot(eij, myGradvz));
+                            commonterm * (V_ij.y / (d + h_ij * Params().epsMinMarkersDis) - dot(eij, myGradvz));
                     }
                 }
             }
         }
     }
 
-    //    if (!paramsD.Conservative_Form)
+    //    if (!Params().Conservative_Form)
     //        My_F_i_np = mu_0 * LaplacainVi;
 
     My_F_i_np *= m_i;
@@ -203,7 +206,7 @@ __global__ void Rho_np_AND_a_ii_AND_sum_m_GradW(Real4* sortedPosRad,
     }
 
     Real h_i = sortedPosRad[i_idx].w;
-    Real m_i = h_i * h_i * h_i * paramsD.rho0;
+    Real m_i = h_i * h_i * h_i * Params().rho0;
 
     Real3 posi = mR3(sortedPosRad[i_idx]);
     Real3 Veli_np = V_np[i_idx];
@@ -236,7 +239,7 @@ __global__ void Rho_np_AND_a_ii_AND_sum_m_GradW(Real4* sortedPosRad,
                         if (d > RESOLUTION_LENGTH_MULT * h_i || sortedRhoPreMu[j].w <= -2 || i_idx == j)
                             continue;
                         Real h_j = sortedPosRad[j].w;
-                        Real m_j = h_j * h_j * h_j * paramsD.rho0;
+                        Real m_j = h_j * h_j * h_j * Params().rho0;
                         Real h_ij = 0.5 * (h_j + h_i);
                         Real3 Velj_np = V_np[j];
                         Real3 grad_i_wij = GradWh(dist3, h_ij);
@@ -275,7 +278,7 @@ __global__ void Calc_dij_pj(Real3* dij_pj,  // write
         return;
     }
     Real h_i = sortedPosRad[i_idx].w;
-    Real m_i = h_i * h_i * h_i * paramsD.rho0;
+    Real m_i = h_i * h_i * h_i * Params().rho0;
 
     Real3 my_F_p = mR3(0);
     Real p_i_old = p_old[i_idx];
@@ -307,7 +310,7 @@ __global__ void Calc_dij_pj(Real3* dij_pj,  // write
                         if (d > RESOLUTION_LENGTH_MULT * h_i || sortedRhoPreMu[j].w <= -2 || i_idx == j)
                             continue;
                         Real h_j = sortedPosRad[j].w;
-                        Real m_j = h_j * h_j * h_j * paramsD.rho0;
+                        Real m_j = h_j * h_j * h_j * Params().rho0;
                         Real h_ij = 0.5 * (h_j + h_i);
                         Real3 grad_i_wij = GradWh(dist3, h_ij);
                         Real Rho_j = sortedRhoPreMu[j].x;
@@ -341,7 +344,7 @@ __global__ void CalcNumber_Contacts(uint* numContacts,
     }
 
     Real h_i = sortedPosRad[i_idx].w;
-    //    Real m_i = h_i * h_i * h_i * paramsD.rho0;
+    //    Real m_i = h_i * h_i * h_i * Params().rho0;
 
     int myType = sortedRhoPreMu[i_idx].w;
     Real3 pos_i = mR3(sortedPosRad[i_idx]);
@@ -380,7 +383,7 @@ __global__ void CalcNumber_Contacts(uint* numContacts,
                             numCol[counter] = j;
                             counter++;
                             // Do not count BCE-BCE interactions...
-                            if (myType >= 0 && sortedRhoPreMu[j].w >= 0 && paramsD.bceType == ADAMI)
+                            if (myType >= 0 && sortedRhoPreMu[j].w >= 0 && Params().bceType == ADAMI)
                                 counter--;
                         }
 
@@ -447,11 +450,11 @@ __global__ void Calc_summGradW(Real3* summGradW,  // write
         return;
     }
     Real h_i = sortedPosRad[i_idx].w;
-    //    Real m_i = h_i * h_i * h_i * paramsD.rho0;
+    //    Real m_i = h_i * h_i * h_i * Params().rho0;
 
     Real3 pos_i = mR3(sortedPosRad[i_idx]);
     Real3 My_summgradW = mR3(0);
-    //    Real dT = paramsD.dT;
+    //    Real dT = Params().dT;
     int3 gridPos = calcGridPos(pos_i);
     for (int z = -1; z <= 1; z++) {
         for (int y = -1; y <= 1; y++) {
@@ -471,7 +474,7 @@ __global__ void Calc_summGradW(Real3* summGradW,  // write
                         if (d > RESOLUTION_LENGTH_MULT * h_i || sortedRhoPreMu[j].w <= -2 || i_idx == j)
                             continue;
                         Real h_j = sortedPosRad[j].w;
-                        Real m_j = h_j * h_j * h_j * paramsD.rho0;
+                        Real m_j = h_j * h_j * h_j * Params().rho0;
                         Real h_ij = 0.5 * (h_j + h_i);
                         Real3 grad_i_wij = GradWh(dist3, h_ij);
                         My_summgradW += m_j * grad_i_wij;
@@ -528,11 +531,11 @@ __device__ void Calc_BC_aij_Bi(const uint i_idx,
     uint csrEndIdx = numContacts[i_idx + 1];
 
     Real h_i = sortedPosRad[i_idx].w;
-    //    Real m_i = h_i * h_i * h_i * paramsD.rho0;
+    //    Real m_i = h_i * h_i * h_i * Params().rho0;
     Real3 my_normal = Normals[i_idx];
 
-    Real3 source_term = paramsD.gravity + paramsD.bodyForce3;
-    //  if (bceIndex >= numObjectsD.numRigid_SphMarkers) {
+    Real3 source_term = Params().gravity + Params().bodyForce3;
+    //  if (bceIndex >= NumObjects().numRigid_SphMarkers) {
     //    return;
     //  }
 
@@ -582,13 +585,13 @@ __device__ void Calc_BC_aij_Bi(const uint i_idx,
                             continue;
 
                         Real h_j = sortedPosRad[j].w;
-                        // Real m_j = h_j * h_j * h_j * paramsD.rho0;
+                        // Real m_j = h_j * h_j * h_j * Params().rho0;
                         // Real rhoj = sortedRhoPreMu[j].x;
                         Real h_ij = 0.5 * (h_j + h_i);
                         Real Wd = W3h(d, h_ij);
                         Real3 Vel_j = sortedVelMas[j];
 
-                        if (paramsD.bceType != ADAMI) {
+                        if (Params().bceType != ADAMI) {
                             if (sortedRhoPreMu[j].w == -1.0 || dot(my_normal, mR3(pos_i - pos_j)) > 0) {
                                 Real3 grad_i_wij = GradWh(dist3, h_ij);
                                 csrValA[csrStartIdx - 1] += dot(grad_i_wij, my_normal);
@@ -621,7 +624,7 @@ __device__ void Calc_BC_aij_Bi(const uint i_idx,
     if (abs(denumenator) < EPSILON) {
         V_new[i_idx] = 2 * V_prescribed;
         B_i[i_idx] = 0;
-        if (paramsD.bceType == ADAMI) {
+        if (Params().bceType == ADAMI) {
             csrValA[csrStartIdx - 1] = a_ii[i_idx];
             csrColIndA[csrStartIdx - 1] = i_idx;
             GlobalcsrColIndA[csrStartIdx - 1] = i_idx + numAllMarkers * i_idx;
@@ -630,7 +633,7 @@ __device__ void Calc_BC_aij_Bi(const uint i_idx,
         Real Scaling = a_ii[i_idx] / denumenator;
         V_new[i_idx] = 2 * V_prescribed - numeratorv / denumenator;
 
-        if (paramsD.bceType == ADAMI) {
+        if (Params().bceType == ADAMI) {
             B_i[i_idx] = pRHS;
             csrValA[csrStartIdx - 1] = denumenator;
             csrColIndA[csrStartIdx - 1] = i_idx;
@@ -642,7 +645,7 @@ __device__ void Calc_BC_aij_Bi(const uint i_idx,
         }
     }
 
-    if (paramsD.bceType != ADAMI) {
+    if (Params().bceType != ADAMI) {
         Real Scaling = a_ii[i_idx];
         if (abs(csrValA[csrStartIdx - 1]) > EPSILON) {
             Scaling = a_ii[i_idx];  // csrValA[csrStartIdx - 1];
@@ -697,13 +700,13 @@ __device__ void Calc_fluid_aij_Bi(const uint i_idx,
     Real dT = delta_t;
 
     int counter = 0;  // There is always one non-zero at each row- The marker itself
-    B_i[i_idx] = paramsD.rho0 - rho_np[i_idx];
+    B_i[i_idx] = Params().rho0 - rho_np[i_idx];
 
     uint csrStartIdx = numContacts[i_idx] + 1;  // Reserve the starting index for the A_ii
     uint csrEndIdx = numContacts[i_idx + 1];
 
     Real h_i = sortedPosRad[i_idx].w;
-    //    Real m_i = h_i * h_i * h_i * paramsD.rho0;
+    //    Real m_i = h_i * h_i * h_i * Params().rho0;
 
     //  for (int c = csrStartIdx; c < csrEndIdx; c++) {
     //    csrValA[c] = a_ii[i_idx];
@@ -734,7 +737,7 @@ __device__ void Calc_fluid_aij_Bi(const uint i_idx,
                         Real h_ij = 0.5 * (h_j + h_i);
                         Real3 grad_i_wij = GradWh(dist3, h_ij);
                         Real Rho_j = sortedRhoPreMu[j].x;
-                        Real m_j = h_j * h_j * h_j * paramsD.rho0;
+                        Real m_j = h_j * h_j * h_j * Params().rho0;
                         Real3 d_it = m_j * (-(dT * dT) / (Rho_j * Rho_j)) * grad_i_wij;
                         Real My_a_ij_1 = m_j * dot(d_it, summGradW[i_idx]);
                         Real My_a_ij_2 = m_j * dot(d_ii[j], grad_i_wij);
@@ -775,7 +778,7 @@ __device__ void Calc_fluid_aij_Bi(const uint i_idx,
                                             Real h_k = sortedPosRad[j].w;
                                             Real h_jk = 0.5 * (h_j + h_k);
                                             Real3 grad_j_wjk = GradWh(dist3jk, h_jk);
-                                            Real m_k = pow(sortedPosRad[k].w, 3) * paramsD.rho0;
+                                            Real m_k = pow(sortedPosRad[k].w, 3) * Params().rho0;
                                             Real Rho_k = sortedRhoPreMu[k].x;
                                             Real3 d_jk = m_k * (-(dT * dT) / (Rho_k * Rho_k)) * grad_j_wjk;
                                             Real My_a_ij_3 = m_j * dot(d_jk, grad_i_wij);
@@ -817,7 +820,7 @@ __device__ void Calc_fluid_aij_Bi(const uint i_idx,
     csrColIndA[csrStartIdx - 1] = i_idx;
     GlobalcsrColIndA[csrStartIdx - 1] = i_idx + numAllMarkers * i_idx;
 
-    if (sortedRhoPreMu[i_idx].x < 0.999 * paramsD.rho0) {
+    if (sortedRhoPreMu[i_idx].x < 0.999 * Params().rho0) {
         csrValA[csrStartIdx - 1] = a_ii[i_idx];
         for (int myIdx = csrStartIdx; myIdx < csrEndIdx; myIdx++) {
             csrValA[myIdx] = 0.0;
@@ -881,10 +884,10 @@ __global__ void FormAXB(Real* csrValA,
         return;
     }
 
-    //    Real m_0 = paramsD.markerMass;
-    //    Real RHO_0 = paramsD.rho0;
-    //    Real dT = paramsD.dT;
-    //    Real3 gravity = paramsD.gravity;
+    //    Real m_0 = Params().markerMass;
+    //    Real RHO_0 = Params().rho0;
+    //    Real dT = Params().dT;
+    //    Real3 gravity = Params().gravity;
 
     int TYPE_OF_NARKER = sortedRhoPreMu[i_idx].w;
 
@@ -936,9 +939,9 @@ __global__ void Calc_Pressure_AXB_USING_CSR(Real* csrValA,
         return;
     }
 
-    //    Real RHO_0 = paramsD.rho0;
-    //    bool ClampPressure = paramsD.ClampPressure;
-    //    Real Max_Pressure = paramsD.Max_Pressure;
+    //    Real RHO_0 = Params().rho0;
+    //    bool ClampPressure = Params().ClampPressure;
+    //    Real Max_Pressure = Params().Max_Pressure;
     uint startIdx = numContacts[i_idx] + 1;  // numContacts[i_idx] is the diagonal itself
     uint endIdx = numContacts[i_idx + 1];
 
@@ -953,7 +956,7 @@ __global__ void Calc_Pressure_AXB_USING_CSR(Real* csrValA,
     Residuals[i_idx] = abs(RHS - aij_pj - p_old[i_idx] * csrValA[startIdx - 1]);
     sortedRhoPreMu[i_idx].y = (RHS - aij_pj) / csrValA[startIdx - 1];
 
-    //    if (paramsD.ClampPressure && sortedRhoPreMu[i_idx].y < 0)
+    //    if (Params().ClampPressure && sortedRhoPreMu[i_idx].y < 0)
     //        sortedRhoPreMu[i_idx].y = 0;
     if (!isfinite(aij_pj)) {
         printf("a_ij *p_j became Nan in Calc_Pressure_AXB_USING_CSR ");
@@ -1009,11 +1012,11 @@ __global__ void Calc_Pressure(Real* a_ii,     // Read
     }
 
     Real h_i = sortedPosRad[i_idx].w;
-    Real m_i = h_i * h_i * h_i * paramsD.rho0;
+    Real m_i = h_i * h_i * h_i * Params().rho0;
 
-    Real RHO_0 = paramsD.rho0;
+    Real RHO_0 = Params().rho0;
     Real dT = delta_t;
-    Real3 source_term = paramsD.gravity + paramsD.bodyForce3;
+    Real3 source_term = Params().gravity + Params().bodyForce3;
 
     if (sortedRhoPreMu[i_idx].x < EPSILON) {
         printf("(Calc_Pressure)My density is %f in Calc_Pressure\n", sortedRhoPreMu[i_idx].x);
@@ -1049,13 +1052,13 @@ __global__ void Calc_Pressure(Real* a_ii,     // Read
                                 Real3 pos_j = mR3(sortedPosRad[j]);
                                 Real3 dist3ij = Distance(pos_i, pos_j);
                                 Real dij = length(dist3ij);
-                                if (dij > RESOLUTION_LENGTH_MULT * paramsD.HSML || i_idx == j ||
+                                if (dij > RESOLUTION_LENGTH_MULT * Params().HSML || i_idx == j ||
                                     sortedRhoPreMu[j].w <= -2)
                                     continue;
                                 //                Real Rho_j = sortedRhoPreMu[j].x;
                                 Real p_j_old = p_old[j];
                                 Real h_j = sortedPosRad[j].w;
-                                Real m_j = h_j * h_j * h_j * paramsD.rho0;
+                                Real m_j = h_j * h_j * h_j * Params().rho0;
 
                                 Real3 djj = d_ii[j];
                                 Real3 F_j_p = F_p[j];
@@ -1110,14 +1113,14 @@ __global__ void Calc_Pressure(Real* a_ii,     // Read
                             Real3 pos_j = mR3(sortedPosRad[j]);
                             Real3 dist3 = Distance(pos_i, pos_j);
                             Real d = length(dist3);
-                            if (d > RESOLUTION_LENGTH_MULT * paramsD.HSML || sortedRhoPreMu[j].w != -1)
+                            if (d > RESOLUTION_LENGTH_MULT * Params().HSML || sortedRhoPreMu[j].w != -1)
                                 continue;
                             // OLD VELOCITY IS SHOULD BE OBDATED NOT THE NEW ONE!!!!!
                             Real3 Vel_j = sortedVelMas[j];
                             Real p_j = p_old[j];
                             Real3 F_j_p = F_p[j];
                             Real h_j = sortedPosRad[j].w;
-                            Real m_j = h_j * h_j * h_j * paramsD.rho0;
+                            Real m_j = h_j * h_j * h_j * Params().rho0;
                             // Real rhoj = sortedRhoPreMu[j].x;
 
                             Real h_ij = 0.5 * (h_j + h_i);
@@ -1146,7 +1149,7 @@ __global__ void Calc_Pressure(Real* a_ii,     // Read
         Residuals[i_idx] = abs(numeratorp - denumenator * p_old[i_idx]) * a_ii[i_idx];
         V_new[i_idx] = Vel_i;
     }
-    // if (paramsD.ClampPressure && p_new < 0.0)
+    // if (Params().ClampPressure && p_new < 0.0)
     //    p_new = 0.0;
     rho_p[i_idx] = my_rho_p;
     sortedRhoPreMu[i_idx].y = p_new;
@@ -1177,9 +1180,9 @@ __global__ void Update_AND_Calc_Res(Real3* sortedVelMas,
     //  p_i = (1 - relax) * p_old_i + relax * p_i;
 
     sortedRhoPreMu[i_idx].y = (1 - params_relaxation) * p_old[i_idx] + params_relaxation * sortedRhoPreMu[i_idx].y;
-    // if(!paramsD.USE_LinearSolver)
+    // if(!Params().USE_LinearSolver)
     p_old[i_idx] = sortedRhoPreMu[i_idx].y;
-    // if (paramsD.ClampPressure && sortedRhoPreMu[i_idx].y < 0)
+    // if (Params().ClampPressure && sortedRhoPreMu[i_idx].y < 0)
     //    sortedRhoPreMu[i_idx].y = 0;
     //  Real AbsRes = abs(sortedRhoPreMu[i_idx].y - p_old[i_idx]);
 
@@ -1225,13 +1228,13 @@ __global__ void CalcForces(Real3* new_vel,  // Write
     //        return;
     //    }
 
-    Real mu_0 = paramsD.mu0;
+    Real mu_0 = Params().mu0;
     Real h_i = sortedPosRad[i_idx].w;
-    Real m_i = h_i * h_i * h_i * paramsD.rho0;
+    Real m_i = h_i * h_i * h_i * Params().rho0;
 
     Real dT = delta_t;
-    Real3 source_term = paramsD.gravity + paramsD.bodyForce3;
-    Real epsilon = paramsD.epsMinMarkersDis;
+    Real3 source_term = Params().gravity + Params().bodyForce3;
+    Real epsilon = Params().epsMinMarkersDis;
     Real3 posi = mR3(sortedPosRad[i_idx]);
     Real3 Veli = sortedVelMas[i_idx];
 
@@ -1245,7 +1248,7 @@ __global__ void CalcForces(Real3* new_vel,  // Write
     Real3 F_i_mu = mR3(0);
     Real3 F_i_surface_tension = mR3(0);
     Real3 F_i_p = mR3(0);
-    if ((sortedRhoPreMu[i_idx].x > 3 * paramsD.rho0 || sortedRhoPreMu[i_idx].x < 0) && sortedRhoPreMu[i_idx].w < 0)
+    if ((sortedRhoPreMu[i_idx].x > 3 * Params().rho0 || sortedRhoPreMu[i_idx].x < 0) && sortedRhoPreMu[i_idx].w < 0)
         printf("too large/small density marker %d, type=%f\n", i_idx, sortedRhoPreMu[i_idx].w);
 
     Real r0 = 0;
@@ -1286,7 +1289,7 @@ __global__ void CalcForces(Real3* new_vel,  // Write
 
                     Real3 eij = rij / d;
                     Real h_j = sortedPosRad[j].w;
-                    Real m_j = h_j * h_j * h_j * paramsD.rho0;
+                    Real m_j = h_j * h_j * h_j * Params().rho0;
 
                     mi_bar += m_j;
                     Ni++;
@@ -1307,10 +1310,10 @@ __global__ void CalcForces(Real3* new_vel,  // Write
                         F_i_p += -m_j * ((p_i / (rho_i * rho_i)) + (p_j / (rho_j * rho_j))) * grad_ij;
 
                     Real Rho_bar = (rho_j + rho_i) * 0.5;
-                    //                    Real nu = mu_0 * paramsD.HSML * 320 / Rho_bar;
+                    //                    Real nu = mu_0 * Params().HSML * 320 / Rho_bar;
                     //                    Real3 muNumerator = nu * fminf(0.0, dot(rij, V_ij)) * grad_ij;
                     Real3 muNumerator = 2 * mu_0 * dot(rij, grad_ij) * V_ij;
-                    Real muDenominator = (Rho_bar * Rho_bar) * (d * d + paramsD.HSML * paramsD.HSML * epsilon);
+                    Real muDenominator = (Rho_bar * Rho_bar) * (d * d + Params().HSML * Params().HSML * epsilon);
                     // Only Consider (fluid-fluid + fluid-solid) or Solid-Fluid Interaction
                     if (sortedRhoPreMu[i_idx].w < 0 || (sortedRhoPreMu[i_idx].w >= 0 && sortedRhoPreMu[j].w < 0))
                         //                    if ((sortedRhoPreMu[i_idx].w < 0 && sortedRhoPreMu[j].w < 0))
@@ -1330,11 +1333,11 @@ __global__ void CalcForces(Real3* new_vel,  // Write
                          Li[1] * eij.y * grad_ij.x + Li[3] * eij.y * grad_ij.y + Li[4] * eij.y * grad_ij.z +
                          Li[2] * eij.z * grad_ij.x + Li[4] * eij.z * grad_ij.y + Li[5] * eij.z * grad_ij.z);
 
-                    LaplacainVi.x += commonterm * (V_ij.x / (d + h_ij * paramsD.epsMinMarkersDis) - dot(eij, myGradvx));
-                    LaplacainVi.y += commonterm * (V_ij.y / (d + h_ij * paramsD.epsMinMarkersDis) - dot(eij, myGradvy));
-                    LaplacainVi.z += commonterm * (V_ij.y / (d + h_ij * paramsD.epsMinMarkersDis) - dot(eij, myGradvz));
+                    LaplacainVi.x += commonterm * (V_ij.x / (d + h_ij * Params().epsMinMarkersDis) - dot(eij, myGradvx));
+                    LaplacainVi.y += commonterm * (V_ij.y / (d + h_ij * Params().epsMinMarkersDis) - dot(eij, myGradvy));
+                    LaplacainVi.z += commonterm * (V_ij.y / (d + h_ij * Params().epsMinMarkersDis) - dot(eij, myGradvz));
 
-                    if (!isfinite(length(LaplacainVi)) && !paramsD.Conservative_Form) {
+                    if (!isfinite(length(LaplacainVi)) && !Params().Conservative_Form) {
                         printf("LaplacainVi in CalcForces returns Nan or Inf");
                     }
                 }
@@ -1347,12 +1350,12 @@ __global__ void CalcForces(Real3* new_vel,  // Write
         mi_bar /= Ni;
     }
     if (mi_bar > EPSILON)
-        r_shift[i_idx] = paramsD.beta_shifting * r0 * r0 * paramsD.v_Max * dT / mi_bar * inner_sum;
+        r_shift[i_idx] = Params().beta_shifting * r0 * r0 * Params().v_Max * dT / mi_bar * inner_sum;
 
-    F_i_surface_tension = -F_i_surface_tension * paramsD.kappa / m_i;
+    F_i_surface_tension = -F_i_surface_tension * Params().kappa / m_i;
     // Forces are per unit mass at this point.
 
-    //    if (paramsD.Conservative_Form)
+    //    if (Params().Conservative_Form)
     derivVelRhoD[i_idx] = mR4((F_i_p + F_i_mu + F_i_surface_tension) * m_i);
     //    else
     //        derivVelRhoD[i_idx] = mR4((F_i_p + mu_0 * LaplacainVi + F_i_surface_tension) * m_i);
@@ -1396,7 +1399,7 @@ __global__ void FinalizePressure(Real4* sortedPosRad,  // Read
         sortedRhoPreMu[i_idx].y = 0.0;
     }
 
-    //  Real m_0 = paramsD.markerMass;
+    //  Real m_0 = Params().markerMass;
     Real3 posi = mR3(sortedPosRad[i_idx]);
     //  Real Rho_i = sortedRhoPreMu[i_idx].x;
     //  Real3 my_F_p = mR3(0);
@@ -1414,16 +1417,16 @@ __global__ void FinalizePressure(Real4* sortedPosRad,  // Read
     Real h_i = sortedPosRad[i_idx].w;
 
     //    if (p_shift < 0)
-    sortedRhoPreMu[i_idx].y = p_old[i_idx] + ((paramsD.ClampPressure) ? paramsD.BASEPRES : 0.0);  //- p_shift;
+    sortedRhoPreMu[i_idx].y = p_old[i_idx] + ((Params().ClampPressure) ? Params().BASEPRES : 0.0);  //- p_shift;
 
-    if (paramsD.ClampPressure && sortedRhoPreMu[i_idx].y < 0)
+    if (Params().ClampPressure && sortedRhoPreMu[i_idx].y < 0)
         sortedRhoPreMu[i_idx].y = 0;
 
     // if (sortedRhoPreMu[i_idx].y < 0)
     //     sortedRhoPreMu[i_idx].y = (p_old[i_idx] > 0) ? p_old[i_idx] : 0.0;
 
-    if (sortedRhoPreMu[i_idx].y > paramsD.Max_Pressure)
-        sortedRhoPreMu[i_idx].y = paramsD.Max_Pressure;
+    if (sortedRhoPreMu[i_idx].y > Params().Max_Pressure)
+        sortedRhoPreMu[i_idx].y = Params().Max_Pressure;
 
     if (sortedRhoPreMu[i_idx].w == -1)
         return;
@@ -1443,11 +1446,11 @@ __global__ void FinalizePressure(Real4* sortedPosRad,  // Read
                     Real3 posJ = mR3(sortedPosRad[j]);
                     Real3 dist3 = Distance(posi, posJ);
                     Real d = length(dist3);
-                    if (d > RESOLUTION_LENGTH_MULT * paramsD.HSML || sortedRhoPreMu[j].w != -1)
+                    if (d > RESOLUTION_LENGTH_MULT * Params().HSML || sortedRhoPreMu[j].w != -1)
                         continue;
                     //                    Real3 grad_i_wij = GradW(dist3);
                     Real h_j = sortedPosRad[j].w;
-                    Real m_j = h_j * h_j * h_j * paramsD.rho0;
+                    Real m_j = h_j * h_j * h_j * Params().rho0;
 
                     Real h_ij = 0.5 * (h_j + h_i);
                     Real Wd = m_j * W3h(d, h_ij);
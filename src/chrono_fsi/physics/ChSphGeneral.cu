@@ -25,10 +25,20 @@
 namespace chrono {
 namespace fsi {
 
+#ifdef CHRONO_FSI_USE_CPU
+fsi::SimParams paramsH_CPU;
+fsi::NumberOfObjects numObjectsH_CPU;
+#endif
+
 void CopyParams_NumberOfObjects(std::shared_ptr<SimParams> paramsH, std::shared_ptr<NumberOfObjects> numObjectsH) {
+#ifdef CHRONO_FSI_USE_CPU
+    paramsH_CPU = *paramsH;
+    numObjectsH_CPU = *numObjectsH;
+#else
     cudaMemcpyToSymbolAsync(paramsD, paramsH.get(), sizeof(SimParams));
     cudaMemcpyToSymbolAsync(numObjectsD, numObjectsH.get(), sizeof(NumberOfObjects));
     cudaDeviceSynchronize();
+#endif
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
@@ -50,10 +60,10 @@ __global__ void calc_A_tensor(Real* A_tensor,
     // elements of matrix B depends on tensor A
 
     uint csrStartIdx = numContacts[i_idx];
-    uint csrEndIdx = numContacts[i_idx + 1];  //- paramsD.Pressure_Constraint;
+    uint csrEndIdx = numContacts[i_idx + 1];  //- Params().Pressure_Constraint;
     Real3 posRadA = mR3(sortedPosRad[i_idx]);
     Real h_i = sortedPosRad[i_idx].w;
-    Real m_i = pow(h_i * paramsD.MULT_INITSPACE, 3) * paramsD.rho0;
+    Real m_i = pow(h_i * Params().MULT_INITSPACE, 3) * Params().rho0;
     //    Real sum_mW = 0;
     Real A_ijk[27] = {0.0};
 
@@ -72,7 +82,7 @@ __global__ void calc_A_tensor(Real* A_tensor,
         if (d > RESOLUTION_LENGTH_MULT * h_i || sortedRhoPreMu[j].w <= -2)
             continue;
         Real h_j = sortedPosRad[j].w;
-        Real m_j = pow(h_j * paramsD.MULT_INITSPACE, 3) * paramsD.rho0;
+        Real m_j = pow(h_j * Params().MULT_INITSPACE, 3) * Params().rho0;
         Real h_ij = 0.5 * (h_j + h_i);
         Real3 grad_ij = GradWh(rij, h_ij);
         Real V_j = sumWij_inv[j];
@@ -143,10 +153,10 @@ __global__ void calc_L_tensor(Real* A_tensor,
     // elements of matrix B depends on tensor A
 
     uint csrStartIdx = numContacts[i_idx];
-    uint csrEndIdx = numContacts[i_idx + 1];  // - paramsD.Pressure_Constraint;
+    uint csrEndIdx = numContacts[i_idx + 1];  // - Params().Pressure_Constraint;
     Real3 posRadA = mR3(sortedPosRad[i_idx]);
     Real h_i = sortedPosRad[i_idx].w;
-    Real m_i = pow(h_i * paramsD.MULT_INITSPACE, 3) * paramsD.rho0;
+    Real m_i = pow(h_i * Params().MULT_INITSPACE, 3) * Params().rho0;
     Real B[36] = {0.0};
 
     //    Real Gi[9] = {0.0};
@@ -170,7 +180,7 @@ __global__ void calc_L_tensor(Real* A_tensor,
         Real3 eij = rij / d;
 
         Real h_j = sortedPosRad[j].w;
-        Real m_j = pow(h_j * paramsD.MULT_INITSPACE, 3) * paramsD.rho0;
+        Real m_j = pow(h_j * Params().MULT_INITSPACE, 3) * Params().rho0;
         Real h_ij = 0.5 * (h_j + h_i);
         Real3 grad_ij = GradWh(rij, h_ij);
         Real V_j = sumWij_inv[j];
@@ -275,7 +285,7 @@ __global__ void calcRho_kernel(Real4* sortedPosRad,
 
     Real3 posRadA = mR3(sortedPosRad[i_idx]);
     Real h_i = sortedPosRad[i_idx].w;
-    Real m_i = pow((h_i * paramsD.MULT_INITSPACE), 3) * paramsD.rho0;
+    Real m_i = pow((h_i * Params().MULT_INITSPACE), 3) * Params().rho0;
     //    printf("paramsD.MULT_INITSPACE=%f, h_i,m_i ", paramsD.MULT_INITSPACE, h_i, m_i);
 
     Real sum_mW = 0;
@@ -304,7 +314,7 @@ __global__ void calcRho_kernel(Real4* sortedPosRad,
                         if (i_idx != j)
                             mcon++;
                         Real h_j = sortedPosRad[j].w;
-                        Real m_j = pow(h_j * paramsD.MULT_INITSPACE, 3) * paramsD.rho0;
+                        Real m_j = pow(h_j * Params().MULT_INITSPACE, 3) * Params().rho0;
                         Real W3 = W3h(d, 0.5 * (h_j + h_i));
                         //                        Real W3 = 0.5 * (W3h(d, h_i) + W3h(d, h_j));
                         sum_mW += m_j * W3;
@@ -312,13 +322,13 @@ __global__ void calcRho_kernel(Real4* sortedPosRad,
                     }
                 }
             }
-    mynumContact[i_idx] = mcon;  //+ paramsD.Pressure_Constraint;  // on extra for handling constraints
+    mynumContact[i_idx] = mcon;  //+ Params().Pressure_Constraint;  // on extra for handling constraints
     // Adding neighbor contribution is done!
     sumWij_inv[i_idx] = m_i / sum_mW;
     //    printf("%f, ", m_i / sum_mW);
     sortedRhoPreMu[i_idx].x = sum_mW;
 
-    if ((sortedRhoPreMu[i_idx].x > 2 * paramsD.rho0 || sortedRhoPreMu[i_idx].x < 0) && sortedRhoPreMu[i_idx].w == -1)
+    if ((sortedRhoPreMu[i_idx].x > 2 * Params().rho0 || sortedRhoPreMu[i_idx].x < 0) && sortedRhoPreMu[i_idx].w == -1)
         printf("(calcRho_kernel)too large/small density marker %d, rho=%f, sum_W=%f, m_i=%f\n", i_idx,
                sortedRhoPreMu[i_idx].x, sum_W, m_i);
 }
@@ -339,15 +349,15 @@ __global__ void calcNormalizedRho_kernel(Real4* sortedPosRad,  // input: sorted
     if (i_idx >= numAllMarkers || sortedRhoPreMu[i_idx].w <= -2) {
         return;
     }
-    //    Real3 gravity = paramsD.gravity;
-    Real RHO_0 = paramsD.rho0;
-    //    Real IncompressibilityFactor = paramsD.IncompressibilityFactor;
+    //    Real3 gravity = Params().gravity;
+    Real RHO_0 = Params().rho0;
+    //    Real IncompressibilityFactor = Params().IncompressibilityFactor;
     //    dxi_over_Vi[i_idx] = 1e10;
     if (sortedRhoPreMu[i_idx].w == -2)
         return;
     Real3 posRadA = mR3(sortedPosRad[i_idx]);
     Real h_i = sortedPosRad[i_idx].w;
-    //    Real m_i = pow(h_i * paramsD.MULT_INITSPACE, 3) * paramsD.rho0;
+    //    Real m_i = pow(h_i * Params().MULT_INITSPACE, 3) * Params().rho0;
     Real sum_mW = 0;
     Real sum_Wij_inv = 0;
     Real C = 0;
@@ -361,7 +371,7 @@ __global__ void calcNormalizedRho_kernel(Real4* sortedPosRad,  // input: sorted
         theta_i = 1;
     Real3 mynormals = mR3(0.0);
 
-    //  /// if (gridPos.x == paramsD.gridSize.x-1) printf("****aha %d %d\n", gridPos.x, paramsD.gridSize.x);
+    //  /// if (gridPos.x == Params().gridSize.x-1) printf("****aha %d %d\n", gridPos.x, Params().gridSize.x);
     //
     // examine neighbouring cells
     for (int z = -1; z <= 1; z++)
@@ -381,7 +391,7 @@ __global__ void calcNormalizedRho_kernel(Real4* sortedPosRad,  // input: sorted
                         Real3 dv3 = Distance(sortedVelMas[i_idx], sortedVelMas[j]);
                         Real d = length(dist3);
                         Real h_j = sortedPosRad[j].w;
-                        Real m_j = pow(h_j * 1, 3) * paramsD.rho0;
+                        Real m_j = pow(h_j * 1, 3) * Params().rho0;
                         C += m_j * Color[i_idx] / sortedRhoPreMu[i_idx].x * W3h(d, 0.5 * (h_j + h_i));
 
                         if (d > RESOLUTION_LENGTH_MULT * h_i || sortedRhoPreMu[j].w <= -2)
@@ -480,9 +490,9 @@ __global__ void calcNormalizedRho_Gi_fillInMatrixIndices(Real4* sortedPosRad,  /
     if (i_idx >= numAllMarkers) {
         return;
     }
-    Real RHO_0 = paramsD.rho0;
+    Real RHO_0 = Params().rho0;
     uint csrStartIdx = numContacts[i_idx] + 1;  // Reserve the starting index for the A_ii
-    //    uint csrEndIdx = numContacts[i_idx + 1];    //- paramsD.Pressure_Constraint;
+    //    uint csrEndIdx = numContacts[i_idx + 1];    //- Params().Pressure_Constraint;
     Real3 posRadA = mR3(sortedPosRad[i_idx]);
     Real h_i = sortedPosRad[i_idx].w;
     Real sum_mW = 0;
@@ -525,7 +535,7 @@ __global__ void calcNormalizedRho_Gi_fillInMatrixIndices(Real4* sortedPosRad,  /
                         Real3 dv3 = Distance(sortedVelMas[i_idx], sortedVelMas[j]);
                         Real d = length(rij);
                         Real h_j = sortedPosRad[j].w;
-                        Real m_j = pow(h_j * paramsD.MULT_INITSPACE, 3) * paramsD.rho0;
+                        Real m_j = pow(h_j * Params().MULT_INITSPACE, 3) * Params().rho0;
                         Real h_ij = 0.5 * (h_j + h_i);
                         Real W3 = W3h(d, h_ij);
                         Real3 grad_i_wij = GradWh(rij, h_ij);
@@ -640,9 +650,9 @@ __global__ void Function_Gradient_Laplacian_Operator(Real4* sortedPosRad,  // in
     if (sortedRhoPreMu[i_idx].w <= -2)
         return;
 
-    //    Real RHO_0 = paramsD.rho0;
+    //    Real RHO_0 = Params().rho0;
     uint csrStartIdx = numContacts[i_idx];
-    uint csrEndIdx = numContacts[i_idx + 1];  //- paramsD.Pressure_Constraint;
+    uint csrEndIdx = numContacts[i_idx + 1];  //- Params().Pressure_Constraint;
     Real3 posRadA = mR3(sortedPosRad[i_idx]);
     Real h_i = sortedPosRad[i_idx].w;
     // get address in grid
@@ -654,7 +664,7 @@ __global__ void Function_Gradient_Laplacian_Operator(Real4* sortedPosRad,  // in
     Real NormGi = 0;
     Real NormLi = 0;
 
-    //    if (paramsD.Pressure_Constraint) {
+    //    if (Params().Pressure_Constraint) {
     //        csrColInd[csrEndIdx] = numAllMarkers;
     //        A_G[csrEndIdx] = mR3(0.0);
     //        A_L[csrEndIdx] = 0.0;
@@ -671,7 +681,7 @@ __global__ void Function_Gradient_Laplacian_Operator(Real4* sortedPosRad,  // in
     }
 
     Real V_i = sumWij_inv[i_idx];
-    Real m_i = pow(h_i * paramsD.MULT_INITSPACE, 3) * paramsD.rho0;
+    Real m_i = pow(h_i * Params().MULT_INITSPACE, 3) * Params().rho0;
     Real rhoi = sortedRhoPreMu[i_idx].x;
     for (int count = csrStartIdx; count < csrEndIdx; count++) {
         int j = csrColInd[count];
@@ -680,7 +690,7 @@ __global__ void Function_Gradient_Laplacian_Operator(Real4* sortedPosRad,  // in
         Real d = length(rij);
         Real3 eij = rij / d;
         Real h_j = sortedPosRad[j].w;
-        Real m_j = pow(h_j * paramsD.MULT_INITSPACE, 3) * paramsD.rho0;
+        Real m_j = pow(h_j * Params().MULT_INITSPACE, 3) * Params().rho0;
         //        Real h_ij = 0.5 * (h_j + h_i);
         //        Real W3 = W3h(d, h_ij);
         //        Real3 grad_i_wij = GradWh(rij, h_ij);
@@ -689,16 +699,16 @@ __global__ void Function_Gradient_Laplacian_Operator(Real4* sortedPosRad,  // in
 
         Real V_j = sumWij_inv[j];
         A_f[count] = V_j * W3;
-        if (paramsD.Conservative_Form) {
-            if (paramsD.gradient_type == 0) {
+        if (Params().Conservative_Form) {
+            if (Params().gradient_type == 0) {
                 Real Coeff = V_j;
                 A_G[count] = Coeff * grad_i_wij;
                 A_G[csrStartIdx] -= Coeff * grad_i_wij;
-            } else if (paramsD.gradient_type == 1) {
+            } else if (Params().gradient_type == 1) {
                 Real Coeff = V_j;
                 A_G[count] = Coeff * grad_i_wij;
                 A_G[csrStartIdx] += Coeff * grad_i_wij;
-            } else if (paramsD.gradient_type == 2) {
+            } else if (Params().gradient_type == 2) {
                 Real3 comm = m_j * rhoi * grad_i_wij;
                 A_G[count] = 1.0 / (sortedRhoPreMu[j].x * sortedRhoPreMu[j].x) * comm;
                 A_G[csrStartIdx] += 1.0 / (rhoi * rhoi) * comm;
@@ -729,29 +739,29 @@ __global__ void Function_Gradient_Laplacian_Operator(Real4* sortedPosRad,  // in
         Real d = length(rij);
         Real3 eij = rij / d;
         Real h_j = sortedPosRad[j].w;
-        Real m_j = pow(h_j * paramsD.MULT_INITSPACE, 3) * paramsD.rho0;
+        Real m_j = pow(h_j * Params().MULT_INITSPACE, 3) * Params().rho0;
         Real h_ij = 0.5 * (h_j + h_i);
         Real W3 = W3h(d, h_ij);
         Real3 grad_ij = GradWh(rij, h_ij);
         Real V_j = sumWij_inv[j];
         if (d < EPSILON)
             continue;
-        if (paramsD.Conservative_Form) {
-            if (paramsD.laplacian_type == 0) {
+        if (Params().Conservative_Form) {
+            if (Params().laplacian_type == 0) {
                 Real commonterm = 1.0 / V_j * (V_j * V_j + V_i * V_i) * dot(rij, grad_ij);
-                A_L[count] -= commonterm / (d * d + h_ij * h_ij * paramsD.epsMinMarkersDis);        // j
-                A_L[csrStartIdx] += commonterm / (d * d + h_ij * h_ij * paramsD.epsMinMarkersDis);  // i
+                A_L[count] -= commonterm / (d * d + h_ij * h_ij * Params().epsMinMarkersDis);        // j
+                A_L[csrStartIdx] += commonterm / (d * d + h_ij * h_ij * Params().epsMinMarkersDis);  // i
                 for (int count_in = csrStartIdx; count_in < csrEndIdx; count_in++) {
                     A_L[count_in] -= commonterm * dot(A_G[count_in], eij);  // k
                 }
-            } else if (paramsD.laplacian_type == 1) {
-                Real comm = 2.0 / rhoi * m_j * dot(rij, grad_ij) / (d * d + h_ij * h_ij * paramsD.epsMinMarkersDis);
+            } else if (Params().laplacian_type == 1) {
+                Real comm = 2.0 / rhoi * m_j * dot(rij, grad_ij) / (d * d + h_ij * h_ij * Params().epsMinMarkersDis);
                 A_L[count] = -comm;        // j
                 A_L[csrStartIdx] += comm;  // i
                                            //                Real commonterm = 2 * V_j * dot(eij, grad_ij);
             } else {
                 Real comm = 2.0 / V_i * (V_j * V_j + V_i * V_i) * dot(rij, grad_ij) /
-                            (d * d + h_ij * h_ij * paramsD.epsMinMarkersDis);
+                            (d * d + h_ij * h_ij * Params().epsMinMarkersDis);
                 A_L[count] = -comm;        // j
                 A_L[csrStartIdx] += comm;  // i
             }
@@ -761,8 +771,8 @@ __global__ void Function_Gradient_Laplacian_Operator(Real4* sortedPosRad,  // in
                                Li[1] * eij.y * grad_ij.x + Li[3] * eij.y * grad_ij.y + Li[4] * eij.y * grad_ij.z +
                                Li[2] * eij.z * grad_ij.x + Li[4] * eij.z * grad_ij.y + Li[5] * eij.z * grad_ij.z);
 
-            A_L[count] -= commonterm / (d + h_ij * paramsD.epsMinMarkersDis);        // j
-            A_L[csrStartIdx] += commonterm / (d + h_ij * paramsD.epsMinMarkersDis);  // i
+            A_L[count] -= commonterm / (d + h_ij * Params().epsMinMarkersDis);        // j
+            A_L[csrStartIdx] += commonterm / (d + h_ij * Params().epsMinMarkersDis);  // i
 
             for (int count_in = csrStartIdx; count_in < csrEndIdx; count_in++) {
                 A_L[count_in] -= commonterm * dot(A_G[count_in], eij);  // k
@@ -794,7 +804,7 @@ __global__ void Jacobi_SOR_Iter(Real4* sortedRhoPreMu,
     }
 
     uint startIdx = numContacts[i_idx] + 1;  // Reserve the starting index for the A_ii
-    uint endIdx = numContacts[i_idx + 1];    //- uint(_3dvector && paramsD.Pressure_Constraint);
+    uint endIdx = numContacts[i_idx + 1];    //- uint(_3dvector && Params().Pressure_Constraint);
 
     if (_3dvector) {
         Real3 aij_vj = mR3(0.0);
@@ -843,8 +853,8 @@ __global__ void Update_AND_Calc_Res(Real4* sortedRhoPreMu,
     if (i_idx >= numAllMarkers) {
         return;
     }
-    //    Real omega = _3dvector ? 1.0 : paramsD.PPE_relaxation;
-    Real omega = paramsD.PPE_relaxation;
+    //    Real omega = _3dvector ? 1.0 : Params().PPE_relaxation;
+    Real omega = Params().PPE_relaxation;
 
     Real res = 0;
     if (_3dvector) {
@@ -905,14 +915,14 @@ __global__ void UpdateDensity(Real3* vis_vel,
         sortedRhoPreMu[i_idx].z = 0;
         return;
     }
-    Real dT = paramsD.dT;
+    Real dT = Params().dT;
     Real rho_plus = 0;
     Real3 Vel_i = sortedVelMas[i_idx];
     Real3 posi = mR3(sortedPosRad[i_idx]);
-    if ((sortedRhoPreMu[i_idx].x > 2 * paramsD.rho0 || sortedRhoPreMu[i_idx].x < 0) && sortedRhoPreMu[i_idx].w < 0)
+    if ((sortedRhoPreMu[i_idx].x > 2 * Params().rho0 || sortedRhoPreMu[i_idx].x < 0) && sortedRhoPreMu[i_idx].w < 0)
         printf("(UpdateDensity-0)too large/small density marker %d, type=%f\n", i_idx, sortedRhoPreMu[i_idx].w);
     Real h_i = sortedPosRad[i_idx].w;
-    //    Real m_i = pow(h_i * paramsD.MULT_INITSPACE, 3) * paramsD.rho0;
+    //    Real m_i = pow(h_i * Params().MULT_INITSPACE, 3) * Params().rho0;
     int3 gridPos = calcGridPos(posi);
 
     Real3 normalizedV_n = mR3(0);
@@ -936,7 +946,7 @@ __global__ void UpdateDensity(Real3* vis_vel,
                         continue;
                     Real3 Vel_j = sortedVelMas[j];
                     Real h_j = sortedPosRad[j].w;
-                    Real m_j = pow(h_j * paramsD.MULT_INITSPACE, 3) * paramsD.rho0;
+                    Real m_j = pow(h_j * Params().MULT_INITSPACE, 3) * Params().rho0;
                     Real h_ij = 0.5 * (h_j + h_i);
                     Real3 grad_i_wij = GradWh(dist3, h_ij);
                     rho_plus += m_j * dot((Vel_i - Vel_j), grad_i_wij) * sumWij_inv[j];
@@ -961,7 +971,7 @@ __global__ void UpdateDensity(Real3* vis_vel,
     }
     if (abs(sumW) > EPSILON) {
         vis_vel[i_idx] = normalizedV_n / normalizedV_d;
-        //        sortedVelMas[i_idx] = paramsD.EPS_XSPH * vis_vel[i_idx] + (1 - paramsD.EPS_XSPH) *
+        //        sortedVelMas[i_idx] = Params().EPS_XSPH * vis_vel[i_idx] + (1 - Params().EPS_XSPH) *
         //        sortedVelMas[i_idx]; //race condition
     }
     XSPH_Vel[i_idx] = xSPH_Sum;  //
@@ -969,7 +979,7 @@ __global__ void UpdateDensity(Real3* vis_vel,
     sortedRhoPreMu[i_idx].x += rho_plus * dT;
 
     //    sortedRhoPreMu[i_idx].y = Eos(sortedRhoPreMu[i_idx].x, sortedRhoPreMu[i_idx].w);
-    if ((sortedRhoPreMu[i_idx].x > 2 * paramsD.rho0 || sortedRhoPreMu[i_idx].x < 0) && sortedRhoPreMu[i_idx].w < 0)
+    if ((sortedRhoPreMu[i_idx].x > 2 * Params().rho0 || sortedRhoPreMu[i_idx].x < 0) && sortedRhoPreMu[i_idx].w < 0)
         printf("(UpdateDensity-1)too large/small density marker %d, type=%f\n", i_idx, sortedRhoPreMu[i_idx].w);
 }
 
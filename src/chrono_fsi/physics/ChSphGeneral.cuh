@@ -40,6 +40,35 @@ namespace fsi {
 __constant__ static fsi::SimParams paramsD;
 __constant__ static fsi::NumberOfObjects numObjectsD;
 
+#ifdef CHRONO_FSI_USE_CPU
+/// Host copies of the simulation parameters, used by the CPU backend.
+/// The Finalize functions assign them instead of copying to the __constant__ symbols above. Unlike those symbols, these
+/// are shared by all translation units (defined in ChSphGeneral.cu).
+extern fsi::SimParams paramsH_CPU;
+extern fsi::NumberOfObjects numObjectsH_CPU;
+#endif
+
+/// Simulation parameters, as seen by the calling code.
+/// Device code reads the __constant__ copy; host code in the CPU backend reads the host copy, so that the
+/// __host__ __device__ marker functions use the same parameters on either backend. Declared static, like the
+/// __constant__ symbols it refers to.
+__host__ __device__ static inline const SimParams& Params() {
+#if defined(CHRONO_FSI_USE_CPU) && !defined(__CUDA_ARCH__)
+    return paramsH_CPU;
+#else
+    return paramsD;
+#endif
+}
+
+/// Numbers of objects, as seen by the calling code (see Params).
+__host__ __device__ static inline const NumberOfObjects& NumObjects() {
+#if defined(CHRONO_FSI_USE_CPU) && !defined(__CUDA_ARCH__)
+    return numObjectsH_CPU;
+#else
+    return numObjectsD;
+#endif
+}
+
 void CopyParams_NumberOfObjects(std::shared_ptr<SimParams> paramsH, std::shared_ptr<NumberOfObjects> numObjectsH);
 //#define W3 W3_Spline
 //#define W2 W2_Spline
@@ -57,9 +86,9 @@ void CopyParams_NumberOfObjects(std::shared_ptr<SimParams> paramsH, std::shared_
 
 //--------------------------------------------------------------------------------------------------------------------------------
 // 3D SPH kernel function, W3_SplineA
-__device__ inline Real W3_Spline(Real d) {  // d is positive. h is the sph particle radius (i.e. h in
+__host__ __device__ inline Real W3_Spline(Real d) {  // d is positive. h is the sph particle radius (i.e. h in
                                             // the document) d is the distance of 2 particles
-    Real h = paramsD.HSML;
+    Real h = Params().HSML;
     Real q = fabs(d) / h;
     if (q < 1) {
         return (0.25f / (PI * h * h * h) * (pow(2 - q, Real(3)) - 4 * pow(1 - q, Real(3))));
@@ -94,7 +123,7 @@ __host__ __device__ inline Real W3h_High(Real d, Real h) {  // d is positive. h
 }
 
 //// 3D SPH kernel function, W3_SplineA
-__device__ inline Real W3H_KERNEL(Real d, Real h) {  // d is positive. h is the sph particle radius (i.e. h in
+__host__ __device__ inline Real W3H_KERNEL(Real d, Real h) {  // d is positive. h is the sph particle radius (i.e. h in
                                                      // the document) d is the distance of 2 particles
     Real q = fabs(d) / h;
     if (q < 1) {
@@ -109,7 +138,7 @@ __device__ inline Real W3H_KERNEL(Real d, Real h) {  // d is positive. h is the
     }
     return 0;
 }
-__device__ inline Real3 W3H_GRADW(Real3 d, Real h) {  // d is positive. h is the sph particle radius (i.e. h in
+__host__ __device__ inline Real3 W3H_GRADW(Real3 d, Real h) {  // d is positive. h is the sph particle radius (i.e. h in
                                                       // the document) d is the distance of 2 particles
     Real q = length(d) / h;
     if (fabs(q) < 1e-10)
@@ -133,7 +162,7 @@ __device__ inline Real3 W3H_GRADW(Real3 d, Real h) {  // d is positive. h is the
 //__device__ inline Real W2_Spline(Real d) { // d is positive. h is the sph
 // particle radius (i.e. h in the document) d
 // is the distance of 2 particles
-//	Real h = paramsD.HSML;
+//	Real h = Params().HSML;
 //	Real q = fabs(d) / h;
 //	if (q < 1) {
 //		return (5 / (14 * PI * h * h) * (pow(2 - q, Real(3)) - 4 * pow(1 -
@@ -174,9 +203,9 @@ __device__ inline Real3 W3H_GRADW(Real3 d, Real h) {  // d is positive. h is the
 // dW * dist3 gives the gradiant of W3_Quadratic, where dist3 is the distance
 // vector of the two particles, (dist3)a =
 // pos_a - pos_b
-__device__ inline Real3 GradW_Spline(Real3 d) {  // d is positive. r is the sph particle radius (i.e. h
+__host__ __device__ inline Real3 GradW_Spline(Real3 d) {  // d is positive. r is the sph particle radius (i.e. h
                                                  // in the document) d is the distance of 2 particles
-    Real h = paramsD.HSML;
+    Real h = Params().HSML;
     Real q = length(d) / h;
     bool less1 = (q < 1);
     bool less2 = (q < 2);
@@ -191,21 +220,21 @@ __device__ inline Real3 GradW_Spline(Real3 d) {  // d is positive. r is the sph
     //	return mR3(0);
 }
 
-__device__ inline Real3 GradWh_Spline(Real3 d, Real h) {  // d is positive. r is the sph particle radius (i.e. h
-                                                          // in the document) d is the distance of 2 particles
+// d is positive. r is the sph particle radius (i.e. h in the document) d is the distance of 2 particles
+__host__ __device__ inline Real3 GradWh_Spline(Real3 d, Real h) {
     Real q = length(d) / h;
 
-    if (abs(q) < EPSILON)
+    if (fabs(q) < EPSILON)
         return mR3(0.0);
     bool less1 = (q < 1);
     bool less2 = (q < 2);
     return (less1 * (3 * q - 4) + less2 * (!less1) * (-q + 4.0f - 4.0f / q)) * .75f * (INVPI)*pow(h, Real(-5)) * d;
 }
 
-__device__ inline Real3 GradWh_High(Real3 d, Real h) {  // d is positive. r is the sph particle radius (i.e. h
+__host__ __device__ inline Real3 GradWh_High(Real3 d, Real h) {  // d is positive. r is the sph particle radius (i.e. h
                                                         // in the document) d is the distance of 2 particles
     Real q = length(d) / h;
-    if (abs(q) < EPSILON)
+    if (fabs(q) < EPSILON)
         return mR3(0.0);
     bool less2 = (q < 2);
     return (3.0 / 8.0 * q - 3.0 / 4.0) * 5.0 / 4.0 / q * (INVPI)*pow(h, Real(-5)) * d * less2;
@@ -229,70 +258,70 @@ __device__ inline Real3 GradWh_High(Real3 d, Real h) {  // d is positive. r is t
 //}
 //--------------------------------------------------------------------------------------------------------------------------------
 
-__device__ inline Real EOS_new(Real rho, Real V_max, Real Min_rho) {
-    if (rho < paramsD.rho0)
-        rho = paramsD.rho0;
+__host__ __device__ inline Real EOS_new(Real rho, Real V_max, Real Min_rho) {
+    if (rho < Params().rho0)
+        rho = Params().rho0;
 
     //    Real gama = 7;
-    //    Real B = paramsD.Cs * paramsD.Cs * paramsD.rho0 * V_max * V_max / gama;
-    //    return B * (pow(rho / paramsD.rho0, gama) - 1) + paramsD.BASEPRES;
+    //    Real B = Params().Cs * Params().Cs * Params().rho0 * V_max * V_max / gama;
+    //    return B * (pow(rho / Params().rho0, gama) - 1) + Params().BASEPRES;
 
-    //    Real B = paramsD.Cs * paramsD.Cs * paramsD.rho0 / gama;
-    return paramsD.Cs * paramsD.Cs * (rho / paramsD.rho0 - 1);
+    //    Real B = Params().Cs * Params().Cs * Params().rho0 / gama;
+    return Params().Cs * Params().Cs * (rho / Params().rho0 - 1);
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
 // Eos is also defined in SDKCollisionSystem.cu
 // fluid equation of state
-__device__ inline Real Eos(Real rho, Real type) {
-    // if (rho < paramsD.rho0) //
-    //     rho = paramsD.rho0; //
+__host__ __device__ inline Real Eos(Real rho, Real type) {
+    // if (rho < Params().rho0) //
+    //     rho = Params().rho0; //
     //******************************
     // Real gama = 7;
-    // Real B = 100 * paramsD.rho0 * paramsD.v_Max * paramsD.v_Max / gama;
-    // return B * (pow(rho / paramsD.rho0, gama) - 1) + paramsD.BASEPRES; //
-    return paramsD.Cs * paramsD.Cs * (rho - paramsD.rho0);  //
+    // Real B = 100 * Params().rho0 * Params().v_Max * Params().v_Max / gama;
+    // return B * (pow(rho / Params().rho0, gama) - 1) + Params().BASEPRES; //
+    return Params().Cs * Params().Cs * (rho - Params().rho0);  //
 }
 //--------------------------------------------------------------------------------------------------------------------------------
-__device__ inline Real InvEos(Real pw) {
+__host__ __device__ inline Real InvEos(Real pw) {
     // Real gama = 7;
-    // Real B = 100 * paramsD.rho0 * paramsD.v_Max * paramsD.v_Max / gama;  // 200;//314e6; //c^2 * paramsD.rho0 / gama
+    // Real B = 100 * Params().rho0 * Params().v_Max * Params().v_Max / gama;  // 200;//314e6; //c^2 * Params().rho0 / gama
     //                                                                      // where c = 1484 m/s for water
-    // Real powerComp = (pw - paramsD.BASEPRES) / B + 1.0;
-    // Real rho = (powerComp > 0) ? paramsD.rho0 * pow(powerComp, 1.0 / gama)
-    //                            : -paramsD.rho0 * pow(fabs(powerComp),
+    // Real powerComp = (pw - Params().BASEPRES) / B + 1.0;
+    // Real rho = (powerComp > 0) ? Params().rho0 * pow(powerComp, 1.0 / gama)
+    //                            : -Params().rho0 * pow(fabs(powerComp),
     //                                                  1.0 / gama);  // did this since CUDA is
     //                                                                // stupid and freaks out by
     //                                                                // negative^(1/gama)
-    Real rho = pw / (paramsD.Cs * paramsD.Cs) + paramsD.rho0;  //
+    Real rho = pw / (Params().Cs * Params().Cs) + Params().rho0;  //
     return rho;
 }
 //--------------------------------------------------------------------------------------------------------------------------------
 // ferrariCi
-__device__ inline Real FerrariCi(Real rho) {
+__host__ __device__ inline Real FerrariCi(Real rho) {
     int gama = 7;
-    Real B = 100 * paramsD.rho0 * paramsD.v_Max * paramsD.v_Max / gama;  // 200;//314e6; //c^2 * paramsD.rho0 / gama
+    Real B = 100 * Params().rho0 * Params().v_Max * Params().v_Max / gama;  // 200;//314e6; //c^2 * Params().rho0 / gama
                                                                          // where c = 1484 m/s for water
-    return sqrt(gama * B / paramsD.rho0) * pow(rho / paramsD.rho0, 0.5 * (gama - 1));
+    return sqrt(gama * B / Params().rho0) * pow(rho / Params().rho0, 0.5 * (gama - 1));
 }
 //--------------------------------------------------------------------------------------------------------------------------------
 
-__device__ inline Real3 Modify_Local_PosB(Real3& b, Real3 a) {
+__host__ __device__ inline Real3 Modify_Local_PosB(Real3& b, Real3 a) {
     Real3 dist3 = a - b;
-    b.x += ((dist3.x > 0.5f * paramsD.boxDims.x) ? paramsD.boxDims.x : 0);
-    b.x -= ((dist3.x < -0.5f * paramsD.boxDims.x) ? paramsD.boxDims.x : 0);
+    b.x += ((dist3.x > 0.5f * Params().boxDims.x) ? Params().boxDims.x : 0);
+    b.x -= ((dist3.x < -0.5f * Params().boxDims.x) ? Params().boxDims.x : 0);
 
-    b.y += ((dist3.y > 0.5f * paramsD.boxDims.y) ? paramsD.boxDims.y : 0);
-    b.y -= ((dist3.y < -0.5f * paramsD.boxDims.y) ? paramsD.boxDims.y : 0);
+    b.y += ((dist3.y > 0.5f * Params().boxDims.y) ? Params().boxDims.y : 0);
+    b.y -= ((dist3.y < -0.5f * Params().boxDims.y) ? Params().boxDims.y : 0);
 
-    b.z += ((dist3.z > 0.5f * paramsD.boxDims.z) ? paramsD.boxDims.z : 0);
-    b.z -= ((dist3.z < -0.5f * paramsD.boxDims.z) ? paramsD.boxDims.z : 0);
+    b.z += ((dist3.z > 0.5f * Params().boxDims.z) ? Params().boxDims.z : 0);
+    b.z -= ((dist3.z < -0.5f * Params().boxDims.z) ? Params().boxDims.z : 0);
 
     dist3 = a - b;
     // modifying the markers perfect overlap
     Real d = length(dist3);
-    if (d < paramsD.epsMinMarkersDis * paramsD.HSML) {
-        dist3 = mR3(paramsD.epsMinMarkersDis * paramsD.HSML, 0, 0);
+    if (d < Params().epsMinMarkersDis * Params().HSML) {
+        dist3 = mR3(Params().epsMinMarkersDis * Params().HSML, 0, 0);
     }
     b = a - dist3;
     return (dist3);
@@ -309,21 +338,21 @@ __device__ inline Real3 Modify_Local_PosB(Real3& b, Real3 a) {
  *
  * @return Distance vector (distance in x, distance in y, distance in z)
  */
-__device__ inline Real3 Distance(Real3 a, Real3 b) {
+__host__ __device__ inline Real3 Distance(Real3 a, Real3 b) {
     //	Real3 dist3 = a - b;
-    //	dist3.x -= ((dist3.x > 0.5f * paramsD.boxDims.x) ? paramsD.boxDims.x :
+    //	dist3.x -= ((dist3.x > 0.5f * Params().boxDims.x) ? Params().boxDims.x :
     // 0);
-    //	dist3.x += ((dist3.x < -0.5f * paramsD.boxDims.x) ? paramsD.boxDims.x :
+    //	dist3.x += ((dist3.x < -0.5f * Params().boxDims.x) ? Params().boxDims.x :
     // 0);
     //
-    //	dist3.y -= ((dist3.y > 0.5f * paramsD.boxDims.y) ? paramsD.boxDims.y :
+    //	dist3.y -= ((dist3.y > 0.5f * Params().boxDims.y) ? Params().boxDims.y :
     // 0);
-    //	dist3.y += ((dist3.y < -0.5f * paramsD.boxDims.y) ? paramsD.boxDims.y :
+    //	dist3.y += ((dist3.y < -0.5f * Params().boxDims.y) ? Params().boxDims.y :
     // 0);
     //
-    //	dist3.z -= ((dist3.z > 0.5f * paramsD.boxDims.z) ? paramsD.boxDims.z :
+    //	dist3.z -= ((dist3.z > 0.5f * Params().boxDims.z) ? Params().boxDims.z :
     // 0);
-    //	dist3.z += ((dist3.z < -0.5f * paramsD.boxDims.z) ? paramsD.boxDims.z :
+    //	dist3.z += ((dist3.z < -0.5f * Params().boxDims.z) ? Params().boxDims.z :
     // 0);
     return Modify_Local_PosB(b, a);
 }
@@ -331,17 +360,17 @@ __device__ inline Real3 Distance(Real3 a, Real3 b) {
 //--------------------------------------------------------------------------------------------------------------------------------
 // first comp of q is rotation, last 3 components are axis of rot
 
-__device__ inline void RotationMatirixFromQuaternion(Real3& AD1, Real3& AD2, Real3& AD3, const Real4& q) {
+__host__ __device__ inline void RotationMatirixFromQuaternion(Real3& AD1, Real3& AD2, Real3& AD3, const Real4& q) {
     AD1 = 2 * mR3(0.5f - q.z * q.z - q.w * q.w, q.y * q.z - q.x * q.w, q.y * q.w + q.x * q.z);
     AD2 = 2 * mR3(q.y * q.z + q.x * q.w, 0.5f - q.y * q.y - q.w * q.w, q.z * q.w - q.x * q.y);
     AD3 = 2 * mR3(q.y * q.w - q.x * q.z, q.z * q.w + q.x * q.y, 0.5f - q.y * q.y - q.z * q.z);
 }
 //--------------------------------------------------------------------------------------------------------------------------------
 
-__device__ inline Real3 InverseRotate_By_RotationMatrix_DeviceHost(const Real3& A1,
-                                                                   const Real3& A2,
-                                                                   const Real3& A3,
-                                                                   const Real3& r3) {
+__host__ __device__ inline Real3 InverseRotate_By_RotationMatrix_DeviceHost(const Real3& A1,
+                                                                            const Real3& A2,
+                                                                            const Real3& A3,
+                                                                            const Real3& r3) {
     return mR3(A1.x * r3.x + A2.x * r3.y + A3.x * r3.z, A1.y * r3.x + A2.y * r3.y + A3.y * r3.z,
                A1.z * r3.x + A2.z * r3.y + A3.z * r3.z);
 }
@@ -351,14 +380,14 @@ __device__ inline Real3 InverseRotate_By_RotationMatrix_DeviceHost(const Real3&
  * @brief calcGridHash
  * @details  See SDKCollisionSystem.cuh
  */
-__device__ inline int3 calcGridPos(Real3 p) {
+__host__ __device__ inline int3 calcGridPos(Real3 p) {
     int3 gridPos;
-    if (paramsD.cellSize.x * paramsD.cellSize.y * paramsD.cellSize.z == 0)
-        printf("calcGridPos=%f,%f,%f\n", paramsD.cellSize.x, paramsD.cellSize.y, paramsD.cellSize.z);
+    if (Params().cellSize.x * Params().cellSize.y * Params().cellSize.z == 0)
+        printf("calcGridPos=%f,%f,%f\n", Params().cellSize.x, Params().cellSize.y, Params().cellSize.z);
 
-    gridPos.x = (int)floor((p.x - paramsD.worldOrigin.x) / paramsD.cellSize.x);
-    gridPos.y = (int)floor((p.y - paramsD.worldOrigin.y) / paramsD.cellSize.y);
-    gridPos.z = (int)floor((p.z - paramsD.worldOrigin.z) / paramsD.cellSize.z);
+    gridPos.x = (int)floor((p.x - Params().worldOrigin.x) / Params().cellSize.x);
+    gridPos.y = (int)floor((p.y - Params().worldOrigin.y) / Params().cellSize.y);
+    gridPos.z = (int)floor((p.z - Params().worldOrigin.z) / Params().cellSize.z);
     return gridPos;
 }
 
@@ -367,20 +396,20 @@ __device__ inline int3 calcGridPos(Real3 p) {
  * @details  See SDKCollisionSystem.cuh
  */
 
-__device__ inline uint calcGridHash(int3 gridPos) {
-    gridPos.x -= ((gridPos.x >= paramsD.gridSize.x) ? paramsD.gridSize.x : 0);
-    gridPos.y -= ((gridPos.y >= paramsD.gridSize.y) ? paramsD.gridSize.y : 0);
-    gridPos.z -= ((gridPos.z >= paramsD.gridSize.z) ? paramsD.gridSize.z : 0);
+__host__ __device__ inline uint calcGridHash(int3 gridPos) {
+    gridPos.x -= ((gridPos.x >= Params().gridSize.x) ? Params().gridSize.x : 0);
+    gridPos.y -= ((gridPos.y >= Params().gridSize.y) ? Params().gridSize.y : 0);
+    gridPos.z -= ((gridPos.z >= Params().gridSize.z) ? Params().gridSize.z : 0);
 
-    gridPos.x += ((gridPos.x < 0) ? paramsD.gridSize.x : 0);
-    gridPos.y += ((gridPos.y < 0) ? paramsD.gridSize.y : 0);
-    gridPos.z += ((gridPos.z < 0) ? paramsD.gridSize.z : 0);
+    gridPos.x += ((gridPos.x < 0) ? Params().gridSize.x : 0);
+    gridPos.y += ((gridPos.y < 0) ? Params().gridSize.y : 0);
+    gridPos.z += ((gridPos.z < 0) ? Params().gridSize.z : 0);
 
-    return gridPos.z * paramsD.gridSize.y * paramsD.gridSize.x + gridPos.y * paramsD.gridSize.x + gridPos.x;
+    return gridPos.z * Params().gridSize.y * Params().gridSize.x + gridPos.y * Params().gridSize.x + gridPos.x;
 }
 
 ////--------------------------------------------------------------------------------------------------------------------------------
-inline __device__ Real Strain_Rate(Real3 grad_ux, Real3 grad_uy, Real3 grad_uz) {
+inline __host__ __device__ Real Strain_Rate(Real3 grad_ux, Real3 grad_uy, Real3 grad_uz) {
     grad_ux.y = (grad_uy.x + grad_ux.y) * 0.5;
     grad_ux.z = (grad_uz.x + grad_ux.z) * 0.5;
 
@@ -398,7 +427,7 @@ inline __device__ Real Strain_Rate(Real3 grad_ux, Real3 grad_uy, Real3 grad_uz)
 }
 
 ////--------------------------------------------------------------------------------------------------------------------------------
-inline __device__ Real Tensor_Norm(Real* T) {
+inline __host__ __device__ Real Tensor_Norm(Real* T) {
     return sqrt(                                          //
         0.5 * (T[0] * T[0] + T[1] * T[1] + T[2] * T[2] +  //
                T[3] * T[3] + T[4] * T[4] + T[5] * T[5] +  //
@@ -406,75 +435,75 @@ inline __device__ Real Tensor_Norm(Real* T) {
     );
 }
 ////--------------------------------------------------------------------------------------------------------------------------------
-inline __device__ Real Sym_Tensor_Norm(Real3 xx_yy_zz, Real3 xy_xz_yz) {
+inline __host__ __device__ Real Sym_Tensor_Norm(Real3 xx_yy_zz, Real3 xy_xz_yz) {
     return sqrt(0.5 * (xx_yy_zz.x * xx_yy_zz.x + xx_yy_zz.y * xx_yy_zz.y + xx_yy_zz.z * xx_yy_zz.z +
                        2 * xy_xz_yz.x * xy_xz_yz.x + 2 * xy_xz_yz.y * xy_xz_yz.y + 2 * xy_xz_yz.z * xy_xz_yz.z));
 }
 ////--------------------------------------------------------------------------------------------------------------------------------
-inline __device__ Real Inertia_num(Real Strain_rate, Real rho, Real p, Real diam) {
+inline __host__ __device__ Real Inertia_num(Real Strain_rate, Real rho, Real p, Real diam) {
     Real I = Strain_rate * diam * sqrt(rho / rmaxr(p, EPSILON));
     return rminr(1e3, I);
 }
 
 ////--------------------------------------------------------------------------------------------------------------------------------
-inline __device__ Real mu_I(Real Strain_rate, Real I) {
+inline __host__ __device__ Real mu_I(Real Strain_rate, Real I) {
     Real mu = 0;
-    if (paramsD.mu_of_I == friction_law::constant)
-        mu = paramsD.mu_fric_s;
-    else if (paramsD.mu_of_I == friction_law::linear)
-        mu = paramsD.mu_fric_s + paramsD.mu_I_b * I;
+    if (Params().mu_of_I == friction_law::constant)
+        mu = Params().mu_fric_s;
+    else if (Params().mu_of_I == friction_law::linear)
+        mu = Params().mu_fric_s + Params().mu_I_b * I;
     else
-        mu = paramsD.mu_fric_s + (paramsD.mu_fric_2 - paramsD.mu_fric_s) * (I / (paramsD.mu_I0 + I));
+        mu = Params().mu_fric_s + (Params().mu_fric_2 - Params().mu_fric_s) * (I / (Params().mu_I0 + I));
 
     return mu;
 }
 ////--------------------------------------------------------------------------------------------------------------------------------
-inline __device__ Real mu_eff(Real Strain_rate, Real p, Real mu_I) {
-    return rmaxr(mu_I * rmaxr(p, 0.0) / Strain_rate, paramsD.mu_max);
+inline __host__ __device__ Real mu_eff(Real Strain_rate, Real p, Real mu_I) {
+    return rmaxr(mu_I * rmaxr(p, 0.0) / Strain_rate, Params().mu_max);
 }
 
 ////--------------------------------------------------------------------------------------------------------------------------------
-inline __device__ Real Herschel_Bulkley_stress(Real Strain_rate, Real k, Real n, Real tau0) {
+inline __host__ __device__ Real Herschel_Bulkley_stress(Real Strain_rate, Real k, Real n, Real tau0) {
     Real tau = tau0 + k * pow(Strain_rate, n);
     return tau;
 }
 ////--------------------------------------------------------------------------------------------------------------------------------
-inline __device__ Real Herschel_Bulkley_mu_eff(Real Strain_rate, Real k, Real n, Real tau0) {
+inline __host__ __device__ Real Herschel_Bulkley_mu_eff(Real Strain_rate, Real k, Real n, Real tau0) {
     Real mu_eff = tau0 / Strain_rate + k * pow(Strain_rate, n - 1);
-    return rminr(mu_eff, paramsD.mu_max);
+    return rminr(mu_eff, Params().mu_max);
 }
 ////--------------------------------------------------------------------------------------------------------------------------------
-inline __device__ void BCE_Vel_Acc(int i_idx,
-                                   Real3& myAcc,
-                                   Real3& V_prescribed,
-
-                                   Real4* sortedPosRad,
-                                   int4 updatePortion,
-                                   uint* gridMarkerIndexD,
-
-                                   Real4* qD,
-                                   Real3* rigidSPH_MeshPos_LRF_D,
-                                   Real3* posRigid_fsiBodies_D,
-                                   Real4* velMassRigid_fsiBodies_D,
-                                   Real3* omegaVelLRF_fsiBodies_D,
-                                   Real3* accRigid_fsiBodies_D,
-                                   Real3* omegaAccLRF_fsiBodies_D,
-                                   uint* rigidIdentifierD,
-
-                                   Real3* pos_fsi_fea_D,
-                                   Real3* vel_fsi_fea_D,
-                                   Real3* acc_fsi_fea_D,
-                                   uint* FlexIdentifierD,
-                                   const int numFlex1D,
-                                   uint2* CableElementsNodes,
-                                   uint4* ShellelementsNodes) {
+inline __host__ __device__ void BCE_Vel_Acc(int i_idx,
+                                            Real3& myAcc,
+                                            Real3& V_prescribed,
+
+                                            Real4* sortedPosRad,
+                                            int4 updatePortion,
+                                            uint* gridMarkerIndexD,
+
+                                            Real4* qD,
+                                            Real3* rigidSPH_MeshPos_LRF_D,
+                                            Real3* posRigid_fsiBodies_D,
+                                            Real4* velMassRigid_fsiBodies_D,
+                                            Real3* omegaVelLRF_fsiBodies_D,
+                                            Real3* accRigid_fsiBodies_D,
+                                            Real3* omegaAccLRF_fsiBodies_D,
+                                            uint* rigidIdentifierD,
+
+                                            Real3* pos_fsi_fea_D,
+                                            Real3* vel_fsi_fea_D,
+                                            Real3* acc_fsi_fea_D,
+                                            uint* FlexIdentifierD,
+                                            const int numFlex1D,
+                                            uint2* CableElementsNodes,
+                                            uint4* ShellelementsNodes) {
     int Original_idx = gridMarkerIndexD[i_idx];
 
     // See if this belongs to a fixed boundary
     if (Original_idx >= updatePortion.x && Original_idx < updatePortion.y) {
         myAcc = mR3(0.0);
         V_prescribed = mR3(0.0);
-        if (paramsD.Apply_BC_U)
+        if (Params().Apply_BC_U)
             V_prescribed = user_BC_U(mR3(sortedPosRad[i_idx]));
     } else if (Original_idx >= updatePortion.y && Original_idx < updatePortion.z) {
         int rigidIndex = rigidIdentifierD[Original_idx - updatePortion.y];
@@ -609,15 +638,15 @@ inline __device__ void BCE_Vel_Acc(int i_idx,
     }
 }
 //--------------------------------------------------------------------------------------------------------------------------------
-inline __device__ void grad_scalar(int i_idx,
-                                   Real4* sortedPosRad,  // input: sorted positions
-                                   Real4* sortedRhoPreMu,
-                                   Real* sumWij_inv,
-                                   Real* G_i,
-                                   Real4* Scalar,
-                                   Real3& myGrad,
-                                   uint* cellStart,
-                                   uint* cellEnd) {
+inline __host__ __device__ void grad_scalar(int i_idx,
+                                            Real4* sortedPosRad,  // input: sorted positions
+                                            Real4* sortedRhoPreMu,
+                                            Real* sumWij_inv,
+                                            Real* G_i,
+                                            Real4* Scalar,
+                                            Real3& myGrad,
+                                            uint* cellStart,
+                                            uint* cellEnd) {
     // Note that this function only calculates the gradient of the first element of the Scalar;
     // This is hard coded like this for now because usually rho appears in Real4 structure
     Real3 posRadA = mR3(sortedPosRad[i_idx]);
@@ -671,17 +700,17 @@ inline __device__ void grad_scalar(int i_idx,
 }
 
 //--------------------------------------------------------------------------------------------------------------------------------
-inline __device__ void grad_vector(int i_idx,
-                                   Real4* sortedPosRad,  // input: sorted positions
-                                   Real4* sortedRhoPreMu,
-                                   Real* sumWij_inv,
-                                   Real* G_i,
-                                   Real3* Vector,
-                                   Real3& myGradx,
-                                   Real3& myGrady,
-                                   Real3& myGradz,
-                                   uint* cellStart,
-                                   uint* cellEnd) {
+inline __host__ __device__ void grad_vector(int i_idx,
+                                            Real4* sortedPosRad,  // input: sorted positions
+                                            Real4* sortedRhoPreMu,
+                                            Real* sumWij_inv,
+                                            Real* G_i,
+                                            Real3* Vector,
+                                            Real3& myGradx,
+                                            Real3& myGrady,
+                                            Real3& myGradz,
+                                            uint* cellStart,
+                                            uint* cellEnd) {
     Real3 posRadA = mR3(sortedPosRad[i_idx]);
     Real h_i = sortedPosRad[i_idx].w;
     int3 gridPos = calcGridPos(posRadA);
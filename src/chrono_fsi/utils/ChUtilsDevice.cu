@@ -75,6 +75,12 @@ void ChUtilsDevice::CopyD2H(thrust::device_vector<Real>& DevVec, thrust::host_ve
 }
 
 void ChUtilsDevice::Sync_CheckError(bool* isErrorH, bool* isErrorD, std::string carshReport) {
+#ifdef CHRONO_FSI_USE_CPU
+    // With the CPU backend, the error flag lives in host memory
+    if (*isErrorD == true) {
+        throw std::runtime_error("Error! program crashed after " + carshReport + " !\n");
+    }
+#else
     cudaDeviceSynchronize();
     cudaMemcpy(isErrorH, isErrorD, sizeof(bool), cudaMemcpyDeviceToHost);
     if (*isErrorH == true) {
@@ -85,6 +91,45 @@ void ChUtilsDevice::Sync_CheckError(bool* isErrorH, bool* isErrorD, std::string
         throw std::runtime_error("Error! program crashed after " + carshReport + " !\n");
     }
     cudaCheckError();
+#endif
+}
+
+bool* ChUtilsDevice::CreateErrorFlag() {
+    bool* isErrorD;
+#ifdef CHRONO_FSI_USE_CPU
+    isErrorD = (bool*)malloc(sizeof(bool));
+#else
+    cudaMalloc((void**)&isErrorD, sizeof(bool));
+#endif
+    ResetErrorFlag(isErrorD);
+    return isErrorD;
+}
+
+void ChUtilsDevice::ResetErrorFlag(bool* isErrorD) {
+#ifdef CHRONO_FSI_USE_CPU
+    *isErrorD = false;
+#else
+    bool isErrorH = false;
+    cudaMemcpy(isErrorD, &isErrorH, sizeof(bool), cudaMemcpyHostToDevice);
+#endif
+}
+
+bool ChUtilsDevice::GetErrorFlag(bool* isErrorD) {
+#ifdef CHRONO_FSI_USE_CPU
+    return *isErrorD;
+#else
+    bool isErrorH;
+    cudaMemcpy(&isErrorH, isErrorD, sizeof(bool), cudaMemcpyDeviceToHost);
+    return isErrorH;
+#endif
+}
+
+void ChUtilsDevice::FreeErrorFlag(bool* isErrorD) {
+#ifdef CHRONO_FSI_USE_CPU
+    free(isErrorD);
+#else
+    cudaFree(isErrorD);
+#endif
 }
 
 }  // end namespace fsi
@@ -17,6 +17,7 @@
 
 #ifndef CH_DEVICEUTILS_H_
 #define CH_DEVICEUTILS_H_
+#include "chrono_fsi/ChConfigFSI.h"  // must precede thrust headers (device system selection)
 #include <cuda_runtime.h>  // for __host__ __device__ flags
 #include <thrust/device_vector.h>
 #include <thrust/host_vector.h>
@@ -97,6 +98,10 @@ typedef unsigned int uint;
 //
 // Legacy CUTIL macros. Currently default to no-ops (TODO)
 // ----------------------------------------------------------------------------
+#ifdef CHRONO_FSI_USE_CPU
+#define cudaCheckError() \
+    {}
+#else
 #define cudaCheckError()                                                                     \
     {                                                                                        \
         cudaError_t e = cudaGetLastError();                                                  \
@@ -105,6 +110,22 @@ typedef unsigned int uint;
             exit(0);                                                                         \
         }                                                                                    \
     }
+#endif
+
+#ifdef CHRONO_FSI_USE_CPU
+// --------------------------------------------------------------------
+// ForEachMarker
+//
+/// Host replacement for a kernel launch with one thread per marker (CPU backend).
+/// Calls func(i, args...) for all i in [0, n), distributed over the OpenMP threads.
+// --------------------------------------------------------------------
+template <typename Func, typename... Args>
+inline void ForEachMarker(uint n, Func func, Args... args) {
+#pragma omp parallel for schedule(static)
+    for (int i = 0; i < (int)n; i++)
+        func((uint)i, args...);
+}
+#endif
 
 // --------------------------------------------------------------------
 // GpuTimer
@@ -185,6 +206,19 @@ class CH_FSI_API ChUtilsDevice {
 
     static void Sync_CheckError(bool* isErrorH, bool* isErrorD, std::string carshReport);
 
+    /// Allocates an error flag that kernels can raise. The flag lives in device memory (host memory with the CPU
+    /// backend) and must be released with FreeErrorFlag.
+    static bool* CreateErrorFlag();
+
+    /// Resets an error flag to false
+    static void ResetErrorFlag(bool* isErrorD);
+
+    /// Returns the current value of an error flag
+    static bool GetErrorFlag(bool* isErrorD);
+
+    /// Releases an error flag allocated with CreateErrorFlag
+    static void FreeErrorFlag(bool* isErrorD);
+
     //    template <class DATATYPE>
     //    static void CopyD2H(thrust::device_vector<DATATYPE>& DevVec, thrust::host_vector<DATATYPE>& HostVec) {
     //        thrust::copy(DevVec.begin(), DevVec.end(), HostVec.begin());
@@ -35,8 +35,12 @@ size_t gran_approx_bytes_used = 0;
 namespace chrono {
 namespace granular {
 
-ChSystemGranularSMC::ChSystemGranularSMC(float sphere_rad, float density, float3 boxDims)
-    : sphere_radius_UU(sphere_rad),
+ChSystemGranularSMC::ChSystemGranularSMC(float sphere_rad,
+                                         float density,
+                                         float3 boxDims,
+                                         GRAN_EXECUTION_BACKEND backend)
+    : backend(backend),
+      sphere_radius_UU(sphere_rad),
       sphere_density_UU(density),
       box_size_X(boxDims.x),
       box_size_Y(boxDims.y),
@@ -64,8 +68,12 @@ ChSystemGranularSMC::ChSystemGranularSMC(float sphere_rad, float density, float3
       rolling_coeff_s2w_UU(0.0),
       spinning_coeff_s2s_UU(0.0),
       spinning_coeff_s2w_UU(0.0) {
-    gpuErrchk(cudaMallocManaged(&gran_params, sizeof(ChGranParams), cudaMemAttachGlobal));
-    gpuErrchk(cudaMallocManaged(&sphere_data, sizeof(ChGranSphereData), cudaMemAttachGlobal));
+    // unified memory if a device is present, host memory otherwise (CPU backend only)
+    gran_params = cudallocator<ChGranParams>().allocate(1);
+    sphere_data = cudallocator<ChGranSphereData>().allocate(1);
+    if (backend == GRAN_EXECUTION_BACKEND::GPU && !cudallocator_managed_available()) {
+        GRANULAR_ERROR("No CUDA device found, use the CPU execution backend instead.\n");
+    }
     psi_T = PSI_T_DEFAULT;
     psi_L = PSI_L_DEFAULT;
     psi_R = PSI_R_DEFAULT;
@@ -117,7 +125,8 @@ void ChSystemGranularSMC::createWallBCs() {
 }
 
 ChSystemGranularSMC::~ChSystemGranularSMC() {
-    gpuErrchk(cudaFree(gran_params));
+    cudallocator<ChGranParams>().deallocate(gran_params, 1);
+    cudallocator<ChGranSphereData>().deallocate(sphere_data, 1);
 }
 
 size_t ChSystemGranularSMC::estimateMemUsage() const {
@@ -755,11 +764,13 @@ void ChSystemGranularSMC::initializeSpheres() {
     runSphereBroadphase();
     INFO_PRINTF("Initial broadphase finished!\n");
 
-    int dev_ID;
-    gpuErrchk(cudaGetDevice(&dev_ID));
-    // these two will be mostly read by everyone
-    gpuErrchk(cudaMemAdvise(gran_params, sizeof(*gran_params), cudaMemAdviseSetReadMostly, dev_ID));
-    gpuErrchk(cudaMemAdvise(sphere_data, sizeof(*sphere_data), cudaMemAdviseSetReadMostly, dev_ID));
+    if (backend == GRAN_EXECUTION_BACKEND::GPU) {
+        int dev_ID;
+        gpuErrchk(cudaGetDevice(&dev_ID));
+        // these two will be mostly read by everyone
+        gpuErrchk(cudaMemAdvise(gran_params, sizeof(*gran_params), cudaMemAdviseSetReadMostly, dev_ID));
+        gpuErrchk(cudaMemAdvise(sphere_data, sizeof(*sphere_data), cudaMemAdviseSetReadMostly, dev_ID));
+    }
 
     INFO_PRINTF("z grav term with timestep %f is %f\n", stepSize_SU,
                 stepSize_SU * stepSize_SU * gran_params->gravAcc_Z_SU);
@@ -126,6 +126,14 @@ enum GRAN_FRICTION_MODE { FRICTIONLESS, SINGLE_STEP, MULTI_STEP };
 /// Rolling resistance models -- ELASTIC_PLASTIC not implemented yet
 enum GRAN_ROLLING_MODE { NO_RESISTANCE, SCHWARTZ, ELASTIC_PLASTIC };
 
+/// Where the sphere solver runs: CUDA kernels on the GPU or OpenMP loops on the host.
+/// Both backends are built with the CUDA toolkit; the CPU backend does not need a CUDA device at run time.
+/// The CPU backend is deterministic: its results do not depend on the number of threads. The two backends sum contact
+/// forces in a different order, so their results agree only up to floating-point round-off, not bitwise.
+/// Only the sphere-only system (ChSystemGranularSMC) supports the CPU backend; ChSystemGranularSMC_trimesh runs on
+/// the GPU.
+enum GRAN_EXECUTION_BACKEND { GPU, CPU };
+
 enum GRAN_OUTPUT_FLAGS { ABSV = 1, VEL_COMPONENTS = 2, FIXITY = 4, ANG_VEL_COMPONENTS = 8, FORCE_COMPONENTS = 16 };
 #define GET_OUTPUT_SETTING(setting) (this->output_flags & setting)
 
@@ -271,16 +279,24 @@ namespace granular {
 
 /**
  * \brief Main Chrono::Granular system class used to control and dispatch the GPU
- * sphere-only solver.
+ * sphere-only solver. The same solver can also run on the host (OpenMP) if the CPU
+ * execution backend is selected at construction.
  */
 class CH_GRANULAR_API ChSystemGranularSMC {
   public:
     // The system is not default-constructible
     ChSystemGranularSMC() = delete;
-    /// Construct granular system with given sphere radius, density, and big domain dimensions
-    ChSystemGranularSMC(float sphere_rad, float density, float3 boxDims);
+    /// Construct granular system with given sphere radius, density, and big domain dimensions.
+    /// The execution backend cannot be changed after construction.
+    ChSystemGranularSMC(float sphere_rad,
+                        float density,
+                        float3 boxDims,
+                        GRAN_EXECUTION_BACKEND backend = GRAN_EXECUTION_BACKEND::GPU);
     virtual ~ChSystemGranularSMC();
 
+    /// Return the execution backend selected at construction
+    GRAN_EXECUTION_BACKEND get_execution_backend() const { return backend; }
+
     /// Return number of subdomains in the big domain
     unsigned int get_SD_count() const { return nSDs; }
 
@@ -551,6 +567,9 @@ class CH_GRANULAR_API ChSystemGranularSMC {
     /// Setup sphere data, initialize local coords
     void setupSphereDataStructures();
 
+    /// Execution backend of the solver
+    const GRAN_EXECUTION_BACKEND backend;
+
     /// Holds the sphere and big-domain-related params in unified memory
     ChGranParams* gran_params;
     /// Holds system degrees of freedom
@@ -650,6 +669,11 @@ class CH_GRANULAR_API ChSystemGranularSMC {
     /// Array containing the IDs of the spheres stored in the SDs associated with the box
     std::vector<unsigned int, cudallocator<unsigned int>> spheres_in_SD_composite;
 
+    /// Entries of each sphere in the composite array, one per touched SD (CPU backend only)
+    std::vector<unsigned int> sphere_composite_entries;
+    /// Contact force on the sphere of each composite array entry, frictionless mode (CPU backend only)
+    std::vector<float3> composite_sphere_forces;
+
     /// List of owner subdomains for each sphere
     std::vector<unsigned int, cudallocator<unsigned int>> sphere_owner_SDs;
 
@@ -685,6 +709,23 @@ class CH_GRANULAR_API ChSystemGranularSMC {
     /// Run the first sphere broadphase pass to get things started
     void runSphereBroadphase();
 
+    // Host (OpenMP) counterparts of the GPU kernels, used by the CPU execution backend
+
+    /// Convert sphere positions from 64-bit global to 32-bit local
+    void initializeLocalPositions_CPU(const int64_t* sphere_pos_global_X,
+                                      const int64_t* sphere_pos_global_Y,
+                                      const int64_t* sphere_pos_global_Z);
+    /// Bin spheres into the subdomains they touch
+    void runSphereBroadphase_CPU();
+    /// Change all local positions to account for a motion of the big domain frame
+    void applyBDFrameChange_CPU(int64_t3 delta);
+    /// Compute sphere accelerations from contacts, boundary conditions, and gravity
+    void computeSphereForces_CPU();
+    /// Integrate sphere velocities and positions
+    void integrateSpheres_CPU();
+    /// Integrate angular velocities and reset friction data
+    void updateFrictionData_CPU();
+
     /// Helper function to convert a position in UU to its SU representation while also changing data type
     template <typename T1, typename T2>
     T1 convertToPosSU(T2 val) {
@@ -30,12 +30,12 @@ using chrono::granular::Z_Cone_BC_params_t;
 using chrono::granular::Z_Cylinder_BC_params_t;
 using chrono::granular::Plane_BC_params_t;
 
-inline __device__ bool addBCForces_Sphere_frictionless(const int64_t3& sphPos,
-                                                       const float3& sphVel,
-                                                       float3& force_from_BCs,
-                                                       GranParamsPtr gran_params,
-                                                       BC_params_t<int64_t, int64_t3>& bc_params,
-                                                       bool track_forces) {
+inline __host__ __device__ bool addBCForces_Sphere_frictionless(const int64_t3& sphPos,
+                                                                const float3& sphVel,
+                                                                float3& force_from_BCs,
+                                                                GranParamsPtr gran_params,
+                                                                BC_params_t<int64_t, int64_t3>& bc_params,
+                                                                bool track_forces) {
     Sphere_BC_params_t<int64_t, int64_t3> sphere_params = bc_params.sphere_params;
     bool contact = false;
     // classic radius grab, this must be signed to avoid false conversions
@@ -51,7 +51,7 @@ inline __device__ bool addBCForces_Sphere_frictionless(const int64_t3& sphPos,
         double3 delta = int64_t3_to_double3(delta_int) / (sphere_params.radius + sphereRadius_SU);
         double d2 = Dot(delta, delta);
         // this needs to be computed in double, then cast to float
-        reciplength = (float)rsqrt(d2);
+        reciplength = (float)granRsqrt(d2);
     }
     // recompute in float to be cheaper
     float3 delta = int64_t3_to_float3(delta_int) / (sphere_params.radius + sphereRadius_SU);
@@ -83,9 +83,9 @@ inline __device__ bool addBCForces_Sphere_frictionless(const int64_t3& sphPos,
 
         force_from_BCs = force_from_BCs + force_accum;
         if (track_forces) {
-            atomicAdd(&(bc_params.reaction_forces.x), -force_accum.x);
-            atomicAdd(&(bc_params.reaction_forces.y), -force_accum.y);
-            atomicAdd(&(bc_params.reaction_forces.z), -force_accum.z);
+            granAtomicAdd(&(bc_params.reaction_forces.x), -force_accum.x);
+            granAtomicAdd(&(bc_params.reaction_forces.y), -force_accum.y);
+            granAtomicAdd(&(bc_params.reaction_forces.z), -force_accum.z);
         }
     }
 
@@ -94,14 +94,14 @@ inline __device__ bool addBCForces_Sphere_frictionless(const int64_t3& sphPos,
 
 /// compute frictionless cone normal forces
 // NOTE: overloaded below
-inline __device__ bool addBCForces_ZCone_frictionless(const int64_t3& sphPos,
-                                                      const float3& sphVel,
-                                                      float3& force_from_BCs,
-                                                      GranParamsPtr gran_params,
-                                                      BC_params_t<int64_t, int64_t3>& bc_params,
-                                                      bool track_forces,
-                                                      float3& contact_normal,
-                                                      float& dist) {
+inline __host__ __device__ bool addBCForces_ZCone_frictionless(const int64_t3& sphPos,
+                                                               const float3& sphVel,
+                                                               float3& force_from_BCs,
+                                                               GranParamsPtr gran_params,
+                                                               BC_params_t<int64_t, int64_t3>& bc_params,
+                                                               bool track_forces,
+                                                               float3& contact_normal,
+                                                               float& dist) {
     Z_Cone_BC_params_t<int64_t, int64_t3> cone_params = bc_params.cone_params;
     bool contact = false;
     // classic radius grab, this must be signed to avoid false conversions
@@ -163,21 +163,21 @@ inline __device__ bool addBCForces_ZCone_frictionless(const int64_t3& sphPos,
             force_accum + -gran_params->Gamma_n_s2w_SU * projection * contact_normal * m_eff * force_model_multiplier;
         force_from_BCs = force_from_BCs + force_accum;
         if (track_forces) {
-            atomicAdd(&(bc_params.reaction_forces.x), -force_accum.x);
-            atomicAdd(&(bc_params.reaction_forces.y), -force_accum.y);
-            atomicAdd(&(bc_params.reaction_forces.z), -force_accum.z);
+            granAtomicAdd(&(bc_params.reaction_forces.x), -force_accum.x);
+            granAtomicAdd(&(bc_params.reaction_forces.y), -force_accum.y);
+            granAtomicAdd(&(bc_params.reaction_forces.z), -force_accum.z);
         }
     }
 
     return contact;
 }
 // overload of above if we don't care about dist and contact normal
-inline __device__ bool addBCForces_ZCone_frictionless(const int64_t3& sphPos,
-                                                      const float3& sphVel,
-                                                      float3& force_from_BCs,
-                                                      GranParamsPtr gran_params,
-                                                      BC_params_t<int64_t, int64_t3>& bc_params,
-                                                      bool track_forces) {
+inline __host__ __device__ bool addBCForces_ZCone_frictionless(const int64_t3& sphPos,
+                                                               const float3& sphVel,
+                                                               float3& force_from_BCs,
+                                                               GranParamsPtr gran_params,
+                                                               BC_params_t<int64_t, int64_t3>& bc_params,
+                                                               bool track_forces) {
     float3 contact_normal = {0, 0, 0};
     float dist;
     return addBCForces_ZCone_frictionless(sphPos, sphVel, force_from_BCs, gran_params, bc_params, track_forces,
@@ -185,17 +185,17 @@ inline __device__ bool addBCForces_ZCone_frictionless(const int64_t3& sphPos,
 }
 
 /// TODO check damping, adhesion
-inline __device__ bool addBCForces_ZCone(unsigned int sphID,
-                                         unsigned int BC_id,
-                                         const int64_t3& sphPos,
-                                         const float3& sphVel,
-                                         const float3& sphOmega,
-                                         float3& force_from_BCs,
-                                         float3& ang_acc_from_BCs,
-                                         GranParamsPtr gran_params,
-                                         GranSphereDataPtr sphere_data,
-                                         BC_params_t<int64_t, int64_t3>& bc_params,
-                                         bool track_forces) {
+inline __host__ __device__ bool addBCForces_ZCone(unsigned int sphID,
+                                                  unsigned int BC_id,
+                                                  const int64_t3& sphPos,
+                                                  const float3& sphVel,
+                                                  const float3& sphOmega,
+                                                  float3& force_from_BCs,
+                                                  float3& ang_acc_from_BCs,
+                                                  GranParamsPtr gran_params,
+                                                  GranSphereDataPtr sphere_data,
+                                                  BC_params_t<int64_t, int64_t3>& bc_params,
+                                                  bool track_forces) {
     // determine these from frictionless helper
     float3 force_accum = {0, 0, 0};
     float3 contact_normal = {0, 0, 0};
@@ -239,9 +239,9 @@ inline __device__ bool addBCForces_ZCone(unsigned int sphID,
 
         force_from_BCs = force_from_BCs + force_accum;
         if (track_forces) {
-            atomicAdd(&(bc_params.reaction_forces.x), -force_accum.x);
-            atomicAdd(&(bc_params.reaction_forces.y), -force_accum.y);
-            atomicAdd(&(bc_params.reaction_forces.z), -force_accum.z);
+            granAtomicAdd(&(bc_params.reaction_forces.x), -force_accum.x);
+            granAtomicAdd(&(bc_params.reaction_forces.y), -force_accum.y);
+            granAtomicAdd(&(bc_params.reaction_forces.z), -force_accum.z);
         }
     }
 
@@ -249,13 +249,13 @@ inline __device__ bool addBCForces_ZCone(unsigned int sphID,
 }
 
 /// TODO check damping, adhesion
-inline __device__ bool addBCForces_Plane_frictionless(const int64_t3& sphPos,
-                                                      const float3& sphVel,
-                                                      float3& force_from_BCs,
-                                                      GranParamsPtr gran_params,
-                                                      BC_params_t<int64_t, int64_t3>& bc_params,
-                                                      bool track_forces,
-                                                      float& dist) {
+inline __host__ __device__ bool addBCForces_Plane_frictionless(const int64_t3& sphPos,
+                                                               const float3& sphVel,
+                                                               float3& force_from_BCs,
+                                                               GranParamsPtr gran_params,
+                                                               BC_params_t<int64_t, int64_t3>& bc_params,
+                                                               bool track_forces,
+                                                               float& dist) {
     Plane_BC_params_t<int64_t3> plane_params = bc_params.plane_params;
     bool contact = false;
     // classic radius grab, this must be signed to avoid false conversions
@@ -291,9 +291,9 @@ inline __device__ bool addBCForces_Plane_frictionless(const int64_t3& sphPos,
 
         force_from_BCs = force_from_BCs + force_accum;
         if (track_forces) {
-            atomicAdd(&(bc_params.reaction_forces.x), -force_accum.x);
-            atomicAdd(&(bc_params.reaction_forces.y), -force_accum.y);
-            atomicAdd(&(bc_params.reaction_forces.z), -force_accum.z);
+            granAtomicAdd(&(bc_params.reaction_forces.x), -force_accum.x);
+            granAtomicAdd(&(bc_params.reaction_forces.y), -force_accum.y);
+            granAtomicAdd(&(bc_params.reaction_forces.z), -force_accum.z);
         }
     }
 
@@ -301,28 +301,28 @@ inline __device__ bool addBCForces_Plane_frictionless(const int64_t3& sphPos,
 }
 
 /// overload of above in case we don't care about dist
-inline __device__ bool addBCForces_Plane_frictionless(const int64_t3& sphPos,
-                                                      const float3& sphVel,
-                                                      float3& force_from_BCs,
-                                                      GranParamsPtr gran_params,
-                                                      BC_params_t<int64_t, int64_t3>& bc_params,
-                                                      bool track_forces) {
+inline __host__ __device__ bool addBCForces_Plane_frictionless(const int64_t3& sphPos,
+                                                               const float3& sphVel,
+                                                               float3& force_from_BCs,
+                                                               GranParamsPtr gran_params,
+                                                               BC_params_t<int64_t, int64_t3>& bc_params,
+                                                               bool track_forces) {
     float dist;
     return addBCForces_Plane_frictionless(sphPos, sphVel, force_from_BCs, gran_params, bc_params, track_forces, dist);
 }
 
 /// TODO check damping, adhesion
-inline __device__ bool addBCForces_Plane(unsigned int sphID,
-                                         unsigned int BC_id,
-                                         const int64_t3& sphPos,
-                                         const float3& sphVel,
-                                         const float3& sphOmega,
-                                         float3& force_from_BCs,
-                                         float3& ang_acc_from_BCs,
-                                         GranParamsPtr gran_params,
-                                         GranSphereDataPtr sphere_data,
-                                         BC_params_t<int64_t, int64_t3>& bc_params,
-                                         bool track_forces) {
+inline __host__ __device__ bool addBCForces_Plane(unsigned int sphID,
+                                                  unsigned int BC_id,
+                                                  const int64_t3& sphPos,
+                                                  const float3& sphVel,
+                                                  const float3& sphOmega,
+                                                  float3& force_from_BCs,
+                                                  float3& ang_acc_from_BCs,
+                                                  GranParamsPtr gran_params,
+                                                  GranSphereDataPtr sphere_data,
+                                                  BC_params_t<int64_t, int64_t3>& bc_params,
+                                                  bool track_forces) {
     float3 force_accum = {0, 0, 0};
     float3 contact_normal = bc_params.plane_params.normal;
 
@@ -364,9 +364,9 @@ inline __device__ bool addBCForces_Plane(unsigned int sphID,
 
         force_from_BCs = force_from_BCs + force_accum;
         if (track_forces) {
-            atomicAdd(&(bc_params.reaction_forces.x), -force_accum.x);
-            atomicAdd(&(bc_params.reaction_forces.y), -force_accum.y);
-            atomicAdd(&(bc_params.reaction_forces.z), -force_accum.z);
+            granAtomicAdd(&(bc_params.reaction_forces.x), -force_accum.x);
+            granAtomicAdd(&(bc_params.reaction_forces.y), -force_accum.y);
+            granAtomicAdd(&(bc_params.reaction_forces.z), -force_accum.z);
         }
     }
 
@@ -374,14 +374,14 @@ inline __device__ bool addBCForces_Plane(unsigned int sphID,
 }
 
 /// TODO check damping, adhesion
-inline __device__ bool addBCForces_Zcyl_frictionless(const int64_t3& sphPos,
-                                                     const float3& sphVel,
-                                                     float3& force_from_BCs,
-                                                     GranParamsPtr gran_params,
-                                                     BC_params_t<int64_t, int64_t3>& bc_params,
-                                                     bool track_forces,
-                                                     float3& contact_normal,
-                                                     float& dist) {
+inline __host__ __device__ bool addBCForces_Zcyl_frictionless(const int64_t3& sphPos,
+                                                              const float3& sphVel,
+                                                              float3& force_from_BCs,
+                                                              GranParamsPtr gran_params,
+                                                              BC_params_t<int64_t, int64_t3>& bc_params,
+                                                              bool track_forces,
+                                                              float3& contact_normal,
+                                                              float& dist) {
     Z_Cylinder_BC_params_t<int64_t, int64_t3> cyl_params = bc_params.cyl_params;
     bool contact = false;
     // classic radius grab
@@ -420,21 +420,21 @@ inline __device__ bool addBCForces_Zcyl_frictionless(const int64_t3& sphPos,
 
         force_from_BCs = force_from_BCs + force_accum;
         if (track_forces) {
-            atomicAdd(&(bc_params.reaction_forces.x), -force_accum.x);
-            atomicAdd(&(bc_params.reaction_forces.y), -force_accum.y);
-            atomicAdd(&(bc_params.reaction_forces.z), -force_accum.z);
+            granAtomicAdd(&(bc_params.reaction_forces.x), -force_accum.x);
+            granAtomicAdd(&(bc_params.reaction_forces.y), -force_accum.y);
+            granAtomicAdd(&(bc_params.reaction_forces.z), -force_accum.z);
         }
     }
     return contact;
 }
 
 /// minimal overload for dist and contact_normal params
-inline __device__ bool addBCForces_Zcyl_frictionless(const int64_t3& sphPos,
-                                                     const float3& sphVel,
-                                                     float3& force_from_BCs,
-                                                     GranParamsPtr gran_params,
-                                                     BC_params_t<int64_t, int64_t3>& bc_params,
-                                                     bool track_forces) {
+inline __host__ __device__ bool addBCForces_Zcyl_frictionless(const int64_t3& sphPos,
+                                                              const float3& sphVel,
+                                                              float3& force_from_BCs,
+                                                              GranParamsPtr gran_params,
+                                                              BC_params_t<int64_t, int64_t3>& bc_params,
+                                                              bool track_forces) {
     float3 contact_normal = {0, 0, 0};
     float dist;
     return addBCForces_Zcyl_frictionless(sphPos, sphVel, force_from_BCs, gran_params, bc_params, track_forces,
@@ -442,17 +442,17 @@ inline __device__ bool addBCForces_Zcyl_frictionless(const int64_t3& sphPos,
 }
 
 /// TODO check damping, adhesion
-inline __device__ bool addBCForces_Zcyl(unsigned int sphID,
-                                        unsigned int BC_id,
-                                        const int64_t3& sphPos,
-                                        const float3& sphVel,
-                                        const float3& sphOmega,
-                                        float3& force_from_BCs,
-                                        float3& ang_acc_from_BCs,
-                                        GranParamsPtr gran_params,
-                                        GranSphereDataPtr sphere_data,
-                                        BC_params_t<int64_t, int64_t3>& bc_params,
-                                        bool track_forces) {
+inline __host__ __device__ bool addBCForces_Zcyl(unsigned int sphID,
+                                                 unsigned int BC_id,
+                                                 const int64_t3& sphPos,
+                                                 const float3& sphVel,
+                                                 const float3& sphOmega,
+                                                 float3& force_from_BCs,
+                                                 float3& ang_acc_from_BCs,
+                                                 GranParamsPtr gran_params,
+                                                 GranSphereDataPtr sphere_data,
+                                                 BC_params_t<int64_t, int64_t3>& bc_params,
+                                                 bool track_forces) {
     float3 force_accum = {0, 0, 0};
     float3 contact_normal;
 
@@ -496,9 +496,9 @@ inline __device__ bool addBCForces_Zcyl(unsigned int sphID,
 
         force_from_BCs = force_from_BCs + force_accum;
         if (track_forces) {
-            atomicAdd(&(bc_params.reaction_forces.x), -force_accum.x);
-            atomicAdd(&(bc_params.reaction_forces.y), -force_accum.y);
-            atomicAdd(&(bc_params.reaction_forces.z), -force_accum.z);
+            granAtomicAdd(&(bc_params.reaction_forces.x), -force_accum.x);
+            granAtomicAdd(&(bc_params.reaction_forces.y), -force_accum.y);
+            granAtomicAdd(&(bc_params.reaction_forces.z), -force_accum.z);
         }
     }
     return contact;
@@ -0,0 +1,395 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+// Host (OpenMP) execution backend for the sphere-only solver. The per-sphere and
+// per-contact physics are the __host__ __device__ helpers also used by the GPU
+// kernels; only the kernel launches are replaced by OpenMP loops. This file is
+// compiled by nvcc together with the GPU backend, so a CUDA toolkit is required
+// to build it, but not a CUDA device to run it.
+//
+// All sums are done in an order that does not depend on thread scheduling, so
+// the results do not change with the number of threads:
+// - spheres are stored in increasing ID order within each SD
+// - the contact slots of each sphere are sorted by partner ID
+// - in frictionless mode, the SD contributions to a sphere are summed in the
+//   order of the SDs touched by that sphere
+// - BC reaction forces are summed over fixed blocks of spheres, in block order
+// The GPU backend sums in a different order, so the two backends are equivalent
+// only up to floating-point round-off (see utest_GRAN_cpu_backend).
+// =============================================================================
+
+#include <algorithm>
+#include <vector>
+
+#include "chrono_granular/physics/ChGranularGPU_SMC.cuh"
+#include "chrono_granular/utils/ChGranularUtilities.h"
+
+namespace chrono {
+namespace granular {
+
+// Gather the spheres touching a subdomain, with positions expressed relative to that subdomain.
+// Returns the number of spheres touching the subdomain.
+static unsigned int gatherSDSpheres(unsigned int thisSD,
+                                    GranSphereDataPtr sphere_data,
+                                    GranParamsPtr gran_params,
+                                    unsigned int sphIDs[MAX_COUNT_OF_SPHERES_PER_SD],
+                                    int pos_X[MAX_COUNT_OF_SPHERES_PER_SD],
+                                    int pos_Y[MAX_COUNT_OF_SPHERES_PER_SD],
+                                    int pos_Z[MAX_COUNT_OF_SPHERES_PER_SD],
+                                    not_stupid_bool fixed[MAX_COUNT_OF_SPHERES_PER_SD]) {
+    unsigned int spheresTouchingThisSD = sphere_data->SD_NumSpheresTouching[thisSD];
+
+    // If we overran, we have a major issue, time to crash before we make illegal memory accesses
+    if (spheresTouchingThisSD > MAX_COUNT_OF_SPHERES_PER_SD) {
+        ABORTABORTABORT("TOO MANY SPHERES! SD %u has %u spheres\n", thisSD, spheresTouchingThisSD);
+    }
+
+    size_t offset = sphere_data->SD_SphereCompositeOffsets[thisSD];
+    for (unsigned int i = 0; i < spheresTouchingThisSD; i++) {
+        unsigned int mySphereID = sphere_data->spheres_in_SD_composite[offset + i];
+        int3 pos = make_int3(sphere_data->sphere_local_pos_X[mySphereID], sphere_data->sphere_local_pos_Y[mySphereID],
+                             sphere_data->sphere_local_pos_Z[mySphereID]);
+        // if this SD doesn't own that sphere, add an offset to account
+        unsigned int sphere_owner_SD = sphere_data->sphere_owner_SDs[mySphereID];
+        if (sphere_owner_SD != thisSD) {
+            pos = pos + getOffsetFromSDs(thisSD, sphere_owner_SD, gran_params);
+        }
+        sphIDs[i] = mySphereID;
+        pos_X[i] = pos.x;
+        pos_Y[i] = pos.y;
+        pos_Z[i] = pos.z;
+        fixed[i] = sphere_data->sphere_fixed[mySphereID];
+    }
+
+    return spheresTouchingThisSD;
+}
+
+// Flag the spheres of a subdomain that are in contact with sphere bodyA. The loop runs over contiguous arrays so that
+// it can be vectorized over the spheres in the subdomain.
+static void flagSDContacts(unsigned int thisSD,
+                           unsigned int bodyA,
+                           unsigned int nSpheresSD,
+                           const int pos_X[MAX_COUNT_OF_SPHERES_PER_SD],
+                           const int pos_Y[MAX_COUNT_OF_SPHERES_PER_SD],
+                           const int pos_Z[MAX_COUNT_OF_SPHERES_PER_SD],
+                           const not_stupid_bool fixed[MAX_COUNT_OF_SPHERES_PER_SD],
+                           not_stupid_bool contact[MAX_COUNT_OF_SPHERES_PER_SD],
+                           GranParamsPtr gran_params) {
+    const int3 posA = make_int3(pos_X[bodyA], pos_Y[bodyA], pos_Z[bodyA]);
+    const bool fixedA = fixed[bodyA] != 0;
+    for (unsigned int bodyB = 0; bodyB < nSpheresSD; bodyB++) {
+        bool active_contact = checkSpheresContacting_int(posA, make_int3(pos_X[bodyB], pos_Y[bodyB], pos_Z[bodyB]),
+                                                         thisSD, gran_params);
+        contact[bodyB] = active_contact && bodyA != bodyB && !(fixedA && fixed[bodyB]);
+    }
+}
+
+// Host counterpart of the computeSphereForces_frictionless kernel for one subdomain. The contact force on each sphere
+// is stored at the sphere's entry in the composite array; external forces are added later, once per sphere.
+static void computeSDForces_frictionless(unsigned int thisSD,
+                                         GranSphereDataPtr sphere_data,
+                                         GranParamsPtr gran_params,
+                                         float3* composite_sphere_forces) {
+    unsigned int sphIDs[MAX_COUNT_OF_SPHERES_PER_SD];
+    int pos_X[MAX_COUNT_OF_SPHERES_PER_SD];
+    int pos_Y[MAX_COUNT_OF_SPHERES_PER_SD];
+    int pos_Z[MAX_COUNT_OF_SPHERES_PER_SD];
+    not_stupid_bool fixed[MAX_COUNT_OF_SPHERES_PER_SD];
+    not_stupid_bool contact[MAX_COUNT_OF_SPHERES_PER_SD];
+
+    unsigned int nSpheresSD = gatherSDSpheres(thisSD, sphere_data, gran_params, sphIDs, pos_X, pos_Y, pos_Z, fixed);
+
+    for (unsigned int bodyA = 0; bodyA < nSpheresSD; bodyA++) {
+        unsigned int mySphereID = sphIDs[bodyA];
+        int3 posA = make_int3(pos_X[bodyA], pos_Y[bodyA], pos_Z[bodyA]);
+        float3 velA = make_float3(sphere_data->pos_X_dt[mySphereID], sphere_data->pos_Y_dt[mySphereID],
+                                  sphere_data->pos_Z_dt[mySphereID]);
+
+        flagSDContacts(thisSD, bodyA, nSpheresSD, pos_X, pos_Y, pos_Z, fixed, contact, gran_params);
+
+        // Force generated on this sphere
+        float3 bodyA_force = {0.f, 0.f, 0.f};
+        unsigned int ncontacts = 0;
+        for (unsigned int bodyB = 0; bodyB < nSpheresSD; bodyB++) {
+            if (!contact[bodyB]) {
+                continue;
+            }
+            if (++ncontacts > MAX_SPHERES_TOUCHED_BY_SPHERE) {
+                ABORTABORTABORT("Sphere %u is touching 12 spheres already and we just found another!!!\n",
+                                mySphereID);
+            }
+
+            unsigned int theirSphereID = sphIDs[bodyB];
+            float3 vrel_t;      // unused but needed for function signature
+            float reciplength;  // used to compute contact normal
+            float3 delta_r;     // used for contact normal
+            float3 force_accum = computeSphereNormalForces(
+                reciplength, vrel_t, delta_r, posA, make_int3(pos_X[bodyB], pos_Y[bodyB], pos_Z[bodyB]), velA,
+                make_float3(sphere_data->pos_X_dt[theirSphereID], sphere_data->pos_Y_dt[theirSphereID],
+                            sphere_data->pos_Z_dt[theirSphereID]),
+                gran_params);
+
+            // Add cohesion term
+            force_accum =
+                force_accum - gran_params->sphere_mass_SU * gran_params->cohesionAcc_s2s * delta_r * reciplength;
+            bodyA_force = bodyA_force + force_accum;
+        }
+
+        composite_sphere_forces[sphere_data->SD_SphereCompositeOffsets[thisSD] + bodyA] = bodyA_force;
+    }
+}
+
+// Sum the SD contributions to the force on a sphere, in the order of the SDs it touches, add its wall, BC, and grav
+// forces, and store its acceleration
+static void computeSphereForces_frictionless(unsigned int mySphereID,
+                                             GranSphereDataPtr sphere_data,
+                                             GranParamsPtr gran_params,
+                                             const unsigned int* sphere_composite_entries,
+                                             const float3* composite_sphere_forces,
+                                             BC_type* bc_type_list,
+                                             BC_params_t<int64_t, int64_t3>* bc_params_list,
+                                             unsigned int nBCs) {
+    float3 bodyA_force = {0.f, 0.f, 0.f};
+    const unsigned int* entries = sphere_composite_entries + (size_t)MAX_SDs_TOUCHED_BY_SPHERE * mySphereID;
+    for (unsigned int i = 0; i < MAX_SDs_TOUCHED_BY_SPHERE; i++) {
+        if (entries[i] != NULL_GRANULAR_ID) {
+            bodyA_force = bodyA_force + composite_sphere_forces[entries[i]];
+        }
+    }
+
+    int3 posA = make_int3(sphere_data->sphere_local_pos_X[mySphereID], sphere_data->sphere_local_pos_Y[mySphereID],
+                          sphere_data->sphere_local_pos_Z[mySphereID]);
+    float3 velA = make_float3(sphere_data->pos_X_dt[mySphereID], sphere_data->pos_Y_dt[mySphereID],
+                              sphere_data->pos_Z_dt[mySphereID]);
+    applyExternalForces_frictionless(sphere_data->sphere_owner_SDs[mySphereID], posA, velA, bodyA_force, gran_params,
+                                     sphere_data, bc_type_list, bc_params_list, nBCs);
+
+    sphere_data->sphere_acc_X[mySphereID] += bodyA_force.x / gran_params->sphere_mass_SU;
+    sphere_data->sphere_acc_Y[mySphereID] += bodyA_force.y / gran_params->sphere_mass_SU;
+    sphere_data->sphere_acc_Z[mySphereID] += bodyA_force.z / gran_params->sphere_mass_SU;
+}
+
+// Host counterpart of the determineContactPairs kernel for one subdomain
+static void determineSDContactPairs(unsigned int thisSD, GranSphereDataPtr sphere_data, GranParamsPtr gran_params) {
+    unsigned int sphIDs[MAX_COUNT_OF_SPHERES_PER_SD];
+    int pos_X[MAX_COUNT_OF_SPHERES_PER_SD];
+    int pos_Y[MAX_COUNT_OF_SPHERES_PER_SD];
+    int pos_Z[MAX_COUNT_OF_SPHERES_PER_SD];
+    not_stupid_bool fixed[MAX_COUNT_OF_SPHERES_PER_SD];
+    not_stupid_bool contact[MAX_COUNT_OF_SPHERES_PER_SD];
+
+    unsigned int nSpheresSD = gatherSDSpheres(thisSD, sphere_data, gran_params, sphIDs, pos_X, pos_Y, pos_Z, fixed);
+
+    for (unsigned int bodyA = 0; bodyA < nSpheresSD; bodyA++) {
+        flagSDContacts(thisSD, bodyA, nSpheresSD, pos_X, pos_Y, pos_Z, fixed, contact, gran_params);
+
+        unsigned int ncontacts = 0;
+        for (unsigned int bodyB = 0; bodyB < nSpheresSD; bodyB++) {
+            if (!contact[bodyB]) {
+                continue;
+            }
+            if (++ncontacts > MAX_SPHERES_TOUCHED_BY_SPHERE) {
+                ABORTABORTABORT("Sphere %u is touching 12 spheres already and we just found another!!!\n",
+                                sphIDs[bodyA]);
+            }
+            // find and mark a spot in the contact map
+            findContactPairInfo(sphere_data, gran_params, sphIDs[bodyA], sphIDs[bodyB]);
+        }
+    }
+}
+
+// Sort the contact slots of a sphere by partner ID (free slots last). Slots are claimed in the order in which SDs are
+// processed, which depends on thread scheduling; sorting fixes the order in which the contact forces are summed.
+static void sortContactSlots(unsigned int mySphereID, GranSphereDataPtr sphere_data) {
+    size_t body_A_offset = (size_t)MAX_SPHERES_TOUCHED_BY_SPHERE * mySphereID;
+    unsigned int* partners = sphere_data->contact_partners_map + body_A_offset;
+    not_stupid_bool* active = sphere_data->contact_active_map + body_A_offset;
+    float3* history = sphere_data->contact_history_map + body_A_offset;
+
+    // insertion sort, there are only a few slots
+    for (unsigned int i = 1; i < MAX_SPHERES_TOUCHED_BY_SPHERE; i++) {
+        unsigned int partner = partners[i];
+        not_stupid_bool is_active = active[i];
+        float3 hist = history[i];
+        unsigned int j = i;
+        for (; j > 0 && partners[j - 1] > partner; j--) {
+            partners[j] = partners[j - 1];
+            active[j] = active[j - 1];
+            history[j] = history[j - 1];
+        }
+        partners[j] = partner;
+        active[j] = is_active;
+        history[j] = hist;
+    }
+}
+
+__host__ void ChSystemGranularSMC::initializeLocalPositions_CPU(const int64_t* sphere_pos_global_X,
+                                                               const int64_t* sphere_pos_global_Y,
+                                                               const int64_t* sphere_pos_global_Z) {
+#pragma omp parallel for
+    for (int i = 0; i < (int)nSpheres; i++) {
+        findNewLocalCoords(sphere_data, i, sphere_pos_global_X[i], sphere_pos_global_Y[i], sphere_pos_global_Z[i],
+                           gran_params);
+    }
+}
+
+__host__ void ChSystemGranularSMC::runSphereBroadphase_CPU() {
+    METRICS_PRINTF("Resetting broadphase info!\n");
+
+    resetBroadphaseInformation();
+    packSphereDataPointers();
+
+    // Find the SDs touched by each sphere
+    std::vector<unsigned int> SDs_touched((size_t)MAX_SDs_TOUCHED_BY_SPHERE * nSpheres, NULL_GRANULAR_ID);
+
+#pragma omp parallel for
+    for (int i = 0; i < (int)nSpheres; i++) {
+        int3 ownerSD_triplet = SDIDTriplet(sphere_data->sphere_owner_SDs[i], gran_params);
+        // positions are relative to Big Domain corner
+        int64_t sphere_pos_relative_X =
+            ((int64_t)ownerSD_triplet.x) * gran_params->SD_size_X_SU + sphere_data->sphere_local_pos_X[i];
+        int64_t sphere_pos_relative_Y =
+            ((int64_t)ownerSD_triplet.y) * gran_params->SD_size_Y_SU + sphere_data->sphere_local_pos_Y[i];
+        int64_t sphere_pos_relative_Z =
+            ((int64_t)ownerSD_triplet.z) * gran_params->SD_size_Z_SU + sphere_data->sphere_local_pos_Z[i];
+
+        figureOutTouchedSD(sphere_pos_relative_X, sphere_pos_relative_Y, sphere_pos_relative_Z,
+                           SDs_touched.data() + (size_t)MAX_SDs_TOUCHED_BY_SPHERE * i, gran_params);
+    }
+
+    // Count the spheres touching each SD
+    for (size_t k = 0; k < SDs_touched.size(); k++) {
+        if (SDs_touched[k] != NULL_GRANULAR_ID) {
+            SD_NumSpheresTouching[SDs_touched[k]]++;
+        }
+    }
+
+    // Exclusive prefix sum gives the offset of each SD in the composite array
+    unsigned int num_entries = 0;
+    for (unsigned int SD = 0; SD < nSDs; SD++) {
+        SD_SphereCompositeOffsets[SD] = num_entries;
+        num_entries += SD_NumSpheresTouching[SD];
+    }
+    spheres_in_SD_composite.resize(num_entries, NULL_GRANULAR_ID);
+    composite_sphere_forces.resize(num_entries);
+
+    // make sure the DEs pointer is updated
+    packSphereDataPointers();
+
+    // Register each sphere with the SDs it touches. Spheres are stored in increasing ID order within each SD, so that
+    // the composite array does not depend on thread scheduling.
+    // Also record the entries of each sphere, in the order of the SDs it touches.
+    std::vector<unsigned int> SD_fill(SD_SphereCompositeOffsets.begin(), SD_SphereCompositeOffsets.end());
+    sphere_composite_entries.assign(SDs_touched.size(), NULL_GRANULAR_ID);
+    for (size_t k = 0; k < SDs_touched.size(); k++) {
+        unsigned int touchedSD = SDs_touched[k];
+        if (touchedSD != NULL_GRANULAR_ID) {
+            sphere_composite_entries[k] = SD_fill[touchedSD];
+            spheres_in_SD_composite[SD_fill[touchedSD]++] = (unsigned int)(k / MAX_SDs_TOUCHED_BY_SPHERE);
+        }
+    }
+}
+
+__host__ void ChSystemGranularSMC::applyBDFrameChange_CPU(int64_t3 delta) {
+#pragma omp parallel for
+    for (int i = 0; i < (int)nSpheres; i++) {
+        int3 sphere_pos_local = make_int3(sphere_data->sphere_local_pos_X[i], sphere_data->sphere_local_pos_Y[i],
+                                          sphere_data->sphere_local_pos_Z[i]);
+        unsigned int ownerSD = sphere_data->sphere_owner_SDs[i];
+
+        // find global pos in old frame, but add the offset
+        int64_t3 sphPos_global = convertPosLocalToGlobal(ownerSD, sphere_pos_local, gran_params) + delta;
+
+        findNewLocalCoords(sphere_data, i, sphPos_global.x, sphPos_global.y, sphPos_global.z, gran_params);
+    }
+}
+
+__host__ void ChSystemGranularSMC::computeSphereForces_CPU() {
+    BC_type* bc_type_list = BC_type_list.data();
+    unsigned int nBCs = (unsigned int)BC_params_list_SU.size();
+    bool frictionless = gran_params->friction_mode == GRAN_FRICTION_MODE::FRICTIONLESS;
+
+    // SDs have very different loads (most are empty), hence the dynamic schedule
+    if (frictionless) {
+#pragma omp parallel for schedule(dynamic, 16)
+        for (int SD = 0; SD < (int)nSDs; SD++) {
+            computeSDForces_frictionless(SD, sphere_data, gran_params, composite_sphere_forces.data());
+        }
+    } else {
+        // figure out who is contacting
+#pragma omp parallel for schedule(dynamic, 16)
+        for (int SD = 0; SD < (int)nSDs; SD++) {
+            determineSDContactPairs(SD, sphere_data, gran_params);
+        }
+
+#pragma omp parallel for
+        for (int i = 0; i < (int)nSpheres; i++) {
+            sortContactSlots(i, sphere_data);
+        }
+    }
+
+    // Spheres are processed in fixed blocks, each with its own copy of the BCs to accumulate reaction forces
+    const unsigned int block_size = 1024;
+    unsigned int nBlocks = (nSpheres + block_size - 1) / block_size;
+    std::vector<BC_params_t<int64_t, int64_t3>> block_bc_params((size_t)nBlocks * nBCs);
+    for (unsigned int b = 0; b < nBlocks; b++) {
+        for (unsigned int BC_id = 0; BC_id < nBCs; BC_id++) {
+            block_bc_params[(size_t)b * nBCs + BC_id] = BC_params_list_SU[BC_id];
+            block_bc_params[(size_t)b * nBCs + BC_id].reaction_forces = {0, 0, 0};
+        }
+    }
+
+#pragma omp parallel for schedule(dynamic)
+    for (int b = 0; b < (int)nBlocks; b++) {
+        BC_params_t<int64_t, int64_t3>* bc_params_list = block_bc_params.data() + (size_t)b * nBCs;
+        unsigned int end = std::min((b + 1) * block_size, nSpheres);
+        for (unsigned int i = b * block_size; i < end; i++) {
+            if (frictionless) {
+                computeSphereForces_frictionless(i, sphere_data, gran_params, sphere_composite_entries.data(),
+                                                 composite_sphere_forces.data(), bc_type_list, bc_params_list, nBCs);
+            } else {
+                computeSphereContactForces_sphere(i, sphere_data, gran_params, bc_type_list, bc_params_list, nBCs,
+                                                  nSpheres);
+            }
+        }
+    }
+
+    // Sum the reaction forces in block order
+    for (unsigned int b = 0; b < nBlocks; b++) {
+        for (unsigned int BC_id = 0; BC_id < nBCs; BC_id++) {
+            float3& reaction_forces = BC_params_list_SU[BC_id].reaction_forces;
+            if (BC_params_list_SU[BC_id].track_forces) {
+                reaction_forces = reaction_forces + block_bc_params[(size_t)b * nBCs + BC_id].reaction_forces;
+            }
+        }
+    }
+}
+
+__host__ void ChSystemGranularSMC::integrateSpheres_CPU() {
+#pragma omp parallel for
+    for (int i = 0; i < (int)nSpheres; i++) {
+        if (!sphere_data->sphere_fixed[i]) {
+            integrateSphere(i, stepSize_SU, sphere_data, gran_params);
+        }
+    }
+}
+
+__host__ void ChSystemGranularSMC::updateFrictionData_CPU() {
+#pragma omp parallel for
+    for (int i = 0; i < (int)nSpheres; i++) {
+        updateSphereFrictionData(i, stepSize_SU, sphere_data, gran_params);
+    }
+}
+
+}  // namespace granular
+}  // namespace chrono
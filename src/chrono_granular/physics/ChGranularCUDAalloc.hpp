@@ -20,12 +20,23 @@
 
 #include <cuda_runtime_api.h>
 #include <climits>
+#include <cstdlib>
 #include <iostream>
 #include <memory>
 #include <new>
 #include <type_traits>
 #include <utility>
 
+/// Whether unified memory is available. On nodes without a CUDA device (e.g. when running the CPU backend), the
+/// allocator falls back to regular host memory.
+inline bool cudallocator_managed_available() {
+    static const bool available = []() {
+        int num_devices = 0;
+        return cudaGetDeviceCount(&num_devices) == cudaSuccess && num_devices > 0;
+    }();
+    return available;
+}
+
 #if (__cplusplus >= 201703L)  // C++17 or newer
 template <class T>
 struct cudallocator {
@@ -84,6 +95,13 @@ class cudallocator {
 
     pointer allocate(size_type n, std::allocator<void>::const_pointer hint = 0) {
         void* vptr;
+        if (!cudallocator_managed_available()) {
+            vptr = std::malloc(n * sizeof(T));
+            if (vptr == nullptr && n > 0) {
+                throw std::bad_alloc();
+            }
+            return (T*)vptr;
+        }
         cudaError_t err = cudaMallocManaged(&vptr, n * sizeof(T), cudaMemAttachGlobal);
         if (err == cudaErrorMemoryAllocation || err == cudaErrorNotSupported) {
             throw std::bad_alloc();
@@ -91,7 +109,13 @@ class cudallocator {
         return (T*)vptr;
     }
 
-    void deallocate(pointer p, size_type n) { cudaFree(p); }
+    void deallocate(pointer p, size_type n) {
+        if (!cudallocator_managed_available()) {
+            std::free(p);
+            return;
+        }
+        cudaFree(p);
+    }
 
     bool operator==(const cudallocator& other) const { return true; }
     bool operator!=(const cudallocator& other) const { return false; }
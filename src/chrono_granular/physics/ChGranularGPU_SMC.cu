@@ -12,6 +12,7 @@
 // Authors: Conlain Kelly, Nic Olsen, Dan Negrut
 // =============================================================================
 
+#include <algorithm>
 #include <cmath>
 #include <numeric>
 
@@ -41,6 +42,13 @@ __host__ double ChSystemGranularSMC::get_max_z() const {
 
 // Reset broadphase data structures
 void ChSystemGranularSMC::resetBroadphaseInformation() {
+    if (backend == GRAN_EXECUTION_BACKEND::CPU) {
+        std::fill(SD_NumSpheresTouching.begin(), SD_NumSpheresTouching.end(), 0);
+        std::fill(SD_SphereCompositeOffsets.begin(), SD_SphereCompositeOffsets.end(), 0);
+        std::fill(spheres_in_SD_composite.begin(), spheres_in_SD_composite.end(), NULL_GRANULAR_ID);
+        return;
+    }
+
     // Set all the offsets to zero
     gpuErrchk(cudaMemset(SD_NumSpheresTouching.data(), 0, SD_NumSpheresTouching.size() * sizeof(unsigned int)));
     gpuErrchk(cudaMemset(SD_SphereCompositeOffsets.data(), 0, SD_SphereCompositeOffsets.size() * sizeof(unsigned int)));
@@ -52,6 +60,28 @@ void ChSystemGranularSMC::resetBroadphaseInformation() {
 
 // Reset sphere acceleration data structures
 void ChSystemGranularSMC::resetSphereAccelerations() {
+    if (backend == GRAN_EXECUTION_BACKEND::CPU) {
+        if (time_integrator == GRAN_TIME_INTEGRATOR::CHUNG) {
+            std::copy(sphere_acc_X.begin(), sphere_acc_X.begin() + nSpheres, sphere_acc_X_old.begin());
+            std::copy(sphere_acc_Y.begin(), sphere_acc_Y.begin() + nSpheres, sphere_acc_Y_old.begin());
+            std::copy(sphere_acc_Z.begin(), sphere_acc_Z.begin() + nSpheres, sphere_acc_Z_old.begin());
+            if (gran_params->friction_mode != FRICTIONLESS) {
+                std::copy(sphere_ang_acc_X.begin(), sphere_ang_acc_X.begin() + nSpheres, sphere_ang_acc_X_old.begin());
+                std::copy(sphere_ang_acc_Y.begin(), sphere_ang_acc_Y.begin() + nSpheres, sphere_ang_acc_Y_old.begin());
+                std::copy(sphere_ang_acc_Z.begin(), sphere_ang_acc_Z.begin() + nSpheres, sphere_ang_acc_Z_old.begin());
+            }
+        }
+        std::fill(sphere_acc_X.begin(), sphere_acc_X.begin() + nSpheres, 0.f);
+        std::fill(sphere_acc_Y.begin(), sphere_acc_Y.begin() + nSpheres, 0.f);
+        std::fill(sphere_acc_Z.begin(), sphere_acc_Z.begin() + nSpheres, 0.f);
+        if (gran_params->friction_mode != FRICTIONLESS) {
+            std::fill(sphere_ang_acc_X.begin(), sphere_ang_acc_X.begin() + nSpheres, 0.f);
+            std::fill(sphere_ang_acc_Y.begin(), sphere_ang_acc_Y.begin() + nSpheres, 0.f);
+            std::fill(sphere_ang_acc_Z.begin(), sphere_ang_acc_Z.begin() + nSpheres, 0.f);
+        }
+        return;
+    }
+
     // cache past acceleration data
     if (time_integrator == GRAN_TIME_INTEGRATOR::CHUNG) {
         gpuErrchk(cudaMemcpy(sphere_acc_X_old.data(), sphere_acc_X.data(), nSpheres * sizeof(float),
@@ -98,6 +128,15 @@ __global__ void compute_absv(const unsigned int nSpheres,
 }
 
 __host__ float ChSystemGranularSMC::get_max_vel() const {
+    if (backend == GRAN_EXECUTION_BACKEND::CPU) {
+        float max_vel = 0;
+        for (unsigned int i = 0; i < nSpheres; i++) {
+            max_vel = std::max(max_vel, std::sqrt(pos_X_dt[i] * pos_X_dt[i] + pos_Y_dt[i] * pos_Y_dt[i] +
+                                                  pos_Z_dt[i] * pos_Z_dt[i]));
+        }
+        return max_vel;
+    }
+
     float* d_absv;
     float* d_max_vel;
     float h_max_vel;
@@ -246,14 +285,19 @@ __host__ void ChSystemGranularSMC::setupSphereDataStructures() {
         }
 
         packSphereDataPointers();
-        // Figure our the number of blocks that need to be launched to cover the box
-        unsigned int nBlocks = (nSpheres + CUDA_THREADS_PER_BLOCK - 1) / CUDA_THREADS_PER_BLOCK;
-        initializeLocalPositions<<<nBlocks, CUDA_THREADS_PER_BLOCK>>>(
-            sphere_data, sphere_global_pos_X.data(), sphere_global_pos_Y.data(), sphere_global_pos_Z.data(), nSpheres,
-            gran_params);
+        if (backend == GRAN_EXECUTION_BACKEND::CPU) {
+            initializeLocalPositions_CPU(sphere_global_pos_X.data(), sphere_global_pos_Y.data(),
+                                         sphere_global_pos_Z.data());
+        } else {
+            // Figure our the number of blocks that need to be launched to cover the box
+            unsigned int nBlocks = (nSpheres + CUDA_THREADS_PER_BLOCK - 1) / CUDA_THREADS_PER_BLOCK;
+            initializeLocalPositions<<<nBlocks, CUDA_THREADS_PER_BLOCK>>>(
+                sphere_data, sphere_global_pos_X.data(), sphere_global_pos_Y.data(), sphere_global_pos_Z.data(),
+                nSpheres, gran_params);
 
-        gpuErrchk(cudaDeviceSynchronize());
-        gpuErrchk(cudaPeekAtLastError());
+            gpuErrchk(cudaDeviceSynchronize());
+            gpuErrchk(cudaPeekAtLastError());
+        }
         defragment_initial_positions();
     }
 
@@ -303,6 +347,11 @@ __host__ void ChSystemGranularSMC::setupSphereDataStructures() {
 }
 
 __host__ void ChSystemGranularSMC::runSphereBroadphase() {
+    if (backend == GRAN_EXECUTION_BACKEND::CPU) {
+        runSphereBroadphase_CPU();
+        return;
+    }
+
     METRICS_PRINTF("Resetting broadphase info!\n");
 
     resetBroadphaseInformation();
@@ -422,6 +471,11 @@ __host__ void ChSystemGranularSMC::updateBCPositions() {
 
         packSphereDataPointers();
 
+        if (backend == GRAN_EXECUTION_BACKEND::CPU) {
+            applyBDFrameChange_CPU(offset_delta);
+            return;
+        }
+
         applyBDFrameChange<<<nBlocks, CUDA_THREADS_PER_BLOCK>>>(offset_delta, sphere_data, nSpheres, gran_params);
 
         gpuErrchk(cudaPeekAtLastError());
@@ -448,14 +502,31 @@ __host__ double ChSystemGranularSMC::advance_simulation(float duration) {
         runSphereBroadphase();
         packSphereDataPointers();
 
-        gpuErrchk(cudaPeekAtLastError());
-        gpuErrchk(cudaDeviceSynchronize());
+        if (backend == GRAN_EXECUTION_BACKEND::GPU) {
+            gpuErrchk(cudaPeekAtLastError());
+            gpuErrchk(cudaDeviceSynchronize());
+        }
 
         resetSphereAccelerations();
         resetBCForces();
 
         METRICS_PRINTF("Starting computeSphereForces!\n");
 
+        // Host backend: same sequence of operations, as OpenMP loops
+        if (backend == GRAN_EXECUTION_BACKEND::CPU) {
+            computeSphereForces_CPU();
+
+            METRICS_PRINTF("Starting integrateSpheres!\n");
+            integrateSpheres_CPU();
+
+            if (gran_params->friction_mode != GRAN_FRICTION_MODE::FRICTIONLESS) {
+                updateFrictionData_CPU();
+            }
+
+            elapsedSimTime += (float)(stepSize_SU * TIME_SU2UU);  // Advance current time
+            continue;
+        }
+
         if (gran_params->friction_mode == FRICTIONLESS) {
             // Compute sphere-sphere forces
             computeSphereForces_frictionless<<<nSDs, MAX_COUNT_OF_SPHERES_PER_SD>>>(
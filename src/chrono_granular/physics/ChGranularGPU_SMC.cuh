@@ -65,11 +65,11 @@ inline __device__ __host__ int64_t3 convertPosLocalToGlobal(unsigned int ownerSD
 /// which subdomains described in the corresponding 8-SD cube are touched by the sphere. The kernel then converts
 /// these indices to indices into the global SD list via the (currently local) conv[3] data structure Should be
 /// mostly bug-free, especially away from boundaries
-inline __device__ void figureOutTouchedSD(int64_t sphCenter_X_relative,
-                                          int64_t sphCenter_Y_relative,
-                                          int64_t sphCenter_Z_relative,
-                                          unsigned int SDs[MAX_SDs_TOUCHED_BY_SPHERE],
-                                          GranParamsPtr gran_params) {
+inline __host__ __device__ void figureOutTouchedSD(int64_t sphCenter_X_relative,
+                                                   int64_t sphCenter_Y_relative,
+                                                   int64_t sphCenter_Z_relative,
+                                                   unsigned int SDs[MAX_SDs_TOUCHED_BY_SPHERE],
+                                                   GranParamsPtr gran_params) {
     // grab radius as signed so we can use it intelligently
     const signed int sphereRadius_SU = gran_params->sphereRadius_SU;
     // I added these to fix a bug, we can inline them if/when needed but they ARE necessary
@@ -342,7 +342,7 @@ __global__ void sphereBroadphase(GranSphereDataPtr sphere_data,
 
 /// Get position offset between two SDs
 // NOTE this assumes they are close together
-inline __device__ int3 getOffsetFromSDs(unsigned int thisSD, unsigned int otherSD, GranParamsPtr gran_params) {
+inline __host__ __device__ int3 getOffsetFromSDs(unsigned int thisSD, unsigned int otherSD, GranParamsPtr gran_params) {
     int3 thisSDTrip = SDIDTriplet(thisSD, gran_params);
     int3 otherSDTrip = SDIDTriplet(otherSD, gran_params);
     int3 dist = {0, 0, 0};
@@ -356,12 +356,12 @@ inline __device__ int3 getOffsetFromSDs(unsigned int thisSD, unsigned int otherS
 }
 
 /// update local positions and SD based on global position
-inline __device__ void findNewLocalCoords(GranSphereDataPtr sphere_data,
-                                          unsigned int mySphereID,
-                                          int64_t global_pos_X,
-                                          int64_t global_pos_Y,
-                                          int64_t global_pos_Z,
-                                          GranParamsPtr gran_params) {
+inline __host__ __device__ void findNewLocalCoords(GranSphereDataPtr sphere_data,
+                                                   unsigned int mySphereID,
+                                                   int64_t global_pos_X,
+                                                   int64_t global_pos_Y,
+                                                   int64_t global_pos_Z,
+                                                   GranParamsPtr gran_params) {
     int3 ownerSD = pointSDTriplet(global_pos_X, global_pos_Y, global_pos_Z, gran_params);
 
     // printf("sphere %u, ownerSD is %d, %d, %d\n", mySphereID, ownerSD.x, ownerSD.y, ownerSD.z);
@@ -403,8 +403,6 @@ inline __device__ void findNewLocalCoords(GranSphereDataPtr sphere_data,
     sphere_data->sphere_local_pos_Z[mySphereID] = sphere_pos_local_Z;
 
     if (SDID >= gran_params->nSDs) {
-        unsigned int mySphereID = threadIdx.x + blockIdx.x * blockDim.x;
-
         ABORTABORTABORT("ERROR! Sphere %u has invalid SD %u, max is %u, triplet %d, %d, %d\n", mySphereID, SDID,
                         gran_params->nSDs, ownerSD.x, ownerSD.y, ownerSD.z);
     }
@@ -453,22 +451,22 @@ static __global__ void initializeLocalPositions(GranSphereDataPtr sphere_data,
 }
 
 // apply gravity to a sphere
-inline __device__ void applyGravity(float3& sphere_force, GranParamsPtr gran_params) {
+inline __host__ __device__ void applyGravity(float3& sphere_force, GranParamsPtr gran_params) {
     sphere_force.x += gran_params->gravAcc_X_SU * gran_params->sphere_mass_SU;
     sphere_force.y += gran_params->gravAcc_Y_SU * gran_params->sphere_mass_SU;
     sphere_force.z += gran_params->gravAcc_Z_SU * gran_params->sphere_mass_SU;
 }
 
 /// Compute forces on a sphere from walls, BCs, and gravity
-inline __device__ void applyExternalForces_frictionless(unsigned int ownerSD,
-                                                        const int3& sphPos_local,  // local X position of DE
-                                                        const float3& sphVel,      // Global X velocity of DE
-                                                        float3& sphere_force,
-                                                        GranParamsPtr gran_params,
-                                                        GranSphereDataPtr sphere_data,
-                                                        BC_type* bc_type_list,
-                                                        BC_params_t<int64_t, int64_t3>* bc_params_list,
-                                                        unsigned int nBCs) {
+inline __host__ __device__ void applyExternalForces_frictionless(unsigned int ownerSD,
+                                                                 const int3& sphPos_local,  // local X position of DE
+                                                                 const float3& sphVel,      // Global X velocity of DE
+                                                                 float3& sphere_force,
+                                                                 GranParamsPtr gran_params,
+                                                                 GranSphereDataPtr sphere_data,
+                                                                 BC_type* bc_type_list,
+                                                                 BC_params_t<int64_t, int64_t3>* bc_params_list,
+                                                                 unsigned int nBCs) {
     int64_t3 sphPos_global = convertPosLocalToGlobal(ownerSD, sphPos_local, gran_params);
 
     // add forces from each BC
@@ -506,18 +504,18 @@ inline __device__ void applyExternalForces_frictionless(unsigned int ownerSD,
 }
 
 /// Compute forces on a sphere from walls, BCs, and gravity
-inline __device__ void applyExternalForces(unsigned int currSphereID,
-                                           unsigned int ownerSD,
-                                           const int3& sphPos_local,  // Global X position of DE
-                                           const float3& sphVel,      // Global X velocity of DE
-                                           const float3& sphOmega,
-                                           float3& sphere_force,
-                                           float3& sphere_ang_acc,
-                                           GranParamsPtr gran_params,
-                                           GranSphereDataPtr sphere_data,
-                                           BC_type* bc_type_list,
-                                           BC_params_t<int64_t, int64_t3>* bc_params_list,
-                                           unsigned int nBCs) {
+inline __host__ __device__ void applyExternalForces(unsigned int currSphereID,
+                                                    unsigned int ownerSD,
+                                                    const int3& sphPos_local,  // Global X position of DE
+                                                    const float3& sphVel,      // Global X velocity of DE
+                                                    const float3& sphOmega,
+                                                    float3& sphere_force,
+                                                    float3& sphere_ang_acc,
+                                                    GranParamsPtr gran_params,
+                                                    GranSphereDataPtr sphere_data,
+                                                    BC_type* bc_type_list,
+                                                    BC_params_t<int64_t, int64_t3>* bc_params_list,
+                                                    unsigned int nBCs) {
     int64_t3 sphPos_global = convertPosLocalToGlobal(ownerSD, sphPos_local, gran_params);
 
     // add forces from each BC
@@ -636,14 +634,14 @@ static __global__ void determineContactPairs(GranSphereDataPtr sphere_data, Gran
 /// Compute normal forces for a contacting pair
 // returns the normal force and sets the reciplength, tangent velocity, and delta_r
 // delta_r is direction of normal force on me
-inline __device__ float3 computeSphereNormalForces(float& reciplength,
-                                                   float3& vrel_t,
-                                                   float3& delta_r,
-                                                   const int3& sphereA_pos,
-                                                   const int3& sphereB_pos,
-                                                   const float3& sphereA_vel,
-                                                   const float3& sphereB_vel,
-                                                   GranParamsPtr gran_params) {
+inline __host__ __device__ float3 computeSphereNormalForces(float& reciplength,
+                                                            float3& vrel_t,
+                                                            float3& delta_r,
+                                                            const int3& sphereA_pos,
+                                                            const int3& sphereB_pos,
+                                                            const float3& sphereA_vel,
+                                                            const float3& sphereB_vel,
+                                                            GranParamsPtr gran_params) {
     // grab radius from global
     unsigned int sphereRadius_SU = gran_params->sphereRadius_SU;
 
@@ -651,7 +649,7 @@ inline __device__ float3 computeSphereNormalForces(float& reciplength,
     {
         double3 delta_r_double = int3_to_double3(sphereA_pos - sphereB_pos) / (2. * sphereRadius_SU);
         // compute in double then convert to float
-        reciplength = (float)rsqrt(Dot(delta_r_double, delta_r_double));
+        reciplength = (float)granRsqrt(Dot(delta_r_double, delta_r_double));
     }
 
     // compute these in float now
@@ -687,137 +685,150 @@ inline __device__ float3 computeSphereNormalForces(float& reciplength,
     return force_accum;
 }
 
-/// each thread is a sphere, computing the forces its contact partners exert on it
-static __global__ void computeSphereContactForces(GranSphereDataPtr sphere_data,
-                                                  GranParamsPtr gran_params,
-                                                  BC_type* bc_type_list,
-                                                  BC_params_t<int64_t, int64_t3>* bc_params_list,
-                                                  unsigned int nBCs,
-                                                  unsigned int nSpheres) {
+/// Compute the forces and torques that contact partners, BCs, and gravity exert on a sphere in frictional mode
+/// Shared by the GPU kernel below and the CPU backend
+inline __host__ __device__ void computeSphereContactForces_sphere(unsigned int mySphereID,
+                                                                  GranSphereDataPtr sphere_data,
+                                                                  GranParamsPtr gran_params,
+                                                                  BC_type* bc_type_list,
+                                                                  BC_params_t<int64_t, int64_t3>* bc_params_list,
+                                                                  unsigned int nBCs,
+                                                                  unsigned int nSpheres) {
     // grab the sphere radius
     unsigned int sphereRadius_SU = gran_params->sphereRadius_SU;
 
-    // my sphere ID, we're using a 1D thread->sphere map
-    unsigned int mySphereID = threadIdx.x + blockIdx.x * blockDim.x;
-
-    // don't overrun the array
-    if (mySphereID < nSpheres) {
-        // my offset in the contact map
-        unsigned int myOwnerSD = sphere_data->sphere_owner_SDs[mySphereID];
+    // my offset in the contact map
+    unsigned int myOwnerSD = sphere_data->sphere_owner_SDs[mySphereID];
 
-        // Bring in data from global
-        int3 my_sphere_pos =
-            make_int3(sphere_data->sphere_local_pos_X[mySphereID], sphere_data->sphere_local_pos_Y[mySphereID],
-                      sphere_data->sphere_local_pos_Z[mySphereID]);
-        // prepare in case we have friction
-        float3 my_omega = {0, 0, 0};
+    // Bring in data from global
+    int3 my_sphere_pos =
+        make_int3(sphere_data->sphere_local_pos_X[mySphereID], sphere_data->sphere_local_pos_Y[mySphereID],
+                  sphere_data->sphere_local_pos_Z[mySphereID]);
+    // prepare in case we have friction
+    float3 my_omega = {0, 0, 0};
 
-        if (gran_params->friction_mode != GRAN_FRICTION_MODE::FRICTIONLESS) {
-            my_omega = make_float3(sphere_data->sphere_Omega_X[mySphereID], sphere_data->sphere_Omega_Y[mySphereID],
-                                   sphere_data->sphere_Omega_Z[mySphereID]);
-        }
+    if (gran_params->friction_mode != GRAN_FRICTION_MODE::FRICTIONLESS) {
+        my_omega = make_float3(sphere_data->sphere_Omega_X[mySphereID], sphere_data->sphere_Omega_Y[mySphereID],
+                               sphere_data->sphere_Omega_Z[mySphereID]);
+    }
 
-        float3 my_sphere_vel = make_float3(sphere_data->pos_X_dt[mySphereID], sphere_data->pos_Y_dt[mySphereID],
-                                           sphere_data->pos_Z_dt[mySphereID]);
+    float3 my_sphere_vel = make_float3(sphere_data->pos_X_dt[mySphereID], sphere_data->pos_Y_dt[mySphereID],
+                                       sphere_data->pos_Z_dt[mySphereID]);
 
-        // Now compute the force each contact partner exerts
-        // Force applied to this sphere
-        float3 bodyA_force = {0.f, 0.f, 0.f};
-        float3 bodyA_AngAcc = {0.f, 0.f, 0.f};
+    // Now compute the force each contact partner exerts
+    // Force applied to this sphere
+    float3 bodyA_force = {0.f, 0.f, 0.f};
+    float3 bodyA_AngAcc = {0.f, 0.f, 0.f};
 
-        size_t body_A_offset = MAX_SPHERES_TOUCHED_BY_SPHERE * mySphereID;
-        // for each sphere contacting me, compute the forces
-        for (unsigned char contact_id = 0; contact_id < MAX_SPHERES_TOUCHED_BY_SPHERE; contact_id++) {
-            // who am I colliding with?
-            bool active_contact = sphere_data->contact_active_map[body_A_offset + contact_id];
+    size_t body_A_offset = MAX_SPHERES_TOUCHED_BY_SPHERE * mySphereID;
+    // for each sphere contacting me, compute the forces
+    for (unsigned char contact_id = 0; contact_id < MAX_SPHERES_TOUCHED_BY_SPHERE; contact_id++) {
+        // who am I colliding with?
+        bool active_contact = sphere_data->contact_active_map[body_A_offset + contact_id];
 
-            if (active_contact) {
-                unsigned int theirSphereID = sphere_data->contact_partners_map[body_A_offset + contact_id];
+        if (active_contact) {
+            unsigned int theirSphereID = sphere_data->contact_partners_map[body_A_offset + contact_id];
 
-                if (theirSphereID >= nSpheres) {
-                    ABORTABORTABORT("Invalid other sphere id found for sphere %u at slot %u, other is %u\n", mySphereID,
-                                    contact_id, theirSphereID);
-                }
+            if (theirSphereID >= nSpheres) {
+                ABORTABORTABORT("Invalid other sphere id found for sphere %u at slot %u, other is %u\n", mySphereID,
+                                contact_id, theirSphereID);
+            }
 
-                unsigned int theirOwnerSD = sphere_data->sphere_owner_SDs[theirSphereID];
-                int3 their_pos = make_int3(sphere_data->sphere_local_pos_X[theirSphereID],
-                                           sphere_data->sphere_local_pos_Y[theirSphereID],
-                                           sphere_data->sphere_local_pos_Z[theirSphereID]);
+            unsigned int theirOwnerSD = sphere_data->sphere_owner_SDs[theirSphereID];
+            int3 their_pos = make_int3(sphere_data->sphere_local_pos_X[theirSphereID],
+                                       sphere_data->sphere_local_pos_Y[theirSphereID],
+                                       sphere_data->sphere_local_pos_Z[theirSphereID]);
 
-                if (theirOwnerSD != myOwnerSD) {
-                    // if the spheres are in different subdomains, offset their positions accordingly
-                    their_pos = their_pos + getOffsetFromSDs(myOwnerSD, theirOwnerSD, gran_params);
-                }
+            if (theirOwnerSD != myOwnerSD) {
+                // if the spheres are in different subdomains, offset their positions accordingly
+                their_pos = their_pos + getOffsetFromSDs(myOwnerSD, theirOwnerSD, gran_params);
+            }
 
-                float3 vrel_t;      // tangent relative velocity
-                float reciplength;  // used to compute contact normal
-                float3 delta_r;     // used for contact normal
-                float3 force_accum = computeSphereNormalForces(
-                    reciplength, vrel_t, delta_r, my_sphere_pos, their_pos, my_sphere_vel,
-                    make_float3(sphere_data->pos_X_dt[theirSphereID], sphere_data->pos_Y_dt[theirSphereID],
-                                sphere_data->pos_Z_dt[theirSphereID]),
-                    gran_params);
-
-                float hertz_force_factor = std::sqrt(2. * (1 - (1. / reciplength)));  // sqrt(delta_n / (2 R_eff)
-
-                // add frictional terms, if needed
-                if (gran_params->friction_mode != GRAN_FRICTION_MODE::FRICTIONLESS) {
-                    float3 their_omega = make_float3(sphere_data->sphere_Omega_X[theirSphereID],
-                                                     sphere_data->sphere_Omega_Y[theirSphereID],
-                                                     sphere_data->sphere_Omega_Z[theirSphereID]);
-                    // delta_r * radius is dimensional vector to center of contact point
-                    // (omega_b cross r_b - omega_a cross r_a), where r_b  = -r_a = delta_r * radius
-                    // add tangential components if they exist, these are automatically tangential from the cross
-                    // product
-                    vrel_t = vrel_t + Cross((my_omega + their_omega), -1.f * delta_r * sphereRadius_SU);
-
-                    // compute alpha due to rolling resistance
-                    float3 rolling_resist_ang_acc = computeRollingAngAcc(
-                        sphere_data, gran_params, gran_params->rolling_coeff_s2s_SU, gran_params->spinning_coeff_s2s_SU,
-                        force_accum, my_omega, their_omega, delta_r * sphereRadius_SU);
-                    bodyA_AngAcc = bodyA_AngAcc + rolling_resist_ang_acc;
-
-                    const float m_eff = gran_params->sphere_mass_SU / 2.f;
-
-                    float3 tangent_force = computeFrictionForces(
-                        gran_params, sphere_data, body_A_offset + contact_id, gran_params->static_friction_coeff_s2s,
-                        gran_params->K_t_s2s_SU, gran_params->Gamma_t_s2s_SU, hertz_force_factor, m_eff, force_accum,
-                        vrel_t, delta_r * reciplength);
-
-                    // tau = r cross f = radius * n cross F
-                    // 2 * radius * n = -1 * delta_r * sphdiameter
-                    // assume abs(r) ~ radius, so n = delta_r
-                    // compute accelerations caused by torques on body
-                    bodyA_AngAcc = bodyA_AngAcc + Cross(-1 * delta_r, tangent_force) / gran_params->sphereInertia_by_r;
-                    // add to total forces
-                    force_accum = force_accum + tangent_force;
-                }
+            float3 vrel_t;      // tangent relative velocity
+            float reciplength;  // used to compute contact normal
+            float3 delta_r;     // used for contact normal
+            float3 force_accum = computeSphereNormalForces(
+                reciplength, vrel_t, delta_r, my_sphere_pos, their_pos, my_sphere_vel,
+                make_float3(sphere_data->pos_X_dt[theirSphereID], sphere_data->pos_Y_dt[theirSphereID],
+                            sphere_data->pos_Z_dt[theirSphereID]),
+                gran_params);
+
+            float hertz_force_factor = std::sqrt(2. * (1 - (1. / reciplength)));  // sqrt(delta_n / (2 R_eff)
+
+            // add frictional terms, if needed
+            if (gran_params->friction_mode != GRAN_FRICTION_MODE::FRICTIONLESS) {
+                float3 their_omega = make_float3(sphere_data->sphere_Omega_X[theirSphereID],
+                                                 sphere_data->sphere_Omega_Y[theirSphereID],
+                                                 sphere_data->sphere_Omega_Z[theirSphereID]);
+                // delta_r * radius is dimensional vector to center of contact point
+                // (omega_b cross r_b - omega_a cross r_a), where r_b  = -r_a = delta_r * radius
+                // add tangential components if they exist, these are automatically tangential from the cross
+                // product
+                vrel_t = vrel_t + Cross((my_omega + their_omega), -1.f * delta_r * sphereRadius_SU);
+
+                // compute alpha due to rolling resistance
+                float3 rolling_resist_ang_acc = computeRollingAngAcc(
+                    sphere_data, gran_params, gran_params->rolling_coeff_s2s_SU, gran_params->spinning_coeff_s2s_SU,
+                    force_accum, my_omega, their_omega, delta_r * sphereRadius_SU);
+                bodyA_AngAcc = bodyA_AngAcc + rolling_resist_ang_acc;
+
+                const float m_eff = gran_params->sphere_mass_SU / 2.f;
+
+                float3 tangent_force = computeFrictionForces(
+                    gran_params, sphere_data, body_A_offset + contact_id, gran_params->static_friction_coeff_s2s,
+                    gran_params->K_t_s2s_SU, gran_params->Gamma_t_s2s_SU, hertz_force_factor, m_eff, force_accum,
+                    vrel_t, delta_r * reciplength);
+
+                // tau = r cross f = radius * n cross F
+                // 2 * radius * n = -1 * delta_r * sphdiameter
+                // assume abs(r) ~ radius, so n = delta_r
+                // compute accelerations caused by torques on body
+                bodyA_AngAcc = bodyA_AngAcc + Cross(-1 * delta_r, tangent_force) / gran_params->sphereInertia_by_r;
+                // add to total forces
+                force_accum = force_accum + tangent_force;
+            }
 
-                // Add cohesion term against contact normal
-                // delta_r * reciplength is contact normal
-                force_accum =
-                    force_accum - gran_params->sphere_mass_SU * gran_params->cohesionAcc_s2s * delta_r * reciplength;
+            // Add cohesion term against contact normal
+            // delta_r * reciplength is contact normal
+            force_accum =
+                force_accum - gran_params->sphere_mass_SU * gran_params->cohesionAcc_s2s * delta_r * reciplength;
 
-                // finally, we add this per-contact accumulator to the total force
-                bodyA_force = bodyA_force + force_accum;
-            }
+            // finally, we add this per-contact accumulator to the total force
+            bodyA_force = bodyA_force + force_accum;
         }
+    }
 
-        // add in gravity and wall forces
-        applyExternalForces(mySphereID, myOwnerSD, my_sphere_pos, my_sphere_vel, my_omega, bodyA_force, bodyA_AngAcc,
-                            gran_params, sphere_data, bc_type_list, bc_params_list, nBCs);
+    // add in gravity and wall forces
+    applyExternalForces(mySphereID, myOwnerSD, my_sphere_pos, my_sphere_vel, my_omega, bodyA_force, bodyA_AngAcc,
+                        gran_params, sphere_data, bc_type_list, bc_params_list, nBCs);
 
-        // Write the force back to global memory so that we can apply them AFTER this kernel finishes
-        atomicAdd(sphere_data->sphere_acc_X + mySphereID, bodyA_force.x / gran_params->sphere_mass_SU);
-        atomicAdd(sphere_data->sphere_acc_Y + mySphereID, bodyA_force.y / gran_params->sphere_mass_SU);
-        atomicAdd(sphere_data->sphere_acc_Z + mySphereID, bodyA_force.z / gran_params->sphere_mass_SU);
+    // Write the force back to global memory so that we can apply them AFTER this kernel finishes
+    granAtomicAdd(sphere_data->sphere_acc_X + mySphereID, bodyA_force.x / gran_params->sphere_mass_SU);
+    granAtomicAdd(sphere_data->sphere_acc_Y + mySphereID, bodyA_force.y / gran_params->sphere_mass_SU);
+    granAtomicAdd(sphere_data->sphere_acc_Z + mySphereID, bodyA_force.z / gran_params->sphere_mass_SU);
 
-        if (gran_params->friction_mode == GRAN_FRICTION_MODE::SINGLE_STEP ||
-            gran_params->friction_mode == GRAN_FRICTION_MODE::MULTI_STEP) {
-            atomicAdd(sphere_data->sphere_ang_acc_X + mySphereID, bodyA_AngAcc.x);
-            atomicAdd(sphere_data->sphere_ang_acc_Y + mySphereID, bodyA_AngAcc.y);
-            atomicAdd(sphere_data->sphere_ang_acc_Z + mySphereID, bodyA_AngAcc.z);
-        }
+    if (gran_params->friction_mode == GRAN_FRICTION_MODE::SINGLE_STEP ||
+        gran_params->friction_mode == GRAN_FRICTION_MODE::MULTI_STEP) {
+        granAtomicAdd(sphere_data->sphere_ang_acc_X + mySphereID, bodyA_AngAcc.x);
+        granAtomicAdd(sphere_data->sphere_ang_acc_Y + mySphereID, bodyA_AngAcc.y);
+        granAtomicAdd(sphere_data->sphere_ang_acc_Z + mySphereID, bodyA_AngAcc.z);
+    }
+}
+
+/// each thread is a sphere, computing the forces its contact partners exert on it
+static __global__ void computeSphereContactForces(GranSphereDataPtr sphere_data,
+                                                  GranParamsPtr gran_params,
+                                                  BC_type* bc_type_list,
+                                                  BC_params_t<int64_t, int64_t3>* bc_params_list,
+                                                  unsigned int nBCs,
+                                                  unsigned int nSpheres) {
+    // my sphere ID, we're using a 1D thread->sphere map
+    unsigned int mySphereID = threadIdx.x + blockIdx.x * blockDim.x;
+
+    // don't overrun the array
+    if (mySphereID < nSpheres) {
+        computeSphereContactForces_sphere(mySphereID, sphere_data, gran_params, bc_type_list, bc_params_list, nBCs,
+                                          nSpheres);
     }
 }
 
@@ -935,24 +946,125 @@ static __global__ void computeSphereForces_frictionless(GranSphereDataPtr sphere
 }
 
 /// Compute update for a quantity using Forward Euler integrator
-inline __device__ float integrateForwardEuler(float stepsize_SU, float val_dt) {
+inline __host__ __device__ float integrateForwardEuler(float stepsize_SU, float val_dt) {
     return stepsize_SU * val_dt;
 }
 
 /// Compute update for a velocity using Chung integrator
-inline __device__ float integrateChung_vel(float stepsize_SU, float acc, float acc_old) {
+inline __host__ __device__ float integrateChung_vel(float stepsize_SU, float acc, float acc_old) {
     constexpr float gamma_hat = -1.f / 2.f;
     constexpr float gamma = 3.f / 2.f;
     return stepsize_SU * (acc * gamma + acc_old * gamma_hat);
 }
 
 /// Compute update for a position using Chung integrator
-inline __device__ float integrateChung_pos(float stepsize_SU, float vel_old, float acc, float acc_old) {
+inline __host__ __device__ float integrateChung_pos(float stepsize_SU, float vel_old, float acc, float acc_old) {
     constexpr float beta = 28.f / 27.f;
     constexpr float beta_hat = .5 - beta;
     return stepsize_SU * (vel_old + stepsize_SU * (acc * beta + acc_old * beta_hat));
 }
 
+/// Numerically integrates force to velocity and velocity to position for a single free sphere
+/// Shared by the GPU kernel below and the CPU backend
+inline __host__ __device__ void integrateSphere(unsigned int mySphereID,
+                                                const float stepsize_SU,
+                                                GranSphereDataPtr sphere_data,
+                                                GranParamsPtr gran_params) {
+    float curr_acc_X = sphere_data->sphere_acc_X[mySphereID];
+    float curr_acc_Y = sphere_data->sphere_acc_Y[mySphereID];
+    float curr_acc_Z = sphere_data->sphere_acc_Z[mySphereID];
+
+    // Check to see if we messed up badly somewhere
+    if (curr_acc_X == NAN || curr_acc_Y == NAN || curr_acc_Z == NAN) {
+        ABORTABORTABORT("NAN force computed -- sphere is %u\n", mySphereID);
+    }
+
+    float old_vel_X = sphere_data->pos_X_dt[mySphereID];
+    float old_vel_Y = sphere_data->pos_Y_dt[mySphereID];
+    float old_vel_Z = sphere_data->pos_Z_dt[mySphereID];
+
+    if (old_vel_X >= gran_params->max_safe_vel || old_vel_X == NAN || old_vel_Y >= gran_params->max_safe_vel ||
+        old_vel_Y == NAN || old_vel_Z >= gran_params->max_safe_vel || old_vel_Z == NAN) {
+        ABORTABORTABORT("Unsafe velocity computed -- sphere is %u, vel is (%f, %f, %f)\n", mySphereID, old_vel_X,
+                        old_vel_Y, old_vel_Z);
+    }
+
+    float v_update_X = 0;
+    float v_update_Y = 0;
+    float v_update_Z = 0;
+
+    // no divergence, same for every thread in block
+    switch (gran_params->time_integrator) {
+        case GRAN_TIME_INTEGRATOR::CENTERED_DIFFERENCE:  // centered diff also computes velocity with the same
+                                                         // signature as Euler
+        case GRAN_TIME_INTEGRATOR::EXTENDED_TAYLOR:      // fall through to Euler for this one
+        case GRAN_TIME_INTEGRATOR::FORWARD_EULER: {
+            v_update_X = integrateForwardEuler(stepsize_SU, curr_acc_X);
+            v_update_Y = integrateForwardEuler(stepsize_SU, curr_acc_Y);
+            v_update_Z = integrateForwardEuler(stepsize_SU, curr_acc_Z);
+
+            break;
+        }
+        case GRAN_TIME_INTEGRATOR::CHUNG: {
+            v_update_X = integrateChung_vel(stepsize_SU, curr_acc_X, sphere_data->sphere_acc_X_old[mySphereID]);
+            v_update_Y = integrateChung_vel(stepsize_SU, curr_acc_Y, sphere_data->sphere_acc_Y_old[mySphereID]);
+            v_update_Z = integrateChung_vel(stepsize_SU, curr_acc_Z, sphere_data->sphere_acc_Z_old[mySphereID]);
+
+            break;
+        }
+    }
+
+    // write back the velocity updates
+    sphere_data->pos_X_dt[mySphereID] += v_update_X;
+    sphere_data->pos_Y_dt[mySphereID] += v_update_Y;
+    sphere_data->pos_Z_dt[mySphereID] += v_update_Z;
+
+    float position_update_x = 0;
+    float position_update_y = 0;
+    float position_update_z = 0;
+    // no divergence, same for every thread in block
+    switch (gran_params->time_integrator) {
+        case GRAN_TIME_INTEGRATOR::EXTENDED_TAYLOR: {
+            position_update_x = integrateForwardEuler(stepsize_SU, old_vel_X + 0.5 * curr_acc_X * stepsize_SU);
+            position_update_y = integrateForwardEuler(stepsize_SU, old_vel_Y + 0.5 * curr_acc_Y * stepsize_SU);
+            position_update_z = integrateForwardEuler(stepsize_SU, old_vel_Z + 0.5 * curr_acc_Z * stepsize_SU);
+            break;
+        }
+
+        case GRAN_TIME_INTEGRATOR::FORWARD_EULER: {
+            position_update_x = integrateForwardEuler(stepsize_SU, old_vel_X);
+            position_update_y = integrateForwardEuler(stepsize_SU, old_vel_Y);
+            position_update_z = integrateForwardEuler(stepsize_SU, old_vel_Z);
+            break;
+        }
+        case GRAN_TIME_INTEGRATOR::CHUNG: {
+            position_update_x =
+                integrateChung_pos(stepsize_SU, old_vel_X, curr_acc_X, sphere_data->sphere_acc_X_old[mySphereID]);
+            position_update_y =
+                integrateChung_pos(stepsize_SU, old_vel_Y, curr_acc_Y, sphere_data->sphere_acc_Y_old[mySphereID]);
+            position_update_z =
+                integrateChung_pos(stepsize_SU, old_vel_Z, curr_acc_Z, sphere_data->sphere_acc_Z_old[mySphereID]);
+            break;
+        }
+        case GRAN_TIME_INTEGRATOR::CENTERED_DIFFERENCE: {
+            position_update_x = integrateForwardEuler(stepsize_SU, old_vel_X + v_update_X);
+            position_update_y = integrateForwardEuler(stepsize_SU, old_vel_Y + v_update_Y);
+            position_update_z = integrateForwardEuler(stepsize_SU, old_vel_Z + v_update_Z);
+            break;
+        }
+    }
+
+    int3 sphere_pos_local =
+        make_int3(sphere_data->sphere_local_pos_X[mySphereID] + position_update_x,
+                  sphere_data->sphere_local_pos_Y[mySphereID] + position_update_y,
+                  sphere_data->sphere_local_pos_Z[mySphereID] + position_update_z);  // TODO Rounding occurs here
+
+    int64_t3 sphPos_global =
+        convertPosLocalToGlobal(sphere_data->sphere_owner_SDs[mySphereID], sphere_pos_local, gran_params);
+
+    findNewLocalCoords(sphere_data, mySphereID, sphPos_global.x, sphPos_global.y, sphPos_global.z, gran_params);
+}
+
 /// Numerically integrates force to velocity and velocity to position
 static __global__ void integrateSpheres(const float stepsize_SU,
                                         GranSphereDataPtr sphere_data,
@@ -964,100 +1076,50 @@ static __global__ void integrateSpheres(const float stepsize_SU,
 
     // Write back velocity updates
     if (mySphereID < nSpheres && !sphere_data->sphere_fixed[mySphereID]) {
-        float curr_acc_X = sphere_data->sphere_acc_X[mySphereID];
-        float curr_acc_Y = sphere_data->sphere_acc_Y[mySphereID];
-        float curr_acc_Z = sphere_data->sphere_acc_Z[mySphereID];
-
-        // Check to see if we messed up badly somewhere
-        if (curr_acc_X == NAN || curr_acc_Y == NAN || curr_acc_Z == NAN) {
-            ABORTABORTABORT("NAN force computed -- sphere is %u\n", mySphereID);
-        }
-
-        float old_vel_X = sphere_data->pos_X_dt[mySphereID];
-        float old_vel_Y = sphere_data->pos_Y_dt[mySphereID];
-        float old_vel_Z = sphere_data->pos_Z_dt[mySphereID];
-
-        if (old_vel_X >= gran_params->max_safe_vel || old_vel_X == NAN || old_vel_Y >= gran_params->max_safe_vel ||
-            old_vel_Y == NAN || old_vel_Z >= gran_params->max_safe_vel || old_vel_Z == NAN) {
-            ABORTABORTABORT("Unsafe velocity computed -- sphere is %u, vel is (%f, %f, %f)\n", mySphereID, old_vel_X,
-                            old_vel_Y, old_vel_Z);
-        }
-
-        float v_update_X = 0;
-        float v_update_Y = 0;
-        float v_update_Z = 0;
-
-        // no divergence, same for every thread in block
-        switch (gran_params->time_integrator) {
-            case GRAN_TIME_INTEGRATOR::CENTERED_DIFFERENCE:  // centered diff also computes velocity with the same
-                                                             // signature as Euler
-            case GRAN_TIME_INTEGRATOR::EXTENDED_TAYLOR:      // fall through to Euler for this one
-            case GRAN_TIME_INTEGRATOR::FORWARD_EULER: {
-                v_update_X = integrateForwardEuler(stepsize_SU, curr_acc_X);
-                v_update_Y = integrateForwardEuler(stepsize_SU, curr_acc_Y);
-                v_update_Z = integrateForwardEuler(stepsize_SU, curr_acc_Z);
+        integrateSphere(mySphereID, stepsize_SU, sphere_data, gran_params);
+    }
+}
 
-                break;
-            }
-            case GRAN_TIME_INTEGRATOR::CHUNG: {
-                v_update_X = integrateChung_vel(stepsize_SU, curr_acc_X, sphere_data->sphere_acc_X_old[mySphereID]);
-                v_update_Y = integrateChung_vel(stepsize_SU, curr_acc_Y, sphere_data->sphere_acc_Y_old[mySphereID]);
-                v_update_Z = integrateChung_vel(stepsize_SU, curr_acc_Z, sphere_data->sphere_acc_Z_old[mySphereID]);
+/// Integrate angular accelerations and reset friction data for a single sphere. ONLY use this with friction on
+/// Shared by the GPU kernel below and the CPU backend
+inline __host__ __device__ void updateSphereFrictionData(unsigned int mySphereID,
+                                                         const float stepsize_SU,
+                                                         GranSphereDataPtr sphere_data,
+                                                         GranParamsPtr gran_params) {
+    // if we're in multistep mode, clean up contact histories
+    cleanupContactMap(sphere_data, mySphereID, gran_params);
 
-                break;
-            }
+    // Write back velocity updates
+    float omega_update_X = 0;
+    float omega_update_Y = 0;
+    float omega_update_Z = 0;
+
+    // no divergence, same for every thread in block
+    switch (gran_params->time_integrator) {
+        case GRAN_TIME_INTEGRATOR::EXTENDED_TAYLOR:      // fall through to Euler for this one
+        case GRAN_TIME_INTEGRATOR::CENTERED_DIFFERENCE:  // both of these have the smae signature as forward Euler
+                                                         // vels
+        case GRAN_TIME_INTEGRATOR::FORWARD_EULER: {
+            // tau = I alpha => alpha = tau / I, we already computed these alphas
+            omega_update_X = integrateForwardEuler(stepsize_SU, sphere_data->sphere_ang_acc_X[mySphereID]);
+            omega_update_Y = integrateForwardEuler(stepsize_SU, sphere_data->sphere_ang_acc_Y[mySphereID]);
+            omega_update_Z = integrateForwardEuler(stepsize_SU, sphere_data->sphere_ang_acc_Z[mySphereID]);
+            break;
         }
-
-        // write back the velocity updates
-        sphere_data->pos_X_dt[mySphereID] += v_update_X;
-        sphere_data->pos_Y_dt[mySphereID] += v_update_Y;
-        sphere_data->pos_Z_dt[mySphereID] += v_update_Z;
-
-        float position_update_x = 0;
-        float position_update_y = 0;
-        float position_update_z = 0;
-        // no divergence, same for every thread in block
-        switch (gran_params->time_integrator) {
-            case GRAN_TIME_INTEGRATOR::EXTENDED_TAYLOR: {
-                position_update_x = integrateForwardEuler(stepsize_SU, old_vel_X + 0.5 * curr_acc_X * stepsize_SU);
-                position_update_y = integrateForwardEuler(stepsize_SU, old_vel_Y + 0.5 * curr_acc_Y * stepsize_SU);
-                position_update_z = integrateForwardEuler(stepsize_SU, old_vel_Z + 0.5 * curr_acc_Z * stepsize_SU);
-                break;
-            }
-
-            case GRAN_TIME_INTEGRATOR::FORWARD_EULER: {
-                position_update_x = integrateForwardEuler(stepsize_SU, old_vel_X);
-                position_update_y = integrateForwardEuler(stepsize_SU, old_vel_Y);
-                position_update_z = integrateForwardEuler(stepsize_SU, old_vel_Z);
-                break;
-            }
-            case GRAN_TIME_INTEGRATOR::CHUNG: {
-                position_update_x =
-                    integrateChung_pos(stepsize_SU, old_vel_X, curr_acc_X, sphere_data->sphere_acc_X_old[mySphereID]);
-                position_update_y =
-                    integrateChung_pos(stepsize_SU, old_vel_Y, curr_acc_Y, sphere_data->sphere_acc_Y_old[mySphereID]);
-                position_update_z =
-                    integrateChung_pos(stepsize_SU, old_vel_Z, curr_acc_Z, sphere_data->sphere_acc_Z_old[mySphereID]);
-                break;
-            }
-            case GRAN_TIME_INTEGRATOR::CENTERED_DIFFERENCE: {
-                position_update_x = integrateForwardEuler(stepsize_SU, old_vel_X + v_update_X);
-                position_update_y = integrateForwardEuler(stepsize_SU, old_vel_Y + v_update_Y);
-                position_update_z = integrateForwardEuler(stepsize_SU, old_vel_Z + v_update_Z);
-                break;
-            }
+        case GRAN_TIME_INTEGRATOR::CHUNG: {
+            omega_update_X = integrateChung_vel(stepsize_SU, sphere_data->sphere_ang_acc_X[mySphereID],
+                                                sphere_data->sphere_ang_acc_X_old[mySphereID]);
+            omega_update_Y = integrateChung_vel(stepsize_SU, sphere_data->sphere_ang_acc_Y[mySphereID],
+                                                sphere_data->sphere_ang_acc_Y_old[mySphereID]);
+            omega_update_Z = integrateChung_vel(stepsize_SU, sphere_data->sphere_ang_acc_Z[mySphereID],
+                                                sphere_data->sphere_ang_acc_Z_old[mySphereID]);
+            break;
         }
-
-        int3 sphere_pos_local =
-            make_int3(sphere_data->sphere_local_pos_X[mySphereID] + position_update_x,
-                      sphere_data->sphere_local_pos_Y[mySphereID] + position_update_y,
-                      sphere_data->sphere_local_pos_Z[mySphereID] + position_update_z);  // TODO Rounding occurs here
-
-        int64_t3 sphPos_global =
-            convertPosLocalToGlobal(sphere_data->sphere_owner_SDs[mySphereID], sphere_pos_local, gran_params);
-
-        findNewLocalCoords(sphere_data, mySphereID, sphPos_global.x, sphPos_global.y, sphPos_global.z, gran_params);
     }
+
+    sphere_data->sphere_Omega_X[mySphereID] += omega_update_X;
+    sphere_data->sphere_Omega_Y[mySphereID] += omega_update_Y;
+    sphere_data->sphere_Omega_Z[mySphereID] += omega_update_Z;
 }
 
 /**
@@ -1071,43 +1133,8 @@ static __global__ void updateFrictionData(const float stepsize_SU,
     // structure
     unsigned int mySphereID = threadIdx.x + blockIdx.x * blockDim.x;
 
-    // if we're in multistep mode, clean up contact histories
-    if (mySphereID < nSpheres) {
-        cleanupContactMap(sphere_data, mySphereID, gran_params);
-    }
-
-    // Write back velocity updates
     if (mySphereID < nSpheres) {
-        float omega_update_X = 0;
-        float omega_update_Y = 0;
-        float omega_update_Z = 0;
-
-        // no divergence, same for every thread in block
-        switch (gran_params->time_integrator) {
-            case GRAN_TIME_INTEGRATOR::EXTENDED_TAYLOR:      // fall through to Euler for this one
-            case GRAN_TIME_INTEGRATOR::CENTERED_DIFFERENCE:  // both of these have the smae signature as forward Euler
-                                                             // vels
-            case GRAN_TIME_INTEGRATOR::FORWARD_EULER: {
-                // tau = I alpha => alpha = tau / I, we already computed these alphas
-                omega_update_X = integrateForwardEuler(stepsize_SU, sphere_data->sphere_ang_acc_X[mySphereID]);
-                omega_update_Y = integrateForwardEuler(stepsize_SU, sphere_data->sphere_ang_acc_Y[mySphereID]);
-                omega_update_Z = integrateForwardEuler(stepsize_SU, sphere_data->sphere_ang_acc_Z[mySphereID]);
-                break;
-            }
-            case GRAN_TIME_INTEGRATOR::CHUNG: {
-                omega_update_X = integrateChung_vel(stepsize_SU, sphere_data->sphere_ang_acc_X[mySphereID],
-                                                    sphere_data->sphere_ang_acc_X_old[mySphereID]);
-                omega_update_Y = integrateChung_vel(stepsize_SU, sphere_data->sphere_ang_acc_Y[mySphereID],
-                                                    sphere_data->sphere_ang_acc_Y_old[mySphereID]);
-                omega_update_Z = integrateChung_vel(stepsize_SU, sphere_data->sphere_ang_acc_Z[mySphereID],
-                                                    sphere_data->sphere_ang_acc_Z_old[mySphereID]);
-                break;
-            }
-        }
-
-        sphere_data->sphere_Omega_X[mySphereID] += omega_update_X;
-        sphere_data->sphere_Omega_Y[mySphereID] += omega_update_Y;
-        sphere_data->sphere_Omega_Z[mySphereID] += omega_update_Z;
+        updateSphereFrictionData(mySphereID, stepsize_SU, sphere_data, gran_params);
     }
 }
 
@@ -25,22 +25,56 @@ using chrono::granular::GRAN_TIME_INTEGRATOR;
 using chrono::granular::GRAN_FRICTION_MODE;
 using chrono::granular::GRAN_ROLLING_MODE;
 
+#if !defined(__CUDA_ARCH__) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 // Print a user-given error message and crash
+#ifdef __CUDA_ARCH__
 #define ABORTABORTABORT(...) \
     {                        \
         printf(__VA_ARGS__); \
         __threadfence();     \
         cub::ThreadTrap();   \
     }
+#else
+#define ABORTABORTABORT(...) \
+    {                        \
+        printf(__VA_ARGS__); \
+        exit(1);             \
+    }
+#endif
 
 #define GRAN_DEBUG_PRINTF(...) printf(__VA_ARGS__)
 
+/// Atomically add to a float; the host version is used by the OpenMP backend
+inline __host__ __device__ void granAtomicAdd(float* address, float val) {
+#ifdef __CUDA_ARCH__
+    atomicAdd(address, val);
+#else
+#pragma omp atomic
+    *address += val;
+#endif
+}
+
+/// Atomic compare-and-swap, returns the old value; the host version is used by the OpenMP backend
+inline __host__ __device__ unsigned int granAtomicCAS(unsigned int* address, unsigned int compare, unsigned int val) {
+#if defined(__CUDA_ARCH__)
+    return atomicCAS(address, compare, val);
+#elif defined(_MSC_VER)
+    return (unsigned int)_InterlockedCompareExchange((volatile long*)address, (long)val, (long)compare);
+#else
+    __atomic_compare_exchange_n(address, &compare, val, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+    return compare;
+#endif
+}
+
 // Decide which SD owns this point in space
 // Pass it the Center of Mass location for a DE to get its owner, also used to get contact point
-inline __device__ int3 pointSDTriplet(int64_t sphCenter_X,
-                                      int64_t sphCenter_Y,
-                                      int64_t sphCenter_Z,
-                                      GranParamsPtr gran_params) {
+inline __host__ __device__ int3 pointSDTriplet(int64_t sphCenter_X,
+                                               int64_t sphCenter_Y,
+                                               int64_t sphCenter_Z,
+                                               GranParamsPtr gran_params) {
     // Note that this offset allows us to have moving walls and the like very easily
 
     int64_t sphCenter_X_modified = -gran_params->BD_frame_X + sphCenter_X;
@@ -59,17 +93,20 @@ inline __device__ int3 pointSDTriplet(int64_t sphCenter_X,
 
 // Decide which SD owns this point in space
 // Short form overload for regular ints
-inline __device__ int3 pointSDTriplet(int sphCenter_X, int sphCenter_Y, int sphCenter_Z, GranParamsPtr gran_params) {
+inline __host__ __device__ int3 pointSDTriplet(int sphCenter_X,
+                                               int sphCenter_Y,
+                                               int sphCenter_Z,
+                                               GranParamsPtr gran_params) {
     // call the 64-bit overload
     return pointSDTriplet((int64_t)sphCenter_X, (int64_t)sphCenter_Y, (int64_t)sphCenter_Z, gran_params);
 }
 
 // Decide which SD owns this point in space
 // overload for doubles (used in triangle code)
-inline __device__ int3 pointSDTriplet(double sphCenter_X,
-                                      double sphCenter_Y,
-                                      double sphCenter_Z,
-                                      GranParamsPtr gran_params) {
+inline __host__ __device__ int3 pointSDTriplet(double sphCenter_X,
+                                               double sphCenter_Y,
+                                               double sphCenter_Z,
+                                               GranParamsPtr gran_params) {
     // call the 64-bit overload
     return pointSDTriplet((int64_t)sphCenter_X, (int64_t)sphCenter_Y, (int64_t)sphCenter_Z, gran_params);
 }
@@ -98,7 +135,7 @@ inline __host__ __device__ int3 SDIDTriplet(unsigned int SD_ID, GranParamsPtr gr
 }
 
 // Convert triplet to single int SD ID
-inline __device__ unsigned int SDTripletID(const int i, const int j, const int k, GranParamsPtr gran_params) {
+inline __host__ __device__ unsigned int SDTripletID(const int i, const int j, const int k, GranParamsPtr gran_params) {
     // if we're outside the BD in any direction, this is an invalid SD
     if (i < 0 || i >= gran_params->nSDs_X) {
         return NULL_GRANULAR_ID;
@@ -113,20 +150,20 @@ inline __device__ unsigned int SDTripletID(const int i, const int j, const int k
 }
 
 // Convert triplet to single int SD ID
-inline __device__ unsigned int SDTripletID(const int3& trip, GranParamsPtr gran_params) {
+inline __host__ __device__ unsigned int SDTripletID(const int3& trip, GranParamsPtr gran_params) {
     return SDTripletID(trip.x, trip.y, trip.z, gran_params);
 }
 
 // Convert triplet to single int SD ID
-inline __device__ unsigned int SDTripletID(const int trip[3], GranParamsPtr gran_params) {
+inline __host__ __device__ unsigned int SDTripletID(const int trip[3], GranParamsPtr gran_params) {
     return SDTripletID(trip[0], trip[1], trip[2], gran_params);
 }
 
 /// get an index for the current contact pair
-inline __device__ size_t findContactPairInfo(GranSphereDataPtr sphere_data,
-                                             GranParamsPtr gran_params,
-                                             unsigned int body_A,
-                                             unsigned int body_B) {
+inline __host__ __device__ size_t findContactPairInfo(GranSphereDataPtr sphere_data,
+                                                      GranParamsPtr gran_params,
+                                                      unsigned int body_A,
+                                                      unsigned int body_B) {
     // TODO this should be size_t everywhere
     size_t body_A_offset = (size_t)MAX_SPHERES_TOUCHED_BY_SPHERE * body_A;
     // first skim through and see if this contact pair is in the map
@@ -147,7 +184,7 @@ inline __device__ size_t findContactPairInfo(GranSphereDataPtr sphere_data,
             // claim this slot for ourselves, atomically
             // if the CAS returns NULL_GRANULAR_ID, it means that the spot was free and we claimed it
             unsigned int body_B_returned =
-                atomicCAS(sphere_data->contact_partners_map + contact_index, NULL_GRANULAR_ID, body_B);
+                granAtomicCAS(sphere_data->contact_partners_map + contact_index, NULL_GRANULAR_ID, body_B);
             // did we get the spot? if so, claim it
             if (NULL_GRANULAR_ID == body_B_returned) {
                 // make sure this contact is marked active
@@ -164,9 +201,9 @@ inline __device__ size_t findContactPairInfo(GranSphereDataPtr sphere_data,
 }
 
 /// cleanup the contact data for a given body
-inline __device__ void cleanupContactMap(GranSphereDataPtr sphere_data,
-                                         unsigned int body_A,
-                                         GranParamsPtr gran_params) {
+inline __host__ __device__ void cleanupContactMap(GranSphereDataPtr sphere_data,
+                                                  unsigned int body_A,
+                                                  GranParamsPtr gran_params) {
     // index of the sphere into the big array
     size_t body_A_offset = (size_t)MAX_SPHERES_TOUCHED_BY_SPHERE * body_A;
 
@@ -194,7 +231,7 @@ inline __device__ void cleanupContactMap(GranSphereDataPtr sphere_data,
     }
 }
 
-inline __device__ bool checkLocalPointInSD(const int3& point, GranParamsPtr gran_params) {
+inline __host__ __device__ bool checkLocalPointInSD(const int3& point, GranParamsPtr gran_params) {
     // TODO verify that this is correct
     // TODO optimize me
     bool ret = (point.x >= 0) && (point.y >= 0) && (point.z >= 0);
@@ -203,10 +240,10 @@ inline __device__ bool checkLocalPointInSD(const int3& point, GranParamsPtr gran
     return ret;
 }
 /// in integer, check whether a pair of spheres is in contact
-inline __device__ bool checkSpheresContacting_int(const int3& sphereA_pos,
-                                                  const int3& sphereB_pos,
-                                                  unsigned int thisSD,
-                                                  GranParamsPtr gran_params) {
+inline __host__ __device__ bool checkSpheresContacting_int(const int3& sphereA_pos,
+                                                           const int3& sphereB_pos,
+                                                           unsigned int thisSD,
+                                                           GranParamsPtr gran_params) {
     // Compute penetration to check for collision, we can use ints provided the diameter is small enough
     int64_t penetration_int = 0;
 
@@ -236,16 +273,16 @@ inline __device__ bool checkSpheresContacting_int(const int3& sphereA_pos,
 }
 
 // NOTE: expects force_accum to be normal force only
-inline __device__ float3 computeRollingAngAcc(GranSphereDataPtr sphere_data,
-                                              GranParamsPtr gran_params,
-                                              float rolling_coeff,
-                                              float spinning_coeff,
-                                              const float3& normal_force,
-                                              const float3& my_omega,
-                                              const float3& their_omega,
-                                              // TODO check to make sure r_contact is what is passed everywhere
-                                              // vec from my center to center of contact
-                                              const float3& r_contact) {
+inline __host__ __device__ float3 computeRollingAngAcc(GranSphereDataPtr sphere_data,
+                                                       GranParamsPtr gran_params,
+                                                       float rolling_coeff,
+                                                       float spinning_coeff,
+                                                       const float3& normal_force,
+                                                       const float3& my_omega,
+                                                       const float3& their_omega,
+                                                       // TODO check to make sure r_contact is what is passed everywhere
+                                                       // vec from my center to center of contact
+                                                       const float3& r_contact) {
     float3 delta_Ang_Acc = {0., 0., 0.};
 
     if (gran_params->friction_mode != GRAN_FRICTION_MODE::FRICTIONLESS &&
@@ -281,21 +318,21 @@ inline __device__ float3 computeRollingAngAcc(GranSphereDataPtr sphere_data,
 
 /// Compute single-step friction displacement
 /// set delta_t for the displacement
-inline __device__ void computeSingleStepDisplacement(GranParamsPtr gran_params,
-                                                     const float3& rel_vel,
-                                                     float3& delta_t) {
+inline __host__ __device__ void computeSingleStepDisplacement(GranParamsPtr gran_params,
+                                                              const float3& rel_vel,
+                                                              float3& delta_t) {
     delta_t = rel_vel * gran_params->stepSize_SU;
     float ut = Length(delta_t);
 }
 
 /// Compute multi-step friction displacement
 /// set delta_t for the displacement
-inline __device__ void computeMultiStepDisplacement(GranParamsPtr gran_params,
-                                                    GranSphereDataPtr sphere_data,
-                                                    const size_t& contact_id,
-                                                    const float3& vrel_t,
-                                                    const float3& contact_normal,
-                                                    float3& delta_t) {
+inline __host__ __device__ void computeMultiStepDisplacement(GranParamsPtr gran_params,
+                                                             GranSphereDataPtr sphere_data,
+                                                             const size_t& contact_id,
+                                                             const float3& vrel_t,
+                                                             const float3& contact_normal,
+                                                             float3& delta_t) {
     // get the tangential displacement so far
     delta_t = sphere_data->contact_history_map[contact_id];
     // add on what we have for this step
@@ -310,15 +347,15 @@ inline __device__ void computeMultiStepDisplacement(GranParamsPtr gran_params,
     sphere_data->contact_history_map[contact_id] = delta_t;
 }
 
-inline __device__ void updateMultiStepDisplacement(GranSphereDataPtr sphere_data,
-                                                   const size_t& contact_index,
-                                                   const float3& vrel_t,
-                                                   const float3& contact_normal,
-                                                   const float k_t,
-                                                   const float gamma_t,
-                                                   const float m_eff,
-                                                   const float force_model_multiplier,
-                                                   const float3& tangent_force) {
+inline __host__ __device__ void updateMultiStepDisplacement(GranSphereDataPtr sphere_data,
+                                                            const size_t& contact_index,
+                                                            const float3& vrel_t,
+                                                            const float3& contact_normal,
+                                                            const float k_t,
+                                                            const float gamma_t,
+                                                            const float m_eff,
+                                                            const float force_model_multiplier,
+                                                            const float3& tangent_force) {
     // Reverse engineer the delta_t from the clamped force and update the map
     sphere_data->contact_history_map[contact_index] =
         ((tangent_force / force_model_multiplier) + gamma_t * m_eff * vrel_t) / -k_t;
@@ -326,17 +363,17 @@ inline __device__ void updateMultiStepDisplacement(GranSphereDataPtr sphere_data
 
 /// compute friction forces for a contact
 /// returns tangent force including hertz factor, clamped and all
-inline __device__ float3 computeFrictionForces(GranParamsPtr gran_params,
-                                               GranSphereDataPtr sphere_data,
-                                               size_t contact_index,
-                                               float static_friction_coeff,
-                                               float k_t,
-                                               float gamma_t,
-                                               float force_model_multiplier,
-                                               float m_eff,
-                                               const float3& normal_force,
-                                               const float3& vrel_t,
-                                               const float3& contact_normal) {
+inline __host__ __device__ float3 computeFrictionForces(GranParamsPtr gran_params,
+                                                        GranSphereDataPtr sphere_data,
+                                                        size_t contact_index,
+                                                        float static_friction_coeff,
+                                                        float k_t,
+                                                        float gamma_t,
+                                                        float force_model_multiplier,
+                                                        float m_eff,
+                                                        const float3& normal_force,
+                                                        const float3& vrel_t,
+                                                        const float3& contact_normal) {
     float3 delta_t = {0.f, 0.f, 0.f};
 
     if (gran_params->friction_mode == GRAN_FRICTION_MODE::SINGLE_STEP) {
@@ -371,18 +408,18 @@ inline __device__ float3 computeFrictionForces(GranParamsPtr gran_params,
 }
 
 // overload for if the body ids are given rather than contact id
-inline __device__ float3 computeFrictionForces(GranParamsPtr gran_params,
-                                               GranSphereDataPtr sphere_data,
-                                               unsigned int body_A_index,
-                                               unsigned int body_B_index,
-                                               float static_friction_coeff,
-                                               float k_t,
-                                               float gamma_t,
-                                               float force_model_multiplier,
-                                               float m_eff,
-                                               const float3& normal_force,
-                                               const float3& rel_vel,
-                                               const float3& contact_normal) {
+inline __host__ __device__ float3 computeFrictionForces(GranParamsPtr gran_params,
+                                                        GranSphereDataPtr sphere_data,
+                                                        unsigned int body_A_index,
+                                                        unsigned int body_B_index,
+                                                        float static_friction_coeff,
+                                                        float k_t,
+                                                        float gamma_t,
+                                                        float force_model_multiplier,
+                                                        float m_eff,
+                                                        const float3& normal_force,
+                                                        const float3& rel_vel,
+                                                        const float3& contact_normal) {
     size_t contact_id = 0;
 
     // if multistep, compute contact id, otherwise we don't care anyways
@@ -32,7 +32,7 @@ namespace chrono {
 namespace granular {
 
 ChSystemGranularSMC_trimesh::ChSystemGranularSMC_trimesh(float sphere_rad, float density, float3 boxDims)
-    : ChSystemGranularSMC(sphere_rad, density, boxDims),
+    : ChSystemGranularSMC(sphere_rad, density, boxDims, GRAN_EXECUTION_BACKEND::GPU),
       K_n_s2m_UU(0),
       K_t_s2m_UU(0),
       Gamma_n_s2m_UU(0),
@@ -108,6 +108,8 @@ class CH_GRANULAR_API ChSystemGranularSMC_trimesh : public ChSystemGranularSMC {
   public:
     // we do not want the system to be default-constructible
     ChSystemGranularSMC_trimesh() = delete;
+    /// Construct the system. The mesh-sphere interaction only has GPU kernels, so this system always uses the GPU
+    /// execution backend.
     ChSystemGranularSMC_trimesh(float sphere_rad, float density, float3 boxDims);
     virtual ~ChSystemGranularSMC_trimesh();
 
@@ -198,9 +198,6 @@ typedef blaze::Subvector<const DynamicVector<real>> ConstSubVectorType;
 //// Viscosity
 //#define _GAMMAFFV_ submatrix(_gamma_,  _num_uni_ + _num_bil_ + 3 * _num_rf_c_ + _num_fluid_,  3 * _num_fluid_)
 
-// The maximum number of shear history contacts per smaller body (SMC)
-#define max_shear 20
-
 /// @addtogroup parallel_module
 /// @{
 
@@ -294,10 +291,15 @@ struct host_container {
     custom_vector<real3> ct_body_torque;  ///< Total contact torque on these bodies
 
     // Contact shear history (SMC)
-    custom_vector<vec3> shear_neigh;          ///< Neighbor list of contacting bodies and shapes
-    custom_vector<real3> shear_disp;          ///< Accumulated shear displacement for each neighbor
-    custom_vector<real> contact_relvel_init;  ///< Initial relative normal velocity manitude per contact pair
-    custom_vector<real> contact_duration;     ///< Accumulated contact duration, per contact pair
+    // History information is stored per contact (as of the last step) and is located through an open-addressing
+    // hash table keyed by the global IDs of the two shapes in contact (which also identify the two bodies).
+    // Contacts between the same two shapes share a key and are told apart by their contact points.
+    custom_vector<long long> shear_keys;      ///< Key (encoded shape pair) of each contact, -1 if no history kept
+    custom_vector<real3> shear_points;        ///< Contact point, in the frame of the body with larger index
+    custom_vector<real3> shear_disp;          ///< Accumulated shear displacement, per contact
+    custom_vector<real> contact_relvel_init;  ///< Initial relative normal velocity manitude, per contact
+    custom_vector<real> contact_duration;     ///< Accumulated contact duration, per contact
+    custom_vector<int> shear_table;           ///< Hash table (linear probing) of contact indices, -1 for empty slots
 
     /// Mapping from all bodies in the system to bodies involved in a contact.
     /// For bodies that are currently not in contact, the mapping entry is -1.
@@ -408,6 +410,21 @@ struct host_container {
     custom_vector<uint> bin_aabb_number;
     custom_vector<uint> bin_start_index;
     custom_vector<uint> bin_num_contact;
+
+    // Static/dynamic split broadphase (see collision_settings::use_static_split)
+    custom_vector<char> shape_static;            ///< shape class (0: active, 1: fixed or sleeping, 2: not colliding)
+    custom_vector<uint> bin_num_static;          ///< number of dynamic-static pairs in each active bin
+    custom_vector<uint> static_bin_number;       ///< sorted list of bins intersected by static shapes
+    custom_vector<uint> static_bin_aabb_number;  ///< static shapes, sorted by bin
+    custom_vector<uint> static_bin_start_index;  ///< start of each static bin in static_bin_aabb_number
+
+    // Hierarchical grid broadphase (see collision_settings::broadphase_algorithm).
+    // The shapes sorted by cell and the cell start indices are stored in bin_aabb_number and bin_start_index.
+    custom_vector<uint> hgrid_shape_level;                    ///< grid level of each shape (UINT_MAX if excluded)
+    custom_vector<real> hgrid_inv_cell_size;                  ///< inverse cell size of each grid level
+    custom_vector<uint> hgrid_level_start;                    ///< start of each grid level in hgrid_cell_number_out
+    custom_vector<unsigned long long> hgrid_cell_number;      ///< keys of the cells intersected by the shapes
+    custom_vector<unsigned long long> hgrid_cell_number_out;  ///< sorted keys of the non-empty cells
 };
 
 /// Global data manager for Chrono::Parallel.
@@ -45,6 +45,7 @@ class collision_measures {
         number_of_contacts_possible = 0;
         number_of_bins_active = 0;
         number_of_bin_intersections = 0;
+        number_of_grid_levels = 0;
 
         rigid_min_bounding_point = real3(0);
         rigid_max_bounding_point = real3(0);
@@ -69,6 +70,7 @@ class collision_measures {
     uint number_of_bins_active;        ///< Number of active bins (containing 1+ AABBs)
     uint number_of_bin_intersections;  ///< Number of AABB bin intersections
     uint number_of_contacts_possible;  ///< Number of contacts possible from broadphase
+    uint number_of_grid_levels;        ///< Number of levels of the hierarchical grid
 
     real3 rigid_min_bounding_point;
     real3 rigid_max_bounding_point;
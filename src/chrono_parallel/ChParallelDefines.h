@@ -137,6 +137,12 @@ enum class NarrowPhaseType {
     NARROWPHASE_HYBRID_MPR  ///< analytical method with fallback on MPR
 };
 
+/// Enumeration of broad-phase collision methods.
+enum class BroadphaseType {
+    BROADPHASE_ONE_LEVEL,    ///< uniform grid
+    BROADPHASE_HIERARCHICAL  ///< hierarchical grid, with one level per size class of the shapes
+};
+
 /// Enumeration for system type.
 /// Used so that parts of the code that have been "flattened" can know what type of system is used.
 enum class SystemType {
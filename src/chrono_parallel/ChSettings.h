@@ -53,8 +53,11 @@ class collision_settings {
         // many cores you are using.
         bins_per_axis = vec3(20, 20, 20);
         narrowphase_algorithm = NarrowPhaseType::NARROWPHASE_HYBRID_MPR;
+        broadphase_algorithm = BroadphaseType::BROADPHASE_ONE_LEVEL;
+        hgrid_level_ratio = 2;
         grid_density = 5;
         fixed_bins = true;
+        use_static_split = false;
     }
 
     real3 min_bounding_point, max_bounding_point;
@@ -82,9 +85,21 @@ class collision_settings {
     /// detection code. The narrowphase_algorithm parameter can be used to change
     /// the type of narrowphase used at runtime.
     NarrowPhaseType narrowphase_algorithm;
+    /// Broadphase algorithm. The uniform grid is the fastest choice for shapes of similar size. For polydisperse
+    /// systems, the hierarchical grid bins each shape in a grid level matching its size, so that the number of
+    /// pair tests does not depend on the size ratio between the largest and the smallest shapes.
+    /// The hierarchical grid is not used if the system contains 3-DOF or FEA nodes.
+    BroadphaseType broadphase_algorithm;
+    /// Ratio between the cell sizes of two consecutive levels of the hierarchical grid (must be larger than 1).
+    real hgrid_level_ratio;
     real grid_density;
     /// Use fixed number of bins instead of tuning them.
     bool fixed_bins;
+    /// Split the broadphase into static and dynamic shapes. Shapes of fixed or sleeping bodies are binned once and
+    /// kept until they move or change state; each step only the shapes of active bodies are binned and tested against
+    /// each other and against the static bins. The grid is kept as long as it contains all the shapes.
+    /// Ignored if the system contains 3-DOF or FEA nodes.
+    bool use_static_split;
 };
 
 /// Chrono::Parallel solver_settings.
@@ -128,6 +143,8 @@ class solver_settings {
         max_power_iteration = 15;
         power_iter_tolerance = 0.1;
         skip_residual = 1;
+        use_mixed_precision = false;
+        max_iteration_refinement = 0;
     }
 
     /// The solver type variable defines name of the solver that will be used to
@@ -216,6 +233,13 @@ class solver_settings {
     real tolerance_objective;
     /// Compute residual every x iterations.
     int skip_residual;
+
+    /// Perform the Shur products of the NSC solver in single precision (positions, velocities and the solver
+    /// iterates remain in double precision). Only meaningful if Chrono::Parallel is built in double precision.
+    bool use_mixed_precision;
+    /// With mixed precision, number of double precision iterations performed at the end of each solve, starting
+    /// from the single precision solution.
+    uint max_iteration_refinement;
 };
 
 /// Aggregate of all settings for Chrono::Parallel.
@@ -181,6 +181,25 @@ void ChCBroadphase::DetermineBoundingBox() {
     min_point = min_point - fraction * size;
     max_point = max_point + fraction * size;
 
+    // With the static/dynamic split, keep the current grid as long as it contains everything, so that the bins of the
+    // static shapes remain valid. When the grid must grow, add some slack to avoid rebuilding them at every step.
+    if (data_manager->settings.collision.use_static_split) {
+        if (grid_set && grid_min.x <= min_point.x && grid_min.y <= min_point.y && grid_min.z <= min_point.z &&
+            max_point.x <= grid_max.x && max_point.y <= grid_max.y && max_point.z <= grid_max.z) {
+            min_point = grid_min;
+            max_point = grid_max;
+        } else {
+            real slack = 0.1;
+            min_point = min_point - slack * size;
+            max_point = max_point + slack * size;
+            grid_min = min_point;
+            grid_max = max_point;
+            grid_set = true;
+        }
+    } else {
+        grid_set = false;
+    }
+
     data_manager->measures.collision.min_bounding_point = min_point;
     data_manager->measures.collision.max_bounding_point = max_point;
     data_manager->measures.collision.global_origin = min_point;
@@ -234,13 +253,27 @@ void ChCBroadphase::ComputeTopLevelResolution() {
 // =========================================================================================================
 ChCBroadphase::ChCBroadphase() {
     data_manager = 0;
+    grid_set = false;
+    grid_min = real3(0);
+    grid_max = real3(0);
+    static_origin = real3(0);
+    static_bin_size = real3(0);
+    static_bins_per_axis = vec3(0);
+    num_static_bins = 0;
 }
 // =========================================================================================================
 // use spatial subdivision to detect the list of POSSIBLE collisions
 // let user define their own narrow-phase collision detection
 void ChCBroadphase::DispatchRigid() {
     if (data_manager->num_rigid_shapes != 0) {
-        OneLevelBroadphase();
+        // The narrowphase of 3-DOF and FEA nodes against rigid shapes requires all rigid shapes in the bins
+        bool nodes = data_manager->num_fluid_bodies != 0 || data_manager->num_fea_nodes != 0;
+        if (data_manager->settings.collision.broadphase_algorithm == BroadphaseType::BROADPHASE_HIERARCHICAL && !nodes)
+            HierarchicalBroadphase();
+        else if (data_manager->settings.collision.use_static_split && !nodes)
+            SplitBroadphase();
+        else
+            OneLevelBroadphase();
         data_manager->num_rigid_contacts = data_manager->measures.collision.number_of_contacts_possible;
     }
     return;
@@ -341,5 +374,338 @@ void ChCBroadphase::OneLevelBroadphase() {
     LOG(TRACE) << "Number of unique collisions: " << number_of_contacts_possible;
 }
 
+// =========================================================================================================
+// Static/dynamic split broadphase
+
+bool ChCBroadphase::UpdateStaticShapes() {
+    const custom_vector<real3>& aabb_min = data_manager->host_data.aabb_min;
+    const custom_vector<real3>& aabb_max = data_manager->host_data.aabb_max;
+    const custom_vector<char>& obj_active = data_manager->host_data.active_rigid;
+    const custom_vector<char>& obj_collide = data_manager->host_data.collide_rigid;
+    const custom_vector<uint>& obj_data_id = data_manager->shape_data.id_rigid;
+    custom_vector<char>& shape_static = data_manager->host_data.shape_static;
+
+    const int num_shapes = data_manager->num_rigid_shapes;
+    const vec3& bins_per_axis = data_manager->settings.collision.bins_per_axis;
+    const real3& bin_size = data_manager->measures.collision.bin_size;
+    const real3& global_origin = data_manager->measures.collision.global_origin;
+
+    // A different grid invalidates all static bins
+    bool changed = !(global_origin == static_origin) || !(bin_size == static_bin_size) ||
+                   bins_per_axis.x != static_bins_per_axis.x || bins_per_axis.y != static_bins_per_axis.y ||
+                   bins_per_axis.z != static_bins_per_axis.z;
+    static_origin = global_origin;
+    static_bin_size = bin_size;
+    static_bins_per_axis = bins_per_axis;
+
+    if (static_flag.size() != (size_t)num_shapes) {
+        static_flag.assign(num_shapes, 2);
+        static_aabb_min.resize(num_shapes);
+        static_aabb_max.resize(num_shapes);
+        changed = true;
+    }
+    shape_static.resize(num_shapes);
+
+    // Classify the shapes (0: active body, 1: fixed or sleeping body, 2: not colliding) and look for shapes which
+    // changed class, or static shapes which moved, since the last rebuild of the static bins.
+    int num_changed = 0;
+#pragma omp parallel for reduction(+ : num_changed)
+    for (int i = 0; i < num_shapes; i++) {
+        uint body = obj_data_id[i];
+        char flag = 2;
+        if (body != UINT_MAX && obj_collide[body] != 0)
+            flag = obj_active[body] != 0 ? 0 : 1;
+        shape_static[i] = flag;
+        if (flag != static_flag[i] ||
+            (flag == 1 && (!(aabb_min[i] == static_aabb_min[i]) || !(aabb_max[i] == static_aabb_max[i])))) {
+            static_flag[i] = flag;
+            static_aabb_min[i] = aabb_min[i];
+            static_aabb_max[i] = aabb_max[i];
+            num_changed++;
+        }
+    }
+
+    return changed || num_changed > 0;
+}
+
+uint ChCBroadphase::BinShapes(char select,
+                              custom_vector<uint>& bin_number,
+                              custom_vector<uint>& bin_number_out,
+                              custom_vector<uint>& bin_aabb_number,
+                              custom_vector<uint>& bin_start_index) {
+    const custom_vector<real3>& aabb_min = data_manager->host_data.aabb_min;
+    const custom_vector<real3>& aabb_max = data_manager->host_data.aabb_max;
+    const custom_vector<char>& shape_static = data_manager->host_data.shape_static;
+    custom_vector<uint>& bin_intersections = data_manager->host_data.bin_intersections;
+
+    const vec3& bins_per_axis = data_manager->settings.collision.bins_per_axis;
+    const real3& inv_bin_size = data_manager->measures.collision.inv_bin_size;
+    const int num_shapes = data_manager->num_rigid_shapes;
+
+    bin_intersections.resize(num_shapes + 1);
+    bin_intersections[num_shapes] = 0;
+
+#pragma omp parallel for
+    for (int i = 0; i < num_shapes; i++) {
+        if (shape_static[i] != select) {
+            bin_intersections[i] = 0;
+            continue;
+        }
+        f_Count_AABB_BIN_Intersection(i, inv_bin_size, aabb_min, aabb_max, bin_intersections);
+    }
+
+    Thrust_Exclusive_Scan(bin_intersections);
+    uint num_intersections = bin_intersections.back();
+
+    bin_number.resize(num_intersections);
+    bin_number_out.resize(num_intersections);
+    bin_aabb_number.resize(num_intersections);
+    bin_start_index.resize(num_intersections);
+
+#pragma omp parallel for
+    for (int i = 0; i < num_shapes; i++) {
+        if (shape_static[i] != select)
+            continue;
+        f_Store_AABB_BIN_Intersection(i, bins_per_axis, inv_bin_size, aabb_min, aabb_max, bin_intersections, bin_number,
+                                      bin_aabb_number);
+    }
+
+    Thrust_Sort_By_Key(bin_number, bin_aabb_number);
+    uint num_bins = (uint)(Run_Length_Encode(bin_number, bin_number_out, bin_start_index));
+
+    bin_start_index.resize(num_bins + 1);
+    bin_start_index[num_bins] = 0;
+    Thrust_Exclusive_Scan(bin_start_index);
+
+    return num_bins;
+}
+
+void ChCBroadphase::SplitBroadphase() {
+    LOG(TRACE) << "ChCBroadphase::SplitBroadphase()";
+    const custom_vector<real3>& aabb_min = data_manager->host_data.aabb_min;
+    const custom_vector<real3>& aabb_max = data_manager->host_data.aabb_max;
+    const custom_vector<short2>& fam_data = data_manager->shape_data.fam_rigid;
+    const custom_vector<char>& obj_active = data_manager->host_data.active_rigid;
+    const custom_vector<char>& obj_collide = data_manager->host_data.collide_rigid;
+    const custom_vector<uint>& obj_data_id = data_manager->shape_data.id_rigid;
+    custom_vector<long long>& contact_pairs = data_manager->host_data.contact_pairs;
+
+    custom_vector<uint>& bin_number = data_manager->host_data.bin_number;
+    custom_vector<uint>& bin_number_out = data_manager->host_data.bin_number_out;
+    custom_vector<uint>& bin_aabb_number = data_manager->host_data.bin_aabb_number;
+    custom_vector<uint>& bin_start_index = data_manager->host_data.bin_start_index;
+    custom_vector<uint>& bin_num_contact = data_manager->host_data.bin_num_contact;
+    custom_vector<uint>& bin_num_static = data_manager->host_data.bin_num_static;
+
+    custom_vector<uint>& static_bin_number = data_manager->host_data.static_bin_number;
+    custom_vector<uint>& static_bin_aabb_number = data_manager->host_data.static_bin_aabb_number;
+    custom_vector<uint>& static_bin_start_index = data_manager->host_data.static_bin_start_index;
+
+    vec3& bins_per_axis = data_manager->settings.collision.bins_per_axis;
+    real3& inv_bin_size = data_manager->measures.collision.inv_bin_size;
+    uint& number_of_bins_active = data_manager->measures.collision.number_of_bins_active;
+    uint& number_of_bin_intersections = data_manager->measures.collision.number_of_bin_intersections;
+    uint& number_of_contacts_possible = data_manager->measures.collision.number_of_contacts_possible;
+
+    // Bin the static shapes, only if they changed since the last step.
+    // Note that the full list of static bin numbers is not needed, so bin_number is used as scratch space.
+    if (UpdateStaticShapes()) {
+        num_static_bins = BinShapes(1, bin_number, static_bin_number, static_bin_aabb_number, static_bin_start_index);
+        LOG(TRACE) << "Number of static bins (rebuilt): " << num_static_bins;
+    }
+
+    // Bin the dynamic shapes
+    number_of_bins_active = BinShapes(0, bin_number, bin_number_out, bin_aabb_number, bin_start_index);
+    number_of_bin_intersections = data_manager->host_data.bin_intersections.back();
+
+    LOG(TRACE) << "Number of bin intersections: " << number_of_bin_intersections;
+    LOG(TRACE) << "Number of bins active: " << number_of_bins_active;
+
+    if (number_of_bins_active <= 0) {
+        number_of_contacts_possible = 0;
+        return;
+    }
+
+    bin_num_contact.resize(number_of_bins_active + 1);
+    bin_num_contact[number_of_bins_active] = 0;
+    bin_num_static.resize(number_of_bins_active);
+
+    // Count the dynamic-dynamic and dynamic-static pairs in each dynamic bin
+#pragma omp parallel for
+    for (int i = 0; i < (signed)number_of_bins_active; i++) {
+        f_Count_AABB_AABB_Intersection(i, inv_bin_size, bins_per_axis, aabb_min, aabb_max, bin_number_out,
+                                       bin_aabb_number, bin_start_index, fam_data, obj_active, obj_collide, obj_data_id,
+                                       bin_num_contact);
+        f_Count_AABB_Static_Intersection(i, inv_bin_size, bins_per_axis, aabb_min, aabb_max, bin_number_out,
+                                         bin_aabb_number, bin_start_index, num_static_bins, static_bin_number,
+                                         static_bin_aabb_number, static_bin_start_index, fam_data, bin_num_static);
+        bin_num_contact[i] += bin_num_static[i];
+    }
+
+    thrust::exclusive_scan(bin_num_contact.begin(), bin_num_contact.end(), bin_num_contact.begin());
+    number_of_contacts_possible = bin_num_contact.back();
+    contact_pairs.resize(number_of_contacts_possible);
+    LOG(TRACE) << "Number of possible collisions: " << number_of_contacts_possible;
+
+    // Store the pairs; in each bin, the dynamic-static pairs follow the dynamic-dynamic ones
+#pragma omp parallel for
+    for (int index = 0; index < (signed)number_of_bins_active; index++) {
+        f_Store_AABB_AABB_Intersection(index, inv_bin_size, bins_per_axis, aabb_min, aabb_max, bin_number_out,
+                                       bin_aabb_number, bin_start_index, bin_num_contact, fam_data, obj_active,
+                                       obj_collide, obj_data_id, contact_pairs);
+        f_Store_AABB_Static_Intersection(index, inv_bin_size, bins_per_axis, aabb_min, aabb_max, bin_number_out,
+                                         bin_aabb_number, bin_start_index, num_static_bins, static_bin_number,
+                                         static_bin_aabb_number, static_bin_start_index, fam_data,
+                                         bin_num_contact[index + 1] - bin_num_static[index], contact_pairs);
+    }
+}
+
+// =========================================================================================================
+// Hierarchical grid broadphase
+
+void ChCBroadphase::HierarchicalBroadphase() {
+    LOG(TRACE) << "ChCBroadphase::HierarchicalBroadphase()";
+    const custom_vector<real3>& aabb_min = data_manager->host_data.aabb_min;
+    const custom_vector<real3>& aabb_max = data_manager->host_data.aabb_max;
+    const custom_vector<short2>& fam_data = data_manager->shape_data.fam_rigid;
+    const custom_vector<char>& obj_active = data_manager->host_data.active_rigid;
+    const custom_vector<char>& obj_collide = data_manager->host_data.collide_rigid;
+    const custom_vector<uint>& obj_data_id = data_manager->shape_data.id_rigid;
+    custom_vector<long long>& contact_pairs = data_manager->host_data.contact_pairs;
+
+    custom_vector<uint>& bin_intersections = data_manager->host_data.bin_intersections;
+    custom_vector<uint>& bin_aabb_number = data_manager->host_data.bin_aabb_number;
+    custom_vector<uint>& bin_start_index = data_manager->host_data.bin_start_index;
+    custom_vector<uint>& bin_num_contact = data_manager->host_data.bin_num_contact;
+
+    custom_vector<uint>& shape_level = data_manager->host_data.hgrid_shape_level;
+    custom_vector<real>& inv_cell_size = data_manager->host_data.hgrid_inv_cell_size;
+    custom_vector<uint>& level_start = data_manager->host_data.hgrid_level_start;
+    custom_vector<unsigned long long>& cell_number = data_manager->host_data.hgrid_cell_number;
+    custom_vector<unsigned long long>& cell_number_out = data_manager->host_data.hgrid_cell_number_out;
+
+    const int num_shapes = data_manager->num_rigid_shapes;
+    const real ratio = Max(data_manager->settings.collision.hgrid_level_ratio, real(1.1));
+    const real3& max_bounding_point = data_manager->measures.collision.max_bounding_point;
+    const real3& global_origin = data_manager->measures.collision.global_origin;
+
+    uint& number_of_grid_levels = data_manager->measures.collision.number_of_grid_levels;
+    uint& number_of_bins_active = data_manager->measures.collision.number_of_bins_active;
+    uint& number_of_bin_intersections = data_manager->measures.collision.number_of_bin_intersections;
+    uint& number_of_contacts_possible = data_manager->measures.collision.number_of_contacts_possible;
+
+    // Find the range of shape sizes (largest AABB extent), excluding inactive shapes and shapes of non-colliding
+    // bodies. The smallest non-zero size sets the cell size of the finest level, but the number of cells along each
+    // axis must fit in a cell key, and the largest shapes must fit in the coarsest level.
+    real min_size = C_LARGE_REAL;
+    real max_size = 0;
+    for (int i = 0; i < num_shapes; i++) {
+        uint body = obj_data_id[i];
+        if (body == UINT_MAX || obj_collide[body] == 0)
+            continue;
+        real size = Max(aabb_max[i] - aabb_min[i]);
+        if (size > 0)
+            min_size = Min(min_size, size);
+        max_size = Max(max_size, size);
+    }
+    real base_size = Max(Max(Abs(max_bounding_point - global_origin)) / HGRID_MAX_CELL, C_EPSILON);
+    if (min_size < C_LARGE_REAL)
+        base_size = Max(base_size, min_size);
+    base_size = Max(base_size, max_size / Pow(ratio, real(HGRID_MAX_LEVELS - 1)));
+    const real inv_log_ratio = 1 / Log(ratio);
+
+    // Level l has cells of size base_size * ratio^l, and contains the shapes larger than the cells of level l-1
+    number_of_grid_levels = 1;
+    if (max_size > base_size)
+        number_of_grid_levels = (uint)Ceil(Log(max_size / base_size) * inv_log_ratio) + 1;
+    number_of_grid_levels = std::min(number_of_grid_levels, (uint)HGRID_MAX_LEVELS);
+    inv_cell_size.resize(number_of_grid_levels);
+    for (uint l = 0; l < number_of_grid_levels; l++)
+        inv_cell_size[l] = 1 / (base_size * Pow(ratio, real(l)));
+
+    LOG(TRACE) << "Number of grid levels: " << number_of_grid_levels << " finest cell size: " << base_size;
+
+    shape_level.resize(num_shapes);
+    bin_intersections.resize(num_shapes + 1);
+    bin_intersections[num_shapes] = 0;
+
+#pragma omp parallel for
+    for (int i = 0; i < num_shapes; i++) {
+        uint body = obj_data_id[i];
+        if (body == UINT_MAX || obj_collide[body] == 0) {
+            shape_level[i] = UINT_MAX;
+        } else {
+            real size = Max(aabb_max[i] - aabb_min[i]);
+            uint level = 0;
+            if (size > base_size)
+                level = std::min((uint)Ceil(Log(size / base_size) * inv_log_ratio), number_of_grid_levels - 1);
+            shape_level[i] = level;
+        }
+        f_HG_Count_AABB_Cell_Intersection(i, aabb_min, aabb_max, shape_level, inv_cell_size, bin_intersections);
+    }
+
+    Thrust_Exclusive_Scan(bin_intersections);
+    number_of_bin_intersections = bin_intersections.back();
+
+    LOG(TRACE) << "Number of bin intersections: " << number_of_bin_intersections;
+
+    cell_number.resize(number_of_bin_intersections);
+    cell_number_out.resize(number_of_bin_intersections);
+    bin_aabb_number.resize(number_of_bin_intersections);
+    bin_start_index.resize(number_of_bin_intersections);
+
+#pragma omp parallel for
+    for (int i = 0; i < num_shapes; i++) {
+        f_HG_Store_AABB_Cell_Intersection(i, aabb_min, aabb_max, shape_level, inv_cell_size, bin_intersections,
+                                          cell_number, bin_aabb_number);
+    }
+
+    Thrust_Sort_By_Key(cell_number, bin_aabb_number);
+    number_of_bins_active = (uint)(Run_Length_Encode(cell_number, cell_number_out, bin_start_index));
+
+    if (number_of_bins_active <= 0) {
+        number_of_contacts_possible = 0;
+        return;
+    }
+
+    bin_start_index.resize(number_of_bins_active + 1);
+    bin_start_index[number_of_bins_active] = 0;
+    Thrust_Exclusive_Scan(bin_start_index);
+
+    LOG(TRACE) << "Number of bins active: " << number_of_bins_active;
+
+    // Since cell keys are ordered by level, the non-empty cells of each level form a contiguous range
+    level_start.resize(number_of_grid_levels + 1);
+    for (uint l = 0; l < number_of_grid_levels; l++) {
+        auto first = cell_number_out.begin();
+        auto last = first + number_of_bins_active;
+        level_start[l] = (uint)(std::lower_bound(first, last, HGrid_Key(l, vec3(0))) - first);
+    }
+    level_start[number_of_grid_levels] = number_of_bins_active;
+
+    // Count and store the potential contacts of each shape
+    bin_num_contact.resize(num_shapes + 1);
+    bin_num_contact[num_shapes] = 0;
+
+#pragma omp parallel for
+    for (int i = 0; i < num_shapes; i++) {
+        f_HG_Count_AABB_AABB_Intersection(i, number_of_grid_levels, aabb_min, aabb_max, shape_level, inv_cell_size,
+                                          level_start, cell_number_out, bin_aabb_number, bin_start_index, fam_data,
+                                          obj_active, obj_data_id, bin_num_contact);
+    }
+
+    thrust::exclusive_scan(bin_num_contact.begin(), bin_num_contact.end(), bin_num_contact.begin());
+    number_of_contacts_possible = bin_num_contact.back();
+    contact_pairs.resize(number_of_contacts_possible);
+    LOG(TRACE) << "Number of possible collisions: " << number_of_contacts_possible;
+
+#pragma omp parallel for
+    for (int i = 0; i < num_shapes; i++) {
+        f_HG_Store_AABB_AABB_Intersection(i, number_of_grid_levels, aabb_min, aabb_max, shape_level, inv_cell_size,
+                                          level_start, cell_number_out, bin_aabb_number, bin_start_index,
+                                          bin_num_contact, fam_data, obj_active, obj_data_id, contact_pairs);
+    }
+}
+
 } // end namespace collision
 } // end namespace chrono
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <climits>
 
 #include "chrono_parallel/ChParallelDefines.h"
@@ -413,6 +414,333 @@ static inline void f_Store_AABB_AABB_Intersection(const uint index,
     }
 }
 
+// STATIC/DYNAMIC SPLIT FUNCTIONS==========================================================
+
+/// Find the range of static shapes in the specified bin. Return false if no static shape intersects the bin.
+static inline bool f_Find_Static_Bin(const uint bin,
+                                     const uint num_static_bins,
+                                     const custom_vector<uint>& static_bin_number,
+                                     const custom_vector<uint>& static_bin_start_index,
+                                     uint& start,
+                                     uint& end) {
+    auto first = static_bin_number.begin();
+    auto last = first + num_static_bins;
+    auto it = std::lower_bound(first, last, bin);
+    if (it == last || *it != bin)
+        return false;
+    uint s = (uint)(it - first);
+    start = static_bin_start_index[s];
+    end = static_bin_start_index[s + 1];
+    return true;
+}
+
+/// Function to count the intersections of the (dynamic) AABBs in a bin with the static AABBs in the same bin.
+static inline void f_Count_AABB_Static_Intersection(const uint index,
+                                                   const real3 inv_bin_size_vec,
+                                                   const vec3 bins_per_axis,
+                                                   const custom_vector<real3>& aabb_min_data,
+                                                   const custom_vector<real3>& aabb_max_data,
+                                                   const custom_vector<uint>& bin_number,
+                                                   const custom_vector<uint>& aabb_number,
+                                                   const custom_vector<uint>& bin_start_index,
+                                                   const uint num_static_bins,
+                                                   const custom_vector<uint>& static_bin_number,
+                                                   const custom_vector<uint>& static_aabb_number,
+                                                   const custom_vector<uint>& static_bin_start_index,
+                                                   const custom_vector<short2>& fam_data,
+                                                   custom_vector<uint>& num_contact) {
+    uint start = bin_start_index[index];
+    uint end = bin_start_index[index + 1];
+    uint static_start, static_end;
+    if (!f_Find_Static_Bin(bin_number[index], num_static_bins, static_bin_number, static_bin_start_index,
+                           static_start, static_end)) {
+        num_contact[index] = 0;
+        return;
+    }
+    uint count = 0;
+    for (uint i = start; i < end; i++) {
+        uint shapeA = aabb_number[i];
+        real3 Amin = aabb_min_data[shapeA];
+        real3 Amax = aabb_max_data[shapeA];
+        short2 famA = fam_data[shapeA];
+
+        for (uint k = static_start; k < static_end; k++) {
+            uint shapeB = static_aabb_number[k];
+            real3 Bmin = aabb_min_data[shapeB];
+            real3 Bmax = aabb_max_data[shapeB];
+
+            if (!collide(famA, fam_data[shapeB]))
+                continue;
+            if (!overlap(Amin, Amax, Bmin, Bmax))
+                continue;
+            if (current_bin(Amin, Amax, Bmin, Bmax, inv_bin_size_vec, bins_per_axis, bin_number[index]) == false)
+                continue;
+            count++;
+        }
+    }
+
+    num_contact[index] = count;
+}
+
+/// Function to store the intersections of the (dynamic) AABBs in a bin with the static AABBs in the same bin,
+/// starting at the specified offset.
+static inline void f_Store_AABB_Static_Intersection(const uint index,
+                                                   const real3 inv_bin_size_vec,
+                                                   const vec3 bins_per_axis,
+                                                   const custom_vector<real3>& aabb_min_data,
+                                                   const custom_vector<real3>& aabb_max_data,
+                                                   const custom_vector<uint>& bin_number,
+                                                   const custom_vector<uint>& aabb_number,
+                                                   const custom_vector<uint>& bin_start_index,
+                                                   const uint num_static_bins,
+                                                   const custom_vector<uint>& static_bin_number,
+                                                   const custom_vector<uint>& static_aabb_number,
+                                                   const custom_vector<uint>& static_bin_start_index,
+                                                   const custom_vector<short2>& fam_data,
+                                                   const uint offset,
+                                                   custom_vector<long long>& potential_contacts) {
+    uint start = bin_start_index[index];
+    uint end = bin_start_index[index + 1];
+    uint static_start, static_end;
+    if (!f_Find_Static_Bin(bin_number[index], num_static_bins, static_bin_number, static_bin_start_index,
+                           static_start, static_end)) {
+        return;
+    }
+    uint count = 0;
+    for (uint i = start; i < end; i++) {
+        uint shapeA = aabb_number[i];
+        real3 Amin = aabb_min_data[shapeA];
+        real3 Amax = aabb_max_data[shapeA];
+        short2 famA = fam_data[shapeA];
+
+        for (uint k = static_start; k < static_end; k++) {
+            uint shapeB = static_aabb_number[k];
+            real3 Bmin = aabb_min_data[shapeB];
+            real3 Bmax = aabb_max_data[shapeB];
+
+            if (!collide(famA, fam_data[shapeB]))
+                continue;
+            if (!overlap(Amin, Amax, Bmin, Bmax))
+                continue;
+            if (current_bin(Amin, Amax, Bmin, Bmax, inv_bin_size_vec, bins_per_axis, bin_number[index]) == false)
+                continue;
+
+            // the two indices of the shapes that make up the contact
+            if (shapeA < shapeB)
+                potential_contacts[offset + count] = ((long long)shapeA << 32 | (long long)shapeB);
+            else
+                potential_contacts[offset + count] = ((long long)shapeB << 32 | (long long)shapeA);
+            count++;
+        }
+    }
+}
+
+// HIERARCHICAL GRID FUNCTIONS==========================================================
+
+/// Maximum number of levels of the hierarchical grid (the level is stored in the top 4 bits of a cell key).
+#define HGRID_MAX_LEVELS 16
+/// Maximum cell index along each axis in any level of the hierarchical grid (20 bits per cell coordinate).
+#define HGRID_MAX_CELL ((1 << 20) - 1)
+
+/// Convert a cell position in the specified level of the hierarchical grid into a unique key.
+/// Keys are ordered by level first.
+static inline unsigned long long HGrid_Key(const uint level, const vec3& A) {
+    return ((unsigned long long)level << 60) | ((unsigned long long)A.x << 40) | ((unsigned long long)A.y << 20) |
+           (unsigned long long)A.z;
+}
+
+/// Convert a position into a cell index in a level of the hierarchical grid.
+/// Unlike HashMax, the same mapping is used for both AABB corners, so that a cell containing any point of an AABB
+/// is always within the range of cells of that AABB.
+static inline vec3 HGrid_Hash(const real3& A, const real inv_cell_size) {
+    vec3 cell = HashMin(A, real3(inv_cell_size));
+    return Clamp(cell, vec3(0), vec3(HGRID_MAX_CELL));
+}
+
+/// Function to count the intersections of a shape with the cells of its level of the hierarchical grid.
+static inline void f_HG_Count_AABB_Cell_Intersection(const uint index,
+                                                     const custom_vector<real3>& aabb_min,
+                                                     const custom_vector<real3>& aabb_max,
+                                                     const custom_vector<uint>& shape_level,
+                                                     const custom_vector<real>& inv_cell_size,
+                                                     custom_vector<uint>& cells_intersected) {
+    uint level = shape_level[index];
+    if (level == UINT_MAX) {
+        cells_intersected[index] = 0;
+        return;
+    }
+    vec3 gmin = HGrid_Hash(aabb_min[index], inv_cell_size[level]);
+    vec3 gmax = HGrid_Hash(aabb_max[index], inv_cell_size[level]);
+    cells_intersected[index] = (gmax.x - gmin.x + 1) * (gmax.y - gmin.y + 1) * (gmax.z - gmin.z + 1);
+}
+
+/// Function to store the intersections of a shape with the cells of its level of the hierarchical grid.
+static inline void f_HG_Store_AABB_Cell_Intersection(const uint index,
+                                                     const custom_vector<real3>& aabb_min,
+                                                     const custom_vector<real3>& aabb_max,
+                                                     const custom_vector<uint>& shape_level,
+                                                     const custom_vector<real>& inv_cell_size,
+                                                     const custom_vector<uint>& cells_intersected,
+                                                     custom_vector<unsigned long long>& cell_number,
+                                                     custom_vector<uint>& aabb_number) {
+    uint level = shape_level[index];
+    if (level == UINT_MAX)
+        return;
+    vec3 gmin = HGrid_Hash(aabb_min[index], inv_cell_size[level]);
+    vec3 gmax = HGrid_Hash(aabb_max[index], inv_cell_size[level]);
+    uint mInd = cells_intersected[index];
+    uint count = 0;
+    for (int i = gmin.x; i <= gmax.x; i++) {
+        for (int j = gmin.y; j <= gmax.y; j++) {
+            for (int k = gmin.z; k <= gmax.z; k++) {
+                cell_number[mInd + count] = HGrid_Key(level, vec3(i, j, k));
+                aabb_number[mInd + count] = index;
+                count++;
+            }
+        }
+    }
+}
+
+/// Find the range of shapes in the specified cell of the hierarchical grid, searching the non-empty cells in the
+/// range [first, last). Return false if the cell is empty.
+static inline bool f_HG_Find_Cell(const unsigned long long key,
+                                  const uint first,
+                                  const uint last,
+                                  const custom_vector<unsigned long long>& cell_number,
+                                  const custom_vector<uint>& cell_start_index,
+                                  uint& start,
+                                  uint& end) {
+    auto begin = cell_number.begin() + first;
+    auto it = std::lower_bound(begin, cell_number.begin() + last, key);
+    if (it == cell_number.begin() + last || *it != key)
+        return false;
+    uint c = (uint)(it - cell_number.begin());
+    start = cell_start_index[c];
+    end = cell_start_index[c + 1];
+    return true;
+}
+
+/// Visit the potential contacts of a shape in the hierarchical grid. The shape is tested against the shapes with a
+/// larger index in its own level and against all the shapes in the coarser levels, in the cells of those levels that
+/// it overlaps. A pair is reported from a single cell only: the cell (in the coarser level of the two shapes) which
+/// contains the minimum corner of the AABB intersection. The callback is invoked as report(shapeA, shapeB).
+template <typename Report>
+static inline void f_HG_Visit_AABB_AABB_Intersection(const uint shapeA,
+                                                     const uint num_levels,
+                                                     const custom_vector<real3>& aabb_min_data,
+                                                     const custom_vector<real3>& aabb_max_data,
+                                                     const custom_vector<uint>& shape_level,
+                                                     const custom_vector<real>& inv_cell_size,
+                                                     const custom_vector<uint>& level_start,
+                                                     const custom_vector<unsigned long long>& cell_number,
+                                                     const custom_vector<uint>& aabb_number,
+                                                     const custom_vector<uint>& cell_start_index,
+                                                     const custom_vector<short2>& fam_data,
+                                                     const custom_vector<char>& body_active,
+                                                     const custom_vector<uint>& body_id,
+                                                     Report&& report) {
+    uint levelA = shape_level[shapeA];
+    if (levelA == UINT_MAX)
+        return;
+    real3 Amin = aabb_min_data[shapeA];
+    real3 Amax = aabb_max_data[shapeA];
+    short2 famA = fam_data[shapeA];
+    uint bodyA = body_id[shapeA];
+
+    for (uint level = levelA; level < num_levels; level++) {
+        // Skip empty levels
+        if (level_start[level] == level_start[level + 1])
+            continue;
+        real inv_size = inv_cell_size[level];
+        vec3 gmin = HGrid_Hash(Amin, inv_size);
+        vec3 gmax = HGrid_Hash(Amax, inv_size);
+        for (int i = gmin.x; i <= gmax.x; i++) {
+            for (int j = gmin.y; j <= gmax.y; j++) {
+                for (int k = gmin.z; k <= gmax.z; k++) {
+                    vec3 cell(i, j, k);
+                    uint start, end;
+                    if (!f_HG_Find_Cell(HGrid_Key(level, cell), level_start[level], level_start[level + 1],
+                                        cell_number, cell_start_index, start, end))
+                        continue;
+                    for (uint n = start; n < end; n++) {
+                        uint shapeB = aabb_number[n];
+                        // Pairs in the same level are visited from the shape with the lower index
+                        if (level == levelA && shapeB <= shapeA)
+                            continue;
+                        uint bodyB = body_id[shapeB];
+                        if (bodyA == bodyB)
+                            continue;
+                        if (!body_active[bodyA] && !body_active[bodyB])
+                            continue;
+                        if (!collide(famA, fam_data[shapeB]))
+                            continue;
+                        real3 Bmin = aabb_min_data[shapeB];
+                        real3 Bmax = aabb_max_data[shapeB];
+                        if (!overlap(Amin, Amax, Bmin, Bmax))
+                            continue;
+                        vec3 pcell = HGrid_Hash(Max(Amin, Bmin), inv_size);
+                        if (pcell.x != i || pcell.y != j || pcell.z != k)
+                            continue;
+                        report(shapeA, shapeB);
+                    }
+                }
+            }
+        }
+    }
+}
+
+/// Function to count the potential contacts of a shape in the hierarchical grid.
+static inline void f_HG_Count_AABB_AABB_Intersection(const uint index,
+                                                     const uint num_levels,
+                                                     const custom_vector<real3>& aabb_min_data,
+                                                     const custom_vector<real3>& aabb_max_data,
+                                                     const custom_vector<uint>& shape_level,
+                                                     const custom_vector<real>& inv_cell_size,
+                                                     const custom_vector<uint>& level_start,
+                                                     const custom_vector<unsigned long long>& cell_number,
+                                                     const custom_vector<uint>& aabb_number,
+                                                     const custom_vector<uint>& cell_start_index,
+                                                     const custom_vector<short2>& fam_data,
+                                                     const custom_vector<char>& body_active,
+                                                     const custom_vector<uint>& body_id,
+                                                     custom_vector<uint>& num_contact) {
+    uint count = 0;
+    f_HG_Visit_AABB_AABB_Intersection(index, num_levels, aabb_min_data, aabb_max_data, shape_level, inv_cell_size,
+                                      level_start, cell_number, aabb_number, cell_start_index, fam_data, body_active,
+                                      body_id, [&count](uint, uint) { count++; });
+    num_contact[index] = count;
+}
+
+/// Function to store the potential contacts of a shape in the hierarchical grid.
+static inline void f_HG_Store_AABB_AABB_Intersection(const uint index,
+                                                     const uint num_levels,
+                                                     const custom_vector<real3>& aabb_min_data,
+                                                     const custom_vector<real3>& aabb_max_data,
+                                                     const custom_vector<uint>& shape_level,
+                                                     const custom_vector<real>& inv_cell_size,
+                                                     const custom_vector<uint>& level_start,
+                                                     const custom_vector<unsigned long long>& cell_number,
+                                                     const custom_vector<uint>& aabb_number,
+                                                     const custom_vector<uint>& cell_start_index,
+                                                     const custom_vector<uint>& num_contact,
+                                                     const custom_vector<short2>& fam_data,
+                                                     const custom_vector<char>& body_active,
+                                                     const custom_vector<uint>& body_id,
+                                                     custom_vector<long long>& potential_contacts) {
+    uint offset = num_contact[index];
+    uint count = 0;
+    f_HG_Visit_AABB_AABB_Intersection(
+        index, num_levels, aabb_min_data, aabb_max_data, shape_level, inv_cell_size, level_start, cell_number,
+        aabb_number, cell_start_index, fam_data, body_active, body_id, [&](uint shapeA, uint shapeB) {
+            // the two indices of the shapes that make up the contact
+            if (shapeA < shapeB)
+                potential_contacts[offset + count] = ((long long)shapeA << 32 | (long long)shapeB);
+            else
+                potential_contacts[offset + count] = ((long long)shapeB << 32 | (long long)shapeA);
+            count++;
+        });
+}
+
 /// @} parallel_colision
 
 } // end namespace collision
@@ -47,6 +47,12 @@ class CH_PARALLEL_API ChCBroadphase {
     ChCBroadphase();
     void DispatchRigid();
     void OneLevelBroadphase();
+    /// Broadphase with separate static (fixed or sleeping) and dynamic shapes.
+    /// Only dynamic-dynamic and dynamic-static pairs are tested; the static bins are rebuilt only on change.
+    void SplitBroadphase();
+    /// Broadphase on a hierarchical grid, with each shape binned in the level with cells matching its size.
+    /// Shapes are tested against shapes in their own level and in the coarser levels.
+    void HierarchicalBroadphase();
     void DetermineBoundingBox();
     void OffsetAABB();
     void ComputeTopLevelResolution();
@@ -56,6 +62,28 @@ class CH_PARALLEL_API ChCBroadphase {
     ChParallelDataManager* data_manager;
 
   private:
+    /// Classify the shapes (0: active body, 1: fixed or sleeping body, 2: not colliding) and check whether the
+    /// static bins must be rebuilt.
+    bool UpdateStaticShapes();
+
+    /// Bin the shapes with the given class (see UpdateStaticShapes). Return the number of non-empty bins.
+    uint BinShapes(char select,
+                   custom_vector<uint>& bin_number,
+                   custom_vector<uint>& bin_number_out,
+                   custom_vector<uint>& bin_aabb_number,
+                   custom_vector<uint>& bin_start_index);
+
+    // Cached state of the static shapes, used to detect changes
+    bool grid_set;                         ///< true if the cached grid is valid
+    real3 grid_min;                        ///< cached grid minimum point
+    real3 grid_max;                        ///< cached grid maximum point
+    real3 static_origin;                   ///< grid origin used for the static bins
+    real3 static_bin_size;                 ///< bin size used for the static bins
+    vec3 static_bins_per_axis;             ///< grid resolution used for the static bins
+    uint num_static_bins;                  ///< number of non-empty static bins
+    custom_vector<char> static_flag;       ///< static flags at the time of the last rebuild
+    custom_vector<real3> static_aabb_min;  ///< AABBs of the static shapes at the time of the last rebuild
+    custom_vector<real3> static_aabb_max;
 };
 
 /// Class for performing narrow-phase collision detection.
@@ -0,0 +1,122 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Description: Contact history hash table for the SMC solver (MultiStep
+// tangential displacement mode).
+// The table stores indices into the per-contact history arrays, with linear
+// probing on collisions. Contacts between the same two shapes share a key and
+// are matched by their contact points. The table is rebuilt at each step from
+// the current contacts and only read while calculating contact forces at the
+// next step.
+//
+// =============================================================================
+
+#pragma once
+
+#include <algorithm>
+
+#include "chrono_parallel/ChParallelDefines.h"
+#include "chrono_parallel/ChDataManager.h"
+
+#include <thrust/fill.h>
+
+namespace chrono {
+
+/// @addtogroup parallel_solver
+/// @{
+
+/// Return the contact history key for the two shapes (global shape IDs) in contact.
+/// The key is independent of the order of the two shapes. Since global shape IDs are unique, the key also identifies
+/// the two bodies in contact.
+static inline long long ContactHistoryKey(int s1, int s2) {
+    return ((long long)std::max(s1, s2) << 32) | (long long)std::min(s1, s2);
+}
+
+/// Hash function for a contact key (64-bit finalizer of MurmurHash3).
+static inline unsigned int HashContactKey(long long key) {
+    unsigned long long h = (unsigned long long)key;
+    h ^= h >> 33;
+    h *= 0xff51afd7ed558ccdULL;
+    h ^= h >> 33;
+    h *= 0xc4ceb9fe1a85ec53ULL;
+    h ^= h >> 33;
+    return (unsigned int)h;
+}
+
+/// Return the index of the contact with given key and nearest to the given point in the history arrays, or -1 if no
+/// contact with this key is present.
+/// A shape pair can have several contacts (e.g. a capsule lying on a box); these share the same key and are told apart
+/// by their contact points, expressed in the frame of one of the two bodies. All entries with the same key are located
+/// on the probe sequence before the first empty slot.
+static inline int FindContactHistory(long long key,
+                                     const real3& point,
+                                     const int* table,
+                                     unsigned int table_size,
+                                     const long long* keys,
+                                     const real3* points) {
+    if (table_size == 0)
+        return -1;
+    unsigned int mask = table_size - 1;
+    int nearest = -1;
+    real nearest_dist2 = 0;
+    for (unsigned int j = HashContactKey(key) & mask;; j = (j + 1) & mask) {
+        int entry = table[j];
+        if (entry == -1)
+            return nearest;
+        if (keys[entry] != key)
+            continue;
+        real dist2 = Length2(points[entry] - point);
+        if (nearest == -1 || dist2 < nearest_dist2 || (dist2 == nearest_dist2 && entry < nearest)) {
+            nearest = entry;
+            nearest_dist2 = dist2;
+        }
+    }
+}
+
+/// Rebuild the hash table for the given contact keys (entries with negative keys are skipped).
+/// Insertion is done in parallel: a thread atomically exchanges its entry with the content of the probed slot and, if
+/// the slot was occupied, carries the displaced entry forward. Since slots never become empty, every entry remains
+/// reachable from its home slot without crossing an empty slot.
+static inline void BuildContactHistoryTable(const custom_vector<long long>& keys, custom_vector<int>& table) {
+    unsigned int table_size = 16;
+    while (table_size < 2 * keys.size())
+        table_size *= 2;
+    unsigned int mask = table_size - 1;
+
+    table.resize(table_size);
+    Thrust_Fill(table, -1);
+    int* table_data = table.data();
+
+#pragma omp parallel for
+    for (int i = 0; i < (signed)keys.size(); i++) {
+        if (keys[i] < 0)
+            continue;
+        int entry = i;
+        for (unsigned int j = HashContactKey(keys[i]) & mask;; j = (j + 1) & mask) {
+            int old;
+#pragma omp atomic capture
+            {
+                old = table_data[j];
+                table_data[j] = entry;
+            }
+            if (old == -1)
+                break;
+            entry = old;
+        }
+    }
+}
+
+/// @} parallel_solver
+
+}  // end namespace chrono
@@ -92,7 +92,12 @@ class CH_PARALLEL_API ChIterativeSolverParallelNSC : public ChIterativeSolverPar
     void ChangeSolverType(SolverType type);
 
   private:
+    /// Run the solver for the current local solver mode, in mixed precision if so requested.
+    /// Return the number of iterations performed.
+    uint SolvePhase(uint max_iteration);
+
     ChShurProduct ShurProductFull;
+    ChShurProductSingle ShurProductSingle;
     ChProjectConstraints ProjectFull;
 };
 
@@ -118,7 +123,11 @@ class CH_PARALLEL_API ChIterativeSolverParallelSMC : public ChIterativeSolverPar
                                 custom_vector<real3>& ext_body_force,
                                 custom_vector<real3>& ext_body_torque,
                                 custom_vector<vec2>& shape_pairs,
-                                custom_vector<char>& shear_touch);
+                                custom_vector<long long>& shear_keys,
+                                custom_vector<real3>& shear_points,
+                                custom_vector<real3>& shear_disp,
+                                custom_vector<real>& contact_relvel_init,
+                                custom_vector<real>& contact_duration);
 
     void host_AddContactForces(uint ct_body_count, const custom_vector<int>& ct_body_id);
 
@@ -101,6 +101,8 @@ void ChIterativeSolverParallelNSC::RunTimeStep() {
                 (data_manager->host_data.v + data_manager->host_data.M_inv * data_manager->host_data.hf);
     }
     ShurProductFull.Setup(data_manager);
+    if (data_manager->settings.solver.use_mixed_precision)
+        ShurProductSingle.Setup(data_manager);
     ShurProductBilateral.Setup(data_manager);
     ShurProductFEM.Setup(data_manager);
     ProjectFull.Setup(data_manager);
@@ -115,12 +117,7 @@ void ChIterativeSolverParallelNSC::RunTimeStep() {
             SetR();
             LOG(INFO) << "ChIterativeSolverParallelNSC::RunTimeStep - Solve Normal";
             data_manager->measures.solver.total_iteration +=
-                solver->Solve(ShurProductFull,                                     //
-                              ProjectFull,                                         //
-                              data_manager->settings.solver.max_iteration_normal,  //
-                              data_manager->num_constraints,                       //
-                              data_manager->host_data.R,                           //
-                              data_manager->host_data.gamma);                      //
+                SolvePhase(data_manager->settings.solver.max_iteration_normal);
         }
     }
     if (data_manager->settings.solver.solver_mode == SolverMode::SLIDING ||
@@ -130,12 +127,7 @@ void ChIterativeSolverParallelNSC::RunTimeStep() {
             SetR();
             LOG(INFO) << "ChIterativeSolverParallelNSC::RunTimeStep - Solve Sliding";
             data_manager->measures.solver.total_iteration +=
-                solver->Solve(ShurProductFull,                                      //
-                              ProjectFull,                                          //
-                              data_manager->settings.solver.max_iteration_sliding,  //
-                              data_manager->num_constraints,                        //
-                              data_manager->host_data.R,                            //
-                              data_manager->host_data.gamma);                       //
+                SolvePhase(data_manager->settings.solver.max_iteration_sliding);
         }
     }
     if (data_manager->settings.solver.solver_mode == SolverMode::SPINNING) {
@@ -144,12 +136,7 @@ void ChIterativeSolverParallelNSC::RunTimeStep() {
             SetR();
             LOG(INFO) << "ChIterativeSolverParallelNSC::RunTimeStep - Solve Spinning";
             data_manager->measures.solver.total_iteration +=
-                solver->Solve(ShurProductFull,                                       //
-                              ProjectFull,                                           //
-                              data_manager->settings.solver.max_iteration_spinning,  //
-                              data_manager->num_constraints,                         //
-                              data_manager->host_data.R,                             //
-                              data_manager->host_data.gamma);                        //
+                SolvePhase(data_manager->settings.solver.max_iteration_spinning);
         }
     }
 
@@ -425,6 +412,23 @@ void ChIterativeSolverParallelNSC::PreSolve() {
     // Currently not supported, might be added back in the future
 }
 
+uint ChIterativeSolverParallelNSC::SolvePhase(uint max_iteration) {
+    if (!data_manager->settings.solver.use_mixed_precision) {
+        return solver->Solve(ShurProductFull, ProjectFull, max_iteration, data_manager->num_constraints,
+                             data_manager->host_data.R, data_manager->host_data.gamma);
+    }
+
+    // Single precision iterations, followed by double precision refinement warm-started from their solution
+    uint iterations = solver->Solve(ShurProductSingle, ProjectFull, max_iteration, data_manager->num_constraints,
+                                    data_manager->host_data.R, data_manager->host_data.gamma);
+    uint max_refinement = data_manager->settings.solver.max_iteration_refinement;
+    if (max_refinement > 0) {
+        iterations += solver->Solve(ShurProductFull, ProjectFull, max_refinement, data_manager->num_constraints,
+                                    data_manager->host_data.R, data_manager->host_data.gamma);
+    }
+    return iterations;
+}
+
 void ChIterativeSolverParallelNSC::ChangeSolverType(SolverType type) {
     data_manager->settings.solver.solver_type = type;
 
@@ -35,6 +35,7 @@
 #include "chrono/physics/ChSystemSMC.h"
 #include "chrono/physics/ChMaterialSurfaceSMC.h"
 #include "chrono_parallel/solver/ChIterativeSolverParallel.h"
+#include "chrono_parallel/solver/ChContactHistorySMC.h"
 
 #if defined(CHRONO_OPENMP_ENABLED)
 #include <thrust/system/omp/execution_policy.h>
@@ -48,6 +49,42 @@
 
 using namespace chrono;
 
+// -----------------------------------------------------------------------------
+// Check if the contact identified by 'index' is, among all contacts between the
+// same two shapes, the one nearest to the specified point (expressed in the
+// frame of body 'shear_body1'). Ties are resolved in favor of the lower index.
+// The contacts between two shapes are consecutive in the contact list.
+// -----------------------------------------------------------------------------
+static bool IsNearestContact(int index,
+                             int num_contacts,
+                             int shear_body1,
+                             const real3& point,
+                             real dist2,
+                             vec2* body_pairs,
+                             vec2* shape_pairs,
+                             real3* pos,
+                             quaternion* rot,
+                             real3* pt1,
+                             real3* pt2,
+                             real* depth) {
+    const vec2& pair = shape_pairs[index];
+    for (int dir = -1; dir <= 1; dir += 2) {
+        for (int j = index + dir; j >= 0 && j < num_contacts; j += dir) {
+            if (shape_pairs[j].x != pair.x || shape_pairs[j].y != pair.y)
+                break;
+            if (depth[j] >= 0)
+                continue;
+            real3 pt_loc = (body_pairs[j].x == shear_body1)
+                               ? TransformParentToLocal(pos[shear_body1], rot[shear_body1], pt1[j])
+                               : TransformParentToLocal(pos[shear_body1], rot[shear_body1], pt2[j]);
+            real d2 = Length2(pt_loc - point);
+            if (d2 < dist2 || (d2 == dist2 && j < index))
+                return false;
+        }
+    }
+    return true;
+}
+
 // -----------------------------------------------------------------------------
 // Main worker function for calculating contact forces. Calculates the contact
 // force and torque for the contact pair identified by 'index' and stores them
@@ -57,6 +94,7 @@ using namespace chrono;
 // -----------------------------------------------------------------------------
 void function_CalcContactForces(
     int index,                                            // index of this contact pair
+    int num_contacts,                                     // number of contacts
     vec2* body_pairs,                                     // indices of the body pair in contact
     vec2* shape_pairs,                                    // indices of the shape pair in contact
     ChSystemSMC::ContactForceModel contact_model,         // contact force model
@@ -82,11 +120,18 @@ void function_CalcContactForces(
     real3* normal,                                        // contact normal (per contact)
     real* depth,                                          // penetration depth (per contact)
     real* eff_radius,                                     // effective contact radius (per contact)
-    vec3* shear_neigh,                                    // neighbor list of contacting bodies and shapes (per body)
-    char* shear_touch,                                    // flag if contact in neighbor list is persistent (per body)
-    real3* shear_disp,                                    // accumulated shear displacement for each neighbor (per body)
-    real* contact_relvel_init,                            // initial relative normal velocity per contact pair
-    real* contact_duration,                               // duration of persistent contact between contact pairs
+    const int* shear_table,                               // contact history hash table
+    unsigned int shear_table_size,                        // size of the contact history hash table
+    const long long* shear_keys_prev,                     // contact keys (per contact, prev. step)
+    const real3* shear_points_prev,                       // contact points (per contact, prev. step)
+    const real3* shear_disp_prev,                         // accumulated shear displacement (per contact, prev. step)
+    const real* contact_relvel_init_prev,                 // initial normal relative velocity (per contact, prev. step)
+    const real* contact_duration_prev,                    // duration of persistent contact (per contact, prev. step)
+    long long* shear_keys,                                // [output] contact key (per contact)
+    real3* shear_points,                                  // [output] contact point (per contact)
+    real3* shear_disp,                                    // [output] accumulated shear displacement (per contact)
+    real* contact_relvel_init,                            // [output] initial relative normal velocity (per contact)
+    real* contact_duration,                               // [output] duration of persistent contact (per contact)
     int* ext_body_id,                                     // [output] body IDs (two per contact)
     real3* ext_body_force,                                // [output] body force (two per contact)
     real3* ext_body_torque                                // [output] body torque (two per contact)
@@ -95,8 +140,10 @@ void function_CalcContactForces(
     int b1 = body_pairs[index].x;
     int b2 = body_pairs[index].y;
 
-    // If the two contact shapes are actually separated, set zero forces and torques.
+    // If the two contact shapes are actually separated, set zero forces and torques (and drop the contact history).
     if (depth[index] >= 0) {
+        if (displ_mode == ChSystemSMC::TangentialDisplacementModel::MultiStep)
+            shear_keys[index] = -1;
         ext_body_id[2 * index] = b1;
         ext_body_id[2 * index + 1] = b2;
         ext_body_force[2 * index] = real3(0);
@@ -177,13 +224,7 @@ void function_CalcContactForces(
     real delta_n = -depth[index];
     real3 delta_t = real3(0);
 
-    int i;
-    int contact_id;
     int shear_body1;
-    int shear_body2;
-    int shear_shape1;
-    int shear_shape2;
-    bool newcontact = true;
 
     if (displ_mode == ChSystemSMC::TangentialDisplacementModel::OneStep) {
         delta_t = relvel_t * dT;
@@ -194,46 +235,38 @@ void function_CalcContactForces(
         int s1 = shape_pairs[index].x;
         int s2 = shape_pairs[index].y;
 
-        // Contact history information stored on the body with the smaller shape or else the body with larger index.
-        // Currently, it is assumed that the smaller shape is on the body with larger ID. We call this body shear_body1.
+        // The shear displacement is expressed relative to the body with larger index. We call this body shear_body1.
+        // The contact point on shear_body1 (in its local frame) distinguishes contacts between the same two shapes.
         shear_body1 = std::max(b1, b2);
-        shear_body2 = std::min(b1, b2);
-        shear_shape1 = std::max(s1, s2);
-        shear_shape2 = std::min(s1, s2);
-
-        // Check if contact history already exists. If not, initialize new contact history.
-        for (i = 0; i < max_shear; i++) {
-            int ctIdUnrolled = max_shear * shear_body1 + i;
-            if (shear_neigh[ctIdUnrolled].x == shear_body2 && shear_neigh[ctIdUnrolled].y == shear_shape1 &&
-                shear_neigh[ctIdUnrolled].z == shear_shape2) {
-                contact_duration[ctIdUnrolled] += dT;
-                contact_id = i;
-                newcontact = false;
-                break;
-            }
+        long long key = ContactHistoryKey(s1, s2);
+        real3 pt_loc = (shear_body1 == b1) ? pt1_loc : pt2_loc;
+
+        // Check if contact history exists from the previous step. If not, initialize new contact history.
+        // The history is that of the nearest previous contact between the same two shapes, provided that no other
+        // current contact between these shapes is nearer to it (e.g., a contact appearing while another one persists
+        // starts a new history).
+        // The history of this contact is stored at the same index as the contact itself.
+        int ctSaveId = index;
+        int ctPrevId =
+            FindContactHistory(key, pt_loc, shear_table, shear_table_size, shear_keys_prev, shear_points_prev);
+        if (ctPrevId >= 0 &&
+            !IsNearestContact(index, num_contacts, shear_body1, shear_points_prev[ctPrevId],
+                              Length2(shear_points_prev[ctPrevId] - pt_loc), body_pairs, shape_pairs, pos, rot, pt1,
+                              pt2, depth)) {
+            ctPrevId = -1;
         }
-        if (newcontact == true) {
-            for (i = 0; i < max_shear; i++) {
-                int ctIdUnrolled = max_shear * shear_body1 + i;
-                if (shear_neigh[ctIdUnrolled].x == -1) {
-                    contact_id = i;
-                    shear_neigh[ctIdUnrolled].x = shear_body2;
-                    shear_neigh[ctIdUnrolled].y = shear_shape1;
-                    shear_neigh[ctIdUnrolled].z = shear_shape2;
-                    shear_disp[ctIdUnrolled].x = 0;
-                    shear_disp[ctIdUnrolled].y = 0;
-                    shear_disp[ctIdUnrolled].z = 0;
-                    contact_relvel_init[ctIdUnrolled] = relvel_init;
-                    contact_duration[ctIdUnrolled] = 0;
-                    break;
-                }
-            }
+        shear_keys[ctSaveId] = key;
+        shear_points[ctSaveId] = pt_loc;
+        if (ctPrevId >= 0) {
+            shear_disp[ctSaveId] = shear_disp_prev[ctPrevId];
+            contact_relvel_init[ctSaveId] = contact_relvel_init_prev[ctPrevId];
+            contact_duration[ctSaveId] = contact_duration_prev[ctPrevId] + dT;
+        } else {
+            shear_disp[ctSaveId] = real3(0);
+            contact_relvel_init[ctSaveId] = relvel_init;
+            contact_duration[ctSaveId] = 0;
         }
 
-        // Record that these two bodies are really in contact at this time.
-        int ctSaveId = max_shear * shear_body1 + contact_id;
-        shear_touch[ctSaveId] = true;
-
         // Increment stored contact history tangential (shear) displacement vector and project it onto the current
         // contact plane.
         if (shear_body1 == b1) {
@@ -464,9 +497,9 @@ void function_CalcContactForces(
             if (displ_mode == ChSystemSMC::TangentialDisplacementModel::MultiStep) {
                 delta_t = (forceT - forceT_damp) / kt;
                 if (shear_body1 == b1) {
-                    shear_disp[max_shear * shear_body1 + contact_id] = delta_t;
+                    shear_disp[index] = delta_t;
                 } else {
-                    shear_disp[max_shear * shear_body1 + contact_id] = -delta_t;
+                    shear_disp[index] = -delta_t;
                 }
             }
         } else {
@@ -562,11 +595,18 @@ void ChIterativeSolverParallelSMC::host_CalcContactForces(custom_vector<int>& ex
                                                           custom_vector<real3>& ext_body_force,
                                                           custom_vector<real3>& ext_body_torque,
                                                           custom_vector<vec2>& shape_pairs,
-                                                          custom_vector<char>& shear_touch) {
+                                                          custom_vector<long long>& shear_keys,
+                                                          custom_vector<real3>& shear_points,
+                                                          custom_vector<real3>& shear_disp,
+                                                          custom_vector<real>& contact_relvel_init,
+                                                          custom_vector<real>& contact_duration) {
+    const auto& host_data = data_manager->host_data;
+
 #pragma omp parallel for
     for (int index = 0; index < (signed)data_manager->num_rigid_contacts; index++) {
         function_CalcContactForces(
             index,                                                  // index of this contact pair
+            (int)data_manager->num_rigid_contacts,                  // number of contacts
             data_manager->host_data.bids_rigid_rigid.data(),        // indices of the body pair in contact
             shape_pairs.data(),                                     // indices of the shape pair in contact
             data_manager->settings.solver.contact_force_model,      // contact force model
@@ -592,14 +632,21 @@ void ChIterativeSolverParallelSMC::host_CalcContactForces(custom_vector<int>& ex
             data_manager->host_data.norm_rigid_rigid.data(),        // contact normal (per contact)
             data_manager->host_data.dpth_rigid_rigid.data(),        // penetration depth (per contact)
             data_manager->host_data.erad_rigid_rigid.data(),        // effective contact radius (per contact)
-            data_manager->host_data.shear_neigh.data(),  // neighbor list of contacting bodies and shapes (per body)
-            shear_touch.data(),                          // flag if contact in neighbor list is persistent (per body)
-            data_manager->host_data.shear_disp.data(),   // accumulated shear displacement for each neighbor (per body)
-            data_manager->host_data.contact_relvel_init.data(),  // initial relative normal velocity per contact pair
-            data_manager->host_data.contact_duration.data(),     // duration of persistent contact between contact pairs
-            ext_body_id.data(),                                  // [output] body IDs (two per contact)
-            ext_body_force.data(),                               // [output] body force (two per contact)
-            ext_body_torque.data()                               // [output] body torque (two per contact)
+            host_data.shear_table.data(),                           // contact history hash table
+            (unsigned int)host_data.shear_table.size(),             // size of the contact history hash table
+            host_data.shear_keys.data(),                            // contact keys (previous step)
+            host_data.shear_points.data(),                          // contact points (previous step)
+            host_data.shear_disp.data(),                            // accumulated shear displacement (previous step)
+            host_data.contact_relvel_init.data(),                   // initial relative normal velocity (previous step)
+            host_data.contact_duration.data(),                      // duration of persistent contact (previous step)
+            shear_keys.data(),                                      // [output] contact keys
+            shear_points.data(),                                    // [output] contact points
+            shear_disp.data(),                                      // [output] accumulated shear displacement
+            contact_relvel_init.data(),                             // [output] initial relative normal velocity
+            contact_duration.data(),                                // [output] duration of persistent contact
+            ext_body_id.data(),                                     // [output] body IDs (two per contact)
+            ext_body_force.data(),                                  // [output] body force (two per contact)
+            ext_body_torque.data()                                  // [output] body torque (two per contact)
         );
     }
 }
@@ -662,12 +709,19 @@ void ChIterativeSolverParallelSMC::ProcessContacts() {
     custom_vector<real3> ext_body_force(2 * data_manager->num_rigid_contacts);
     custom_vector<real3> ext_body_torque(2 * data_manager->num_rigid_contacts);
     custom_vector<vec2> shape_pairs;
-    custom_vector<char> shear_touch;
+    custom_vector<long long> shear_keys;
+    custom_vector<real3> shear_points;
+    custom_vector<real3> shear_disp;
+    custom_vector<real> contact_relvel_init;
+    custom_vector<real> contact_duration;
 
     if (data_manager->settings.solver.tangential_displ_mode == ChSystemSMC::TangentialDisplacementModel::MultiStep) {
         shape_pairs.resize(data_manager->num_rigid_contacts);
-        shear_touch.resize(max_shear * data_manager->num_rigid_bodies);
-        Thrust_Fill(shear_touch, false);
+        shear_keys.resize(data_manager->num_rigid_contacts);
+        shear_points.resize(data_manager->num_rigid_contacts);
+        shear_disp.resize(data_manager->num_rigid_contacts);
+        contact_relvel_init.resize(data_manager->num_rigid_contacts);
+        contact_duration.resize(data_manager->num_rigid_contacts);
 #pragma omp parallel for
         for (int i = 0; i < (signed)data_manager->num_rigid_contacts; i++) {
             vec2 pair = I2(int(data_manager->host_data.contact_pairs[i] >> 32),
@@ -676,16 +730,18 @@ void ChIterativeSolverParallelSMC::ProcessContacts() {
         }
     }
 
-    host_CalcContactForces(ext_body_id, ext_body_force, ext_body_torque, shape_pairs, shear_touch);
+    host_CalcContactForces(ext_body_id, ext_body_force, ext_body_torque, shape_pairs, shear_keys, shear_points,
+                           shear_disp, contact_relvel_init, contact_duration);
 
+    // Replace the contact history with that of the current contacts and rebuild the hash table.
+    // Contacts that were not found at this step (including separated shapes) are thus dropped from the history.
     if (data_manager->settings.solver.tangential_displ_mode == ChSystemSMC::TangentialDisplacementModel::MultiStep) {
-#pragma omp parallel for
-        for (int index = 0; index < (signed)data_manager->num_rigid_bodies; index++) {
-            for (int i = 0; i < max_shear; i++) {
-                if (shear_touch[max_shear * index + i] == false)
-                    data_manager->host_data.shear_neigh[max_shear * index + i].x = -1;
-            }
-        }
+        data_manager->host_data.shear_keys.swap(shear_keys);
+        data_manager->host_data.shear_points.swap(shear_points);
+        data_manager->host_data.shear_disp.swap(shear_disp);
+        data_manager->host_data.contact_relvel_init.swap(contact_relvel_init);
+        data_manager->host_data.contact_duration.swap(contact_duration);
+        BuildContactHistoryTable(data_manager->host_data.shear_keys, data_manager->host_data.shear_table);
     }
 
     // 2. Calculate contact forces and torques - per body basis
@@ -807,6 +863,14 @@ void ChIterativeSolverParallelSMC::RunTimeStep() {
         data_manager->system_timer.start("ChIterativeSolverParallelSMC_ProcessContact");
         ProcessContacts();
         data_manager->system_timer.stop("ChIterativeSolverParallelSMC_ProcessContact");
+    } else {
+        // No contacts, so no contact history to keep
+        data_manager->host_data.shear_keys.clear();
+        data_manager->host_data.shear_points.clear();
+        data_manager->host_data.shear_disp.clear();
+        data_manager->host_data.contact_relvel_init.clear();
+        data_manager->host_data.contact_duration.clear();
+        data_manager->host_data.shear_table.clear();
     }
 
     // Generate the mass matrix and compute M_inv_k
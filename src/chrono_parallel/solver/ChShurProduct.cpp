@@ -104,6 +104,36 @@ void ChShurProduct::operator()(const DynamicVector<real>& x, DynamicVector<real>
     data_manager->system_timer.stop("ShurProduct");
 }
 
+void ChShurProductSingle::Setup(ChParallelDataManager* data_container_) {
+    ChShurProduct::Setup(data_container_);
+    data_manager->system_timer.start("ShurProduct");
+    E = data_manager->host_data.E;
+    if (data_manager->settings.solver.compute_N) {
+        Nshur = data_manager->host_data.Nshur;
+    } else {
+        D_T = data_manager->host_data.D_T;
+        M_invD = data_manager->host_data.M_invD;
+    }
+    data_manager->system_timer.stop("ShurProduct");
+}
+
+void ChShurProductSingle::operator()(const DynamicVector<real>& x, DynamicVector<real>& output) {
+    if (data_manager->settings.solver.local_solver_mode != data_manager->settings.solver.solver_mode) {
+        ChShurProduct::operator()(x, output);
+        return;
+    }
+
+    data_manager->system_timer.start("ShurProduct");
+    x_s = x;
+    if (data_manager->settings.solver.compute_N) {
+        AX_s = Nshur * x_s + E * x_s;
+    } else {
+        AX_s = D_T * (M_invD * x_s) + E * x_s;
+    }
+    output = AX_s;
+    data_manager->system_timer.stop("ShurProduct");
+}
+
 void ChShurProductBilateral::Setup(ChParallelDataManager* data_container_) {
     ChShurProduct::Setup(data_container_);
     if (data_manager->num_bilaterals == 0) {
@@ -164,6 +164,7 @@ using namespace chrono::fea;
 %shared_ptr(chrono::ChBodyEasyMesh)
 %shared_ptr(chrono::ChBodyEasyClusterOfSpheres)
 %shared_ptr(chrono::ChConveyor)
+%shared_ptr(chrono::ChAparticleBase)
 %shared_ptr(chrono::ChAparticle)
 %shared_ptr(chrono::ChParticleBase)
 %shared_ptr(chrono::ChIndexedParticles)
@@ -16,6 +16,7 @@
 #include "chrono/solver/ChSolverBB.h"
 #include "chrono/solver/ChSolverAPGD.h"
 #include "chrono/solver/ChSolverPSOR.h"
+#include "chrono/solver/ChSolverPSORcolored.h"
 #include "chrono/solver/ChSolverPJacobi.h"
 
 using namespace chrono;
@@ -40,6 +41,7 @@ using namespace chrono;
 %shared_ptr(chrono::ChSolverBB)
 %shared_ptr(chrono::ChSolverAPGD)
 %shared_ptr(chrono::ChSolverPSOR)
+%shared_ptr(chrono::ChSolverPSORcolored)
 %shared_ptr(chrono::ChSolverPJacobi)
 %shared_ptr(chrono::ChSolverSparseLU)
 %shared_ptr(chrono::ChSolverSparseQR)
@@ -58,6 +60,7 @@ using namespace chrono;
 %include "../../chrono/solver/ChSolverBB.h"
 %include "../../chrono/solver/ChSolverAPGD.h"
 %include "../../chrono/solver/ChSolverPSOR.h"
+%include "../../chrono/solver/ChSolverPSORcolored.h"
 %include "../../chrono/solver/ChSolverPJacobi.h"
 
 
@@ -33,5 +33,30 @@ float ChTerrain::GetCoefficientFriction(const ChVector<>& loc) const {
     return 0.8f;
 }
 
+void ChTerrain::GetProperties(const ChVector<>& loc, double& height, ChVector<>& normal, float& friction) const {
+    height = GetHeight(loc);
+    normal = GetNormal(loc);
+    friction = GetCoefficientFriction(loc);
+}
+
+void ChTerrain::GetProperties(const std::vector<ChVector<>>& locs,
+                              std::vector<double>& heights,
+                              std::vector<ChVector<>>& normals,
+                              std::vector<float>& frictions) const {
+    size_t n = locs.size();
+    heights.resize(n);
+    normals.resize(n);
+    frictions.resize(n);
+    for (size_t i = 0; i < n; i++)
+        GetProperties(locs[i], heights[i], normals[i], frictions[i]);
+}
+
+void ChTerrain::GetHeights(const std::vector<ChVector<>>& locs, std::vector<double>& heights) const {
+    size_t n = locs.size();
+    heights.resize(n);
+    for (size_t i = 0; i < n; i++)
+        heights[i] = GetHeight(locs[i]);
+}
+
 }  // end namespace vehicle
 }  // end namespace chrono
@@ -19,6 +19,8 @@
 #ifndef CH_TERRAIN_H
 #define CH_TERRAIN_H
 
+#include <vector>
+
 #include "chrono/core/ChVector.h"
 
 #include "chrono_vehicle/ChApiVehicle.h"
@@ -54,6 +56,26 @@ class CH_VEHICLE_API ChTerrain {
     /// with other objects (including tire models that do not explicitly use it).
     virtual float GetCoefficientFriction(const ChVector<>& loc) const;
 
+    /// Get the terrain height, normal, and coefficient of friction at the point below the specified location.
+    /// The default implementation calls GetHeight, GetNormal, and GetCoefficientFriction. Derived classes should
+    /// override it if the three quantities can be obtained with a single terrain lookup.
+    virtual void GetProperties(const ChVector<>& loc, double& height, ChVector<>& normal, float& friction) const;
+
+    /// Get the terrain height, normal, and coefficient of friction at the points below the specified locations.
+    /// The output vectors are resized to the number of query locations. This batched query is used by tire
+    /// models which sample the terrain at several points per step. The default implementation calls the
+    /// single-point GetProperties for each location.
+    virtual void GetProperties(const std::vector<ChVector<>>& locs,
+                               std::vector<double>& heights,
+                               std::vector<ChVector<>>& normals,
+                               std::vector<float>& frictions) const;
+
+    /// Get the terrain heights below the specified locations.
+    /// The output vector is resized to the number of query locations. Use this batched query when only the heights are
+    /// needed (normal and friction may be more expensive to evaluate). The default implementation calls GetHeight for
+    /// each location.
+    virtual void GetHeights(const std::vector<ChVector<>>& locs, std::vector<double>& heights) const;
+
     /// Class to be used as a functor interface for location-dependent coefficient of friction.
     class CH_VEHICLE_API FrictionFunctor {
       public:
@@ -189,11 +189,32 @@ double CRGTerrain::GetHeight(const ChVector<>& loc) const {
 }
 
 ChVector<> CRGTerrain::GetNormal(const ChVector<>& loc) const {
+    return ComputeNormal(loc, GetHeight(loc));
+}
+
+void CRGTerrain::GetProperties(const ChVector<>& loc, double& height, ChVector<>& normal, float& friction) const {
+    height = GetHeight(loc);
+    normal = ComputeNormal(loc, height);
+    friction = m_friction_fun ? (*m_friction_fun)(loc) : m_friction;
+}
+
+void CRGTerrain::GetProperties(const std::vector<ChVector<>>& locs,
+                               std::vector<double>& heights,
+                               std::vector<ChVector<>>& normals,
+                               std::vector<float>& frictions) const {
+    size_t n = locs.size();
+    heights.resize(n);
+    normals.resize(n);
+    frictions.resize(n);
+    for (size_t i = 0; i < n; i++)
+        CRGTerrain::GetProperties(locs[i], heights[i], normals[i], frictions[i]);
+}
+
+ChVector<> CRGTerrain::ComputeNormal(const ChVector<>& loc, double z0) const {
     ChVector<> loc_ISO = ChWorldFrame::ToISO(loc);
     // to avoid 'jumping' of the normal vector, we take this smoothing approach
     const double delta = 0.05;
-    double z0, zfront, zleft;
-    z0 = GetHeight(loc);
+    double zfront, zleft;
     zfront = GetHeight(ChWorldFrame::FromISO(loc_ISO + ChVector<>(delta, 0, 0)));
     zleft = GetHeight(ChWorldFrame::FromISO(loc_ISO + ChVector<>(0, delta, 0)));
     ChVector<> p0(loc_ISO.x(), loc_ISO.y(), z0);
@@ -36,5 +36,29 @@ float FlatTerrain::GetCoefficientFriction(const ChVector<>& loc) const {
     return m_friction_fun ? (*m_friction_fun)(loc) : m_friction;
 }
 
+void FlatTerrain::GetProperties(const ChVector<>& loc, double& height, ChVector<>& normal, float& friction) const {
+    height = m_height;
+    normal = ChWorldFrame::Vertical();
+    friction = m_friction_fun ? (*m_friction_fun)(loc) : m_friction;
+}
+
+void FlatTerrain::GetProperties(const std::vector<ChVector<>>& locs,
+                                std::vector<double>& heights,
+                                std::vector<ChVector<>>& normals,
+                                std::vector<float>& frictions) const {
+    size_t n = locs.size();
+    heights.assign(n, m_height);
+    normals.assign(n, ChWorldFrame::Vertical());
+    frictions.assign(n, m_friction);
+    if (m_friction_fun) {
+        for (size_t i = 0; i < n; i++)
+            frictions[i] = (*m_friction_fun)(locs[i]);
+    }
+}
+
+void FlatTerrain::GetHeights(const std::vector<ChVector<>>& locs, std::vector<double>& heights) const {
+    heights.assign(locs.size(), m_height);
+}
+
 }  // end namespace vehicle
 }  // end namespace chrono
@@ -57,6 +57,24 @@ class CH_VEHICLE_API FlatTerrain : public ChTerrain {
     /// Otherwise, it returns the constant value specified at construction.
     virtual float GetCoefficientFriction(const ChVector<>& loc) const override;
 
+    /// Get the terrain height, normal, and coefficient of friction at the point below the specified location.
+    /// Returns the constant height and normal, and the coefficient of friction as in GetCoefficientFriction.
+    virtual void GetProperties(const ChVector<>& loc,
+                               double& height,
+                               ChVector<>& normal,
+                               float& friction) const override;
+
+    /// Get the terrain height, normal, and coefficient of friction at the points below the specified locations.
+    /// The constant height and normal are assigned directly; the friction functor, if any, is called per point.
+    virtual void GetProperties(const std::vector<ChVector<>>& locs,
+                               std::vector<double>& heights,
+                               std::vector<ChVector<>>& normals,
+                               std::vector<float>& frictions) const override;
+
+    /// Get the terrain heights below the specified locations.
+    /// Returns the constant value passed at construction for all locations.
+    virtual void GetHeights(const std::vector<ChVector<>>& locs, std::vector<double>& heights) const override;
+
   private:
     double m_height;   ///< terrain height
     float m_friction;  ///< contact coefficient of friction
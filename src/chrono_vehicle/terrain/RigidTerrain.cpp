@@ -49,7 +49,10 @@ RigidTerrain::RigidTerrain(ChSystem* system)
       m_num_patches(0),
       m_collision_family(14),
       m_use_friction_functor(false),
-      m_contact_callback(nullptr) {}
+      m_contact_callback(nullptr),
+      m_index_cell(0),
+      m_index_nx(0),
+      m_index_ny(0) {}
 
 // -----------------------------------------------------------------------------
 // Constructor from JSON file
@@ -59,7 +62,10 @@ RigidTerrain::RigidTerrain(ChSystem* system, const std::string& filename)
       m_num_patches(0),
       m_collision_family(14),
       m_use_friction_functor(false),
-      m_contact_callback(nullptr) {
+      m_contact_callback(nullptr),
+      m_index_cell(0),
+      m_index_nx(0),
+      m_index_ny(0) {
     // Open and parse the input file
     Document d = ReadFileJSON(filename);
     if (d.IsNull())
@@ -161,6 +167,9 @@ void RigidTerrain::AddPatch(std::shared_ptr<Patch> patch,
     patch->m_friction = material->GetSfriction();
 
     m_patches.push_back(patch);
+
+    // Invalidate the patch index (rebuilt at initialization)
+    m_index_bins.clear();
 }
 
 // -----------------------------------------------------------------------------
@@ -219,6 +228,7 @@ std::shared_ptr<RigidTerrain::Patch> RigidTerrain::AddPatch(std::shared_ptr<ChMa
     patch->m_hwidth = width / 2; 
     patch->m_radius = ChVector<>(length, width, thickness).Length() / 2;
     patch->m_type = PatchType::BOX;
+    patch->ComputeFootprint();
 
     return patch;
 }
@@ -262,6 +272,7 @@ std::shared_ptr<RigidTerrain::Patch> RigidTerrain::AddPatch(std::shared_ptr<ChMa
 
     patch->m_mesh_name = mesh_name;
     patch->m_type = PatchType::MESH;
+    patch->ComputeFootprint();
 
     return patch;
 }
@@ -278,7 +289,7 @@ std::shared_ptr<RigidTerrain::Patch> RigidTerrain::AddPatch(std::shared_ptr<ChMa
                                                             double hMax,
                                                             double sweep_sphere_radius,
                                                             bool visualization) {
-    auto patch = chrono_types::make_shared<MeshPatch>();
+    auto patch = chrono_types::make_shared<HeightMapPatch>();
     AddPatch(patch, position, material);
 
     // Read the image file (request only 1 channel) and extract number of pixels.
@@ -316,6 +327,9 @@ std::shared_ptr<RigidTerrain::Patch> RigidTerrain::AddPatch(std::shared_ptr<ChMa
     // Initialize the array of accumulators (number of adjacent faces to a vertex)
     std::vector<int> accumulators(n_verts, 0);
 
+    // Cache vertex heights for direct height and normal queries
+    patch->m_heights.resize(n_verts);
+
     // Readability aliases
     std::vector<ChVector<> >& vertices = patch->m_trimesh->getCoordsVertices();
     std::vector<ChVector<> >& normals = patch->m_trimesh->getCoordsNormals();
@@ -333,6 +347,7 @@ std::shared_ptr<RigidTerrain::Patch> RigidTerrain::AddPatch(std::shared_ptr<ChMa
             double x = ix * dx - 0.5 * length;
             // Map gray level to vertex height
             double z = hMin + hmap.Gray(ix, iy) * h_scale;
+            patch->m_heights[iv] = z;
             // Set vertex location
             vertices[iv] = ChWorldFrame::FromISO(ChVector<>(x, y, z));
             // Initialize vertex normal to (0, 0, 0).
@@ -400,6 +415,15 @@ std::shared_ptr<RigidTerrain::Patch> RigidTerrain::AddPatch(std::shared_ptr<ChMa
     patch->m_radius = ChVector<>(length, width, (hMax - hMin)).Length() / 2;
     patch->m_mesh_name = mesh_name;
     patch->m_type = PatchType::HEIGHT_MAP;
+    patch->ComputeFootprint();
+
+    patch->m_nv_x = nv_x;
+    patch->m_nv_y = nv_y;
+    patch->m_length = length;
+    patch->m_width = width;
+    patch->m_sweep_sphere_radius = sweep_sphere_radius;
+    ChVector<> vertical = patch->m_body->TransformDirectionLocalToParent(ChWorldFrame::Vertical());
+    patch->m_level = Vdot(vertical, ChWorldFrame::Vertical()) > 1 - 1e-10;
 
     return patch;
 }
@@ -488,6 +512,8 @@ void RigidTerrain::Initialize() {
     if (m_patches.empty())
         return;
 
+    BuildPatchIndex();
+
     if (m_patches.size() > 1) {
         for (auto patch : m_patches) {
             // Add all patches to the same collision family
@@ -549,27 +575,147 @@ float RigidTerrain::GetCoefficientFriction(const ChVector<>& loc) const {
     return hit ? friction : 0.8f;
 }
 
+void RigidTerrain::GetProperties(const ChVector<>& loc, double& height, ChVector<>& normal, float& friction) const {
+    bool hit = FindPoint(loc, height, normal, friction);
+    if (!hit) {
+        height = 0.0;
+        normal = ChWorldFrame::Vertical();
+        friction = 0.8f;
+    }
+    if (m_friction_fun)
+        friction = (*m_friction_fun)(loc);
+}
+
+void RigidTerrain::GetProperties(const std::vector<ChVector<>>& locs,
+                                 std::vector<double>& heights,
+                                 std::vector<ChVector<>>& normals,
+                                 std::vector<float>& frictions) const {
+    size_t n = locs.size();
+    heights.resize(n);
+    normals.resize(n);
+    frictions.resize(n);
+    for (size_t i = 0; i < n; i++)
+        RigidTerrain::GetProperties(locs[i], heights[i], normals[i], frictions[i]);
+}
+
 bool RigidTerrain::FindPoint(const ChVector<> loc, double& height, ChVector<>& normal, float& friction) const {
     bool hit = false;
     height = std::numeric_limits<double>::lowest();
     normal = ChWorldFrame::Vertical();
     friction = 0.8f;
 
-    for (auto patch : m_patches) {
+    auto test_patch = [&](const Patch& patch) {
+        if (!patch.InFootprint(loc))
+            return;
         double pheight;
         ChVector<> pnormal;
-        bool phit = patch->FindPoint(loc, pheight, pnormal);
+        bool phit = patch.FindPoint(loc, pheight, pnormal);
         if (phit && pheight > height) {
             hit = true;
             height = pheight;
             normal = pnormal;
-            friction = patch->m_friction;
+            friction = patch.m_friction;
         }
+    };
+
+    if (m_index_bins.empty()) {
+        // No patch index (not yet initialized); test all patches
+        for (auto patch : m_patches)
+            test_patch(*patch);
+    } else {
+        // Test only the patches overlapping the index cell below the given location.
+        // Locations on the index boundary are accepted up to round-off.
+        ChVector<> loc_iso = ChWorldFrame::ToISO(loc);
+        double x = (loc_iso.x() - m_index_min.x()) / m_index_cell;
+        double y = (loc_iso.y() - m_index_min.y()) / m_index_cell;
+        const double eps = 1e-9;
+        if (x < -eps || x > m_index_nx + eps || y < -eps || y > m_index_ny + eps)
+            return false;
+        int ix = std::min((int)x, m_index_nx - 1);
+        int iy = std::min((int)y, m_index_ny - 1);
+        for (auto ip : m_index_bins[ix + m_index_nx * iy])
+            test_patch(*m_patches[ip]);
     }
 
     return hit;
 }
 
+// -----------------------------------------------------------------------------
+// Patch footprints and spatial index over patches
+// -----------------------------------------------------------------------------
+
+bool RigidTerrain::Patch::InFootprint(const ChVector<>& loc) const {
+    // Locations on the footprint boundary are accepted up to round-off
+    const double eps = 1e-9;
+    ChVector<> loc_iso = ChWorldFrame::ToISO(loc);
+    return loc_iso.x() >= m_fp_min.x() - eps && loc_iso.x() <= m_fp_max.x() + eps &&  //
+           loc_iso.y() >= m_fp_min.y() - eps && loc_iso.y() <= m_fp_max.y() + eps;
+}
+
+void RigidTerrain::BoxPatch::ComputeFootprint() {
+    ChVector<> forward = m_body->GetA().Get_A_Xaxis();
+    ChVector<> lateral = m_body->GetA().Get_A_Yaxis();
+    m_fp_min = ChVector2<>(std::numeric_limits<double>::max());
+    m_fp_max = ChVector2<>(std::numeric_limits<double>::lowest());
+    for (int i = -1; i <= 1; i += 2) {
+        for (int j = -1; j <= 1; j += 2) {
+            ChVector<> corner = ChWorldFrame::ToISO(m_location + (i * m_hlength) * forward + (j * m_hwidth) * lateral);
+            m_fp_min.x() = std::min(m_fp_min.x(), corner.x());
+            m_fp_min.y() = std::min(m_fp_min.y(), corner.y());
+            m_fp_max.x() = std::max(m_fp_max.x(), corner.x());
+            m_fp_max.y() = std::max(m_fp_max.y(), corner.y());
+        }
+    }
+}
+
+void RigidTerrain::MeshPatch::ComputeFootprint() {
+    m_fp_min = ChVector2<>(std::numeric_limits<double>::max());
+    m_fp_max = ChVector2<>(std::numeric_limits<double>::lowest());
+    for (const auto& v : m_trimesh->getCoordsVertices()) {
+        ChVector<> v_iso = ChWorldFrame::ToISO(m_body->TransformPointLocalToParent(v));
+        m_fp_min.x() = std::min(m_fp_min.x(), v_iso.x());
+        m_fp_min.y() = std::min(m_fp_min.y(), v_iso.y());
+        m_fp_max.x() = std::max(m_fp_max.x(), v_iso.x());
+        m_fp_max.y() = std::max(m_fp_max.y(), v_iso.y());
+    }
+}
+
+void RigidTerrain::BuildPatchIndex() {
+    // Bounding box of all patch footprints
+    ChVector2<> fp_min(std::numeric_limits<double>::max());
+    ChVector2<> fp_max(std::numeric_limits<double>::lowest());
+    for (const auto& patch : m_patches) {
+        fp_min.x() = std::min(fp_min.x(), patch->m_fp_min.x());
+        fp_min.y() = std::min(fp_min.y(), patch->m_fp_min.y());
+        fp_max.x() = std::max(fp_max.x(), patch->m_fp_max.x());
+        fp_max.y() = std::max(fp_max.y(), patch->m_fp_max.y());
+    }
+
+    // Pick a cell size resulting in about 4 cells per patch
+    double sizeX = std::max(fp_max.x() - fp_min.x(), 1e-3);
+    double sizeY = std::max(fp_max.y() - fp_min.y(), 1e-3);
+    m_index_min = fp_min;
+    m_index_cell = std::sqrt(sizeX * sizeY / (4.0 * m_patches.size()));
+    m_index_nx = std::max(1, (int)std::ceil(sizeX / m_index_cell));
+    m_index_ny = std::max(1, (int)std::ceil(sizeY / m_index_cell));
+
+    // Register each patch with all cells overlapping its footprint
+    m_index_bins.clear();
+    m_index_bins.resize(m_index_nx * m_index_ny);
+    for (int ip = 0; ip < (int)m_patches.size(); ip++) {
+        const auto& patch = m_patches[ip];
+        int ix1 = std::min((int)((patch->m_fp_min.x() - m_index_min.x()) / m_index_cell), m_index_nx - 1);
+        int iy1 = std::min((int)((patch->m_fp_min.y() - m_index_min.y()) / m_index_cell), m_index_ny - 1);
+        int ix2 = std::min((int)((patch->m_fp_max.x() - m_index_min.x()) / m_index_cell), m_index_nx - 1);
+        int iy2 = std::min((int)((patch->m_fp_max.y() - m_index_min.y()) / m_index_cell), m_index_ny - 1);
+        for (int ix = ix1; ix <= ix2; ix++) {
+            for (int iy = iy1; iy <= iy2; iy++) {
+                m_index_bins[ix + m_index_nx * iy].push_back(ip);
+            }
+        }
+    }
+}
+
 bool RigidTerrain::BoxPatch::FindPoint(const ChVector<>& loc, double& height, ChVector<>& normal) const {
     // Ray definition (in global frame)
     ChVector<> A = loc + (m_radius + 1000) * ChWorldFrame::Vertical();  // start point
@@ -598,6 +744,59 @@ bool RigidTerrain::MeshPatch::FindPoint(const ChVector<>& loc, double& height, C
     return result.hit;
 }
 
+bool RigidTerrain::HeightMapPatch::FindPoint(const ChVector<>& loc, double& height, ChVector<>& normal) const {
+    // Fall back on ray casting if the patch is tilted
+    if (!m_level)
+        return MeshPatch::FindPoint(loc, height, normal);
+
+    // Location in the (ISO) frame of the height map
+    ChVector<> loc_iso = ChWorldFrame::ToISO(m_body->TransformPointParentToLocal(loc));
+
+    // Find the grid cell containing the given location.
+    // Recall that vertex rows are ordered starting at the (-length/2, -width/2) corner.
+    double dx = m_length / (m_nv_x - 1);
+    double dy = m_width / (m_nv_y - 1);
+    // Locations on the patch boundary are accepted up to round-off.
+    double x = (loc_iso.x() + 0.5 * m_length) / dx;
+    double y = (loc_iso.y() + 0.5 * m_width) / dy;
+    const double eps = 1e-9;
+    if (x < -eps || x > m_nv_x - 1 + eps || y < -eps || y > m_nv_y - 1 + eps)
+        return false;
+    int ix = std::min((int)x, m_nv_x - 2);
+    int iy = std::min((int)y, m_nv_y - 2);
+    double ax = x - ix;
+    double ay = y - iy;
+
+    // Interpolate on the triangle containing the given location.
+    // Use the same triangulation as the contact mesh (cells split along the v0 - v3 diagonal).
+    int v0 = ix + m_nv_x * iy;
+    double h0 = m_heights[v0];
+    double h1 = m_heights[v0 + 1];
+    double h2 = m_heights[v0 + m_nv_x];
+    double h3 = m_heights[v0 + m_nv_x + 1];
+    double z;
+    ChVector<> nrm;
+    if (ax >= ay) {
+        // triangle (v0, v1, v3)
+        z = h0 + ax * (h1 - h0) + ay * (h3 - h1);
+        nrm = ChVector<>(-(h1 - h0) / dx, -(h3 - h1) / dy, 1);
+    } else {
+        // triangle (v0, v3, v2)
+        z = h0 + ay * (h2 - h0) + ax * (h3 - h2);
+        nrm = ChVector<>(-(h3 - h2) / dx, -(h2 - h0) / dy, 1);
+    }
+    nrm.Normalize();
+
+    // Account for the sweep sphere radius of the contact mesh
+    z += m_sweep_sphere_radius / nrm.z();
+
+    ChVector<> point = ChWorldFrame::FromISO(ChVector<>(loc_iso.x(), loc_iso.y(), z));
+    height = ChWorldFrame::Height(m_body->TransformPointLocalToParent(point));
+    normal = m_body->TransformDirectionLocalToParent(ChWorldFrame::FromISO(nrm));
+
+    return true;
+}
+
 // -----------------------------------------------------------------------------
 // Export all patch meshes
 // -----------------------------------------------------------------------------
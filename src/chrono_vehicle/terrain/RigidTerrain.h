@@ -24,6 +24,7 @@
 
 #include "chrono/assets/ChColor.h"
 #include "chrono/assets/ChColorAsset.h"
+#include "chrono/core/ChVector2.h"
 #include "chrono/geometry/ChTriangleMeshConnected.h"
 #include "chrono/physics/ChBody.h"
 #include "chrono/physics/ChSystem.h"
@@ -71,13 +72,19 @@ class CH_VEHICLE_API RigidTerrain : public ChTerrain {
 
       protected:
         virtual bool FindPoint(const ChVector<>& loc, double& height, ChVector<>& normal) const = 0;
+        virtual void ComputeFootprint() = 0;
         virtual void ExportMeshPovray(const std::string& out_dir, bool smoothed = false) {}
         virtual void ExportMeshWavefront(const std::string& out_dir) {}
 
+        /// Check if the specified location is above or below the patch footprint.
+        bool InFootprint(const ChVector<>& loc) const;
+
         PatchType m_type;                ///< type of this patch
         std::shared_ptr<ChBody> m_body;  ///< associated body
         float m_friction;                ///< coefficient of friction
         double m_radius;                 ///< bounding sphere radius
+        ChVector2<> m_fp_min;            ///< lower corner of horizontal bounding box (ISO frame)
+        ChVector2<> m_fp_max;            ///< upper corner of horizontal bounding box (ISO frame)
 
         friend class RigidTerrain;
     };
@@ -166,6 +173,20 @@ class CH_VEHICLE_API RigidTerrain : public ChTerrain {
     /// See UseLocationDependentFriction.
     virtual float GetCoefficientFriction(const ChVector<>& loc) const override;
 
+    /// Get the terrain height, normal, and coefficient of friction at the point below the specified location.
+    /// All three quantities are obtained with a single FindPoint call.
+    virtual void GetProperties(const ChVector<>& loc,
+                               double& height,
+                               ChVector<>& normal,
+                               float& friction) const override;
+
+    /// Get the terrain height, normal, and coefficient of friction at the points below the specified locations.
+    /// Each location requires a single FindPoint call (and a call to the friction functor, if one was specified).
+    virtual void GetProperties(const std::vector<ChVector<>>& locs,
+                               std::vector<double>& heights,
+                               std::vector<ChVector<>>& normals,
+                               std::vector<float>& frictions) const override;
+
     /// Export all patch meshes as macros in PovRay include files.
     void ExportMeshPovray(const std::string& out_dir, bool smoothed = false);
 
@@ -173,7 +194,10 @@ class CH_VEHICLE_API RigidTerrain : public ChTerrain {
     void ExportMeshWavefront(const std::string& out_dir);
 
     /// Find the terrain height, normal, and coefficient of friction at the point below the specified location.
-    /// The point on the terrain surface is obtained through ray casting into the terrain contact model.
+    /// Only the patches whose footprint contains the specified location are tested (using a spatial index over the
+    /// patch footprints, built at initialization). For box patches and height-map patches, the point on the terrain
+    /// surface is calculated directly; for general mesh patches, it is obtained through ray casting into the patch
+    /// contact model.
     /// The return value is 'true' if the ray intersection succeeded and 'false' otherwise (in which case
     /// the output is set to heigh=0, normal=[0,0,1], and friction=0.8).
     bool FindPoint(const ChVector<> loc, double& height, ChVector<>& normal, float& friction) const;
@@ -190,6 +214,7 @@ class CH_VEHICLE_API RigidTerrain : public ChTerrain {
         double m_hlength;       ///< patch half-length
         double m_hwidth;        ///< patch half-width
         virtual bool FindPoint(const ChVector<>& loc, double& height, ChVector<>& normal) const override;
+        virtual void ComputeFootprint() override;
     };
 
     /// Patch represented as a mesh.
@@ -197,10 +222,26 @@ class CH_VEHICLE_API RigidTerrain : public ChTerrain {
         std::shared_ptr<geometry::ChTriangleMeshConnected> m_trimesh;  ///< associated mesh
         std::string m_mesh_name;                                       ///< name of associated mesh
         virtual bool FindPoint(const ChVector<>& loc, double& height, ChVector<>& normal) const override;
+        virtual void ComputeFootprint() override;
         virtual void ExportMeshPovray(const std::string& out_dir, bool smoothed = false) override;
         virtual void ExportMeshWavefront(const std::string& out_dir) override;
     };
 
+    /// Patch represented as a mesh generated from a height map.
+    /// Height and normal queries are answered by a direct lookup in the regular grid of mesh vertices, unless the
+    /// patch is tilted with respect to the world vertical (in which case, the ray-casting MeshPatch::FindPoint is
+    /// used).
+    struct CH_VEHICLE_API HeightMapPatch : public MeshPatch {
+        int m_nv_x;                     ///< number of grid vertices in X direction
+        int m_nv_y;                     ///< number of grid vertices in Y direction
+        double m_length;                ///< patch length (X direction)
+        double m_width;                 ///< patch width (Y direction)
+        double m_sweep_sphere_radius;   ///< radius of sweep sphere for the contact mesh
+        bool m_level;                   ///< true if the patch vertical is aligned with the world vertical
+        std::vector<double> m_heights;  ///< vertex heights (ISO frame), ordered as the mesh vertices
+        virtual bool FindPoint(const ChVector<>& loc, double& height, ChVector<>& normal) const override;
+    };
+
     ChSystem* m_system;
     int m_num_patches;
     std::vector<std::shared_ptr<Patch>> m_patches;
@@ -212,7 +253,16 @@ class CH_VEHICLE_API RigidTerrain : public ChTerrain {
                   std::shared_ptr<ChMaterialSurface> material);
     void LoadPatch(const rapidjson::Value& a);
 
+    /// Build a uniform 2D grid index over the patch footprints (ISO horizontal plane).
+    void BuildPatchIndex();
+
     int m_collision_family;
+
+    ChVector2<> m_index_min;                     ///< lower corner of the indexed area
+    double m_index_cell;                         ///< cell size of the patch index
+    int m_index_nx;                              ///< number of index cells in X direction
+    int m_index_ny;                              ///< number of index cells in Y direction
+    std::vector<std::vector<int>> m_index_bins;  ///< indices of patches overlapping each index cell
 };
 
 /// @} vehicle_terrain
@@ -19,7 +19,10 @@
 
 #include <cstdio>
 #include <cmath>
+#include <algorithm>
+#include <climits>
 #include <queue>
+#include <unordered_set>
 
 #include "chrono/physics/ChMaterialSurfaceNSC.h"
 #include "chrono/physics/ChMaterialSurfaceSMC.h"
@@ -60,6 +63,33 @@ float SCMDeformableTerrain::GetCoefficientFriction(const ChVector<>& loc) const
     return m_friction_fun ? (*m_friction_fun)(loc) : 0.8f;
 }
 
+// Return the terrain height, normal, and coefficient of friction at the specified location
+void SCMDeformableTerrain::GetProperties(const ChVector<>& loc,
+                                         double& height,
+                                         ChVector<>& normal,
+                                         float& friction) const {
+    height = m_ground->GetHeight(loc);
+    normal = m_ground->plane.TransformDirectionLocalToParent(ChWorldFrame::Vertical());
+    friction = m_friction_fun ? (*m_friction_fun)(loc) : 0.8f;
+}
+
+// Return the terrain height, normal, and coefficient of friction at the specified locations
+void SCMDeformableTerrain::GetProperties(const std::vector<ChVector<>>& locs,
+                                         std::vector<double>& heights,
+                                         std::vector<ChVector<>>& normals,
+                                         std::vector<float>& frictions) const {
+    size_t n = locs.size();
+    heights.resize(n);
+    normals.assign(n, m_ground->plane.TransformDirectionLocalToParent(ChWorldFrame::Vertical()));
+    frictions.assign(n, 0.8f);
+    for (size_t i = 0; i < n; i++)
+        heights[i] = m_ground->GetHeight(locs[i]);
+    if (m_friction_fun) {
+        for (size_t i = 0; i < n; i++)
+            frictions[i] = (*m_friction_fun)(locs[i]);
+    }
+}
+
 // Set the color of the visualization assets
 void SCMDeformableTerrain::SetColor(ChColor color) {
     if (m_ground->m_color)
@@ -179,6 +209,10 @@ void SCMDeformableTerrain::AddMovingPatch(std::shared_ptr<ChBody> body,
     m_ground->m_moving_patch = true;
 }
 
+void SCMDeformableTerrain::SetRayCastingPatchBodiesOnly(bool val) {
+    m_ground->m_patch_bodies_only = val;
+}
+
 // Set user-supplied callback for evaluating location-dependent soil parameters
 void SCMDeformableTerrain::RegisterSoilParametersCallback(std::shared_ptr<SoilParametersCallback> cb) {
     m_ground->m_soil_fun = cb;
@@ -189,6 +223,11 @@ void SCMDeformableTerrain::Initialize(double height, double sizeX, double sizeY,
     m_ground->Initialize(height, sizeX, sizeY, divX, divY);
 }
 
+// Initialize the terrain as a flat implicit grid
+void SCMDeformableTerrain::Initialize(double height, double sizeX, double sizeY, double delta) {
+    m_ground->Initialize(height, sizeX, sizeY, delta);
+}
+
 // Initialize the terrain from a specified .obj mesh file.
 void SCMDeformableTerrain::Initialize(const std::string& mesh_file) {
     m_ground->Initialize(mesh_file);
@@ -218,6 +257,18 @@ TerrainForce SCMDeformableTerrain::GetContactForce(std::shared_ptr<ChBody> body)
     return frc;
 }
 
+size_t SCMDeformableTerrain::GetNumVertices() const {
+    return m_ground->m_num_vertices;
+}
+
+size_t SCMDeformableTerrain::GetNumRayCasts() const {
+    return m_ground->m_num_ray_casts;
+}
+
+double SCMDeformableTerrain::GetTimerRayCasting() const {
+    return m_ground->m_timer_ray_casting();
+}
+
 void SCMDeformableTerrain::PrintStepStatistics(std::ostream& os) const {
     os << " Timers:" << std::endl;
     os << "   Calculate areas:         " << m_ground->m_timer_calc_areas() << std::endl;
@@ -241,7 +292,8 @@ void SCMDeformableTerrain::PrintStepStatistics(std::ostream& os) const {
 // -----------------------------------------------------------------------------
 
 // Constructor.
-SCMDeformableSoil::SCMDeformableSoil(ChSystem* system, bool visualization_mesh) : m_soil_fun(nullptr) {
+SCMDeformableSoil::SCMDeformableSoil(ChSystem* system, bool visualization_mesh)
+    : m_visualization_mesh(visualization_mesh), m_soil_fun(nullptr) {
     this->SetSystem(system);
 
     // Create the default triangle mesh asset
@@ -288,6 +340,12 @@ SCMDeformableSoil::SCMDeformableSoil(ChSystem* system, bool visualization_mesh)
     last_t = 0;
 
     m_moving_patch = false;
+    m_patch_bodies_only = false;
+
+    m_num_vertices = 0;
+    m_num_faces = 0;
+    m_num_ray_casts = 0;
+    m_num_marked_faces = 0;
 }
 
 // Initialize the terrain as a flat grid
@@ -302,6 +360,10 @@ void SCMDeformableSoil::Initialize(double height, double sizeX, double sizeY, in
     std::vector<ChVector<>>& uv_coords = trimesh->getCoordsUV();
     std::vector<ChVector<float>>& colors = trimesh->getCoordsColors();
 
+    // The mesh uses int indices, so the number of vertices and faces cannot exceed INT_MAX
+    if ((int64_t)(nX + 1) * (nY + 1) > INT_MAX || 2 * (int64_t)nX * nY > INT_MAX)
+        throw ChException("SCMDeformableTerrain: too many grid divisions for a mesh; use an implicit grid instead");
+
     unsigned int nvx = nX + 1;
     unsigned int nvy = nY + 1;
     double dx = sizeX / nX;
@@ -530,10 +592,133 @@ void SCMDeformableSoil::Initialize(const std::string& heightmap_file,
     ////trimesh->WriteWavefront("foo.obj", meshes);
 }
 
+// Initialize the terrain as a flat implicit grid.
+// Only the (optional) visualization mesh is created here; SCM data is allocated as grid nodes get loaded.
+void SCMDeformableSoil::Initialize(double height, double sizeX, double sizeY, double delta) {
+    m_height = height;
+    m_grid_delta = delta;
+    m_grid_nx = (int)std::ceil(sizeX / delta);
+    m_grid_ny = (int)std::ceil(sizeY / delta);
+    m_grid_map.clear();
+    m_grid_loaded.clear();
+
+    auto trimesh = m_trimesh_shape->GetMesh();
+    trimesh->Clear();
+
+    if (m_visualization_mesh) {
+        // The mesh uses int indices, so the number of its vertices and faces cannot exceed INT_MAX
+        if ((int64_t)(m_grid_nx + 1) * (m_grid_ny + 1) > INT_MAX || 2 * (int64_t)m_grid_nx * m_grid_ny > INT_MAX)
+            throw ChException("SCMDeformableTerrain: grid too large for a visualization mesh; construct the terrain "
+                              "without visualization mesh");
+
+        // Readability aliases
+        std::vector<ChVector<>>& vertices = trimesh->getCoordsVertices();
+        std::vector<ChVector<>>& normals = trimesh->getCoordsNormals();
+        std::vector<ChVector<int>>& idx_vertices = trimesh->getIndicesVertexes();
+        std::vector<ChVector<int>>& idx_normals = trimesh->getIndicesNormals();
+        std::vector<ChVector<>>& uv_coords = trimesh->getCoordsUV();
+
+        int nvx = m_grid_nx + 1;
+        int nvy = m_grid_ny + 1;
+        vertices.resize(nvx * nvy);
+        normals.resize(nvx * nvy);
+        uv_coords.resize(nvx * nvy);
+        idx_vertices.resize(2 * m_grid_nx * m_grid_ny);
+        idx_normals.resize(2 * m_grid_nx * m_grid_ny);
+
+        // Vertices are ordered row after row, starting at the (-X,-Y) corner (see GetGridNodeIndex)
+        for (int iy = 0; iy < nvy; iy++) {
+            for (int ix = 0; ix < nvx; ix++) {
+                int iv = (int)GetGridNodeIndex(ChVector2<int>(ix, iy));
+                vertices[iv] = GetGridNodePoint(ChVector2<int>(ix, iy), m_height);
+                normals[iv] = plane.TransformDirectionLocalToParent(ChVector<>(0, 0, 1));
+                uv_coords[iv] = ChVector<>(ix / (double)m_grid_nx, iy / (double)m_grid_ny, 0);
+            }
+        }
+
+        int it = 0;
+        for (int iy = 0; iy < m_grid_ny; iy++) {
+            for (int ix = 0; ix < m_grid_nx; ix++) {
+                int v0 = (int)GetGridNodeIndex(ChVector2<int>(ix, iy));
+                idx_vertices[it] = ChVector<int>(v0, v0 + 1, v0 + nvx + 1);
+                idx_normals[it] = ChVector<int>(v0, v0 + 1, v0 + nvx + 1);
+                ++it;
+                idx_vertices[it] = ChVector<int>(v0, v0 + nvx + 1, v0 + nvx);
+                idx_normals[it] = ChVector<int>(v0, v0 + nvx + 1, v0 + nvx);
+                ++it;
+            }
+        }
+    }
+
+    // Release the per-vertex data and topology used by the mesh-based representations
+    p_vertices_initial = std::vector<ChVector<>>();
+    p_speeds = std::vector<ChVector<>>();
+    p_level = std::vector<double>();
+    p_level_initial = std::vector<double>();
+    p_hit_level = std::vector<double>();
+    p_sinkage = std::vector<double>();
+    p_sinkage_plastic = std::vector<double>();
+    p_sinkage_elastic = std::vector<double>();
+    p_step_plastic_flow = std::vector<double>();
+    p_kshear = std::vector<double>();
+    p_area = std::vector<double>();
+    p_sigma = std::vector<double>();
+    p_sigma_yeld = std::vector<double>();
+    p_tau = std::vector<double>();
+    p_massremainder = std::vector<double>();
+    p_id_island = std::vector<int>();
+    p_erosion = std::vector<bool>();
+    connected_vertexes = std::vector<std::set<int>>();
+    tri_map = std::vector<std::array<int, 4>>();
+
+    m_type = PatchType::GRID;
+}
+
+SCMDeformableSoil::NodeRecord::NodeRecord(double init_level)
+    : level(init_level),
+      level_initial(init_level),
+      hit_level(1e9),
+      sinkage(0),
+      sinkage_plastic(0),
+      sinkage_elastic(0),
+      step_plastic_flow(0),
+      sigma(0),
+      sigma_yeld(0),
+      kshear(0),
+      tau(0) {}
+
+double SCMDeformableSoil::GetGridNodeLevel(const ChVector2<int>& node) const {
+    auto itr = m_grid_map.find(GetGridNodeIndex(node));
+    return (itr == m_grid_map.end()) ? m_height : itr->second.level;
+}
+
+ChVector<> SCMDeformableSoil::GetGridNodePoint(const ChVector2<int>& node, double level) const {
+    double x = (node.x() - 0.5 * m_grid_nx) * m_grid_delta;
+    double y = (node.y() - 0.5 * m_grid_ny) * m_grid_delta;
+    return plane * ChVector<>(x, y, level);
+}
+
 // Return the terrain height at the specified location
 double SCMDeformableSoil::GetHeight(const ChVector<>& loc) const {
-    //// TODO
-    return 0;
+    //// TODO: mesh-based representations
+    if (m_type != PatchType::GRID)
+        return 0;
+
+    // Bilinear interpolation of the current node levels in the grid cell containing the given location
+    ChVector<> loc_plane = plane.TransformPointParentToLocal(loc);
+    double xi = ChClamp(loc_plane.x() / m_grid_delta + 0.5 * m_grid_nx, 0.0, (double)m_grid_nx);
+    double yi = ChClamp(loc_plane.y() / m_grid_delta + 0.5 * m_grid_ny, 0.0, (double)m_grid_ny);
+    int ix = std::min((int)xi, m_grid_nx - 1);
+    int iy = std::min((int)yi, m_grid_ny - 1);
+    double ax = xi - ix;
+    double ay = yi - iy;
+
+    double level = (1 - ax) * (1 - ay) * GetGridNodeLevel(ChVector2<int>(ix, iy)) +
+                   ax * (1 - ay) * GetGridNodeLevel(ChVector2<int>(ix + 1, iy)) +
+                   (1 - ax) * ay * GetGridNodeLevel(ChVector2<int>(ix, iy + 1)) +
+                   ax * ay * GetGridNodeLevel(ChVector2<int>(ix + 1, iy + 1));
+
+    return ChWorldFrame::Height(plane * ChVector<>(loc_plane.x(), loc_plane.y(), level));
 }
 
 // Set up auxiliary data structures.
@@ -580,6 +765,446 @@ void SCMDeformableSoil::SetupAuxData() {
     m_trimesh_shape->GetMesh()->ComputeNeighbouringTriangleMap(this->tri_map);
 }
 
+// Create a load for the given force on the hit contactable and accumulate the resultant contact force.
+void SCMDeformableSoil::AddContactForce(ChContactable* contactable, const ChVector<>& force, const ChVector<>& point) {
+    if (ChBody* rigidbody = dynamic_cast<ChBody*>(contactable)) {
+        // [](){} Trick: no deletion for this shared ptr, since 'rigidbody' was not a new ChBody()
+        // object, but an already used pointer because mrayhit_result.hitModel->GetPhysicsItem()
+        // cannot return it as shared_ptr, as needed by the ChLoadBodyForce:
+        std::shared_ptr<ChBody> srigidbody(rigidbody, [](ChBody*) {});
+        std::shared_ptr<ChLoadBodyForce> mload(new ChLoadBodyForce(srigidbody, force, false, point, false));
+        this->Add(mload);
+
+        // Accumulate contact force for this rigid body.
+        // The resultant force is assumed to be applied at the body COM.
+        // All components of the generalized terrain force are expressed in the global frame.
+        auto itr = m_contact_forces.find(contactable);
+        if (itr == m_contact_forces.end()) {
+            // Create new entry and initialize generalized force.
+            TerrainForce frc;
+            frc.point = srigidbody->GetPos();
+            frc.force = force;
+            frc.moment = Vcross(Vsub(point, srigidbody->GetPos()), force);
+            m_contact_forces.insert(std::make_pair(contactable, frc));
+        } else {
+            // Update generalized force.
+            itr->second.force += force;
+            itr->second.moment += Vcross(Vsub(point, srigidbody->GetPos()), force);
+        }
+    } else if (ChLoadableUV* surf = dynamic_cast<ChLoadableUV*>(contactable)) {
+        // [](){} Trick: no deletion for this shared ptr
+        std::shared_ptr<ChLoadableUV> ssurf(surf, [](ChLoadableUV*) {});
+        std::shared_ptr<ChLoad<ChLoaderForceOnSurface>> mload(new ChLoad<ChLoaderForceOnSurface>(ssurf));
+        mload->loader.SetForce(force);
+        mload->loader.SetApplication(0.5, 0.5);  //***TODO*** set UV, now just in middle
+        this->Add(mload);
+
+        // Accumulate contact forces for this surface.
+        //// TODO
+    }
+}
+
+
+// Cast the given rays using the batched ray-hit test of the collision system, in parallel with the number of threads
+// set for the containing system. If so requested, only the collision models of the moving patch bodies are tested.
+void SCMDeformableSoil::CastRays(const std::vector<ChVector<>>& from,
+                                 const std::vector<ChVector<>>& to,
+                                 std::vector<collision::ChCollisionSystem::ChRayhitResult>& results) {
+    std::vector<collision::ChCollisionModel*> models;
+    if (m_moving_patch && m_patch_bodies_only) {
+        for (const auto& p : m_patches) {
+            auto model = p.m_body->GetCollisionModel().get();
+            if (std::find(models.begin(), models.end(), model) == models.end())
+                models.push_back(model);
+        }
+    }
+
+    GetSystem()->GetCollisionSystem()->RayHitBatch(from, to, models, results, GetSystem()->GetNumThreads());
+}
+
+// Update the extent of the moving patches (expressed in the reference plane).
+void SCMDeformableSoil::UpdateMovingPatches() {
+    for (auto& p : m_patches) {
+        ChVector<> center_abs = p.m_body->GetFrame_REF_to_abs().TransformPointLocalToParent(p.m_point);
+        ChVector<> center_loc = plane.TransformPointParentToLocal(center_abs);
+
+        p.m_min.x() = center_loc.x() - p.m_dim.x() / 2;
+        p.m_min.y() = center_loc.y() - p.m_dim.y() / 2;
+        p.m_max.x() = center_loc.x() + p.m_dim.x() / 2;
+        p.m_max.y() = center_loc.y() + p.m_dim.y() / 2;
+    }
+}
+
+// Set the active patches to the bounding boxes of all colliding, non-fixed bodies in the system (expressed in the
+// reference plane and inflated by one grid spacing). Used for the implicit grid if no moving patches are defined.
+void SCMDeformableSoil::UpdateBodyPatches() {
+    m_patches.clear();
+    for (const auto& body : GetSystem()->Get_bodylist()) {
+        if (!body->GetCollide() || body->GetBodyFixed() || !body->GetCollisionModel())
+            continue;
+        ChVector<> bbmin;
+        ChVector<> bbmax;
+        body->GetCollisionModel()->GetAABB(bbmin, bbmax);
+        MovingPatchInfo p;
+        p.m_body = body;
+        p.m_min = ChVector2<>(+1e30, +1e30);
+        p.m_max = ChVector2<>(-1e30, -1e30);
+        for (int k = 0; k < 8; k++) {
+            ChVector<> corner((k & 1) ? bbmax.x() : bbmin.x(), (k & 2) ? bbmax.y() : bbmin.y(),
+                              (k & 4) ? bbmax.z() : bbmin.z());
+            ChVector<> corner_loc = plane.TransformPointParentToLocal(corner);
+            p.m_min.x() = std::min(p.m_min.x(), corner_loc.x() - m_grid_delta);
+            p.m_min.y() = std::min(p.m_min.y(), corner_loc.y() - m_grid_delta);
+            p.m_max.x() = std::max(p.m_max.x(), corner_loc.x() + m_grid_delta);
+            p.m_max.y() = std::max(p.m_max.y(), corner_loc.y() + m_grid_delta);
+        }
+        m_patches.push_back(p);
+    }
+}
+
+// Get the false color of a grid node for the current plot type.
+ChColor SCMDeformableSoil::GetGridNodeColor(const NodeRecord& nr) const {
+    switch (plot_type) {
+        case SCMDeformableTerrain::PLOT_LEVEL:
+            return ChColor::ComputeFalseColor(nr.level, plot_v_min, plot_v_max);
+        case SCMDeformableTerrain::PLOT_LEVEL_INITIAL:
+            return ChColor::ComputeFalseColor(nr.level_initial, plot_v_min, plot_v_max);
+        case SCMDeformableTerrain::PLOT_SINKAGE:
+            return ChColor::ComputeFalseColor(nr.sinkage, plot_v_min, plot_v_max);
+        case SCMDeformableTerrain::PLOT_SINKAGE_ELASTIC:
+            return ChColor::ComputeFalseColor(nr.sinkage_elastic, plot_v_min, plot_v_max);
+        case SCMDeformableTerrain::PLOT_SINKAGE_PLASTIC:
+            return ChColor::ComputeFalseColor(nr.sinkage_plastic, plot_v_min, plot_v_max);
+        case SCMDeformableTerrain::PLOT_STEP_PLASTIC_FLOW:
+            return ChColor::ComputeFalseColor(nr.step_plastic_flow, plot_v_min, plot_v_max);
+        case SCMDeformableTerrain::PLOT_K_JANOSI:
+            return ChColor::ComputeFalseColor(nr.kshear, plot_v_min, plot_v_max);
+        case SCMDeformableTerrain::PLOT_PRESSURE:
+            return ChColor::ComputeFalseColor(nr.sigma, plot_v_min, plot_v_max);
+        case SCMDeformableTerrain::PLOT_PRESSURE_YELD:
+            return ChColor::ComputeFalseColor(nr.sigma_yeld, plot_v_min, plot_v_max);
+        case SCMDeformableTerrain::PLOT_SHEAR:
+            return ChColor::ComputeFalseColor(nr.tau, plot_v_min, plot_v_max);
+        case SCMDeformableTerrain::PLOT_IS_TOUCHED:
+            return nr.sigma > 0 ? ChColor(1, 0, 0) : ChColor(0, 0, 1);
+        default:
+            // Quantities not tracked on the implicit grid (mass remainder, island ID)
+            return ChColor(0, 0, 1);
+    }
+}
+
+// Implementation of ComputeInternalForces for the implicit grid.
+// Same SCM model as for the mesh-based representation, but all per-node data is kept in a hash map which only
+// contains the grid nodes that were ever loaded. Ray casts are limited to the grid nodes in the moving patches
+// (if enabled) and there is no mesh refinement or bulldozing.
+void SCMDeformableSoil::ComputeInternalForcesGrid() {
+    // Readability aliases
+    auto trimesh = m_trimesh_shape->GetMesh();
+    std::vector<ChVector<>>& vertices = trimesh->getCoordsVertices();
+    std::vector<ChVector<>>& normals = trimesh->getCoordsNormals();
+    std::vector<ChVector<float>>& colors = trimesh->getCoordsColors();
+
+    //
+    // Reset the load list and map of contact forces
+    //
+
+    this->GetLoadList().clear();
+    m_contact_forces.clear();
+
+    ChVector<> N = plane.TransformDirectionLocalToParent(ChVector<>(0, 0, 1));
+    double area = m_grid_delta * m_grid_delta;
+
+    //
+    // Perform ray casting test to detect the contact point sinkage
+    //
+
+    m_timer_ray_casting.start();
+    m_num_ray_casts = 0;
+
+    // Reset the SCM quantities at the grid nodes loaded at the previous step
+    std::vector<ChVector2<int>> previously_loaded;
+    previously_loaded.swap(m_grid_loaded);
+    for (const auto& node : previously_loaded) {
+        auto& nr = m_grid_map.at(GetGridNodeIndex(node));
+        nr.sigma = 0;
+        nr.sinkage_elastic = 0;
+        nr.step_plastic_flow = 0;
+        nr.hit_level = 1e9;
+    }
+
+    // Collect the ranges of grid nodes to be ray cast: the grid nodes inside the moving patches (if enabled) or
+    // below the bounding boxes of the colliding bodies. The entire grid is used only if the system contains FEA meshes
+    // (whose contact surfaces have no readily available bounding box) and no moving patches were defined.
+    std::vector<std::pair<ChVector2<int>, ChVector2<int>>> ranges;
+    if (m_moving_patch || GetSystem()->Get_meshlist().empty()) {
+        if (m_moving_patch)
+            UpdateMovingPatches();
+        else
+            UpdateBodyPatches();
+        for (const auto& p : m_patches) {
+            int x_min = (int)std::ceil(p.m_min.x() / m_grid_delta + 0.5 * m_grid_nx);
+            int y_min = (int)std::ceil(p.m_min.y() / m_grid_delta + 0.5 * m_grid_ny);
+            int x_max = (int)std::floor(p.m_max.x() / m_grid_delta + 0.5 * m_grid_nx);
+            int y_max = (int)std::floor(p.m_max.y() / m_grid_delta + 0.5 * m_grid_ny);
+            ChClampValue(x_min, 0, m_grid_nx);
+            ChClampValue(y_min, 0, m_grid_ny);
+            ChClampValue(x_max, 0, m_grid_nx);
+            ChClampValue(y_max, 0, m_grid_ny);
+            ranges.push_back(std::make_pair(ChVector2<int>(x_min, y_min), ChVector2<int>(x_max, y_max)));
+        }
+    } else {
+        ranges.push_back(std::make_pair(ChVector2<int>(0, 0), ChVector2<int>(m_grid_nx, m_grid_ny)));
+    }
+
+    // Collect the rays to be cast from the grid nodes in the above ranges.
+    // Overlapping moving patches are handled by skipping nodes already collected.
+    std::unordered_set<ChVector2<int>, GridHash> ray_node_set;
+    std::vector<ChVector2<int>> ray_nodes;
+    std::vector<ChVector<>> ray_from;
+    std::vector<ChVector<>> ray_to;
+
+    for (const auto& r : ranges) {
+        for (int ix = r.first.x(); ix <= r.second.x(); ix++) {
+            for (int iy = r.first.y(); iy <= r.second.y(); iy++) {
+                ChVector2<int> node(ix, iy);
+                if (!ray_node_set.insert(node).second)
+                    continue;
+                ChVector<> to = GetGridNodePoint(node, GetGridNodeLevel(node)) + N * test_high_offset;
+                ray_nodes.push_back(node);
+                ray_from.push_back(to - N * test_low_offset);
+                ray_to.push_back(to);
+            }
+        }
+    }
+
+    // Cast all rays (in parallel) and record hits in a map (key: grid node).
+    struct HitRecord {
+        ChContactable* contactable;  // pointer to hit object
+        ChVector<> abs_point;        // hit point, expressed in global frame
+        int patch_id;                // index of associated patch id
+    };
+    std::unordered_map<ChVector2<int>, HitRecord, GridHash> hits;
+
+    std::vector<collision::ChCollisionSystem::ChRayhitResult> ray_results;
+    CastRays(ray_from, ray_to, ray_results);
+    m_num_ray_casts = ray_results.size();
+    for (size_t k = 0; k < ray_results.size(); k++) {
+        if (ray_results[k].hit) {
+            HitRecord record = {ray_results[k].hitModel->GetContactable(), ray_results[k].abs_hitPoint, -1};
+            hits.insert(std::make_pair(ray_nodes[k], record));
+        }
+    }
+
+    // Loop through all hit nodes and determine to which contact patch they belong.
+    // Use a queue-based flood-filling algorithm, with the same connectivity as the visualization mesh.
+    static const int nbr_x[6] = {-1, 1, 0, 0, -1, 1};
+    static const int nbr_y[6] = {0, 0, -1, 1, -1, 1};
+    int num_patches = 0;
+    for (auto& h : hits) {
+        if (h.second.patch_id != -1)  // move on if node already assigned to a patch
+            continue;
+        std::queue<ChVector2<int>> todo;
+        h.second.patch_id = num_patches++;  // assign this node to a new patch
+        todo.push(h.first);                 // add node to end of queue
+        while (!todo.empty()) {
+            auto crt = todo.front();  // current node is first element in queue
+            todo.pop();
+            for (int k = 0; k < 6; k++) {
+                auto nbr = hits.find(ChVector2<int>(crt.x() + nbr_x[k], crt.y() + nbr_y[k]));
+                if (nbr == hits.end() || nbr->second.patch_id != -1)
+                    continue;
+                nbr->second.patch_id = h.second.patch_id;  // assign neighbor to same patch
+                todo.push(nbr->first);                     // add neighbor to end of queue
+            }
+        }
+    }
+
+    // Collect hit nodes assigned to each patch.
+    struct PatchRecord {
+        std::vector<ChVector2<>> points;  // points in patch (projected on reference plane)
+        double area;                      // patch area
+        double perimeter;                 // patch perimeter
+        double oob;                       // approximate value of 1/b
+    };
+    std::vector<PatchRecord> patches(num_patches);
+    for (auto& h : hits) {
+        ChVector2<> p((h.first.x() - 0.5 * m_grid_nx) * m_grid_delta, (h.first.y() - 0.5 * m_grid_ny) * m_grid_delta);
+        patches[h.second.patch_id].points.push_back(p);
+    }
+
+    // Calculate area and perimeter of each patch.
+    // Calculate approximation to Beker term 1/b.
+    for (auto& p : patches) {
+        utils::ChConvexHull2D ch(p.points);
+        p.area = ch.GetArea();
+        p.perimeter = ch.GetPerimeter();
+        if (p.area < 1e-6) {
+            p.oob = 0;
+        } else {
+            p.oob = p.perimeter / (2 * p.area);
+        }
+    }
+
+    // Initialize local values for the soil parameters
+    double Bekker_Kphi = m_Bekker_Kphi;
+    double Bekker_Kc = m_Bekker_Kc;
+    double Bekker_n = m_Bekker_n;
+    double Mohr_cohesion = m_Mohr_cohesion;
+    double Mohr_friction = m_Mohr_friction;
+    double Janosi_shear = m_Janosi_shear;
+    double elastic_K = m_elastic_K;
+    double damping_R = m_damping_R;
+
+    // Process only hit nodes
+    for (auto& h : hits) {
+        const ChVector2<int>& node = h.first;
+        ChContactable* contactable = h.second.contactable;
+        const ChVector<>& abs_point = h.second.abs_point;
+        int patch_id = h.second.patch_id;
+
+        auto loc_point = plane.TransformParentToLocal(abs_point);
+
+        if (m_soil_fun) {
+            m_soil_fun->Set(loc_point.x(), loc_point.y());
+
+            Bekker_Kphi = m_soil_fun->m_Bekker_Kphi;
+            Bekker_Kc = m_soil_fun->m_Bekker_Kc;
+            Bekker_n = m_soil_fun->m_Bekker_n;
+            Mohr_cohesion = m_soil_fun->m_Mohr_cohesion;
+            Mohr_friction = m_soil_fun->m_Mohr_friction;
+            Janosi_shear = m_soil_fun->m_Janosi_shear;
+            elastic_K = m_soil_fun->m_elastic_K;
+            damping_R = m_soil_fun->m_damping_R;
+        }
+
+        // Work on a copy of the node record (a new record if this node was never loaded before); the record is
+        // stored in the map only if the node is loaded.
+        int64_t node_index = GetGridNodeIndex(node);
+        auto itr = m_grid_map.find(node_index);
+        NodeRecord nr = (itr == m_grid_map.end()) ? NodeRecord(m_height) : itr->second;
+
+        nr.hit_level = loc_point.z();
+        double hit_offset = -nr.hit_level + nr.level_initial;
+
+        ChVector<> point = GetGridNodePoint(node, nr.level);
+        ChVector<> speed = contactable->GetContactPointSpeed(point);
+
+        ChVector<> T = -speed;
+        T = plane.TransformDirectionParentToLocal(T);
+        double Vn = -T.z();
+        T.z() = 0;
+        T = plane.TransformDirectionLocalToParent(T);
+        T.Normalize();
+
+        // Elastic try:
+        nr.sigma = elastic_K * (hit_offset - nr.sinkage_plastic);
+
+        // Handle unilaterality:
+        if (nr.sigma < 0)
+            continue;
+
+        nr.sinkage = hit_offset;
+        nr.level = nr.hit_level;
+
+        // Accumulate shear for Janosi-Hanamoto
+        nr.kshear += Vdot(speed, -T) * GetSystem()->GetStep();
+
+        // Plastic correction:
+        if (nr.sigma > nr.sigma_yeld) {
+            // Bekker formula
+            nr.sigma = (patches[patch_id].oob * Bekker_Kc + Bekker_Kphi) * pow(nr.sinkage, Bekker_n);
+            nr.sigma_yeld = nr.sigma;
+            double old_sinkage_plastic = nr.sinkage_plastic;
+            nr.sinkage_plastic = nr.sinkage - nr.sigma / elastic_K;
+            nr.step_plastic_flow = (nr.sinkage_plastic - old_sinkage_plastic) / GetSystem()->GetStep();
+        }
+
+        nr.sinkage_elastic = nr.sinkage - nr.sinkage_plastic;
+
+        // add compressive speed-proportional damping (not clamped by pressure yield)
+        nr.sigma += -Vn * damping_R;
+
+        // Mohr-Coulomb
+        double tau_max = Mohr_cohesion + nr.sigma * tan(Mohr_friction * CH_C_DEG_TO_RAD);
+
+        // Janosi-Hanamoto
+        nr.tau = tau_max * (1.0 - exp(-(nr.kshear / Janosi_shear)));
+
+        ChVector<> Fn = N * area * nr.sigma;
+        ChVector<> Ft = T * area * nr.tau;
+
+        AddContactForce(contactable, Fn + Ft, point);
+
+        // Store the updated node record and mark the node as loaded
+        if (itr == m_grid_map.end())
+            m_grid_map.insert(std::make_pair(node_index, nr));
+        else
+            itr->second = nr;
+        m_grid_loaded.push_back(node);
+
+    }  // end loop on ray hits
+
+    m_timer_ray_casting.stop();
+
+    m_num_vertices = m_grid_map.size();
+    m_num_faces = 0;
+    m_num_marked_faces = 0;
+
+    //
+    // Update the visualization mesh (only at nodes loaded at this or at the previous step)
+    //
+
+    m_timer_visualization.start();
+
+    if (m_visualization_mesh && !vertices.empty()) {
+        m_num_faces = trimesh->getIndicesVertexes().size();
+
+        if (plot_type != SCMDeformableTerrain::PLOT_NONE) {
+            if (colors.size() != vertices.size()) {
+                ChColor mcolor = GetGridNodeColor(NodeRecord(m_height));
+                colors.assign(vertices.size(), ChVector<float>(mcolor.R, mcolor.G, mcolor.B));
+                for (const auto& nr : m_grid_map) {
+                    mcolor = GetGridNodeColor(nr.second);
+                    colors[(int)nr.first] = {mcolor.R, mcolor.G, mcolor.B};
+                }
+            }
+        } else {
+            colors.clear();
+        }
+
+        std::vector<ChVector2<int>> modified(m_grid_loaded);
+        modified.insert(modified.end(), previously_loaded.begin(), previously_loaded.end());
+
+        for (const auto& node : modified) {
+            int64_t iv = GetGridNodeIndex(node);
+            const auto& nr = m_grid_map.at(iv);
+            vertices[iv] = GetGridNodePoint(node, nr.level);
+
+            // Update the normals at this node and its neighbors (central differences of node levels)
+            for (int k = 0; k < 5; k++) {
+                int x = node.x() + (k == 1) - (k == 2);
+                int y = node.y() + (k == 3) - (k == 4);
+                if (x < 0 || x > m_grid_nx || y < 0 || y > m_grid_ny)
+                    continue;
+                double hE = GetGridNodeLevel(ChVector2<int>(std::min(x + 1, m_grid_nx), y));
+                double hW = GetGridNodeLevel(ChVector2<int>(std::max(x - 1, 0), y));
+                double hN = GetGridNodeLevel(ChVector2<int>(x, std::min(y + 1, m_grid_ny)));
+                double hS = GetGridNodeLevel(ChVector2<int>(x, std::max(y - 1, 0)));
+                ChVector<> nrm(hW - hE, hS - hN, 2 * m_grid_delta);
+                normals[(int)GetGridNodeIndex(ChVector2<int>(x, y))] =
+                    plane.TransformDirectionLocalToParent(nrm.GetNormalized());
+            }
+
+            if (!colors.empty()) {
+                ChColor mcolor = GetGridNodeColor(nr);
+                colors[iv] = {mcolor.R, mcolor.G, mcolor.B};
+            }
+        }
+    }
+
+    m_timer_visualization.stop();
+}
+
 // Reset the list of forces, and fills it with forces from a soil contact model.
 void SCMDeformableSoil::ComputeInternalForces() {
     m_timer_calc_areas.reset();
@@ -588,6 +1213,11 @@ void SCMDeformableSoil::ComputeInternalForces() {
     m_timer_bulldozing.reset();
     m_timer_visualization.reset();
 
+    if (m_type == PatchType::GRID) {
+        ComputeInternalForcesGrid();
+        return;
+    }
+
     // Readability aliases
     auto trimesh = m_trimesh_shape->GetMesh();
     std::vector<ChVector<>>& vertices = trimesh->getCoordsVertices();
@@ -641,30 +1271,16 @@ void SCMDeformableSoil::ComputeInternalForces() {
     m_num_ray_casts = 0;
 
     // If enabled, update the extent of the moving patches (no ray-hit tests performed outside)
-    if (m_moving_patch) {
-        for (auto& p : m_patches) {
-            ChVector<> center_abs = p.m_body->GetFrame_REF_to_abs().TransformPointLocalToParent(p.m_point);
-            ChVector<> center_loc = plane.TransformPointParentToLocal(center_abs);
-
-            p.m_min.x() = center_loc.x() - p.m_dim.x() / 2;
-            p.m_min.y() = center_loc.y() - p.m_dim.y() / 2;
-            p.m_max.x() = center_loc.x() + p.m_dim.x() / 2;
-            p.m_max.y() = center_loc.y() + p.m_dim.y() / 2;
-           
-        }
-    }
+    if (m_moving_patch)
+        UpdateMovingPatches();
 
     // Loop through all vertices.
     // - set default SCM quantities (in case no ray-hit)
     // - skip vertices outside moving patch (if option enabled)
-    // - cast ray and record result in a map (key: vertex index)
-    // - initialize patch id to -1 (not set)
-    struct HitRecord {
-        ChContactable* contactable;  // pointer to hit object
-        ChVector<> abs_point;        // hit point, expressed in global frame
-        int patch_id;                // index of associated patch id
-    };
-    std::unordered_map<int, HitRecord> hits;
+    // - collect ray to be cast from current vertex
+    std::vector<int> ray_vertices;
+    std::vector<ChVector<>> ray_from;
+    std::vector<ChVector<>> ray_to;
 
     for (int i = 0; i < vertices.size(); ++i) {
         auto v = plane.TransformParentToLocal(vertices[i]);
@@ -690,15 +1306,29 @@ void SCMDeformableSoil::ComputeInternalForces() {
                 continue;
         }
 
-        // Perform ray casting from current vertex
-        collision::ChCollisionSystem::ChRayhitResult mrayhit_result;
+        // Ray from current vertex
         ChVector<> to = vertices[i] + N * test_high_offset;
-        ChVector<> from = to - N * test_low_offset;
-        this->GetSystem()->GetCollisionSystem()->RayHit(from, to, mrayhit_result);
-        m_num_ray_casts++;
-        if (mrayhit_result.hit) {
-            HitRecord record = {mrayhit_result.hitModel->GetContactable(), mrayhit_result.abs_hitPoint, -1};
-            hits.insert(std::make_pair(i, record));
+        ray_vertices.push_back(i);
+        ray_from.push_back(to - N * test_low_offset);
+        ray_to.push_back(to);
+    }
+
+    // Cast all rays (in parallel) and record hits in a map (key: vertex index).
+    // Initialize patch id to -1 (not set).
+    struct HitRecord {
+        ChContactable* contactable;  // pointer to hit object
+        ChVector<> abs_point;        // hit point, expressed in global frame
+        int patch_id;                // index of associated patch id
+    };
+    std::unordered_map<int, HitRecord> hits;
+
+    std::vector<collision::ChCollisionSystem::ChRayhitResult> ray_results;
+    CastRays(ray_from, ray_to, ray_results);
+    m_num_ray_casts = ray_results.size();
+    for (size_t k = 0; k < ray_results.size(); k++) {
+        if (ray_results[k].hit) {
+            HitRecord record = {ray_results[k].hitModel->GetContactable(), ray_results[k].abs_hitPoint, -1};
+            hits.insert(std::make_pair(ray_vertices[k], record));
         }
     }
 
@@ -849,44 +1479,7 @@ void SCMDeformableSoil::ComputeInternalForces() {
             Fn = N * p_area[i] * p_sigma[i];
             Ft = T * p_area[i] * p_tau[i];
 
-            if (ChBody* rigidbody = dynamic_cast<ChBody*>(contactable)) {
-                // [](){} Trick: no deletion for this shared ptr, since 'rigidbody' was not a new ChBody()
-                // object, but an already used pointer because mrayhit_result.hitModel->GetPhysicsItem()
-                // cannot return it as shared_ptr, as needed by the ChLoadBodyForce:
-                std::shared_ptr<ChBody> srigidbody(rigidbody, [](ChBody*) {});
-                std::shared_ptr<ChLoadBodyForce> mload(
-                    new ChLoadBodyForce(srigidbody, Fn + Ft, false, vertices[i], false));
-                this->Add(mload);
-
-                // Accumulate contact force for this rigid body.
-                // The resultant force is assumed to be applied at the body COM.
-                // All components of the generalized terrain force are expressed in the global frame.
-                auto itr = m_contact_forces.find(contactable);
-                if (itr == m_contact_forces.end()) {
-                    // Create new entry and initialize generalized force.
-                    ChVector<> force = Fn + Ft;
-                    TerrainForce frc;
-                    frc.point = srigidbody->GetPos();
-                    frc.force = force;
-                    frc.moment = Vcross(Vsub(vertices[i], srigidbody->GetPos()), force);
-                    m_contact_forces.insert(std::make_pair(contactable, frc));
-                } else {
-                    // Update generalized force.
-                    ChVector<> force = Fn + Ft;
-                    itr->second.force += force;
-                    itr->second.moment += Vcross(Vsub(vertices[i], srigidbody->GetPos()), force);
-                }
-            } else if (ChLoadableUV* surf = dynamic_cast<ChLoadableUV*>(contactable)) {
-                // [](){} Trick: no deletion for this shared ptr
-                std::shared_ptr<ChLoadableUV> ssurf(surf, [](ChLoadableUV*) {});
-                std::shared_ptr<ChLoad<ChLoaderForceOnSurface>> mload(new ChLoad<ChLoaderForceOnSurface>(ssurf));
-                mload->loader.SetForce(Fn + Ft);
-                mload->loader.SetApplication(0.5, 0.5);  //***TODO*** set UV, now just in middle
-                this->Add(mload);
-
-                // Accumulate contact forces for this surface.
-                //// TODO
-            }
+            AddContactForce(contactable, Fn + Ft, vertices[i]);
 
             // Update mesh representation
             vertices[i] = p_vertices_initial[i] - N * p_sinkage[i];
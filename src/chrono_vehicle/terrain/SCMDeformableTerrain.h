@@ -20,6 +20,7 @@
 #ifndef SCM_DEFORMABLE_TERRAIN_H
 #define SCM_DEFORMABLE_TERRAIN_H
 
+#include <cstdint>
 #include <set>
 #include <string>
 #include <unordered_map>
@@ -32,6 +33,7 @@
 #include "chrono/physics/ChLoadsBody.h"
 #include "chrono/physics/ChSystem.h"
 #include "chrono/core/ChTimer.h"
+#include "chrono/core/ChVector2.h"
 
 #include "chrono_vehicle/ChApiVehicle.h"
 #include "chrono_vehicle/ChSubsysDefs.h"
@@ -143,7 +145,8 @@ class CH_VEHICLE_API SCMDeformableTerrain : public ChTerrain {
 
     /// Add a new moving patch.
     /// Multiple calls to this function can be made, each of them adding a new active patch area.
-    /// If no patches are defined, ray-casting is performed for every single node of the underlying SCM mesh.
+    /// If no patches are defined, ray-casting is performed for every single node of the underlying SCM mesh (for a
+    /// terrain on an implicit grid, only for the grid nodes below the colliding bodies; see Initialize).
     /// If at least one patch is defined, ray-casting is performed only for mesh nodes within the patch areas
     /// (that is, nodes that are within the specified range from the given point on the associated body).
     void AddMovingPatch(std::shared_ptr<ChBody> body,     ///< [in] monitored body
@@ -152,6 +155,12 @@ class CH_VEHICLE_API SCMDeformableTerrain : public ChTerrain {
                         double dimY                       ///< [in] patch Y dimension
     );
 
+    /// Restrict ray casting to the bodies associated with the moving patches (default: false).
+    /// If enabled, rays are tested directly against the collision models of these bodies only, which is much faster
+    /// than a ray cast against the entire collision system. Only use this option if all bodies that may interact
+    /// with the terrain were passed to AddMovingPatch (e.g., one patch per wheel or track shoe).
+    void SetRayCastingPatchBodiesOnly(bool val);
+
     /// Class to be used as a callback interface for location-dependent soil parameters.
     /// A derived class must implement Set() and set **all** soil parameters (no defaults are provided).
     class CH_VEHICLE_API SoilParametersCallback {
@@ -192,6 +201,21 @@ class CH_VEHICLE_API SCMDeformableTerrain : public ChTerrain {
     /// Otherwise, it returns the constant value of 0.8.
     virtual float GetCoefficientFriction(const ChVector<>& loc) const override;
 
+    /// Get the terrain height, normal, and coefficient of friction at the point below the specified location.
+    /// Returns the interpolated grid height, the reference plane normal, and the coefficient of friction
+    /// as in GetCoefficientFriction.
+    virtual void GetProperties(const ChVector<>& loc,
+                               double& height,
+                               ChVector<>& normal,
+                               float& friction) const override;
+
+    /// Get the terrain height, normal, and coefficient of friction at the points below the specified locations.
+    /// The reference plane normal is calculated only once for all locations.
+    virtual void GetProperties(const std::vector<ChVector<>>& locs,
+                               std::vector<double>& heights,
+                               std::vector<ChVector<>>& normals,
+                               std::vector<float>& frictions) const override;
+
     /// Get the current reference plane. The SCM terrain patch is in the (x,y) plane with normal along the Z axis.
     const ChCoordsys<>& GetPlane() const;
 
@@ -207,6 +231,21 @@ class CH_VEHICLE_API SCMDeformableTerrain : public ChTerrain {
                     int divY        ///< [in] number of divisions in the Y direction
     );
 
+    /// Initialize the terrain system (flat, sparse).
+    /// This version uses an implicit regular grid with the given spacing. SCM quantities are stored only for the grid
+    /// nodes that are actually loaded (in a hash map), so that memory scales with the deformed footprint rather than
+    /// with the terrain area. If no moving patches are defined (see AddMovingPatch), ray casting is limited to the grid
+    /// nodes below the bounding boxes of the colliding, non-fixed bodies in the system; if the system contains FEA
+    /// meshes, moving patches are required to avoid casting rays from every grid node. The visualization mesh (if
+    /// enabled at construction) still covers the entire grid; an exception is thrown if it would have more than INT_MAX
+    /// vertices or faces. Grid nodes are indexed with 64-bit integers. Automatic mesh refinement and bulldozing are not
+    /// supported in this mode.
+    void Initialize(double height,  ///< [in] terrain height
+                    double sizeX,   ///< [in] terrain dimension in the X direction
+                    double sizeY,   ///< [in] terrain dimension in the Y direction
+                    double delta    ///< [in] grid spacing
+    );
+
     /// Initialize the terrain system (mesh).
     /// The initial undeformed mesh is provided via a Wavefront .obj file.
     void Initialize(const std::string& mesh_file  ///< [in] filename of the input mesh (.OBJ file in Wavefront format)
@@ -229,6 +268,17 @@ class CH_VEHICLE_API SCMDeformableTerrain : public ChTerrain {
     /// Return the current cumulative contact force on the specified body (due to interaction with the SCM terrain).
     TerrainForce GetContactForce(std::shared_ptr<ChBody> body) const;
 
+    /// Return the number of terrain nodes with SCM data at the last step.
+    /// For a terrain initialized on an implicit grid, only the grid nodes loaded so far are counted.
+    size_t GetNumVertices() const;
+
+    /// Return the number of ray casts performed at the last step.
+    size_t GetNumRayCasts() const;
+
+    /// Return the time spent in the ray casting phase at the last step (in seconds).
+    /// This includes the evaluation of the SCM forces at the hit vertices.
+    double GetTimerRayCasting() const;
+
     /// Print timing and counter information for last step.
     void PrintStepStatistics(std::ostream& os) const;
 
@@ -252,6 +302,14 @@ class CH_VEHICLE_API SCMDeformableSoil : public ChLoadContainer {
                     int divY        ///< [in] number of divisions in the Y direction
     );
 
+    /// Initialize the terrain system (flat, sparse).
+    /// This version uses an implicit regular grid and only stores data for the loaded grid nodes.
+    void Initialize(double height,  ///< [in] terrain height
+                    double sizeX,   ///< [in] terrain dimension in the X direction
+                    double sizeY,   ///< [in] terrain dimension in the Y direction
+                    double delta    ///< [in] grid spacing
+    );
+
     /// Initialize the terrain system (mesh).
     /// The initial undeformed mesh is provided via a Wavefront .obj file.
     void Initialize(const std::string& mesh_file  ///< [in] filename of the input mesh (.OBJ file in Wavefront format)
@@ -274,9 +332,34 @@ class CH_VEHICLE_API SCMDeformableSoil : public ChLoadContainer {
   private:
     /// Patch type.
     enum class PatchType {
-        BOX,        ///< rectangular box
-        MESH,       ///< triangular mesh (from a Wavefront OBJ file)
-        HEIGHT_MAP  ///< triangular mesh (generated from a gray-scale image height-map)
+        BOX,         ///< rectangular box
+        MESH,        ///< triangular mesh (from a Wavefront OBJ file)
+        HEIGHT_MAP,  ///< triangular mesh (generated from a gray-scale image height-map)
+        GRID         ///< implicit regular grid, with data stored only for modified nodes
+    };
+
+    /// Hash function for integer grid coordinates.
+    struct GridHash {
+        std::size_t operator()(const ChVector2<int>& p) const {
+            return std::hash<int>()(p.x()) ^ (std::hash<int>()(p.y()) * 73856093);
+        }
+    };
+
+    /// SCM quantities at a node of the implicit grid.
+    struct NodeRecord {
+        double level;              // current level (in reference plane)
+        double level_initial;      // undeformed level (in reference plane)
+        double hit_level;          // level of the ray hit point
+        double sinkage;            // total sinkage
+        double sinkage_plastic;    // plastic sinkage
+        double sinkage_elastic;    // elastic sinkage
+        double step_plastic_flow;  // plastic flow rate at last step
+        double sigma;              // normal pressure
+        double sigma_yeld;         // yield pressure
+        double kshear;             // Janosi-Hanamoto shear accumulator
+        double tau;                // shear stress
+
+        explicit NodeRecord(double init_level);
     };
 
     // Get the terrain height below the specified location.
@@ -315,14 +398,50 @@ class CH_VEHICLE_API SCMDeformableSoil : public ChLoadContainer {
         ChLoadContainer::IntLoadResidual_F(off, R, c);
     }
 
+    // Implementation of ComputeInternalForces for the implicit grid (PatchType::GRID).
+    void ComputeInternalForcesGrid();
+
+    // Update the extent of the moving patches, based on the current position of their associated bodies.
+    void UpdateMovingPatches();
+
+    // Set the active patches to the current bounding boxes of the colliding bodies (implicit grid, no moving patches).
+    void UpdateBodyPatches();
+
+    // Get the false color of a grid node record for the current plot type.
+    ChColor GetGridNodeColor(const NodeRecord& nr) const;
+
+    // Create a load for the given force, applied at the given point on the hit contactable, and accumulate the
+    // resultant on the contactable (if a rigid body).
+    void AddContactForce(ChContactable* contactable, const ChVector<>& force, const ChVector<>& point);
+
+    // Get the (current) level of the specified grid node, in the reference plane.
+    double GetGridNodeLevel(const ChVector2<int>& node) const;
+
+    // Get the (64-bit) index of the specified grid node. Nodes are numbered row after row, starting at the (-X,-Y)
+    // corner; this is also the index of the node in the visualization mesh.
+    int64_t GetGridNodeIndex(const ChVector2<int>& node) const {
+        return node.x() + (int64_t)(m_grid_nx + 1) * node.y();
+    }
+
+    // Get the location of the specified grid node (with given level), expressed in the global frame.
+    ChVector<> GetGridNodePoint(const ChVector2<int>& node, double level) const;
+
     // This is called after Initialize(), it pre-computes aux.topology
     // data structures for the mesh, aux. material data, etc.
     void SetupAuxData();
 
     std::shared_ptr<ChColorAsset> m_color;
     std::shared_ptr<ChTriangleMeshShape> m_trimesh_shape;
+    bool m_visualization_mesh;
     double m_height;
 
+    // Implicit grid data (PatchType::GRID)
+    double m_grid_delta;                                 // grid spacing
+    int m_grid_nx;                                       // number of grid divisions in X direction
+    int m_grid_ny;                                       // number of grid divisions in Y direction
+    std::unordered_map<int64_t, NodeRecord> m_grid_map;  // modified grid nodes (keyed by grid node index)
+    std::vector<ChVector2<int>> m_grid_loaded;           // grid nodes loaded at last step
+
     std::vector<ChVector<>> p_vertices_initial;
     std::vector<ChVector<>> p_speeds;
     std::vector<double> p_level;
@@ -385,6 +504,12 @@ class CH_VEHICLE_API SCMDeformableSoil : public ChLoadContainer {
     };
     std::vector<MovingPatchInfo> m_patches;  // set of active moving patches
     bool m_moving_patch;                     // moving patch feature enabled?
+    bool m_patch_bodies_only;                // ray casting restricted to moving patch bodies?
+
+    // Cast rays (in parallel) between the given points and collect the collision models to test (if restricted).
+    void CastRays(const std::vector<ChVector<>>& from,
+                  const std::vector<ChVector<>>& to,
+                  std::vector<collision::ChCollisionSystem::ChRayhitResult>& results);
 
     // Callback object for position-dependent soil properties
     std::shared_ptr<SCMDeformableTerrain::SoilParametersCallback> m_soil_fun;
@@ -20,6 +20,7 @@
 // =============================================================================
 
 #include <cmath>
+#include <vector>
 
 #include "chrono/physics/ChSystem.h"
 #include "chrono_vehicle/ChWorldFrame.h"
@@ -178,14 +179,16 @@ bool ChTire::DiscTerrainCollision(
     ChVector<> ptD = disc_center + disc_radius * Vcross(disc_normal, dir1 / sqrt(sinTilt2));
 
     // Find terrain height at lowest point. No contact if lowest point is above the terrain.
-    double hp = terrain.GetHeight(ptD);
+    double hp;
+    ChVector<> normal;
+    float mu;
+    terrain.GetProperties(ptD, hp, normal, mu);
     double ptD_height = ChWorldFrame::Height(ptD);
     if (ptD_height > hp)
         return false;
 
     // Approximate the terrain with a plane. Define the projection of the lowest
     // point onto this plane as the contact point on the terrain.
-    ChVector<> normal = terrain.GetNormal(ptD);
     ChVector<> longitudinal = Vcross(disc_normal, normal);
     longitudinal.Normalize();
     ChVector<> lateral = Vcross(normal, longitudinal);
@@ -210,19 +213,36 @@ bool ChTire::DiscTerrainCollision4pt(
     ChCoordsys<>& contact,          // [out] contact coordinate system (relative to the global frame)
     double& depth,                  // [out] penetration depth (positive if contact occurred),
     double& camber_angle)           // [out] camber angle
+{
+    float mu;
+    return DiscTerrainCollision4pt(terrain, disc_center, disc_normal, disc_radius, width, contact, depth,
+                                   camber_angle, mu);
+}
+
+bool ChTire::DiscTerrainCollision4pt(
+    const ChTerrain& terrain,       // [in] reference to terrain system
+    const ChVector<>& disc_center,  // [in] global location of the disc center
+    const ChVector<>& disc_normal,  // [in] disc normal, expressed in the global frame
+    double disc_radius,             // [in] disc radius
+    double width,                   // [in] tire width
+    ChCoordsys<>& contact,          // [out] contact coordinate system (relative to the global frame)
+    double& depth,                  // [out] penetration depth (positive if contact occurred),
+    double& camber_angle,           // [out] camber angle
+    float& mu)                      // [out] coefficient of friction below the disc center
 {
     double dx = 0.1 * disc_radius;
     double dy = 0.3 * width;
 
-    // Find terrain height below disc center. There is no contact if the disc
-    // center is below the terrain or farther away by more than its radius.
-    double hc = terrain.GetHeight(disc_center);
+    // Find terrain height, normal, and coefficient of friction below disc center (single terrain lookup).
+    // There is no contact if the disc center is below the terrain or farther away by more than its radius.
+    double hc;
+    ChVector<> nhelp;
+    terrain.GetProperties(disc_center, hc, nhelp, mu);
     double disc_height = ChWorldFrame::Height(disc_center);
     if (disc_height <= hc || disc_height >= hc + disc_radius)
         return false;
 
     // Find the lowest point on the disc. There is no contact if the disc is (almost) horizontal.
-    ChVector<> nhelp = terrain.GetNormal(disc_center);
     ChVector<> dir1 = Vcross(disc_normal, nhelp);
     double sinTilt2 = dir1.Length2();
 
@@ -239,26 +259,21 @@ bool ChTire::DiscTerrainCollision4pt(
     longitudinal.Normalize();
     ChVector<> lateral = Vcross(normal, longitudinal);
 
-    // Calculate four contact points in the contact patch
-    ChVector<> ptQ1 = ptD + dx * longitudinal;
-    double hQ1 = terrain.GetHeight(ptQ1);
-    double ptQ1_height = ChWorldFrame::Height(ptQ1);
-    ptQ1 = ptQ1 - (ptQ1_height - hQ1) * ChWorldFrame::Vertical();
-
-    ChVector<> ptQ2 = ptD - dx * longitudinal;
-    double hQ2 = terrain.GetHeight(ptQ2);
-    double ptQ2_height = ChWorldFrame::Height(ptQ2);
-    ptQ2 = ptQ2 - (ptQ2_height - hQ2) * ChWorldFrame::Vertical();
-
-    ChVector<> ptQ3 = ptD + dy * lateral;
-    double hQ3 = terrain.GetHeight(ptQ3);
-    double ptQ3_height = ChWorldFrame::Height(ptQ3);
-    ptQ3 = ptQ3 - (ptQ3_height - hQ3) * ChWorldFrame::Vertical();
-
-    ChVector<> ptQ4 = ptD - dy * lateral;
-    double hQ4 = terrain.GetHeight(ptQ4);
-    double ptQ4_height = ChWorldFrame::Height(ptQ4);
-    ptQ4 = ptQ4 - (ptQ4_height - hQ4) * ChWorldFrame::Vertical();
+    // Calculate four contact points in the contact patch (single batched terrain height lookup).
+    // The query buffers are reused across calls (one set per thread).
+    static thread_local std::vector<ChVector<>> ptQ(4);
+    static thread_local std::vector<double> hQ;
+    ptQ[0] = ptD + dx * longitudinal;
+    ptQ[1] = ptD - dx * longitudinal;
+    ptQ[2] = ptD + dy * lateral;
+    ptQ[3] = ptD - dy * lateral;
+    terrain.GetHeights(ptQ, hQ);
+    for (size_t i = 0; i < 4; i++)
+        ptQ[i] = ptQ[i] - (ChWorldFrame::Height(ptQ[i]) - hQ[i]) * ChWorldFrame::Vertical();
+    const ChVector<>& ptQ1 = ptQ[0];
+    const ChVector<>& ptQ2 = ptQ[1];
+    const ChVector<>& ptQ3 = ptQ[2];
+    const ChVector<>& ptQ4 = ptQ[3];
 
     // Calculate a smoothed road surface normal
     ChVector<> rQ2Q1 = ptQ1 - ptQ2;
@@ -316,18 +331,26 @@ bool ChTire::DiscTerrainCollisionEnvelope(
     // where the equivalent contact point is exactly, so we use the intersection
     // area to decide if there is contact or not.
 
-    ChVector<> normal = terrain.GetNormal(disc_center);
-    ChVector<> longitudinal = Vcross(disc_normal, normal);
+    ChVector<> nhelp = terrain.GetNormal(disc_center);
+    ChVector<> longitudinal = Vcross(disc_normal, nhelp);
     longitudinal.Normalize();
 
+    // Sample the terrain along the longitudinal direction (single batched terrain query).
+    // The sample buffers are reused across calls (one set per thread), to avoid allocations at each step.
     const size_t n_div = 180;
     double x_step = 2.0 * disc_radius / n_div;
+    static thread_local std::vector<ChVector<>> pTest;
+    static thread_local std::vector<double> qTest;
+    pTest.resize(n_div - 1);
+    for (size_t i = 1; i < n_div; i++)
+        pTest[i - 1] = disc_center + (-disc_radius + x_step * double(i)) * longitudinal;
+    terrain.GetHeights(pTest, qTest);
+
     double A = 0;  // overlapping area of tire disc and road surface contour
     for (size_t i = 1; i < n_div; i++) {
         double x = -disc_radius + x_step * double(i);
-        ChVector<> pTest = disc_center + x * longitudinal;
-        double q = terrain.GetHeight(pTest);
-        double a = ChWorldFrame::Height(pTest) - sqrt(disc_radius * disc_radius - x * x);
+        double q = qTest[i - 1];
+        double a = ChWorldFrame::Height(pTest[i - 1]) - sqrt(disc_radius * disc_radius - x * x);
         if (q > a) {
             A += q - a;
         }
@@ -342,7 +365,6 @@ bool ChTire::DiscTerrainCollisionEnvelope(
     depth = areaDep.Get_y(A);
 
     // Find the lowest point on the disc. There is no contact if the disc is (almost) horizontal.
-    ChVector<> nhelp = terrain.GetNormal(disc_center);
     ChVector<> dir1 = Vcross(disc_normal, nhelp);
     double sinTilt2 = dir1.Length2();
 
@@ -355,7 +377,7 @@ bool ChTire::DiscTerrainCollisionEnvelope(
     // Find terrain height at lowest point. No contact if lowest point is above
     // the terrain.
 
-    normal = terrain.GetNormal(ptD);
+    ChVector<> normal = terrain.GetNormal(ptD);
     longitudinal = Vcross(disc_normal, normal);
     longitudinal.Normalize();
     ChVector<> lateral = Vcross(normal, longitudinal);
@@ -202,6 +202,20 @@ class CH_VEHICLE_API ChTire : public ChPart {
         double& camber_angle            ///< [out] tire camber angle
     );
 
+    /// Same as above, but also return the terrain coefficient of friction below the disc center.
+    /// The coefficient of friction is obtained from the same terrain lookup as the height below the disc center.
+    static bool DiscTerrainCollision4pt(
+        const ChTerrain& terrain,       ///< [in] reference to terrain system
+        const ChVector<>& disc_center,  ///< [in] global location of the disc center
+        const ChVector<>& disc_normal,  ///< [in] disc normal, expressed in the global frame
+        double disc_radius,             ///< [in] disc radius
+        double width,                   ///< [in] tire width
+        ChCoordsys<>& contact,          ///< [out] contact coordinate system (relative to the global frame)
+        double& depth,                  ///< [out] penetration depth (positive if contact occurred)
+        double& camber_angle,           ///< [out] tire camber angle
+        float& mu                       ///< [out] coefficient of friction below the disc center
+    );
+
     /// Collsion algorithm based on a paper of J. Shane Sui and John A. Hirshey II:
     /// "A New Analytical Tire Model for Vehicle Dynamic Analysis" presented at 2001 MSC User Meeting
     static bool DiscTerrainCollisionEnvelope(
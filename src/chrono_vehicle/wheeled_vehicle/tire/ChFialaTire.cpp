@@ -105,7 +105,10 @@ void ChFialaTire::Synchronize(double time,
     m_time = time;
 
     // Get mu at wheel location
-    m_mu = terrain.GetCoefficientFriction(wheel_state.pos);
+    // (the four-point collision detection returns it from its own terrain lookup)
+    float mu = 0;
+    if (m_collision_type != ChTire::CollisionType::FOUR_POINTS)
+        mu = terrain.GetCoefficientFriction(wheel_state.pos);
 
     // Extract the wheel normal (expressed in global frame)
     ChMatrix33<> A(wheel_state.rot);
@@ -120,13 +123,14 @@ void ChFialaTire::Synchronize(double time,
             break;
         case ChTire::CollisionType::FOUR_POINTS:
             m_data.in_contact = DiscTerrainCollision4pt(terrain, wheel_state.pos, disc_normal, m_unloaded_radius,
-                                                        m_width, m_data.frame, m_data.depth, dum_cam);
+                                                        m_width, m_data.frame, m_data.depth, dum_cam, mu);
             break;
         case ChTire::CollisionType::ENVELOPE:
             m_data.in_contact = DiscTerrainCollisionEnvelope(terrain, wheel_state.pos, disc_normal, m_unloaded_radius,
                                                              m_areaDep, m_data.frame, m_data.depth);
             break;
     }
+    m_mu = mu;
 
     if (m_data.in_contact) {
         // Wheel velocity in the ISO-C Frame
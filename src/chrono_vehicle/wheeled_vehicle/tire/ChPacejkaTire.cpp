@@ -436,7 +436,11 @@ void ChPacejkaTire::update_W_frame(const ChTerrain& terrain) {
     // Check contact with terrain, using a disc of radius R0.
     ChCoordsys<> contact_frame;
 
-    m_mu = terrain.GetCoefficientFriction(m_tireState.pos);
+    // Friction coefficient below the wheel center
+    // (the four-point collision detection returns it from its own terrain lookup)
+    float mu = 0;
+    if (m_collision_type != CollisionType::FOUR_POINTS)
+        mu = terrain.GetCoefficientFriction(m_tireState.pos);
 
     double depth;
     double dum_cam;
@@ -447,13 +451,14 @@ void ChPacejkaTire::update_W_frame(const ChTerrain& terrain) {
             break;
         case CollisionType::FOUR_POINTS:
             m_in_contact = DiscTerrainCollision4pt(terrain, m_tireState.pos, m_tireState.rot.GetYaxis(), m_R0,
-                                                   m_params->dimension.width, contact_frame, depth, dum_cam);
+                                                   m_params->dimension.width, contact_frame, depth, dum_cam, mu);
             break;
         case CollisionType::ENVELOPE:
             m_in_contact = DiscTerrainCollisionEnvelope(terrain, m_tireState.pos, m_tireState.rot.GetYaxis(), m_R0,
                                                         m_areaDep, contact_frame, depth);
             break;
     }
+    m_mu = mu;
 
     // set the depth if there is contact with terrain
     m_depth = (m_in_contact) ? depth : 0;
@@ -135,9 +135,11 @@ void ChTMeasyTire::Synchronize(double time, const ChTerrain& terrain) {
 
     m_time = time;
 
-    // Get mu at wheel location and ensure it stays realistic and the formulae don't degenerate
-    m_mu = terrain.GetCoefficientFriction(wheel_state.pos);
-    ChClampValue(m_mu, 0.1, 1.0);
+    // Get mu at wheel location
+    // (the four-point collision detection returns it from its own terrain lookup)
+    float mu = 0;
+    if (m_collision_type != CollisionType::FOUR_POINTS)
+        mu = terrain.GetCoefficientFriction(wheel_state.pos);
 
     // Extract the wheel normal (expressed in global frame)
     ChMatrix33<> A(wheel_state.rot);
@@ -152,7 +154,7 @@ void ChTMeasyTire::Synchronize(double time, const ChTerrain& terrain) {
             break;
         case CollisionType::FOUR_POINTS:
             m_data.in_contact = DiscTerrainCollision4pt(terrain, wheel_state.pos, disc_normal, m_unloaded_radius,
-                                                        m_width, m_data.frame, m_data.depth, m_gamma);
+                                                        m_width, m_data.frame, m_data.depth, m_gamma, mu);
             break;
         case CollisionType::ENVELOPE:
             m_data.in_contact = DiscTerrainCollisionEnvelope(terrain, wheel_state.pos, disc_normal, m_unloaded_radius,
@@ -160,6 +162,11 @@ void ChTMeasyTire::Synchronize(double time, const ChTerrain& terrain) {
             m_gamma = GetCamberAngle();
             break;
     }
+
+    // Ensure mu stays realistic and the formulae don't degenerate
+    m_mu = mu;
+    ChClampValue(m_mu, 0.1, 1.0);
+
     UpdateVerticalStiffness();
     if (m_data.in_contact) {
         // Wheel velocity in the ISO-C Frame
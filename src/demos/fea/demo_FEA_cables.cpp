@@ -30,7 +30,7 @@ using namespace chrono::irrlicht;
 
 using namespace irr;
 
-// Select solver type (SPARSE_QR, SPARSE_LU, or MINRES).
+// Select solver type (SPARSE_QR, SPARSE_LU, SPARSE_LDLT, or MINRES).
 ChSolver::Type solver_type = ChSolver::Type::SPARSE_QR;
 
 int main(int argc, char* argv[]) {
@@ -114,6 +114,15 @@ int main(int argc, char* argv[]) {
             solver->SetVerbose(false);
             break;
         }
+        case ChSolver::Type::SPARSE_LDLT: {
+            std::cout << "Using SparseLDLT solver" << std::endl;
+            auto solver = chrono_types::make_shared<ChSolverSparseLDLT>();
+            my_system.SetSolver(solver);
+            solver->UseSparsityPatternLearner(true);
+            solver->LockSparsityPattern(true);
+            solver->SetVerbose(false);
+            break;
+        }
         case ChSolver::Type::MINRES: {
             std::cout << "Using MINRES solver" << std::endl;
             auto solver = chrono_types::make_shared<ChSolverMINRES>();
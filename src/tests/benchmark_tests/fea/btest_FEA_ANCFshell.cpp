@@ -17,9 +17,14 @@
 // Note that the MKL Pardiso and Mumps solvers are set to lock the sparsity
 // pattern, but not to use the sparsity pattern learner.
 //
+// The ANCFshell_InternalForces benchmark measures the thread scaling of the
+// evaluation of element internal forces on a square plate of ANCF shells.
+// Benchmark arguments: number of elements per side, number of OpenMP threads.
+//
 // =============================================================================
 
 #include "chrono/ChConfig.h"
+#include "chrono/parallel/ChOpenMP.h"
 #include "chrono/utils/ChBenchmark.h"
 
 #include "chrono/physics/ChSystemSMC.h"
@@ -254,6 +259,74 @@ CH_BM_SIMULATION_LOOP(ANCFshell64_MUMPS, ANCFshell_MUMPS<64>, NUM_SKIP_STEPS, NU
 
 // =============================================================================
 
+static void ANCFshell_InternalForces(benchmark::State& st) {
+    int N = (int)st.range(0);
+    int num_threads = (int)st.range(1);
+
+    ChSystemSMC system;
+    system.Set_G_acc(ChVector<>(0, 0, -9.8));
+
+    double length = 1;
+    double thickness = 0.01;
+    double dx = length / N;
+    auto mat = chrono_types::make_shared<ChMaterialShellANCF>(500, ChVector<>(2.1e7), ChVector<>(0.3),
+                                                              ChVector<>(8.0769231e6));
+
+    // Create an N x N plate of shell elements, fixed along one edge
+    auto mesh = chrono_types::make_shared<ChMesh>();
+    system.Add(mesh);
+
+    ChVector<> dir(0, 0, 1);
+    std::vector<std::shared_ptr<ChNodeFEAxyzD>> nodes;
+    for (int j = 0; j <= N; j++) {
+        for (int i = 0; i <= N; i++) {
+            auto node = chrono_types::make_shared<ChNodeFEAxyzD>(ChVector<>(i * dx, j * dx, 0), dir);
+            node->SetFixed(i == 0);
+            mesh->AddNode(node);
+            nodes.push_back(node);
+        }
+    }
+    for (int j = 0; j < N; j++) {
+        for (int i = 0; i < N; i++) {
+            auto element = chrono_types::make_shared<ChElementShellANCF>();
+            element->SetNodes(nodes[j * (N + 1) + i], nodes[j * (N + 1) + i + 1], nodes[(j + 1) * (N + 1) + i + 1],
+                              nodes[(j + 1) * (N + 1) + i]);
+            element->SetDimensions(dx, dx);
+            element->AddLayer(thickness, 0, mat);
+            element->SetAlphaDamp(0.0);
+            element->SetGravityOn(false);
+            mesh->AddElement(element);
+        }
+    }
+
+    system.Setup();
+    system.Update();
+
+    CHOMPfunctions::SetNumThreads(num_threads);
+    ChVectorDynamic<> R(system.GetNcoords_w());
+    for (auto _ : st) {
+        R.setZero();
+        mesh->IntLoadResidual_F(0, R, 1.0);
+    }
+    CHOMPfunctions::SetNumThreads(CHOMPfunctions::GetNumProcs());
+
+    st.SetItemsProcessed(st.iterations() * mesh->GetNelements());
+    st.counters["colors"] = mesh->GetNumElementColors();
+}
+BENCHMARK(ANCFshell_InternalForces)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime()
+    ->Args({32, 1})
+    ->Args({32, 2})
+    ->Args({32, 4})
+    ->Args({32, 8})
+    ->Args({64, 1})
+    ->Args({64, 2})
+    ->Args({64, 4})
+    ->Args({64, 8});
+
+// =============================================================================
+
 int main(int argc, char* argv[]) {
     ::benchmark::Initialize(&argc, argv);
 
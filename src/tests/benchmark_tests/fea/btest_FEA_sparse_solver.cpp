@@ -15,6 +15,9 @@
 // Benchmark test for sparse matrix setup (assembly of system matrix).
 // This provides a measure of the effect and performance of using the "sparsity
 // learner".
+// Also measures the sparse LDLT solver, which reuses the symbolic analysis with
+// a locked sparsity pattern, and compares the iterative solvers (GMRES and MINRES) with the different
+// preconditioners, with and without reuse of the preconditioner.
 //
 // =============================================================================
 
@@ -24,6 +27,7 @@
 #include "chrono/core/ChMatrix.h"
 #include "chrono/physics/ChSystemSMC.h"
 #include "chrono/solver/ChDirectSolverLS.h"
+#include "chrono/solver/ChIterativeSolverLS.h"
 #include "chrono/fea/ChElementShellANCF.h"
 #include "chrono/fea/ChMesh.h"
 
@@ -150,6 +154,59 @@ class SystemFixture : public ::benchmark::Fixture {
     }                                                                                 \
     BENCHMARK_REGISTER_F(SystemFixture, TEST_NAME)->Unit(benchmark::kMillisecond);
 
+#define BM_SOLVER_LDLT(TEST_NAME, N, SYMMETRY)                                                   \
+    BENCHMARK_TEMPLATE_DEFINE_F(SystemFixture, TEST_NAME, N)(benchmark::State & st) {            \
+        auto solver = chrono_types::make_shared<ChSolverSparseLDLT>();                           \
+        solver->SetMatrixSymmetryType(ChDirectSolverLS::MatrixSymmetryType::SYMMETRY);           \
+        solver->LockSparsityPattern(true);                                                       \
+        solver->SetVerbose(false);                                                               \
+        m_system->SetSolver(solver);                                                             \
+        while (st.KeepRunning()) {                                                               \
+            m_system->DoStaticLinear();                                                          \
+        }                                                                                        \
+        Report(st);                                                                              \
+        st.counters["LS_Analysis"] = solver->GetNumAnalysisCalls();                              \
+        st.counters["LS_Factorize"] = solver->GetTimeSetup_SolverCall() * 1e3 / st.iterations(); \
+    }                                                                                            \
+    BENCHMARK_REGISTER_F(SystemFixture, TEST_NAME)->Unit(benchmark::kMillisecond);
+
+#define BM_SOLVER_SLOT_MAP(TEST_NAME, N, WITH_SLOT_MAP)                                         \
+    BENCHMARK_TEMPLATE_DEFINE_F(SystemFixture, TEST_NAME, N)(benchmark::State & st) {            \
+        auto solver = chrono_types::make_shared<ChSolverSparseLDLT>();                           \
+        solver->SetMatrixSymmetryType(ChDirectSolverLS::MatrixSymmetryType::SYMMETRIC_POSDEF);   \
+        solver->LockSparsityPattern(true);                                                       \
+        solver->UseSlotMapAssembly(WITH_SLOT_MAP);                                               \
+        solver->SetVerbose(false);                                                               \
+        m_system->SetSolver(solver);                                                             \
+        while (st.KeepRunning()) {                                                               \
+            m_system->DoStaticLinear();                                                          \
+        }                                                                                        \
+        Report(st);                                                                              \
+        st.counters["LS_SlotMap"] = solver->GetNumSlotMapAssemblies();                           \
+        st.counters["LS_Assembly"] = solver->GetTimeSetup_Assembly() * 1e3 / st.iterations();    \
+    }                                                                                            \
+    BENCHMARK_REGISTER_F(SystemFixture, TEST_NAME)->Unit(benchmark::kMillisecond);
+
+#define BM_SOLVER_ITERATIVE(TEST_NAME, N, SOLVER, PRECOND, INTERVAL)                   \
+    BENCHMARK_TEMPLATE_DEFINE_F(SystemFixture, TEST_NAME, N)(benchmark::State & st) { \
+        auto solver = chrono_types::make_shared<SOLVER>();                            \
+        solver->SetPreconditioner(ChIterativeSolverLS::PreconditionerType::PRECOND);  \
+        solver->SetPreconditionerUpdateInterval(INTERVAL);                            \
+        solver->SetMaxIterations(2000);                                               \
+        solver->SetTolerance(1e-10);                                                  \
+        solver->SetVerbose(false);                                                    \
+        m_system->SetSolver(solver);                                                  \
+        double iterations = 0;                                                        \
+        while (st.KeepRunning()) {                                                    \
+            m_system->DoStaticLinear();                                               \
+            iterations += solver->GetIterations();                                    \
+        }                                                                             \
+        Report(st);                                                                   \
+        st.counters["LS_Iterations"] = iterations / st.iterations();                  \
+        st.counters["LS_Updates"] = solver->GetNumPreconditionerUpdates();            \
+    }                                                                                 \
+    BENCHMARK_REGISTER_F(SystemFixture, TEST_NAME)->Unit(benchmark::kMillisecond);
+
 #ifdef CHRONO_MKL
 BM_SOLVER_MKL(MKL_learner_500, 500, true)
 BM_SOLVER_MKL(MKL_no_learner_500, 500, false)
@@ -186,3 +243,33 @@ BM_SOLVER_QR(QR_learner_4000, 4000, true)
 BM_SOLVER_QR(QR_no_learner_4000, 4000, false)
 BM_SOLVER_QR(QR_learner_8000, 8000, true)
 BM_SOLVER_QR(QR_no_learner_8000, 8000, false)
+
+BM_SOLVER_LDLT(LDLT_500, 500, SYMMETRIC_INDEF)
+BM_SOLVER_LDLT(LLT_500, 500, SYMMETRIC_POSDEF)
+BM_SOLVER_LDLT(LDLT_2000, 2000, SYMMETRIC_INDEF)
+BM_SOLVER_LDLT(LLT_2000, 2000, SYMMETRIC_POSDEF)
+BM_SOLVER_LDLT(LDLT_8000, 8000, SYMMETRIC_INDEF)
+BM_SOLVER_LDLT(LLT_8000, 8000, SYMMETRIC_POSDEF)
+
+BM_SOLVER_SLOT_MAP(LLT_slot_map_500, 500, true)
+BM_SOLVER_SLOT_MAP(LLT_no_slot_map_500, 500, false)
+BM_SOLVER_SLOT_MAP(LLT_slot_map_2000, 2000, true)
+BM_SOLVER_SLOT_MAP(LLT_no_slot_map_2000, 2000, false)
+BM_SOLVER_SLOT_MAP(LLT_slot_map_8000, 8000, true)
+BM_SOLVER_SLOT_MAP(LLT_no_slot_map_8000, 8000, false)
+
+BM_SOLVER_ITERATIVE(GMRES_diag_500, 500, ChSolverGMRES, DIAGONAL, 1)
+BM_SOLVER_ITERATIVE(GMRES_block_500, 500, ChSolverGMRES, BLOCK_JACOBI, 1)
+BM_SOLVER_ITERATIVE(GMRES_ilu_500, 500, ChSolverGMRES, ILU, 1)
+BM_SOLVER_ITERATIVE(GMRES_ilu_reuse_500, 500, ChSolverGMRES, ILU, 10)
+BM_SOLVER_ITERATIVE(GMRES_diag_2000, 2000, ChSolverGMRES, DIAGONAL, 1)
+BM_SOLVER_ITERATIVE(GMRES_block_2000, 2000, ChSolverGMRES, BLOCK_JACOBI, 1)
+BM_SOLVER_ITERATIVE(GMRES_ilu_2000, 2000, ChSolverGMRES, ILU, 1)
+BM_SOLVER_ITERATIVE(GMRES_ilu_reuse_2000, 2000, ChSolverGMRES, ILU, 10)
+
+BM_SOLVER_ITERATIVE(MINRES_diag_500, 500, ChSolverMINRES, DIAGONAL, 1)
+BM_SOLVER_ITERATIVE(MINRES_block_500, 500, ChSolverMINRES, BLOCK_JACOBI, 1)
+BM_SOLVER_ITERATIVE(MINRES_block_reuse_500, 500, ChSolverMINRES, BLOCK_JACOBI, 10)
+BM_SOLVER_ITERATIVE(MINRES_diag_2000, 2000, ChSolverMINRES, DIAGONAL, 1)
+BM_SOLVER_ITERATIVE(MINRES_block_2000, 2000, ChSolverMINRES, BLOCK_JACOBI, 1)
+BM_SOLVER_ITERATIVE(MINRES_block_reuse_2000, 2000, ChSolverMINRES, BLOCK_JACOBI, 10)
@@ -0,0 +1,140 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Benchmark test for the Chrono::Parallel broadphase on a polydisperse system.
+// A bed of small spheres is settling in a container, together with a few
+// spheres 100 times larger. Each test is run with the uniform grid and with
+// the hierarchical grid broadphase (see collision_settings::broadphase_algorithm).
+//
+// The global reference frame has Z up.
+//
+// =============================================================================
+
+#include "chrono/ChConfig.h"
+#include "chrono/utils/ChBenchmark.h"
+#include "chrono/utils/ChUtilsCreators.h"
+
+#include "chrono_parallel/physics/ChSystemParallel.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+// =============================================================================
+
+template <int N, BroadphaseType BROADPHASE>
+class PolydisperseTest : public utils::ChBenchmarkTest {
+  public:
+    PolydisperseTest();
+    ~PolydisperseTest() { delete m_system; }
+
+    ChSystem* GetSystem() override { return m_system; }
+    void ExecuteStep() override { m_system->DoStepDynamics(m_step); }
+
+  private:
+    ChSystemParallelNSC* m_system;
+    double m_step;
+};
+
+template <int N, BroadphaseType BROADPHASE>
+PolydisperseTest<N, BROADPHASE>::PolydisperseTest() : m_system(new ChSystemParallelNSC()), m_step(1e-3) {
+    double r_small = 0.005;  // radius of the small spheres
+    double r_large = 0.5;    // radius of the large spheres
+    double spacing = 2.5 * r_small;
+    double hdim = N * spacing / 2 + r_large;  // half-size of the container
+
+    m_system->Set_G_acc(ChVector<>(0, 0, -9.81));
+    m_system->GetSettings()->solver.solver_mode = SolverMode::SLIDING;
+    m_system->GetSettings()->solver.max_iteration_normal = 0;
+    m_system->GetSettings()->solver.max_iteration_sliding = 50;
+    m_system->GetSettings()->solver.max_iteration_spinning = 0;
+    m_system->GetSettings()->solver.max_iteration_bilateral = 0;
+    m_system->GetSettings()->solver.tolerance = 1e-3;
+    m_system->GetSettings()->solver.alpha = 0;
+    m_system->GetSettings()->solver.contact_recovery_speed = 1;
+    m_system->ChangeSolverType(SolverType::APGD);
+    m_system->GetSettings()->collision.collision_envelope = 0.1 * r_small;
+    m_system->GetSettings()->collision.narrowphase_algorithm = NarrowPhaseType::NARROWPHASE_HYBRID_MPR;
+    m_system->GetSettings()->collision.broadphase_algorithm = BROADPHASE;
+    m_system->GetSettings()->collision.bins_per_axis = vec3(20, 20, 20);
+
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+    mat->SetFriction(0.4f);
+
+    // Container
+    auto bin = chrono_types::make_shared<ChBody>(chrono_types::make_shared<ChCollisionModelParallel>());
+    bin->SetBodyFixed(true);
+    bin->SetCollide(true);
+    bin->GetCollisionModel()->ClearModel();
+    utils::AddBoxGeometry(bin.get(), mat, ChVector<>(hdim, hdim, 0.1), ChVector<>(0, 0, -0.1));
+    utils::AddBoxGeometry(bin.get(), mat, ChVector<>(0.1, hdim, hdim), ChVector<>(-hdim - 0.1, 0, hdim));
+    utils::AddBoxGeometry(bin.get(), mat, ChVector<>(0.1, hdim, hdim), ChVector<>(hdim + 0.1, 0, hdim));
+    utils::AddBoxGeometry(bin.get(), mat, ChVector<>(hdim, 0.1, hdim), ChVector<>(0, -hdim - 0.1, hdim));
+    utils::AddBoxGeometry(bin.get(), mat, ChVector<>(hdim, 0.1, hdim), ChVector<>(0, hdim + 0.1, hdim));
+    bin->GetCollisionModel()->BuildModel();
+    m_system->AddBody(bin);
+
+    // Layers of small spheres
+    double mass_small = 1000 * (4.0 / 3.0) * CH_C_PI * r_small * r_small * r_small;
+    for (int iz = 0; iz < 4; iz++) {
+        for (int ix = 0; ix < N; ix++) {
+            for (int iy = 0; iy < N; iy++) {
+                ChVector<> pos(-N * spacing / 2 + (ix + 0.5) * spacing, -N * spacing / 2 + (iy + 0.5) * spacing,
+                               r_small + iz * spacing);
+                auto ball = chrono_types::make_shared<ChBody>(chrono_types::make_shared<ChCollisionModelParallel>());
+                ball->SetMass(mass_small);
+                ball->SetInertiaXX(0.4 * mass_small * r_small * r_small * ChVector<>(1, 1, 1));
+                ball->SetPos(pos);
+                ball->SetCollide(true);
+                ball->GetCollisionModel()->ClearModel();
+                utils::AddSphereGeometry(ball.get(), mat, r_small);
+                ball->GetCollisionModel()->BuildModel();
+                m_system->AddBody(ball);
+            }
+        }
+    }
+
+    // Large spheres, dropped on the bed of small spheres
+    double mass_large = 1000 * (4.0 / 3.0) * CH_C_PI * r_large * r_large * r_large;
+    for (int i = 0; i < 4; i++) {
+        ChVector<> pos((i % 2 - 0.5) * (hdim - r_large), (i / 2 - 0.5) * (hdim - r_large), 4 * spacing + r_large);
+        auto ball = chrono_types::make_shared<ChBody>(chrono_types::make_shared<ChCollisionModelParallel>());
+        ball->SetMass(mass_large);
+        ball->SetInertiaXX(0.4 * mass_large * r_large * r_large * ChVector<>(1, 1, 1));
+        ball->SetPos(pos);
+        ball->SetCollide(true);
+        ball->GetCollisionModel()->ClearModel();
+        utils::AddSphereGeometry(ball.get(), mat, r_large);
+        ball->GetCollisionModel()->BuildModel();
+        m_system->AddBody(ball);
+    }
+}
+
+// =============================================================================
+
+#define NUM_SKIP_STEPS 50  // number of steps for hot start
+#define NUM_SIM_STEPS 100  // number of simulation steps for each benchmark
+
+using PolydisperseTest040 = PolydisperseTest<40, BroadphaseType::BROADPHASE_ONE_LEVEL>;
+using PolydisperseTest080 = PolydisperseTest<80, BroadphaseType::BROADPHASE_ONE_LEVEL>;
+using PolydisperseTest040hgrid = PolydisperseTest<40, BroadphaseType::BROADPHASE_HIERARCHICAL>;
+using PolydisperseTest080hgrid = PolydisperseTest<80, BroadphaseType::BROADPHASE_HIERARCHICAL>;
+
+CH_BM_SIMULATION_LOOP(Polydisperse040, PolydisperseTest040, NUM_SKIP_STEPS, NUM_SIM_STEPS, 5);
+CH_BM_SIMULATION_LOOP(Polydisperse080, PolydisperseTest080, NUM_SKIP_STEPS, NUM_SIM_STEPS, 5);
+CH_BM_SIMULATION_LOOP(Polydisperse040_hgrid, PolydisperseTest040hgrid, NUM_SKIP_STEPS, NUM_SIM_STEPS, 5);
+CH_BM_SIMULATION_LOOP(Polydisperse080_hgrid, PolydisperseTest080hgrid, NUM_SKIP_STEPS, NUM_SIM_STEPS, 5);
+
+// =============================================================================
+
+BENCHMARK_MAIN();
@@ -99,4 +99,36 @@ BENCHMARK_DEFINE_F(SystemFixture, SingleLoop)(benchmark::State& st) {
 BENCHMARK_REGISTER_F(SystemFixture, SingleLoop)->Unit(benchmark::kMicrosecond);
 ////BENCHMARK_REGISTER_F(SystemFixture, SingleLoop)->Unit(benchmark::kMicrosecond)->Iterations(1);
 
+// Benchmark the update of all bodies (always sequential, see ChAssembly::Update)
+BENCHMARK_DEFINE_F(SystemFixture, SystemUpdate)(benchmark::State& st) {
+    for (auto _ : st) {
+        sys->Update(current_time, false);
+    }
+    st.SetItemsProcessed(st.iterations() * sys->Get_bodylist().size());
+}
+BENCHMARK_REGISTER_F(SystemFixture, SystemUpdate)->Unit(benchmark::kMicrosecond);
+
+// Benchmark the multi-threaded assembly-level loops over all bodies (state gather and residual loading), using the
+// specified number of threads
+BENCHMARK_DEFINE_F(SystemFixture, SystemStateGatherResidual)(benchmark::State& st) {
+    sys->SetNumThreads((int)st.range(0));
+    sys->Setup();
+    sys->Update(current_time, false);
+    ChState x(sys->GetNcoords_x(), sys);
+    ChStateDelta v(sys->GetNcoords_v(), sys);
+    ChVectorDynamic<> R(sys->GetNcoords_v());
+    double T;
+    for (auto _ : st) {
+        sys->StateGather(x, v, T);
+        R.setZero();
+        sys->LoadResidual_F(R, 1.0);
+        sys->LoadResidual_Mv(R, v, 1.0);
+    }
+    st.SetItemsProcessed(st.iterations() * sys->Get_bodylist().size());
+}
+BENCHMARK_REGISTER_F(SystemFixture, SystemStateGatherResidual)
+    ->Unit(benchmark::kMicrosecond)
+    ->RangeMultiplier(2)
+    ->Range(1, 16);
+
 ////BENCHMARK_MAIN();
@@ -0,0 +1,129 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Benchmark test for binary checkpoint/restart (utils::WriteCheckpointBinary and
+// utils::ReadCheckpointBinary).
+// Balls are settled in a container, then a checkpoint of the system is written.
+// The benchmarks measure the time to write the checkpoint, to restart from it
+// (re-create the model and read the checkpoint), and, for comparison, to reach
+// the same state by re-creating the model and simulating from the beginning.
+//
+// =============================================================================
+
+#include <string>
+
+#include "chrono/core/ChMathematics.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/utils/ChUtilsCreators.h"
+#include "chrono/utils/ChUtilsInputOutput.h"
+
+#include "chrono_thirdparty/filesystem/path.h"
+
+#include "benchmark/benchmark.h"
+
+using namespace chrono;
+
+// =============================================================================
+
+#define STEP_SIZE 1e-3  // integration step size
+#define NUM_STEPS 200   // number of steps before the checkpoint
+
+static void CreateModel(ChSystemNSC& system, int num_balls) {
+    system.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto material = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+    material->SetFriction(0.4f);
+
+    utils::CreateBoxContainer(&system, -1, material, ChVector<>(2, 2, 2), 0.1, ChVector<>(0, 0, 0),
+                              ChQuaternion<>(1, 0, 0, 0), true, true, false, false);
+
+    double radius = 0.05;
+    double mass = 1;
+    for (int i = 0; i < num_balls; i++) {
+        auto ball = chrono_types::make_shared<ChBody>();
+        ball->SetMass(mass);
+        ball->SetInertiaXX(0.4 * mass * radius * radius * ChVector<>(1, 1, 1));
+        ball->SetPos(ChVector<>(-1.8 + 3.6 * ChRandom(), radius + 0.5 * ChRandom(), -1.8 + 3.6 * ChRandom()));
+        ball->SetCollide(true);
+        ball->GetCollisionModel()->ClearModel();
+        utils::AddSphereGeometry(ball.get(), material, radius);
+        ball->GetCollisionModel()->BuildModel();
+        system.AddBody(ball);
+    }
+}
+
+static std::string CheckpointFile(int num_balls) {
+    const std::string out_dir = GetChronoOutputPath() + "CHECKPOINT";
+    filesystem::create_directory(filesystem::path(GetChronoOutputPath()));
+    filesystem::create_directory(filesystem::path(out_dir));
+    return out_dir + "/btest_checkpoint_" + std::to_string(num_balls) + ".dat";
+}
+
+// Simulate the model and write the checkpoint used by the Restart benchmark.
+static std::string WriteReference(int num_balls) {
+    std::string filename = CheckpointFile(num_balls);
+    ChSystemNSC system;
+    CreateModel(system, num_balls);
+    for (int i = 0; i < NUM_STEPS; i++)
+        system.DoStepDynamics(STEP_SIZE);
+    utils::WriteCheckpointBinary(&system, filename);
+    return filename;
+}
+
+// =============================================================================
+
+static void Write(benchmark::State& state) {
+    int num_balls = (int)state.range(0);
+    std::string filename = CheckpointFile(num_balls);
+    ChSystemNSC system;
+    CreateModel(system, num_balls);
+    for (int i = 0; i < NUM_STEPS; i++)
+        system.DoStepDynamics(STEP_SIZE);
+
+    for (auto _ : state) {
+        if (!utils::WriteCheckpointBinary(&system, filename))
+            state.SkipWithError("Cannot write checkpoint");
+    }
+    state.counters["Contacts"] = system.GetNcontacts();
+}
+
+static void Restart(benchmark::State& state) {
+    int num_balls = (int)state.range(0);
+    std::string filename = WriteReference(num_balls);
+
+    for (auto _ : state) {
+        ChSystemNSC system;
+        CreateModel(system, num_balls);
+        utils::ReadCheckpointBinary(&system, filename);
+    }
+}
+
+static void Resimulate(benchmark::State& state) {
+    int num_balls = (int)state.range(0);
+
+    for (auto _ : state) {
+        ChSystemNSC system;
+        CreateModel(system, num_balls);
+        for (int i = 0; i < NUM_STEPS; i++)
+            system.DoStepDynamics(STEP_SIZE);
+    }
+}
+
+BENCHMARK(Write)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+BENCHMARK(Restart)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+BENCHMARK(Resimulate)->Arg(100)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+// =============================================================================
+
+BENCHMARK_MAIN();
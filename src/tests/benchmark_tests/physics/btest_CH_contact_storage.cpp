@@ -0,0 +1,123 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Benchmark for the storage of contact objects in the contact containers.
+// Compares the baseline storage (std::list of heap-allocated contacts, with
+// unused contacts deleted at the end of each collision pass) with ChContactPool,
+// with and without pooling of unused contacts across steps.
+// Each step adds a varying number of contacts (churn) and then performs a sweep
+// over all contacts, as done when loading residuals and constraints.
+//
+// =============================================================================
+
+#include <list>
+
+#include <benchmark/benchmark.h>
+
+#include "chrono/physics/ChContactPool.h"
+
+using namespace chrono;
+
+// Contact-like payload, comparable in size to a ChContactNSC object
+struct Contact {
+    explicit Contact(double seed) { Reset(seed); }
+    void Reset(double seed) {
+        for (int i = 0; i < 48; i++)
+            data[i] = seed + i;
+    }
+    double Load() const { return data[0] + data[17] + data[47]; }
+    double data[48];
+};
+
+// Baseline storage, as in the contact containers before ChContactPool
+class ListStorage {
+  public:
+    ~ListStorage() {
+        for (auto c : m_list)
+            delete c;
+    }
+    void Begin() { m_last = m_list.begin(); }
+    void Add(double seed) {
+        if (m_last != m_list.end()) {
+            (*m_last)->Reset(seed);
+            ++m_last;
+        } else {
+            m_list.push_back(new Contact(seed));
+            m_last = m_list.end();
+        }
+    }
+    void End() {
+        while (m_last != m_list.end()) {
+            delete *m_last;
+            m_last = m_list.erase(m_last);
+        }
+    }
+    double Sweep() const {
+        double sum = 0;
+        for (auto c : m_list)
+            sum += c->Load();
+        return sum;
+    }
+
+  private:
+    std::list<Contact*> m_list;
+    std::list<Contact*>::iterator m_last;
+};
+
+// Contact pool storage, as in ChContactContainerNSC and ChContactContainerSMC
+template <bool POOLING>
+class PoolStorage {
+  public:
+    void Begin() { m_pool.Rewind(); }
+    void Add(double seed) {
+        if (auto c = m_pool.Recycle())
+            c->Reset(seed);
+        else
+            m_pool.Emplace(seed);
+    }
+    void End() {
+        if (!POOLING)
+            m_pool.Trim();
+    }
+    double Sweep() const {
+        double sum = 0;
+        for (size_t i = 0; i < m_pool.size(); i++)
+            sum += m_pool[i]->Load();
+        return sum;
+    }
+
+  private:
+    ChContactPool<Contact> m_pool;
+};
+
+// Simulate collision passes with a number of contacts oscillating around the specified value
+template <typename Storage>
+static void BM_ContactStorage(benchmark::State& st) {
+    int num_contacts = (int)st.range(0);
+    Storage storage;
+    int step = 0;
+    for (auto _ : st) {
+        int n = num_contacts + ((step++ % 7) - 3) * num_contacts / 20;
+        storage.Begin();
+        for (int i = 0; i < n; i++)
+            storage.Add(i);
+        storage.End();
+        benchmark::DoNotOptimize(storage.Sweep());
+    }
+    st.SetItemsProcessed(st.iterations() * num_contacts);
+}
+
+BENCHMARK_TEMPLATE(BM_ContactStorage, ListStorage)->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_ContactStorage, PoolStorage<false>)->Arg(1000)->Arg(10000)->Arg(100000);
+BENCHMARK_TEMPLATE(BM_ContactStorage, PoolStorage<true>)->Arg(1000)->Arg(10000)->Arg(100000);
@@ -0,0 +1,127 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Benchmark test for ensemble runs (utils::ChEnsemble).
+// A sweep of short, independent simulations (spheres with varying friction
+// dropped into a container) is run with an ensemble on 1, 2, 4, and 8 threads
+// and, on POSIX systems, as one process per run with up to 1, 2, 4, and 8
+// concurrent processes. The reported item rate is the number of runs per second.
+//
+// =============================================================================
+
+#include <memory>
+
+#include "chrono/ChConfig.h"
+#include "chrono/core/ChMathematics.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/utils/ChEnsemble.h"
+#include "chrono/utils/ChUtilsSamplers.h"
+
+#include "benchmark/benchmark.h"
+
+#if !defined(_WIN32)
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+using namespace chrono;
+
+// =============================================================================
+
+#define NUM_RUNS 32     // number of runs in the sweep
+#define STEP_SIZE 1e-3  // integration step size
+#define END_TIME 0.1    // final time of each run
+
+class MixerRun : public utils::ChEnsembleMember {
+  public:
+    virtual void Initialize(int index, unsigned int seed) override {
+        m_system = std::unique_ptr<ChSystemNSC>(new ChSystemNSC);
+
+        // The design parameter varies over the sweep
+        auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+        mat->SetFriction(0.1f + 0.8f * index / NUM_RUNS);
+
+        auto ground = chrono_types::make_shared<ChBodyEasyBox>(2, 0.2, 2, 1000, false, true, mat);
+        ground->SetPos(ChVector<>(0, -0.1, 0));
+        ground->SetBodyFixed(true);
+        m_system->AddBody(ground);
+
+        for (int i = 0; i < 40; i++) {
+            auto ball = chrono_types::make_shared<ChBodyEasySphere>(0.05, 1000, false, true, mat);
+            ball->SetPos(ChVector<>(-0.5 + ChRandom(), 0.1 + 0.5 * ChRandom(), -0.5 + ChRandom()));
+            m_system->AddBody(ball);
+        }
+    }
+
+    virtual ChSystem* GetSystem() override { return m_system.get(); }
+
+    virtual void Finalize() override { m_system.reset(); }
+
+  private:
+    std::unique_ptr<ChSystemNSC> m_system;
+};
+
+// =============================================================================
+
+static void Ensemble(benchmark::State& state) {
+    for (auto _ : state) {
+        utils::ChEnsemble ensemble;
+        for (int i = 0; i < NUM_RUNS; i++)
+            ensemble.AddMember(chrono_types::make_shared<MixerRun>());
+        ensemble.SetNumThreads((int)state.range(0));
+        ensemble.Run(STEP_SIZE, END_TIME);
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_RUNS);
+}
+
+BENCHMARK(Ensemble)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+#if !defined(_WIN32)
+
+// Each run in a separate (forked) process, with at most range(0) processes at a time
+static void ProcessPerRun(benchmark::State& state) {
+    int max_procs = (int)state.range(0);
+    for (auto _ : state) {
+        int running = 0;
+        for (int i = 0; i < NUM_RUNS; i++) {
+            if (running == max_procs) {
+                wait(nullptr);
+                running--;
+            }
+            pid_t pid = fork();
+            if (pid == 0) {
+                utils::ChEnsemble ensemble;
+                ensemble.AddMember(chrono_types::make_shared<MixerRun>());
+                ensemble.SetSeed(1 + i);
+                ensemble.Run(STEP_SIZE, END_TIME);
+                _exit(0);
+            }
+            running++;
+        }
+        while (running > 0) {
+            wait(nullptr);
+            running--;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_RUNS);
+}
+
+BENCHMARK(ProcessPerRun)->Arg(1)->Arg(2)->Arg(4)->Arg(8)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+#endif
+
+// =============================================================================
+
+BENCHMARK_MAIN();
@@ -93,6 +93,34 @@ BM_LINK_OP_VOID(UpdateState_LinkLock, ChLinkLock, UpdateState)
 BM_LINK_OP_TIME(Update_LinkMarkers, ChLinkMarkers, Update)
 BM_LINK_OP_TIME(Update_LinkLock, ChLinkLock, Update)
 
+// Benchmark the assembly-level loops over all bodies and joints, using the specified number of threads
+
+BENCHMARK_DEFINE_F(LinkLockBM, SystemUpdate)(benchmark::State& st) {
+    sys->SetNumThreads((int)st.range(0));
+    for (auto _ : st) {
+        sys->Update(crt_time, false);
+    }
+    st.SetItemsProcessed(st.iterations() * sys->Get_linklist().size());
+}
+BENCHMARK_REGISTER_F(LinkLockBM, SystemUpdate)->Unit(benchmark::kMicrosecond)->RangeMultiplier(2)->Range(1, 16);
+
+BENCHMARK_DEFINE_F(LinkLockBM, SystemLoadConstraints)(benchmark::State& st) {
+    sys->SetNumThreads((int)st.range(0));
+    sys->Setup();
+    sys->Update(crt_time, false);
+    ChVectorDynamic<> Qc(sys->GetNconstr());
+    for (auto _ : st) {
+        Qc.setZero();
+        sys->LoadConstraint_C(Qc, 1.0);
+        sys->LoadConstraint_Ct(Qc, 1.0);
+    }
+    st.SetItemsProcessed(st.iterations() * sys->Get_linklist().size());
+}
+BENCHMARK_REGISTER_F(LinkLockBM, SystemLoadConstraints)
+    ->Unit(benchmark::kMicrosecond)
+    ->RangeMultiplier(2)
+    ->Range(1, 16);
+
 // Main function
 
 BENCHMARK_MAIN();
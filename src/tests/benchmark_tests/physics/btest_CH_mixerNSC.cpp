@@ -13,6 +13,8 @@
 // =============================================================================
 //
 // Benchmark test for contact simulation using NSC contact.
+// Each mixer size is run with and without pooling of contact objects across
+// steps (see ChContactContainer::SetContactPooling).
 //
 // =============================================================================
 
@@ -31,7 +33,7 @@ using namespace chrono;
 
 // =============================================================================
 
-template <int N>
+template <int N, bool POOLING = false>
 class MixerTestNSC : public utils::ChBenchmarkTest {
   public:
     MixerTestNSC();
@@ -47,8 +49,10 @@ class MixerTestNSC : public utils::ChBenchmarkTest {
     double m_step;
 };
 
-template <int N>
-MixerTestNSC<N>::MixerTestNSC() : m_system(new ChSystemNSC()), m_step(0.02) {
+template <int N, bool POOLING>
+MixerTestNSC<N, POOLING>::MixerTestNSC() : m_system(new ChSystemNSC()), m_step(0.02) {
+    m_system->GetContactContainer()->SetContactPooling(POOLING);
+
     auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
 
     for (int bi = 0; bi < N; bi++) {
@@ -101,8 +105,8 @@ MixerTestNSC<N>::MixerTestNSC() : m_system(new ChSystemNSC()), m_step(0.02) {
     m_system->AddLink(my_motor);
 }
 
-template <int N>
-void MixerTestNSC<N>::SimulateVis() {
+template <int N, bool POOLING>
+void MixerTestNSC<N, POOLING>::SimulateVis() {
 #ifdef CHRONO_IRRLICHT
     irrlicht::ChIrrApp application(m_system, L"Rigid contacts", irr::core::dimension2d<irr::u32>(800, 600), false, true);
     application.AddTypicalLogo();
@@ -130,6 +134,12 @@ void MixerTestNSC<N>::SimulateVis() {
 CH_BM_SIMULATION_LOOP(MixerNSC032, MixerTestNSC<32>,  NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
 CH_BM_SIMULATION_LOOP(MixerNSC064, MixerTestNSC<64>,  NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
 
+using MixerTestNSC032pooled = MixerTestNSC<32, true>;
+using MixerTestNSC064pooled = MixerTestNSC<64, true>;
+
+CH_BM_SIMULATION_LOOP(MixerNSC032_pooled, MixerTestNSC032pooled,  NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+CH_BM_SIMULATION_LOOP(MixerNSC064_pooled, MixerTestNSC064pooled,  NUM_SKIP_STEPS, NUM_SIM_STEPS, 10);
+
 // =============================================================================
 
 int main(int argc, char* argv[]) {
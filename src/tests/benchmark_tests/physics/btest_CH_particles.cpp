@@ -0,0 +1,116 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Benchmark for the state and residual functions of particle clusters.
+// Compares ChParticlesClones (one heap object per particle) with
+// ChParticlesClonesSoA (particle state in contiguous arrays).
+//
+// =============================================================================
+
+#include <benchmark/benchmark.h>
+
+#include "chrono/physics/ChParticlesClones.h"
+#include "chrono/physics/ChParticlesClonesSoA.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+using namespace chrono;
+
+// Benchmarking fixture: create a system with a single particle cluster
+template <typename Cluster>
+class ParticlesFixture : public ::benchmark::Fixture {
+  public:
+    void SetUp(const ::benchmark::State& st) override {
+        const int num_particles = 100000;
+        sys = new ChSystemNSC();
+        particles = chrono_types::make_shared<Cluster>();
+        particles->SetMass(0.1);
+        particles->SetInertiaXX(ChVector<>(1e-3, 2e-3, 3e-3));
+        for (int i = 0; i < num_particles; i++) {
+            ChVector<> pos(rand() % 1000 / 1000.0, rand() % 1000 / 1000.0, rand() % 1000 / 1000.0);
+            particles->AddParticle(ChCoordsys<>(pos, Q_from_AngX(rand() % 1000 / 1000.0)));
+        }
+        sys->Add(particles);
+
+        int n_x = particles->GetDOF();
+        int n_w = particles->GetDOF_w();
+        x.resize(n_x);
+        x_new.resize(n_x);
+        v.resize(n_w);
+        R.resize(n_w);
+        double T;
+        particles->IntStateGather(0, x, 0, v, T);
+        v.setConstant(0.01);
+    }
+
+    void TearDown(const ::benchmark::State&) override {
+        particles.reset();
+        delete sys;
+    }
+
+    ChSystemNSC* sys;
+    std::shared_ptr<Cluster> particles;
+    ChState x;
+    ChState x_new;
+    ChStateDelta v;
+    ChVectorDynamic<> R;
+};
+
+#define BM_PARTICLES(CLUSTER)                                                         \
+    BENCHMARK_TEMPLATE_DEFINE_F(ParticlesFixture, CLUSTER##_GatherScatter, CLUSTER)   \
+    (benchmark::State & st) {                                                         \
+        double T;                                                                     \
+        for (auto _ : st) {                                                           \
+            particles->IntStateGather(0, x, 0, v, T);                                 \
+            particles->IntStateScatter(0, x, 0, v, T);                                \
+        }                                                                             \
+        st.SetItemsProcessed(st.iterations() * particles->GetNparticles());           \
+    }                                                                                 \
+    BENCHMARK_REGISTER_F(ParticlesFixture, CLUSTER##_GatherScatter)                   \
+        ->Unit(benchmark::kMicrosecond);                                              \
+                                                                                      \
+    BENCHMARK_TEMPLATE_DEFINE_F(ParticlesFixture, CLUSTER##_StateIncrement, CLUSTER)  \
+    (benchmark::State & st) {                                                         \
+        for (auto _ : st) {                                                           \
+            particles->IntStateIncrement(0, x_new, x, 0, v);                          \
+        }                                                                             \
+        st.SetItemsProcessed(st.iterations() * particles->GetNparticles());           \
+    }                                                                                 \
+    BENCHMARK_REGISTER_F(ParticlesFixture, CLUSTER##_StateIncrement)                  \
+        ->Unit(benchmark::kMicrosecond);                                              \
+                                                                                      \
+    BENCHMARK_TEMPLATE_DEFINE_F(ParticlesFixture, CLUSTER##_LoadResidual_F, CLUSTER)  \
+    (benchmark::State & st) {                                                         \
+        for (auto _ : st) {                                                           \
+            R.setZero();                                                              \
+            particles->IntLoadResidual_F(0, R, 1.0);                                  \
+        }                                                                             \
+        st.SetItemsProcessed(st.iterations() * particles->GetNparticles());           \
+    }                                                                                 \
+    BENCHMARK_REGISTER_F(ParticlesFixture, CLUSTER##_LoadResidual_F)                  \
+        ->Unit(benchmark::kMicrosecond);                                              \
+                                                                                      \
+    BENCHMARK_TEMPLATE_DEFINE_F(ParticlesFixture, CLUSTER##_LoadResidual_Mv, CLUSTER) \
+    (benchmark::State & st) {                                                         \
+        for (auto _ : st) {                                                           \
+            R.setZero();                                                              \
+            particles->IntLoadResidual_Mv(0, R, v, 1.0);                              \
+        }                                                                             \
+        st.SetItemsProcessed(st.iterations() * particles->GetNparticles());           \
+    }                                                                                 \
+    BENCHMARK_REGISTER_F(ParticlesFixture, CLUSTER##_LoadResidual_Mv)                 \
+        ->Unit(benchmark::kMicrosecond);
+
+BM_PARTICLES(ChParticlesClones)
+BM_PARTICLES(ChParticlesClonesSoA)
+
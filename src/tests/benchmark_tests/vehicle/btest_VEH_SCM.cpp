@@ -0,0 +1,127 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Benchmark test for SCM deformable terrain ray casting.
+// Four wheels, each with its own moving patch, are held at a fixed sinkage in a
+// fine SCM mesh. The reported time is the time spent in the SCM ray casting phase
+// and the item rate is the number of processed SCM vertices per second.
+//
+// Benchmark arguments: number of threads, ray casting restricted to the moving
+// patch bodies (0/1).
+//
+// =============================================================================
+
+#include <benchmark/benchmark.h>
+
+#include "chrono/physics/ChSystemSMC.h"
+
+#include "chrono_vehicle/terrain/SCMDeformableTerrain.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+// =============================================================================
+
+class SCMTest {
+  public:
+    SCMTest(int num_threads, bool patch_bodies_only);
+    ~SCMTest() { delete m_terrain; }
+
+    void ExecuteStep() { m_system.DoStepDynamics(m_step); }
+
+    size_t GetNumRayCasts() const { return m_terrain->GetNumRayCasts(); }
+    double GetTimerRayCasting() const { return m_terrain->GetTimerRayCasting(); }
+
+  private:
+    ChSystemSMC m_system;
+    SCMDeformableTerrain* m_terrain;
+    double m_step;
+};
+
+SCMTest::SCMTest(int num_threads, bool patch_bodies_only) : m_step(1e-3) {
+    m_system.Set_G_acc(ChVector<>(0, 0, -9.81));
+    m_system.SetNumThreads(num_threads);
+
+    // Create the SCM terrain (10 m x 4 m, 2 cm resolution) without visualization mesh
+    m_terrain = new SCMDeformableTerrain(&m_system, false);
+    m_terrain->Initialize(0, 10, 4, 500, 200);
+    m_terrain->SetSoilParameters(0.2e6, 0, 1.1, 0, 30, 0.01, 4e7, 3e4);
+    m_terrain->SetRayCastingPatchBodiesOnly(patch_bodies_only);
+
+    // Create the wheels (fixed, slightly sunk into the terrain), with one moving patch per wheel
+    auto material = chrono_types::make_shared<ChMaterialSurfaceSMC>();
+    double radius = 0.5;
+    double width = 0.3;
+    for (int i = 0; i < 4; i++) {
+        auto wheel = chrono_types::make_shared<ChBody>();
+        wheel->SetPos(ChVector<>(-1.5 + (i / 2) * 3.0, -1.0 + (i % 2) * 2.0, radius - 0.05));
+        wheel->SetBodyFixed(true);
+        wheel->SetCollide(true);
+        wheel->GetCollisionModel()->ClearModel();
+        wheel->GetCollisionModel()->AddCylinder(material, radius, radius, width / 2);
+        wheel->GetCollisionModel()->BuildModel();
+        m_system.AddBody(wheel);
+
+        m_terrain->AddMovingPatch(wheel, ChVector<>(0, 0, 0), 2 * radius, 2 * width);
+    }
+
+    // Add some obstacles that do not interact with the terrain (tested by unrestricted ray casts only)
+    for (int i = 0; i < 50; i++) {
+        auto box = chrono_types::make_shared<ChBody>();
+        box->SetPos(ChVector<>(-4.5 + 0.2 * i, 1.8, 2.0));
+        box->SetBodyFixed(true);
+        box->SetCollide(true);
+        box->GetCollisionModel()->ClearModel();
+        box->GetCollisionModel()->AddBox(material, 0.05, 0.05, 0.05);
+        box->GetCollisionModel()->BuildModel();
+        m_system.AddBody(box);
+    }
+}
+
+// =============================================================================
+
+#define NUM_SKIP_STEPS 10  // number of steps for hot start
+#define NUM_SIM_STEPS 100  // number of simulation steps for each benchmark
+
+static void SCM_RayCasting(benchmark::State& st) {
+    SCMTest test((int)st.range(0), st.range(1) != 0);
+    for (int i = 0; i < NUM_SKIP_STEPS; i++)
+        test.ExecuteStep();
+
+    size_t num_ray_casts = 0;
+    for (auto _ : st) {
+        double time = 0;
+        for (int i = 0; i < NUM_SIM_STEPS; i++) {
+            test.ExecuteStep();
+            num_ray_casts += test.GetNumRayCasts();
+            time += test.GetTimerRayCasting();
+        }
+        st.SetIterationTime(time);
+    }
+    st.SetItemsProcessed(num_ray_casts);
+    st.SetLabel("items = SCM vertices");
+}
+BENCHMARK(SCM_RayCasting)
+    ->UseManualTime()
+    ->Unit(benchmark::kMillisecond)
+    ->Args({1, 0})
+    ->Args({2, 0})
+    ->Args({4, 0})
+    ->Args({8, 0})
+    ->Args({1, 1})
+    ->Args({2, 1})
+    ->Args({4, 1})
+    ->Args({8, 1});
+
+BENCHMARK_MAIN();
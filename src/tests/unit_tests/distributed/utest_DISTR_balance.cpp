@@ -0,0 +1,133 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Unit test for the dynamic load balancing of the sub-domains.
+// A pile of spheres settles at one end of the domain. With load balancing, the
+// sub-domain boundaries must move towards the pile, without losing bodies.
+//
+// To be run on 2 or more MPI ranks, e.g.: mpirun -np 4 utest_DISTR_balance
+//
+// =============================================================================
+
+#include <mpi.h>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include "chrono/physics/ChBody.h"
+
+#include "chrono_distributed/collision/ChBoundary.h"
+#include "chrono_distributed/collision/ChCollisionModelDistributed.h"
+#include "chrono_distributed/physics/ChDomainDistributed.h"
+#include "chrono_distributed/physics/ChSystemDistributed.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+// Count the bodies this rank is responsible for (each body is owned or shared by exactly one rank)
+static int CountOwnedBodies(ChSystemDistributed& sys) {
+    int count = 0;
+    for (auto status : sys.ddm->comm_status) {
+        if (status == distributed::OWNED || status == distributed::SHARED_UP || status == distributed::SHARED_DOWN)
+            count++;
+    }
+    return count;
+}
+
+int main(int argc, char* argv[]) {
+    MPI_Init(&argc, &argv);
+    int my_rank;
+    int num_ranks;
+    MPI_Comm_rank(MPI_COMM_WORLD, &my_rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &num_ranks);
+
+    double radius = 0.1;
+    double ghost_layer = 2 * radius;
+
+    ChSystemDistributed sys(MPI_COMM_WORLD, ghost_layer, 10000);
+    sys.Set_G_acc(ChVector<double>(0, 0, -9.8));
+    sys.GetDomain()->SetSplitAxis(0);
+    sys.GetDomain()->SetSimDomain(0, 10, 0, 2, -1, 5);
+    sys.GetDomain()->SetBalanceInterval(10);
+    sys.GetSettings()->solver.contact_force_model = ChSystemSMC::Hooke;
+    sys.GetSettings()->collision.bins_per_axis = vec3(10, 10, 10);
+
+    auto material = chrono_types::make_shared<ChMaterialSurfaceSMC>();
+
+    // Container floor and walls, present on all ranks
+    auto bin = chrono_types::make_shared<ChBody>(chrono_types::make_shared<ChCollisionModelDistributed>());
+    bin->SetBodyFixed(true);
+    bin->SetCollide(true);
+    sys.AddBodyAllRanks(bin);
+
+    auto boundary = new ChBoundary(bin, material);
+    boundary->AddPlane(ChFrame<>(ChVector<>(5, 1, 0), QUNIT), ChVector2<>(10, 2));
+    boundary->AddPlane(ChFrame<>(ChVector<>(0, 1, 2), Q_from_AngY(CH_C_PI_2)), ChVector2<>(4, 2));
+    boundary->AddPlane(ChFrame<>(ChVector<>(5, 0, 2), Q_from_AngX(-CH_C_PI_2)), ChVector2<>(10, 4));
+    boundary->AddPlane(ChFrame<>(ChVector<>(5, 2, 2), Q_from_AngX(CH_C_PI_2)), ChVector2<>(10, 4));
+
+    // Pile of spheres in the first 2 units of the domain
+    int num_bodies = 0;
+    for (int iz = 0; iz < 4; iz++) {
+        for (int iy = 0; iy < 8; iy++) {
+            for (int ix = 0; ix < 8; ix++) {
+                ChVector<> pos(0.15 + 0.25 * ix, 0.15 + 0.25 * iy, 0.15 + 0.25 * iz);
+                auto ball = chrono_types::make_shared<ChBody>(chrono_types::make_shared<ChCollisionModelDistributed>());
+                ball->SetMass(1);
+                ball->SetInertiaXX(ChVector<>(0.4 * radius * radius));
+                ball->SetPos(pos);
+                ball->GetCollisionModel()->ClearModel();
+                ball->GetCollisionModel()->AddSphere(material, radius);
+                ball->GetCollisionModel()->BuildModel();
+                ball->SetCollide(true);
+                sys.AddBody(ball);
+                num_bodies++;
+            }
+        }
+    }
+
+    double initial_hi = sys.GetDomain()->GetSplitPoints()[1];
+
+    for (int i = 0; i < 1000; i++)
+        sys.DoStepDynamics(1e-4);
+
+    int owned = CountOwnedBodies(sys);
+    int total = 0;
+    MPI_Allreduce(&owned, &total, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+
+    int ret = 0;
+    if (total != num_bodies) {
+        if (my_rank == 0)
+            std::cout << "Body count mismatch: " << total << " instead of " << num_bodies << std::endl;
+        ret = 1;
+    }
+
+    // The first sub-domain must have shrunk towards the pile, and all sub-domains must be longer than 2 ghost layers
+    const std::vector<double>& points = sys.GetDomain()->GetSplitPoints();
+    if (num_ranks > 1 && points[1] >= initial_hi) {
+        if (my_rank == 0)
+            std::cout << "Sub-domain boundaries did not move: " << points[1] << std::endl;
+        ret = 1;
+    }
+    for (int i = 0; i < num_ranks; i++) {
+        if (points[i + 1] - points[i] < 2 * ghost_layer - 1e-12) {
+            if (my_rank == 0)
+                std::cout << "Sub-domain " << i << " too thin: " << points[i + 1] - points[i] << std::endl;
+            ret = 1;
+        }
+    }
+
+    MPI_Finalize();
+    return ret;
+}
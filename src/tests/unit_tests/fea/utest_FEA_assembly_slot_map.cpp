@@ -0,0 +1,175 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Test the assembly of the system matrix with a cached map of the CSR value
+// slots, on a system of ANCF cables connected to rigid bodies. Compare the
+// assembled matrix and the simulation results with those obtained with the
+// default assembly, also after a change in the problem structure. Check that
+// the assembled matrix does not depend on the number of assembly threads.
+//
+// =============================================================================
+
+#include <cmath>
+
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/fea/ChBuilderBeam.h"
+#include "chrono/fea/ChLinkPointFrame.h"
+#include "chrono/fea/ChLinkDirFrame.h"
+#include "chrono/solver/ChDirectSolverLS.h"
+#include "chrono/timestepper/ChTimestepper.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+class Model {
+  public:
+    Model(std::shared_ptr<ChDirectSolverLS> solver);
+    std::shared_ptr<ChSystemNSC> GetSystem() const { return m_system; }
+    std::shared_ptr<ChBodyEasyBox> GetBox() const { return m_box; }
+    std::shared_ptr<ChLinkDirFrame> GetDirLink() const { return m_dir; }
+
+  private:
+    std::shared_ptr<ChSystemNSC> m_system;
+    std::shared_ptr<ChBodyEasyBox> m_box;
+    std::shared_ptr<ChLinkDirFrame> m_dir;
+};
+
+Model::Model(std::shared_ptr<ChDirectSolverLS> solver) {
+    m_system = chrono_types::make_shared<ChSystemNSC>();
+
+    auto mesh = chrono_types::make_shared<ChMesh>();
+
+    auto section = chrono_types::make_shared<ChBeamSectionCable>();
+    section->SetDiameter(0.015);
+    section->SetYoungModulus(0.01e9);
+    section->SetBeamRaleyghDamping(0.000);
+
+    auto truss = chrono_types::make_shared<ChBody>();
+    truss->SetBodyFixed(true);
+
+    // Cable hinged to the truss, with a box at its end
+    ChBuilderCableANCF builder;
+    builder.BuildBeam(mesh, section, 10, ChVector<>(0, 0, 0), ChVector<>(1, 0, 0));
+
+    auto hinge = chrono_types::make_shared<ChLinkPointFrame>();
+    hinge->Initialize(builder.GetLastBeamNodes().front(), truss);
+    m_system->Add(hinge);
+
+    m_box = chrono_types::make_shared<ChBodyEasyBox>(0.2, 0.04, 0.04, 1000);
+    m_box->SetPos(builder.GetLastBeamNodes().back()->GetPos() + ChVector<>(0.1, 0, 0));
+    m_system->Add(m_box);
+
+    auto pos = chrono_types::make_shared<ChLinkPointFrame>();
+    pos->Initialize(builder.GetLastBeamNodes().back(), m_box);
+    m_system->Add(pos);
+
+    m_dir = chrono_types::make_shared<ChLinkDirFrame>();
+    m_dir->Initialize(builder.GetLastBeamNodes().back(), m_box);
+    m_dir->SetDirectionInAbsoluteCoords(ChVector<>(1, 0, 0));
+    m_system->Add(m_dir);
+
+    m_system->Add(mesh);
+
+    m_system->SetTimestepperType(ChTimestepper::Type::EULER_IMPLICIT_LINEARIZED);
+    m_system->SetSolver(solver);
+}
+
+// Simulate the model with slot map assembly (using the specified number of threads) and with the default assembly.
+// Optionally, disable a link half-way through the simulation. Compare the assembled matrices and the box positions.
+static void Compare(int num_threads, bool change_structure) {
+    auto solver1 = chrono_types::make_shared<ChSolverSparseLU>();
+    solver1->LockSparsityPattern(true);
+    solver1->UseSlotMapAssembly(true);
+    solver1->SetNumAssemblyThreads(num_threads);
+    Model model1(solver1);
+
+    auto solver2 = chrono_types::make_shared<ChSolverSparseLU>();
+    solver2->LockSparsityPattern(false);
+    Model model2(solver2);
+
+    // Stiffness blocks are added in a different order than in the default assembly
+    double precision = 1e-9;
+    double timestep = 0.002;
+    int num_steps = 200;
+
+    for (int i = 0; i < num_steps; i++) {
+        if (change_structure && i == num_steps / 2) {
+            model1.GetDirLink()->SetDisabled(true);
+            model2.GetDirLink()->SetDisabled(true);
+        }
+
+        model1.GetSystem()->DoStepDynamics(timestep);
+        model2.GetSystem()->DoStepDynamics(timestep);
+
+        const auto& mat1 = solver1->GetMatrix();
+        const auto& mat2 = solver2->GetMatrix();
+        ASSERT_EQ(mat1.rows(), mat2.rows());
+        ASSERT_LE((mat1 - mat2).norm(), precision * mat2.norm());
+
+        auto pos1 = model1.GetBox()->GetPos();
+        auto pos2 = model2.GetBox()->GetPos();
+        ASSERT_NEAR(pos1.x(), pos2.x(), precision);
+        ASSERT_NEAR(pos1.y(), pos2.y(), precision);
+        ASSERT_NEAR(pos1.z(), pos2.z(), precision);
+    }
+
+    // The slot map is recorded at the first call to Setup and again after the change in problem structure.
+    // All other calls to Setup use the slot map assembly and do not require a new symbolic analysis.
+    int num_records = change_structure ? 2 : 1;
+    ASSERT_EQ(solver1->GetNumAnalysisCalls(), num_records);
+    ASSERT_EQ(solver1->GetNumSlotMapAssemblies(), solver1->GetNumSetupCalls() - num_records);
+}
+
+TEST(AssemblySlotMap, serial) {
+    Compare(1, false);
+}
+
+TEST(AssemblySlotMap, parallel) {
+    Compare(4, false);
+}
+
+TEST(AssemblySlotMap, structure_change) {
+    Compare(1, true);
+    Compare(4, true);
+}
+
+TEST(AssemblySlotMap, deterministic) {
+    auto solver1 = chrono_types::make_shared<ChSolverSparseLU>();
+    solver1->LockSparsityPattern(true);
+    solver1->UseSlotMapAssembly(true);
+    solver1->SetNumAssemblyThreads(1);
+    Model model1(solver1);
+
+    auto solver4 = chrono_types::make_shared<ChSolverSparseLU>();
+    solver4->LockSparsityPattern(true);
+    solver4->UseSlotMapAssembly(true);
+    solver4->SetNumAssemblyThreads(4);
+    Model model4(solver4);
+
+    // The assembled matrices and the simulation results are bit-identical
+    for (int i = 0; i < 50; i++) {
+        model1.GetSystem()->DoStepDynamics(0.002);
+        model4.GetSystem()->DoStepDynamics(0.002);
+
+        const auto& mat1 = solver1->GetMatrix();
+        const auto& mat4 = solver4->GetMatrix();
+        ASSERT_EQ(mat1.nonZeros(), mat4.nonZeros());
+        for (int k = 0; k < mat1.nonZeros(); k++)
+            ASSERT_EQ(mat1.valuePtr()[k], mat4.valuePtr()[k]);
+        ASSERT_TRUE(model1.GetBox()->GetPos().Equals(model4.GetBox()->GetPos()));
+    }
+}
@@ -0,0 +1,158 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Test the loading of element internal and gravity forces in ChMesh, performed
+// one element color at a time and in parallel over the elements of each color.
+// Compare the residual with a serial accumulation over all elements, for a
+// plate of ANCF shells and for a fan of ANCF cables sharing a hub node.
+//
+// =============================================================================
+
+#include <cmath>
+
+#include "chrono/core/ChMathematics.h"
+#include "chrono/parallel/ChOpenMP.h"
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/fea/ChElementCableANCF.h"
+#include "chrono/fea/ChElementShellANCF.h"
+#include "chrono/fea/ChMesh.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+// Square plate of N x N ANCF shells, fixed along one edge.
+// Each interior node is shared by 4 elements, which the greedy coloring places in 4 different colors.
+static std::shared_ptr<ChMesh> CreatePlate(ChSystem& system, int N) {
+    auto mesh = chrono_types::make_shared<ChMesh>();
+    system.Add(mesh);
+
+    double dx = 1.0 / N;
+    auto mat = chrono_types::make_shared<ChMaterialShellANCF>(500, ChVector<>(2.1e7), ChVector<>(0.3),
+                                                              ChVector<>(8.0769231e6));
+
+    std::vector<std::shared_ptr<ChNodeFEAxyzD>> nodes;
+    for (int j = 0; j <= N; j++) {
+        for (int i = 0; i <= N; i++) {
+            auto node = chrono_types::make_shared<ChNodeFEAxyzD>(ChVector<>(i * dx, j * dx, 0), ChVector<>(0, 0, 1));
+            node->SetFixed(i == 0);
+            mesh->AddNode(node);
+            nodes.push_back(node);
+        }
+    }
+    for (int j = 0; j < N; j++) {
+        for (int i = 0; i < N; i++) {
+            auto element = chrono_types::make_shared<ChElementShellANCF>();
+            element->SetNodes(nodes[j * (N + 1) + i], nodes[j * (N + 1) + i + 1], nodes[(j + 1) * (N + 1) + i + 1],
+                              nodes[(j + 1) * (N + 1) + i]);
+            element->SetDimensions(dx, dx);
+            element->AddLayer(0.01, 0, mat);
+            element->SetAlphaDamp(0.01);
+            mesh->AddElement(element);
+        }
+    }
+
+    return mesh;
+}
+
+// Fan of M two-element ANCF cables, all connected to a fixed hub node.
+// The first element of each cable shares the hub node, so that each one is placed in a different color, while the
+// second elements share their nodes with elements of several different colors.
+static std::shared_ptr<ChMesh> CreateFan(ChSystem& system, int M) {
+    auto mesh = chrono_types::make_shared<ChMesh>();
+    system.Add(mesh);
+
+    auto section = chrono_types::make_shared<ChBeamSectionCable>();
+    section->SetDiameter(0.015);
+    section->SetYoungModulus(0.01e9);
+    section->SetBeamRaleyghDamping(0.01);
+
+    auto hub = chrono_types::make_shared<ChNodeFEAxyzD>(ChVector<>(0, 0, 0), ChVector<>(1, 0, 0));
+    hub->SetFixed(true);
+    mesh->AddNode(hub);
+
+    for (int k = 0; k < M; k++) {
+        ChVector<> dir(std::cos(k * CH_C_2PI / M), std::sin(k * CH_C_2PI / M), 0);
+        auto node1 = chrono_types::make_shared<ChNodeFEAxyzD>(0.5 * dir, dir);
+        auto node2 = chrono_types::make_shared<ChNodeFEAxyzD>(1.0 * dir, dir);
+        mesh->AddNode(node1);
+        mesh->AddNode(node2);
+
+        auto element1 = chrono_types::make_shared<ChElementCableANCF>();
+        element1->SetNodes(hub, node1);
+        element1->SetSection(section);
+        mesh->AddElement(element1);
+
+        auto element2 = chrono_types::make_shared<ChElementCableANCF>();
+        element2->SetNodes(node1, node2);
+        element2->SetSection(section);
+        mesh->AddElement(element2);
+    }
+
+    return mesh;
+}
+
+// Deform the mesh and compare the residual loaded by ChMesh (colored, parallel) with a serial accumulation.
+static void Compare(ChSystem& system, std::shared_ptr<ChMesh> mesh, int min_colors) {
+    system.Set_G_acc(ChVector<>(0, 0, -9.8));
+    mesh->SetAutomaticGravity(true);
+
+    // Initialize the system and compute the state offsets, then set random node positions and velocities.
+    // No dynamics step is taken: the default solver is not suited to these meshes.
+    system.Update(false);
+    system.Setup();
+    ChSetRandomSeed(42);
+    for (unsigned int i = 0; i < mesh->GetNnodes(); i++) {
+        auto node = std::dynamic_pointer_cast<ChNodeFEAxyzD>(mesh->GetNode(i));
+        if (node->GetFixed())
+            continue;
+        node->SetPos(node->GetPos() + 0.01 * ChVector<>(ChRandom() - 0.5, ChRandom() - 0.5, ChRandom() - 0.5));
+        node->SetD(node->GetD() + 0.01 * ChVector<>(ChRandom() - 0.5, ChRandom() - 0.5, ChRandom() - 0.5));
+        node->SetPos_dt(ChVector<>(ChRandom() - 0.5, ChRandom() - 0.5, ChRandom() - 0.5));
+    }
+    system.Update(false);
+
+    // Serial accumulation over all elements, in element order
+    ChVectorDynamic<> R_serial(system.GetNcoords_w());
+    R_serial.setZero();
+    for (unsigned int i = 0; i < mesh->GetNelements(); i++) {
+        mesh->GetElement(i)->EleIntLoadResidual_F(R_serial, 1.0);
+        mesh->GetElement(i)->EleIntLoadResidual_F_gravity(R_serial, system.Get_G_acc(), 1.0);
+    }
+
+    // Colored accumulation, with several threads
+    int num_threads = CHOMPfunctions::GetMaxThreads();
+    CHOMPfunctions::SetNumThreads(4);
+    ChVectorDynamic<> R_colored(system.GetNcoords_w());
+    R_colored.setZero();
+    mesh->IntLoadResidual_F(mesh->GetOffset_w(), R_colored, 1.0);
+    CHOMPfunctions::SetNumThreads(num_threads);
+
+    ASSERT_GE(mesh->GetNumElementColors(), min_colors);
+    ASSERT_GT(R_serial.norm(), 0.0);
+    ASSERT_LE((R_colored - R_serial).norm(), 1e-12 * R_serial.norm());
+}
+
+TEST(ElementColoring, shell_plate) {
+    ChSystemSMC system;
+    auto mesh = CreatePlate(system, 8);
+    Compare(system, mesh, 4);
+}
+
+TEST(ElementColoring, cable_fan) {
+    ChSystemSMC system;
+    auto mesh = CreateFan(system, 12);
+    Compare(system, mesh, 12);
+}
@@ -0,0 +1,217 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Test the preconditioners of the iterative linear solvers on a system of ANCF
+// cables connected to rigid bodies. Compare results with the SparseQR solver and
+// check that the block-Jacobi and ILU preconditioners require significantly fewer
+// iterations than the diagonal preconditioner. The mesh is kept small so that the
+// test runs quickly; see btest_FEA_sparse_solver for timings on larger problems.
+//
+// =============================================================================
+
+#include <cmath>
+
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/fea/ChBuilderBeam.h"
+#include "chrono/fea/ChLinkPointFrame.h"
+#include "chrono/fea/ChLinkDirFrame.h"
+#include "chrono/solver/ChIterativeSolverLS.h"
+#include "chrono/solver/ChDirectSolverLS.h"
+#include "chrono/timestepper/ChTimestepper.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+using PrecondType = ChIterativeSolverLS::PreconditionerType;
+
+class Model {
+  public:
+    Model();
+    std::shared_ptr<ChSystemNSC> GetSystem() const { return m_system; }
+    std::shared_ptr<ChBodyEasyBox> GetBox1() const { return m_box1; }
+    std::shared_ptr<ChBodyEasyBox> GetBox2() const { return m_box2; }
+
+  private:
+    std::shared_ptr<ChSystemNSC> m_system;
+    std::shared_ptr<ChBodyEasyBox> m_box1;
+    std::shared_ptr<ChBodyEasyBox> m_box2;
+};
+
+Model::Model() {
+    m_system = chrono_types::make_shared<ChSystemNSC>();
+
+    auto mesh = chrono_types::make_shared<ChMesh>();
+
+    auto section = chrono_types::make_shared<ChBeamSectionCable>();
+    section->SetDiameter(0.015);
+    section->SetYoungModulus(0.01e9);
+    section->SetBeamRaleyghDamping(0.000);
+
+    auto truss = chrono_types::make_shared<ChBody>();
+    truss->SetBodyFixed(true);
+
+    ChBuilderCableANCF builder;
+
+    // First cable, hinged to the truss, with a box at its end
+    builder.BuildBeam(mesh, section, 2, ChVector<>(0, 0, 0), ChVector<>(0.4, 0, 0));
+
+    auto hinge = chrono_types::make_shared<ChLinkPointFrame>();
+    hinge->Initialize(builder.GetLastBeamNodes().front(), truss);
+    m_system->Add(hinge);
+
+    m_box1 = chrono_types::make_shared<ChBodyEasyBox>(0.2, 0.04, 0.04, 1000);
+    m_box1->SetPos(builder.GetLastBeamNodes().back()->GetPos() + ChVector<>(0.1, 0, 0));
+    m_system->Add(m_box1);
+
+    auto pos1 = chrono_types::make_shared<ChLinkPointFrame>();
+    pos1->Initialize(builder.GetLastBeamNodes().back(), m_box1);
+    m_system->Add(pos1);
+
+    auto dir1 = chrono_types::make_shared<ChLinkDirFrame>();
+    dir1->Initialize(builder.GetLastBeamNodes().back(), m_box1);
+    dir1->SetDirectionInAbsoluteCoords(ChVector<>(1, 0, 0));
+    m_system->Add(dir1);
+
+    // Second cable, between the two boxes
+    builder.BuildBeam(mesh, section, 4, ChVector<>(m_box1->GetPos().x() + 0.1, 0, 0),
+                      ChVector<>(m_box1->GetPos().x() + 0.9, 0, 0));
+
+    auto pos2 = chrono_types::make_shared<ChLinkPointFrame>();
+    pos2->Initialize(builder.GetLastBeamNodes().front(), m_box1);
+    m_system->Add(pos2);
+
+    auto dir2 = chrono_types::make_shared<ChLinkDirFrame>();
+    dir2->Initialize(builder.GetLastBeamNodes().front(), m_box1);
+    dir2->SetDirectionInAbsoluteCoords(ChVector<>(1, 0, 0));
+    m_system->Add(dir2);
+
+    m_box2 = chrono_types::make_shared<ChBodyEasyBox>(0.2, 0.04, 0.04, 1000);
+    m_box2->SetPos(builder.GetLastBeamNodes().back()->GetPos() + ChVector<>(0.1, 0, 0));
+    m_system->Add(m_box2);
+
+    auto pos3 = chrono_types::make_shared<ChLinkPointFrame>();
+    pos3->Initialize(builder.GetLastBeamNodes().back(), m_box2);
+    m_system->Add(pos3);
+
+    auto dir3 = chrono_types::make_shared<ChLinkDirFrame>();
+    dir3->Initialize(builder.GetLastBeamNodes().back(), m_box2);
+    dir3->SetDirectionInAbsoluteCoords(ChVector<>(1, 0, 0));
+    m_system->Add(dir3);
+
+    m_system->Add(mesh);
+
+    m_system->SetTimestepperType(ChTimestepper::Type::EULER_IMPLICIT_LINEARIZED);
+    m_system->SetSolverForceTolerance(1e-13);
+}
+
+static void CompareVectors(const ChVector<>& v1, const ChVector<>& v2, double tol) {
+    ASSERT_NEAR(v1.x(), v2.x(), tol);
+    ASSERT_NEAR(v1.y(), v2.y(), tol);
+    ASSERT_NEAR(v1.z(), v2.z(), tol);
+}
+
+// Simulate the model with the given iterative solver and with SparseQR; compare the positions of the two boxes.
+// Return the average number of solver iterations per step.
+static double Compare(std::shared_ptr<ChIterativeSolverLS> solver, int num_steps) {
+    Model model1;
+    Model model2;
+
+    solver->SetMaxIterations(500);
+    solver->SetTolerance(1e-12);
+    model1.GetSystem()->SetSolver(solver);
+
+    auto qr_solver = chrono_types::make_shared<ChSolverSparseQR>();
+    qr_solver->LockSparsityPattern(true);
+    model2.GetSystem()->SetSolver(qr_solver);
+
+    const double precision = 1e-5;
+    double timestep = 0.002;
+    double iterations = 0;
+
+    for (int i = 0; i < num_steps; i++) {
+        model1.GetSystem()->DoStepDynamics(timestep);
+        model2.GetSystem()->DoStepDynamics(timestep);
+        iterations += solver->GetIterations();
+
+        CompareVectors(model1.GetBox1()->GetPos(), model2.GetBox1()->GetPos(), precision);
+        CompareVectors(model1.GetBox2()->GetPos(), model2.GetBox2()->GetPos(), precision);
+    }
+
+    return iterations / num_steps;
+}
+
+// Simulate the model with the given iterative solver, limited to the specified number of iterations.
+// Return the average number of solver iterations per step.
+static double CountIterations(std::shared_ptr<ChIterativeSolverLS> solver, int max_iterations, int num_steps) {
+    Model model;
+
+    solver->SetMaxIterations(max_iterations);
+    solver->SetTolerance(1e-12);
+    model.GetSystem()->SetSolver(solver);
+
+    double timestep = 0.002;
+    double iterations = 0;
+
+    for (int i = 0; i < num_steps; i++) {
+        model.GetSystem()->DoStepDynamics(timestep);
+        iterations += solver->GetIterations();
+    }
+
+    return iterations / num_steps;
+}
+
+TEST(IterativePreconditioner, GMRES) {
+    // With the diagonal preconditioner, GMRES does not reach the required tolerance for this problem; it is run with a
+    // lower iteration limit, which the other preconditioners must remain well below.
+    int num_steps = 20;
+    auto diag_solver = chrono_types::make_shared<ChSolverGMRES>();
+    diag_solver->SetPreconditioner(PrecondType::DIAGONAL);
+    double diag_iterations = CountIterations(diag_solver, 400, num_steps);
+
+    for (auto type : {PrecondType::BLOCK_JACOBI, PrecondType::ILU}) {
+        auto solver = chrono_types::make_shared<ChSolverGMRES>();
+        solver->SetPreconditioner(type);
+        ASSERT_EQ(solver->GetPreconditioner(), type);
+        double iterations = Compare(solver, num_steps);
+        ASSERT_EQ(solver->GetNumPreconditionerUpdates(), num_steps);
+        ASSERT_LT(iterations, 0.5 * diag_iterations);
+    }
+}
+
+TEST(IterativePreconditioner, MINRES) {
+    int num_steps = 20;
+    auto diag_solver = chrono_types::make_shared<ChSolverMINRES>();
+    diag_solver->SetPreconditioner(PrecondType::DIAGONAL);
+    double diag_iterations = Compare(diag_solver, num_steps);
+
+    auto solver = chrono_types::make_shared<ChSolverMINRES>();
+    solver->SetPreconditioner(PrecondType::BLOCK_JACOBI);
+    double iterations = Compare(solver, num_steps);
+    ASSERT_LT(iterations, 0.5 * diag_iterations);
+}
+
+TEST(IterativePreconditioner, reuse) {
+    // Reusing the preconditioner over several steps must not affect the solution
+    int num_steps = 40;
+    for (auto type : {PrecondType::BLOCK_JACOBI, PrecondType::ILU}) {
+        auto solver = chrono_types::make_shared<ChSolverGMRES>();
+        solver->SetPreconditioner(type);
+        solver->SetPreconditionerUpdateInterval(10);
+        Compare(solver, num_steps);
+        ASSERT_EQ(solver->GetNumPreconditionerUpdates(), num_steps / 10);
+    }
+}
@@ -0,0 +1,269 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Test the sparse LDLT direct solver:
+// - dynamics of ANCF cables connected to rigid bodies (symmetric indefinite),
+//   compared with the SparseQR solver;
+// - static analysis of an ANCF shell mesh (symmetric positive definite),
+//   compared with the SparseLU solver.
+// Also check that, with a locked sparsity pattern, the symbolic analysis is
+// performed only once, and that non-symmetric matrix types are rejected.
+//
+// =============================================================================
+
+#include <cmath>
+
+#include "chrono/core/ChException.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/fea/ChBuilderBeam.h"
+#include "chrono/fea/ChElementShellANCF.h"
+#include "chrono/fea/ChLinkPointFrame.h"
+#include "chrono/fea/ChLinkDirFrame.h"
+#include "chrono/fea/ChMesh.h"
+#include "chrono/solver/ChDirectSolverLS.h"
+#include "chrono/timestepper/ChTimestepper.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::fea;
+
+// -----------------------------------------------------------------------------
+
+class CableModel {
+  public:
+    CableModel();
+    std::shared_ptr<ChSystemNSC> GetSystem() const { return m_system; }
+    std::shared_ptr<ChBodyEasyBox> GetBox1() const { return m_box1; }
+    std::shared_ptr<ChBodyEasyBox> GetBox2() const { return m_box2; }
+
+  private:
+    std::shared_ptr<ChSystemNSC> m_system;
+    std::shared_ptr<ChBodyEasyBox> m_box1;
+    std::shared_ptr<ChBodyEasyBox> m_box2;
+};
+
+CableModel::CableModel() {
+    m_system = chrono_types::make_shared<ChSystemNSC>();
+
+    auto mesh = chrono_types::make_shared<ChMesh>();
+
+    auto section = chrono_types::make_shared<ChBeamSectionCable>();
+    section->SetDiameter(0.015);
+    section->SetYoungModulus(0.01e9);
+    section->SetBeamRaleyghDamping(0.000);
+
+    auto truss = chrono_types::make_shared<ChBody>();
+    truss->SetBodyFixed(true);
+
+    ChBuilderCableANCF builder;
+
+    // First cable, hinged to the truss, with a box at its end
+    builder.BuildBeam(mesh, section, 4, ChVector<>(0, 0, 0), ChVector<>(0.4, 0, 0));
+
+    auto hinge = chrono_types::make_shared<ChLinkPointFrame>();
+    hinge->Initialize(builder.GetLastBeamNodes().front(), truss);
+    m_system->Add(hinge);
+
+    m_box1 = chrono_types::make_shared<ChBodyEasyBox>(0.2, 0.04, 0.04, 1000);
+    m_box1->SetPos(builder.GetLastBeamNodes().back()->GetPos() + ChVector<>(0.1, 0, 0));
+    m_system->Add(m_box1);
+
+    auto pos1 = chrono_types::make_shared<ChLinkPointFrame>();
+    pos1->Initialize(builder.GetLastBeamNodes().back(), m_box1);
+    m_system->Add(pos1);
+
+    auto dir1 = chrono_types::make_shared<ChLinkDirFrame>();
+    dir1->Initialize(builder.GetLastBeamNodes().back(), m_box1);
+    dir1->SetDirectionInAbsoluteCoords(ChVector<>(1, 0, 0));
+    m_system->Add(dir1);
+
+    // Second cable, between the two boxes
+    builder.BuildBeam(mesh, section, 8, ChVector<>(m_box1->GetPos().x() + 0.1, 0, 0),
+                      ChVector<>(m_box1->GetPos().x() + 0.9, 0, 0));
+
+    auto pos2 = chrono_types::make_shared<ChLinkPointFrame>();
+    pos2->Initialize(builder.GetLastBeamNodes().front(), m_box1);
+    m_system->Add(pos2);
+
+    auto dir2 = chrono_types::make_shared<ChLinkDirFrame>();
+    dir2->Initialize(builder.GetLastBeamNodes().front(), m_box1);
+    dir2->SetDirectionInAbsoluteCoords(ChVector<>(1, 0, 0));
+    m_system->Add(dir2);
+
+    m_box2 = chrono_types::make_shared<ChBodyEasyBox>(0.2, 0.04, 0.04, 1000);
+    m_box2->SetPos(builder.GetLastBeamNodes().back()->GetPos() + ChVector<>(0.1, 0, 0));
+    m_system->Add(m_box2);
+
+    auto pos3 = chrono_types::make_shared<ChLinkPointFrame>();
+    pos3->Initialize(builder.GetLastBeamNodes().back(), m_box2);
+    m_system->Add(pos3);
+
+    auto dir3 = chrono_types::make_shared<ChLinkDirFrame>();
+    dir3->Initialize(builder.GetLastBeamNodes().back(), m_box2);
+    dir3->SetDirectionInAbsoluteCoords(ChVector<>(1, 0, 0));
+    m_system->Add(dir3);
+
+    m_system->Add(mesh);
+
+    m_system->SetTimestepperType(ChTimestepper::Type::EULER_IMPLICIT_LINEARIZED);
+    m_system->SetSolverForceTolerance(1e-13);
+}
+
+// -----------------------------------------------------------------------------
+
+class ShellModel {
+  public:
+    ShellModel(int num_elements);
+    std::shared_ptr<ChSystemSMC> GetSystem() const { return m_system; }
+    std::shared_ptr<ChNodeFEAxyzD> GetTipNode() const { return m_tip; }
+
+  private:
+    std::shared_ptr<ChSystemSMC> m_system;
+    std::shared_ptr<ChNodeFEAxyzD> m_tip;
+};
+
+ShellModel::ShellModel(int num_elements) {
+    m_system = chrono_types::make_shared<ChSystemSMC>();
+    m_system->Set_G_acc(ChVector<>(0, -9.8, 0));
+
+    double length = 1;
+    double width = 0.1;
+    double thickness = 0.01;
+
+    ChVector<> E(2.1e7, 2.1e7, 2.1e7);
+    ChVector<> nu(0.3, 0.3, 0.3);
+    ChVector<> G(8.0769231e6, 8.0769231e6, 8.0769231e6);
+    auto mat = chrono_types::make_shared<ChMaterialShellANCF>(500, E, nu, G);
+
+    auto mesh = chrono_types::make_shared<ChMesh>();
+    m_system->Add(mesh);
+
+    double dx = length / num_elements;
+    ChVector<> dir(0, 1, 0);
+
+    auto nodeA = chrono_types::make_shared<ChNodeFEAxyzD>(ChVector<>(0, 0, -width / 2), dir);
+    auto nodeB = chrono_types::make_shared<ChNodeFEAxyzD>(ChVector<>(0, 0, +width / 2), dir);
+    nodeA->SetFixed(true);
+    nodeB->SetFixed(true);
+    mesh->AddNode(nodeA);
+    mesh->AddNode(nodeB);
+
+    for (int i = 1; i <= num_elements; i++) {
+        auto nodeC = chrono_types::make_shared<ChNodeFEAxyzD>(ChVector<>(i * dx, 0, -width / 2), dir);
+        auto nodeD = chrono_types::make_shared<ChNodeFEAxyzD>(ChVector<>(i * dx, 0, +width / 2), dir);
+        mesh->AddNode(nodeC);
+        mesh->AddNode(nodeD);
+
+        auto element = chrono_types::make_shared<ChElementShellANCF>();
+        element->SetNodes(nodeA, nodeB, nodeD, nodeC);
+        element->SetDimensions(dx, width);
+        element->AddLayer(thickness, 0 * CH_C_DEG_TO_RAD, mat);
+        element->SetAlphaDamp(0.0);
+        element->SetGravityOn(false);
+        mesh->AddElement(element);
+
+        nodeA = nodeC;
+        nodeB = nodeD;
+    }
+
+    m_tip = nodeA;
+    m_tip->SetForce(ChVector<>(0, -1, 0));
+}
+
+// -----------------------------------------------------------------------------
+
+static void CompareVectors(const ChVector<>& v1, const ChVector<>& v2, double tol) {
+    ASSERT_NEAR(v1.x(), v2.x(), tol);
+    ASSERT_NEAR(v1.y(), v2.y(), tol);
+    ASSERT_NEAR(v1.z(), v2.z(), tol);
+}
+
+TEST(SparseLDLT, indefinite) {
+    CableModel model1;
+    CableModel model2;
+
+    auto solver = chrono_types::make_shared<ChSolverSparseLDLT>();
+    solver->LockSparsityPattern(true);
+    model1.GetSystem()->SetSolver(solver);
+
+    auto qr_solver = chrono_types::make_shared<ChSolverSparseQR>();
+    qr_solver->LockSparsityPattern(true);
+    model2.GetSystem()->SetSolver(qr_solver);
+
+    const double precision = 1e-6;
+    double timestep = 0.002;
+    int num_steps = 500;
+
+    for (int i = 0; i < num_steps; i++) {
+        model1.GetSystem()->DoStepDynamics(timestep);
+        model2.GetSystem()->DoStepDynamics(timestep);
+
+        CompareVectors(model1.GetBox1()->GetPos(), model2.GetBox1()->GetPos(), precision);
+        CompareVectors(model1.GetBox2()->GetPos(), model2.GetBox2()->GetPos(), precision);
+    }
+
+    // With a locked sparsity pattern, the symbolic analysis is performed only once
+    ASSERT_EQ(solver->GetNumAnalysisCalls(), 1);
+    ASSERT_EQ(qr_solver->GetNumAnalysisCalls(), 1);
+    ASSERT_GE(solver->GetNumSetupCalls(), num_steps);
+}
+
+TEST(SparseLDLT, unlocked) {
+    CableModel model;
+
+    auto solver = chrono_types::make_shared<ChSolverSparseLDLT>();
+    solver->LockSparsityPattern(false);
+    model.GetSystem()->SetSolver(solver);
+
+    for (int i = 0; i < 10; i++)
+        model.GetSystem()->DoStepDynamics(0.002);
+
+    // Without a locked sparsity pattern, the symbolic analysis is performed at each call to Setup
+    ASSERT_EQ(solver->GetNumAnalysisCalls(), solver->GetNumSetupCalls());
+}
+
+TEST(SparseLDLT, posdef) {
+    ShellModel model1(20);
+    ShellModel model2(20);
+
+    auto solver = chrono_types::make_shared<ChSolverSparseLDLT>();
+    solver->SetMatrixSymmetryType(ChDirectSolverLS::MatrixSymmetryType::SYMMETRIC_POSDEF);
+    solver->LockSparsityPattern(true);
+    model1.GetSystem()->SetSolver(solver);
+
+    auto lu_solver = chrono_types::make_shared<ChSolverSparseLU>();
+    lu_solver->LockSparsityPattern(true);
+    model2.GetSystem()->SetSolver(lu_solver);
+
+    for (int i = 0; i < 3; i++) {
+        ASSERT_TRUE(model1.GetSystem()->DoStaticLinear());
+        ASSERT_TRUE(model2.GetSystem()->DoStaticLinear());
+        CompareVectors(model1.GetTipNode()->GetPos(), model2.GetTipNode()->GetPos(), 1e-6);
+    }
+
+    ASSERT_EQ(solver->GetNumAnalysisCalls(), 1);
+    ASSERT_EQ(lu_solver->GetNumAnalysisCalls(), 1);
+}
+
+TEST(SparseLDLT, symmetry_type) {
+    ChSolverSparseLDLT solver;
+    ASSERT_THROW(solver.SetMatrixSymmetryType(ChDirectSolverLS::MatrixSymmetryType::GENERAL), ChException);
+    ASSERT_THROW(solver.SetMatrixSymmetryType(ChDirectSolverLS::MatrixSymmetryType::STRUCTURAL_SYMMETRIC),
+                 ChException);
+    ASSERT_NO_THROW(solver.SetMatrixSymmetryType(ChDirectSolverLS::MatrixSymmetryType::SYMMETRIC_POSDEF));
+    ASSERT_NO_THROW(solver.SetMatrixSymmetryType(ChDirectSolverLS::MatrixSymmetryType::SYMMETRIC_INDEF));
+}
@@ -0,0 +1,148 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Regression test for the force exerted by the fluid on the BCE markers of a
+// rigid body. A fixed sphere is submerged in a tank of fluid at rest and the
+// fluid force on the sphere, averaged once the fluid has settled, is compared
+// with the hydrostatic buoyancy.
+// The same check (and reference value) applies to the GPU and to the CPU
+// (USE_FSI_CPU) backends, so that the two are validated against each other.
+//
+// =============================================================================
+
+#include <cmath>
+
+#include "chrono/core/ChGlobal.h"
+#include "chrono/physics/ChSystemSMC.h"
+#include "chrono/utils/ChUtilsGenerators.h"
+
+#include "chrono_fsi/ChSystemFsi.h"
+#include "chrono_fsi/utils/ChUtilsGeneratorFsi.h"
+#include "chrono_fsi/utils/ChUtilsJSON.h"
+
+#include "chrono_thirdparty/filesystem/path.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+typedef fsi::Real Real;
+
+TEST(ChFsiBce, buoyancy) {
+    // Tank and fluid dimensions, sphere radius
+    Real bxDim = 0.6;
+    Real byDim = 0.6;
+    Real bzDim = 0.8;
+    Real fzDim = 0.6;
+    Real radius = 0.12;
+
+    ChSystemSMC sys;
+    fsi::ChSystemFsi fsi_sys(sys);
+
+    auto paramsH = fsi_sys.GetSimParams();
+    std::string input_json = GetChronoDataFile("fsi/input_json/demo_FSI_CylinderDrop_Explicit.json");
+    ASSERT_TRUE(fsi::utils::ParseJSON(input_json, paramsH, fsi::mR3(bxDim, byDim, bzDim)));
+    fsi_sys.SetFluidDynamics(paramsH->fluid_dynamic_type);
+
+    Real initSpace0 = paramsH->MULT_INITSPACE * paramsH->HSML;
+    paramsH->cMin = fsi::mR3(-bxDim / 2, -byDim / 2, -bzDim / 2) * 2 - 4 * initSpace0;
+    paramsH->cMax = fsi::mR3(bxDim / 2, byDim / 2, bzDim) * 2 + 4 * initSpace0;
+    fsi::utils::FinalizeDomain(paramsH);
+
+    ASSERT_TRUE(filesystem::create_directory(filesystem::path(GetChronoOutputPath())));
+    std::string out_dir = GetChronoOutputPath() + "UTEST_FSI_BCE/";
+    std::string demo_dir;
+    fsi::utils::PrepareOutputDir(paramsH, demo_dir, out_dir, input_json);
+
+    ChVector<> center(0, 0, fzDim / 2);
+    ChVector<> gravity(paramsH->gravity.x, paramsH->gravity.y, paramsH->gravity.z);
+    sys.Set_G_acc(gravity);
+
+    // Fluid markers, leaving out the volume of the sphere
+    utils::GridSampler<> sampler(initSpace0);
+    ChVector<> boxCenter(0, 0, fzDim / 2 + initSpace0);
+    ChVector<> boxHalfDim(bxDim / 2, byDim / 2, fzDim / 2);
+    auto points = sampler.SampleBox(boxCenter, boxHalfDim);
+    int numPart = 0;
+    for (const auto& p : points) {
+        if ((p - center).Length() < radius + initSpace0)
+            continue;
+        fsi_sys.GetDataManager()->AddSphMarker(fsi::mR4(p.x(), p.y(), p.z(), paramsH->HSML), fsi::mR3(1e-10),
+                                               fsi::mR4(paramsH->rho0, paramsH->BASEPRES, paramsH->mu0, -1));
+        numPart++;
+    }
+    fsi_sys.GetDataManager()->fsiGeneralData->referenceArray.push_back(mI4(0, numPart, -1, -1));
+    fsi_sys.GetDataManager()->fsiGeneralData->referenceArray.push_back(mI4(numPart, numPart, 0, 0));
+
+    // Tank walls, represented by boundary BCE markers
+    auto tank = chrono_types::make_shared<ChBody>();
+    tank->SetBodyFixed(true);
+    tank->SetCollide(false);
+    sys.AddBody(tank);
+
+    ChVector<> sizeBottom(bxDim / 2 + 3 * initSpace0, byDim / 2 + 3 * initSpace0, 2 * initSpace0);
+    ChVector<> size_YZ(2 * initSpace0, byDim / 2 + 3 * initSpace0, bzDim / 2);
+    ChVector<> size_XZ(bxDim / 2, 2 * initSpace0, bzDim / 2);
+    ChVector<> posBottom(0, 0, -2 * initSpace0);
+    ChVector<> pos_xp(bxDim / 2 + initSpace0, 0.0, bzDim / 2 + initSpace0);
+    ChVector<> pos_xn(-bxDim / 2 - 3 * initSpace0, 0.0, bzDim / 2 + initSpace0);
+    ChVector<> pos_yp(0, byDim / 2 + initSpace0, bzDim / 2 + initSpace0);
+    ChVector<> pos_yn(0, -byDim / 2 - 3 * initSpace0, bzDim / 2 + initSpace0);
+
+    auto fsiData = fsi_sys.GetDataManager();
+    fsi::utils::AddBoxBce(fsiData, paramsH, tank, posBottom, QUNIT, sizeBottom);
+    fsi::utils::AddBoxBce(fsiData, paramsH, tank, pos_xp, QUNIT, size_YZ, 23);
+    fsi::utils::AddBoxBce(fsiData, paramsH, tank, pos_xn, QUNIT, size_YZ, 23);
+    fsi::utils::AddBoxBce(fsiData, paramsH, tank, pos_yp, QUNIT, size_XZ, 13);
+    fsi::utils::AddBoxBce(fsiData, paramsH, tank, pos_yn, QUNIT, size_XZ, 13);
+
+    // Fixed submerged sphere, represented by rigid BCE markers
+    auto sphere = chrono_types::make_shared<ChBody>();
+    sphere->SetPos(center);
+    sphere->SetBodyFixed(true);
+    sphere->SetCollide(false);
+    sys.AddBody(sphere);
+
+    fsi_sys.AddFsiBody(sphere);
+    fsi::utils::AddSphereBce(fsiData, paramsH, sphere, ChVector<>(0), QUNIT, radius);
+
+    fsi_sys.Finalize();
+    ASSERT_EQ(fsiData->numObjects->numRigidBodies, 1u);
+
+    // Let the fluid settle, then average the fluid force on the sphere
+    double settle_time = 0.2;
+    double average_time = 0.1;
+    ChVector<> force(0);
+    int num_samples = 0;
+    double time = 0;
+    while (time < settle_time + average_time) {
+        fsi_sys.DoStepDynamics_FSI();
+        time += paramsH->dT;
+        if (time > settle_time) {
+            force += sphere->Get_accumulated_force();
+            num_samples++;
+        }
+    }
+    ASSERT_GT(num_samples, 0);
+    force /= num_samples;
+
+    // Buoyancy of the volume represented by the BCE markers of the sphere
+    double buoyancy = paramsH->rho0 * gravity.Length() * (4.0 / 3.0) * CH_C_PI * std::pow(radius, 3);
+    std::cout << "Fluid force on sphere: " << force << "  buoyancy: " << buoyancy << std::endl;
+
+    ASSERT_TRUE(std::isfinite(force.z()));
+    ASSERT_NEAR(force.z(), buoyancy, 0.3 * buoyancy);
+    ASSERT_LT(std::abs(force.x()), 0.1 * buoyancy);
+    ASSERT_LT(std::abs(force.y()), 0.1 * buoyancy);
+}
@@ -0,0 +1,142 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+// Comparison of the CPU (OpenMP) and GPU execution backends of the sphere-only
+// solver. Both backends run the same physics but sum contact forces in a
+// different order, so results are compared up to a tolerance:
+// - after a short run, every sphere position agrees within a fraction of the radius
+// - after settling, the bed height and the reaction force on the bottom plane agree
+// The CPU backend is deterministic, so CPU runs with different numbers of threads
+// must give bitwise identical positions and reaction forces.
+// =============================================================================
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "chrono_granular/api/ChApiGranularChrono.h"
+#include "chrono_granular/physics/ChGranular.h"
+#include "chrono/parallel/ChOpenMP.h"
+#include "chrono/utils/ChUtilsSamplers.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::granular;
+
+const float sphereRadius = 1.f;
+const float sphereDensity = 2.50f;
+const float grav_acceleration = -980.f;
+const float timestep = 5e-5f;
+const float box_size = 30.f;
+
+struct BackendResult {
+    std::vector<float> positions;  // x, y, z of each sphere, in sphere ID order
+    double max_z;
+    float plane_force;
+};
+
+BackendResult run_backend(GRAN_EXECUTION_BACKEND backend, float end_time, const std::string& out_name) {
+    ChSystemGranularSMC gran_system(sphereRadius, sphereDensity, make_float3(box_size, box_size, box_size), backend);
+    gran_system.set_K_n_SPH2SPH(5e7f);
+    gran_system.set_K_n_SPH2WALL(5e7f);
+    gran_system.set_Gamma_n_SPH2SPH(20000.f);
+    gran_system.set_Gamma_n_SPH2WALL(20000.f);
+    gran_system.set_K_t_SPH2SPH(2e7f);
+    gran_system.set_K_t_SPH2WALL(2e7f);
+    gran_system.set_Gamma_t_SPH2SPH(10000.f);
+    gran_system.set_Gamma_t_SPH2WALL(10000.f);
+    gran_system.set_static_friction_coeff_SPH2SPH(0.5f);
+    gran_system.set_static_friction_coeff_SPH2WALL(0.5f);
+    gran_system.set_Cohesion_ratio(0.f);
+    gran_system.set_Adhesion_ratio_S2W(0.f);
+    gran_system.set_gravitational_acceleration(0.f, 0.f, grav_acceleration);
+
+    // Only positions are written, as raw floats
+    gran_system.setOutputMode(GRAN_OUTPUT_MODE::BINARY);
+    gran_system.setOutputFlags(0);
+    gran_system.setVerbose(GRAN_VERBOSITY::QUIET);
+
+    // Loose HCP packing in the bottom half of the box, so that the spheres fall and collide
+    chrono::utils::HCPSampler<float> sampler(2.2f * sphereRadius);
+    ChVector<float> center(0.f, 0.f, -0.25f * box_size);
+    ChVector<float> hdims(box_size / 2.f - sphereRadius, box_size / 2.f - sphereRadius, box_size / 4.f - sphereRadius);
+    std::vector<ChVector<float>> body_points = sampler.SampleBox(center, hdims);
+
+    ChGranularSMC_API apiSMC;
+    apiSMC.setGranSystem(&gran_system);
+    apiSMC.setElemsPositions(body_points);
+
+    gran_system.set_BD_Fixed(true);
+    gran_system.set_friction_mode(GRAN_FRICTION_MODE::MULTI_STEP);
+    gran_system.set_timeIntegrator(GRAN_TIME_INTEGRATOR::CENTERED_DIFFERENCE);
+
+    float plane_normal[3] = {0, 0, 1};
+    float plane_center[3] = {0, 0, -box_size / 2 + 2 * sphereRadius};
+    size_t plane_bc_id = gran_system.Create_BC_Plane(plane_center, plane_normal, true);
+
+    gran_system.set_fixed_stepSize(timestep);
+    gran_system.initialize();
+
+    gran_system.advance_simulation(end_time);
+
+    BackendResult result;
+    result.max_z = gran_system.get_max_z();
+
+    float reaction_forces[3] = {0, 0, 0};
+    gran_system.getBCReactionForces(plane_bc_id, reaction_forces);
+    result.plane_force = reaction_forces[2];
+
+    gran_system.writeFile(out_name);
+    std::ifstream ptFile(out_name + ".raw", std::ios::in | std::ios::binary);
+    result.positions.resize(3 * gran_system.getNumSpheres());
+    ptFile.read((char*)result.positions.data(), result.positions.size() * sizeof(float));
+    EXPECT_TRUE((bool)ptFile) << "Cannot read back " << out_name << ".raw";
+
+    return result;
+}
+
+// CPU runs with one and several threads must give identical results.
+TEST(GranularBackend, cpu_threads) {
+    CHOMPfunctions::SetNumThreads(1);
+    BackendResult serial = run_backend(GRAN_EXECUTION_BACKEND::CPU, 0.02f, "gran_cpu_serial");
+    CHOMPfunctions::SetNumThreads(4);
+    BackendResult threaded = run_backend(GRAN_EXECUTION_BACKEND::CPU, 0.02f, "gran_cpu_threaded");
+
+    ASSERT_FALSE(serial.positions.empty());
+    ASSERT_EQ(serial.positions, threaded.positions);
+    ASSERT_EQ(serial.plane_force, threaded.plane_force);
+}
+
+// Short run: positions must agree sphere by sphere.
+TEST(GranularBackend, short_run) {
+    BackendResult gpu = run_backend(GRAN_EXECUTION_BACKEND::GPU, 0.02f, "gran_gpu_short");
+    BackendResult cpu = run_backend(GRAN_EXECUTION_BACKEND::CPU, 0.02f, "gran_cpu_short");
+
+    ASSERT_FALSE(gpu.positions.empty());
+    ASSERT_EQ(gpu.positions.size(), cpu.positions.size());
+
+    for (size_t i = 0; i < gpu.positions.size(); i++)
+        ASSERT_NEAR(cpu.positions[i], gpu.positions[i], 1e-2f * sphereRadius) << "sphere " << i / 3;
+}
+
+// Settled bed: individual trajectories may diverge, but the aggregate state must agree.
+TEST(GranularBackend, settled) {
+    BackendResult gpu = run_backend(GRAN_EXECUTION_BACKEND::GPU, 0.5f, "gran_gpu_settled");
+    BackendResult cpu = run_backend(GRAN_EXECUTION_BACKEND::CPU, 0.5f, "gran_cpu_settled");
+
+    ASSERT_NEAR(cpu.plane_force, gpu.plane_force, 0.01f * std::abs(gpu.plane_force));
+    ASSERT_NEAR(cpu.max_z, gpu.max_z, sphereRadius);
+}
@@ -0,0 +1,134 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// ChronoParallel unit test comparing the potential contact pairs found by the
+// hierarchical grid broadphase with those found by the uniform grid broadphase
+// and by a brute-force test of all AABB pairs, on a polydisperse set of spheres
+// (radii spanning two orders of magnitude) in a container.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "chrono/core/ChMathematics.h"
+#include "chrono/utils/ChUtilsCreators.h"
+
+#include "chrono_parallel/physics/ChSystemParallel.h"
+#include "chrono_parallel/collision/ChCollision.h"
+
+#include "unit_testing.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+typedef std::vector<std::pair<int, int>> PairList;
+
+// Run the broadphase with the specified algorithm and return the sorted list of shape pairs.
+static PairList Broadphase(ChParallelDataManager* data_manager, BroadphaseType type) {
+    data_manager->settings.collision.broadphase_algorithm = type;
+    data_manager->aabb_generator->GenerateAABB();
+    data_manager->broadphase->DetermineBoundingBox();
+    data_manager->broadphase->OffsetAABB();
+    data_manager->broadphase->ComputeTopLevelResolution();
+    data_manager->broadphase->DispatchRigid();
+
+    PairList pairs;
+    for (uint i = 0; i < data_manager->num_rigid_contacts; i++) {
+        long long p = data_manager->host_data.contact_pairs[i];
+        int a = int(p >> 32);
+        int b = int(p & 0xffffffff);
+        pairs.push_back(std::make_pair(std::min(a, b), std::max(a, b)));
+    }
+    std::sort(pairs.begin(), pairs.end());
+    return pairs;
+}
+
+// Return the sorted list of all pairs of shapes on different bodies with overlapping AABBs.
+// All shapes are in the default collision family and the only fixed body is the container.
+static PairList BruteForce(ChParallelDataManager* data_manager) {
+    const auto& aabb_min = data_manager->host_data.aabb_min;
+    const auto& aabb_max = data_manager->host_data.aabb_max;
+    const auto& id = data_manager->shape_data.id_rigid;
+    const auto& active = data_manager->host_data.active_rigid;
+
+    PairList pairs;
+    int num_shapes = (int)data_manager->num_rigid_shapes;
+    for (int a = 0; a < num_shapes; a++) {
+        for (int b = a + 1; b < num_shapes; b++) {
+            if (id[a] == id[b] || (!active[id[a]] && !active[id[b]]))
+                continue;
+            if (aabb_min[a].x <= aabb_max[b].x && aabb_min[b].x <= aabb_max[a].x && aabb_min[a].y <= aabb_max[b].y &&
+                aabb_min[b].y <= aabb_max[a].y && aabb_min[a].z <= aabb_max[b].z && aabb_min[b].z <= aabb_max[a].z)
+                pairs.push_back(std::make_pair(a, b));
+        }
+    }
+    return pairs;
+}
+
+TEST(ChronoParallel, broadphase_polydisperse) {
+    ChSystemParallelNSC system;
+    system.Set_G_acc(ChVector<>(0, 0, -9.81));
+    system.GetSettings()->collision.collision_envelope = 0.001;
+    system.GetSettings()->collision.bins_per_axis = vec3(10, 10, 10);
+
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+
+    // Container (fixed, with several shapes)
+    double hdim = 1;
+    auto bin = std::shared_ptr<ChBody>(system.NewBody());
+    bin->SetBodyFixed(true);
+    bin->SetCollide(true);
+    bin->GetCollisionModel()->ClearModel();
+    utils::AddBoxGeometry(bin.get(), mat, ChVector<>(hdim, hdim, 0.05), ChVector<>(0, 0, -0.05));
+    utils::AddBoxGeometry(bin.get(), mat, ChVector<>(0.05, hdim, hdim), ChVector<>(-hdim - 0.05, 0, hdim));
+    utils::AddBoxGeometry(bin.get(), mat, ChVector<>(0.05, hdim, hdim), ChVector<>(hdim + 0.05, 0, hdim));
+    utils::AddBoxGeometry(bin.get(), mat, ChVector<>(hdim, 0.05, hdim), ChVector<>(0, -hdim - 0.05, hdim));
+    utils::AddBoxGeometry(bin.get(), mat, ChVector<>(hdim, 0.05, hdim), ChVector<>(0, hdim + 0.05, hdim));
+    bin->GetCollisionModel()->BuildModel();
+    system.AddBody(bin);
+
+    // Densely packed small spheres, with a few spheres up to 100 times larger, at random positions
+    ChSetRandomSeed(17);
+    for (int i = 0; i < 3000; i++) {
+        double radius = (i % 100 == 0) ? 0.1 + 0.4 * ChRandom() : 0.005 + 0.02 * ChRandom();
+        ChVector<> pos(hdim * (2 * ChRandom() - 1), hdim * (2 * ChRandom() - 1), 2 * hdim * ChRandom());
+        auto ball = std::shared_ptr<ChBody>(system.NewBody());
+        ball->SetMass(1);
+        ball->SetPos(pos);
+        ball->SetCollide(true);
+        ball->GetCollisionModel()->ClearModel();
+        utils::AddSphereGeometry(ball.get(), mat, radius);
+        ball->GetCollisionModel()->BuildModel();
+        system.AddBody(ball);
+    }
+
+    // Take one step to load the data manager
+    system.DoStepDynamics(1e-4);
+    auto data_manager = system.data_manager;
+
+    PairList pairs_one_level = Broadphase(data_manager, BroadphaseType::BROADPHASE_ONE_LEVEL);
+    PairList pairs_hierarchical = Broadphase(data_manager, BroadphaseType::BROADPHASE_HIERARCHICAL);
+    PairList pairs_brute_force = BruteForce(data_manager);
+
+    ASSERT_GT(data_manager->measures.collision.number_of_grid_levels, 1u);
+    ASSERT_GT(pairs_brute_force.size(), 0u);
+
+    // Each pair must be reported exactly once
+    ASSERT_TRUE(std::adjacent_find(pairs_hierarchical.begin(), pairs_hierarchical.end()) == pairs_hierarchical.end());
+
+    ASSERT_EQ(pairs_hierarchical, pairs_brute_force);
+    ASSERT_EQ(pairs_one_level, pairs_brute_force);
+}
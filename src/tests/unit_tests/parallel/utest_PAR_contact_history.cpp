@@ -0,0 +1,375 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// ChronoParallel unit test for the contact history of the SMC solver
+// (MultiStep tangential displacement mode).
+// - The hash table storage (BuildContactHistoryTable / FindContactHistory) is
+//   compared with the previous storage (a fixed number of history slots per
+//   body, searched linearly) on random sequences of contacts.
+// - The shear history of a box resting on a tilted ground must persist across
+//   steps, keeping the box from sliding.
+// - A capsule landing on a box (two contacts between the same two shapes)
+//   must keep a separate history for each contact.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <vector>
+
+#include "chrono/core/ChMathematics.h"
+#include "chrono/utils/ChUtilsCreators.h"
+
+#include "chrono_parallel/physics/ChSystemParallel.h"
+#include "chrono_parallel/solver/ChContactHistorySMC.h"
+
+#include "unit_testing.h"
+
+using namespace chrono;
+
+// Contact between two shapes on two bodies
+struct Contact {
+    int b1, b2;  // body IDs
+    int s1, s2;  // global shape IDs
+    real3 pt;    // contact point
+};
+
+// Previous storage: a fixed number of history slots per body (on the body with larger index), searched linearly.
+// Slots not touched at a step are released.
+class SlotHistory {
+  public:
+    static const int max_shear = 20;
+
+    explicit SlotHistory(int num_bodies) : neigh(max_shear * num_bodies, vec3(-1, -1, -1)), value(neigh.size(), 0) {}
+
+    // Process the contacts of one step. Return, for each contact, the number of steps it has been in contact
+    // (1 for a new contact), or 0 if there was no free history slot.
+    std::vector<int> Step(const std::vector<Contact>& contacts) {
+        std::vector<char> touch(neigh.size(), 0);
+        std::vector<int> result;
+        for (const auto& c : contacts) {
+            int body1 = std::max(c.b1, c.b2);
+            vec3 id(std::min(c.b1, c.b2), std::max(c.s1, c.s2), std::min(c.s1, c.s2));
+            int slot = -1;
+            for (int i = 0; i < max_shear && slot < 0; i++) {
+                vec3& n = neigh[max_shear * body1 + i];
+                if (n.x == id.x && n.y == id.y && n.z == id.z) {
+                    slot = max_shear * body1 + i;
+                    value[slot]++;
+                }
+            }
+            for (int i = 0; i < max_shear && slot < 0; i++) {
+                if (neigh[max_shear * body1 + i].x == -1) {
+                    slot = max_shear * body1 + i;
+                    neigh[slot] = id;
+                    value[slot] = 1;
+                }
+            }
+            if (slot >= 0)
+                touch[slot] = 1;
+            result.push_back(slot >= 0 ? value[slot] : 0);
+        }
+        for (size_t i = 0; i < neigh.size(); i++) {
+            if (!touch[i])
+                neigh[i].x = -1;
+        }
+        return result;
+    }
+
+  private:
+    std::vector<vec3> neigh;
+    std::vector<int> value;
+};
+
+// Current storage: per-contact history, located through the hash table of the previous step.
+class TableHistory {
+  public:
+    std::vector<int> Step(const std::vector<Contact>& contacts) {
+        custom_vector<long long> new_keys(contacts.size());
+        custom_vector<real3> new_points(contacts.size());
+        std::vector<int> new_value(contacts.size());
+        for (size_t i = 0; i < contacts.size(); i++) {
+            long long key = ContactHistoryKey(contacts[i].s1, contacts[i].s2);
+            int prev = FindContactHistory(key, contacts[i].pt, table.data(), (unsigned int)table.size(),
+                                          keys.data(), points.data());
+            new_keys[i] = key;
+            new_points[i] = contacts[i].pt;
+            new_value[i] = (prev >= 0) ? value[prev] + 1 : 1;
+        }
+        keys.swap(new_keys);
+        points.swap(new_points);
+        value.swap(new_value);
+        BuildContactHistoryTable(keys, table);
+        return value;
+    }
+
+  private:
+    custom_vector<long long> keys;
+    custom_vector<real3> points;
+    custom_vector<int> table;
+    std::vector<int> value;
+};
+
+// Random contacts between num_bodies bodies, each with shapes_per_body shapes. Each contact of the previous step
+// persists with the given probability, and new contacts are added up to the specified number.
+static void RandomContacts(std::vector<Contact>& contacts,
+                           int num_contacts,
+                           int num_bodies,
+                           int shapes_per_body,
+                           double persistence) {
+    std::vector<Contact> next;
+    for (const auto& c : contacts) {
+        if (ChRandom() < persistence)
+            next.push_back(c);
+    }
+    while ((int)next.size() < num_contacts) {
+        Contact c;
+        c.pt = real3(0);
+        c.b1 = (int)(ChRandom() * num_bodies) % num_bodies;
+        c.b2 = (int)(ChRandom() * num_bodies) % num_bodies;
+        if (c.b1 == c.b2)
+            continue;
+        c.s1 = c.b1 * shapes_per_body + (int)(ChRandom() * shapes_per_body) % shapes_per_body;
+        c.s2 = c.b2 * shapes_per_body + (int)(ChRandom() * shapes_per_body) % shapes_per_body;
+        bool duplicate = false;
+        for (const auto& d : next)
+            duplicate |= ContactHistoryKey(d.s1, d.s2) == ContactHistoryKey(c.s1, c.s2);
+        if (!duplicate)
+            next.push_back(c);
+    }
+    contacts.swap(next);
+}
+
+TEST(ChronoParallel, contact_history_storage) {
+    ChSetRandomSeed(3);
+
+    // Few contacts per body: both storages must find the same history
+    int num_bodies = 200;
+    SlotHistory slots(num_bodies);
+    TableHistory table;
+    std::vector<Contact> contacts;
+    int max_steps = 0;
+    for (int step = 0; step < 50; step++) {
+        RandomContacts(contacts, 300, num_bodies, 3, 0.9);
+        auto res_slots = slots.Step(contacts);
+        auto res_table = table.Step(contacts);
+        ASSERT_EQ(res_slots, res_table);
+        for (auto n : res_table)
+            max_steps = std::max(max_steps, n);
+    }
+    ASSERT_GT(max_steps, 10);
+
+    // More contacts per body than history slots: the hash table must keep the history of all contacts
+    SlotHistory slots_dense(4);
+    TableHistory table_dense;
+    std::vector<Contact> dense;
+    for (int i = 0; i < 3 * SlotHistory::max_shear; i++)
+        dense.push_back({0, 1, 100 + i, 1000 + i, real3(0)});
+    for (int step = 1; step <= 5; step++) {
+        auto res_slots = slots_dense.Step(dense);
+        auto res_table = table_dense.Step(dense);
+        for (size_t i = 0; i < dense.size(); i++) {
+            ASSERT_EQ(res_table[i], step);
+            ASSERT_EQ(res_slots[i], (i < SlotHistory::max_shear) ? step : 0);
+        }
+    }
+
+    // Several contacts between the same two shapes, listed in a different order at each step: the history of each
+    // contact must be located by its contact point
+    TableHistory table_multi;
+    std::vector<Contact> multi;
+    for (int i = 0; i < 4; i++)
+        multi.push_back({0, 1, 10, 20, real3(0.1 * i, 0, 0)});
+    for (int step = 1; step <= 5; step++) {
+        std::reverse(multi.begin(), multi.end());
+        auto res_table = table_multi.Step(multi);
+        for (size_t i = 0; i < multi.size(); i++)
+            ASSERT_EQ(res_table[i], step);
+    }
+}
+
+// Copy of the contact history of one step, searched linearly.
+struct HistoryCopy {
+    std::vector<long long> keys;
+    std::vector<real3> points;
+    std::vector<real> duration;
+
+    void Copy(const host_container& host_data) {
+        keys.assign(host_data.shear_keys.begin(), host_data.shear_keys.end());
+        points.assign(host_data.shear_points.begin(), host_data.shear_points.end());
+        duration.assign(host_data.contact_duration.begin(), host_data.contact_duration.end());
+    }
+
+    // Index of the contact with given key nearest to the given point, -1 if none.
+    int Find(long long key, const real3& pt) const {
+        int nearest = -1;
+        for (int i = 0; i < (int)keys.size(); i++) {
+            if (keys[i] == key && (nearest == -1 || Length2(points[i] - pt) < Length2(points[nearest] - pt)))
+                nearest = i;
+        }
+        return nearest;
+    }
+};
+
+TEST(ChronoParallel, contact_history_persistence) {
+    // Ground tilted by 15 degrees (as tilted gravity), below the friction angle
+    double angle = 15 * CH_C_DEG_TO_RAD;
+    double step_size = 1e-4;
+
+    ChSystemParallelSMC system;
+    system.Set_G_acc(ChVector<>(9.81 * std::sin(angle), 0, -9.81 * std::cos(angle)));
+    system.GetSettings()->solver.contact_force_model = ChSystemSMC::Hooke;
+    system.GetSettings()->solver.tangential_displ_mode = ChSystemSMC::MultiStep;
+    system.GetSettings()->solver.use_material_properties = false;
+    system.GetSettings()->collision.narrowphase_algorithm = NarrowPhaseType::NARROWPHASE_HYBRID_MPR;
+    system.GetSettings()->collision.bins_per_axis = vec3(5, 5, 5);
+    CHOMPfunctions::SetNumThreads(1);
+    system.GetSettings()->max_threads = 1;
+
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceSMC>();
+    mat->SetFriction(0.6f);
+    mat->SetRestitution(0);
+    mat->SetKn(2e5f);
+    mat->SetGn(4e2f);
+    mat->SetKt(2e5f);
+    mat->SetGt(4e2f);
+
+    auto ground = std::shared_ptr<ChBody>(system.NewBody());
+    ground->SetBodyFixed(true);
+    ground->SetCollide(true);
+    ground->GetCollisionModel()->ClearModel();
+    utils::AddBoxGeometry(ground.get(), mat, ChVector<>(1, 1, 0.1), ChVector<>(0, 0, -0.1));
+    ground->GetCollisionModel()->BuildModel();
+    system.AddBody(ground);
+
+    auto box = std::shared_ptr<ChBody>(system.NewBody());
+    box->SetMass(1);
+    box->SetInertiaXX(ChVector<>(0.01, 0.01, 0.01));
+    box->SetPos(ChVector<>(0, 0, 0.1));
+    box->SetCollide(true);
+    box->GetCollisionModel()->ClearModel();
+    utils::AddBoxGeometry(box.get(), mat, ChVector<>(0.1, 0.1, 0.1));
+    box->GetCollisionModel()->BuildModel();
+    system.AddBody(box);
+
+    // Let the box settle
+    for (int i = 0; i < 2000; i++)
+        system.DoStepDynamics(step_size);
+
+    const auto& host_data = system.data_manager->host_data;
+    ASSERT_GT(system.data_manager->num_rigid_contacts, 0u);
+
+    // At each step, the history of each contact must be carried over from the previous step
+    HistoryCopy prev;
+    double x0 = box->GetPos().x();
+    for (int i = 0; i < 500; i++) {
+        system.DoStepDynamics(step_size);
+        ASSERT_EQ(host_data.shear_keys.size(), system.data_manager->num_rigid_contacts);
+
+        for (size_t k = 0; k < host_data.shear_keys.size(); k++) {
+            ASSERT_GE(host_data.shear_keys[k], 0);
+            ASSERT_GT(Length(host_data.shear_disp[k]), 0);
+            if (i > 0) {
+                int p = prev.Find(host_data.shear_keys[k], host_data.shear_points[k]);
+                ASSERT_GE(p, 0);
+                ASSERT_NEAR(host_data.contact_duration[k], prev.duration[p] + step_size, 1e-10);
+            }
+        }
+        prev.Copy(host_data);
+    }
+
+    // With persistent shear history, the box sticks to the tilted ground
+    ASSERT_NEAR(box->GetPos().x(), x0, 1e-4);
+}
+
+TEST(ChronoParallel, contact_history_multipoint) {
+    double step_size = 1e-4;
+
+    ChSystemParallelSMC system;
+    system.Set_G_acc(ChVector<>(0, 0, -9.81));
+    system.GetSettings()->solver.contact_force_model = ChSystemSMC::Hooke;
+    system.GetSettings()->solver.tangential_displ_mode = ChSystemSMC::MultiStep;
+    system.GetSettings()->solver.use_material_properties = false;
+    system.GetSettings()->collision.narrowphase_algorithm = NarrowPhaseType::NARROWPHASE_R;
+    system.GetSettings()->collision.bins_per_axis = vec3(5, 5, 5);
+    CHOMPfunctions::SetNumThreads(1);
+    system.GetSettings()->max_threads = 1;
+
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceSMC>();
+    mat->SetFriction(0.6f);
+    mat->SetRestitution(0);
+    mat->SetKn(2e5f);
+    mat->SetGn(4e2f);
+    mat->SetKt(2e5f);
+    mat->SetGt(4e2f);
+
+    auto ground = std::shared_ptr<ChBody>(system.NewBody());
+    ground->SetBodyFixed(true);
+    ground->SetCollide(true);
+    ground->GetCollisionModel()->ClearModel();
+    utils::AddBoxGeometry(ground.get(), mat, ChVector<>(1, 1, 0.1), ChVector<>(0, 0, -0.1));
+    ground->GetCollisionModel()->BuildModel();
+    system.AddBody(ground);
+
+    // Capsule (axis along y) tilted about the x axis: it touches the ground with one end first and then lands flat,
+    // resting on the box with two contacts between the same two shapes.
+    // (The R narrowphase generates up to 2 contacts for a box-capsule pair; box-box contacts are single-point.)
+    double radius = 0.05;
+    double hlen = 0.2;
+    double angle = 0.1;
+    auto capsule = std::shared_ptr<ChBody>(system.NewBody());
+    capsule->SetMass(1);
+    capsule->SetInertiaXX(ChVector<>(0.015, 0.001, 0.015));
+    capsule->SetPos(ChVector<>(0, 0, radius + hlen * std::sin(angle)));
+    capsule->SetRot(Q_from_AngX(angle));
+    capsule->SetCollide(true);
+    capsule->GetCollisionModel()->ClearModel();
+    utils::AddCapsuleGeometry(capsule.get(), mat, radius, hlen);
+    capsule->GetCollisionModel()->BuildModel();
+    system.AddBody(capsule);
+
+    const auto& host_data = system.data_manager->host_data;
+
+    // At each step, a contact near a contact of the previous step must continue the history of that contact (each
+    // previous contact being continued at most once), while any other contact must start a new history.
+    HistoryCopy prev;
+    size_t max_contacts = 0;
+    for (int i = 0; i < 3000; i++) {
+        system.DoStepDynamics(step_size);
+        ASSERT_EQ(host_data.shear_keys.size(), system.data_manager->num_rigid_contacts);
+
+        std::vector<int> matched;
+        size_t num_contacts = 0;
+        for (size_t k = 0; k < host_data.shear_keys.size(); k++) {
+            if (host_data.shear_keys[k] < 0)
+                continue;
+            num_contacts++;
+            int p = prev.Find(host_data.shear_keys[k], host_data.shear_points[k]);
+            if (p >= 0 && Length(host_data.shear_points[k] - prev.points[p]) < 0.01) {
+                ASSERT_NEAR(host_data.contact_duration[k], prev.duration[p] + step_size, 1e-10);
+                ASSERT_TRUE(std::find(matched.begin(), matched.end(), p) == matched.end());
+                matched.push_back(p);
+            } else {
+                ASSERT_EQ(host_data.contact_duration[k], 0);
+            }
+        }
+        max_contacts = std::max(max_contacts, num_contacts);
+        prev.Copy(host_data);
+    }
+
+    // The capsule rests on the ground with both ends, the first end having been in contact longer
+    ASSERT_EQ(max_contacts, 2u);
+    ASSERT_EQ(prev.keys.size(), 2u);
+    ASSERT_EQ(prev.keys[0], prev.keys[1]);
+    ASSERT_GT(std::abs(prev.duration[0] - prev.duration[1]), 10 * step_size);
+}
@@ -0,0 +1,144 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// ChronoParallel unit test for the mixed-precision NSC solver.
+// A small pile of spheres settles in a container with the APGD solver, using
+// double precision and single precision (ChShurProductSingle) Shur products.
+// The difference between the two Shur products, and between the resulting
+// body positions and contact forces, must remain within single precision
+// bounds.
+//
+// =============================================================================
+
+#include <cmath>
+
+#include "chrono/utils/ChUtilsCreators.h"
+
+#include "chrono_parallel/physics/ChSystemParallel.h"
+#include "chrono_parallel/solver/ChSolverParallel.h"
+
+#include "unit_testing.h"
+
+using namespace chrono;
+
+static const double radius = 0.05;
+
+// Create a container with a 3x3x3 lattice of spheres, with the specified precision of the Shur products.
+static ChSystemParallelNSC* CreateSystem(bool mixed_precision, std::shared_ptr<ChBody>& container) {
+    auto system = new ChSystemParallelNSC();
+    system->Set_G_acc(ChVector<>(0, 0, -9.81));
+    system->GetSettings()->solver.solver_mode = SolverMode::SLIDING;
+    system->GetSettings()->solver.max_iteration_normal = 0;
+    system->GetSettings()->solver.max_iteration_sliding = 100;
+    system->GetSettings()->solver.max_iteration_spinning = 0;
+    system->GetSettings()->solver.max_iteration_bilateral = 0;
+    system->GetSettings()->solver.tolerance = 1e-6;
+    system->GetSettings()->solver.alpha = 0;
+    system->GetSettings()->solver.contact_recovery_speed = 1;
+    system->GetSettings()->solver.use_mixed_precision = mixed_precision;
+    system->GetSettings()->solver.max_iteration_refinement = 0;
+    system->ChangeSolverType(SolverType::APGD);
+    system->GetSettings()->collision.collision_envelope = 0.05 * radius;
+    system->GetSettings()->collision.bins_per_axis = vec3(5, 5, 5);
+    CHOMPfunctions::SetNumThreads(1);
+    system->GetSettings()->max_threads = 1;
+
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+    mat->SetFriction(0.4f);
+
+    double hdim = 2 * radius * 3;
+    container = std::shared_ptr<ChBody>(system->NewBody());
+    container->SetBodyFixed(true);
+    container->SetCollide(true);
+    container->GetCollisionModel()->ClearModel();
+    utils::AddBoxGeometry(container.get(), mat, ChVector<>(hdim, hdim, 0.05), ChVector<>(0, 0, -0.05));
+    utils::AddBoxGeometry(container.get(), mat, ChVector<>(0.05, hdim, hdim), ChVector<>(-hdim - 0.05, 0, hdim));
+    utils::AddBoxGeometry(container.get(), mat, ChVector<>(0.05, hdim, hdim), ChVector<>(hdim + 0.05, 0, hdim));
+    utils::AddBoxGeometry(container.get(), mat, ChVector<>(hdim, 0.05, hdim), ChVector<>(0, -hdim - 0.05, hdim));
+    utils::AddBoxGeometry(container.get(), mat, ChVector<>(hdim, 0.05, hdim), ChVector<>(0, hdim + 0.05, hdim));
+    container->GetCollisionModel()->BuildModel();
+    system->AddBody(container);
+
+    double mass = 1000 * (4.0 / 3.0) * CH_C_PI * std::pow(radius, 3);
+    for (int ix = -1; ix <= 1; ix++) {
+        for (int iy = -1; iy <= 1; iy++) {
+            for (int iz = 0; iz < 3; iz++) {
+                auto ball = std::shared_ptr<ChBody>(system->NewBody());
+                ball->SetMass(mass);
+                ball->SetInertiaXX(0.4 * mass * radius * radius * ChVector<>(1, 1, 1));
+                ball->SetPos(ChVector<>(2.01 * radius * ix, 2.01 * radius * iy, radius + 2.01 * radius * iz));
+                ball->SetCollide(true);
+                ball->GetCollisionModel()->ClearModel();
+                utils::AddSphereGeometry(ball.get(), mat, radius);
+                ball->GetCollisionModel()->BuildModel();
+                system->AddBody(ball);
+            }
+        }
+    }
+
+    return system;
+}
+
+TEST(ChronoParallel, mixed_precision) {
+    std::shared_ptr<ChBody> container_d;
+    std::shared_ptr<ChBody> container_s;
+    ChSystemParallelNSC* system_d = CreateSystem(false, container_d);
+    ChSystemParallelNSC* system_s = CreateSystem(true, container_s);
+
+    double step_size = 1e-3;
+    for (int i = 0; i < 200; i++) {
+        system_d->DoStepDynamics(step_size);
+        system_s->DoStepDynamics(step_size);
+    }
+
+    // Shur products with the matrices of the last step
+    ASSERT_GT(system_s->data_manager->num_constraints, 0u);
+    ChShurProduct shur_d;
+    ChShurProductSingle shur_s;
+    shur_d.Setup(system_s->data_manager);
+    shur_s.Setup(system_s->data_manager);
+
+    DynamicVector<real> x(system_s->data_manager->num_constraints);
+    for (size_t i = 0; i < x.size(); i++)
+        x[i] = std::sin(0.1 * i) + 0.5;
+    DynamicVector<real> AX_d(x.size());
+    DynamicVector<real> AX_s(x.size());
+    shur_d(x, AX_d);
+    shur_s(x, AX_s);
+    DynamicVector<real> diff = AX_d - AX_s;
+    real norm_d = Sqrt((real)(AX_d, AX_d));
+    real norm_diff = Sqrt((real)(diff, diff));
+    ASSERT_GT(norm_d, 0);
+    ASSERT_LE(norm_diff, 1e-5 * norm_d);
+
+    // Body positions, relative to the sphere radius
+    auto& bodies_d = system_d->Get_bodylist();
+    auto& bodies_s = system_s->Get_bodylist();
+    ASSERT_EQ(bodies_d.size(), bodies_s.size());
+    for (size_t i = 0; i < bodies_d.size(); i++) {
+        ASSERT_LE((bodies_d[i]->GetPos() - bodies_s[i]->GetPos()).Length(), 1e-3 * radius);
+    }
+
+    // Contact force on the container, relative to the weight of the spheres
+    system_d->CalculateContactForces();
+    system_s->CalculateContactForces();
+    real3 force_d = system_d->GetBodyContactForce(container_d);
+    real3 force_s = system_s->GetBodyContactForce(container_s);
+    double weight = 27 * bodies_d[1]->GetMass() * 9.81;
+    ASSERT_NEAR(force_d.z, weight, 0.05 * weight);
+    ASSERT_LE(Length(force_d - force_s), 1e-2 * weight);
+
+    delete system_d;
+    delete system_s;
+}
@@ -0,0 +1,107 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Unit test for the multi-threaded per-item loops in ChAssembly.
+// A set of pendulum chains (bodies connected by revolute joints, one of them
+// driven by a rotational motor) is simulated with one and with several threads
+// (see ChSystem::SetNumThreads). The final states must be bit-identical.
+//
+// =============================================================================
+
+#include <memory>
+#include <vector>
+
+#include "chrono/motion_functions/ChFunction_Sine.h"
+#include "chrono/physics/ChBody.h"
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChLinkMotorRotationSpeed.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+struct BodyState {
+    ChVector<> pos;
+    ChQuaternion<> rot;
+    ChVector<> vel;
+    ChVector<> wvel;
+};
+
+static std::vector<BodyState> RunChains(int num_threads) {
+    const int num_chains = 8;
+    const int num_links = 6;
+
+    ChSystemNSC system;
+    system.SetNumThreads(num_threads);
+    system.Set_G_acc(ChVector<>(0, -9.81, 0));
+    system.SetTimestepperType(ChTimestepper::Type::EULER_IMPLICIT_LINEARIZED);
+    system.SetSolverType(ChSolver::Type::PSOR);
+    system.SetSolverMaxIterations(50);
+
+    auto ground = chrono_types::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    system.AddBody(ground);
+
+    // The first link of each chain is driven, all with the same speed function
+    auto speed = chrono_types::make_shared<ChFunction_Sine>(0, 0.5, 2.0);
+
+    for (int ic = 0; ic < num_chains; ic++) {
+        double z = 0.5 * ic;
+        std::shared_ptr<ChBody> prev = ground;
+        for (int il = 0; il < num_links; il++) {
+            auto body = chrono_types::make_shared<ChBody>();
+            body->SetPos(ChVector<>(il + 0.5, 0, z));
+            body->SetMass(1.0 + 0.1 * il);
+            body->SetInertiaXX(ChVector<>(0.01, 0.1, 0.1));
+            system.AddBody(body);
+
+            if (il == 0) {
+                auto motor = chrono_types::make_shared<ChLinkMotorRotationSpeed>();
+                motor->Initialize(body, prev, ChFrame<>(ChVector<>(il, 0, z)));
+                motor->SetSpeedFunction(speed);
+                system.AddLink(motor);
+            } else {
+                auto joint = chrono_types::make_shared<ChLinkLockRevolute>();
+                joint->Initialize(body, prev, ChCoordsys<>(ChVector<>(il, 0, z), QUNIT));
+                system.AddLink(joint);
+            }
+            prev = body;
+        }
+    }
+
+    for (int i = 0; i < 200; i++)
+        system.DoStepDynamics(1e-3);
+
+    std::vector<BodyState> states;
+    for (auto body : system.Get_bodylist())
+        states.push_back({body->GetPos(), body->GetRot(), body->GetPos_dt(), body->GetWvel_loc()});
+    return states;
+}
+
+TEST(ChAssembly, threads) {
+    auto s1 = RunChains(1);
+    auto s4 = RunChains(4);
+
+    ASSERT_EQ(s1.size(), s4.size());
+    for (size_t i = 0; i < s1.size(); i++) {
+        ASSERT_TRUE(s1[i].pos.Equals(s4[i].pos)) << "body " << i;
+        ASSERT_TRUE(s1[i].rot.Equals(s4[i].rot)) << "body " << i;
+        ASSERT_TRUE(s1[i].vel.Equals(s4[i].vel)) << "body " << i;
+        ASSERT_TRUE(s1[i].wvel.Equals(s4[i].wvel)) << "body " << i;
+    }
+
+    // The chains actually moved
+    ASSERT_GT((s1.back().pos - ChVector<>(5.5, 0, 3.5)).Length(), 1e-3);
+}
@@ -0,0 +1,243 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Unit test for binary checkpoint/restart.
+// A system with contacts, a pendulum, and a shaft driveline is simulated, a
+// checkpoint is written, and the simulation is continued. An identical system is
+// then re-created, the checkpoint is loaded, and the same steps are simulated.
+// The test checks that the two continued simulations produce identical states,
+// also with warm starting of the iterative solver (which requires the contacts
+// and their reactions to be restored), and that writing a checkpoint does not
+// alter the simulation.
+//
+// =============================================================================
+
+#include <vector>
+
+#include "chrono/physics/ChContactContainerNSC.h"
+#include "chrono/physics/ChLinkLock.h"
+#include "chrono/physics/ChShaftsClutch.h"
+#include "chrono/physics/ChShaftsGear.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChSolverPSOR.h"
+#include "chrono/utils/ChUtilsCreators.h"
+#include "chrono/utils/ChUtilsInputOutput.h"
+
+#include "chrono_thirdparty/filesystem/path.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+// Create the test model in the given system.
+// With warm starting, the PSOR solver is initialized with the reactions of persistent contacts.
+static void CreateModel(ChSystemNSC& system, bool warm_start = false) {
+    system.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    if (warm_start) {
+        auto solver = chrono_types::make_shared<ChSolverPSOR>();
+        solver->SetMaxIterations(20);
+        solver->EnableWarmStart(true);
+        system.SetSolver(solver);
+        std::static_pointer_cast<ChContactContainerNSC>(system.GetContactContainer())->SetPersistentContacts(true);
+    }
+
+    auto material = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+    material->SetFriction(0.4f);
+
+    // Balls dropped on a fixed container
+    utils::CreateBoxContainer(&system, -1, material, ChVector<>(2, 2, 1), 0.1, ChVector<>(0, 0, 0),
+                              ChQuaternion<>(1, 0, 0, 0), true, true, false, false);
+
+    double radius = 0.25;
+    double mass = 1;
+    for (int i = 0; i < 5; i++) {
+        auto ball = chrono_types::make_shared<ChBody>();
+        ball->SetMass(mass);
+        ball->SetInertiaXX(0.4 * mass * radius * radius * ChVector<>(1, 1, 1));
+        ball->SetPos(ChVector<>(-1.2 + 0.6 * i, radius + 0.1 * i, 0.1 * (i % 2)));
+        ball->SetPos_dt(ChVector<>(0.2, 0, 0));
+        ball->SetCollide(true);
+        ball->GetCollisionModel()->ClearModel();
+        utils::AddSphereGeometry(ball.get(), material, radius);
+        ball->GetCollisionModel()->BuildModel();
+        system.AddBody(ball);
+    }
+
+    // Pendulum connected to ground through a revolute joint
+    auto ground = chrono_types::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    system.AddBody(ground);
+
+    auto pend = chrono_types::make_shared<ChBody>();
+    pend->SetMass(2);
+    pend->SetInertiaXX(ChVector<>(0.1, 0.1, 0.1));
+    pend->SetPos(ChVector<>(1, 3, 0));
+    system.AddBody(pend);
+
+    auto revolute = chrono_types::make_shared<ChLinkLockRevolute>();
+    revolute->Initialize(ground, pend, ChCoordsys<>(ChVector<>(0, 3, 0), QUNIT));
+    system.AddLink(revolute);
+
+    // Shafts connected by a gear and a clutch
+    auto shaftA = chrono_types::make_shared<ChShaft>();
+    shaftA->SetInertia(0.5);
+    shaftA->SetAppliedTorque(6);
+    system.Add(shaftA);
+
+    auto shaftB = chrono_types::make_shared<ChShaft>();
+    shaftB->SetInertia(100);
+    system.Add(shaftB);
+
+    auto shaftC = chrono_types::make_shared<ChShaft>();
+    shaftC->SetInertia(0.6);
+    shaftC->SetPos_dt(-10);
+    system.Add(shaftC);
+
+    auto gearAB = chrono_types::make_shared<ChShaftsGear>();
+    gearAB->Initialize(shaftA, shaftB);
+    gearAB->SetTransmissionRatio(-0.1);
+    system.Add(gearAB);
+
+    auto clutchAC = chrono_types::make_shared<ChShaftsClutch>();
+    clutchAC->Initialize(shaftA, shaftC);
+    clutchAC->SetTorqueLimit(60);
+    system.Add(clutchAC);
+}
+
+// Return the current system state.
+static void GetState(ChSystemNSC& system, ChState& x, ChStateDelta& v, double& t) {
+    x.setZero(system.GetNcoords_x(), &system);
+    v.setZero(system.GetNcoords_w(), &system);
+    system.StateGather(x, v, t);
+}
+
+// Simulate the given number of steps and return the final system state.
+static void Simulate(ChSystemNSC& system, int num_steps, ChState& x, ChStateDelta& v, double& t) {
+    for (int i = 0; i < num_steps; i++)
+        system.DoStepDynamics(1e-3);
+    GetState(system, x, v, t);
+}
+
+// Check that two states are bitwise identical.
+static void CheckStates(const ChState& x1, const ChStateDelta& v1, double t1,
+                        const ChState& x2, const ChStateDelta& v2, double t2) {
+    ASSERT_EQ(t1, t2);
+    ASSERT_EQ(x1.size(), x2.size());
+    ASSERT_EQ(v1.size(), v2.size());
+    for (int i = 0; i < x1.size(); i++)
+        ASSERT_EQ(x1(i), x2(i));
+    for (int i = 0; i < v1.size(); i++)
+        ASSERT_EQ(v1(i), v2(i));
+}
+
+// Simulate, write a checkpoint, and continue the simulation. Then restart from the checkpoint and check that the
+// continued simulations are identical.
+static void CheckRestart(bool warm_start, const std::string& filename) {
+    // Reference simulation, with a checkpoint written after the first stage
+    ChState x_chk, x_ref;
+    ChStateDelta v_chk, v_ref;
+    double t_chk, t_ref;
+    int ncontacts_chk;
+    {
+        ChSystemNSC system;
+        CreateModel(system, warm_start);
+        Simulate(system, 500, x_chk, v_chk, t_chk);
+        ncontacts_chk = system.GetNcontacts();
+        ASSERT_GT(ncontacts_chk, 0);
+        ASSERT_TRUE(utils::WriteCheckpointBinary(&system, filename));
+        Simulate(system, 500, x_ref, v_ref, t_ref);
+    }
+
+    // Restarted simulation
+    ChState x;
+    ChStateDelta v;
+    double t;
+    {
+        ChSystemNSC system;
+        CreateModel(system, warm_start);
+        utils::ReadCheckpointBinary(&system, filename);
+
+        // The restored state and contacts must match the checkpointed ones exactly
+        GetState(system, x, v, t);
+        CheckStates(x, v, t, x_chk, v_chk, t_chk);
+        ASSERT_EQ(system.GetNcontacts(), ncontacts_chk);
+
+        Simulate(system, 500, x, v, t);
+    }
+
+    // The continued simulations must produce the same results
+    CheckStates(x, v, t, x_ref, v_ref, t_ref);
+}
+
+TEST(ChCheckpoint, restart) {
+    const std::string out_dir = GetChronoOutputPath() + "CHECKPOINT";
+    ASSERT_TRUE(filesystem::create_directory(filesystem::path(GetChronoOutputPath())));
+    ASSERT_TRUE(filesystem::create_directory(filesystem::path(out_dir)));
+    CheckRestart(false, out_dir + "/checkpoint.dat");
+}
+
+TEST(ChCheckpoint, restart_warm_start) {
+    const std::string out_dir = GetChronoOutputPath() + "CHECKPOINT";
+    ASSERT_TRUE(filesystem::create_directory(filesystem::path(GetChronoOutputPath())));
+    ASSERT_TRUE(filesystem::create_directory(filesystem::path(out_dir)));
+    CheckRestart(true, out_dir + "/checkpoint_warm.dat");
+}
+
+TEST(ChCheckpoint, read_only) {
+    const std::string out_dir = GetChronoOutputPath() + "CHECKPOINT";
+    ASSERT_TRUE(filesystem::create_directory(filesystem::path(GetChronoOutputPath())));
+    ASSERT_TRUE(filesystem::create_directory(filesystem::path(out_dir)));
+    const std::string filename = out_dir + "/checkpoint_read_only.dat";
+
+    // Writing checkpoints must not change the simulation results
+    ChState x1, x2;
+    ChStateDelta v1, v2;
+    double t1, t2;
+    {
+        ChSystemNSC system;
+        CreateModel(system, true);
+        for (int i = 0; i < 4; i++) {
+            Simulate(system, 100, x1, v1, t1);
+            ASSERT_TRUE(utils::WriteCheckpointBinary(&system, filename));
+        }
+    }
+    {
+        ChSystemNSC system;
+        CreateModel(system, true);
+        Simulate(system, 400, x2, v2, t2);
+    }
+    CheckStates(x1, v1, t1, x2, v2, t2);
+}
+
+TEST(ChCheckpoint, mismatch) {
+    const std::string out_dir = GetChronoOutputPath() + "CHECKPOINT";
+    ASSERT_TRUE(filesystem::create_directory(filesystem::path(GetChronoOutputPath())));
+    ASSERT_TRUE(filesystem::create_directory(filesystem::path(out_dir)));
+    const std::string filename = out_dir + "/checkpoint_mismatch.dat";
+
+    ChSystemNSC system;
+    CreateModel(system);
+
+    // The system must be set up before writing a checkpoint
+    ASSERT_FALSE(utils::WriteCheckpointBinary(&system, filename));
+    system.DoStepDynamics(1e-3);
+    ASSERT_TRUE(utils::WriteCheckpointBinary(&system, filename));
+
+    // Loading in a system with a different model must fail
+    ChSystemNSC other;
+    CreateModel(other);
+    other.AddBody(chrono_types::make_shared<ChBody>());
+    ASSERT_THROW(utils::ReadCheckpointBinary(&other, filename), ChException);
+}
@@ -0,0 +1,133 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Unit test for the multithreaded narrowphase of the Bullet collision system.
+// A pile of spheres, boxes, convex hulls, and compound bodies falling on a mesh
+// is simulated with one and with several threads; the contacts and the body
+// states must be identical.
+//
+// =============================================================================
+
+#include <vector>
+
+#include "chrono/collision/ChCollisionSystemBullet.h"
+#include "chrono/geometry/ChTriangleMeshConnected.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChMaterialSurfaceNSC.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+struct Result {
+    std::vector<int> num_contacts;
+    std::vector<ChVector<>> pos;
+    std::vector<ChQuaternion<>> rot;
+};
+
+static Result Simulate(int num_threads) {
+    ChSystemNSC system;
+    auto collision_system = std::static_pointer_cast<ChCollisionSystemBullet>(system.GetCollisionSystem());
+    collision_system->SetNumThreads(num_threads);
+
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+    mat->SetFriction(0.4f);
+
+    // Ground: a flat triangle mesh (concave pairs, processed serially)
+    auto mesh = chrono_types::make_shared<geometry::ChTriangleMeshConnected>();
+    mesh->addTriangle(ChVector<>(-2, 0, -2), ChVector<>(-2, 0, 2), ChVector<>(2, 0, 2));
+    mesh->addTriangle(ChVector<>(-2, 0, -2), ChVector<>(2, 0, 2), ChVector<>(2, 0, -2));
+    auto ground = chrono_types::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    ground->GetCollisionModel()->ClearModel();
+    ground->GetCollisionModel()->AddTriangleMesh(mat, mesh, true, false, VNULL, ChMatrix33<>(1), 0.01);
+    ground->GetCollisionModel()->BuildModel();
+    ground->SetCollide(true);
+    system.AddBody(ground);
+
+    // Container walls (convex)
+    for (int side = -1; side <= 1; side += 2) {
+        auto wall_x = chrono_types::make_shared<ChBodyEasyBox>(0.1, 1, 2, 1000, false, true, mat);
+        wall_x->SetPos(ChVector<>(side * 0.5, 0.5, 0));
+        wall_x->SetBodyFixed(true);
+        system.AddBody(wall_x);
+        auto wall_z = chrono_types::make_shared<ChBodyEasyBox>(2, 1, 0.1, 1000, false, true, mat);
+        wall_z->SetPos(ChVector<>(0, 0.5, side * 0.5));
+        wall_z->SetBodyFixed(true);
+        system.AddBody(wall_z);
+    }
+
+    // Falling bodies
+    std::vector<ChVector<>> hull_points = {ChVector<>(-0.03, 0, -0.03), ChVector<>(0.03, 0, -0.03),
+                                           ChVector<>(0, 0, 0.04),      ChVector<>(0, 0.05, 0)};
+    int num_bodies = 0;
+    for (int iy = 0; iy < 4; iy++) {
+        for (int ix = 0; ix < 4; ix++) {
+            for (int iz = 0; iz < 4; iz++) {
+                ChVector<> pos(-0.2 + 0.12 * ix + 0.01 * iy, 0.1 + 0.12 * iy, -0.2 + 0.12 * iz);
+                std::shared_ptr<ChBody> body;
+                switch (num_bodies++ % 4) {
+                    case 0:
+                        body = chrono_types::make_shared<ChBodyEasySphere>(0.04, 1000, false, true, mat);
+                        break;
+                    case 1:
+                        body = chrono_types::make_shared<ChBodyEasyBox>(0.06, 0.05, 0.07, 1000, false, true, mat);
+                        break;
+                    case 2:
+                        body = chrono_types::make_shared<ChBodyEasyConvexHull>(hull_points, 1000, false, true, mat);
+                        break;
+                    case 3:
+                        body = chrono_types::make_shared<ChBody>();
+                        body->GetCollisionModel()->ClearModel();
+                        body->GetCollisionModel()->AddSphere(mat, 0.03, ChVector<>(-0.02, 0, 0));
+                        body->GetCollisionModel()->AddBox(mat, 0.02, 0.02, 0.02, ChVector<>(0.02, 0, 0));
+                        body->GetCollisionModel()->BuildModel();
+                        body->SetCollide(true);
+                        break;
+                }
+                body->SetPos(pos);
+                body->SetRot(Q_from_AngAxis(0.3 * num_bodies, ChVector<>(1, 1, 0).GetNormalized()));
+                system.AddBody(body);
+            }
+        }
+    }
+
+    Result result;
+    for (int i = 0; i < 150; i++) {
+        system.DoStepDynamics(2e-3);
+        result.num_contacts.push_back(system.GetNcontacts());
+    }
+    for (auto body : system.Get_bodylist()) {
+        result.pos.push_back(body->GetPos());
+        result.rot.push_back(body->GetRot());
+    }
+    return result;
+}
+
+TEST(ChCollisionSystemBullet, narrowphase_mt) {
+    auto r1 = Simulate(1);
+    auto r4 = Simulate(4);
+
+    // Make sure there were contacts between all kinds of shapes
+    ASSERT_GT(r1.num_contacts.back(), 50);
+
+    ASSERT_EQ(r1.num_contacts, r4.num_contacts);
+    ASSERT_EQ(r1.pos.size(), r4.pos.size());
+    for (size_t i = 0; i < r1.pos.size(); i++) {
+        ASSERT_TRUE(r1.pos[i].Equals(r4.pos[i])) << "body " << i;
+        ASSERT_TRUE(r1.rot[i].Equals(r4.rot[i])) << "body " << i;
+    }
+}
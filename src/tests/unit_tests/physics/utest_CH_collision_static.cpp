@@ -0,0 +1,107 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Unit test for the static/dynamic split of the Bullet broadphase.
+// Spheres are dropped on a floor made of fixed tiles. Midway through the
+// simulation one of the tiles is moved away, so that the sphere resting on it
+// must fall. Results with and without the split must match, and with the split
+// the tiles must remain in the static tree of the broadphase.
+//
+// =============================================================================
+
+#include <vector>
+
+#include "chrono/collision/ChCollisionSystemBullet.h"
+#include "chrono/collision/bullet/BulletCollision/BroadphaseCollision/btDbvtBroadphase.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChMaterialSurfaceNSC.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+static const int num_tiles = 10;  // number of tiles in each direction
+
+struct Result {
+    std::vector<ChVector<>> pos;  // final sphere positions
+    int num_static_proxies;       // number of proxies in the static tree of the broadphase
+};
+
+static Result Simulate(bool static_split) {
+    ChSystemNSC system;
+    auto collision_system = std::static_pointer_cast<ChCollisionSystemBullet>(system.GetCollisionSystem());
+    collision_system->SetUseStaticSplit(static_split);
+
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+    mat->SetFriction(0.4f);
+
+    // Floor tiles
+    std::vector<std::shared_ptr<ChBody>> tiles;
+    for (int ix = 0; ix < num_tiles; ix++) {
+        for (int iz = 0; iz < num_tiles; iz++) {
+            auto tile = chrono_types::make_shared<ChBodyEasyBox>(0.2, 0.1, 0.2, 1000, false, true, mat);
+            tile->SetPos(ChVector<>(0.2 * ix, -0.05, 0.2 * iz));
+            tile->SetBodyFixed(true);
+            system.AddBody(tile);
+            tiles.push_back(tile);
+        }
+    }
+
+    // Spheres, each one above the center of a tile
+    std::vector<std::shared_ptr<ChBody>> spheres;
+    for (int ix = 0; ix < num_tiles; ix += 2) {
+        for (int iz = 0; iz < num_tiles; iz += 2) {
+            auto sphere = chrono_types::make_shared<ChBodyEasySphere>(0.05, 1000, false, true, mat);
+            sphere->SetPos(ChVector<>(0.2 * ix, 0.1 + 0.01 * iz, 0.2 * iz));
+            system.AddBody(sphere);
+            spheres.push_back(sphere);
+        }
+    }
+
+    for (int i = 0; i < 300; i++) {
+        // Move away the tile below the first sphere
+        if (i == 150)
+            tiles[0]->SetPos(ChVector<>(0, -2, 0));
+        system.DoStepDynamics(2e-3);
+    }
+
+    Result result;
+    for (auto sphere : spheres)
+        result.pos.push_back(sphere->GetPos());
+    auto broadphase = static_cast<btDbvtBroadphase*>(collision_system->GetBulletCollisionWorld()->getBroadphase());
+    result.num_static_proxies = broadphase->m_sets[1].m_leaves;
+    return result;
+}
+
+TEST(ChCollisionSystemBullet, static_split) {
+    auto r_split = Simulate(true);
+    auto r_ref = Simulate(false);
+
+    // All tiles (and only the tiles) must be in the static tree
+    ASSERT_EQ(r_split.num_static_proxies, num_tiles * num_tiles);
+
+    // The first sphere must have fallen, the other ones must rest on the floor
+    ASSERT_LT(r_split.pos[0].y(), -0.1);
+    for (size_t i = 1; i < r_split.pos.size(); i++)
+        ASSERT_NEAR(r_split.pos[i].y(), 0.05, 1e-3);
+
+    ASSERT_EQ(r_split.pos.size(), r_ref.pos.size());
+    for (size_t i = 0; i < r_split.pos.size(); i++) {
+        ASSERT_NEAR(r_split.pos[i].x(), r_ref.pos[i].x(), 1e-6) << "sphere " << i;
+        ASSERT_NEAR(r_split.pos[i].y(), r_ref.pos[i].y(), 1e-6) << "sphere " << i;
+        ASSERT_NEAR(r_split.pos[i].z(), r_ref.pos[i].z(), 1e-6) << "sphere " << i;
+    }
+}
@@ -0,0 +1,155 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Unit test for the ensemble runner (utils::ChEnsemble).
+// Each member drops a few spheres, at random locations, into a container. The
+// ensemble is run with one and with several threads; the results of each member
+// must be identical, and must depend only on the member seed. No profiling zones
+// must be recorded during multi-threaded runs, while profiling stays enabled.
+//
+// =============================================================================
+
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "chrono/core/ChMathematics.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/utils/ChEnsemble.h"
+#include "chrono/utils/ChProfiler.h"
+#include "chrono/utils/ChUtilsSamplers.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+class SpheresRun : public utils::ChEnsembleMember {
+  public:
+    SpheresRun(bool fail = false) : m_fail(fail) {}
+
+    virtual void Initialize(int index, unsigned int seed) override {
+        if (m_fail)
+            throw std::runtime_error("setup failed");
+
+        m_system = std::unique_ptr<ChSystemNSC>(new ChSystemNSC);
+        auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+
+        auto ground = chrono_types::make_shared<ChBodyEasyBox>(2, 0.2, 2, 1000, false, true, mat);
+        ground->SetPos(ChVector<>(0, -0.1, 0));
+        ground->SetBodyFixed(true);
+        m_system->AddBody(ground);
+
+        // Random initial locations, from both per-thread random engines
+        std::uniform_real_distribution<double> dist(-0.5, 0.5);
+        for (int i = 0; i < 8; i++) {
+            auto ball = chrono_types::make_shared<ChBodyEasySphere>(0.05, 1000, false, true, mat);
+            ball->SetPos(ChVector<>(dist(utils::rengine()), 0.1 + ChRandom(), dist(utils::rengine())));
+            m_system->AddBody(ball);
+        }
+    }
+
+    virtual ChSystem* GetSystem() override { return m_system.get(); }
+
+    virtual void Finalize() override {
+        m_pos.clear();
+        for (auto body : m_system->Get_bodylist())
+            m_pos.push_back(body->GetPos());
+        m_system.reset();
+    }
+
+    std::vector<ChVector<>> m_pos;
+
+  private:
+    bool m_fail;
+    std::unique_ptr<ChSystemNSC> m_system;
+};
+
+static std::vector<std::vector<ChVector<>>> RunEnsemble(int num_threads, unsigned int seed) {
+    utils::ChEnsemble ensemble;
+    for (int i = 0; i < 6; i++)
+        ensemble.AddMember(chrono_types::make_shared<SpheresRun>());
+    ensemble.SetNumThreads(num_threads);
+    ensemble.SetSeed(seed);
+    ensemble.Run(1e-3, 0.2);
+
+    EXPECT_EQ(ensemble.GetNumFailed(), 0);
+
+    std::vector<std::vector<ChVector<>>> pos;
+    for (int i = 0; i < ensemble.GetNumMembers(); i++)
+        pos.push_back(std::static_pointer_cast<SpheresRun>(ensemble.GetMember(i))->m_pos);
+    return pos;
+}
+
+TEST(ChEnsemble, reproducible) {
+    auto r1 = RunEnsemble(1, 1);
+    auto r4 = RunEnsemble(4, 1);
+    auto r4_shifted = RunEnsemble(4, 3);
+
+    ASSERT_EQ(r1.size(), r4.size());
+    for (size_t i = 0; i < r1.size(); i++) {
+        ASSERT_EQ(r1[i].size(), 9u);
+        for (size_t j = 0; j < r1[i].size(); j++)
+            ASSERT_TRUE(r1[i][j].Equals(r4[i][j])) << "member " << i << " body " << j;
+    }
+
+    // Results depend only on the member seed: member i+2 with base seed 1 uses the seed of member i with base seed 3
+    for (size_t i = 0; i + 2 < r1.size(); i++) {
+        for (size_t j = 0; j < r1[i].size(); j++)
+            ASSERT_TRUE(r1[i + 2][j].Equals(r4_shifted[i][j])) << "member " << i << " body " << j;
+    }
+
+    // Different seeds give different initial conditions
+    ASSERT_FALSE(r1[0][1].Equals(r1[1][1]));
+}
+
+TEST(ChEnsemble, errors) {
+    utils::ChEnsemble ensemble;
+    ensemble.AddMember(chrono_types::make_shared<SpheresRun>());
+    ensemble.AddMember(chrono_types::make_shared<SpheresRun>(true));
+    ensemble.AddMember(chrono_types::make_shared<SpheresRun>());
+    ensemble.SetNumThreads(2);
+    ensemble.Run(1e-3, 0.01);
+
+    ASSERT_EQ(ensemble.GetNumFailed(), 1);
+    ASSERT_TRUE(ensemble.GetError(0).empty());
+    ASSERT_EQ(ensemble.GetError(1), "setup failed");
+    ASSERT_EQ(std::static_pointer_cast<SpheresRun>(ensemble.GetMember(2))->m_pos.size(), 9u);
+}
+
+TEST(ChEnsemble, profiling) {
+    using utils::ChProfileManager;
+
+    ChProfileManager::Enable(true);
+    ChProfileManager::ClearTrace();
+    ChProfileManager::EnableTrace(true);
+
+    // With several threads, no profiling zones are recorded (but profiling is left enabled)
+    auto r4 = RunEnsemble(4, 1);
+    ASSERT_TRUE(ChProfileManager::IsEnabled());
+    ASSERT_EQ(ChProfileManager::Get_Trace_Num_Events(), 0);
+
+    // With a single thread, profiling zones are recorded
+    auto r1 = RunEnsemble(1, 1);
+    ASSERT_GT(ChProfileManager::Get_Trace_Num_Events(), 0);
+
+    ChProfileManager::EnableTrace(false);
+    ChProfileManager::ClearTrace();
+
+    for (size_t i = 0; i < r1.size(); i++) {
+        for (size_t j = 0; j < r1[i].size(); j++)
+            ASSERT_TRUE(r1[i][j].Equals(r4[i][j])) << "member " << i << " body " << j;
+    }
+}
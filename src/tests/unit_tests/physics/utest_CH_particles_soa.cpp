@@ -0,0 +1,123 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Unit test for the structure-of-arrays particle cluster.
+// A set of free-flying, spinning particles is simulated with ChParticlesClones
+// and with ChParticlesClonesSoA, and the resulting particle states are compared.
+// Also check that modifications through the particle frames returned by
+// ChParticlesClonesSoA::GetParticle are written to the container.
+//
+// =============================================================================
+
+#include "chrono/physics/ChParticlesClones.h"
+#include "chrono/physics/ChParticlesClonesSoA.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/timestepper/ChTimestepper.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+static const int num_particles = 50;
+
+template <typename Cluster>
+std::shared_ptr<Cluster> Simulate(ChTimestepper::Type integrator) {
+    ChSystemNSC system;
+    system.SetTimestepperType(integrator);
+
+    auto particles = chrono_types::make_shared<Cluster>();
+    particles->SetMass(0.2);
+    particles->SetInertiaXX(ChVector<>(1e-3, 2e-3, 3e-3));
+    for (int i = 0; i < num_particles; i++) {
+        ChQuaternion<> rot = Q_from_AngAxis(0.1 * i, ChVector<>(1, 2, 3).GetNormalized());
+        particles->AddParticle(ChCoordsys<>(ChVector<>(0.1 * i, 0, 0), rot));
+    }
+    system.Add(particles);
+
+    // Set initial velocities through the generic state interface
+    int n_w = particles->GetDOF_w();
+    ChState x(particles->GetDOF(), nullptr);
+    ChStateDelta v(n_w, nullptr);
+    double T;
+    particles->IntStateGather(0, x, 0, v, T);
+    for (int i = 0; i < num_particles; i++) {
+        v.segment(6 * i, 3) = ChVector<>(0.1 * i, 1, 0).eigen();
+        v.segment(6 * i + 3, 3) = ChVector<>(1, -0.5 * i, 2).eigen();
+    }
+    particles->IntStateScatter(0, x, 0, v, T);
+
+    for (int i = 0; i < 50; i++)
+        system.DoStepDynamics(1e-3);
+
+    return particles;
+}
+
+static void Compare(ChTimestepper::Type integrator) {
+    auto p_aos = Simulate<ChParticlesClones>(integrator);
+    auto p_soa = Simulate<ChParticlesClonesSoA>(integrator);
+
+    ASSERT_EQ(p_aos->GetNparticles(), p_soa->GetNparticles());
+    for (unsigned int i = 0; i < num_particles; i++) {
+        const ChParticleBase& a = p_aos->GetParticle(i);
+        const ChParticleBase& b = p_soa->GetParticle(i);
+        for (int k = 0; k < 3; k++) {
+            ASSERT_NEAR(a.GetPos()[k], b.GetPos()[k], 1e-10);
+            ASSERT_NEAR(a.GetPos_dt()[k], b.GetPos_dt()[k], 1e-10);
+            ASSERT_NEAR(a.GetWvel_loc()[k], b.GetWvel_loc()[k], 1e-10);
+        }
+        ASSERT_NEAR(a.GetRot().e0(), b.GetRot().e0(), 1e-10);
+        ASSERT_NEAR(a.GetRot().e1(), b.GetRot().e1(), 1e-10);
+        ASSERT_NEAR(a.GetRot().e2(), b.GetRot().e2(), 1e-10);
+        ASSERT_NEAR(a.GetRot().e3(), b.GetRot().e3(), 1e-10);
+    }
+}
+
+TEST(ChParticlesClonesSoA, euler_implicit_linearized) {
+    Compare(ChTimestepper::Type::EULER_IMPLICIT_LINEARIZED);
+}
+
+TEST(ChParticlesClonesSoA, euler_implicit) {
+    Compare(ChTimestepper::Type::EULER_IMPLICIT);
+}
+
+TEST(ChParticlesClonesSoA, write_through) {
+    ChParticlesClonesSoA particles;
+    for (int i = 0; i < 3; i++)
+        particles.AddParticle(ChCoordsys<>(ChVector<>(i, 0, 0), QUNIT));
+
+    ChQuaternion<> rot = Q_from_AngAxis(0.3, ChVector<>(0, 0, 1));
+    ChParticleBase& p = particles.GetParticle(1);
+    p.SetPos(ChVector<>(1, 2, 3));
+    p.SetRot(rot);
+    p.SetPos_dt(ChVector<>(4, 5, 6));
+    p.SetWvel_loc(ChVector<>(0.1, 0.2, 0.3));
+    p.SetPos_dtdt(ChVector<>(7, 8, 9));
+
+    ASSERT_DOUBLE_EQ((particles.GetParticlePos(1) - ChVector<>(1, 2, 3)).Length(), 0.0);
+    ASSERT_NEAR((particles.GetParticleRot(1) - rot).Length(), 0.0, 1e-15);
+    ASSERT_DOUBLE_EQ((particles.GetParticlePos_dt(1) - ChVector<>(4, 5, 6)).Length(), 0.0);
+    ASSERT_NEAR((particles.GetParticleWvel_loc(1) - ChVector<>(0.1, 0.2, 0.3)).Length(), 0.0, 1e-15);
+
+    // The other particles are not affected
+    ASSERT_DOUBLE_EQ((particles.GetParticlePos(0) - ChVector<>(0, 0, 0)).Length(), 0.0);
+    ASSERT_DOUBLE_EQ((particles.GetParticlePos(2) - ChVector<>(2, 0, 0)).Length(), 0.0);
+    ASSERT_DOUBLE_EQ(particles.GetParticlePos_dt(2).Length(), 0.0);
+
+    // Changes made through the container are seen by the frame at the next GetParticle call
+    particles.SetParticlePos(1, ChVector<>(-1, -2, -3));
+    const ChParticleBase& q = particles.GetParticle(1);
+    ASSERT_DOUBLE_EQ((q.GetPos() - ChVector<>(-1, -2, -3)).Length(), 0.0);
+    ASSERT_DOUBLE_EQ((q.GetPos_dtdt() - ChVector<>(7, 8, 9)).Length(), 0.0);
+    ASSERT_NEAR((q.GetWvel_loc() - ChVector<>(0.1, 0.2, 0.3)).Length(), 0.0, 1e-15);
+}
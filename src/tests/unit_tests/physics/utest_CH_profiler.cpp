@@ -0,0 +1,286 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Unit test for the profiler trace and JSON exports.
+// A ball bouncing on the ground is simulated with trace recording enabled. The
+// test checks that zone events and counter samples are recorded and exported,
+// that recorded events are kept when the trace is disabled (until written or
+// cleared), and that nothing is recorded when profiling is disabled at run time.
+// A pile of balls is also simulated with several threads, to check that the
+// profile tree and the trace do not depend on the number of threads, and a
+// system is simulated on a separate thread, to check that only zones on the
+// profiling thread are recorded and that, by default, the profiling thread is
+// the first thread that advances a system.
+//
+// =============================================================================
+
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/utils/ChProfiler.h"
+#include "chrono/utils/ChUtilsCreators.h"
+
+#include "chrono_thirdparty/filesystem/path.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::utils;
+
+// Create the test model in the given system.
+static void CreateModel(ChSystemNSC& system) {
+    system.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto material = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+
+    auto ground = chrono_types::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    ground->SetCollide(true);
+    ground->GetCollisionModel()->ClearModel();
+    utils::AddBoxGeometry(ground.get(), material, ChVector<>(2, 0.1, 2), ChVector<>(0, -0.1, 0));
+    ground->GetCollisionModel()->BuildModel();
+    system.AddBody(ground);
+
+    auto ball = chrono_types::make_shared<ChBody>();
+    ball->SetPos(ChVector<>(0, 0.2, 0));
+    ball->SetCollide(true);
+    ball->GetCollisionModel()->ClearModel();
+    utils::AddSphereGeometry(ball.get(), material, 0.2);
+    ball->GetCollisionModel()->BuildModel();
+    system.AddBody(ball);
+}
+
+// Create a pile of balls with visualization assets, so that the parallel item updates have some work to do.
+static void CreatePile(ChSystemNSC& system) {
+    CreateModel(system);
+
+    auto material = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+    for (int i = 0; i < 5; i++) {
+        for (int j = 0; j < 5; j++) {
+            for (int k = 0; k < 4; k++) {
+                auto ball = chrono_types::make_shared<ChBody>();
+                ball->SetPos(ChVector<>(0.25 * i - 0.5, 0.6 + 0.25 * k, 0.25 * j - 0.5));
+                ball->SetCollide(true);
+                ball->GetCollisionModel()->ClearModel();
+                utils::AddSphereGeometry(ball.get(), material, 0.1);
+                ball->GetCollisionModel()->BuildModel();
+                system.AddBody(ball);
+            }
+        }
+    }
+}
+
+// Return the number of calls of the named zone, a direct child of the profile tree root (-1 if not found).
+static int GetRootZoneCalls(const std::string& name) {
+    int calls = -1;
+    ChProfileIterator* iterator = ChProfileManager::Get_Iterator();
+    for (iterator->First(); !iterator->Is_Done(); iterator->Next()) {
+        if (name == iterator->Get_Current_Name())
+            calls = iterator->Get_Current_Total_Calls();
+    }
+    ChProfileManager::Release_Iterator(iterator);
+    return calls;
+}
+
+// Simulate the pile with the given number of threads and return the number of recorded trace events.
+static size_t SimulatePile(int num_threads) {
+    ChSystemNSC system;
+    system.SetNumThreads(num_threads);
+    CreatePile(system);
+
+    ChProfileManager::Reset();
+    ChProfileManager::ClearTrace();
+    ChProfileManager::EnableTrace(true);
+    for (int i = 0; i < 20; i++) {
+        system.DoStepDynamics(1e-3);
+        ChProfileManager::Increment_Frame_Counter();
+    }
+    ChProfileManager::EnableTrace(false);
+
+    // Zones opened after the simulation must be children of the root
+    {
+        CH_PROFILE("TestZone");
+    }
+
+    return ChProfileManager::Get_Trace_Num_Events();
+}
+
+// Return the content of the given file.
+static std::string ReadFile(const std::string& filename) {
+    std::ifstream file(filename);
+    std::stringstream buffer;
+    buffer << file.rdbuf();
+    return buffer.str();
+}
+
+TEST(ChProfiler, trace) {
+    const std::string out_dir = GetChronoOutputPath() + "PROFILER";
+    ASSERT_TRUE(filesystem::create_directory(filesystem::path(GetChronoOutputPath())));
+    ASSERT_TRUE(filesystem::create_directory(filesystem::path(out_dir)));
+
+    ChSystemNSC system;
+    CreateModel(system);
+
+    ChProfileManager::Reset();
+    ChProfileManager::ClearTrace();
+    ChProfileManager::EnableTrace(true);
+    for (int i = 0; i < 10; i++) {
+        system.DoStepDynamics(1e-3);
+        ChProfileManager::Increment_Frame_Counter();
+    }
+    ChProfileManager::EnableTrace(false);
+
+    ASSERT_GT(system.GetNcontacts(), 0);
+
+    // Disabling trace recording keeps the recorded events, and no new events are recorded
+    size_t num_events = ChProfileManager::Get_Trace_Num_Events();
+    ASSERT_GT(num_events, 10);
+    system.DoStepDynamics(1e-3);
+    ASSERT_EQ(ChProfileManager::Get_Trace_Num_Events(), num_events);
+
+    // Record again, appending to the existing events, and export
+    ChProfileManager::EnableTrace(true);
+    for (int i = 0; i < 9; i++) {
+        system.DoStepDynamics(1e-3);
+        ChProfileManager::Increment_Frame_Counter();
+    }
+    ASSERT_GT(ChProfileManager::Get_Trace_Num_Events(), num_events);
+
+    const std::string trace_file = out_dir + "/trace.json";
+    ASSERT_TRUE(ChProfileManager::WriteChromeTrace(trace_file));
+    std::string trace = ReadFile(trace_file);
+    ASSERT_NE(trace.find("\"traceEvents\""), std::string::npos);
+    ASSERT_NE(trace.find("\"Integrate_Y\""), std::string::npos);
+    ASSERT_NE(trace.find("\"SolverSolve\""), std::string::npos);
+    ASSERT_NE(trace.find("\"Broad-phase\""), std::string::npos);
+    ASSERT_NE(trace.find("\"UpdateAABBs\""), std::string::npos);
+    ASSERT_NE(trace.find("\"Narrow-phase\""), std::string::npos);
+    ASSERT_NE(trace.find("\"UpdateBodies\""), std::string::npos);
+    ASSERT_NE(trace.find("\"contacts\""), std::string::npos);
+
+    // Writing the trace discards the written events
+    ASSERT_EQ(ChProfileManager::Get_Trace_Num_Events(), 0);
+
+    const std::string json_file = out_dir + "/profile.json";
+    ASSERT_TRUE(ChProfileManager::WriteJSON(json_file));
+    std::string json = ReadFile(json_file);
+    ASSERT_NE(json.find("\"frames\": 19"), std::string::npos);
+    ASSERT_NE(json.find("\"ComputeCollisions\""), std::string::npos);
+
+    // Explicitly discard recorded events
+    system.DoStepDynamics(1e-3);
+    ASSERT_GT(ChProfileManager::Get_Trace_Num_Events(), 0);
+    ChProfileManager::EnableTrace(false);
+    ChProfileManager::ClearTrace();
+    ASSERT_EQ(ChProfileManager::Get_Trace_Num_Events(), 0);
+}
+
+TEST(ChProfiler, disabled) {
+    ChSystemNSC system;
+    CreateModel(system);
+
+    ChProfileManager::Reset();
+    ChProfileManager::ClearTrace();
+    ChProfileManager::Enable(false);
+    ChProfileManager::EnableTrace(true);
+    for (int i = 0; i < 10; i++)
+        system.DoStepDynamics(1e-3);
+    size_t num_events = ChProfileManager::Get_Trace_Num_Events();
+    ChProfileManager::EnableTrace(false);
+    ChProfileManager::Enable(true);
+
+    ASSERT_EQ(num_events, 0);
+}
+
+TEST(ChProfiler, multithreaded) {
+    size_t num_events_1 = SimulatePile(1);
+    int num_steps_1 = GetRootZoneCalls("Integrate_Y");
+    ASSERT_EQ(num_steps_1, 20);
+    ASSERT_EQ(GetRootZoneCalls("TestZone"), 1);
+
+    size_t num_events_4 = SimulatePile(4);
+    ASSERT_EQ(GetRootZoneCalls("Integrate_Y"), 20);
+    ASSERT_EQ(GetRootZoneCalls("TestZone"), 1);
+
+    ASSERT_GT(num_events_1, 0);
+    ASSERT_EQ(num_events_4, num_events_1);
+
+    ChProfileManager::ClearTrace();
+}
+
+TEST(ChProfiler, other_thread) {
+    ChProfileManager::SetProfilingThread();
+    ChProfileManager::Reset();
+    ChProfileManager::ClearTrace();
+    ChProfileManager::EnableTrace(true);
+
+    // Zones opened on another thread are not recorded
+    std::thread worker([]() {
+        ASSERT_FALSE(ChProfileManager::IsProfilingThread());
+        ChSystemNSC system;
+        CreateModel(system);
+        for (int i = 0; i < 10; i++)
+            system.DoStepDynamics(1e-3);
+    });
+    worker.join();
+    ASSERT_EQ(ChProfileManager::Get_Trace_Num_Events(), 0);
+    ASSERT_LE(GetRootZoneCalls("Integrate_Y"), 0);
+
+    // Zones opened on the profiling thread are recorded
+    ASSERT_TRUE(ChProfileManager::IsProfilingThread());
+    ChSystemNSC system;
+    CreateModel(system);
+    for (int i = 0; i < 10; i++)
+        system.DoStepDynamics(1e-3);
+    ASSERT_GT(ChProfileManager::Get_Trace_Num_Events(), 0);
+    ASSERT_EQ(GetRootZoneCalls("Integrate_Y"), 10);
+
+    ChProfileManager::EnableTrace(false);
+    ChProfileManager::ClearTrace();
+}
+
+TEST(ChProfiler, first_stepping_thread) {
+    ChProfileManager::ClearProfilingThread();
+    ChProfileManager::Reset();
+    ChProfileManager::ClearTrace();
+    ChProfileManager::EnableTrace(true);
+    ASSERT_FALSE(ChProfileManager::IsProfilingThread());
+
+    // The first thread that advances a system becomes the profiling thread
+    std::thread worker([]() {
+        ChSystemNSC system;
+        CreateModel(system);
+        for (int i = 0; i < 10; i++)
+            system.DoStepDynamics(1e-3);
+        ASSERT_TRUE(ChProfileManager::IsProfilingThread());
+    });
+    worker.join();
+    ASSERT_FALSE(ChProfileManager::IsProfilingThread());
+    ASSERT_GT(ChProfileManager::Get_Trace_Num_Events(), 0);
+    ASSERT_EQ(GetRootZoneCalls("Integrate_Y"), 10);
+
+    // Stepping on this thread does not take over
+    size_t num_events = ChProfileManager::Get_Trace_Num_Events();
+    ChSystemNSC system;
+    CreateModel(system);
+    system.DoStepDynamics(1e-3);
+    ASSERT_FALSE(ChProfileManager::IsProfilingThread());
+    ASSERT_EQ(ChProfileManager::Get_Trace_Num_Events(), num_events);
+
+    ChProfileManager::SetProfilingThread();
+    ChProfileManager::EnableTrace(false);
+    ChProfileManager::ClearTrace();
+}
@@ -0,0 +1,191 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Unit test for batched ray casting in the Bullet collision system.
+// Rays are cast on a scene with a mesh ground and bodies with different shapes.
+// The results of RayHitBatch, with and without a list of collision models and
+// with one and several threads, must match those of one RayHit call per ray.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <vector>
+
+#include "chrono/collision/ChCollisionSystemBullet.h"
+#include "chrono/core/ChMathematics.h"
+#include "chrono/geometry/ChTriangleMeshConnected.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChMaterialSurfaceNSC.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::collision;
+
+class RayHitBatchTest : public ::testing::Test {
+  protected:
+    RayHitBatchTest();
+
+    // Compare the batch results with the reference results and return the number of hits.
+    int Compare(const std::vector<ChCollisionSystem::ChRayhitResult>& batch,
+                const std::vector<ChCollisionSystem::ChRayhitResult>& reference);
+
+    ChSystemNSC system;
+    std::vector<ChCollisionModel*> models;  // subset of the collision models, used as filter
+    std::vector<ChVector<>> from;
+    std::vector<ChVector<>> to;
+};
+
+RayHitBatchTest::RayHitBatchTest() {
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+
+    // Ground: a flat triangle mesh
+    auto mesh = chrono_types::make_shared<geometry::ChTriangleMeshConnected>();
+    mesh->addTriangle(ChVector<>(-2, 0, -2), ChVector<>(-2, 0, 2), ChVector<>(2, 0, 2));
+    mesh->addTriangle(ChVector<>(-2, 0, -2), ChVector<>(2, 0, 2), ChVector<>(2, 0, -2));
+    auto ground = chrono_types::make_shared<ChBody>();
+    ground->SetBodyFixed(true);
+    ground->GetCollisionModel()->ClearModel();
+    ground->GetCollisionModel()->AddTriangleMesh(mat, mesh, true, false, VNULL, ChMatrix33<>(1), 0.01);
+    ground->GetCollisionModel()->BuildModel();
+    ground->SetCollide(true);
+    system.AddBody(ground);
+
+    auto sphere = chrono_types::make_shared<ChBodyEasySphere>(0.3, 1000, false, true, mat);
+    sphere->SetPos(ChVector<>(-1, 0.3, -1));
+    system.AddBody(sphere);
+
+    auto box = chrono_types::make_shared<ChBodyEasyBox>(0.6, 0.4, 0.8, 1000, false, true, mat);
+    box->SetPos(ChVector<>(1, 0.2, -1));
+    box->SetRot(Q_from_AngY(0.3));
+    system.AddBody(box);
+
+    auto cylinder = chrono_types::make_shared<ChBodyEasyCylinder>(0.25, 0.5, 1000, false, true, mat);
+    cylinder->SetPos(ChVector<>(-1, 0.25, 1));
+    system.AddBody(cylinder);
+
+    // Compound body, tilted, partly hiding the sphere
+    auto compound = chrono_types::make_shared<ChBody>();
+    compound->SetPos(ChVector<>(0.6, 0.7, 0.6));
+    compound->SetRot(Q_from_AngX(0.4) * Q_from_AngY(0.2));
+    compound->GetCollisionModel()->ClearModel();
+    compound->GetCollisionModel()->AddBox(mat, 0.3, 0.05, 0.3, ChVector<>(0, 0, 0));
+    compound->GetCollisionModel()->AddSphere(mat, 0.15, ChVector<>(0.3, 0.2, 0));
+    compound->GetCollisionModel()->BuildModel();
+    compound->SetCollide(true);
+    system.AddBody(compound);
+
+    for (auto body : system.Get_bodylist())
+        body->SetBodyFixed(true);
+
+    // Only the ground, the sphere and the compound body are used as filter
+    models.push_back(ground->GetCollisionModel().get());
+    models.push_back(sphere->GetCollisionModel().get());
+    models.push_back(compound->GetCollisionModel().get());
+
+    // Synchronize the collision models and update the broadphase
+    system.Update();
+    system.ComputeCollisions();
+
+    // Vertical rays on a grid extending beyond the ground (cell edges coincide with the mesh edges and diagonal)
+    for (int i = 0; i <= 50; i++) {
+        for (int j = 0; j <= 50; j++) {
+            double x = -2.5 + 0.1 * i;
+            double z = -2.5 + 0.1 * j;
+            from.push_back(ChVector<>(x, 2, z));
+            to.push_back(ChVector<>(x, -1, z));
+        }
+    }
+
+    // Slanted rays with random start points and directions
+    ChSetRandomSeed(12);
+    for (int i = 0; i < 1000; i++) {
+        ChVector<> start(4 * ChRandom() - 2, 1 + ChRandom(), 4 * ChRandom() - 2);
+        ChVector<> dir(2 * ChRandom() - 1, -1 - ChRandom(), 2 * ChRandom() - 1);
+        from.push_back(start);
+        to.push_back(start + dir * 2);
+    }
+}
+
+int RayHitBatchTest::Compare(const std::vector<ChCollisionSystem::ChRayhitResult>& batch,
+                             const std::vector<ChCollisionSystem::ChRayhitResult>& reference) {
+    const double tol = 1e-6;
+    int num_hits = 0;
+    EXPECT_EQ(batch.size(), reference.size());
+    for (size_t i = 0; i < reference.size(); i++) {
+        EXPECT_EQ(batch[i].hit, reference[i].hit) << "ray " << i;
+        if (!reference[i].hit || !batch[i].hit)
+            continue;
+        num_hits++;
+        EXPECT_EQ(batch[i].hitModel, reference[i].hitModel) << "ray " << i;
+        EXPECT_NEAR(batch[i].dist_factor, reference[i].dist_factor, tol) << "ray " << i;
+        EXPECT_NEAR((batch[i].abs_hitPoint - reference[i].abs_hitPoint).Length(), 0, tol) << "ray " << i;
+        EXPECT_NEAR((batch[i].abs_hitNormal - reference[i].abs_hitNormal).Length(), 0, tol) << "ray " << i;
+    }
+    return num_hits;
+}
+
+TEST_F(RayHitBatchTest, all_models) {
+    auto collision_system = system.GetCollisionSystem();
+
+    std::vector<ChCollisionSystem::ChRayhitResult> reference(from.size());
+    for (size_t i = 0; i < from.size(); i++)
+        collision_system->RayHit(from[i], to[i], reference[i]);
+
+    for (int num_threads : {1, 4}) {
+        std::vector<ChCollisionSystem::ChRayhitResult> batch;
+        collision_system->RayHitBatch(from, to, std::vector<ChCollisionModel*>(), batch, num_threads);
+        int num_hits = Compare(batch, reference);
+        ASSERT_GT(num_hits, 0);
+        ASSERT_LT(num_hits, (int)from.size());
+    }
+}
+
+TEST_F(RayHitBatchTest, filtered_models) {
+    auto collision_system = system.GetCollisionSystem();
+
+    // Reference: closest hit over the individual models
+    std::vector<ChCollisionSystem::ChRayhitResult> reference(from.size());
+    for (size_t i = 0; i < from.size(); i++) {
+        reference[i].hit = false;
+        for (auto model : models) {
+            ChCollisionSystem::ChRayhitResult result;
+            if (collision_system->RayHit(from[i], to[i], model, result) &&
+                (!reference[i].hit || result.dist_factor < reference[i].dist_factor))
+                reference[i] = result;
+        }
+    }
+
+    // Check that the filter matters: some rays hit excluded models when no filter is used
+    int num_excluded = 0;
+    for (size_t i = 0; i < from.size(); i++) {
+        ChCollisionSystem::ChRayhitResult result;
+        if (collision_system->RayHit(from[i], to[i], result) &&
+            std::find(models.begin(), models.end(), result.hitModel) == models.end())
+            num_excluded++;
+    }
+    ASSERT_GT(num_excluded, 0);
+
+    for (int num_threads : {1, 4}) {
+        std::vector<ChCollisionSystem::ChRayhitResult> batch;
+        collision_system->RayHitBatch(from, to, models, batch, num_threads);
+        int num_hits = Compare(batch, reference);
+        ASSERT_GT(num_hits, 0);
+        for (const auto& result : batch) {
+            if (result.hit)
+                ASSERT_NE(std::find(models.begin(), models.end(), result.hitModel), models.end());
+        }
+    }
+}
@@ -0,0 +1,170 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Unit test for the graph-colored PSOR solver.
+// A layer of touching balls settles in a box. The test checks that the total contact
+// force on the container balances the weight of the balls and that results
+// do not depend on the number of threads used by the solver.
+// A hanging chain, some of whose constraints do not report their variables,
+// checks that such constraints are handled and that the solution matches
+// the one obtained with the PSOR solver.
+//
+// =============================================================================
+
+#include <vector>
+
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChConstraintTwoGeneric.h"
+#include "chrono/solver/ChSolverPSOR.h"
+#include "chrono/solver/ChSolverPSORcolored.h"
+#include "chrono/solver/ChVariablesGeneric.h"
+#include "chrono/utils/ChUtilsCreators.h"
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+// Simulate the ball settling problem with the specified solver settings.
+// Return the final ball positions and the resultant contact force on the container.
+static void Simulate(int num_threads, bool symmetric, std::vector<ChVector<>>& positions, ChVector<>& force) {
+    ChSystemNSC system;
+    system.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    auto solver = chrono_types::make_shared<ChSolverPSORcolored>();
+    solver->SetNumThreads(num_threads);
+    solver->SetSymmetric(symmetric);
+    solver->SetMaxIterations(100);
+    system.SetSolver(solver);
+
+    auto material = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+    material->SetFriction(0.4f);
+
+    double radius = 0.5;
+    double mass = 1;
+    std::vector<std::shared_ptr<ChBody>> balls;
+    for (int ix = 0; ix < 3; ix++) {
+        for (int iz = 0; iz < 3; iz++) {
+            auto ball = chrono_types::make_shared<ChBody>();
+            ball->SetMass(mass);
+            ball->SetInertiaXX(0.4 * mass * radius * radius * ChVector<>(1, 1, 1));
+            ball->SetPos(ChVector<>(-1.0 + ix, radius + 0.01 * (ix + iz), -1.0 + iz));
+            ball->SetCollide(true);
+            ball->GetCollisionModel()->ClearModel();
+            utils::AddSphereGeometry(ball.get(), material, radius);
+            ball->GetCollisionModel()->BuildModel();
+            system.AddBody(ball);
+            balls.push_back(ball);
+        }
+    }
+
+    auto ground = utils::CreateBoxContainer(&system, -1, material, ChVector<>(2, 2, 1), 0.1, ChVector<>(0, 0, 0),
+                                            ChQuaternion<>(1, 0, 0, 0), true, true, false, false);
+
+    while (system.GetChTime() < 0.3) {
+        system.DoStepDynamics(2e-3);
+    }
+
+    positions.clear();
+    for (auto& ball : balls)
+        positions.push_back(ball->GetPos());
+    force = ground->GetContactForce();
+
+    ASSERT_GT(solver->GetNumColors(), 1);
+}
+
+TEST(ChSolverPSORcolored, settling) {
+    double weight = 9 * 1 * 9.81;
+
+    for (bool symmetric : {false, true}) {
+        std::vector<ChVector<>> pos_serial;
+        ChVector<> force_serial;
+        Simulate(1, symmetric, pos_serial, force_serial);
+        ASSERT_NEAR(-force_serial.y(), weight, 1e-2 * weight);
+
+        std::vector<ChVector<>> pos_parallel;
+        ChVector<> force_parallel;
+        Simulate(4, symmetric, pos_parallel, force_parallel);
+
+        ASSERT_EQ(pos_serial.size(), pos_parallel.size());
+        for (size_t i = 0; i < pos_serial.size(); i++) {
+            ASSERT_EQ(pos_serial[i].x(), pos_parallel[i].x());
+            ASSERT_EQ(pos_serial[i].y(), pos_parallel[i].y());
+            ASSERT_EQ(pos_serial[i].z(), pos_parallel[i].z());
+        }
+        ASSERT_EQ(force_serial.y(), force_parallel.y());
+    }
+}
+
+// Constraint which does not report its variables (as a user-defined constraint relying on the default implementation
+// of ChConstraint::CollectVariables).
+class ChConstraintOpaque : public ChConstraintTwoGeneric {
+  public:
+    ChConstraintOpaque(ChVariables* mvariables_a, ChVariables* mvariables_b)
+        : ChConstraintTwoGeneric(mvariables_a, mvariables_b) {}
+    virtual ChConstraintOpaque* Clone() const override { return new ChConstraintOpaque(*this); }
+    virtual void CollectVariables(std::vector<ChVariables*>& vars) override {}
+};
+
+// Solve for the reactions in a 1D hanging chain, with every third constraint not reporting its variables.
+static std::vector<double> SolveChain(ChIterativeSolverVI& solver) {
+    const int n_masses = 11;
+    ChSystemDescriptor descriptor;
+    std::vector<std::unique_ptr<ChVariablesGeneric>> vars;
+    std::vector<std::unique_ptr<ChConstraintTwoGeneric>> constraints;
+
+    descriptor.BeginInsertion();
+    for (int im = 0; im < n_masses; im++) {
+        vars.emplace_back(new ChVariablesGeneric(1));
+        vars[im]->GetMass()(0) = 10;
+        vars[im]->GetInvMass()(0) = 0.1;
+        vars[im]->Get_fb()(0) = -9.8 * 10 * 0.01;
+        descriptor.InsertVariables(vars[im].get());
+        if (im > 0) {
+            if (im % 3 == 0)
+                constraints.emplace_back(new ChConstraintOpaque(vars[im].get(), vars[im - 1].get()));
+            else
+                constraints.emplace_back(new ChConstraintTwoGeneric(vars[im].get(), vars[im - 1].get()));
+            constraints.back()->Set_b_i(0);
+            constraints.back()->Get_Cq_a()(0) = 1;
+            constraints.back()->Get_Cq_b()(0) = -1;
+            descriptor.InsertConstraint(constraints.back().get());
+        }
+    }
+    vars[0]->SetDisabled(true);
+    descriptor.EndInsertion();
+
+    solver.SetMaxIterations(2000);
+    solver.SetTolerance(1e-12);
+    solver.Solve(descriptor);
+
+    std::vector<double> reactions;
+    for (auto& c : constraints)
+        reactions.push_back(c->Get_l_i());
+    return reactions;
+}
+
+TEST(ChSolverPSORcolored, unknown_connectivity) {
+    ChSolverPSOR psor;
+    auto reactions_psor = SolveChain(psor);
+
+    ChSolverPSORcolored colored;
+    colored.SetNumThreads(4);
+    auto reactions_colored = SolveChain(colored);
+
+    // A chain needs two colors; each of the three constraints which do not report their variables gets its own color.
+    ASSERT_EQ(colored.GetNumColors(), 2 + 3);
+
+    ASSERT_EQ(reactions_psor.size(), reactions_colored.size());
+    for (size_t i = 0; i < reactions_psor.size(); i++)
+        ASSERT_NEAR(reactions_colored[i], reactions_psor[i], 1e-8);
+}
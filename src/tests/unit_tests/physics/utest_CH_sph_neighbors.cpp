@@ -0,0 +1,220 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Unit test for the cell list neighbor search of SPH nodes.
+// The pairs found by ChNeighborGridSPH are compared with a brute-force search,
+// also with multiple threads, and an SPH fluid block simulated with the cell list
+// is compared with the same fluid block simulated with the pairs reported by the
+// collision system. With the cell list, the nodes must be moved to a collision family
+// that excludes node-node pairs only, and their original families must be restored
+// when the cell list is disabled. A fluid block resting in a container, simulated with
+// the cell list, must stay in the container.
+//
+// =============================================================================
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "chrono/core/ChMathematics.h"
+#include "chrono/physics/ChBody.h"
+#include "chrono/physics/ChMatterSPH.h"
+#include "chrono/physics/ChNeighborGridSPH.h"
+#include "chrono/physics/ChProximityContainerSPH.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/utils/ChUtilsCreators.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+TEST(ChNeighborGridSPH, brute_force) {
+    // Random points in a box, with slightly different radii
+    int num_points = 2000;
+    std::vector<ChVector<>> pos(num_points);
+    std::vector<double> radius(num_points);
+    for (int i = 0; i < num_points; i++) {
+        pos[i] = ChVector<>(ChRandom(), 0.5 * ChRandom(), 2 * ChRandom());
+        radius[i] = 0.05 + 0.02 * ChRandom();
+    }
+    // A far away point, to exercise the enlargement of sparse grids
+    pos.push_back(ChVector<>(100, 100, 100));
+    radius.push_back(0.05);
+
+    ChNeighborGridSPH grid;
+    grid.Update(pos, radius);
+    ASSERT_LE(grid.GetNumCells(), 8 * pos.size());
+
+    // Pair indices refer to the points in cell order
+    const auto& sorted = grid.GetSortedIndices();
+    std::vector<std::pair<unsigned int, unsigned int>> pairs;
+    for (size_t ip = 0; ip < grid.GetNumPairs(); ip++) {
+        unsigned int a = sorted[grid.GetPairsA()[ip]];
+        unsigned int b = sorted[grid.GetPairsB()[ip]];
+        pairs.push_back(std::make_pair(std::min(a, b), std::max(a, b)));
+    }
+    std::sort(pairs.begin(), pairs.end());
+
+    std::vector<std::pair<unsigned int, unsigned int>> pairs_ref;
+    for (unsigned int i = 0; i < pos.size(); i++) {
+        for (unsigned int j = i + 1; j < pos.size(); j++) {
+            double r = std::max(radius[i], radius[j]);
+            if ((pos[j] - pos[i]).Length2() < r * r)
+                pairs_ref.push_back(std::make_pair(i, j));
+        }
+    }
+
+    ASSERT_GT(pairs_ref.size(), 0);
+    ASSERT_EQ(pairs, pairs_ref);
+
+    // The parallel search must find the same pairs, in the same order
+    ChNeighborGridSPH grid_par;
+    grid_par.SetNumThreads(4);
+    grid_par.Update(pos, radius);
+    ASSERT_EQ(grid_par.GetPairsA(), grid.GetPairsA());
+    ASSERT_EQ(grid_par.GetPairsB(), grid.GetPairsB());
+}
+
+// Simulate a block of SPH fluid and return the final node positions.
+static std::vector<ChVector<>> Simulate(bool use_cell_list, int& num_pairs, int& num_bullet_pairs) {
+    ChSystemNSC system;
+
+    auto fluid = chrono_types::make_shared<ChMatterSPH>();
+    fluid->FillBox(ChVector<>(0.1, 0.1, 0.1), 0.02, 1000, ChCoordsys<>(ChVector<>(0, 0.05, 0), QUNIT), true, 2.2, 0);
+    fluid->GetMaterial().Set_viscosity(0.5);
+    fluid->GetMaterial().Set_pressure_stiffness(300);
+
+    // The collision system reports the SPH pairs (unless the cell list is used).
+    // The nodes use a custom family mask, which must be preserved.
+    fluid->SetCollide(true);
+    system.Add(fluid);
+    for (auto& node : fluid->GetNodes())
+        node->collision_model->SetFamilyMaskNoCollisionWithFamily(3);
+
+    auto proximity = chrono_types::make_shared<ChProximityContainerSPH>();
+    proximity->SetUseCellList(use_cell_list);
+    system.Add(proximity);
+
+    for (int i = 0; i < 20; i++)
+        system.DoStepDynamics(1e-3);
+
+    num_pairs = proximity->GetNproximities();
+
+    // With the cell list, the nodes are moved to the cell list family, which does not collide with itself
+    auto model = fluid->GetNodes()[0]->collision_model;
+    short int group = use_cell_list ? (short int)(1 << proximity->GetCellListFamily()) : (short int)1;
+    EXPECT_TRUE(fluid->GetCollide());
+    EXPECT_EQ(model->GetFamilyGroup(), group);
+    EXPECT_EQ((model->GetFamilyMask() & group) != 0, !use_cell_list);
+    EXPECT_FALSE(model->GetFamilyMaskDoesCollisionWithFamily(3));
+
+    // Count the node-node pairs still processed by the collision system
+    class PairCollector : public ChProximityContainer::AddProximityCallback {
+      public:
+        int num = 0;
+        virtual void OnAddProximity(const collision::ChCollisionModel& modA,
+                                    const collision::ChCollisionModel& modB) override {
+            num++;
+        }
+    };
+    auto proximity_bullet = chrono_types::make_shared<ChProximityContainerSPH>();
+    proximity_bullet->SetUseCellList(false);
+    PairCollector collector;
+    proximity_bullet->RegisterAddProximityCallback(&collector);
+    system.GetCollisionSystem()->Run();
+    system.GetCollisionSystem()->ReportProximities(proximity_bullet.get());
+    num_bullet_pairs = collector.num;
+
+    std::vector<ChVector<>> pos;
+    for (auto& node : fluid->GetNodes())
+        pos.push_back(node->GetPos());
+
+    // Disabling the cell list restores the original node families
+    proximity->SetUseCellList(false);
+    system.DoStepDynamics(1e-3);
+    EXPECT_EQ(model->GetFamilyGroup(), 1);
+    EXPECT_EQ(model->GetFamilyMask(), (short int)(0x7FFF & ~(1 << 3)));
+    EXPECT_GT(proximity->GetNproximities(), 0);
+
+    return pos;
+}
+
+TEST(ChProximityContainerSPH, cell_list) {
+    int num_pairs_bullet;
+    int num_pairs_grid;
+    int num_node_pairs_bullet;
+    int num_node_pairs_grid;
+    auto pos_bullet = Simulate(false, num_pairs_bullet, num_node_pairs_bullet);
+    auto pos_grid = Simulate(true, num_pairs_grid, num_node_pairs_grid);
+
+    // The collision system reports all pairs with overlapping bounding boxes (a superset)
+    ASSERT_GT(num_pairs_grid, 0);
+    ASSERT_LE(num_pairs_grid, num_pairs_bullet);
+    ASSERT_EQ(num_node_pairs_bullet, num_pairs_bullet);
+
+    // With the cell list, the nodes are not processed by the collision system
+    ASSERT_EQ(num_node_pairs_grid, 0);
+
+    // Pairs farther apart than the kernel radius do not contribute, so the results must match
+    ASSERT_EQ(pos_bullet.size(), pos_grid.size());
+    for (size_t i = 0; i < pos_grid.size(); i++) {
+        ASSERT_NEAR(pos_bullet[i].x(), pos_grid[i].x(), 1e-10);
+        ASSERT_NEAR(pos_bullet[i].y(), pos_grid[i].y(), 1e-10);
+        ASSERT_NEAR(pos_bullet[i].z(), pos_grid[i].z(), 1e-10);
+    }
+}
+
+TEST(ChProximityContainerSPH, container) {
+    ChSystemNSC system;
+    system.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    // Open box container (inner dimensions 0.2 x 0.2 x 0.2, floor top at y = 0)
+    auto container = chrono_types::make_shared<ChBody>();
+    container->SetBodyFixed(true);
+    container->SetCollide(true);
+    auto mat = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+    double t = 0.02;
+    container->GetCollisionModel()->ClearModel();
+    utils::AddBoxGeometry(container.get(), mat, ChVector<>(0.1 + t, t / 2, 0.1 + t), ChVector<>(0, -t / 2, 0));
+    utils::AddBoxGeometry(container.get(), mat, ChVector<>(t / 2, 0.1, 0.1), ChVector<>(-0.1 - t / 2, 0.1, 0));
+    utils::AddBoxGeometry(container.get(), mat, ChVector<>(t / 2, 0.1, 0.1), ChVector<>(+0.1 + t / 2, 0.1, 0));
+    utils::AddBoxGeometry(container.get(), mat, ChVector<>(0.1, 0.1, t / 2), ChVector<>(0, 0.1, -0.1 - t / 2));
+    utils::AddBoxGeometry(container.get(), mat, ChVector<>(0.1, 0.1, t / 2), ChVector<>(0, 0.1, +0.1 + t / 2));
+    container->GetCollisionModel()->BuildModel();
+    system.AddBody(container);
+
+    // Fluid block just above the floor
+    auto fluid = chrono_types::make_shared<ChMatterSPH>();
+    fluid->FillBox(ChVector<>(0.1, 0.1, 0.1), 0.02, 1000, ChCoordsys<>(ChVector<>(0, 0.06, 0), QUNIT), true, 2.2, 0);
+    fluid->GetMaterial().Set_viscosity(0.5);
+    fluid->GetMaterial().Set_pressure_stiffness(300);
+    fluid->SetCollide(true);
+    system.Add(fluid);
+
+    auto proximity = chrono_types::make_shared<ChProximityContainerSPH>();
+    proximity->SetUseCellList(true);
+    system.Add(proximity);
+
+    for (int i = 0; i < 300; i++)
+        system.DoStepDynamics(1e-3);
+
+    // Contacts between the nodes and the container are found, and the fluid stays in the container
+    ASSERT_GT(system.GetNcontacts(), 0);
+    ASSERT_GT(proximity->GetNproximities(), 0);
+    for (auto& node : fluid->GetNodes()) {
+        ASSERT_GT(node->GetPos().y(), -0.01);
+        ASSERT_LT(std::abs(node->GetPos().x()), 0.11);
+        ASSERT_LT(std::abs(node->GetPos().z()), 0.11);
+    }
+}
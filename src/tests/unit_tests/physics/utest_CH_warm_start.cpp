@@ -0,0 +1,189 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2014 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Unit test for solver warm starting with persistent contacts.
+// A tetrahedral pyramid of spheres rests on a fixed bottom layer. The test checks
+// that, once the pyramid is at rest, all contacts are matched with contacts of the
+// previous step and that a warm-started PSOR solver converges in fewer iterations
+// than a cold-started one (with a tolerance that both reach). The test also checks that the reactions of
+// a contact are carried over if the collision system reports the pair of models
+// in the opposite order at the next step.
+//
+// =============================================================================
+
+#include <cmath>
+
+#include "chrono/physics/ChContactContainerNSC.h"
+#include "chrono/physics/ChSystemNSC.h"
+#include "chrono/solver/ChSolverPSOR.h"
+#include "chrono/utils/ChUtilsCreators.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+
+// Simulate the pyramid with the given settings.
+// Return the average number of solver iterations over the last steps, the number of contacts at the last step, and
+// the number of contacts matched with a contact of the previous step. Also check that the solver always converged.
+static void Simulate(bool warm_start, double& iterations, int& num_contacts, int& num_matched) {
+    ChSystemNSC system;
+    system.Set_G_acc(ChVector<>(0, -9.81, 0));
+
+    int max_iterations = 1000;
+    auto solver = chrono_types::make_shared<ChSolverPSOR>();
+    solver->SetMaxIterations(max_iterations);
+    solver->SetTolerance(1e-4);
+    solver->EnableWarmStart(warm_start);
+    system.SetSolver(solver);
+
+    auto container = std::static_pointer_cast<ChContactContainerNSC>(system.GetContactContainer());
+    container->SetPersistentContacts(warm_start);
+
+    auto material = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+    material->SetFriction(0.5f);
+
+    // Layers of spheres in a close packing, each sphere resting on three spheres of the layer below. The bottom layer
+    // is fixed. Unlike a box stack, the contact forces are (nearly) unique, so that the solution of the previous step
+    // is a good initial guess.
+    int num_layers = 4;
+    double radius = 0.1;
+    for (int k = 0; k < num_layers; k++) {
+        int n = num_layers - k;
+        for (int i = 0; i < n; i++) {
+            for (int j = 0; j < n - i; j++) {
+                auto ball = chrono_types::make_shared<ChBody>();
+                ball->SetMass(1);
+                ball->SetInertiaXX(ChVector<>(0.4 * radius * radius));
+                ball->SetPos(ChVector<>(radius * (2 * i + j + k), radius * (1 + 2 * k * std::sqrt(2.0 / 3)),
+                                        radius * (j * std::sqrt(3.0) + k / std::sqrt(3.0))));
+                ball->SetBodyFixed(k == 0);
+                ball->SetCollide(true);
+                ball->GetCollisionModel()->ClearModel();
+                utils::AddSphereGeometry(ball.get(), material, radius);
+                ball->GetCollisionModel()->BuildModel();
+                system.AddBody(ball);
+            }
+        }
+    }
+
+    int num_steps = 300;
+    int num_avg = 100;
+    iterations = 0;
+    for (int i = 0; i < num_steps; i++) {
+        system.DoStepDynamics(1e-3);
+        if (i >= num_steps - num_avg) {
+            ASSERT_LT(solver->GetIterations(), max_iterations);
+            iterations += solver->GetIterations();
+        }
+    }
+    iterations /= num_avg;
+
+    num_contacts = system.GetNcontacts();
+    num_matched = container->GetNcontactsMatched();
+}
+
+TEST(ChContactContainerNSC, warm_start) {
+    double iter_cold, iter_warm;
+    int ncontacts_cold, ncontacts_warm;
+    int nmatched_cold, nmatched_warm;
+
+    Simulate(false, iter_cold, ncontacts_cold, nmatched_cold);
+    Simulate(true, iter_warm, ncontacts_warm, nmatched_warm);
+
+    ASSERT_GT(ncontacts_warm, 0);
+    ASSERT_EQ(nmatched_cold, 0);
+    ASSERT_EQ(nmatched_warm, ncontacts_warm);
+    ASSERT_LT(iter_warm, 0.5 * iter_cold);
+}
+
+// Collect the contact frame and the reactions of the (single) contact in a container.
+class ContactReporter : public ChContactContainer::ReportContactCallback {
+  public:
+    virtual bool OnReportContact(const ChVector<>& pA,
+                                 const ChVector<>& pB,
+                                 const ChMatrix33<>& plane_coord,
+                                 const double& distance,
+                                 const double& eff_radius,
+                                 const ChVector<>& react_forces,
+                                 const ChVector<>& react_torques,
+                                 ChContactable* contactobjA,
+                                 ChContactable* contactobjB) override {
+        m_plane = plane_coord;
+        m_forces = react_forces;
+        return true;
+    }
+
+    ChMatrix33<> m_plane;
+    ChVector<> m_forces;
+};
+
+TEST(ChContactContainerNSC, swapped_pair) {
+    ChSystemNSC system;
+    auto container = std::static_pointer_cast<ChContactContainerNSC>(system.GetContactContainer());
+    container->SetPersistentContacts(true);
+
+    auto material = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+    std::shared_ptr<ChBody> bodies[2];
+    for (int i = 0; i < 2; i++) {
+        bodies[i] = chrono_types::make_shared<ChBody>();
+        bodies[i]->SetPos(ChVector<>(0.1 * i, 0.5 * i, 0.2 * i));
+        bodies[i]->SetCollide(true);
+        bodies[i]->GetCollisionModel()->ClearModel();
+        utils::AddSphereGeometry(bodies[i].get(), material, 0.25);
+        bodies[i]->GetCollisionModel()->BuildModel();
+        system.AddBody(bodies[i]);
+    }
+
+    collision::ChCollisionInfo cinfo;
+    cinfo.modelA = bodies[0]->GetCollisionModel().get();
+    cinfo.modelB = bodies[1]->GetCollisionModel().get();
+    cinfo.shapeA = cinfo.modelA->GetShape(0).get();
+    cinfo.shapeB = cinfo.modelB->GetShape(0).get();
+    cinfo.vN = ChVector<>(0.1, 0.5, 0.2).GetNormalized();
+    cinfo.vpA = cinfo.vN * 0.25;
+    cinfo.vpB = bodies[1]->GetPos() - cinfo.vN * 0.25;
+    cinfo.distance = (cinfo.vpB - cinfo.vpA) ^ cinfo.vN;
+
+    // First pass: one contact, with known reactions
+    container->BeginAddContact();
+    container->AddContact(cinfo);
+    container->EndAddContact();
+    ASSERT_EQ(container->GetNcontacts(), 1);
+    ASSERT_EQ(container->GetDOC(), 3);
+
+    ChVectorDynamic<> L(3);
+    L << 1.0, 0.2, -0.3;
+    container->IntStateScatterReactions(0, L);
+
+    auto reporter1 = chrono_types::make_shared<ContactReporter>();
+    container->ReportAllContacts(reporter1);
+
+    // Second pass: same contact, with the two models reported in the opposite order
+    container->BeginAddContact();
+    container->AddContact(collision::ChCollisionInfo(cinfo, true));
+    container->EndAddContact();
+    ASSERT_EQ(container->GetNcontacts(), 1);
+    ASSERT_EQ(container->GetNcontactsMatched(), 1);
+
+    auto reporter2 = chrono_types::make_shared<ContactReporter>();
+    container->ReportAllContacts(reporter2);
+
+    // Same normal reaction, and the force on each body is unchanged (up to the float precision of the cache)
+    ASSERT_NEAR(reporter2->m_forces.x(), reporter1->m_forces.x(), 1e-6);
+    ChVector<> force1 = reporter1->m_plane * reporter1->m_forces;
+    ChVector<> force2 = reporter2->m_plane * reporter2->m_forces;
+    ASSERT_NEAR(force2.x(), -force1.x(), 1e-6);
+    ASSERT_NEAR(force2.y(), -force1.y(), 1e-6);
+    ASSERT_NEAR(force2.z(), -force1.z(), 1e-6);
+}
@@ -0,0 +1,294 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Test the direct height and normal queries of RigidTerrain height-map patches.
+// The same height map is loaded as a height-map patch and, after exporting its
+// mesh, as a general mesh patch (queried through ray casting). The height-map
+// patch must report the same height and normal as the exported mesh triangles
+// at interior points, on cell edges and vertices, and report no hit outside the
+// patch. It must also report the same hits and heights as the mesh patch, up
+// to the accuracy of ray casting on the collision mesh.
+// Terrains with adjacent and overlapping patches are also queried with and
+// without the spatial index over patches.
+//
+// =============================================================================
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include "chrono/core/ChMathematics.h"
+#include "chrono/geometry/ChTriangleMeshConnected.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "chrono_vehicle/ChVehicleModelData.h"
+#include "chrono_vehicle/terrain/RigidTerrain.h"
+
+#include "chrono_thirdparty/filesystem/path.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+// Height map (64 x 64 pixels), mapped to a patch with grid spacing 0.1
+static const std::string hmap_file("terrain/height_maps/bump64.bmp");
+static const int hmap_nv = 64;
+static const double hmap_size = 6.3;
+static const double hmap_delta = 0.1;
+static const double hmap_hmax = 0.5;
+
+// The exported mesh is written with 6 significant digits and loaded back in single precision
+static const double mesh_bary_tol = 1e-5;
+static const double mesh_height_tol = 1e-5;
+static const double mesh_normal_tol = 1e-4;
+
+// Ray casting on the collision mesh is approximate: the convex cast stops iterating about 1e-2 away from the surface of
+// the triangles, which are inflated by the collision envelope. The normals it reports are not reliable close to
+// triangle edges and vertices (i.e., almost everywhere on a fine mesh), so only hits and heights are compared.
+static const double ray_tol = 2e-2;
+
+class RigidTerrainHeightMapTest : public ::testing::Test {
+  protected:
+    RigidTerrainHeightMapTest();
+
+    // Intersect the vertical line through the specified location with the triangles of the exported mesh.
+    // Return the height and the normals of all triangles containing the point (several on edges and vertices).
+    bool MeshHeight(const ChVector<>& loc, double& height, std::vector<ChVector<>>& normals) const;
+
+    // Check that the height-map patch agrees with the exported mesh and the mesh patch at the specified location
+    void Compare(const ChVector<>& loc);
+
+    ChSystemNSC system;
+    std::shared_ptr<ChMaterialSurfaceNSC> material;
+    ChCoordsys<> position;  // position of both patches
+    RigidTerrain terrain_hmap;
+    RigidTerrain terrain_mesh;
+    geometry::ChTriangleMeshConnected mesh;  // exported mesh, in the patch frame
+};
+
+RigidTerrainHeightMapTest::RigidTerrainHeightMapTest()
+    : position(ChVector<>(1.0, 0.5, 0.2), QUNIT), terrain_hmap(&system), terrain_mesh(&system) {
+    material = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+
+    terrain_hmap.AddPatch(material, position, vehicle::GetDataFile(hmap_file), "hmap_patch", hmap_size, hmap_size,
+                          0, hmap_hmax, 0, false);
+    terrain_hmap.Initialize();
+
+    // Export the height-map mesh and load it back as a general mesh patch
+    const std::string out_dir = GetChronoOutputPath() + "RIGID_TERRAIN_HMAP";
+    filesystem::create_directory(filesystem::path(GetChronoOutputPath()));
+    filesystem::create_directory(filesystem::path(out_dir));
+    terrain_hmap.ExportMeshWavefront(out_dir);
+    terrain_mesh.AddPatch(material, position, out_dir + "/hmap_patch.obj", "mesh_patch", 0, false);
+    terrain_mesh.Initialize();
+    mesh.LoadWavefrontMesh(out_dir + "/hmap_patch.obj", false, false);
+
+    // Update the collision models, used for ray casting into the mesh patch
+    system.Update();
+    system.ComputeCollisions();
+}
+
+bool RigidTerrainHeightMapTest::MeshHeight(const ChVector<>& loc,
+                                           double& height,
+                                           std::vector<ChVector<>>& normals) const {
+    // The default world frame is ISO, so the vertical direction is the Z axis of the patch frame
+    ChVector<> p = position.TransformPointParentToLocal(loc);
+    bool hit = false;
+    for (int it = 0; it < mesh.getNumTriangles(); it++) {
+        auto tri = mesh.getTriangle(it);
+        const ChVector<>& a = tri.p1;
+        const ChVector<>& b = tri.p2;
+        const ChVector<>& c = tri.p3;
+
+        // Barycentric coordinates of the projection of the point on the triangle
+        double det = (b.x() - a.x()) * (c.y() - a.y()) - (c.x() - a.x()) * (b.y() - a.y());
+        double la = ((b.x() - p.x()) * (c.y() - p.y()) - (c.x() - p.x()) * (b.y() - p.y())) / det;
+        double lb = ((c.x() - p.x()) * (a.y() - p.y()) - (a.x() - p.x()) * (c.y() - p.y())) / det;
+        double lc = 1 - la - lb;
+        if (la < -mesh_bary_tol || lb < -mesh_bary_tol || lc < -mesh_bary_tol)
+            continue;
+
+        hit = true;
+        height = position.TransformPointLocalToParent(la * a + lb * b + lc * c).z();
+        ChVector<> normal = Vcross(b - a, c - a).GetNormalized();
+        normals.push_back(position.TransformDirectionLocalToParent(normal.z() > 0 ? normal : -normal));
+    }
+    return hit;
+}
+
+void RigidTerrainHeightMapTest::Compare(const ChVector<>& loc) {
+    double height_hmap, height_exact, height_mesh;
+    ChVector<> normal_hmap, normal_mesh;
+    std::vector<ChVector<>> normals_exact;
+    float friction;
+    bool hit_hmap = terrain_hmap.FindPoint(loc, height_hmap, normal_hmap, friction);
+    bool hit_exact = MeshHeight(loc, height_exact, normals_exact);
+    bool hit_mesh = terrain_mesh.FindPoint(loc, height_mesh, normal_mesh, friction);
+
+    // Mesh patch: same hit, except within the ray casting tolerance from the patch boundary
+    ChVector<> loc_patch = position.TransformPointParentToLocal(loc);
+    bool near_boundary = std::abs(std::abs(loc_patch.x()) - hmap_size / 2) < ray_tol ||
+                         std::abs(std::abs(loc_patch.y()) - hmap_size / 2) < ray_tol;
+    if (!near_boundary)
+        ASSERT_EQ(hit_hmap, hit_mesh) << "at " << loc;
+
+    // Exported mesh: same hit, same height, and the normal of one of the triangles containing the point
+    ASSERT_EQ(hit_hmap, hit_exact) << "at " << loc;
+    if (!hit_hmap)
+        return;
+    ASSERT_NEAR(height_hmap, height_exact, mesh_height_tol) << "at " << loc;
+    bool normal_match = false;
+    for (const auto& n : normals_exact)
+        normal_match = normal_match || (normal_hmap - n).Length() < mesh_normal_tol;
+    ASSERT_TRUE(normal_match) << "at " << loc << "  normal " << normal_hmap;
+
+    // Mesh patch: same height, up to the accuracy of ray casting
+    ASSERT_TRUE(hit_mesh) << "at " << loc;
+    ASSERT_NEAR(height_hmap, height_mesh, ray_tol) << "at " << loc;
+}
+
+// Random locations inside the patch.
+TEST_F(RigidTerrainHeightMapTest, interior) {
+    ChSetRandomSeed(5);
+    for (int i = 0; i < 2000; i++) {
+        double x = (ChRandom() - 0.5) * hmap_size;
+        double y = (ChRandom() - 0.5) * hmap_size;
+        Compare(position.pos + ChVector<>(x, y, 1));
+    }
+}
+
+// Locations on cell edges (along both grid directions and on the cell diagonals) and on the grid vertices.
+TEST_F(RigidTerrainHeightMapTest, edges_vertices) {
+    ChSetRandomSeed(7);
+    for (int i = 0; i < hmap_nv; i++) {
+        for (int j = 0; j < hmap_nv; j += 3) {
+            double s = ChRandom();
+            double x = -hmap_size / 2 + i * hmap_delta;
+            double y = -hmap_size / 2 + j * hmap_delta;
+            Compare(position.pos + ChVector<>(x, y, 1));  // vertex
+            if (j < hmap_nv - 1)
+                Compare(position.pos + ChVector<>(x, y + s * hmap_delta, 1));  // edge along y
+            if (i < hmap_nv - 1)
+                Compare(position.pos + ChVector<>(x + s * hmap_delta, y, 1));  // edge along x
+            if (i < hmap_nv - 1 && j < hmap_nv - 1)
+                Compare(position.pos + ChVector<>(x + s * hmap_delta, y + s * hmap_delta, 1));  // cell diagonal
+        }
+    }
+}
+
+// Locations on the patch boundary and just outside the patch.
+TEST_F(RigidTerrainHeightMapTest, boundary) {
+    const double h = hmap_size / 2;
+    const double eps = 1e-3;
+    for (int i = 0; i <= 20; i++) {
+        double s = -h + i * hmap_size / 20;
+        for (double b : {h - eps, h + eps}) {
+            Compare(position.pos + ChVector<>(s, b, 1));
+            Compare(position.pos + ChVector<>(s, -b, 1));
+            Compare(position.pos + ChVector<>(b, s, 1));
+            Compare(position.pos + ChVector<>(-b, s, 1));
+        }
+    }
+
+    // No hit outside the patch
+    double height;
+    ChVector<> normal;
+    float friction;
+    ASSERT_FALSE(terrain_hmap.FindPoint(position.pos + ChVector<>(h + eps, 0, 1), height, normal, friction));
+    ASSERT_FALSE(terrain_hmap.FindPoint(position.pos + ChVector<>(-h - eps, -h - eps, 1), height, normal, friction));
+    ASSERT_FALSE(terrain_mesh.FindPoint(position.pos + ChVector<>(h + 2 * ray_tol, 0, 1), height, normal, friction));
+    ASSERT_FALSE(terrain_mesh.FindPoint(position.pos + ChVector<>(-h - 2 * ray_tol, -h - 2 * ray_tol, 1), height, normal,
+                                        friction));
+}
+
+// Terrain with adjacent and overlapping patches.
+// The combined terrain must report the highest hit over the individual patches, both before Initialize (when all
+// patches are tested) and after Initialize (when only the patches registered in the spatial index are tested).
+TEST_F(RigidTerrainHeightMapTest, multiple_patches) {
+    const double h = hmap_size / 2;
+
+    // Patch definitions: two adjacent height maps sharing an edge, a box overlapping both, and a box inside the first
+    auto add_patches = [&](RigidTerrain& terrain, int which) {
+        if (which < 0 || which == 0)
+            terrain.AddPatch(material, position, vehicle::GetDataFile(hmap_file), "hmap_0", hmap_size, hmap_size, 0,
+                             hmap_hmax, 0, false);
+        if (which < 0 || which == 1)
+            terrain.AddPatch(material, ChCoordsys<>(position.pos + ChVector<>(hmap_size, 0, 0.1), QUNIT),
+                             vehicle::GetDataFile(hmap_file), "hmap_1", hmap_size, hmap_size, 0, hmap_hmax, 0, false);
+        if (which < 0 || which == 2)
+            terrain.AddPatch(material, position.pos + ChVector<>(h, 1, 0.25), ChVector<>(0, 0, 1), 2, 1.5, 1, false,
+                             1, false);
+        if (which < 0 || which == 3)
+            terrain.AddPatch(material, position.pos + ChVector<>(-1.5, -1.5, 0.3), ChVector<>(0.1, 0.1, 1), 1, 1, 1,
+                             false, 1, false);
+    };
+
+    RigidTerrain terrain(&system);
+    add_patches(terrain, -1);
+
+    std::vector<std::shared_ptr<RigidTerrain>> single;
+    for (int ip = 0; ip < 4; ip++) {
+        single.push_back(chrono_types::make_shared<RigidTerrain>(&system));
+        add_patches(*single.back(), ip);
+        single.back()->Initialize();
+    }
+
+    std::vector<ChVector<>> locs;
+    ChSetRandomSeed(11);
+    for (int i = 0; i < 2000; i++) {
+        double x = -h - 1 + (2 * hmap_size + 2) * ChRandom();
+        double y = -h - 1 + (hmap_size + 2) * ChRandom();
+        locs.push_back(position.pos + ChVector<>(x, y, 2));
+    }
+    for (int j = 0; j <= 40; j++) {
+        double y = -h + j * hmap_size / 40;
+        locs.push_back(position.pos + ChVector<>(h, y, 2));  // shared edge of the two height maps
+    }
+
+    auto check = [&]() {
+        for (const auto& loc : locs) {
+            bool hit_ref = false;
+            double height_ref = std::numeric_limits<double>::lowest();
+            ChVector<> normal_ref;
+            for (const auto& t : single) {
+                double height;
+                ChVector<> normal;
+                float friction;
+                if (t->FindPoint(loc, height, normal, friction) && height > height_ref) {
+                    hit_ref = true;
+                    height_ref = height;
+                    normal_ref = normal;
+                }
+            }
+
+            double height;
+            ChVector<> normal;
+            float friction;
+            bool hit = terrain.FindPoint(loc, height, normal, friction);
+            ASSERT_EQ(hit, hit_ref) << "at " << loc;
+            if (hit) {
+                ASSERT_NEAR(height, height_ref, 1e-12) << "at " << loc;
+                ASSERT_NEAR((normal - normal_ref).Length(), 0, 1e-12) << "at " << loc;
+            }
+        }
+    };
+
+    // Before Initialize, all patches are tested
+    check();
+
+    // After Initialize, the spatial index is used
+    terrain.Initialize();
+    check();
+}
@@ -0,0 +1,176 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Test the implicit-grid mode of the SCM deformable terrain.
+// A rigid wheel settles on flat terrain represented either as a mesh or as an
+// implicit grid with the same node spacing. Both must give the same sinkage and
+// contact force. In grid mode, the terrain height must reflect the deformation
+// at loaded nodes and the reference height elsewhere, and the number of stored
+// nodes must depend on the wheel footprint only, not on the terrain size, also
+// for grids with more nodes than can be indexed with 32-bit integers. Without
+// moving patches, only the grid nodes below the wheel bounding box are ray cast.
+// The contact force fluctuates from step to step (and round-off differences
+// between runs grow once the wheel settles), so forces are averaged over the
+// end of the simulation and results are compared with relative tolerances.
+//
+// =============================================================================
+
+#include <cmath>
+
+#include "chrono/collision/ChCollisionModel.h"
+#include "chrono/physics/ChBodyEasy.h"
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "chrono_vehicle/terrain/SCMDeformableTerrain.h"
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+static const double wheel_radius = 0.3;
+static const double wheel_width = 0.2;
+static const double grid_delta = 0.0625;
+static const double patch_size = 1.0;
+
+enum class TerrainType { MESH, GRID };
+
+struct SettleResult {
+    double sinkage;         // sinkage of the wheel bottom point
+    double force;           // vertical contact force on the wheel (averaged over the last 0.25 s)
+    double weight;          // wheel weight
+    double height_center;   // terrain height below the wheel center
+    double height_far;      // terrain height away from the wheel
+    size_t num_vertices;    // number of terrain nodes with SCM data
+    size_t num_ray_casts;   // number of rays cast at the last step
+};
+
+// Let a rigid wheel settle on SCM terrain of given type and size (square, centered at the origin).
+// If so requested, a moving patch is attached to the wheel.
+static SettleResult Settle(TerrainType type, double size, bool moving_patch = true) {
+    ChSystemNSC system;
+    system.Set_G_acc(ChVector<>(0, 0, -9.81));
+
+    // Wheel (cylinder with axis along Y), initially just above the terrain, above a terrain node
+    auto material = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+    auto wheel = chrono_types::make_shared<ChBodyEasyCylinder>(wheel_radius, wheel_width, 1000, false, true, material);
+    wheel->SetPos(ChVector<>(0, 0, wheel_radius + 0.01));
+    system.AddBody(wheel);
+
+    SCMDeformableTerrain terrain(&system, false);
+    terrain.SetSoilParameters(2e5, 0, 1.1, 0, 30, 0.01, 4e7, 3e4);
+    if (moving_patch)
+        terrain.AddMovingPatch(wheel, VNULL, patch_size, patch_size);
+    int div = (int)std::round(size / grid_delta);
+    switch (type) {
+        case TerrainType::MESH:
+            terrain.Initialize(0, size, size, div, div);
+            break;
+        case TerrainType::GRID:
+            terrain.Initialize(0, size, size, grid_delta);
+            break;
+    }
+
+    double step = 1e-3;
+    double force = 0;
+    int num_steps = 0;
+    while (system.GetChTime() < 1.0) {
+        system.DoStepDynamics(step);
+        if (system.GetChTime() > 0.75) {
+            force += terrain.GetContactForce(wheel).force.z();
+            num_steps++;
+        }
+    }
+
+    SettleResult result;
+    result.sinkage = wheel_radius - wheel->GetPos().z();
+    result.force = force / num_steps;
+    result.weight = wheel->GetMass() * 9.81;
+    result.height_center = terrain.GetHeight(ChVector<>(0, 0, 1));
+    result.height_far = terrain.GetHeight(ChVector<>(size / 4, size / 4, 1));
+    result.num_vertices = terrain.GetNumVertices();
+    result.num_ray_casts = terrain.GetNumRayCasts();
+
+    return result;
+}
+
+TEST(SCMGrid, mesh_vs_grid) {
+    SettleResult mesh = Settle(TerrainType::MESH, 4);
+    SettleResult grid = Settle(TerrainType::GRID, 4);
+
+    // The wheel sinks and is supported by the terrain
+    ASSERT_GT(mesh.sinkage, 0.005);
+    ASSERT_NEAR(mesh.force, mesh.weight, 0.02 * mesh.weight);
+    ASSERT_NEAR(grid.force, grid.weight, 0.02 * grid.weight);
+
+    // Both representations give the same sinkage and contact force
+    ASSERT_NEAR(grid.sinkage, mesh.sinkage, 0.01 * mesh.sinkage);
+    ASSERT_NEAR(grid.force, mesh.force, 0.02 * mesh.force);
+
+    // Grid mode: deformed height below the wheel (at a loaded node), reference height away from the wheel.
+    // Rays hit the wheel collision shape, inflated by its safe margin.
+    double margin = collision::ChCollisionModel::GetDefaultSuggestedMargin();
+    ASSERT_NEAR(grid.height_center, -(grid.sinkage + margin), 3e-3);
+    ASSERT_EQ(grid.height_far, 0.0);
+}
+
+TEST(SCMGrid, stored_nodes) {
+    SettleResult small = Settle(TerrainType::GRID, 4);
+    SettleResult large = Settle(TerrainType::GRID, 400);
+
+    // Only the nodes loaded by the wheel are stored, regardless of the terrain size.
+    // These are a subset of the grid nodes in the moving patch.
+    size_t num_patch_nodes = (size_t)(patch_size / grid_delta + 1) * (size_t)(patch_size / grid_delta + 1);
+    ASSERT_GT(small.num_vertices, 0u);
+    ASSERT_GT(large.num_vertices, 0u);
+    ASSERT_LE(small.num_vertices, num_patch_nodes);
+    ASSERT_LE(large.num_vertices, num_patch_nodes);
+
+    // The grid nodes below the wheel coincide, so the results are the same
+    ASSERT_NEAR(large.sinkage, small.sinkage, 0.01 * small.sinkage);
+    ASSERT_NEAR(large.force, small.force, 0.01 * small.force);
+}
+
+TEST(SCMGrid, large_grid) {
+    // A grid with more than INT_MAX nodes (the nodes below the wheel have indices larger than INT_MAX)
+    double size = 1e4;
+    SettleResult small = Settle(TerrainType::GRID, 4);
+    SettleResult huge = Settle(TerrainType::GRID, size);
+    ASSERT_GT(huge.num_vertices, 0u);
+    ASSERT_NEAR(huge.sinkage, small.sinkage, 0.01 * small.sinkage);
+    ASSERT_NEAR(huge.force, small.force, 0.01 * small.force);
+
+    // Such a grid cannot have a visualization mesh
+    ChSystemNSC system;
+    SCMDeformableTerrain terrain(&system, true);
+    ASSERT_THROW(terrain.Initialize(0, size, size, grid_delta), ChException);
+}
+
+TEST(SCMGrid, no_moving_patch) {
+    // Without moving patches, rays are cast only from the grid nodes below the wheel bounding box (inflated by one
+    // grid spacing), not from all the nodes of the grid
+    SettleResult patch = Settle(TerrainType::GRID, 400, true);
+    SettleResult body = Settle(TerrainType::GRID, 400, false);
+
+    size_t num_patch_nodes = (size_t)(patch_size / grid_delta + 1) * (size_t)(patch_size / grid_delta + 1);
+    ASSERT_GT(patch.num_ray_casts, 0u);
+    ASSERT_LE(patch.num_ray_casts, num_patch_nodes);
+    ASSERT_GT(body.num_ray_casts, 0u);
+    ASSERT_LT(body.num_ray_casts, patch.num_ray_casts);
+
+    // All loaded nodes are below the wheel, so the results are the same
+    ASSERT_EQ(body.num_vertices, patch.num_vertices);
+    ASSERT_NEAR(body.sinkage, patch.sinkage, 0.01 * patch.sinkage);
+    ASSERT_NEAR(body.force, patch.force, 0.01 * patch.force);
+}
@@ -0,0 +1,139 @@
+// =============================================================================
+// PROJECT CHRONO - http://projectchrono.org
+//
+// Copyright (c) 2019 projectchrono.org
+// All rights reserved.
+//
+// Use of this source code is governed by a BSD-style license that can be found
+// in the LICENSE file at the top level of the distribution and at
+// http://projectchrono.org/license-chrono.txt.
+//
+// =============================================================================
+// Authors: agent
+// =============================================================================
+//
+// Test the terrain property queries (single-point and batched GetProperties, GetHeights)
+// against the scalar getters GetHeight, GetNormal, and GetCoefficientFriction,
+// for each terrain type.
+//
+// =============================================================================
+
+#include <cmath>
+#include <vector>
+
+#include "chrono/physics/ChSystemNSC.h"
+
+#include "chrono_vehicle/ChConfigVehicle.h"
+#include "chrono_vehicle/ChVehicleModelData.h"
+#include "chrono_vehicle/terrain/FlatTerrain.h"
+#include "chrono_vehicle/terrain/RigidTerrain.h"
+#include "chrono_vehicle/terrain/SCMDeformableTerrain.h"
+#ifdef CHRONO_OPENCRG
+#include "chrono_vehicle/terrain/CRGTerrain.h"
+#endif
+
+#include "gtest/gtest.h"
+
+using namespace chrono;
+using namespace chrono::vehicle;
+
+// Location-dependent coefficient of friction
+class FrictionFunctor : public ChTerrain::FrictionFunctor {
+  public:
+    virtual float operator()(const ChVector<>& loc) override { return 0.6f + 0.1f * (float)std::sin(loc.x()); }
+};
+
+// Compare the single-point and batched queries with the scalar getters, on a grid of locations
+static void CheckProperties(const ChTerrain& terrain, double size, double z) {
+    std::vector<ChVector<>> locs;
+    for (int i = -5; i <= 5; i++)
+        for (int j = -5; j <= 5; j++)
+            locs.push_back(ChVector<>(i * size / 10, j * size / 10, z));
+
+    std::vector<double> heights;
+    std::vector<ChVector<>> normals;
+    std::vector<float> frictions;
+    terrain.GetProperties(locs, heights, normals, frictions);
+    ASSERT_EQ(heights.size(), locs.size());
+    ASSERT_EQ(normals.size(), locs.size());
+    ASSERT_EQ(frictions.size(), locs.size());
+
+    std::vector<double> heights_only;
+    terrain.GetHeights(locs, heights_only);
+    ASSERT_EQ(heights_only.size(), locs.size());
+
+    for (size_t i = 0; i < locs.size(); i++) {
+        double height;
+        ChVector<> normal;
+        float friction;
+        terrain.GetProperties(locs[i], height, normal, friction);
+
+        double height_ref = terrain.GetHeight(locs[i]);
+        ChVector<> normal_ref = terrain.GetNormal(locs[i]);
+        float friction_ref = terrain.GetCoefficientFriction(locs[i]);
+
+        ASSERT_NEAR(height, height_ref, 1e-12);
+        ASSERT_NEAR((normal - normal_ref).Length(), 0.0, 1e-12);
+        ASSERT_EQ(friction, friction_ref);
+
+        ASSERT_NEAR(heights[i], height_ref, 1e-12);
+        ASSERT_NEAR((normals[i] - normal_ref).Length(), 0.0, 1e-12);
+        ASSERT_EQ(frictions[i], friction_ref);
+
+        ASSERT_NEAR(heights_only[i], height_ref, 1e-12);
+    }
+}
+
+TEST(TerrainProperties, flat) {
+    FlatTerrain terrain(0.5, 0.7f);
+    CheckProperties(terrain, 10, 1);
+
+    FrictionFunctor friction;
+    terrain.RegisterFrictionFunctor(&friction);
+    CheckProperties(terrain, 10, 1);
+}
+
+TEST(TerrainProperties, rigid) {
+    ChSystemNSC system;
+    auto material = chrono_types::make_shared<ChMaterialSurfaceNSC>();
+
+    // Tilted box patch and height-map patch, side by side; some locations fall outside both patches
+    RigidTerrain terrain(&system);
+    terrain.AddPatch(material, ChVector<>(-5, 0, 0), ChVector<>(0.1, 0, 1), 10, 10, 1, false, 1, false);
+    terrain.AddPatch(material, ChCoordsys<>(ChVector<>(5, 0, 0), QUNIT),
+                     vehicle::GetDataFile("terrain/height_maps/bump64.bmp"), "bump", 10, 10, 0, 1, 0, false);
+    terrain.Initialize();
+    CheckProperties(terrain, 24, 5);
+
+    FrictionFunctor friction;
+    terrain.RegisterFrictionFunctor(&friction);
+    CheckProperties(terrain, 24, 5);
+}
+
+TEST(TerrainProperties, scm) {
+    ChSystemNSC system;
+
+    SCMDeformableTerrain terrain(&system, false);
+    terrain.SetPlane(ChCoordsys<>(ChVector<>(0, 0, 0.2), Q_from_AngX(0.1)));
+    terrain.Initialize(0.0, 10, 10, 20, 20);
+    CheckProperties(terrain, 10, 2);
+
+    FrictionFunctor friction;
+    terrain.RegisterFrictionFunctor(&friction);
+    CheckProperties(terrain, 10, 2);
+}
+
+#ifdef CHRONO_OPENCRG
+TEST(TerrainProperties, crg) {
+    ChSystemNSC system;
+
+    CRGTerrain terrain(&system);
+    terrain.UseMeshVisualization(false);
+    terrain.Initialize(vehicle::GetDataFile("terrain/crg_roads/handmade_curved_banked_sloped.crg"));
+    CheckProperties(terrain, 20, 5);
+
+    FrictionFunctor friction;
+    terrain.RegisterFrictionFunctor(&friction);
+    CheckProperties(terrain, 20, 5);
+}
+#endif